@@ -47,6 +47,10 @@ from . import enum_types
 from . import struct_types
 from . import writer
 
+# Structs with at least this many parsed fields switch on the field name length before comparing
+# names, instead of comparing each element's name against every field in turn.
+_MIN_FIELDS_FOR_LENGTH_DISPATCH = 4
+
 
 def _get_field_member_name(field):
     # type: (ast.Field) -> str
@@ -1343,6 +1347,57 @@ class _CppSourceFileWriter(_CppFileWriterBase):
             # Generate namespace check now that "$db" has been read or defaulted
             struct_type_info.gen_namespace_check(self._writer, "_dbName", "commandElement")
 
+    def _gen_field_deserializer_or_ignore(self, field, bson_object, field_usage_check):
+        # type: (ast.Field, str, _FieldUsageCheckerBase) -> None
+        """Generate the C++ code to deserialize or skip a field matched by name."""
+        if field.ignore:
+            field_usage_check.add(field, "element")
+
+            self._writer.write_line('// ignore field')
+        else:
+            self.gen_field_deserializer(field, bson_object, "element", field_usage_check)
+
+    def _gen_unknown_field_check(self, struct):
+        # type: (ast.Struct) -> None
+        """Generate the C++ code to reject a field a strict struct does not know."""
+        # For commands, check if this a well known command field that the IDL parser
+        # should ignore regardless of strict mode.
+        command_predicate = None
+        if isinstance(struct, ast.Command):
+            command_predicate = "!mongo::isGenericArgument(fieldName)"
+
+        with self._predicate(command_predicate):
+            self._writer.write_line('ctxt.throwUnknownField(fieldName);')
+
+    def _gen_fields_length_dispatch(self, fields, bson_object, field_usage_check):
+        # type: (List[ast.Field], str, _FieldUsageCheckerBase) -> None
+        """
+        Generate a switch on the field name length ahead of the name comparisons.
+
+        Each field name is then compared only against the fields of the same length instead of
+        against every field the struct declares.
+        """
+        fields_by_length = {}  # type: Dict[int, List[ast.Field]]
+        for field in fields:
+            fields_by_length.setdefault(len(field.name), []).append(field)
+
+        with self._block('switch (fieldName.size()) {', '}'):
+            for length in sorted(fields_by_length):
+                self._writer.write_line('case %d:' % (length))
+                self._writer.indent()
+                for field in fields_by_length[length]:
+                    field_predicate = 'fieldName == %s' % (_get_field_constant_name(field))
+                    with self._predicate(field_predicate):
+                        self._gen_field_deserializer_or_ignore(field, bson_object,
+                                                               field_usage_check)
+                        self._writer.write_line('continue;')
+                self._writer.write_line('break;')
+                self._writer.unindent()
+            self._writer.write_line('default:')
+            self._writer.indent()
+            self._writer.write_line('break;')
+            self._writer.unindent()
+
     def _gen_fields_deserializer_common(self, struct, bson_object):
         # type: (ast.Struct, str) -> _FieldUsageCheckerBase
         """Generate the C++ code to deserialize list of fields."""
@@ -1372,39 +1427,35 @@ class _CppSourceFileWriter(_CppFileWriterBase):
             field_usage_check.add_store("fieldName")
             self._writer.write_empty_line()
 
-            first_field = True
-            for field in struct.fields:
-                # Do not parse chained fields as fields since they are actually chained types.
-                if field.chained and not field.chained_struct_field:
-                    continue
-
-                field_predicate = 'fieldName == %s' % (_get_field_constant_name(field))
-
-                with self._predicate(field_predicate, not first_field):
+            # Do not parse chained fields as fields since they are actually chained types.
+            parsed_fields = [
+                field for field in struct.fields
+                if not field.chained or field.chained_struct_field
+            ]
 
-                    if field.ignore:
-                        field_usage_check.add(field, "element")
+            if len(parsed_fields) >= _MIN_FIELDS_FOR_LENGTH_DISPATCH:
+                self._gen_fields_length_dispatch(parsed_fields, bson_object, field_usage_check)
 
-                        self._writer.write_line('// ignore field')
-                    else:
-                        self.gen_field_deserializer(field, bson_object, "element",
-                                                    field_usage_check)
-
-                if first_field:
-                    first_field = False
-
-            # End of for fields
-            # Generate strict check for extranous fields
-            if struct.strict:
-                with self._block('else {', '}'):
-                    # For commands, check if this a well known command field that the IDL parser
-                    # should ignore regardless of strict mode.
-                    command_predicate = None
-                    if isinstance(struct, ast.Command):
-                        command_predicate = "!mongo::isGenericArgument(fieldName)"
-
-                    with self._predicate(command_predicate):
-                        self._writer.write_line('ctxt.throwUnknownField(fieldName);')
+                # Every matched field continues the loop, so anything reaching here is unknown.
+                if struct.strict:
+                    self._gen_unknown_field_check(struct)
+            else:
+                first_field = True
+                for field in parsed_fields:
+                    field_predicate = 'fieldName == %s' % (_get_field_constant_name(field))
+
+                    with self._predicate(field_predicate, not first_field):
+                        self._gen_field_deserializer_or_ignore(field, bson_object,
+                                                               field_usage_check)
+
+                    if first_field:
+                        first_field = False
+
+                # End of for fields
+                # Generate strict check for extranous fields
+                if struct.strict:
+                    with self._block('else {', '}'):
+                        self._gen_unknown_field_check(struct)
 
         # Parse chained structs if not inlined
         # Parse chained types always here
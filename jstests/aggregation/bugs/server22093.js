@@ -46,9 +46,14 @@ assert(planHasStage(db, explained.stages[0].$cursor.queryPlanner.winningPlan, "C
 explained = coll.explain().aggregate([{$match: {foo: {$gt: 0}}}, {$count: "count"}]);
 assert(planHasStage(db, explained.stages[0].$cursor.queryPlanner.winningPlan, "COUNT_SCAN"));
 
-// A $match that is not a single range cannot use the COUNT_SCAN optimization.
-explained = coll.explain().aggregate([{$match: {foo: {$in: [0, 1]}}}, {$count: "count"}]);
-assert(!planHasStage(db, explained.stages[0].$cursor.queryPlanner.winningPlan, "COUNT_SCAN"));
+// A $match made of several ranges is counted by a COUNT_SCAN that visits each range in turn.
+explained = coll.explain().aggregate([{$match: {foo: {$in: [0, 2]}}}, {$count: "count"}]);
+assert(planHasStage(db, explained.stages[0].$cursor.queryPlanner.winningPlan, "COUNT_SCAN"));
+assert.eq(10, coll.aggregate([{$match: {foo: {$in: [0, 2]}}}, {$count: "count"}]).next().count);
+assert.eq(10,
+          coll.aggregate([{$match: {foo: {$in: [0, 2]}}}, {$sort: {foo: -1}}, {$count: "count"}])
+              .next()
+              .count);
 
 // Test that COUNT_SCAN can be used when there is a $sort.
 explained = coll.explain().aggregate([{$sort: {foo: 1}}, {$count: "count"}]);
@@ -191,12 +191,12 @@ assertPipelineDoesNotUseAggregation({
 });
 assertPipelineDoesNotUseAggregation({
     pipeline: [{$project: {x: 1, "a.b": 1, _id: 0}}],
-    expectedStages: ["COLLSCAN", "PROJECTION_DEFAULT"],
+    expectedStages: ["COLLSCAN", "PROJECTION_SIMPLE"],
     expectedResult: [{x: 10}, {x: 20}, {x: 30}, {x: 40, a: {b: "ab1"}}]
 });
 assertPipelineDoesNotUseAggregation({
     pipeline: [{$match: {x: 40}}, {$project: {"a.b": 1, _id: 0}}],
-    expectedStages: ["COLLSCAN", "PROJECTION_DEFAULT"],
+    expectedStages: ["COLLSCAN", "PROJECTION_SIMPLE"],
     expectedResult: [{a: {b: "ab1"}}]
 });
 // We can collapse a $project stage if it has a complex pipeline expression.
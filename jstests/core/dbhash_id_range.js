@@ -0,0 +1,59 @@
+/**
+ * Tests that dbHash can hash the documents of a single collection with an _id in [min, max), so
+ * that the copies of two collections can be compared one range at a time.
+ *
+ * @tags: [
+ *   assumes_superuser_permissions,
+ *   # dbhash command is not available on embedded
+ *   incompatible_with_embedded,
+ * ]
+ */
+(function() {
+"use strict";
+
+const testDB = db.getSiblingDB("dbhash_id_range");
+assert.commandWorked(testDB.dropDatabase());
+const coll = testDB.coll;
+const other = testDB.other;
+
+const docs = [];
+for (let i = 0; i < 10; ++i) {
+    docs.push({_id: i, x: i});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(other.insert(docs));
+
+function rangeHash(collName, min, max) {
+    const cmd = {dbHash: 1, collections: [collName]};
+    if (min !== undefined) {
+        cmd.min = {_id: min};
+    }
+    if (max !== undefined) {
+        cmd.max = {_id: max};
+    }
+    return assert.commandWorked(testDB.runCommand(cmd)).collections[collName];
+}
+
+// Without bounds the whole collection is hashed.
+const fullHash = rangeHash(coll.getName());
+assert.eq(fullHash, rangeHash(coll.getName(), MinKey, MaxKey));
+assert.neq(fullHash, rangeHash(coll.getName(), 0, 5));
+
+// Diverge the two collections in the upper half only.
+assert.commandWorked(other.update({_id: 7}, {$set: {x: -1}}));
+assert.neq(fullHash, rangeHash(other.getName()));
+assert.eq(rangeHash(coll.getName(), undefined, 5), rangeHash(other.getName(), undefined, 5));
+assert.neq(rangeHash(coll.getName(), 5), rangeHash(other.getName(), 5));
+assert.eq(rangeHash(coll.getName(), 5, 7), rangeHash(other.getName(), 5, 7));
+assert.neq(rangeHash(coll.getName(), 7, 8), rangeHash(other.getName(), 7, 8));
+
+// Ranges require exactly one collection and an {_id: <value>} bound.
+assert.commandFailedWithCode(testDB.runCommand({dbHash: 1, min: {_id: 0}}),
+                             ErrorCodes.InvalidOptions);
+assert.commandFailedWithCode(
+    testDB.runCommand({dbHash: 1, collections: [coll.getName()], min: {x: 0}}),
+    ErrorCodes.InvalidOptions);
+assert.commandFailedWithCode(
+    testDB.runCommand({dbHash: 1, collections: [coll.getName()], max: 5}),
+    ErrorCodes.TypeMismatch);
+})();
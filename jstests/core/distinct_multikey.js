@@ -68,11 +68,19 @@ explain = coll.explain("queryPlanner").distinct("a", {a: {$gte: 2}});
 assert(planHasStage(db, explain.queryPlanner.winningPlan, "PROJECTION_COVERED"));
 assert(planHasStage(db, explain.queryPlanner.winningPlan, "DISTINCT_SCAN"));
 
-// Test distinct over a trailing multikey field.
+// Test distinct over a trailing multikey field. There is no predicate on the multikey field, so
+// the distinct scan can be used as long as the values are read from the fetched documents.
 result = coll.distinct("b", {a: {$gte: 2}});
 assert.eq([3, 4, 5], result.sort());
 explain = coll.explain("queryPlanner").distinct("b", {a: {$gte: 2}});
 assert(planHasStage(db, explain.queryPlanner.winningPlan, "FETCH"));
+assert(planHasStage(db, explain.queryPlanner.winningPlan, "DISTINCT_SCAN"));
+
+// A predicate on the trailing multikey field still rules out the distinct scan.
+result = coll.distinct("b", {a: {$gte: 2}, b: 4});
+assert.eq([3, 4, 5], result.sort());
+explain = coll.explain("queryPlanner").distinct("b", {a: {$gte: 2}, b: 4});
+assert(planHasStage(db, explain.queryPlanner.winningPlan, "FETCH"));
 assert(planHasStage(db, explain.queryPlanner.winningPlan, "IXSCAN"));
 
 // Test distinct over a trailing non-multikey field, where the leading field is multikey.
@@ -100,4 +108,18 @@ assert.eq([1, 7, 8], result.sort());
 explain = coll.explain("queryPlanner").distinct("b.c", {a: 3});
 assert(planHasStage(db, explain.queryPlanner.winningPlan, "PROJECTION_DEFAULT"));
 assert(planHasStage(db, explain.queryPlanner.winningPlan, "DISTINCT_SCAN"));
+
+// Test that a covered predicate that cannot be expressed as index bounds is applied by the distinct
+// scan itself. The first key for each value of 'a' fails the filter, and must not hide the later
+// key with the same value that passes it.
+coll.drop();
+assert.commandWorked(coll.createIndex({a: 1, b: 1}));
+assert.commandWorked(coll.insert([{a: 1, b: 1}, {a: 1, b: 2}, {a: 2, b: 3}, {a: 3, b: 3}]));
+assert.commandWorked(coll.insert([{a: 3, b: 4}, {a: 4, b: 1}, {a: 4, b: 5}]));
+
+result = coll.distinct("a", {a: {$gte: 1}, b: {$mod: [2, 0]}});
+assert.eq([1, 3], result.sort());
+explain = coll.explain("queryPlanner").distinct("a", {a: {$gte: 1}, b: {$mod: [2, 0]}});
+assert(planHasStage(db, explain.queryPlanner.winningPlan, "PROJECTION_COVERED"));
+assert(planHasStage(db, explain.queryPlanner.winningPlan, "DISTINCT_SCAN"));
 }());
@@ -178,4 +178,23 @@ lastHistogram = assertHistogramDiffEq(testColl, lastHistogram, 0, 0, 0);
 // Test non-command.
 assert.commandFailed(testColl.runCommand("IHopeNobodyEverMakesThisACommand"));
 lastHistogram = assertHistogramDiffEq(testColl, lastHistogram, 0, 0, 0);
+
+// Percentiles are reported in the order requested and never decrease.
+commandResult = testDB.runCommand({
+    aggregate: testColl.getName(),
+    pipeline: [{$collStats: {latencyStats: {percentiles: [50, 99, 99.9]}}}],
+    cursor: {}
+});
+assert.commandWorked(commandResult);
+var writes = commandResult.cursor.firstBatch[0].latencyStats.writes;
+assert.eq([50, 99, 99.9], writes.percentiles.map(p => p.percentile), tojson(writes));
+assert.lte(writes.percentiles[0].micros, writes.percentiles[1].micros, tojson(writes));
+assert.lte(writes.percentiles[1].micros, writes.percentiles[2].micros, tojson(writes));
+
+commandResult = testDB.runCommand({
+    aggregate: testColl.getName(),
+    pipeline: [{$collStats: {latencyStats: {percentiles: [0]}}}],
+    cursor: {}
+});
+assert.commandFailedWithCode(commandResult, 5212029);
 }());
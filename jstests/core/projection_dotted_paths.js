@@ -92,4 +92,12 @@ assert(isIndexOnly(db, explain.queryPlanner.winningPlan));
 // with nulls. This is a bug tracked by SERVER-23229.
 resultDoc = coll.findOne({a: 1}, {_id: 0, "x.y.y": 1, "x.y.z": 1, "x.z": 1});
 assert.eq(resultDoc, {x: {y: {y: null, z: null}, z: null}});
+
+// A dotted projection of a fetched document is applied by the simple fast path. It descends into
+// arrays, including nested ones, and drops the scalars it finds there or along the path.
+assert.commandWorked(coll.insert({a: 4, b: [1, {c: 1, d: 2}, [{c: 2}, 3]], e: {c: 1}, f: 5}));
+resultDoc = coll.findOne({a: 4}, {_id: 0, "b.c": 1, "e.d": 1, "f.g": 1});
+assert.eq(resultDoc, {b: [{c: 1}, [{c: 2}]], e: {}});
+explain = coll.find({a: 4}, {_id: 0, "b.c": 1, "e.d": 1, "f.g": 1}).explain("queryPlanner");
+assert(planHasStage(db, explain.queryPlanner.winningPlan, "PROJECTION_SIMPLE"), explain);
 }());
@@ -97,6 +97,7 @@ let viewsCommandTests = {
     _configsvrDropDatabase: {skip: isAnInternalCommand},
     _configsvrEnableSharding: {skip: isAnInternalCommand},
     _configsvrEnsureChunkVersionIsGreaterThan: {skip: isAnInternalCommand},
+    _configsvrGetChangedChunks: {skip: isAnInternalCommand},
     _configsvrMoveChunk: {skip: isAnInternalCommand},
     _configsvrMovePrimary: {skip: isAnInternalCommand},
     _configsvrRefineCollectionShardKey: {skip: isAnInternalCommand},
@@ -0,0 +1,71 @@
+/**
+ * Tests that $accumulator gives the same results, with accumulate called once per document in
+ * order, whether or not the accumulate calls are batched.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db.accumulator_js_batching;
+
+let bulk = coll.initializeOrderedBulkOp();
+for (let i = 0; i < 1000; ++i) {
+    bulk.insert({_id: i, group: i % 3});
+}
+assert.commandWorked(bulk.execute());
+
+const pipeline = [
+    {$sort: {_id: 1}},
+    {
+        $group: {
+            _id: "$group",
+            ids: {
+                $accumulator: {
+                    init: function(group) {
+                        return {group: group, ids: [], calls: 0};
+                    },
+                    initArgs: ["$group"],
+                    accumulate: function(state, id, group) {
+                        if (state.group !== group) {
+                            throw new Error("accumulate called with the wrong state");
+                        }
+                        state.ids.push(id);
+                        state.calls++;
+                        return state;
+                    },
+                    accumulateArgs: ["$_id", "$group"],
+                    merge: function(state1, state2) {
+                        return {
+                            group: state1.group,
+                            ids: state1.ids.concat(state2.ids),
+                            calls: state1.calls + state2.calls
+                        };
+                    },
+                    lang: "js",
+                }
+            }
+        }
+    },
+    {$sort: {_id: 1}},
+];
+
+function runWithBatchSize(batchSize) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryJavaScriptAccumulatorBatchSize: batchSize}));
+    return coll.aggregate(pipeline).toArray();
+}
+
+const unbatched = runWithBatchSize(1);
+assert.eq(3, unbatched.length);
+for (let group of unbatched) {
+    const expected = Array.from({length: 1000}, (_, i) => i).filter(i => i % 3 === group._id);
+    assert.eq(expected, group.ids.ids, tojson(group));
+    assert.eq(expected.length, group.ids.calls, tojson(group));
+}
+
+assert.eq(unbatched, runWithBatchSize(7));
+assert.eq(unbatched, runWithBatchSize(10000));
+
+MongoRunner.stopMongod(conn);
+})();
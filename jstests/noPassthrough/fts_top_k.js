@@ -0,0 +1,56 @@
+/**
+ * Tests that a $text query sorted by text score with a limit stops reading the text index once no
+ * unread document can make it into the top results, and that it returns the same scores as a
+ * full sort.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const conn = MongoRunner.runMongod();
+const coll = conn.getDB("test").fts_top_k;
+
+assert.commandWorked(coll.createIndex({title: "text", body: "text"}, {weights: {title: 10}}));
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 5; ++i) {
+    bulk.insert({_id: i, title: "alpha beta " + "alpha ".repeat(i), body: "gamma"});
+}
+for (let i = 5; i < 1000; ++i) {
+    bulk.insert({_id: i, title: "gamma", body: (i % 2 ? "alpha " : "beta ").repeat(i % 7 + 1)});
+}
+assert.commandWorked(bulk.execute());
+
+function scores(search, limit) {
+    let cursor = coll.find({$text: {$search: search}}, {score: {$meta: "textScore"}})
+                     .sort({score: {$meta: "textScore"}});
+    if (limit) {
+        cursor = cursor.limit(limit);
+    }
+    return cursor.toArray().map(doc => doc.score);
+}
+
+for (let search of ["alpha beta", "alpha", "alpha beta -gamma", "\"alpha beta\""]) {
+    for (let limit of [1, 5, 20]) {
+        assert.eq(scores(search).slice(0, limit), scores(search, limit), {search, limit});
+    }
+}
+
+// The five documents with both terms in the heavily weighted title are the top five, so only a
+// handful of documents have to be fetched and scored.
+const explain = coll.find({$text: {$search: "alpha beta"}}, {score: {$meta: "textScore"}})
+                    .sort({score: {$meta: "textScore"}})
+                    .limit(5)
+                    .explain("executionStats");
+const textOr = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+assert.neq(null, textOr, tojson(explain));
+assert.lt(textOr.docsExamined, 100, tojson(textOr));
+
+// Without a limit all of the matching documents are scored.
+const fullExplain = coll.find({$text: {$search: "alpha beta"}}, {score: {$meta: "textScore"}})
+                        .sort({score: {$meta: "textScore"}})
+                        .explain("executionStats");
+assert.eq(1000, getPlanStage(fullExplain.executionStats.executionStages, "TEXT_OR").docsExamined);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,51 @@
+/**
+ * Tests that, with internalQueryPlannerEnableIndexSkipScan set, a compound index can answer a
+ * query over its second field by seeking to each distinct value of the leading field, and that a
+ * collection scan wins when the leading field has too many distinct values.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const conn =
+    MongoRunner.runMongod({setParameter: {internalQueryPlannerEnableIndexSkipScan: true}});
+const coll = conn.getDB("test").index_skip_scan;
+
+assert.commandWorked(coll.createIndex({tenant: 1, ts: 1}));
+assert.commandWorked(coll.createIndex({uniq: 1, ts: 1}));
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 5000; ++i) {
+    bulk.insert({tenant: i % 4, uniq: i, ts: i});
+}
+assert.commandWorked(bulk.execute());
+
+// Four distinct tenants: the skip scan touches only the matching keys of each one.
+const query = {ts: {$gte: 100, $lt: 110}};
+assert.eq(10, coll.find(query).itcount());
+assert.eq(
+    coll.find(query).sort({ts: 1}).toArray(),
+    coll.find(query).hint({$natural: 1}).toArray().sort((a, b) => a.ts - b.ts));
+
+let explain = coll.find(query).hint({tenant: 1, ts: 1}).explain("executionStats");
+let ixscan = getPlanStage(explain.executionStats.executionStages, "IXSCAN");
+assert.neq(null, ixscan, tojson(explain));
+assert.eq(
+    {tenant: ["[MinKey, MaxKey]"], ts: ["[100.0, 110.0)"]}, ixscan.indexBounds, tojson(ixscan));
+assert.lt(ixscan.keysExamined, 100, tojson(ixscan));
+
+// With a distinct leading value per document, the trial period charges a seek per key and the
+// skip scan over {uniq: 1, ts: 1} must not be chosen over the {tenant: 1, ts: 1} one.
+explain = coll.find(query).explain();
+const winning = getPlanStage(explain.queryPlanner.winningPlan, "IXSCAN");
+assert.neq(null, winning, tojson(explain));
+assert.eq({tenant: 1, ts: 1}, winning.keyPattern, tojson(explain));
+
+// Disabling the knob returns to a collection scan.
+assert.commandWorked(
+    conn.adminCommand({setParameter: 1, internalQueryPlannerEnableIndexSkipScan: false}));
+explain = coll.find(query).explain();
+assert(isCollscan(conn.getDB("test"), explain.queryPlanner.winningPlan), tojson(explain));
+
+MongoRunner.stopMongod(conn);
+})();
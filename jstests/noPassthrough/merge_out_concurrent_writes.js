@@ -0,0 +1,48 @@
+/**
+ * Tests that, with internalDocumentSourceWriterMaxInFlightBatches set, $out and $merge write their
+ * batches concurrently and still produce every document, and that a failed batch fails the
+ * aggregation.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {internalDocumentSourceWriterMaxInFlightBatches: 4}});
+const db = conn.getDB("test");
+const source = db.merge_out_concurrent_writes;
+const target = db.merge_out_concurrent_writes_target;
+
+// Documents of 256KB split the output into batches of about 64 documents.
+const kNumDocs = 300;
+const padding = "x".repeat(256 * 1024);
+let bulk = source.initializeUnorderedBulkOp();
+for (let i = 0; i < kNumDocs; ++i) {
+    bulk.insert({_id: i, padding: padding});
+}
+assert.commandWorked(bulk.execute());
+
+source.aggregate([{$out: target.getName()}]);
+assert.eq(kNumDocs, target.find().itcount());
+
+source.aggregate([
+    {$project: {padding: 1, updated: {$literal: true}}},
+    {$merge: {into: target.getName(), whenMatched: "replace", whenNotMatched: "fail"}}
+]);
+assert.eq(kNumDocs, target.find({updated: true}).itcount());
+
+// Documents missing from the target fail the batch they are in, and with it the aggregation.
+assert.commandWorked(target.remove({_id: {$gte: kNumDocs - 10}}));
+const res = db.runCommand({
+    aggregate: source.getName(),
+    pipeline: [{$merge: {into: target.getName(), whenMatched: "replace", whenNotMatched: "fail"}}],
+    cursor: {}
+});
+assert.commandFailedWithCode(res, ErrorCodes.MergeStageNoMatchingDocument);
+
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalDocumentSourceWriterMaxInFlightBatches: 0}));
+source.aggregate([{$out: target.getName()}]);
+assert.eq(kNumDocs, target.find().itcount());
+
+MongoRunner.stopMongod(conn);
+})();
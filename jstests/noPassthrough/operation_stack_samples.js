@@ -0,0 +1,49 @@
+/**
+ * Tests that, with operationStackSamplingIntervalMillis set, the stacks of running operations are
+ * sampled and served by the $operationStackSamples stage, tagged with the command and query hash.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/parallel_shell_helpers.js");
+
+const conn = MongoRunner.runMongod({setParameter: {operationStackSamplingIntervalMillis: 10}});
+const db = conn.getDB("test");
+const adminDB = conn.getDB("admin");
+const coll = db.operation_stack_samples;
+for (let i = 0; i < 20; ++i) {
+    assert.commandWorked(coll.insert({_id: i}));
+}
+
+// The stage runs on the admin database only, as a collectionless aggregate.
+assert.commandFailedWithCode(
+    db.runCommand({aggregate: 1, pipeline: [{$operationStackSamples: {}}], cursor: {}}),
+    ErrorCodes.InvalidNamespace);
+
+function runSlowFind(collName) {
+    assert.eq(20,
+              db.getSiblingDB("test")[collName]
+                  .find({$where: "sleep(50); return true;"})
+                  .batchSize(100)
+                  .itcount());
+}
+const awaitFind = startParallelShell(funWithArgs(runSlowFind, coll.getName()), conn.port);
+awaitFind();
+
+// Samples are only taken on platforms whose unwinder can run in a signal handler.
+const stats = assert.commandWorked(adminDB.runCommand({serverStatus: 1})).operationStackSampling;
+assert.neq(undefined, stats);
+if (stats.samples > 0) {
+    const samples =
+        adminDB.aggregate([{$operationStackSamples: {}}, {$match: {command: "find"}}]).toArray();
+    assert.gt(samples.length, 0, tojson(stats));
+    for (let sample of samples) {
+        assert.gt(sample.samples, 0, tojson(sample));
+        assert.gt(sample.stack.length, 0, tojson(sample));
+    }
+    // Samples taken before planning aren't tagged with a query hash, but most are.
+    assert(samples.some(sample => typeof sample.queryHash === "string"), tojson(samples));
+}
+
+MongoRunner.stopMongod(conn);
+})();
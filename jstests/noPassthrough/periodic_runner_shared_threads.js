@@ -0,0 +1,32 @@
+/**
+ * Tests that, with periodicRunnerSharedThreadCount set, the server's periodic jobs keep running on
+ * the shared threads and report their runs in the periodicJobs serverStatus section.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter: {periodicRunnerSharedThreadCount: 2, logicalSessionRefreshMillis: 100},
+});
+const admin = conn.getDB("admin");
+
+assert.eq(undefined, assert.commandWorked(admin.runCommand({serverStatus: 1})).periodicJobs);
+
+function getJobStats(name) {
+    const section = assert.commandWorked(admin.runCommand({serverStatus: 1, periodicJobs: 1}))
+                        .periodicJobs;
+    assert.eq(2, section.sharedThreads, tojson(section));
+    return section.jobs.find(job => job.name === name);
+}
+
+// The logical session cache refresh is a PeriodicRunner job on every mongod.
+assert.soon(() => {
+    const stats = getJobStats("LogicalSessionCacheRefresh");
+    return stats && stats.runs > 2;
+});
+
+const stats = getJobStats("LogicalSessionCacheRefresh");
+assert.gte(stats.totalMillis, stats.lastMillis, tojson(stats));
+
+MongoRunner.stopMongod(conn);
+})();
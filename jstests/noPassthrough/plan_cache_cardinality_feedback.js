@@ -0,0 +1,47 @@
+/**
+ * Tests that, with internalQueryCacheCardinalityFeedback set, trials of a cached plan record the
+ * works and results they observed in the plan cache entry, and that $planCacheStats reports them.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryCacheCardinalityFeedback: true}});
+const coll = conn.getDB("test").plan_cache_cardinality_feedback;
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; ++i) {
+    bulk.insert({a: i % 10, b: i % 100});
+}
+assert.commandWorked(bulk.execute());
+
+function getCacheEntry() {
+    const entries = coll.aggregate([{$planCacheStats: {}}]).toArray();
+    assert.eq(1, entries.length, tojson(entries));
+    return entries[0];
+}
+
+// The first run creates an inactive entry, the second activates it and the later ones run its
+// plan for a trial period.
+for (let i = 0; i < 4; ++i) {
+    assert.eq(10, coll.find({a: 1, b: 1}).itcount());
+}
+let entry = getCacheEntry();
+assert(entry.isActive, tojson(entry));
+assert.gte(entry.cardinalityFeedback.trials, 2, tojson(entry));
+assert.gt(entry.cardinalityFeedback.avgTrialWorks, 0, tojson(entry));
+assert.gt(entry.cardinalityFeedback.avgTrialSelectivity, 0, tojson(entry));
+assert.eq(0, entry.cardinalityFeedback.unchangedReplans, tojson(entry));
+
+// Without the knob no feedback is recorded.
+assert.commandWorked(coll.getDB().runCommand({planCacheClear: coll.getName()}));
+assert.commandWorked(
+    conn.adminCommand({setParameter: 1, internalQueryCacheCardinalityFeedback: false}));
+for (let i = 0; i < 4; ++i) {
+    assert.eq(10, coll.find({a: 1, b: 1}).itcount());
+}
+entry = getCacheEntry();
+assert.eq(undefined, entry.cardinalityFeedback, tojson(entry));
+
+MongoRunner.stopMongod(conn);
+})();
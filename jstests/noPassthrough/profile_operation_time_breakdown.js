@@ -0,0 +1,64 @@
+/**
+ * Tests that profiler entries break an operation's time down into CPU time, time queued for an
+ * execution ticket and time blocked on prepare conflicts.
+ *
+ * @tags: [requires_profiling, requires_wiredtiger, uses_transactions, uses_prepare_transaction]
+ */
+(function() {
+"use strict";
+
+load("jstests/core/txns/libs/prepare_helpers.js");
+load("jstests/libs/parallel_shell_helpers.js");
+
+// A single read ticket lets a reader blocked on a prepare conflict hold up the next one.
+const rst = new ReplSetTest(
+    {nodes: 1, nodeOptions: {setParameter: {wiredTigerConcurrentReadTransactions: 1}}});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const db = primary.getDB("test");
+const coll = db.profile_operation_time_breakdown;
+assert.commandWorked(coll.insert({_id: 1}));
+assert.commandWorked(db.other.insert({_id: 1}));
+assert.commandWorked(db.setProfilingLevel(2));
+
+const session = primary.startSession();
+session.startTransaction();
+assert.commandWorked(session.getDatabase("test")[coll.getName()].update({_id: 1}, {$set: {a: 1}}));
+PrepareHelpers.prepareTransaction(session);
+
+function runFind(collName, comment) {
+    assert.commandWorked(db.getSiblingDB("test").runCommand({find: collName, comment: comment}));
+}
+
+function waitForOp(comment, extraFilter) {
+    assert.soon(() => primary.getDB("admin")
+                          .aggregate([
+                              {$currentOp: {}},
+                              {$match: Object.assign({"command.comment": comment}, extraFilter)}
+                          ])
+                          .itcount() === 1);
+}
+
+const blocked = startParallelShell(funWithArgs(runFind, coll.getName(), "blocked"), primary.port);
+waitForOp("blocked", {prepareReadConflicts: {$gt: 0}});
+const queued = startParallelShell(funWithArgs(runFind, "other", "queued"), primary.port);
+waitForOp("queued", {});
+
+assert.commandWorked(session.abortTransaction_forTesting());
+blocked();
+queued();
+
+const blockedEntry = db.system.profile.findOne({"command.comment": "blocked"});
+assert.gt(blockedEntry.prepareConflictDurationMillis, 0, tojson(blockedEntry));
+const queuedEntry = db.system.profile.findOne({"command.comment": "queued"});
+assert.gt(queuedEntry.ticketQueueMicros, 0, tojson(queuedEntry));
+
+if (db.serverBuildInfo().buildEnvironment.target_os === "linux") {
+    assert.gt(blockedEntry.cpuNanos, 0, tojson(blockedEntry));
+    assert.gt(queuedEntry.cpuNanos, 0, tojson(queuedEntry));
+}
+
+rst.stopSet();
+})();
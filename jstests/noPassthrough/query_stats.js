@@ -0,0 +1,58 @@
+/**
+ * Tests that completed queries are aggregated by namespace and query shape and served by the
+ * $queryStats stage, and that queryShapeStatsMaxEntries bounds the number of shapes tracked.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const adminDB = conn.getDB("admin");
+const coll = db.query_stats;
+assert.commandWorked(coll.createIndex({a: 1}));
+for (let i = 0; i < 20; ++i) {
+    assert.commandWorked(coll.insert({_id: i, a: i % 5}));
+}
+
+// The stage runs on the admin database only, as a collectionless aggregate.
+assert.commandFailedWithCode(
+    db.runCommand({aggregate: 1, pipeline: [{$queryStats: {}}], cursor: {}}),
+    ErrorCodes.InvalidNamespace);
+
+const queryHash = coll.find({a: 1}).explain().queryPlanner.queryHash;
+function getEntries() {
+    return adminDB
+        .aggregate([{$queryStats: {}}, {$match: {ns: coll.getFullName(), queryHash: queryHash}}])
+        .toArray();
+}
+const before = getEntries();
+const execCountBefore = before.length ? before[0].execCount : 0;
+
+// Two queries of the same shape, differing only in their constants.
+assert.eq(4, coll.find({a: 1}).itcount());
+assert.eq(4, coll.find({a: 2}).itcount());
+
+let entries = getEntries();
+assert.eq(1, entries.length, tojson(entries));
+const entry = entries[0];
+assert.eq(execCountBefore + 2, entry.execCount, tojson(entry));
+assert.gte(entry.nreturned, 8, tojson(entry));
+assert.gte(entry.keysExamined, 8, tojson(entry));
+assert.gte(entry.docsExamined, 8, tojson(entry));
+assert.gt(entry.bytesReturned, 0, tojson(entry));
+assert.gte(entry.maxExecMicros, entry.execMicrosPercentiles.p50, tojson(entry));
+assert.lte(entry.firstSeen, entry.lastSeen, tojson(entry));
+
+// Once the table is full, executions of new shapes are dropped.
+const stats = assert.commandWorked(adminDB.runCommand({serverStatus: 1})).queryShapeStats;
+assert.commandWorked(
+    adminDB.runCommand({setParameter: 1, queryShapeStatsMaxEntries: NumberInt(stats.shapes)}));
+assert.eq(20, coll.find({_id: {$gte: 0}, a: {$exists: true}}).itcount());
+entries = adminDB.aggregate([{$queryStats: {}}]).toArray();
+assert.eq(stats.shapes, entries.length, tojson(entries));
+assert.gt(
+    assert.commandWorked(adminDB.runCommand({serverStatus: 1})).queryShapeStats.droppedExecutions,
+    stats.droppedExecutions);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,46 @@
+/**
+ * Tests that, with internalQuerySampleBlockSize set, $sample answered from the random cursor draws
+ * distinct documents from every part of the collection, and that the sample is exact in size.
+ *
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For aggPlanHasStage.
+
+const conn = MongoRunner.runMongod({setParameter: {internalQuerySampleBlockSize: 1000}});
+const db = conn.getDB("test");
+const coll = db.sample_block_sampling;
+
+const kNumDocs = 10000;
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < kNumDocs; ++i) {
+    bulk.insert({_id: i, padding: "x".repeat(i % 2 === 0 ? 10 : 2000)});
+}
+assert.commandWorked(bulk.execute());
+
+const explain = coll.explain().aggregate([{$sample: {size: 100}}]);
+assert(aggPlanHasStage(explain, "$sampleFromRandomCursor"), tojson(explain));
+
+// Blocks larger than the strata read the whole collection in order, so each tenth of it should
+// provide about a tenth of every sample, whatever the size of its documents.
+const countsPerTenth = new Array(10).fill(0);
+for (let run = 0; run < 20; ++run) {
+    const ids = coll.aggregate([{$sample: {size: 100}}, {$project: {_id: 1}}])
+                    .toArray()
+                    .map(doc => doc._id);
+    assert.eq(100, ids.length);
+    assert.eq(100, new Set(ids).size, tojson(ids));
+    ids.forEach(id => ++countsPerTenth[Math.floor(id / (kNumDocs / 10))]);
+}
+countsPerTenth.forEach(count => assert.between(120, count, 280, tojson(countsPerTenth)));
+
+// Small blocks still return exactly the requested number of distinct documents.
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQuerySampleBlockSize: 2}));
+const ids = coll.aggregate([{$sample: {size: 200}}]).toArray().map(doc => doc._id);
+assert.eq(200, ids.length);
+assert.eq(200, new Set(ids).size, tojson(ids));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,39 @@
+/**
+ * Tests that a rolling traffic recording keeps recording past maxFileSize by moving the full file
+ * to '<filename>.previous', and that both files can be read on their own.
+ */
+(function() {
+"use strict";
+
+const recordingDir = MongoRunner.toRealDir("$dataDir/traffic_recording_rolling/");
+const recordingFilePath = MongoRunner.toRealDir(recordingDir + "/recording.txt");
+mkdir(recordingDir);
+
+const conn = MongoRunner.runMongod({setParameter: {trafficRecordingDirectory: recordingDir}});
+const adminDB = conn.getDB("admin");
+const coll = conn.getDB("test").traffic_recording_rolling;
+
+const maxFileSize = 64 * 1024;
+assert.commandWorked(adminDB.runCommand(
+    {startRecordingTraffic: 1, filename: "recording.txt", maxFileSize: maxFileSize, rolling: true}));
+assert(adminDB.serverStatus().trafficRecording.rolling);
+
+// Record several times maxFileSize worth of traffic.
+const doc = {payload: "x".repeat(1024)};
+for (let i = 0; i < 4 * maxFileSize / 1024; ++i) {
+    assert.commandWorked(coll.insert(doc));
+}
+
+const stats = adminDB.serverStatus().trafficRecording;
+assert(stats.running, tojson(stats));
+assert.lt(stats.currentFileSize, maxFileSize, tojson(stats));
+
+assert.commandWorked(adminDB.runCommand({stopRecordingTraffic: 1}));
+MongoRunner.stopMongod(conn);
+
+for (let path of [recordingFilePath, recordingFilePath + ".previous"]) {
+    const records = convertTrafficRecordingToBSON(path);
+    assert.gt(records.length, 0, path);
+    assert(records.some(record => record.opType === "insert"), path);
+}
+})();
@@ -0,0 +1,56 @@
+/**
+ * Tests that the TTL monitor deletes expired documents in batches of ttlIndexDeleteBatchSize,
+ * defers the remaining batches to the next pass while the storage engine cache is under pressure,
+ * and reports its progress and backlog in serverStatus.
+ *
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+// A cache pressure threshold of 0 makes every check report the cache as under pressure.
+const conn = MongoRunner.runMongod({
+    setParameter:
+        {ttlMonitorSleepSecs: 1, ttlIndexDeleteBatchSize: 10, cachePressureThreshold: 0}
+});
+const db = conn.getDB("test");
+
+function ttlMetrics() {
+    return db.serverStatus().metrics.ttl;
+}
+
+const kCollections = 3;
+const kDocs = 45;
+const expired = new Date(0);
+for (let i = 0; i < kCollections; ++i) {
+    const coll = db["ttl_batched_deletes_" + i];
+    assert.commandWorked(coll.createIndex({x: 1}, {expireAfterSeconds: 0}));
+    assert.commandWorked(
+        coll.insert(Array.from({length: kDocs}, (_, j) => ({_id: j, x: expired}))));
+}
+
+// Under cache pressure, each pass deletes one batch per index and leaves the rest as backlog.
+assert.soon(() => ttlMetrics().indexesWithBacklog === kCollections, tojson(ttlMetrics()));
+let metrics = ttlMetrics();
+assert.gte(metrics.throttledBatches, kCollections, tojson(metrics));
+for (let i = 0; i < kCollections; ++i) {
+    assert.gt(db["ttl_batched_deletes_" + i].count(), 0);
+}
+
+// Without pressure the monitor catches up, still in batches of ten documents.
+assert.commandWorked(db.adminCommand({setParameter: 1, cachePressureThreshold: 95}));
+assert.soon(() => {
+    for (let i = 0; i < kCollections; ++i) {
+        if (db["ttl_batched_deletes_" + i].count() !== 0) {
+            return false;
+        }
+    }
+    return true;
+});
+assert.soon(() => ttlMetrics().indexesWithBacklog === 0, tojson(ttlMetrics()));
+metrics = ttlMetrics();
+assert.gte(metrics.deletedDocuments, kCollections * kDocs, tojson(metrics));
+assert.gte(metrics.batches, kCollections * Math.ceil(kDocs / 10), tojson(metrics));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,47 @@
+/**
+ * Tests that, with internalInsertUnacknowledgedMaxBatchSize set, a w:0 insert commits its
+ * documents in fewer storage transactions, and that acknowledged inserts are unaffected.
+ *
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {internalInsertMaxBatchSize: 10}});
+const db = conn.getDB("test");
+const coll = db.unacknowledged_insert_batch_size;
+assert.commandWorked(coll.insert({_id: -1}));
+
+const nDocs = 1000;
+let nextId = 0;
+
+function transactionsCommitted() {
+    return db.serverStatus().wiredTiger.transaction["transactions committed"];
+}
+
+function commitsForInsert(writeConcern) {
+    const docs = [];
+    for (let i = 0; i < nDocs; ++i) {
+        docs.push({_id: nextId++});
+    }
+    const before = transactionsCommitted();
+    assert.commandWorked(
+        db.runCommand({insert: coll.getName(), documents: docs, writeConcern: writeConcern}));
+    // An unacknowledged insert has finished by the time the next command on the connection runs.
+    assert.eq(nextId + 1, coll.find().itcount());
+    return transactionsCommitted() - before;
+}
+
+const defaultCommits = commitsForInsert({w: 0});
+assert.gte(defaultCommits, nDocs / 10, "commits: " + defaultCommits);
+
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalInsertUnacknowledgedMaxBatchSize: nDocs}));
+const batchedCommits = commitsForInsert({w: 0});
+assert.lt(batchedCommits, defaultCommits / 2, "commits: " + batchedCommits);
+
+const acknowledgedCommits = commitsForInsert({w: 1});
+assert.gte(acknowledgedCommits, nDocs / 10, "commits: " + acknowledgedCommits);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,53 @@
+/**
+ * Tests that the in-memory filter used to skip duplicate key searches on unique indexes never lets
+ * a duplicate key in, including for keys inserted before a restart, and that its statistics are
+ * reported by $indexStats.
+ *
+ * @tags: [requires_persistence, requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+const options = {setParameter: {wiredTigerUniqueIndexKeyFilterBitsPerKey: 10}};
+let conn = MongoRunner.runMongod(options);
+let coll = conn.getDB("test").unique_index_duplicate_key_filter;
+
+assert.commandWorked(coll.createIndex({a: 1}, {unique: true}));
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; ++i) {
+    bulk.insert({a: i});
+}
+assert.commandWorked(bulk.execute());
+
+for (let i = 0; i < 1000; i += 100) {
+    assert.commandFailedWithCode(coll.insert({a: i}), ErrorCodes.DuplicateKey);
+}
+
+function getFilterStats() {
+    const stats = coll.aggregate([{$indexStats: {}}, {$match: {name: "a_1"}}]).toArray();
+    assert.eq(1, stats.length, tojson(stats));
+    return stats[0].duplicateKeyFilter;
+}
+
+let filterStats = getFilterStats();
+assert(filterStats, "missing duplicateKeyFilter in $indexStats");
+// Most of the inserts skipped the search. The rest were false positives.
+assert.gte(filterStats.negatives, 900, tojson(filterStats));
+
+// The filter of the restarted node is populated from the keys already in the index.
+MongoRunner.stopMongod(conn);
+conn = MongoRunner.runMongod(Object.merge(options, {dbpath: conn.dbpath, noCleanData: true}));
+coll = conn.getDB("test").unique_index_duplicate_key_filter;
+
+for (let i = 0; i < 1000; i += 100) {
+    assert.commandFailedWithCode(coll.insert({a: i}), ErrorCodes.DuplicateKey);
+}
+assert.commandWorked(coll.insert({a: 1000}));
+
+filterStats = getFilterStats();
+assert.eq(1001, filterStats.keys, tojson(filterStats));
+assert.eq(11, filterStats.checks, tojson(filterStats));
+assert.lte(filterStats.negatives, 1, tojson(filterStats));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,52 @@
+/**
+ * Tests that update commands whose statements update by _id, and so share collection lock
+ * acquisitions across internalUpdateMaxBatchSize statements, keep per-statement results when
+ * mixed with upserts that create the collection, multi-updates and failing statements.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {internalUpdateMaxBatchSize: 2}});
+const db = conn.getDB("test");
+const coll = db.update_id_batch_lock;
+coll.drop();
+
+// The first upsert creates the collection; the following ones then run under a batch lock.
+let res = assert.commandWorked(db.runCommand({
+    update: coll.getName(),
+    updates: [
+        {q: {_id: 0}, u: {$set: {a: 0}}, upsert: true},
+        {q: {_id: 1}, u: {$set: {a: 1}}, upsert: true},
+        {q: {_id: 2}, u: {$set: {a: 2}}, upsert: true},
+        {q: {_id: 0}, u: {$inc: {a: 10}}},
+        {q: {_id: 3}, u: {$set: {a: 3}}},
+    ]
+}));
+assert.eq(4, res.n, tojson(res));
+assert.eq(1, res.nModified, tojson(res));
+assert.eq([0, 1, 2], res.upserted.map(u => u._id), tojson(res));
+assert.eq([{_id: 0, a: 10}, {_id: 1, a: 1}, {_id: 2, a: 2}], coll.find().sort({_id: 1}).toArray());
+
+// A failing statement in an unordered batch doesn't stop the statements after it, and a
+// multi-update between _id updates sees their effects.
+res = db.runCommand({
+    update: coll.getName(),
+    ordered: false,
+    updates: [
+        {q: {_id: 1}, u: {$set: {b: 1}}},
+        {q: {_id: 2}, u: {$set: {_id: 20}}},
+        {q: {_id: 2}, u: {$set: {b: 2}}},
+        {q: {b: {$exists: true}}, u: {$inc: {b: 100}}, multi: true},
+        {q: {_id: 0}, u: {$set: {b: 0}}},
+    ]
+});
+assert.commandWorked(res);
+assert.eq(1, res.writeErrors.length, tojson(res));
+assert.eq(1, res.writeErrors[0].index, tojson(res));
+assert.eq(ErrorCodes.ImmutableField, res.writeErrors[0].code, tojson(res));
+assert.eq(5, res.n, tojson(res));
+assert.eq([{_id: 0, a: 10, b: 0}, {_id: 1, a: 1, b: 101}, {_id: 2, a: 2, b: 102}],
+          coll.find().sort({_id: 1}).toArray());
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,49 @@
+/**
+ * Tests that updates which leave a document's layout unchanged are written to WiredTiger as
+ * modifications of the existing record, including when they change indexed fields and when a
+ * $push trims the array back to its previous size.
+ *
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db.update_in_place_damages;
+
+// Documents under 1KB are rewritten whole unless the update applies in place.
+assert.commandWorked(
+    coll.insert({_id: 0, counter: NumberInt(0), recent: [1, 2, 3], pad: "x".repeat(100)}));
+assert.commandWorked(coll.createIndex({counter: 1}));
+assert.commandWorked(coll.createIndex({recent: 1}));
+
+function modifyCalls() {
+    return db.serverStatus().wiredTiger.cursor["cursor modify calls"];
+}
+
+const nUpdates = 50;
+let before = modifyCalls();
+for (let i = 0; i < nUpdates; ++i) {
+    assert.commandWorked(coll.update({_id: 0}, {$inc: {counter: NumberInt(1)}}));
+}
+assert.gte(modifyCalls() - before, nUpdates);
+
+before = modifyCalls();
+for (let i = 0; i < nUpdates; ++i) {
+    assert.commandWorked(coll.update({_id: 0}, {$push: {recent: {$each: [4 + i], $slice: -3}}}));
+}
+assert.gte(modifyCalls() - before, nUpdates);
+
+// The index entries follow the in-place updates.
+const expected =
+    [{_id: 0, counter: NumberInt(nUpdates), recent: [nUpdates + 1, nUpdates + 2, nUpdates + 3]}];
+assert.eq(expected, coll.find({counter: nUpdates}, {pad: 0}).hint({counter: 1}).toArray());
+assert.eq(expected, coll.find({recent: nUpdates + 3}, {pad: 0}).hint({recent: 1}).toArray());
+assert.eq(0, coll.find({counter: nUpdates - 1}).hint({counter: 1}).itcount());
+assert.eq(0, coll.find({recent: 3}).hint({recent: 1}).itcount());
+assert.commandWorked(coll.validate({full: true}));
+assert(coll.validate({full: true}).valid);
+
+MongoRunner.stopMongod(conn);
+})();
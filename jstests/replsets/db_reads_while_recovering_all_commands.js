@@ -42,6 +42,7 @@ const allCommands = {
     _configsvrDropDatabase: {skip: isPrimaryOnly},
     _configsvrEnableSharding: {skip: isPrimaryOnly},
     _configsvrEnsureChunkVersionIsGreaterThan: {skip: isPrimaryOnly},
+    _configsvrGetChangedChunks: {skip: isAnInternalCommand},
     _configsvrMoveChunk: {skip: isPrimaryOnly},
     _configsvrMovePrimary: {skip: isPrimaryOnly},
     _configsvrRefineCollectionShardKey: {skip: isPrimaryOnly},
@@ -0,0 +1,83 @@
+/**
+ * Tests that, with storeFindAndModifyImagesInSideCollection set, a retryable findAndModify stores
+ * its pre- or post-image in config.image_collection instead of a no-op oplog entry, that
+ * secondaries rebuild the same image while applying the write, and that retries are answered
+ * from it, including after failover.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/retryable_writes_util.js");
+
+if (!RetryableWritesUtil.storageEngineSupportsRetryableWrites(jsTest.options().storageEngine)) {
+    jsTestLog("Retryable writes are not supported, skipping test");
+    return;
+}
+
+const rst = new ReplSetTest({
+    nodes: 2,
+    nodeOptions: {setParameter: {storeFindAndModifyImagesInSideCollection: true}},
+});
+rst.startSet();
+rst.initiate();
+
+let primary = rst.getPrimary();
+let testDB = primary.getDB("test");
+const coll = testDB.find_and_modify_image_collection;
+assert.commandWorked(coll.insert([{_id: 1, a: 1}, {_id: 2, a: 1}]));
+
+const lsid = {id: UUID()};
+let txnNumber = 0;
+
+function runAndRetry(cmd) {
+    cmd = Object.assign({lsid: lsid, txnNumber: NumberLong(++txnNumber)}, cmd);
+    const result = assert.commandWorked(testDB.runCommand(cmd));
+    const retryResult = assert.commandWorked(testDB.runCommand(cmd));
+    assert.eq(result.value, retryResult.value);
+    assert.eq(result.lastErrorObject, retryResult.lastErrorObject);
+    return {cmd: cmd, result: result};
+}
+
+function checkImage(node, expectedKind, expectedImage) {
+    const image = node.getDB("config").image_collection.findOne({"_id.id": lsid.id});
+    assert.neq(null, image, node.host);
+    assert.eq(NumberLong(txnNumber), image.txnNum, tojson(image));
+    assert.eq(expectedKind, image.imageKind, tojson(image));
+    assert.docEq(expectedImage, image.image, tojson(image));
+
+    const oplog = node.getDB("local").oplog.rs;
+    const writeEntry = oplog.findOne({ns: coll.getFullName(), txnNumber: NumberLong(txnNumber)});
+    assert.eq(expectedKind, writeEntry.needsRetryImage, tojson(writeEntry));
+    assert.eq(undefined, writeEntry.preImageOpTime, tojson(writeEntry));
+    assert.eq(undefined, writeEntry.postImageOpTime, tojson(writeEntry));
+    assert.eq(0,
+              oplog.find({op: "n", ns: coll.getFullName(), txnNumber: NumberLong(txnNumber)})
+                  .itcount());
+}
+
+let res = runAndRetry({findAndModify: coll.getName(), query: {_id: 1}, update: {$inc: {a: 1}}});
+assert.docEq({_id: 1, a: 1}, res.result.value);
+rst.awaitReplication();
+rst.nodes.forEach(node => checkImage(node, "preImage", {_id: 1, a: 1}));
+
+res = runAndRetry(
+    {findAndModify: coll.getName(), query: {_id: 1}, update: {$inc: {a: 1}}, new: true});
+assert.docEq({_id: 1, a: 3}, res.result.value);
+rst.awaitReplication();
+rst.nodes.forEach(node => checkImage(node, "postImage", {_id: 1, a: 3}));
+
+const lastRemove = runAndRetry({findAndModify: coll.getName(), query: {_id: 2}, remove: true});
+assert.docEq({_id: 2, a: 1}, lastRemove.result.value);
+rst.awaitReplication();
+rst.nodes.forEach(node => checkImage(node, "preImage", {_id: 2, a: 1}));
+
+// The new primary answers the retry from its own copy of the image.
+assert.commandWorked(primary.adminCommand({replSetStepDown: 60, force: true}));
+primary = rst.getPrimary();
+testDB = primary.getDB("test");
+const retryResult = assert.commandWorked(testDB.runCommand(lastRemove.cmd));
+assert.eq(lastRemove.result.value, retryResult.value);
+assert.eq(1, testDB.find_and_modify_image_collection.find().itcount());
+
+rst.stopSet();
+})();
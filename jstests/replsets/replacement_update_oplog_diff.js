@@ -0,0 +1,50 @@
+/**
+ * Tests that, with logReplacementUpdatesAsDiffs set, replacement-style and pipeline-style updates
+ * of large documents write $set/$unset oplog entries, and that secondaries apply them to the same
+ * documents as the primary.
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest(
+    {nodes: 2, nodeOptions: {setParameter: {logReplacementUpdatesAsDiffs: true}}});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const db = primary.getDB("test");
+const coll = db.replacement_update_oplog_diff;
+const padding = "x".repeat(1000);
+assert.commandWorked(coll.insert({_id: 0, a: 1, b: {c: 1, d: 1}, pad: padding}));
+assert.commandWorked(coll.insert({_id: 1, a: 1, pad: padding}));
+
+function lastOplogEntry(id) {
+    return primary.getDB("local")
+        .oplog.rs.find({ns: coll.getFullName(), op: "u", "o2._id": id})
+        .sort({$natural: -1})
+        .limit(1)
+        .next();
+}
+
+// A replacement changing a nested field, removing one and adding one at the end.
+assert.commandWorked(coll.update({_id: 0}, {a: 1, b: {c: 2}, pad: padding, z: 1}));
+let entry = lastOplogEntry(0);
+assert.eq({$v: 1, $set: {"b.c": 2, z: 1}, $unset: {"b.d": true}}, entry.o, tojson(entry));
+
+// A pipeline update.
+assert.commandWorked(coll.update({_id: 1}, [{$set: {a: {$add: ["$a", 1]}}}]));
+entry = lastOplogEntry(1);
+assert.eq({$v: 1, $set: {a: 2}}, entry.o, tojson(entry));
+
+// A replacement that reorders fields can't be diffed and is logged whole.
+assert.commandWorked(coll.update({_id: 1}, {pad: padding, a: 3}));
+entry = lastOplogEntry(1);
+assert.eq({_id: 1, pad: padding, a: 3}, entry.o, tojson(entry));
+
+rst.awaitReplication();
+const secondaryColl = rst.getSecondary().getDB("test")[coll.getName()];
+assert.eq(coll.find().sort({_id: 1}).toArray(), secondaryColl.find().sort({_id: 1}).toArray());
+rst.checkReplicatedDataHashes();
+
+rst.stopSet();
+})();
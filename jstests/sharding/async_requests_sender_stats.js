@@ -0,0 +1,42 @@
+/**
+ * Tests that mongos reports how many shards each AsyncRequestsSender targeted, per-shard response
+ * counts and times, and how long catalog cache refreshes took, in the shardingStatistics
+ * serverStatus section that FTDC collects.
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({shards: 2});
+const mongos = st.s;
+const testDb = mongos.getDB("test");
+
+assert.commandWorked(mongos.adminCommand({enableSharding: "test"}));
+st.ensurePrimaryShard("test", st.shard0.shardName);
+assert.commandWorked(mongos.adminCommand({shardCollection: "test.coll", key: {x: 1}}));
+assert.commandWorked(mongos.adminCommand({split: "test.coll", middle: {x: 0}}));
+assert.commandWorked(mongos.adminCommand(
+    {moveChunk: "test.coll", find: {x: 0}, to: st.shard1.shardName, _waitForDelete: true}));
+assert.commandWorked(testDb.coll.insert([{x: -1}, {x: 1}]));
+
+function getStats() {
+    return assert.commandWorked(testDb.serverStatus()).shardingStatistics;
+}
+
+const before = getStats().asyncRequestsSender;
+assert.eq(2, testDb.coll.find().itcount());
+const after = getStats().asyncRequestsSender;
+
+assert.gt(after.fanout["2"], before.fanout["2"], tojson(after));
+for (let shardName of [st.shard0.shardName, st.shard1.shardName]) {
+    const shardBefore = before.shards[shardName] || {numResponses: 0};
+    assert.gt(after.shards[shardName].numResponses, shardBefore.numResponses, tojson(after));
+    assert.gte(after.shards[shardName].totalResponseTimeMicros, 0, tojson(after));
+}
+
+const catalogCache = getStats().catalogCache;
+assert.gt(catalogCache.countFullRefreshesStarted, 0, tojson(catalogCache));
+assert.gte(catalogCache.totalFullRefreshTimeMicros, 0, tojson(catalogCache));
+assert(catalogCache.hasOwnProperty("totalIncrementalRefreshTimeMicros"), tojson(catalogCache));
+
+st.stop();
+})();
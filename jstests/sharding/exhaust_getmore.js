@@ -0,0 +1,46 @@
+/**
+ * Tests that mongos streams getMore batches to a client that allows exhaust, merging the results of
+ * every shard, so that the client sends no getMore after the first.
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({shards: 2, mongos: 1});
+const mongosDB = st.s.getDB("test");
+const coll = mongosDB.exhaust_getmore;
+
+st.shardColl(coll, {_id: 1}, {_id: 50}, {_id: 50}, mongosDB.getName());
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 100; ++i) {
+    bulk.insert({_id: i});
+}
+assert.commandWorked(bulk.execute());
+
+function bytesReceivedByMongos() {
+    return assert.commandWorked(mongosDB.adminCommand({serverStatus: 1})).network.physicalBytesIn;
+}
+
+function runFind(exhaust) {
+    let cursor = coll.find().sort({_id: 1}).batchSize(2);
+    if (exhaust) {
+        cursor = cursor.addOption(DBQuery.Option.exhaust);
+    }
+    const before = bytesReceivedByMongos();
+    const docs = cursor.toArray();
+    return {docs: docs, bytesIn: bytesReceivedByMongos() - before};
+}
+
+const expected = Array.from({length: 100}, (_, i) => ({_id: i}));
+const normal = runFind(false);
+assert.eq(expected, normal.docs);
+const exhaust = runFind(true);
+assert.eq(expected, exhaust.docs);
+
+// Both runs receive the same replies from the shards, but without exhaust the client also sends
+// each of the 49 getMores itself, rather than just the first.
+assert.gt(normal.bytesIn - exhaust.bytesIn,
+          40 * 80,
+          {normal: normal.bytesIn, exhaust: exhaust.bytesIn});
+
+st.stop();
+})();
@@ -0,0 +1,52 @@
+/**
+ * Tests that, with internalQueryHierarchicalMergeMinShards set, mongos merges the partial $group
+ * and sorted results of the shards in groups before the final merge, and that the results match
+ * those of a single merge.
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({shards: 5, mongos: 1});
+const db = st.s.getDB("test");
+const coll = db.hierarchical_merge;
+
+assert.commandWorked(db.adminCommand({enableSharding: db.getName()}));
+st.ensurePrimaryShard(db.getName(), st.shard0.shardName);
+assert.commandWorked(db.adminCommand({shardCollection: coll.getFullName(), key: {_id: 1}}));
+for (let i = 1; i < 5; ++i) {
+    assert.commandWorked(db.adminCommand({split: coll.getFullName(), middle: {_id: i * 100}}));
+    assert.commandWorked(db.adminCommand({
+        moveChunk: coll.getFullName(),
+        find: {_id: i * 100},
+        to: st["shard" + i].shardName,
+        _waitForDelete: true
+    }));
+}
+
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 500; ++i) {
+    bulk.insert({_id: i, key: i % 7, val: (i * 37) % 101});
+}
+assert.commandWorked(bulk.execute());
+
+const pipelines = [
+    [
+        {$group: {_id: "$key", total: {$sum: "$val"}, avg: {$avg: "$val"}, n: {$sum: 1}}},
+        {$sort: {_id: 1}}
+    ],
+    [{$sort: {val: -1, _id: 1}}, {$limit: 25}],
+    [{$sort: {val: 1, _id: 1}}, {$skip: 10}, {$limit: 10}],
+];
+const expected = pipelines.map(pipeline => coll.aggregate(pipeline).toArray());
+
+assert.commandWorked(
+    st.s.adminCommand({setParameter: 1, internalQueryHierarchicalMergeMinShards: 3}));
+assert.commandWorked(st.s.adminCommand({setParameter: 1, logComponentVerbosity: {query: 1}}));
+pipelines.forEach((pipeline, i) => {
+    assert.commandWorked(st.s.adminCommand({clearLog: "global"}));
+    assert.eq(expected[i], coll.aggregate(pipeline).toArray(), tojson(pipeline));
+    checkLog.contains(st.s, "Dispatching intermediate merges");
+});
+
+st.stop();
+})();
@@ -0,0 +1,90 @@
+/**
+ * Tests that, with internalQueryPushLookupToShards set, mongos runs $lookup and $graphLookup in the
+ * shards part of the pipeline when the foreign collection is sharded with the same chunks as the
+ * local one, or is small and unsharded, and on the merger otherwise.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/discover_topology.js");  // For findNonConfigNodes.
+load("jstests/noPassthrough/libs/server_parameter_helpers.js");  // For setParameterOnAllHosts.
+
+const st = new ShardingTest({shards: 2, mongos: 1});
+const db = st.s.getDB("test");
+assert.commandWorked(db.adminCommand({enableSharding: db.getName()}));
+st.ensurePrimaryShard(db.getName(), st.shard0.shardName);
+
+const local = db.local;
+const colocated = db.colocated;
+const misaligned = db.misaligned;
+const unsharded = db.unsharded;
+
+st.shardColl(local, {_id: 1}, {_id: 50}, {_id: 50}, db.getName());
+st.shardColl(colocated, {k: 1}, {k: 50}, {k: 50}, db.getName());
+st.shardColl(misaligned, {k: 1}, {k: 25}, {k: 25}, db.getName());
+for (let i = 0; i < 100; ++i) {
+    assert.commandWorked(local.insert({_id: i, parent: i - 1}));
+    assert.commandWorked(colocated.insert({k: i}));
+    assert.commandWorked(misaligned.insert({k: i}));
+    assert.commandWorked(unsharded.insert({_id: i, k: i, parent: i - 1}));
+}
+
+setParameterOnAllHosts(
+    DiscoverTopology.findNonConfigNodes(st.s), "internalQueryAllowShardedLookup", true);
+
+function lookupFrom(coll) {
+    return [
+        {$lookup: {from: coll.getName(), localField: "_id", foreignField: "k", as: "joined"}},
+        {$sort: {_id: 1}}
+    ];
+}
+const graphLookup = [
+    {
+        $graphLookup: {
+            from: unsharded.getName(),
+            startWith: "$parent",
+            connectFromField: "parent",
+            connectToField: "_id",
+            maxDepth: 2,
+            as: "ancestors"
+        }
+    },
+    {$sort: {_id: 1}}
+];
+
+function assertRunsOnShards(pipeline, stageName, onShards) {
+    const explain = local.explain().aggregate(pipeline);
+    assert(explain.hasOwnProperty("splitPipeline"), tojson(explain));
+    const runsIn = (part) => part.some(stage => stage.hasOwnProperty(stageName));
+    assert.eq(onShards, runsIn(explain.splitPipeline.shardsPart), tojson(explain));
+    assert.eq(!onShards, runsIn(explain.splitPipeline.mergerPart), tojson(explain));
+
+    const results = local.aggregate(pipeline).toArray();
+    assert.eq(100, results.length);
+    results.forEach(doc => {
+        if (stageName === "$lookup") {
+            assert.eq([doc._id], doc.joined.map(joined => joined.k), tojson(doc));
+        } else {
+            assert.eq(Math.min(doc._id, 3), doc.ancestors.length, tojson(doc));
+        }
+    });
+}
+
+// The join runs on the merger unless the knob is set.
+assertRunsOnShards(lookupFrom(colocated), "$lookup", false);
+
+setParameterOnAllHosts(
+    DiscoverTopology.findNonConfigNodes(st.s), "internalQueryPushLookupToShards", true);
+assertRunsOnShards(lookupFrom(colocated), "$lookup", true);
+assertRunsOnShards(lookupFrom(misaligned), "$lookup", false);
+assertRunsOnShards(lookupFrom(unsharded), "$lookup", true);
+assertRunsOnShards(graphLookup, "$graphLookup", true);
+
+// An unsharded foreign collection larger than a shard may hold in memory stays on the merger.
+setParameterOnAllHosts(DiscoverTopology.findNonConfigNodes(st.s),
+                       "internalLookupHashJoinMaxMemoryBytes",
+                       Object.bsonsize(unsharded.findOne()));
+assertRunsOnShards(lookupFrom(unsharded), "$lookup", false);
+
+st.stop();
+})();
@@ -89,6 +89,7 @@ let testCases = {
     _configsvrDropDatabase: {skip: "internal command"},
     _configsvrEnableSharding: {skip: "internal command"},
     _configsvrEnsureChunkVersionIsGreaterThan: {skip: "internal command"},
+    _configsvrGetChangedChunks: {skip: "internal command"},
     _configsvrMoveChunk: {skip: "internal command"},
     _configsvrMovePrimary: {skip: "internal command"},
     _configsvrRefineCollectionShardKey: {skip: "internal command"},
@@ -0,0 +1,106 @@
+/**
+ * Tests that, with transactionCoordinatorPresumeAbort set, a coordinator which decides to abort
+ * because a participant no longer has the transaction sends abort without persisting the decision,
+ * and that a commit decision is still persisted.
+ *
+ * @tags: [uses_transactions, uses_prepare_transaction, uses_multi_shard_transaction]
+ */
+
+(function() {
+'use strict';
+
+load('jstests/sharding/libs/sharded_transactions_helpers.js');
+
+const dbName = "test";
+const collName = "foo";
+const ns = dbName + "." + collName;
+
+const st = new ShardingTest({shards: 2, causallyConsistent: true});
+
+const coordinator = st.shard0;
+const participant = st.shard1;
+
+assert.commandWorked(
+    coordinator.adminCommand({setParameter: 1, transactionCoordinatorPresumeAbort: true}));
+
+assert.commandWorked(st.s.adminCommand({enableSharding: dbName}));
+assert.commandWorked(st.s.adminCommand({movePrimary: dbName, to: coordinator.shardName}));
+assert.commandWorked(st.s.adminCommand({shardCollection: ns, key: {_id: 1}}));
+assert.commandWorked(st.s.adminCommand({split: ns, middle: {_id: 0}}));
+assert.commandWorked(st.s.adminCommand({moveChunk: ns, find: {_id: 0}, to: participant.shardName}));
+assert.commandWorked(coordinator.adminCommand({_flushRoutingTableCacheUpdates: ns}));
+assert.commandWorked(participant.adminCommand({_flushRoutingTableCacheUpdates: ns}));
+st.refreshCatalogCacheForNs(st.s, ns);
+
+const lsid = {id: UUID()};
+let txnNumber = 0;
+
+const getCoordinatorDoc = function() {
+    return coordinator.getDB("config").transaction_coordinators.findOne(
+        {"_id.lsid.id": lsid.id, "_id.txnNumber": txnNumber});
+};
+
+const runCommit = function(shouldCommit) {
+    const cmd = "db.adminCommand({commitTransaction: 1, lsid: " + tojson(lsid) +
+        ", txnNumber: NumberLong(" + txnNumber + "), autocommit: false})";
+    return startParallelShell(
+        shouldCommit ? "assert.commandWorked(" + cmd + ");"
+                     : "assert.commandFailedWithCode(" + cmd + ", ErrorCodes.NoSuchTransaction);",
+        st.s.port);
+};
+
+const testCommitProtocol = function(shouldCommit) {
+    txnNumber++;
+    assert.commandWorked(st.s.getDB(dbName).runCommand({
+        insert: collName,
+        documents: [{_id: -txnNumber}, {_id: txnNumber}],
+        lsid: lsid,
+        txnNumber: NumberLong(txnNumber),
+        stmtId: NumberInt(0),
+        startTransaction: true,
+        autocommit: false,
+    }));
+
+    if (!shouldCommit) {
+        // The participant votes to abort with NoSuchTransaction.
+        assert.commandWorked(participant.adminCommand({
+            abortTransaction: 1,
+            lsid: lsid,
+            txnNumber: NumberLong(txnNumber),
+            stmtId: NumberInt(0),
+            autocommit: false,
+        }));
+    }
+
+    assert.commandWorked(coordinator.adminCommand({
+        configureFailPoint: "hangBeforeWaitingForDecisionWriteConcern",
+        mode: "alwaysOn",
+    }));
+
+    const awaitResult = runCommit(shouldCommit);
+
+    waitForFailpoint("Hit hangBeforeWaitingForDecisionWriteConcern failpoint", txnNumber);
+    const coordDoc = getCoordinatorDoc();
+    assert.neq(null, coordDoc);
+    if (shouldCommit) {
+        assert.eq("commit", coordDoc.decision.decision, tojson(coordDoc));
+    } else {
+        assert.eq(undefined, coordDoc.decision, tojson(coordDoc));
+    }
+    assert.commandWorked(coordinator.adminCommand({
+        configureFailPoint: "hangBeforeWaitingForDecisionWriteConcern",
+        mode: "off",
+    }));
+
+    awaitResult();
+    assert.soon(() => getCoordinatorDoc() === null);
+};
+
+testCommitProtocol(false /* test abort */);
+assert.eq(0, st.s.getDB(dbName).getCollection(collName).find().itcount());
+
+testCommitProtocol(true /* test commit */);
+assert.soon(() => st.s.getDB(dbName).getCollection(collName).find().itcount() === 2);
+
+st.stop();
+})();
@@ -31,6 +31,7 @@
 
 #include <cmath>
 
+#include "mongo/platform/compiler.h"
 #include "mongo/platform/decimal128.h"
 #include "mongo/util/assert_util.h"
 
@@ -47,23 +48,22 @@ namespace mongo {
  *
  */
 
+// The integer and non-NaN double comparisons are written so that they compile to flag-setting
+// instructions rather than to branches, which mispredict on unordered input such as a sort.
 inline int compareInts(int lhs, int rhs) {
-    return lhs == rhs ? 0 : lhs < rhs ? -1 : 1;
+    return (lhs > rhs) - (lhs < rhs);
 }
 
 inline int compareLongs(long long lhs, long long rhs) {
-    return lhs == rhs ? 0 : lhs < rhs ? -1 : 1;
+    return (lhs > rhs) - (lhs < rhs);
 }
 
 inline int compareDoubles(double lhs, double rhs) {
-    if (lhs == rhs)
-        return 0;
-    if (lhs < rhs)
-        return -1;
-    if (lhs > rhs)
-        return 1;
+    const int ret = (lhs > rhs) - (lhs < rhs);
+    if (MONGO_likely(ret != 0 || lhs == rhs))
+        return ret;
 
-    // If none of the above cases returned, lhs or rhs must be NaN.
+    // Neither comparison held and the values are not equal, so lhs or rhs must be NaN.
     if (std::isnan(lhs))
         return std::isnan(rhs) ? 0 : -1;
     dassert(std::isnan(rhs));
@@ -31,6 +31,8 @@
 
 #include <benchmark/benchmark.h>
 
+#include "mongo/base/status.h"
+#include "mongo/bson/bson_validate.h"
 #include "mongo/bson/bsonobjbuilder.h"
 
 namespace mongo {
@@ -63,7 +65,46 @@ void BM_arrayLookup(benchmark::State& state) {
     state.SetItemsProcessed(totalLen);
 }
 
+/**
+ * Validates a document of 'state.range(0)' elements, each of which is a number or, if
+ * 'state.range(1)' is set, a string.
+ */
+void BM_validate(benchmark::State& state) {
+    BSONObjBuilder builder;
+    for (auto j = 0; j < state.range(0); j++) {
+        auto fieldName = std::to_string(j);
+        if (state.range(1)) {
+            builder.append(fieldName, "a short string value");
+        } else {
+            builder.append(fieldName, static_cast<long long>(j));
+        }
+    }
+    BSONObj doc = builder.obj();
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(validateBSON(doc.objdata(), doc.objsize(), BSONVersion::kLatest));
+    }
+    state.SetBytesProcessed(state.iterations() * doc.objsize());
+}
+
+/**
+ * Validates a document nesting 'state.range(0)' single-field objects.
+ */
+void BM_validateNested(benchmark::State& state) {
+    BSONObj doc = BSON("x" << 1);
+    for (auto j = 0; j < state.range(0); j++) {
+        doc = BSON("x" << doc);
+    }
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(validateBSON(doc.objdata(), doc.objsize(), BSONVersion::kLatest));
+    }
+    state.SetBytesProcessed(state.iterations() * doc.objsize());
+}
+
 BENCHMARK(BM_arrayBuilder)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_arrayLookup)->Ranges({{{1}, {100'000}}});
+BENCHMARK(BM_validate)->Ranges({{{1}, {10'000}}, {{0}, {1}}});
+BENCHMARK(BM_validateNested)->Ranges({{{1}, {100}}});
 
 }  // namespace mongo
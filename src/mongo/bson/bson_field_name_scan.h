@@ -0,0 +1,84 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_AMD64) || defined(__amd64__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "mongo/platform/bits.h"
+
+namespace mongo {
+
+/**
+ * Returns the length, not including the NUL terminator, of the BSON field name starting at
+ * 'fieldName'.
+ *
+ * 'limit' must point at or before the last readable byte of the enclosing buffer (for a BSONObj,
+ * the trailing EOO byte). The scan loads 16 bytes at a time while at least that many bytes remain
+ * before 'limit', so it never reads past the buffer, and finishes byte-at-a-time. As with strlen,
+ * the field name must be NUL terminated.
+ */
+inline size_t bsonFieldNameLength(const char* fieldName, const char* limit) {
+    const char* p = fieldName;
+#if defined(_M_AMD64) || defined(__amd64__)
+    const __m128i zero = _mm_setzero_si128();
+    while (limit - p >= 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const uint32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, zero));
+        if (mask)
+            return (p - fieldName) + countTrailingZeros64(mask);
+        p += 16;
+    }
+#elif defined(__aarch64__)
+    while (limit - p >= 16) {
+        const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+        const uint64x2_t isNul = vreinterpretq_u64_u8(vceqq_u8(chunk, vdupq_n_u8(0)));
+        // Each matching byte becomes 0xff, so the first NUL is found by counting zero bits from
+        // the low end of each 64-bit half.
+        const uint64_t low = vgetq_lane_u64(isNul, 0);
+        if (low)
+            return (p - fieldName) + countTrailingZeros64(low) / 8;
+        const uint64_t high = vgetq_lane_u64(isNul, 1);
+        if (high)
+            return (p - fieldName) + 8 + countTrailingZeros64(high) / 8;
+        p += 16;
+    }
+#endif
+    return (p - fieldName) + std::strlen(p);
+}
+
+}  // namespace mongo
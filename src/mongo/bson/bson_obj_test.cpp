@@ -647,6 +647,46 @@ TEST(BSONObj, getFieldsWithDuplicates) {
     ASSERT_EQUALS(fields[1].str(), "3");
 }
 
+TEST(BSONObj, getFieldsRuntimeSized) {
+    auto e = BSON("a" << 2 << "b"
+                      << "3"
+                      << "a" << 9 << "c" << 10);
+    std::vector<StringData> fieldNames{"c", "a", "missing"};
+    std::vector<BSONElement> fields(fieldNames.size());
+    e.getFields(fieldNames.size(), fieldNames.data(), fields.data());
+    ASSERT_EQUALS(fields[0].numberInt(), 10);
+    ASSERT_EQUALS(fields[1].numberInt(), 2);
+    ASSERT(fields[2].eoo());
+}
+
+TEST(BSONObj, getFieldWithLongFieldNames) {
+    // Field names longer than a vector register, and names ending at various offsets from the end
+    // of the object, exercise both the vectorized and the byte-at-a-time parts of the scan.
+    BSONObjBuilder bob;
+    std::vector<std::string> names;
+    for (size_t len = 1; len <= 40; ++len) {
+        names.push_back(std::string(len, 'a' + (len % 26)));
+        bob.append(names.back(), static_cast<int>(len));
+    }
+    BSONObj obj = bob.obj();
+
+    for (size_t i = 0; i < names.size(); ++i) {
+        BSONElement e = obj.getField(names[i]);
+        ASSERT_EQUALS(e.fieldNameStringData(), names[i]);
+        ASSERT_EQUALS(e.fieldNameSize(), static_cast<int>(names[i].size() + 1));
+        ASSERT_EQUALS(e.numberInt(), static_cast<int>(i + 1));
+    }
+    ASSERT(obj.getField(std::string(41, 'p')).eoo());
+    ASSERT(obj.getField(names.back().substr(1)).eoo());
+
+    size_t count = 0;
+    BSONObjIterator it(obj);
+    while (it.more()) {
+        ASSERT_EQUALS(it.next().fieldNameStringData(), names[count++]);
+    }
+    ASSERT_EQUALS(count, names.size());
+}
+
 TEST(BSONObj, ShareOwnershipWith) {
     BSONObj obj;
     {
@@ -415,6 +415,130 @@ Status validateBSONIterative(Buffer* buffer) {
     return Status::OK();
 }
 
+/**
+ * Returns true if the buffer starts with a valid BSON object. It checks each element in place,
+ * without the frames and _id tracking that validateBSONIterative() keeps to describe an error.
+ * Code with scope and nesting beyond kMaxFastPathDepth are left to validateBSONIterative(), as is
+ * any invalid input, so a false result only means the full validator must decide.
+ */
+bool validateBSONFast(const char* buffer, uint64_t maxLength) {
+    constexpr size_t kMaxFastPathDepth = 32;
+    const uint64_t maxDepth = BSONDepth::getMaxAllowableDepth();
+    // The end offset of each object being validated, innermost last.
+    uint64_t ends[kMaxFastPathDepth];
+    size_t depth = 0;
+
+    auto readInt32 = [&](uint64_t pos) {
+        return ConstDataView(buffer).read<LittleEndian<int32_t>>(pos);
+    };
+    // Begins the object at 'pos', which must end at or before 'limit'.
+    auto beginObj = [&](uint64_t pos, uint64_t limit) {
+        if (depth == kMaxFastPathDepth || depth > maxDepth || pos + sizeof(int32_t) > limit)
+            return false;
+        const int32_t size = readInt32(pos);
+        if (size < 5 || pos + size > limit)
+            return false;
+        ends[depth++] = pos + size;
+        return true;
+    };
+    // Skips the c-string at 'pos', which must end before 'end'.
+    auto skipCString = [&](uint64_t* pos, uint64_t end) {
+        auto terminator = static_cast<const char*>(memchr(buffer + *pos, 0, end - *pos));
+        if (!terminator)
+            return false;
+        *pos = terminator - buffer + 1;
+        return true;
+    };
+
+    if (!beginObj(0, maxLength))
+        return false;
+
+    // Every element, including the EOO that ends it, lies strictly inside the innermost object,
+    // so 'pos' stays below ends[depth - 1] between elements.
+    uint64_t pos = sizeof(int32_t);
+    while (depth) {
+        const uint64_t end = ends[depth - 1];
+        const auto type = static_cast<signed char>(buffer[pos++]);
+        if (type == EOO) {
+            if (pos != end)
+                return false;
+            --depth;
+            continue;
+        }
+        if (!skipCString(&pos, end))
+            return false;
+
+        uint64_t valueSize = 0;
+        switch (type) {
+            case MinKey:
+            case MaxKey:
+            case jstNULL:
+            case Undefined:
+                break;
+            case NumberInt:
+                valueSize = sizeof(int32_t);
+                break;
+            case NumberDouble:
+            case NumberLong:
+            case bsonTimestamp:
+            case Date:
+                valueSize = sizeof(int64_t);
+                break;
+            case NumberDecimal:
+                valueSize = sizeof(Decimal128::Value);
+                break;
+            case jstOID:
+                valueSize = OID::kOIDSize;
+                break;
+            case Bool:
+                if (pos >= end || static_cast<uint8_t>(buffer[pos]) > 1)
+                    return false;
+                valueSize = 1;
+                break;
+            case Code:
+            case Symbol:
+            case String:
+            case DBRef: {
+                if (pos + sizeof(int32_t) >= end)
+                    return false;
+                const int32_t sz = readInt32(pos);
+                if (sz <= 0 || pos + sizeof(int32_t) + sz >= end ||
+                    buffer[pos + sizeof(int32_t) + sz - 1] != 0)
+                    return false;
+                valueSize = sizeof(int32_t) + sz + (type == DBRef ? OID::kOIDSize : 0);
+                break;
+            }
+            case BinData: {
+                if (pos + sizeof(int32_t) >= end)
+                    return false;
+                const int32_t sz = readInt32(pos);
+                if (sz < 0 || sz == std::numeric_limits<int>::max())
+                    return false;
+                valueSize = sizeof(int32_t) + 1 + sz;
+                break;
+            }
+            case RegEx:
+                if (!skipCString(&pos, end) || !skipCString(&pos, end))
+                    return false;
+                break;
+            case Object:
+            case Array:
+                // Leave room for the EOO of the enclosing object.
+                if (!beginObj(pos, end - 1))
+                    return false;
+                pos += sizeof(int32_t);
+                continue;
+            default:
+                return false;
+        }
+
+        if (pos + valueSize >= end)
+            return false;
+        pos += valueSize;
+    }
+    return true;
+}
+
 }  // namespace
 
 Status validateBSON(const char* originalBuffer, uint64_t maxLength, BSONVersion version) {
@@ -422,6 +546,10 @@ Status validateBSON(const char* originalBuffer, uint64_t maxLength, BSONVersion
         return Status(ErrorCodes::InvalidBSON, "bson data has to be at least 5 bytes");
     }
 
+    if (MONGO_likely(validateBSONFast(originalBuffer, maxLength))) {
+        return Status::OK();
+    }
+
     Buffer buf(originalBuffer, maxLength, version);
     return validateBSONIterative(&buf);
 }
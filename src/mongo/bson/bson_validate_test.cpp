@@ -251,6 +251,51 @@ TEST(BSONValidateFast, NestedObject) {
     ASSERT_NOT_OK(validateBSON(x.objdata(), x.objsize() / 2, BSONVersion::kLatest));
 }
 
+BSONObj makeObjectWithEveryType(BSONObj nested) {
+    BSONObjBuilder bob;
+    bob.appendMinKey("minKey");
+    bob.appendNull("null");
+    bob.appendUndefined("undefined");
+    bob.append("int", 1);
+    bob.append("long", 2LL);
+    bob.append("double", 3.0);
+    bob.append("decimal", Decimal128(4));
+    bob.append("bool", true);
+    bob.appendDate("date", Date_t::fromMillisSinceEpoch(5));
+    bob.append("timestamp", Timestamp(6, 7));
+    bob.append("oid", OID::gen());
+    bob.append("string", "eight");
+    bob.appendCode("code", "nine");
+    bob.appendSymbol("symbol", "ten");
+    bob.appendDBRef("dbref", "test.coll", OID::gen());
+    bob.appendBinData("binData", 3, BinDataGeneral, "abc");
+    bob.appendRegex("regex", "^a", "i");
+    bob.append("array", BSON_ARRAY(1 << "two"));
+    bob.append("object", nested);
+    bob.appendMaxKey("maxKey");
+    return bob.obj();
+}
+
+TEST(BSONValidateFast, EveryTypeAtEveryDepth) {
+    BSONObj x;
+    for (int depth = 0; depth < 50; ++depth) {
+        x = makeObjectWithEveryType(x);
+        ASSERT_OK(validateBSON(x.objdata(), x.objsize(), BSONVersion::kLatest));
+        ASSERT_NOT_OK(validateBSON(x.objdata(), x.objsize() - 1, BSONVersion::kLatest));
+    }
+}
+
+TEST(BSONValidateFast, NestedObjectSizeMustMatchItsElements) {
+    BSONObj x = BSON("a" << BSON("b" << 1) << "c" << 2);
+    auto inner = x["a"].embeddedObject();
+    for (int delta : {-1, 1}) {
+        BSONObj mine = x.copy();
+        char* innerSize = const_cast<char*>(mine.objdata()) + (inner.objdata() - x.objdata());
+        DataView(innerSize).write(tagLittleEndian(inner.objsize() + delta));
+        ASSERT_NOT_OK(validateBSON(mine.objdata(), mine.objsize(), BSONVersion::kLatest));
+    }
+}
+
 TEST(BSONValidateFast, ErrorWithId) {
     BufBuilder bb;
     BSONObjBuilder ob(bb);
@@ -592,14 +592,31 @@ void BSONObj::getFields(unsigned n, const char** fieldNames, BSONElement* fields
     }
 }
 
+void BSONObj::getFields(size_t n, const StringData* fieldNames, BSONElement* fields) const {
+    size_t numRemaining = n;
+    std::vector<bool> found(n, false);
+    BSONObjIterator it(*this);
+    while (numRemaining > 0 && it.more()) {
+        BSONElement e = it.next();
+        const StringData fieldName = e.fieldNameStringData();
+        for (size_t i = 0; i < n; ++i) {
+            if (!found[i] && fieldNames[i] == fieldName) {
+                fields[i] = e;
+                found[i] = true;
+                --numRemaining;
+                break;
+            }
+        }
+    }
+}
+
 BSONElement BSONObj::getField(StringData name) const {
     BSONObjIterator i(*this);
     while (i.more()) {
         BSONElement e = i.next();
-        // We know that e has a cached field length since BSONObjIterator::next internally
-        // called BSONElement::size on the BSONElement that it returned, so it is more
-        // efficient to re-use that information by obtaining the field name as a
-        // StringData, which will be pre-populated with the cached length.
+        // BSONObjIterator::next computes the field name length with a vectorized scan and caches
+        // it in the returned element, so this comparison can reject on length before touching the
+        // name bytes.
         if (name == e.fieldNameStringData())
             return e;
     }
@@ -41,6 +41,7 @@
 #include "mongo/base/string_data.h"
 #include "mongo/base/string_data_comparator_interface.h"
 #include "mongo/bson/bson_comparator_interface_base.h"
+#include "mongo/bson/bson_field_name_scan.h"
 #include "mongo/bson/bsonelement.h"
 #include "mongo/bson/bsontypes.h"
 #include "mongo/bson/oid.h"
@@ -335,6 +336,14 @@ public:
 
     void getFields(unsigned n, const char** fieldNames, BSONElement* fields) const;
 
+    /**
+     * Get several fields at once, for when the number of names is only known at runtime. Each
+     * element is visited at most once and the scan stops as soon as every name has been found. As
+     * with the other overloads, only the first occurrence of a duplicated field is returned, and
+     * entries of 'fields' whose name is not present are left unchanged.
+     */
+    void getFields(size_t n, const StringData* fieldNames, BSONElement* fields) const;
+
     /**
      * Get several fields at once. This is faster than separate getField() calls as the size of
      * elements iterated can then be calculated only once each.
@@ -761,7 +770,11 @@ public:
 
     BSONElement next() {
         verify(_pos <= _theend);
-        BSONElement e(_pos);
+        // The field name is scanned against the end of the object so that the scan can safely
+        // examine several bytes at a time. EOO has no field name, so it is never scanned.
+        const int fieldNameSize =
+            *_pos == EOO ? 0 : static_cast<int>(bsonFieldNameLength(_pos + 1, _theend)) + 1;
+        BSONElement e(_pos, fieldNameSize, -1, BSONElement::CachedSizeTag());
         _pos += e.size();
         return e;
     }
@@ -894,7 +907,9 @@ template <size_t N>
 inline void BSONObj::getFields(const std::array<StringData, N>& fieldNames,
                                std::array<BSONElement, N>* fields) const {
     std::bitset<N> foundFields;
-    for (auto&& el : *this) {
+    BSONObjIterator it(*this);
+    while (it.more()) {
+        BSONElement el = it.next();
         auto fieldName = el.fieldNameStringData();
         for (std::size_t i = 0; i < N; ++i) {
             if (!foundFields.test(i) && (fieldNames[i] == fieldName)) {
@@ -31,6 +31,7 @@
 
 #include "mongo/bson/json.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <fmt/format.h>
 
@@ -562,7 +563,7 @@ Status JParse::timestampObject(StringData fieldName, BSONObjBuilder& builder) {
     char* endptr;
     uint32_t seconds;
     NumberParser parser = NumberParser::strToAny(10);
-    Status parsedStatus = parser(_input, &seconds, &endptr);
+    Status parsedStatus = parser(numberText(), &seconds, &endptr);
     if (parsedStatus == ErrorCodes::Overflow) {
         return parseError("Timestamp seconds overflow");
     }
@@ -584,7 +585,7 @@ Status JParse::timestampObject(StringData fieldName, BSONObjBuilder& builder) {
         return parseError("Negative increment in \"$timestamp\"");
     }
     uint32_t count;
-    parsedStatus = parser(_input, &count, &endptr);
+    parsedStatus = parser(numberText(), &count, &endptr);
     if (parsedStatus == ErrorCodes::Overflow) {
         return parseError("Timestamp increment overflow");
     }
@@ -916,7 +917,7 @@ Status JParse::timestamp(StringData fieldName, BSONObjBuilder& builder) {
     char* endptr;
     NumberParser parser = NumberParser::strToAny(10);
     uint32_t seconds;
-    Status parsedStatus = parser(_input, &seconds, &endptr);
+    Status parsedStatus = parser(numberText(), &seconds, &endptr);
     if (parsedStatus == ErrorCodes::Overflow) {
         return parseError("Timestamp seconds overflow");
     }
@@ -931,7 +932,7 @@ Status JParse::timestamp(StringData fieldName, BSONObjBuilder& builder) {
         return parseError("Negative seconds in \"$timestamp\"");
     }
     uint32_t count;
-    parsedStatus = parser(_input, &count, &endptr);
+    parsedStatus = parser(numberText(), &count, &endptr);
     if (parsedStatus == ErrorCodes::Overflow) {
         return parseError("Timestamp increment overflow");
     }
@@ -975,7 +976,7 @@ Status JParse::numberLong(StringData fieldName, BSONObjBuilder& builder) {
     }
     char* endptr;
     int64_t val;
-    Status parsedStatus = NumberParser::strToAny(10)(_input, &val, &endptr);
+    Status parsedStatus = NumberParser::strToAny(10)(numberText(), &val, &endptr);
     if (parsedStatus == ErrorCodes::Overflow) {
         return parseError("NumberLong out of range");
     }
@@ -1024,7 +1025,7 @@ Status JParse::numberInt(StringData fieldName, BSONObjBuilder& builder) {
     }
     char* endptr;
     int32_t val;
-    Status parsedStatus = NumberParser::strToAny(10)(_input, &val, &endptr);
+    Status parsedStatus = NumberParser::strToAny(10)(numberText(), &val, &endptr);
     if (parsedStatus == ErrorCodes::Overflow) {
         return parseError("NumberInt out of range");
     }
@@ -1131,20 +1132,60 @@ Status JParse::regexOptCheck(StringData opt) {
     return Status::OK();
 }
 
+StringData JParse::numberText() const {
+    auto isSpace = [](char c) { return isspace(static_cast<unsigned char>(c)); };
+    auto isDelimiter = [&](char c) {
+        return c == ',' || c == '}' || c == ']' || c == ':' || isSpace(c);
+    };
+    const char* end = std::find_if_not(_input, _input_end, isSpace);
+    end = std::find_if(end, _input_end, isDelimiter);
+    return StringData(_input, end - _input);
+}
+
 Status JParse::number(StringData fieldName, BSONObjBuilder& builder) {
+    // The number parsers skip leading whitespace anyway.
+    while (_input < _input_end && isspace(*reinterpret_cast<const unsigned char*>(_input))) {
+        ++_input;
+    }
+    const StringData text = numberText();
+
+    // Plain decimal integers, by far the most common numbers, need neither strtod nor a second
+    // parse. Up to 18 digits always fit in a long long.
+    StringData digits = text.startsWith("-") ? text.substr(1) : text;
+    if (!digits.empty() && digits.size() <= 18 &&
+        std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+        long long magnitude = 0;
+        for (char c : digits) {
+            magnitude = magnitude * 10 + (c - '0');
+        }
+        const long long value = digits.size() == text.size() ? magnitude : -magnitude;
+        if (value == static_cast<int>(value)) {
+            MONGO_JSON_DEBUG("Type: 32 bit int");
+            builder.append(fieldName, static_cast<int>(value));
+        } else {
+            MONGO_JSON_DEBUG("Type: 64 bit int");
+            builder.append(fieldName, value);
+        }
+        _input = text.rawData() + text.size();
+        if (_input >= _input_end) {
+            return parseError("Trailing number at end of input");
+        }
+        return Status::OK();
+    }
+
     char* endptrll;
     char* endptrd;
     long long retll;
     double retd;
 
-    Status parsedStatus = NumberParser::strToAny()(_input, &retd, &endptrd);
+    Status parsedStatus = NumberParser::strToAny()(text, &retd, &endptrd);
     if (parsedStatus == ErrorCodes::Overflow) {
         return parseError("Value cannot fit in double");
     }
     if (!parsedStatus.isOK()) {
         return parseError("Bad characters in value");
     }
-    parsedStatus = NumberParser::strToAny(10)(_input, &retll, &endptrll);
+    parsedStatus = NumberParser::strToAny(10)(text, &retll, &endptrll);
     if (endptrll < endptrd || parsedStatus == ErrorCodes::Overflow) {
         // The number either had characters only meaningful for a double or
         // could not fit in a 64 bit int
@@ -1414,12 +1455,12 @@ bool JParse::isArray() {
 StatusWith<Date_t> JParse::parseDate() {
     long long msSinceEpoch;
     char* endptr;
-    Status parsedStatus = NumberParser::strToAny(10)(_input, &msSinceEpoch, &endptr);
+    Status parsedStatus = NumberParser::strToAny(10)(numberText(), &msSinceEpoch, &endptr);
     if (parsedStatus == ErrorCodes::Overflow) {
         /* Need to handle this because jsonString outputs the value of Date_t as unsigned.
          * See SERVER-8330 and SERVER-8573 */
         unsigned long long oldDate;  // Date_t used to be stored as unsigned long longs
-        parsedStatus = NumberParser::strToAny(10)(_input, &oldDate, &endptr);
+        parsedStatus = NumberParser::strToAny(10)(numberText(), &oldDate, &endptr);
         if (parsedStatus == ErrorCodes::Overflow) {
             return parseError("Date milliseconds overflow");
         }
@@ -384,6 +384,13 @@ private:
      */
     Status number(StringData fieldName, BSONObjBuilder&);
 
+    /**
+     * @return the input from the cursor through the number text that may start there, ending
+     * before the next ',', '}', ']', ':' or whitespace after it. Every number parser stops within
+     * this range, so handing them the range saves measuring and copying the rest of the input.
+     */
+    StringData numberText() const;
+
     /*
      * FIELD :
      *     STRING
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cfloat>
 #include <cinttypes>
 #include <cstdint>
@@ -111,6 +112,10 @@ private:
     SharedBuffer _buf;
 };
 
+/**
+ * Allocates from 'SZ' bytes of inline storage, moving to the heap only once a buffer outgrows it.
+ */
+template <size_t SZ>
 class StackAllocator {
     StackAllocator(const StackAllocator&) = delete;
     StackAllocator& operator=(const StackAllocator&) = delete;
@@ -121,7 +126,6 @@ public:
         free();
     }
 
-    enum { SZ = 512 };
     void malloc(size_t sz) {
         if (sz > SZ)
             _ptr = mongoMalloc(sz);
@@ -340,7 +344,20 @@ private:
         DataView(grow(sizeof(t))).write(tagLittleEndian(t));
     }
     /* "slow" portion of 'grow()'  */
-    void grow_reallocate(int minSize);
+    MONGO_COMPILER_NOINLINE void grow_reallocate(int minSize) {
+        if (minSize > BufferMaxSize) {
+            std::stringstream ss;
+            ss << "BufBuilder attempted to grow() to " << minSize << " bytes, past the 64MB limit.";
+            msgasserted(13548, ss.str().c_str());
+        }
+
+        int a = 64;
+        while (a < minSize)
+            a = a * 2;
+
+        _buf.realloc(a);
+        size = a;
+    }
 
     BufferAllocator _buf;
     int l;
@@ -359,12 +376,23 @@ MONGO_STATIC_ASSERT(std::is_move_constructible_v<BufBuilder>);
     While designed to be a variable on the stack, if you were to dynamically allocate one,
       nothing bad would happen.  In fact in some circumstances this might make sense, say,
       embedded in some other object.
+    StackBufBuilderBase<SZ> holds SZ bytes inline; pick SZ to fit the expected data, since
+      anything larger moves to the heap.
 */
-class StackBufBuilder : public BasicBufBuilder<StackAllocator> {
+template <size_t SZ>
+class StackBufBuilderBase : public BasicBufBuilder<StackAllocator<SZ>> {
 public:
-    StackBufBuilder() : BasicBufBuilder<StackAllocator>(StackAllocator::SZ) {}
+    StackBufBuilderBase() : BasicBufBuilder<StackAllocator<SZ>>(SZ) {}
+
+    /** @param initsize a hint as to the final size; only a larger one allocates up front */
+    explicit StackBufBuilderBase(int initsize)
+        : BasicBufBuilder<StackAllocator<SZ>>(std::max(initsize, static_cast<int>(SZ))) {}
+
     void release() = delete;  // not allowed. not implemented.
 };
+
+const size_t StackSizeDefault = 512;
+using StackBufBuilder = StackBufBuilderBase<StackSizeDefault>;
 MONGO_STATIC_ASSERT(!std::is_move_constructible<StackBufBuilder>::value);
 
 /** std::stringstream deals with locale so this is a lot faster than std::stringstream for UTF8 */
@@ -524,11 +552,11 @@ private:
 };
 
 using StringBuilder = StringBuilderImpl<SharedBufferAllocator>;
-using StackStringBuilder = StringBuilderImpl<StackAllocator>;
+using StackStringBuilder = StringBuilderImpl<StackAllocator<StackSizeDefault>>;
 
 extern template class BasicBufBuilder<SharedBufferAllocator>;
-extern template class BasicBufBuilder<StackAllocator>;
+extern template class BasicBufBuilder<StackAllocator<StackSizeDefault>>;
 extern template class StringBuilderImpl<SharedBufferAllocator>;
-extern template class StringBuilderImpl<StackAllocator>;
+extern template class StringBuilderImpl<StackAllocator<StackSizeDefault>>;
 
 }  // namespace mongo
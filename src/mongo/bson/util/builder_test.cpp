@@ -79,11 +79,39 @@ TEST(Builder, BooleanOstreamOperator) {
 }
 
 TEST(Builder, StackAllocatorShouldNotLeak) {
-    StackAllocator stackAlloc;
-    stackAlloc.malloc(StackAllocator::SZ + 1);  // Force heap allocation.
+    StackAllocator<StackSizeDefault> stackAlloc;
+    stackAlloc.malloc(StackSizeDefault + 1);  // Force heap allocation.
     // Let the builder go out of scope. If this leaks, it will trip the ASAN leak detector.
 }
 
+TEST(Builder, StackBufBuilderMovesToHeapOnlyOnceItOutgrowsItsInlineStorage) {
+    StackBufBuilderBase<64> builder;
+    const char* inlineStorage = builder.buf();
+    ASSERT_EQ(builder.getSize(), 64);
+
+    std::string data(64, 'x');
+    builder.appendBuf(data.data(), data.size());
+    ASSERT_EQ(builder.buf(), inlineStorage);
+
+    builder.appendChar('y');
+    ASSERT_NE(builder.buf(), inlineStorage);
+    ASSERT_EQ(builder.len(), 65);
+    ASSERT_EQ(StringData(builder.buf(), 64), data);
+    ASSERT_EQ(builder.buf()[64], 'y');
+}
+
+TEST(Builder, StackBufBuilderSizeHintAllocatesOnlyPastItsInlineStorage) {
+    StackBufBuilderBase<64> small(16);
+    ASSERT_EQ(small.getSize(), 64);
+
+    StackBufBuilderBase<64> large(1024);
+    ASSERT_EQ(large.getSize(), 1024);
+    std::string data(1024, 'x');
+    const char* heapStorage = large.buf();
+    large.appendBuf(data.data(), data.size());
+    ASSERT_EQ(large.buf(), heapStorage);
+}
+
 template <typename T>
 void testStringBuilderIntegral() {
     auto check = [](T num) { ASSERT_EQ(std::string(str::stream() << num), std::to_string(num)); };
@@ -60,6 +60,11 @@ namespace mongo {
  * server is going to advertise the same salt value upon
  * reauthentication.  This might be useful for mobile clients where
  * CPU usage is a concern."
+ *
+ * The salt and iteration count come from the user's credential document, which is replicated,
+ * so every member of a replica set advertises the same presecrets. Lookups for a host with no
+ * matching record therefore fall back to a record made for any other host with identical
+ * presecrets, sparing a burst of new connections after a failover the full computation.
  */
 template <typename HashBlock>
 class SCRAMClientCache {
@@ -71,7 +76,8 @@ public:
     /**
      * Returns precomputed SCRAMSecrets, if one has already been
      * stored for the specified hostname and the provided presecrets
-     * match those recorded for the hostname. Otherwise, no secrets
+     * match those recorded for the hostname, or if any other host
+     * has a record for the same presecrets. Otherwise, no secrets
      * are returned.
      */
     scram::Secrets<HashBlock> getCachedSecrets(
@@ -80,19 +86,23 @@ public:
 
         // Search the cache for a record associated with the host we're trying to connect to.
         auto foundSecret = _hostToSecrets.find(target);
-        if (foundSecret == _hostToSecrets.end()) {
-            return {};
-        }
 
         // Presecrets contain parameters provided by the server, which may change. If the
         // cached presecrets don't match the presecrets we have on hand, we must not return the
-        // stale cached secrets. We'll need to rerun the SCRAM computation.
-        const auto& foundPresecrets = foundSecret->second.first;
-        if (foundPresecrets == presecrets) {
+        // stale cached secrets.
+        if (foundSecret != _hostToSecrets.end() && foundSecret->second.first == presecrets) {
             return foundSecret->second.second;
-        } else {
-            return {};
         }
+
+        // The secrets depend only on the presecrets, so a record made for another host which
+        // advertised the same salt and iteration count is just as valid. Only when there is none
+        // will we need to rerun the SCRAM computation.
+        for (const auto& record : _hostToSecrets) {
+            if (record.second.first == presecrets) {
+                return record.second.second;
+            }
+        }
+        return {};
     }
 
     /**
@@ -607,9 +607,8 @@ void testSetAndGetWithDifferentParameters() {
     cache.setCachedSecrets(host, presecrets, secrets);
     ASSERT_TRUE(cache.getCachedSecrets(host, presecrets));
 
-    // Alter each of: host, password, salt, iterationCount.
+    // Alter each of: password, salt, iterationCount.
     // Any one of which should fail to retreive from cache.
-    ASSERT_FALSE(cache.getCachedSecrets(HostAndPort("localhost:27018"), presecrets));
     ASSERT_FALSE(cache.getCachedSecrets(host, scram::Presecrets<HashBlock>("aab", salt, 10000)));
     const auto badSalt = scram::Presecrets<HashBlock>::generateSecureRandomSalt();
     ASSERT_FALSE(cache.getCachedSecrets(host, scram::Presecrets<HashBlock>("aaa", badSalt, 10000)));
@@ -621,6 +620,41 @@ TEST(SCRAMCache, testSetAndGetWithDifferentParameters) {
     testSetAndGetWithDifferentParameters<SHA256Block>();
 }
 
+template <typename HashBlock>
+void testGetFromOtherHostWithSamePresecrets() {
+    SCRAMClientCache<HashBlock> cache;
+    const auto salt = scram::Presecrets<HashBlock>::generateSecureRandomSalt();
+    HostAndPort host("localhost:27017");
+    HostAndPort otherHost("localhost:27018");
+
+    const auto presecrets = scram::Presecrets<HashBlock>("aaa", salt, 10000);
+    const auto secrets = scram::Secrets<HashBlock>(presecrets);
+    cache.setCachedSecrets(host, presecrets, secrets);
+
+    // A host with no record of its own is served the secrets cached for another host, as long
+    // as it advertised the same presecrets.
+    const auto cachedSecrets = cache.getCachedSecrets(otherHost, presecrets);
+    ASSERT_TRUE(cachedSecrets);
+    ASSERT_TRUE(secrets.clientKey() == cachedSecrets.clientKey());
+    ASSERT_TRUE(secrets.serverKey() == cachedSecrets.serverKey());
+    ASSERT_TRUE(secrets.storedKey() == cachedSecrets.storedKey());
+    ASSERT_FALSE(
+        cache.getCachedSecrets(otherHost, scram::Presecrets<HashBlock>("aaa", salt, 10001)));
+
+    // A host whose own record is stale still finds a matching record made for another host.
+    const auto newPresecrets = scram::Presecrets<HashBlock>("aab", salt, 10000);
+    const auto newSecrets = scram::Secrets<HashBlock>(newPresecrets);
+    cache.setCachedSecrets(otherHost, newPresecrets, newSecrets);
+    ASSERT_TRUE(cache.getCachedSecrets(otherHost, presecrets));
+    ASSERT_TRUE(secrets.clientKey() == cache.getCachedSecrets(otherHost, presecrets).clientKey());
+    ASSERT_TRUE(newSecrets.clientKey() == cache.getCachedSecrets(host, newPresecrets).clientKey());
+}
+
+TEST(SCRAMCache, testGetFromOtherHostWithSamePresecrets) {
+    testGetFromOtherHostWithSamePresecrets<SHA1Block>();
+    testGetFromOtherHostWithSamePresecrets<SHA256Block>();
+}
+
 template <typename HashBlock>
 void testSetAndReset() {
     SCRAMClientCache<HashBlock> cache;
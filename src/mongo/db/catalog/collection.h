@@ -286,11 +286,16 @@ public:
      * outside this Collection. The bulk loader is notified with the RecordId of the document
      * inserted into the RecordStore.
      *
+     * If 'recordBulkLoader' is non-null, the document is appended through it instead of being
+     * inserted as part of the current storage transaction, and is not removed if that transaction
+     * is rolled back.
+     *
      * NOTE: It is up to caller to commit the indexes.
      */
     virtual Status insertDocumentForBulkLoader(OperationContext* const opCtx,
                                                const BSONObj& doc,
-                                               const OnRecordInsertedFn& onRecordInserted) = 0;
+                                               const OnRecordInsertedFn& onRecordInserted,
+                                               RecordStoreBulkLoader* recordBulkLoader) = 0;
 
     /**
      * Updates the document @ oldLocation with newDoc.
@@ -312,10 +317,12 @@ public:
     virtual bool updateWithDamagesSupported() const = 0;
 
     /**
-     * Not allowed to modify indexes.
+     * Applies 'damages' to the document @ loc in place. When 'indexesAffected' is true, also
+     * updates the index entries of the document.
      * Illegal to call if updateWithDamagesSupported() returns false.
      * Sets 'args.updatedDoc' to the updated version of the document with damages applied, on
      * success.
+     * 'opDebug' Optional argument. When not null, will be used to record operation statistics.
      * @return the contents of the updated record.
      */
     virtual StatusWith<RecordData> updateDocumentWithDamages(
@@ -324,6 +331,8 @@ public:
         const Snapshotted<RecordData>& oldRec,
         const char* const damageSource,
         const mutablebson::DamageVector& damages,
+        const bool indexesAffected,
+        OpDebug* const opDebug,
         CollectionUpdateArgs* const args) = 0;
 
     // -----------
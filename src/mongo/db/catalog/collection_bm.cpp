@@ -0,0 +1,175 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/catalog/catalog_test_fixture.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/query/internal_plans.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.collection_bm");
+
+/**
+ * Runs a mongod catalog on top of a real WiredTiger engine for the lifetime of the object, so that
+ * benchmarks can exercise the same insert and query paths as a running server does, in-process.
+ */
+class WiredTigerCatalogFixture : public CatalogTestFixture {
+public:
+    WiredTigerCatalogFixture() : CatalogTestFixture("wiredTiger") {
+        setUp();
+        ASSERT_OK(storageInterface()->createCollection(operationContext(), kNss, {}));
+    }
+
+    ~WiredTigerCatalogFixture() {
+        tearDown();
+    }
+
+private:
+    void _doTest() override {}
+};
+
+/**
+ * Returns a document whose shape is controlled by 'numFields': an _id plus 'numFields' fields that
+ * alternate between integers and short strings.
+ */
+BSONObj makeDocument(int id, int numFields) {
+    BSONObjBuilder bob;
+    bob.append("_id", id);
+    for (int i = 0; i < numFields; ++i) {
+        const std::string fieldName = str::stream() << "f" << i;
+        if (i % 2) {
+            bob.append(fieldName, str::stream() << "value " << id);
+        } else {
+            bob.append(fieldName, id + i);
+        }
+    }
+    return bob.obj();
+}
+
+void insertDocuments(OperationContext* opCtx, int numDocuments, int numFields) {
+    AutoGetCollection autoColl(opCtx, kNss, MODE_IX);
+    for (int i = 0; i < numDocuments; ++i) {
+        WriteUnitOfWork wuow(opCtx);
+        invariant(autoColl.getCollection()->insertDocument(
+            opCtx, InsertStatement(makeDocument(i, numFields)), nullptr));
+        wuow.commit();
+    }
+}
+
+/**
+ * Inserts one document per iteration, in its own WriteUnitOfWork and with its own collection lock
+ * acquisition, into a collection with only an _id index. The argument is the number of fields per
+ * document.
+ */
+void BM_CollectionInsert(benchmark::State& state) {
+    WiredTigerCatalogFixture fixture;
+    auto opCtx = fixture.operationContext();
+    const int numFields = state.range(0);
+
+    int id = 0;
+    for (auto keepRunning : state) {
+        AutoGetCollection autoColl(opCtx, kNss, MODE_IX);
+        WriteUnitOfWork wuow(opCtx);
+        invariant(autoColl.getCollection()->insertDocument(
+            opCtx, InsertStatement(makeDocument(id++, numFields)), nullptr));
+        wuow.commit();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Runs a full collection scan through a PlanExecutor per iteration. The argument is the number of
+ * documents in the collection.
+ */
+void BM_CollectionScan(benchmark::State& state) {
+    WiredTigerCatalogFixture fixture;
+    auto opCtx = fixture.operationContext();
+    const int numDocuments = state.range(0);
+    insertDocuments(opCtx, numDocuments, 10);
+
+    for (auto keepRunning : state) {
+        AutoGetCollectionForRead autoColl(opCtx, kNss);
+        auto exec = InternalPlanner::collectionScan(
+            opCtx, kNss.ns(), autoColl.getCollection(), PlanExecutor::NO_YIELD);
+        BSONObj obj;
+        int numReturned = 0;
+        while (exec->getNext(&obj, nullptr) == PlanExecutor::ADVANCED) {
+            ++numReturned;
+        }
+        invariant(numReturned == numDocuments);
+        opCtx->recoveryUnit()->abandonSnapshot();
+    }
+    state.SetItemsProcessed(state.iterations() * numDocuments);
+}
+
+/**
+ * Looks up one document by _id through an index scan and fetch per iteration. The argument is the
+ * number of documents in the collection.
+ */
+void BM_IdIndexPointLookup(benchmark::State& state) {
+    WiredTigerCatalogFixture fixture;
+    auto opCtx = fixture.operationContext();
+    const int numDocuments = state.range(0);
+    insertDocuments(opCtx, numDocuments, 10);
+
+    int id = 0;
+    for (auto keepRunning : state) {
+        AutoGetCollectionForRead autoColl(opCtx, kNss);
+        auto collection = autoColl.getCollection();
+        auto idIndex = collection->getIndexCatalog()->findIdIndex(opCtx);
+        const BSONObj key = BSON("_id" << (id++ % numDocuments));
+        auto exec = InternalPlanner::indexScan(opCtx,
+                                               collection,
+                                               idIndex,
+                                               key,
+                                               key,
+                                               BoundInclusion::kIncludeBothStartAndEndKeys,
+                                               PlanExecutor::NO_YIELD,
+                                               InternalPlanner::FORWARD,
+                                               InternalPlanner::IXSCAN_FETCH);
+        BSONObj obj;
+        invariant(exec->getNext(&obj, nullptr) == PlanExecutor::ADVANCED);
+        opCtx->recoveryUnit()->abandonSnapshot();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_CollectionInsert)->ArgName("fields")->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK(BM_CollectionScan)->ArgName("documents")->Arg(1000)->Arg(100'000);
+BENCHMARK(BM_IdIndexPointLookup)->ArgName("documents")->Arg(1000)->Arg(100'000);
+
+}  // namespace
+}  // namespace mongo
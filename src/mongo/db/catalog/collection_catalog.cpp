@@ -191,6 +191,7 @@ void CollectionCatalog::setCollectionNamespace(OperationContext* opCtx,
 
     _collections[toCollection] = _collections[fromCollection];
     _collections.erase(fromCollection);
+    _publishLookupSnapshot(lock);
 
     ResourceId oldRid = ResourceId(RESOURCE_COLLECTION, fromCollection.ns());
     ResourceId newRid = ResourceId(RESOURCE_COLLECTION, toCollection.ns());
@@ -204,6 +205,7 @@ void CollectionCatalog::setCollectionNamespace(OperationContext* opCtx,
 
         _collections[fromCollection] = _collections[toCollection];
         _collections.erase(toCollection);
+        _publishLookupSnapshot(lock);
 
         ResourceId oldRid = ResourceId(RESOURCE_COLLECTION, fromCollection.ns());
         ResourceId newRid = ResourceId(RESOURCE_COLLECTION, toCollection.ns());
@@ -226,6 +228,7 @@ void CollectionCatalog::onCloseCatalog(OperationContext* opCtx) {
     _shadowCatalog.emplace();
     for (auto& entry : _catalog)
         _shadowCatalog->insert({entry.first, entry.second->ns()});
+    _publishLookupSnapshot(lock);
 }
 
 void CollectionCatalog::onOpenCatalog(OperationContext* opCtx) {
@@ -233,6 +236,29 @@ void CollectionCatalog::onOpenCatalog(OperationContext* opCtx) {
     stdx::lock_guard<Latch> lock(_catalogLock);
     invariant(_shadowCatalog);
     _shadowCatalog.reset();
+    _publishLookupSnapshot(lock);
+}
+
+std::shared_ptr<const CollectionCatalog::LookupSnapshot> CollectionCatalog::_getLookupSnapshot()
+    const {
+    return std::atomic_load(&_lookupSnapshot);
+}
+
+void CollectionCatalog::_publishLookupSnapshot(WithLock) {
+    auto snapshot = std::make_shared<LookupSnapshot>();
+    snapshot->version = _lookupSnapshot->version + 1;
+    snapshot->byUUID.reserve(_catalog.size());
+    for (auto& entry : _catalog) {
+        snapshot->byUUID.emplace(entry.first,
+                                 std::make_pair(entry.second.get(), entry.second->ns()));
+    }
+    snapshot->byNamespace.reserve(_collections.size());
+    for (auto& entry : _collections) {
+        snapshot->byNamespace.emplace(entry.first,
+                                      std::make_pair(entry.second, entry.second->uuid()));
+    }
+    snapshot->shadowCatalog = _shadowCatalog;
+    std::atomic_store(&_lookupSnapshot, std::shared_ptr<const LookupSnapshot>(std::move(snapshot)));
 }
 
 Collection* CollectionCatalog::lookupCollectionByUUID(OperationContext* opCtx,
@@ -241,8 +267,9 @@ Collection* CollectionCatalog::lookupCollectionByUUID(OperationContext* opCtx,
         return coll;
     }
 
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    return _lookupCollectionByUUID(lock, uuid);
+    auto snapshot = _getLookupSnapshot();
+    auto foundIt = snapshot->byUUID.find(uuid);
+    return foundIt == snapshot->byUUID.end() ? nullptr : foundIt->second.first;
 }
 
 Collection* CollectionCatalog::_lookupCollectionByUUID(WithLock, CollectionUUID uuid) const {
@@ -256,9 +283,9 @@ Collection* CollectionCatalog::lookupCollectionByNamespace(OperationContext* opC
         return coll;
     }
 
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto it = _collections.find(nss);
-    return it == _collections.end() ? nullptr : it->second;
+    auto snapshot = _getLookupSnapshot();
+    auto it = snapshot->byNamespace.find(nss);
+    return it == snapshot->byNamespace.end() ? nullptr : it->second.first;
 }
 
 boost::optional<NamespaceString> CollectionCatalog::lookupNSSByUUID(OperationContext* opCtx,
@@ -267,10 +294,10 @@ boost::optional<NamespaceString> CollectionCatalog::lookupNSSByUUID(OperationCon
         return coll->ns();
     }
 
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto foundIt = _catalog.find(uuid);
-    if (foundIt != _catalog.end()) {
-        NamespaceString ns = foundIt->second->ns();
+    auto snapshot = _getLookupSnapshot();
+    auto foundIt = snapshot->byUUID.find(uuid);
+    if (foundIt != snapshot->byUUID.end()) {
+        const NamespaceString& ns = foundIt->second.second;
         invariant(!ns.isEmpty());
         return ns;
     }
@@ -278,9 +305,9 @@ boost::optional<NamespaceString> CollectionCatalog::lookupNSSByUUID(OperationCon
     // Only in the case that the catalog is closed and a UUID is currently unknown, resolve it
     // using the pre-close state. This ensures that any tasks reloading the catalog can see their
     // own updates.
-    if (_shadowCatalog) {
-        auto shadowIt = _shadowCatalog->find(uuid);
-        if (shadowIt != _shadowCatalog->end())
+    if (snapshot->shadowCatalog) {
+        auto shadowIt = snapshot->shadowCatalog->find(uuid);
+        if (shadowIt != snapshot->shadowCatalog->end())
             return shadowIt->second;
     }
     return boost::none;
@@ -292,10 +319,10 @@ boost::optional<CollectionUUID> CollectionCatalog::lookupUUIDByNSS(
         return coll->uuid();
     }
 
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto it = _collections.find(nss);
-    if (it != _collections.end()) {
-        return it->second->uuid();
+    auto snapshot = _getLookupSnapshot();
+    auto it = snapshot->byNamespace.find(nss);
+    if (it != snapshot->byNamespace.end()) {
+        return it->second.second;
     }
     return boost::none;
 }
@@ -407,6 +434,7 @@ void CollectionCatalog::registerCollection(CollectionUUID uuid, std::unique_ptr<
     _catalog[uuid] = std::move(*coll);
     _collections[ns] = _catalog[uuid].get();
     _orderedCollections[dbIdPair] = _catalog[uuid].get();
+    _publishLookupSnapshot(lock);
 
     auto dbRid = ResourceId(RESOURCE_DATABASE, dbName);
     addResource(dbRid, dbName);
@@ -438,6 +466,7 @@ std::unique_ptr<Collection> CollectionCatalog::deregisterCollection(CollectionUU
     _orderedCollections.erase(dbIdPair);
     _collections.erase(ns);
     _catalog.erase(uuid);
+    _publishLookupSnapshot(lock);
 
     auto collRid = ResourceId(RESOURCE_COLLECTION, ns.ns());
     removeResource(collRid, ns.ns());
@@ -476,6 +505,7 @@ void CollectionCatalog::deregisterAllCollections() {
     _collections.clear();
     _orderedCollections.clear();
     _catalog.clear();
+    _publishLookupSnapshot(lock);
 
     stdx::lock_guard<Latch> resourceLock(_resourceLock);
     _resourceInformation.clear();
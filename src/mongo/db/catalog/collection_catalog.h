@@ -31,6 +31,7 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <set>
 
 #include "mongo/db/catalog/collection.h"
@@ -250,6 +251,31 @@ public:
 private:
     friend class CollectionCatalog::iterator;
 
+    /**
+     * An immutable copy of the UUID and namespace mappings, including the pre-close namespaces of
+     * a closed catalog. Every change to those mappings builds a new snapshot under '_catalogLock'
+     * and publishes it atomically, so the lookup functions read the current snapshot without
+     * taking '_catalogLock' and never wait behind a collection being created, dropped or renamed.
+     */
+    struct LookupSnapshot {
+        uint64_t version = 0;
+        stdx::unordered_map<CollectionUUID,
+                            std::pair<Collection*, NamespaceString>,
+                            CollectionUUID::Hash>
+            byUUID;
+        stdx::unordered_map<NamespaceString, std::pair<Collection*, CollectionUUID>> byNamespace;
+        boost::optional<stdx::unordered_map<CollectionUUID, NamespaceString, CollectionUUID::Hash>>
+            shadowCatalog;
+    };
+
+    std::shared_ptr<const LookupSnapshot> _getLookupSnapshot() const;
+
+    /**
+     * Rebuilds the lookup snapshot from '_catalog', '_collections' and '_shadowCatalog' and
+     * publishes it.
+     */
+    void _publishLookupSnapshot(WithLock);
+
     Collection* _lookupCollectionByUUID(WithLock, CollectionUUID uuid) const;
 
     const std::vector<CollectionUUID>& _getOrdering_inlock(const StringData& db,
@@ -277,6 +303,9 @@ private:
      */
     uint64_t _generationNumber;
 
+    // Only accessed through std::atomic_load and std::atomic_store.
+    std::shared_ptr<const LookupSnapshot> _lookupSnapshot = std::make_shared<LookupSnapshot>();
+
     // Protects _resourceInformation.
     mutable Mutex _resourceLock = MONGO_MAKE_LATCH("CollectionCatalog::_resourceLock");
 
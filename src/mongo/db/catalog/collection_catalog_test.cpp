@@ -38,6 +38,7 @@
 #include "mongo/db/operation_context_noop.h"
 #include "mongo/db/service_context_d_test_fixture.h"
 #include "mongo/db/storage/durable_catalog.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 
@@ -528,6 +529,47 @@ TEST_F(CollectionCatalogTest, RenameCollection) {
     ASSERT_EQUALS(catalog.lookupCollectionByUUID(&opCtx, uuid), collection);
 }
 
+TEST_F(CollectionCatalogTest, LookupsFollowRenameCollection) {
+    auto uuid = CollectionUUID::gen();
+    NamespaceString oldNss(nss.db(), "oldcol");
+    std::unique_ptr<Collection> collUnique = std::make_unique<CollectionMock>(oldNss);
+    auto collection = collUnique.get();
+    catalog.registerCollection(uuid, &collUnique);
+
+    NamespaceString newNss(nss.db(), "newcol");
+    catalog.setCollectionNamespace(&opCtx, collection, oldNss, newNss);
+    ASSERT_EQUALS(catalog.lookupCollectionByNamespace(&opCtx, oldNss), nullptr);
+    ASSERT_EQUALS(catalog.lookupCollectionByNamespace(&opCtx, newNss), collection);
+    ASSERT_EQUALS(catalog.lookupUUIDByNSS(&opCtx, oldNss), boost::none);
+    ASSERT_EQUALS(*catalog.lookupUUIDByNSS(&opCtx, newNss), collection->uuid());
+    ASSERT_EQUALS(*catalog.lookupNSSByUUID(&opCtx, uuid), newNss);
+
+    catalog.deregisterAllCollections();
+    ASSERT_EQUALS(catalog.lookupCollectionByNamespace(&opCtx, newNss), nullptr);
+    ASSERT_EQUALS(catalog.lookupNSSByUUID(&opCtx, uuid), boost::none);
+}
+
+TEST_F(CollectionCatalogTest, ConcurrentLookupsDuringRegistration) {
+    AtomicWord<bool> done{false};
+    stdx::thread reader([&] {
+        OperationContextNoop readerOpCtx;
+        while (!done.load()) {
+            ASSERT_EQUALS(catalog.lookupCollectionByUUID(&readerOpCtx, colUUID), col);
+            ASSERT_EQUALS(*catalog.lookupNSSByUUID(&readerOpCtx, colUUID), nss);
+        }
+    });
+
+    for (int i = 0; i < 100; ++i) {
+        auto uuid = CollectionUUID::gen();
+        NamespaceString churnNss(nss.db(), "churn" + std::to_string(i));
+        std::unique_ptr<Collection> collUnique = std::make_unique<CollectionMock>(churnNss);
+        catalog.registerCollection(uuid, &collUnique);
+        catalog.deregisterCollection(uuid);
+    }
+    done.store(true);
+    reader.join();
+}
+
 TEST_F(CollectionCatalogTest, LookupNSSByUUIDForClosedCatalogReturnsOldNSSIfDropped) {
     catalog.onCloseCatalog(&opCtx);
     catalog.deregisterCollection(colUUID);
@@ -35,6 +35,7 @@
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/catalog/index_key_validate.h"
 #include "mongo/db/catalog/multi_index_block.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
@@ -111,9 +112,20 @@ StatusWith<int64_t> compactCollection(OperationContext* opCtx,
     auto oldTotalSize = recordStore->storageSize(opCtx) + collection->getIndexSize(opCtx);
     auto indexCatalog = collection->getIndexCatalog();
 
+    {
+        stdx::unique_lock<Client> lk(*opCtx->getClient());
+        CurOp::get(opCtx)->setMessage_inlock("Compact: compacting record store");
+    }
+
+    auto oldRecordStoreSize = recordStore->storageSize(opCtx);
     Status status = recordStore->compact(opCtx);
     if (!status.isOK())
         return status;
+    LOGV2_DEBUG(5212049,
+                1,
+                "compacted record store of {collectionNss}, bytes freed: {bytesFreed}",
+                "collectionNss"_attr = collectionNss,
+                "bytesFreed"_attr = oldRecordStoreSize - recordStore->storageSize(opCtx));
 
     // Compact all indexes (not including unfinished indexes)
     status = indexCatalog->compactIndexes(opCtx);
@@ -529,7 +529,8 @@ Status CollectionImpl::insertDocument(OperationContext* opCtx,
 
 Status CollectionImpl::insertDocumentForBulkLoader(OperationContext* opCtx,
                                                    const BSONObj& doc,
-                                                   const OnRecordInsertedFn& onRecordInserted) {
+                                                   const OnRecordInsertedFn& onRecordInserted,
+                                                   RecordStoreBulkLoader* recordBulkLoader) {
 
     auto status = checkFailCollectionInsertsFailPoint(_ns, doc);
     if (!status.isOK()) {
@@ -545,8 +546,9 @@ Status CollectionImpl::insertDocumentForBulkLoader(OperationContext* opCtx,
 
     // Using timestamp 0 for these inserts, which are non-oplog so we don't have an appropriate
     // timestamp to use.
-    StatusWith<RecordId> loc =
-        _recordStore->insertRecord(opCtx, doc.objdata(), doc.objsize(), Timestamp());
+    StatusWith<RecordId> loc = recordBulkLoader
+        ? recordBulkLoader->append(doc.objdata(), doc.objsize())
+        : _recordStore->insertRecord(opCtx, doc.objdata(), doc.objsize(), Timestamp());
 
     if (!loc.isOK())
         return loc.getStatus();
@@ -809,15 +811,18 @@ StatusWith<RecordData> CollectionImpl::updateDocumentWithDamages(
     const Snapshotted<RecordData>& oldRec,
     const char* damageSource,
     const mutablebson::DamageVector& damages,
+    bool indexesAffected,
+    OpDebug* opDebug,
     CollectionUpdateArgs* args) {
     dassert(opCtx->lockState()->isCollectionLockedForMode(ns(), MODE_IX));
     invariant(oldRec.snapshotId() == opCtx->recoveryUnit()->getSnapshotId());
     invariant(updateWithDamagesSupported());
 
     // For in-place updates we need to grab an owned copy of the pre-image doc if pre-image
-    // recording is enabled and we haven't already set the pre-image due to this update being
-    // a retryable findAndModify or a possible update to the shard key.
-    if (!args->preImageDoc && getRecordPreImages()) {
+    // recording is enabled or the index entries of the document must be updated, and we haven't
+    // already set the pre-image due to this update being a retryable findAndModify or a possible
+    // update to the shard key.
+    if (!args->preImageDoc && (getRecordPreImages() || indexesAffected)) {
         args->preImageDoc = oldRec.value().toBson().getOwned();
     }
 
@@ -826,6 +831,19 @@ StatusWith<RecordData> CollectionImpl::updateDocumentWithDamages(
 
     if (newRecStatus.isOK()) {
         args->updatedDoc = newRecStatus.getValue().toBson();
+
+        if (indexesAffected) {
+            int64_t keysInserted, keysDeleted;
+
+            uassertStatusOK(_indexCatalog->updateRecord(
+                opCtx, *args->preImageDoc, args->updatedDoc, loc, &keysInserted, &keysDeleted));
+
+            if (opDebug) {
+                opDebug->additiveMetrics.incrementKeysInserted(keysInserted);
+                opDebug->additiveMetrics.incrementKeysDeleted(keysDeleted);
+            }
+        }
+
         args->preImageRecordingEnabledForCollection = getRecordPreImages();
         OplogUpdateEntryArgs entryArgs(*args, ns(), _uuid);
         getGlobalServiceContext()->getOpObserver()->onUpdate(opCtx, entryArgs);
@@ -174,7 +174,8 @@ public:
      */
     Status insertDocumentForBulkLoader(OperationContext* opCtx,
                                        const BSONObj& doc,
-                                       const OnRecordInsertedFn& onRecordInserted) final;
+                                       const OnRecordInsertedFn& onRecordInserted,
+                                       RecordStoreBulkLoader* recordBulkLoader) final;
 
     /**
      * Updates the document @ oldLocation with newDoc.
@@ -196,10 +197,12 @@ public:
     bool updateWithDamagesSupported() const final;
 
     /**
-     * Not allowed to modify indexes.
+     * Applies 'damages' to the document @ loc in place. When 'indexesAffected' is true, also
+     * updates the index entries of the document.
      * Illegal to call if updateWithDamagesSupported() returns false.
      * Sets 'args.updatedDoc' to the updated version of the document with damages applied, on
      * success.
+     * 'opDebug' Optional argument. When not null, will be used to record operation statistics.
      * @return the contents of the updated record.
      */
     StatusWith<RecordData> updateDocumentWithDamages(OperationContext* opCtx,
@@ -207,6 +210,8 @@ public:
                                                      const Snapshotted<RecordData>& oldRec,
                                                      const char* damageSource,
                                                      const mutablebson::DamageVector& damages,
+                                                     bool indexesAffected,
+                                                     OpDebug* opDebug,
                                                      CollectionUpdateArgs* args) final;
 
     // -----------
@@ -135,7 +135,8 @@ public:
 
     Status insertDocumentForBulkLoader(OperationContext* opCtx,
                                        const BSONObj& doc,
-                                       const OnRecordInsertedFn& onRecordInserted) {
+                                       const OnRecordInsertedFn& onRecordInserted,
+                                       RecordStoreBulkLoader* recordBulkLoader) {
         std::abort();
     }
 
@@ -158,6 +159,8 @@ public:
                                                      const Snapshotted<RecordData>& oldRec,
                                                      const char* damageSource,
                                                      const mutablebson::DamageVector& damages,
+                                                     bool indexesAffected,
+                                                     OpDebug* opDebug,
                                                      CollectionUpdateArgs* args) {
         std::abort();
     }
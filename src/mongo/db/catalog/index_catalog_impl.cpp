@@ -1650,23 +1650,46 @@ void IndexCatalogImpl::unindexRecord(OperationContext* opCtx,
 }
 
 Status IndexCatalogImpl::compactIndexes(OperationContext* opCtx) {
+    // A single index's compaction cannot be interrupted, so report which index we are on in
+    // currentOp and allow the operation to be killed between indexes.
+    ProgressMeterHolder progress;
+    {
+        stdx::unique_lock<Client> lk(*opCtx->getClient());
+        progress.set(CurOp::get(opCtx)->setProgress_inlock(
+            "Compact: compacting indexes", _readyIndexes.size(), 1));
+    }
+
     for (IndexCatalogEntryContainer::const_iterator it = _readyIndexes.begin();
          it != _readyIndexes.end();
          ++it) {
+        Status status = opCtx->checkForInterruptNoAssert();
+        if (!status.isOK()) {
+            return status;
+        }
+
         IndexCatalogEntry* entry = it->get();
+        IndexAccessMethod* iam = entry->accessMethod();
 
         LOGV2_DEBUG(20363,
                     1,
                     "compacting index: {entry_descriptor}",
                     "entry_descriptor"_attr = entry->descriptor()->toString());
-        Status status = entry->accessMethod()->compact(opCtx);
+        auto oldIndexSize = iam->getSpaceUsedBytes(opCtx);
+        status = iam->compact(opCtx);
         if (!status.isOK()) {
             LOGV2_ERROR(20377,
                         "failed to compact index: {entry_descriptor}",
                         "entry_descriptor"_attr = entry->descriptor()->toString());
             return status;
         }
+        LOGV2_DEBUG(5212050,
+                    1,
+                    "compacted index {indexName}, bytes freed: {bytesFreed}",
+                    "indexName"_attr = entry->descriptor()->indexName(),
+                    "bytesFreed"_attr = oldIndexSize - iam->getSpaceUsedBytes(opCtx));
+        progress.hit();
     }
+    progress.finished();
     return Status::OK();
 }
 
@@ -36,6 +36,7 @@
 #include "mongo/db/catalog/index_consistency.h"
 
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/catalog/max_validate_mb_per_sec_gen.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/util/string_map.h"
@@ -44,7 +45,25 @@ namespace mongo {
 
 namespace {
 
-const size_t kNumHashBuckets = 1U << 16;
+// The minimum number of hash buckets, used for small collections and as the unit of growth.
+const size_t kMinNumHashBuckets = 1U << 16;
+
+/**
+ * Returns the number of hash buckets to use for 'numExpectedKeys' index keys: the smallest power
+ * of two with at least one bucket per key, bounded by 'maxValidateMemoryUsageMB'.
+ */
+size_t _numHashBuckets(long long numExpectedKeys) {
+    const size_t maxNumBuckets = std::max<size_t>(
+        kMinNumHashBuckets,
+        static_cast<size_t>(gMaxValidateMemoryUsageMB.load()) * 1024 * 1024 / sizeof(uint32_t));
+
+    size_t numBuckets = kMinNumHashBuckets;
+    while (numBuckets < static_cast<unsigned long long>(numExpectedKeys) &&
+           numBuckets * 2 <= maxNumBuckets) {
+        numBuckets *= 2;
+    }
+    return numBuckets;
+}
 
 StringSet::hasher hash;
 
@@ -75,12 +94,17 @@ IndexInfo::IndexInfo(const IndexDescriptor* descriptor)
 IndexConsistency::IndexConsistency(OperationContext* opCtx,
                                    CollectionValidation::ValidateState* validateState)
     : _validateState(validateState), _firstPhase(true) {
-    _indexKeyCount.resize(kNumHashBuckets);
-
     for (const auto& index : _validateState->getIndexes()) {
         const IndexDescriptor* descriptor = index->descriptor();
         _indexesInfo.emplace(descriptor->indexName(), IndexInfo(descriptor));
     }
+
+    // With a fixed number of buckets, each bucket of a large collection covers many keys and a
+    // single inconsistency makes the second phase record all of them. Grow the buckets with the
+    // number of keys we expect to see instead.
+    const long long numExpectedKeys = _validateState->getCollection()->numRecords(opCtx) *
+        static_cast<long long>(_indexesInfo.size());
+    _indexKeyCount.resize(_numHashBuckets(numExpectedKeys));
 }
 
 void IndexConsistency::addMultikeyMetadataPath(const KeyString::Value& ks, IndexInfo* indexInfo) {
@@ -306,6 +330,6 @@ BSONObj IndexConsistency::_generateInfo(const IndexInfo& indexInfo,
 
 uint32_t IndexConsistency::_hashKeyString(const KeyString::Value& ks,
                                           uint32_t indexNameHash) const {
-    return ks.hash(indexNameHash) % kNumHashBuckets;
+    return ks.hash(indexNameHash) % _indexKeyCount.size();
 }
 }  // namespace mongo
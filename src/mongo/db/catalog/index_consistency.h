@@ -138,7 +138,8 @@ private:
 
     // We map the hashed KeyString values to a bucket that contains the count of how many
     // index keys and document keys we've seen in each bucket. This counter is unsigned to avoid
-    // undefined behavior in the (unlikely) case of overflow.
+    // undefined behavior in the (unlikely) case of overflow. The number of buckets grows with the
+    // collection, bounded by 'maxValidateMemoryUsageMB'.
     // Count rules:
     //     - If the count is non-zero for a bucket after all documents and index entries have been
     //       processed, one or more indexes are inconsistent for KeyStrings that map to it.
@@ -33,6 +33,7 @@
 
 #include "mongo/db/catalog/multi_index_block.h"
 
+#include <algorithm>
 #include <ostream>
 
 #include "mongo/base/error_codes.h"
@@ -56,10 +57,12 @@
 #include "mongo/logger/redaction.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/progress_meter.h"
 #include "mongo/util/quick_exit.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 #include "mongo/util/uuid.h"
 
 namespace mongo {
@@ -72,6 +75,161 @@ MONGO_FAIL_POINT_DEFINE(hangAfterIndexBuildOf);
 MONGO_FAIL_POINT_DEFINE(hangAndThenFailIndexBuild);
 MONGO_FAIL_POINT_DEFINE(leaveIndexBuildUnfinishedForShutdown);
 
+namespace {
+// Limits on the documents buffered by ParallelKeyGenerator before their keys are generated.
+constexpr size_t kKeyGenerationBatchDocuments = 4096;
+constexpr size_t kKeyGenerationBatchBytes = 16 * 1024 * 1024;
+}  // namespace
+
+/**
+ * Buffers the documents scanned by insertAllDocumentsInCollection() and generates their keys for
+ * every index on a pool of threads, one batch at a time. The keys are then added to each index's
+ * bulk builder on the scanning thread, since the external sorters are not thread-safe.
+ */
+class MultiIndexBlock::ParallelKeyGenerator {
+public:
+    ParallelKeyGenerator(MultiIndexBlock* block, size_t numThreads)
+        : _block(block), _numThreads(numThreads), _pool([&] {
+              ThreadPool::Options options;
+              options.poolName = "IndexBuildKeyGenerationPool";
+              options.threadNamePrefix = "IndexBuildKeyGeneration-";
+              // The scanning thread generates keys for one share of each batch itself.
+              options.maxThreads = numThreads - 1;
+              options.onCreateThread = [](const std::string& threadName) {
+                  Client::initThread(threadName.c_str());
+              };
+              return options;
+          }()) {
+        invariant(numThreads > 1);
+        _pool.startup();
+    }
+
+    ~ParallelKeyGenerator() {
+        _pool.shutdown();
+        _pool.join();
+    }
+
+    /**
+     * Buffers 'doc' and, once the batch is full, adds the keys of all buffered documents.
+     */
+    Status add(OperationContext* opCtx, const BSONObj& doc, const RecordId& loc) {
+        _batch.emplace_back(doc.getOwned(), loc);
+        _batchBytes += doc.objsize();
+        if (_batch.size() >= kKeyGenerationBatchDocuments ||
+            _batchBytes >= kKeyGenerationBatchBytes) {
+            return flush(opCtx);
+        }
+        return Status::OK();
+    }
+
+    /**
+     * Adds the keys of all buffered documents.
+     */
+    Status flush(OperationContext* opCtx) {
+        if (_batch.empty()) {
+            return Status::OK();
+        }
+        if (State::kAborted == _block->_getState()) {
+            return {ErrorCodes::IndexBuildAborted,
+                    str::stream() << "Index build aborted: " << _block->_abortReason};
+        }
+
+        const auto& indexes = _block->_indexes;
+        // Keys of the document at position 'i' in the batch for the index at position 'j' are at
+        // position 'i * indexes.size() + j'. Documents which do not match the filter of a partial
+        // index have no keys for it.
+        std::vector<boost::optional<IndexAccessMethod::BulkBuilder::GeneratedKeys>> keys(
+            _batch.size() * indexes.size());
+        std::vector<Status> statuses(_numThreads, Status::OK());
+        // Each thread needs its own copy of the shared field lookup, which holds the fields of the
+        // document it was last set to.
+        std::vector<boost::optional<TopLevelFieldLookup>> topLevelFields(_numThreads,
+                                                                         _block->_topLevelFields);
+
+
+        // Each thread takes every '_numThreads'-th document, so that the cost of large documents is
+        // spread evenly.
+        auto generateKeys = [&](size_t thread) {
+            try {
+                auto& fields = topLevelFields[thread];
+                for (size_t i = thread; i < _batch.size(); i += _numThreads) {
+                    const auto& [doc, loc] = _batch[i];
+                    if (fields) {
+                        fields->setDocument(doc);
+                    }
+                    for (size_t j = 0; j < indexes.size(); ++j) {
+                        const auto& index = indexes[j];
+                        if (index.filterExpression && !index.filterExpression->matchesBSON(doc)) {
+                            continue;
+                        }
+                        auto& generated = keys[i * indexes.size() + j];
+                        generated.emplace();
+                        auto status = index.bulk->generateKeys(
+                            doc, loc, index.options, &generated.get(), fields.get_ptr());
+                        if (!status.isOK()) {
+                            statuses[thread] = status;
+                            return;
+                        }
+                    }
+                }
+            } catch (...) {
+                statuses[thread] = exceptionToStatus();
+            }
+        };
+
+        for (size_t thread = 1; thread < _numThreads; ++thread) {
+            _pool.schedule([&, thread](Status status) {
+                if (!status.isOK()) {
+                    statuses[thread] = status;
+                    return;
+                }
+                generateKeys(thread);
+            });
+        }
+        generateKeys(0);
+        _pool.waitForIdle();
+
+        for (auto&& status : statuses) {
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+
+        for (size_t i = 0; i < _batch.size(); ++i) {
+            const auto& [doc, loc] = _batch[i];
+            for (size_t j = 0; j < indexes.size(); ++j) {
+                auto& generated = keys[i * indexes.size() + j];
+                if (!generated) {
+                    continue;
+                }
+                // Adding keys to a BulkBuilderImpl's Sorter performs file I/O that may result in
+                // an exception.
+                try {
+                    auto status =
+                        indexes[j].bulk->insertKeys(opCtx, doc, loc, std::move(*generated));
+                    if (!status.isOK()) {
+                        return status;
+                    }
+                } catch (...) {
+                    return exceptionToStatus();
+                }
+            }
+        }
+
+        _batch.clear();
+        _batchBytes = 0;
+        return Status::OK();
+    }
+
+private:
+    MultiIndexBlock* const _block;
+    const size_t _numThreads;
+    ThreadPool _pool;
+
+    std::vector<std::pair<BSONObj, RecordId>> _batch;
+    size_t _batchBytes = 0;
+};
+
 MultiIndexBlock::~MultiIndexBlock() {
     invariant(_buildIsCleanedUp);
 }
@@ -348,6 +506,25 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(OperationContext* opCtx,
             _indexes.push_back(std::move(index));
         }
 
+        std::vector<std::string> topLevelFieldNames;
+        size_t numBtreeBulkIndexes = 0;
+        for (const auto& index : _indexes) {
+            const IndexDescriptor* descriptor = index.block->getEntry()->descriptor();
+            if (!index.bulk || descriptor->getIndexType() != INDEX_BTREE) {
+                continue;
+            }
+            ++numBtreeBulkIndexes;
+            for (auto&& keyElem : descriptor->keyPattern()) {
+                auto fieldName = keyElem.fieldNameStringData();
+                if (!fieldName.empty() && fieldName.find('.') == std::string::npos) {
+                    topLevelFieldNames.push_back(fieldName.toString());
+                }
+            }
+        }
+        if (numBtreeBulkIndexes > 1) {
+            _topLevelFields.emplace(std::move(topLevelFieldNames));
+        }
+
         if (isBackgroundBuilding())
             _backgroundOperation.reset(new BackgroundOperation(ns));
 
@@ -453,6 +630,17 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(OperationContext* opCtx,
         _method != IndexBuildMethod::kBackground && useReadOnceCursorsForIndexBuilds.load();
     opCtx->recoveryUnit()->setReadOnce(readOnce);
 
+    // Key generation is CPU bound, so spread it across threads when every index is built through
+    // a bulk builder. Background builds insert into the indexes directly.
+    std::unique_ptr<ParallelKeyGenerator> keyGenerator;
+    const size_t numKeyGenerationThreads = maxIndexBuildKeyGenerationThreads.load();
+    if (numKeyGenerationThreads > 1 &&
+        std::all_of(_indexes.begin(), _indexes.end(), [](const IndexToBuild& index) {
+            return static_cast<bool>(index.bulk);
+        })) {
+        keyGenerator = std::make_unique<ParallelKeyGenerator>(this, numKeyGenerationThreads);
+    }
+
     Snapshotted<BSONObj> objToIndex;
     RecordId loc;
     PlanExecutor::ExecState state;
@@ -483,7 +671,8 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(OperationContext* opCtx,
             failPointHangDuringBuild(&hangBeforeIndexBuildOf, "before", objToIndex.value());
 
             WriteUnitOfWork wunit(opCtx);
-            Status ret = insert(opCtx, objToIndex.value(), loc);
+            Status ret = keyGenerator ? keyGenerator->add(opCtx, objToIndex.value(), loc)
+                                      : insert(opCtx, objToIndex.value(), loc);
             if (_method == IndexBuildMethod::kBackground)
                 exec->saveState();
             if (!ret.isOK()) {
@@ -530,6 +719,15 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(OperationContext* opCtx,
         return exec->getMemberObjectStatus(objToIndex.value());
     }
 
+    if (keyGenerator) {
+        WriteUnitOfWork wunit(opCtx);
+        Status ret = keyGenerator->flush(opCtx);
+        if (!ret.isOK()) {
+            return ret;
+        }
+        wunit.commit();
+    }
+
     if (MONGO_unlikely(leaveIndexBuildUnfinishedForShutdown.shouldFail())) {
         LOGV2(20389,
               "Index build interrupted due to 'leaveIndexBuildUnfinishedForShutdown' failpoint. "
@@ -579,6 +777,10 @@ Status MultiIndexBlock::insert(OperationContext* opCtx, const BSONObj& doc, cons
                 str::stream() << "Index build aborted: " << _abortReason};
     }
 
+    if (_topLevelFields) {
+        _topLevelFields->setDocument(doc);
+    }
+
     for (size_t i = 0; i < _indexes.size(); i++) {
         if (_indexes[i].filterExpression && !_indexes[i].filterExpression->matchesBSON(doc)) {
             continue;
@@ -590,7 +792,16 @@ Status MultiIndexBlock::insert(OperationContext* opCtx, const BSONObj& doc, cons
             // When calling insert, BulkBuilderImpl's Sorter performs file I/O that may result in an
             // exception.
             try {
-                idxStatus = _indexes[i].bulk->insert(opCtx, doc, loc, _indexes[i].options);
+                IndexAccessMethod::BulkBuilder::GeneratedKeys generatedKeys;
+                idxStatus = _indexes[i].bulk->generateKeys(doc,
+                                                           loc,
+                                                           _indexes[i].options,
+                                                           &generatedKeys,
+                                                           _topLevelFields.get_ptr());
+                if (idxStatus.isOK()) {
+                    idxStatus =
+                        _indexes[i].bulk->insertKeys(opCtx, doc, loc, std::move(generatedKeys));
+                }
             } catch (...) {
                 return exceptionToStatus();
             }
@@ -640,11 +851,13 @@ Status MultiIndexBlock::dumpInsertsFromBulk(OperationContext* opCtx,
         // SERVER-41918 This call to commitBulk() results in file I/O that may result in an
         // exception.
         try {
+            Timer timer;
             Status status = _indexes[i].real->commitBulk(opCtx,
                                                          _indexes[i].bulk.get(),
                                                          dupsAllowed,
                                                          dupRecords,
                                                          (dupRecords) ? nullptr : &dupKeysInserted);
+            _indexes[i].bulkLoadDuration = Milliseconds(timer.millis());
 
             if (!status.isOK()) {
                 return status;
@@ -672,6 +885,13 @@ Status MultiIndexBlock::dumpInsertsFromBulk(OperationContext* opCtx,
     return Status::OK();
 }
 
+void MultiIndexBlock::appendBulkLoadMillis(BSONObjBuilder* builder) const {
+    for (const auto& index : _indexes) {
+        builder->append(index.block->getEntry()->descriptor()->indexName(),
+                        durationCount<Milliseconds>(index.bulkLoadDuration));
+    }
+}
+
 Status MultiIndexBlock::drainBackgroundWrites(
     OperationContext* opCtx,
     RecoveryUnit::ReadSource readSource,
@@ -46,6 +46,7 @@
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_build_interceptor.h"
+#include "mongo/db/index/top_level_field_lookup.h"
 #include "mongo/db/record_id.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/fail_point.h"
@@ -192,6 +193,12 @@ public:
     Status dumpInsertsFromBulk(OperationContext* opCtx);
     Status dumpInsertsFromBulk(OperationContext* opCtx, std::set<RecordId>* const dupRecords);
 
+    /**
+     * Appends the time in milliseconds that dumpInsertsFromBulk() spent loading each index from its
+     * external sorter, keyed by index name.
+     */
+    void appendBulkLoadMillis(BSONObjBuilder* builder) const;
+
     /**
      * For background indexes using an IndexBuildInterceptor to capture inserts during a build,
      * drain these writes into the index. If intent locks are held on the collection, more writes
@@ -329,6 +336,8 @@ public:
     State getState_forTest() const;
 
 private:
+    class ParallelKeyGenerator;
+
     struct IndexToBuild {
         std::unique_ptr<IndexBuildBlock> block;
 
@@ -337,6 +346,9 @@ private:
         std::unique_ptr<IndexAccessMethod::BulkBuilder> bulk;
 
         InsertDeleteOptions options;
+
+        // Time spent in dumpInsertsFromBulk() loading this index from 'bulk'.
+        Milliseconds bulkLoadDuration{0};
     };
 
     /**
@@ -359,6 +371,11 @@ private:
 
     std::vector<IndexToBuild> _indexes;
 
+    // Set when several btree indexes are bulk built, to the union of the top-level fields of their
+    // key patterns. Each document is then searched once for all of these fields rather than once
+    // per index.
+    boost::optional<TopLevelFieldLookup> _topLevelFields;
+
     std::unique_ptr<BackgroundOperation> _backgroundOperation;
 
     IndexBuildMethod _method = IndexBuildMethod::kHybrid;
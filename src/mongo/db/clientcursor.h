@@ -242,6 +242,21 @@ public:
         _nReturnedSoFar = n;
     }
 
+    /**
+     * Returns the total size in bytes of the batches of query results returned by the cursor so
+     * far.
+     */
+    std::uint64_t nBytesReturnedSoFar() const {
+        return _nBytesReturnedSoFar;
+    }
+
+    /**
+     * Increments the cursor's tracked number of bytes of query results returned so far by 'n'.
+     */
+    void incNBytesReturnedSoFar(std::uint64_t n) {
+        _nBytesReturnedSoFar += n;
+    }
+
     /**
      * Returns the number of batches returned by this cursor so far.
      */
@@ -404,6 +419,9 @@ private:
     // Tracks the number of results returned by this cursor so far.
     std::uint64_t _nReturnedSoFar = 0;
 
+    // Tracks the size in bytes of the batches returned by this cursor so far.
+    std::uint64_t _nBytesReturnedSoFar = 0;
+
     // Tracks the number of batches returned by this cursor so far.
     std::uint64_t _nBatchesReturned = 0;
 
@@ -112,6 +112,30 @@ public:
             }
         }
 
+        // The optional 'min' and 'max' fields restrict the hash of a single collection to the
+        // documents with an _id in [min, max). Comparing the hashes of sub-ranges of a collection
+        // lets two nodes narrow down where their copies differ without rehashing all of it.
+        BSONObj minId;
+        BSONObj maxId;
+        for (auto&& [fieldName, bound] :
+             {std::make_pair("min", &minId), std::make_pair("max", &maxId)}) {
+            auto elem = cmdObj[fieldName];
+            if (!elem) {
+                continue;
+            }
+            uassert(ErrorCodes::TypeMismatch,
+                    str::stream() << "'" << fieldName << "' must be an object",
+                    elem.type() == Object);
+            *bound = elem.Obj().getOwned();
+            uassert(ErrorCodes::InvalidOptions,
+                    str::stream() << "'" << fieldName << "' must be of the form {_id: <value>}",
+                    bound->nFields() == 1 && bound->hasField("_id"));
+            uassert(ErrorCodes::InvalidOptions,
+                    str::stream() << "'" << fieldName
+                                  << "' requires 'collections' to name exactly one collection",
+                    desiredCollections.size() == 1);
+        }
+
         const std::string ns = parseNs(dbname, cmdObj);
         uassert(ErrorCodes::InvalidNamespace,
                 str::stream() << "Invalid db name: " << ns,
@@ -277,7 +301,7 @@ public:
             }
 
             // Compute the hash for this collection.
-            std::string hash = _hashCollection(opCtx, db, collNss);
+            std::string hash = _hashCollection(opCtx, db, collNss, minId, maxId);
 
             collectionToHashMap[collNss.coll().toString()] = hash;
 
@@ -323,7 +347,11 @@ public:
     }
 
 private:
-    std::string _hashCollection(OperationContext* opCtx, Database* db, const NamespaceString& nss) {
+    std::string _hashCollection(OperationContext* opCtx,
+                                Database* db,
+                                const NamespaceString& nss,
+                                const BSONObj& minId,
+                                const BSONObj& maxId) {
 
         Collection* collection =
             CollectionCatalog::get(opCtx).lookupCollectionByNamespace(opCtx, nss);
@@ -355,13 +383,18 @@ private:
 
         auto desc = collection->getIndexCatalog()->findIdIndex(opCtx);
 
+        uassert(ErrorCodes::InvalidOptions,
+                str::stream() << "Hashing a range of " << nss << " requires an _id index",
+                desc || (minId.isEmpty() && maxId.isEmpty()));
+
         std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec;
         if (desc) {
+            // Empty bounds scan the whole index.
             exec = InternalPlanner::indexScan(opCtx,
                                               collection,
                                               desc,
-                                              BSONObj(),
-                                              BSONObj(),
+                                              minId,
+                                              maxId,
                                               BoundInclusion::kIncludeStartKeyOnly,
                                               PlanExecutor::NO_YIELD,
                                               InternalPlanner::FORWARD,
@@ -580,6 +580,7 @@ public:
                         opCtx->getRemainingMaxTimeMicros());
                 }
                 pinnedCursor.getCursor()->setNReturnedSoFar(numResults);
+                pinnedCursor.getCursor()->incNBytesReturnedSoFar(firstBatch.bytesUsed());
                 pinnedCursor.getCursor()->incNBatches();
 
                 // Fill out curop based on the results.
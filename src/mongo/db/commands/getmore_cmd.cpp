@@ -573,6 +573,12 @@ public:
             CursorId respondWithId = 0;
 
             CursorResponseBuilder nextBatch(reply, CursorResponseBuilder::Options());
+            // Size the reply for the batch this cursor is likely to return, judging by the
+            // documents it has returned so far, so a large batch does not repeatedly reallocate it.
+            nextBatch.reserve(FindCommon::predictGetMoreBytes(cursorPin->nReturnedSoFar(),
+                                                              cursorPin->nBytesReturnedSoFar(),
+                                                              cursorPin->getNBatches(),
+                                                              _request.batchSize.value_or(0)));
             BSONObj obj;
             PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
             std::uint64_t numResults = 0;
@@ -649,6 +655,7 @@ public:
 
                 cursorPin->setLeftoverMaxTimeMicros(opCtx->getRemainingMaxTimeMicros());
                 cursorPin->incNReturnedSoFar(numResults);
+                cursorPin->incNBytesReturnedSoFar(nextBatch.bytesUsed());
                 cursorPin->incNBatches();
 
                 if (opCtx->isExhaust() && !clientsLastKnownCommittedOpTime(opCtx).isNull()) {
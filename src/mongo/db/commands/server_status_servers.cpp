@@ -38,6 +38,7 @@
 #include "mongo/util/net/hostname_canonicalization.h"
 #include "mongo/util/net/socket_utils.h"
 #include "mongo/util/net/ssl_manager.h"
+#include "mongo/util/shared_buffer_pool.h"
 
 namespace mongo {
 
@@ -84,6 +85,14 @@ public:
         BSONObjBuilder b;
         networkCounter.append(b);
         appendMessageCompressionStats(&b);
+        {
+            const auto poolStats = SharedBufferPool::getStats();
+            BSONObjBuilder section(b.subobjStart("bufferPool"));
+            section.append("hits", poolStats.hits);
+            section.append("misses", poolStats.misses);
+            section.append("cached", poolStats.cached);
+            section.append("freed", poolStats.freed);
+        }
         auto executor = opCtx->getServiceContext()->getServiceExecutor();
         if (executor) {
             BSONObjBuilder section(b.subobjStart("serviceExecutorTaskStats"));
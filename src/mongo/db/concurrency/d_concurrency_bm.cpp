@@ -128,6 +128,29 @@ BENCHMARK_DEFINE_F(DConcurrencyTest, BM_CollectionIntentExclusiveLock)(benchmark
     }
 }
 
+BENCHMARK_DEFINE_F(DConcurrencyTest, BM_DistinctCollectionIntentExclusiveLock)
+(benchmark::State& state) {
+    std::unique_ptr<ForceSupportsDocLocking> supportDocLocking;
+
+    if (state.thread_index == 0) {
+        makeKClientsWithLockers(state.threads);
+        supportDocLocking = std::make_unique<ForceSupportsDocLocking>(true);
+    }
+
+    // The lock acquisitions of a simple write, on a distinct collection per thread so that the
+    // only shared intent locks are the global and database ones.
+    const NamespaceString nss("test", str::stream() << "coll" << state.thread_index);
+    for (auto keepRunning : state) {
+        auto opCtx = clients[state.thread_index].second.get();
+        Lock::DBLock dlk(opCtx, "test", MODE_IX);
+        Lock::CollectionLock clk(opCtx, nss, MODE_IX);
+    }
+
+    if (state.thread_index == 0) {
+        clients.clear();
+    }
+}
+
 BENCHMARK_DEFINE_F(DConcurrencyTest, BM_MMAPv1CollectionSharedLock)(benchmark::State& state) {
     std::unique_ptr<ForceSupportsDocLocking> supportDocLocking;
 
@@ -176,6 +199,11 @@ BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionIntentSharedLock)
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionIntentExclusiveLock)
     ->ThreadRange(1, kMaxPerfThreads);
 
+// Measures aggregate throughput, which is what intent lock scaling across cores affects.
+BENCHMARK_REGISTER_F(DConcurrencyTest, BM_DistinctCollectionIntentExclusiveLock)
+    ->ThreadRange(1, kMaxPerfThreads)
+    ->UseRealTime();
+
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_MMAPv1CollectionSharedLock)
     ->ThreadRange(1, kMaxPerfThreads);
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_MMAPv1CollectionExclusiveLock)
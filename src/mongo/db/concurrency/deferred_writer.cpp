@@ -99,38 +99,88 @@ StatusWith<std::unique_ptr<AutoGetCollection>> DeferredWriter::_getCollection(
     return std::move(agc);
 }
 
-void DeferredWriter::_worker(InsertStatement stmt) {
-    auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
-    OperationContext* opCtx = uniqueOpCtx.get();
+Status DeferredWriter::_writeBatch(OperationContext* opCtx,
+                                   const std::vector<InsertStatement>& batch) {
     auto result = _getCollection(opCtx);
-
     if (!result.isOK()) {
-        _logFailure(result.getStatus());
-        return;
+        return result.getStatus();
     }
 
     auto agc = std::move(result.getValue());
-
     Collection& collection = *agc->getCollection();
 
-    Status status = writeConflictRetry(opCtx, "deferred insert", _nss.ns(), [&] {
-        WriteUnitOfWork wuow(opCtx);
-        Status status = collection.insertDocument(opCtx, stmt, nullptr, false);
-        if (!status.isOK()) {
-            return status;
+    auto insert = [&](std::vector<InsertStatement>::const_iterator begin,
+                      std::vector<InsertStatement>::const_iterator end) {
+        return writeConflictRetry(opCtx, "deferred insert", _nss.ns(), [&] {
+            WriteUnitOfWork wuow(opCtx);
+            Status status = collection.insertDocuments(opCtx, begin, end, nullptr, false);
+            if (!status.isOK()) {
+                return status;
+            }
+
+            wuow.commit();
+            return Status::OK();
+        });
+    };
+
+    Status status = insert(batch.begin(), batch.end());
+    if (status.isOK() || batch.size() == 1) {
+        return status;
+    }
+
+    for (auto it = batch.begin(); it != batch.end(); ++it) {
+        Status docStatus = insert(it, it + 1);
+        if (!docStatus.isOK()) {
+            status = docStatus;
         }
+    }
+    return status;
+}
 
-        wuow.commit();
-        return Status::OK();
-    });
+void DeferredWriter::_worker() {
+    auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
+    OperationContext* opCtx = uniqueOpCtx.get();
 
-    stdx::lock_guard<Latch> lock(_mutex);
+    while (true) {
+        std::vector<InsertStatement> batch;
+        int64_t batchBytes = 0;
+        {
+            stdx::unique_lock<Latch> lock(_mutex);
+
+            // Give more documents a chance to join the batch, unless it's already full.
+            _pendingCV.wait_for(lock, kBatchDelay.toSystemDuration(), [&] {
+                return _shuttingDown || _pending.size() >= kMaxBatchDocuments ||
+                    _pendingBytes >= kMaxBatchBytes;
+            });
+
+            while (!_pending.empty() && batch.size() < kMaxBatchDocuments) {
+                auto docBytes = _pending.front().doc.objsize();
+                if (!batch.empty() && batchBytes + docBytes > kMaxBatchBytes) {
+                    break;
+                }
+                batchBytes += docBytes;
+                batch.push_back(std::move(_pending.front()));
+                _pending.pop_front();
+            }
+            _pendingBytes -= batchBytes;
+
+            if (batch.empty()) {
+                _workerScheduled = false;
+                return;
+            }
+        }
+
+        Status status = _writeBatch(opCtx, batch);
 
-    _numBytes -= stmt.doc.objsize();
+        stdx::lock_guard<Latch> lock(_mutex);
 
-    // If a write to a deferred collection fails, periodically tell the log.
-    if (!status.isOK()) {
-        _logFailure(status);
+        _numBytes -= batchBytes;
+        ++_batchesWritten;
+
+        // If a write to a deferred collection fails, periodically tell the log.
+        if (!status.isOK()) {
+            _logFailure(status);
+        }
     }
 }
 
@@ -163,6 +213,12 @@ void DeferredWriter::shutdown(void) {
         return;
     }
 
+    {
+        stdx::lock_guard<Latch> lock(_mutex);
+        _shuttingDown = true;
+        _pendingCV.notify_all();
+    }
+
     _pool->waitForIdle();
     _pool->shutdown();
     _pool->join();
@@ -184,11 +240,21 @@ bool DeferredWriter::insertDocument(BSONObj obj) {
 
     // Add the object to the buffer.
     _numBytes += obj.objsize();
-    _pool->schedule([this, obj](auto status) {
-        fassert(40588, status);
+    _pendingBytes += obj.objsize();
+    _pending.emplace_back(obj.getOwned());
 
-        _worker(InsertStatement(obj.getOwned()));
-    });
+    if (_pending.size() >= kMaxBatchDocuments || _pendingBytes >= kMaxBatchBytes) {
+        _pendingCV.notify_one();
+    }
+
+    if (!_workerScheduled) {
+        _workerScheduled = true;
+        _pool->schedule([this](auto status) {
+            fassert(40588, status);
+
+            _worker();
+        });
+    }
     return true;
 }
 
@@ -196,5 +262,10 @@ int64_t DeferredWriter::getDroppedEntries() {
     return _droppedEntries;
 }
 
+int64_t DeferredWriter::getBatchesWritten() {
+    stdx::lock_guard<Latch> lock(_mutex);
+    return _batchesWritten;
+}
+
 
 }  // namespace mongo
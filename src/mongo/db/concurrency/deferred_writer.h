@@ -29,10 +29,14 @@
 
 #pragma once
 
+#include <deque>
+#include <vector>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
 
 namespace mongo {
 
@@ -49,6 +53,10 @@ class ThreadPool;
  * guarantees, and cannot report whether the insert succeeded--in other words, this class provides
  * eventual "best effort" inserts.
  *
+ * Buffered documents are written in batches: the worker waits up to `kBatchDelay` for more
+ * documents to arrive, or until `kMaxBatchDocuments` documents or `kMaxBatchBytes` bytes are
+ * pending, and then inserts them in a single write unit of work.
+ *
  * Because this class is motivated by the health log and errors cannot be cleanly reported to the
  * caller, it cannot report most errors to the client; it instead periodically logs any errors to
  * the system log.
@@ -61,6 +69,10 @@ class DeferredWriter {
     DeferredWriter& operator=(const DeferredWriter&) = delete;
 
 public:
+    static constexpr std::size_t kMaxBatchDocuments = 500;
+    static constexpr int64_t kMaxBatchBytes = 1024 * 1024;
+    static constexpr Milliseconds kBatchDelay{10};
+
     /**
      * Create a new DeferredWriter for writing to a given collection.
      *
@@ -109,6 +121,11 @@ public:
      */
     int64_t getDroppedEntries();
 
+    /**
+     * Get the number of batches written to the backing collection, whether or not they succeeded.
+     */
+    int64_t getBatchesWritten();
+
 private:
     /**
      * Log failure, but only if a certain interval has passed since the last log.
@@ -134,9 +151,16 @@ private:
     StatusWith<std::unique_ptr<AutoGetCollection>> _getCollection(OperationContext* opCtx);
 
     /**
-     * The method that the worker thread will run.
+     * The method that the worker thread will run. Writes batches of pending documents until there
+     * are none left.
      */
-    void _worker(InsertStatement stmt);
+    void _worker();
+
+    /**
+     * Insert `batch` into the backing collection. If the batch fails as a whole, fall back to
+     * inserting its documents one at a time so a single bad document doesn't lose the others.
+     */
+    Status _writeBatch(OperationContext* opCtx, const std::vector<InsertStatement>& batch);
 
     /**
      * The options for the collection, in case we need to create it.
@@ -161,10 +185,30 @@ private:
     Mutex _mutex = MONGO_MAKE_LATCH("DeferredWriter::_mutex");
 
     /**
-     * The number of bytes currently in the in-memory buffer.
+     * The number of bytes currently in the in-memory buffer, including the batch being written.
      */
     int64_t _numBytes;
 
+    /**
+     * Documents waiting to be picked up by the worker, and their total size in bytes.
+     */
+    std::deque<InsertStatement> _pending;
+    int64_t _pendingBytes = 0;
+
+    /**
+     * Signalled when a batch fills up or the writer shuts down, to cut the batch delay short.
+     */
+    stdx::condition_variable _pendingCV;
+
+    /**
+     * Whether a worker task is scheduled or running; it picks up any document pushed meanwhile.
+     */
+    bool _workerScheduled = false;
+
+    bool _shuttingDown = false;
+
+    int64_t _batchesWritten = 0;
+
     /**
      * The number of deffered entries that have been dropped. Resets when the
      * rate-limited system log is written out.
@@ -78,18 +78,38 @@ void FlowControlTicketholder::set(ServiceContext* service,
     globalFlow = std::move(flowControl);
 }
 
-void FlowControlTicketholder::refreshTo(int numTickets) {
+void FlowControlTicketholder::refreshTo(int numTickets, int numSlices, Milliseconds period) {
     invariant(numTickets >= 0);
+    invariant(numSlices >= 1);
     stdx::lock_guard<Latch> lk(_mutex);
     LOGV2_DEBUG(20518,
                 4,
                 "Refreshing tickets. Before: {tickets} Now: {numTickets}",
-                "tickets"_attr = _tickets,
+                "tickets"_attr = _tickets + _heldBackTickets,
                 "numTickets"_attr = numTickets);
-    _tickets = numTickets;
+    if (numSlices > 1 && numTickets >= numSlices) {
+        // The first slice also carries the remainder of the division.
+        _ticketsPerSlice = numTickets / numSlices;
+        _heldBackTickets = _ticketsPerSlice * (numSlices - 1);
+        _tickets = numTickets - _heldBackTickets;
+        _sliceInterval = period / numSlices;
+        _nextSliceAt = Date_t::now() + _sliceInterval;
+    } else {
+        _heldBackTickets = 0;
+        _tickets = numTickets;
+    }
     _cv.notify_all();
 }
 
+void FlowControlTicketholder::_releaseDueSlices(WithLock, Date_t now) {
+    while (_heldBackTickets > 0 && _nextSliceAt <= now) {
+        const int slice = std::min(_ticketsPerSlice, _heldBackTickets);
+        _tickets += slice;
+        _heldBackTickets -= slice;
+        _nextSliceAt += _sliceInterval;
+    }
+}
+
 void FlowControlTicketholder::getTicket(OperationContext* opCtx,
                                         FlowControlTicketholder::CurOp* stats) {
     stdx::unique_lock<Latch> lk(_mutex);
@@ -97,6 +117,10 @@ void FlowControlTicketholder::getTicket(OperationContext* opCtx,
         return;
     }
 
+    if (_heldBackTickets > 0) {
+        _releaseDueSlices(lk, Date_t::now());
+    }
+
     LOGV2_DEBUG(20519, 4, "Taking ticket. Available: {tickets}", "tickets"_attr = _tickets);
     if (_tickets == 0) {
         ++stats->acquireWaitCount;
@@ -118,9 +142,21 @@ void FlowControlTicketholder::getTicket(OperationContext* opCtx,
         stats->waiting = false;
     });
 
-    // getTicket() should block until there are tickets or the Ticketholder is in shutdown
-    while (!opCtx->waitForConditionOrInterruptFor(
-        _cv, lk, Milliseconds(500), [&] { return _tickets > 0 || _inShutdown; })) {
+    // getTicket() should block until there are tickets or the Ticketholder is in shutdown. While
+    // slices are held back, wake up in time to release the next one.
+    auto waitTime = [&] {
+        if (_heldBackTickets == 0) {
+            return Milliseconds(500);
+        }
+        return std::max(Milliseconds(1),
+                        std::min(Milliseconds(500), _nextSliceAt - Date_t::now()));
+    };
+    while (!opCtx->waitForConditionOrInterruptFor(_cv, lk, waitTime(), [&] {
+        if (_heldBackTickets > 0) {
+            _releaseDueSlices(lk, Date_t::now());
+        }
+        return _tickets > 0 || _inShutdown;
+    })) {
         updateTotalTime();
     }
 
@@ -33,6 +33,8 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -79,7 +81,13 @@ public:
 
     static void set(ServiceContext* service, std::unique_ptr<FlowControlTicketholder> flowControl);
 
-    void refreshTo(int numTickets);
+    /**
+     * Replaces the available tickets with `numTickets`. With `numSlices` greater than one, only the
+     * first slice is available immediately and the rest are released evenly across `period`, so
+     * writers are paced through the period instead of spending every ticket at its start and then
+     * stalling until the next refresh. Unused tickets from earlier slices stay available.
+     */
+    void refreshTo(int numTickets, int numSlices = 1, Milliseconds period = Seconds(1));
 
     void getTicket(OperationContext* opCtx, FlowControlTicketholder::CurOp* stats);
 
@@ -90,6 +98,11 @@ public:
     void setInShutdown();
 
 private:
+    /**
+     * Makes available every held back slice whose release time is not after `now`.
+     */
+    void _releaseDueSlices(WithLock, Date_t now);
+
     // Use an int64_t as this is serialized to bson which does not support unsigned 64-bit numbers.
     AtomicWord<std::int64_t> _totalTimeAcquiringMicros;
 
@@ -97,6 +110,13 @@ private:
     stdx::condition_variable _cv;
     int _tickets;
 
+    // Tickets from the last refresh that are not yet available, released `_ticketsPerSlice` at a
+    // time every `_sliceInterval` starting at `_nextSliceAt`.
+    int _heldBackTickets = 0;
+    int _ticketsPerSlice = 0;
+    Milliseconds _sliceInterval{0};
+    Date_t _nextSliceAt;
+
     bool _inShutdown;  // used to synchronize shutdown of the ticket refresher job
 };
 
@@ -33,6 +33,13 @@
 
 #include "mongo/db/concurrency/lock_manager.h"
 
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #include "mongo/base/data_type_endian.h"
 #include "mongo/base/data_view.h"
 #include "mongo/base/static_assert.h"
@@ -379,6 +386,7 @@ void LockHead::migratePartitionedLockHeads() {
                 // Note that newRequest() will preserve the recursiveCount in this case
                 LockResult res = newRequest(request);
                 invariant(res == LOCK_OK);  // Lock must still be granted
+                partition->migrations++;
             }
             partition->data.erase(it);
             delete partitionedLock;
@@ -396,9 +404,54 @@ void LockHead::migratePartitionedLockHeads() {
 // Have more buckets than CPUs to reduce contention on lock and caches
 const unsigned LockManager::_numLockBuckets(128);
 
-// Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+namespace {
+
+/**
+ * Parses a sysfs CPU list such as "0-3,8,10-11" into the CPU numbers it names.
+ */
+std::vector<unsigned> parseCpuList(const std::string& list) {
+    std::vector<unsigned> cpus;
+    std::istringstream ranges(list);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        unsigned first, last;
+        char dash;
+        std::istringstream rangeStream(range);
+        if (!(rangeStream >> first))
+            continue;
+        last = first;
+        if (rangeStream >> dash >> last && dash != '-')
+            continue;
+        for (unsigned cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+/**
+ * Returns the NUMA node of each CPU, indexed by CPU number, or an empty vector if the machine
+ * does not expose its NUMA topology.
+ */
+std::vector<unsigned> readCpuNodes() {
+    std::vector<unsigned> cpuNodes;
+#ifdef __linux__
+    const unsigned kMaxNodes = 64;
+    for (unsigned node = 0; node < kMaxNodes; ++node) {
+        std::ifstream file(str::stream() << "/sys/devices/system/node/node" << node << "/cpulist");
+        std::string list;
+        if (!file || !std::getline(file, list))
+            continue;
+        for (auto cpu : parseCpuList(list)) {
+            if (cpu >= cpuNodes.size())
+                cpuNodes.resize(cpu + 1, 0);
+            cpuNodes[cpu] = node;
+        }
+    }
+#endif
+    return cpuNodes;
+}
+
+}  // namespace
 
 // static
 std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serviceContext) {
@@ -427,8 +480,14 @@ std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serv
 }
 
 LockManager::LockManager() {
-    _lockBuckets = new LockBucket[_numLockBuckets];
-    _partitions = new Partition[_numPartitions];
+    _lockBuckets = new CacheAligned<LockBucket>[_numLockBuckets];
+
+    _cpuNodes = readCpuNodes();
+    const unsigned numNodes =
+        _cpuNodes.empty() ? 1 : *std::max_element(_cpuNodes.begin(), _cpuNodes.end()) + 1;
+    for (unsigned node = 0; node < numNodes; ++node) {
+        _partitions.push_back(std::make_unique<NodePartitions>());
+    }
 }
 
 LockManager::~LockManager() {
@@ -440,7 +499,6 @@ LockManager::~LockManager() {
     }
 
     delete[] _lockBuckets;
-    delete[] _partitions;
 }
 
 LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mode) {
@@ -453,6 +511,7 @@ LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mo
 
     // For intent modes, try the PartitionedLockHead
     if (request->partitioned) {
+        _assignPartition(request);
         Partition* partition = _getPartition(request);
         stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
 
@@ -460,9 +519,11 @@ LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mo
         PartitionedLockHead* partitionedLock = partition->find(resId);
 
         if (partitionedLock) {
+            partition->intentAcquisitions++;
             partitionedLock->newRequest(request);
             return LOCK_OK;
         }
+        partition->intentMisses++;
         // Unsuccessful: there was no PartitionedLockHead yet, so use regular LockHead.
         // Must not hold any locks. It is OK for requests with intent modes to be on
         // both a PartitionedLockHead and a regular LockHead, so the race here is benign.
@@ -821,8 +882,40 @@ LockManager::LockBucket* LockManager::_getBucket(ResourceId resId) const {
     return &_lockBuckets[resId % _numLockBuckets];
 }
 
+void LockManager::_assignPartition(LockRequest* request) const {
+#ifdef __linux__
+    auto cpu = sched_getcpu();
+    if (cpu >= 0) {
+        unsigned node = static_cast<size_t>(cpu) < _cpuNodes.size() ? _cpuNodes[cpu] : 0;
+        request->partitionIndex =
+            node * _numPartitionsPerNode + static_cast<unsigned>(cpu) % _numPartitionsPerNode;
+        return;
+    }
+#endif
+    request->partitionIndex = request->locker->getId() % _numPartitionsPerNode;
+}
+
 LockManager::Partition* LockManager::_getPartition(LockRequest* request) const {
-    return &_partitions[request->locker->getId() % _numPartitions];
+    return &_partitions[request->partitionIndex / _numPartitionsPerNode]
+                ->partitions[request->partitionIndex % _numPartitionsPerNode];
+}
+
+void LockManager::appendPartitionStats(BSONObjBuilder* result) const {
+    BSONObjBuilder nodes(result->subobjStart("lockManagerPartitions"));
+    for (unsigned node = 0; node < _partitions.size(); ++node) {
+        long long intentAcquisitions = 0, intentMisses = 0, migrations = 0;
+        for (auto& partition : _partitions[node]->partitions) {
+            stdx::lock_guard<SimpleMutex> scopedLock(partition.mutex);
+            intentAcquisitions += partition.intentAcquisitions;
+            intentMisses += partition.intentMisses;
+            migrations += partition.migrations;
+        }
+
+        BSONObjBuilder nodeBuilder(nodes.subobjStart(str::stream() << "node" << node));
+        nodeBuilder.append("intentAcquisitions", intentAcquisitions);
+        nodeBuilder.append("intentMisses", intentMisses);
+        nodeBuilder.append("migrations", migrations);
+    }
 }
 
 void LockManager::dump() const {
@@ -1044,6 +1137,7 @@ void LockRequest::initNew(Locker* locker, LockGrantNotification* notify) {
     next = nullptr;
     status = STATUS_NEW;
     partitioned = false;
+    partitionIndex = 0;
     mode = MODE_NONE;
     convertMode = MODE_NONE;
     unlockPending = 0;
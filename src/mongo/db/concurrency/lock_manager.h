@@ -32,6 +32,7 @@
 #include <cstdint>
 #include <deque>
 #include <map>
+#include <memory>
 #include <vector>
 
 #include "mongo/bson/bsonobj.h"
@@ -42,8 +43,9 @@
 #include "mongo/platform/compiler.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
-#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/flat_hash_map.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -141,6 +143,12 @@ public:
     void getLockInfoBSON(const std::map<LockerId, BSONObj>& lockToClientMap,
                          BSONObjBuilder* result);
 
+    /**
+     * Appends the intent lock statistics of the partitions of each NUMA node, for the locks
+     * section of serverStatus.
+     */
+    void appendPartitionStats(BSONObjBuilder* result) const;
+
 private:
     // The lockheads need access to the partitions
     friend struct LockHead;
@@ -149,20 +157,37 @@ private:
 
     struct LockBucket {
         SimpleMutex mutex;
-        typedef stdx::unordered_map<ResourceId, LockHead*> Map;
+        typedef FlatHashMap<ResourceId, LockHead*> Map;
         Map data;
         LockHead* findOrInsert(ResourceId resId);
     };
 
-    // Each locker maps to a partition that is used for resources acquired in intent modes
-    // modes and potentially other modes that don't conflict with themselves. This avoids
-    // contention on the regular LockHead in the lock manager.
+    // Each intent mode request maps to a partition, chosen by the CPU it was made on, that is used
+    // for resources acquired in intent modes and potentially other modes that don't conflict with
+    // themselves. This avoids contention on the regular LockHead in the lock manager.
     struct Partition {
         PartitionedLockHead* find(ResourceId resId);
         PartitionedLockHead* findOrInsert(ResourceId resId);
-        typedef stdx::unordered_map<ResourceId, PartitionedLockHead*> Map;
+        typedef FlatHashMap<ResourceId, PartitionedLockHead*> Map;
         SimpleMutex mutex;
         Map data;
+
+        // Statistics, protected by 'mutex'. Requests granted through an existing
+        // PartitionedLockHead, requests that had to go through the LockHead's bucket instead, and
+        // granted requests moved to the LockHead because of a conflicting request.
+        long long intentAcquisitions = 0;
+        long long intentMisses = 0;
+        long long migrations = 0;
+    };
+
+    // Balance scalability of intent locks against potential added cost of conflicting locks.
+    // The exact value doesn't appear very important, but should be power of two
+    static constexpr unsigned _numPartitionsPerNode = 32;
+
+    // The partitions used by the CPUs of one NUMA node. They are kept on pages of their own, so
+    // that the kernel's NUMA balancing can move them to the memory of the node using them.
+    struct alignas(4096) NodePartitions {
+        CacheAligned<Partition> partitions[_numPartitionsPerNode];
     };
 
     /**
@@ -173,7 +198,15 @@ private:
 
 
     /**
-     * Retrieves the Partition that a particular LockRequest should use for intent locking.
+     * Assigns the Partition that a new intent mode LockRequest uses for intent locking. Requests
+     * made on the same CPU share a partition, so the partition mutex normally stays in that CPU's
+     * cache and concurrent requests on different CPUs do not contend. Each NUMA node has its own
+     * partitions, so their cache lines never move between sockets.
+     */
+    void _assignPartition(LockRequest* request) const;
+
+    /**
+     * Retrieves the Partition that a particular LockRequest uses for intent locking.
      */
     Partition* _getPartition(LockRequest* request) const;
 
@@ -219,10 +252,14 @@ private:
      */
     void _cleanupUnusedLocksInBucket(LockBucket* bucket);
 
+    // Buckets and partitions are cache line aligned so that neighbouring mutexes, which are taken
+    // by different threads, do not share a cache line.
     static const unsigned _numLockBuckets;
-    LockBucket* _lockBuckets;
+    CacheAligned<LockBucket>* _lockBuckets;
 
-    static const unsigned _numPartitions;
-    Partition* _partitions;
+    // The NUMA node of each CPU, indexed by CPU number. Empty if the topology is unknown, in which
+    // case there is a single node.
+    std::vector<unsigned> _cpuNodes;
+    std::vector<std::unique_ptr<NodePartitions>> _partitions;
 };
 }  // namespace mongo
@@ -27,6 +27,7 @@
  *    it in the license file.
  */
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/lock_manager_defs.h"
 #include "mongo/db/concurrency/lock_manager_test_help.h"
 #include "mongo/unittest/unittest.h"
@@ -952,4 +953,43 @@ TEST(LockManager, Fairness) {
     ASSERT(lockMgr.unlock(&requestIX1));
 }
 
+static long long sumPartitionStat(const LockManager& lockMgr, StringData field) {
+    BSONObjBuilder builder;
+    lockMgr.appendPartitionStats(&builder);
+    long long total = 0;
+    for (auto&& node : builder.obj()["lockManagerPartitions"].Obj()) {
+        total += node.Obj()[field].numberLong();
+    }
+    return total;
+}
+
+TEST(LockManager, PartitionStats) {
+    LockManager lockMgr;
+    const ResourceId resId(RESOURCE_COLLECTION, std::string("TestDB.collection"));
+
+    LockerImpl locker[3];
+    TrackingLockGrantNotification notify[3];
+    LockRequest request[3];
+    for (int i = 0; i < 3; i++) {
+        request[i].initNew(&locker[i], &notify[i]);
+    }
+
+    // Both intent requests are granted through a partition, whether or not they share one.
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &request[0], MODE_IS));
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &request[1], MODE_IS));
+    ASSERT_EQ(2,
+              sumPartitionStat(lockMgr, "intentAcquisitions") +
+                  sumPartitionStat(lockMgr, "intentMisses"));
+    ASSERT_EQ(0, sumPartitionStat(lockMgr, "migrations"));
+
+    // The conflicting request moves both of them to the LockHead.
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &request[2], MODE_X));
+    ASSERT_EQ(2, sumPartitionStat(lockMgr, "migrations"));
+
+    lockMgr.unlock(&request[0]);
+    lockMgr.unlock(&request[1]);
+    ASSERT(notify[2].numNotifies == 1);
+    lockMgr.unlock(&request[2]);
+}
+
 }  // namespace mongo
@@ -44,6 +44,7 @@
 #include "mongo/stdx/new.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/concurrency/ticketholder_gen.h"
 #include "mongo/util/debug_util.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
@@ -337,10 +338,20 @@ bool LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Date_t d
         // If the ticket wait is interrupted, restore the state of the client.
         auto restoreStateOnErrorGuard = makeGuard([&] { _clientState.store(kInactive); });
 
+        // Operations that keep yielding are long-running, so they queue behind short ones.
+        const auto yieldThreshold = gAdmissionControlLowPriorityYieldThreshold.load();
+        const auto priority = yieldThreshold > 0 && _numYields >= yieldThreshold
+            ? TicketHolder::Priority::kLow
+            : TicketHolder::Priority::kNormal;
+
+        const auto queueStart = curTimeMicros64();
+        ON_BLOCK_EXIT(
+            [&] { _ticketQueueMicros.fetchAndAddRelaxed(curTimeMicros64() - queueStart); });
+
         OperationContext* interruptible = _uninterruptibleLocksRequested ? nullptr : opCtx;
         if (deadline == Date_t::max()) {
-            holder->waitForTicket(interruptible);
-        } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
+            holder->waitForTicket(interruptible, priority);
+        } else if (!holder->waitForTicketUntil(interruptible, deadline, priority)) {
             return false;
         }
         restoreStateOnErrorGuard.dismiss();
@@ -771,6 +782,7 @@ bool LockerImpl::saveLockStateAndUnlock(Locker::LockSnapshot* stateOut) {
     // Sort locks by ResourceId. They'll later be acquired in this canonical locking order.
     std::sort(stateOut->locks.begin(), stateOut->locks.end());
 
+    _numYields++;
     return true;
 }
 
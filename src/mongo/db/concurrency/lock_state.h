@@ -215,6 +215,10 @@ public:
         return _flowControlStats;
     }
 
+    Microseconds getTicketQueueTime() const override {
+        return Microseconds(_ticketQueueMicros.load());
+    }
+
     //
     // Below functions are for testing only.
     //
@@ -347,6 +351,13 @@ private:
     // Mode for which the Locker acquired a ticket, or MODE_NONE if no ticket was acquired.
     LockMode _modeForTicket = MODE_NONE;
 
+    // Number of times this Locker released its locks through saveLockStateAndUnlock(). Decides
+    // the priority at which it queues for tickets.
+    int _numYields = 0;
+
+    // Total time spent in _acquireTicket() waiting for an execution ticket.
+    AtomicWord<long long> _ticketQueueMicros{0};
+
     // Indicates whether the client is active reader/writer or is queued.
     AtomicWord<ClientState> _clientState{kInactive};
 
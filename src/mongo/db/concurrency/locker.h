@@ -506,6 +506,14 @@ public:
         return FlowControlTicketholder::CurOp();
     }
 
+    /**
+     * If tracked by an implementation, returns the total time spent queued for execution tickets.
+     * May be called by threads other than the one owning the Locker.
+     */
+    virtual Microseconds getTicketQueueTime() const {
+        return Microseconds(0);
+    }
+
     /**
      * This function is for unit testing only.
      */
@@ -48,6 +48,7 @@
 #include "mongo/db/prepare_conflict_tracker.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/stats/query_shape_stats.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/rpc/metadata/client_metadata_ismaster.h"
@@ -79,6 +80,20 @@ const std::vector<const char*> kDollarQueryModifiers = {
     "$maxTimeMS",
 };
 
+/**
+ * Returns the CPU time consumed so far by the calling thread, or boost::none on platforms where it
+ * can't be measured cheaply.
+ */
+boost::optional<Nanoseconds> getThreadCpuTime() {
+#if defined(__linux__)
+    struct timespec t;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t) == 0) {
+        return Nanoseconds(static_cast<long long>(t.tv_sec) * 1000 * 1000 * 1000 + t.tv_nsec);
+    }
+#endif
+    return boost::none;
+}
+
 TimerStats oplogGetMoreStats;
 ServerStatusMetricField<TimerStats> displayBatchesReceived("repl.network.oplogGetMoresProcessed",
                                                            &oplogGetMoreStats);
@@ -341,8 +356,10 @@ void CurOp::setGenericCursor_inlock(GenericCursor gc) {
 CurOp::CurOp(OperationContext* opCtx) : CurOp(opCtx, &_curopStack(opCtx)) {
     // If this is a sub-operation, we store the snapshot of lock stats as the base lock stats of the
     // current operation.
-    if (_parent != nullptr)
+    if (_parent != nullptr) {
         _lockStatsBase = opCtx->lockState()->getLockerInfo(boost::none)->stats;
+        _ticketQueueTimeBase = opCtx->lockState()->getTicketQueueTime();
+    }
 }
 
 CurOp::CurOp(OperationContext* opCtx, CurOpStack* stack) : _stack(stack) {
@@ -406,6 +423,7 @@ void CurOp::setNS_inlock(StringData ns) {
 void CurOp::ensureStarted() {
     if (_start == 0) {
         _start = curTimeMicros64();
+        _startCpuTime = getThreadCpuTime();
     }
 }
 
@@ -437,12 +455,37 @@ bool CurOp::completeAndLogOperation(OperationContext* opCtx,
     _end = curTimeMicros64();
     _debug.executionTimeMicros = durationCount<Microseconds>(elapsedTimeExcludingPauses());
 
+    // Break down where the time went: CPU, queueing for a ticket and prepare conflicts. Time
+    // blocked on locks, flow control and the storage engine is reported with their statistics.
+    if (_startCpuTime) {
+        if (auto cpuTime = getThreadCpuTime()) {
+            _debug.cpuTime = *cpuTime - *_startCpuTime;
+        }
+    }
+    _debug.ticketQueueTime = opCtx->lockState()->getTicketQueueTime() - _ticketQueueTimeBase;
+    auto prepareConflictDurationMicros =
+        PrepareConflictTracker::get(opCtx).getPrepareConflictDuration();
+    _debug.prepareConflictDurationMillis =
+        duration_cast<Milliseconds>(prepareConflictDurationMicros);
+
     const auto executionTimeMillis = _debug.executionTimeMicros / 1000;
 
     if (_debug.isReplOplogFetching) {
         oplogGetMoreStats.recordMillis(executionTimeMillis);
     }
 
+    if (_debug.queryHash && QueryShapeStats::shouldRecord(opCtx->getClient())) {
+        QueryShapeStats::Execution execution;
+        execution.execMicros = _debug.executionTimeMicros;
+        execution.docsExamined = _debug.additiveMetrics.docsExamined.value_or(0);
+        execution.keysExamined = _debug.additiveMetrics.keysExamined.value_or(0);
+        execution.nreturned = std::max(_debug.nreturned, 0LL);
+        execution.bytesReturned = std::max(_debug.responseLength, 0);
+        auto service = opCtx->getServiceContext();
+        QueryShapeStats::get(service)->record(
+            _ns, *_debug.queryHash, execution, service->getFastClockSource()->now());
+    }
+
     bool shouldLogSlowOp, shouldSample;
 
     // Log the operation if it is eligible according to the current slowMS and sampleRate settings.
@@ -484,12 +527,6 @@ bool CurOp::completeAndLogOperation(OperationContext* opCtx,
             }
         }
 
-        // Gets the time spent blocked on prepare conflicts.
-        auto prepareConflictDurationMicros =
-            PrepareConflictTracker::get(opCtx).getPrepareConflictDuration();
-        _debug.prepareConflictDurationMillis =
-            duration_cast<Milliseconds>(prepareConflictDurationMicros);
-
         logv2::DynamicAttributes attr;
         _debug.report(opCtx, (lockerInfo ? &lockerInfo->stats : nullptr), &attr);
         LOGV2(51803, "slow query", attr);
@@ -649,6 +686,11 @@ void CurOp::reportState(OperationContext* opCtx, BSONObjBuilder* builder, bool t
         builder->append("writeConflicts", n);
     }
 
+    if (auto queueTime = opCtx->lockState()->getTicketQueueTime() - _ticketQueueTimeBase;
+        queueTime > Microseconds::zero()) {
+        builder->append("ticketQueueMicros", durationCount<Microseconds>(queueTime));
+    }
+
     builder->append("numYields", _numYields);
 }
 
@@ -731,6 +773,14 @@ string OpDebug::report(OperationContext* opCtx, const SingleThreadedLockStats* l
         s << " prepareConflictDuration: " << prepareConflictDurationMillis;
     }
 
+    if (cpuTime) {
+        s << " cpuNanos:" << durationCount<Nanoseconds>(*cpuTime);
+    }
+
+    if (ticketQueueTime > Microseconds::zero()) {
+        s << " ticketQueueMicros:" << durationCount<Microseconds>(ticketQueueTime);
+    }
+
     if (dataThroughputLastSecond) {
         s << " dataThroughputLastSecond: " << *dataThroughputLastSecond << " MB/sec";
     }
@@ -896,6 +946,14 @@ void OpDebug::report(OperationContext* opCtx,
         pAttrs->add("prepareConflictDuration", prepareConflictDurationMillis);
     }
 
+    if (cpuTime) {
+        pAttrs->add("cpuNanos", durationCount<Nanoseconds>(*cpuTime));
+    }
+
+    if (ticketQueueTime > Microseconds::zero()) {
+        pAttrs->add("ticketQueueMicros", durationCount<Microseconds>(ticketQueueTime));
+    }
+
     if (dataThroughputLastSecond) {
         pAttrs->add("dataThroughputLastSecondMBperSec", *dataThroughputLastSecond);
     }
@@ -1056,6 +1114,17 @@ void OpDebug::append(OperationContext* opCtx,
     OPDEBUG_APPEND_OPTIONAL("dataThroughputLastSecond", dataThroughputLastSecond);
     OPDEBUG_APPEND_OPTIONAL("dataThroughputAverage", dataThroughputAverage);
 
+    if (cpuTime) {
+        b.appendNumber("cpuNanos", durationCount<Nanoseconds>(*cpuTime));
+    }
+    if (ticketQueueTime > Microseconds::zero()) {
+        b.appendNumber("ticketQueueMicros", durationCount<Microseconds>(ticketQueueTime));
+    }
+    if (prepareConflictDurationMillis > Milliseconds::zero()) {
+        b.appendNumber("prepareConflictDurationMillis",
+                       durationCount<Milliseconds>(prepareConflictDurationMillis));
+    }
+
     b.appendNumber("numYield", curop.numYields());
     OPDEBUG_APPEND_NUMBER(nreturned);
 
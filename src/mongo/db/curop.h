@@ -238,6 +238,12 @@ public:
     // Stores the duration of time spent blocked on prepare conflicts.
     Milliseconds prepareConflictDurationMillis{0};
 
+    // CPU time used by the executing thread, where the platform can measure it.
+    boost::optional<Nanoseconds> cpuTime;
+
+    // Time spent queued for execution tickets.
+    Microseconds ticketQueueTime{0};
+
     // Stores the amount of the data processed by the throttle cursors in MB/sec.
     boost::optional<float> dataThroughputLastSecond;
     boost::optional<float> dataThroughputAverage;
@@ -664,6 +670,12 @@ private:
     // The cumulative duration for which the timer has been paused.
     Microseconds _totalPausedDuration{0};
 
+    // The CPU time of the executing thread when this CurOp instance was marked as started.
+    boost::optional<Nanoseconds> _startCpuTime;
+
+    // The snapshot of the Locker's ticket queueing time taken when a sub-operation is constructed.
+    Microseconds _ticketQueueTimeBase{0};
+
     // _networkOp represents the network-level op code: OP_QUERY, OP_GET_MORE, OP_MSG, etc.
     NetworkOp _networkOp{opInvalid};  // only set this through setNetworkOp_inlock() to keep synced
     // _logicalOp is the logical operation type, ie 'dbQuery' regardless of whether this is an
@@ -35,8 +35,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
-#include "mongo/stdx/unordered_map.h"
-#include "mongo/stdx/unordered_set.h"
+#include "mongo/util/flat_hash_map.h"
 
 namespace mongo {
 
@@ -93,12 +92,12 @@ private:
 
     // _dataMap is filled out by the first child and probed by subsequent children.  This is the
     // hash table that we create by intersecting _children and probe with the last child.
-    typedef stdx::unordered_map<RecordId, WorkingSetID, RecordId::Hasher> DataMap;
+    typedef FlatHashMap<RecordId, WorkingSetID, RecordId::Hasher> DataMap;
     DataMap _dataMap;
 
     // Keeps track of what elements from _dataMap subsequent children have seen.
     // Only used while _hashingChildren.
-    typedef stdx::unordered_set<RecordId, RecordId::Hasher> SeenMap;
+    typedef FlatHashSet<RecordId, RecordId::Hasher> SeenMap;
     SeenMap _seenMap;
 
     // True if we're still intersecting _children[0..._children.size()-1].
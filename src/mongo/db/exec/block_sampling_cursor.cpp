@@ -0,0 +1,172 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/block_sampling_cursor.h"
+
+#include <algorithm>
+
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+
+namespace mongo {
+
+namespace {
+// The number of RecordIds drawn from the random cursor for each stratum.
+const long long kRandomCursorSamplesPerStratum = 4;
+}  // namespace
+
+BlockSamplingCursor::BlockSamplingCursor(OperationContext* opCtx,
+                                         const RecordStore* rs,
+                                         std::unique_ptr<RecordCursor> randomCursor,
+                                         long long sampleSize,
+                                         long long blockSize)
+    : _opCtx(opCtx),
+      _rs(rs),
+      _sampleSize(sampleSize),
+      _blockSize(blockSize),
+      _randomCursor(std::move(randomCursor)) {
+    invariant(_sampleSize >= 0);
+    invariant(_blockSize > 0);
+}
+
+boost::optional<Record> BlockSamplingCursor::next() {
+    if (!_drawn) {
+        _drawSample();
+        _drawn = true;
+    }
+
+    while (_position < _sample.size()) {
+        if (auto record = _cursor->seekExact(_sample[_position++])) {
+            return record;
+        }
+    }
+    return boost::none;
+}
+
+void BlockSamplingCursor::_drawSample() {
+    std::vector<RecordId> randomIds;
+    for (long long i = 0; i < _sampleSize * kRandomCursorSamplesPerStratum; ++i) {
+        auto record = _randomCursor->next();
+        if (!record) {
+            break;
+        }
+        randomIds.push_back(record->id);
+    }
+    _randomCursor.reset();
+    std::sort(randomIds.begin(), randomIds.end());
+    randomIds.erase(std::unique(randomIds.begin(), randomIds.end()), randomIds.end());
+
+    // Stratum 's' covers [boundaries[s - 1], boundaries[s]), where the first stratum starts at the
+    // beginning of the record store and the last one runs to its end.
+    std::vector<RecordId> boundaries;
+    for (size_t i = kRandomCursorSamplesPerStratum - 1; i < randomIds.size();
+         i += kRandomCursorSamplesPerStratum) {
+        boundaries.push_back(randomIds[i]);
+    }
+    const long long numStrata = boundaries.size() + 1;
+
+    auto& prng = _opCtx->getClient()->getPrng();
+    _cursor = _rs->getCursor(_opCtx, true);
+    // Samples a stratum could not provide, for lack of records, are owed by the next one.
+    long long owed = 0;
+    for (long long s = 0; s < numStrata; ++s) {
+        const long long quota =
+            _sampleSize / numStrata + (s < _sampleSize % numStrata ? 1 : 0) + owed;
+        const auto end = s + 1 < numStrata ? boost::make_optional(boundaries[s]) : boost::none;
+
+        // The block always holds at least the stratum's share of the sample.
+        const long long blockSize = std::max(_blockSize, quota);
+        std::vector<RecordId> reservoir;
+        long long seen = 0;
+        auto record = s == 0 ? _cursor->next() : _cursor->seekExact(boundaries[s - 1]);
+        for (; record && seen < blockSize && (!end || record->id < *end);
+             record = _cursor->next()) {
+            if (seen < quota) {
+                reservoir.push_back(record->id);
+            } else if (auto slot = prng.nextInt64(seen + 1); slot < quota) {
+                reservoir[slot] = record->id;
+            }
+            if (++seen % 128 == 0) {
+                _opCtx->checkForInterrupt();
+            }
+        }
+
+        owed = quota - reservoir.size();
+        _sample.insert(_sample.end(), reservoir.begin(), reservoir.end());
+    }
+
+    // Return the sample in random order rather than in RecordId order.
+    for (size_t i = _sample.size(); i > 1; --i) {
+        std::swap(_sample[i - 1], _sample[prng.nextInt64(i)]);
+    }
+}
+
+void BlockSamplingCursor::save() {
+    if (_randomCursor) {
+        _randomCursor->save();
+    }
+    if (_cursor) {
+        _cursor->saveUnpositioned();
+    }
+}
+
+bool BlockSamplingCursor::restore() {
+    if (_randomCursor && !_randomCursor->restore()) {
+        return false;
+    }
+    // Every record is found again by its RecordId, wherever the cursor is positioned.
+    if (_cursor) {
+        _cursor->restore();
+    }
+    return true;
+}
+
+void BlockSamplingCursor::detachFromOperationContext() {
+    _opCtx = nullptr;
+    if (_randomCursor) {
+        _randomCursor->detachFromOperationContext();
+    }
+    if (_cursor) {
+        _cursor->detachFromOperationContext();
+    }
+}
+
+void BlockSamplingCursor::reattachToOperationContext(OperationContext* opCtx) {
+    _opCtx = opCtx;
+    if (_randomCursor) {
+        _randomCursor->reattachToOperationContext(opCtx);
+    }
+    if (_cursor) {
+        _cursor->reattachToOperationContext(opCtx);
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,89 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/record_store.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * A RecordCursor returning a random sample of 'sampleSize' distinct records of a record store, in
+ * random order, drawn by stratified block sampling.
+ *
+ * The record store's random cursor only chooses the strata: it draws a few RecordIds per sampled
+ * record, and every few of them in RecordId order starts a new stratum, so the strata hold about
+ * the same number of records whatever the biases of the random cursor. The sample is then shared
+ * evenly among the strata, and each stratum's part is drawn by reservoir sampling over a block of
+ * up to 'blockSize' records read in order from its start. When the block covers the whole stratum,
+ * about numRecords / sampleSize records, every record is about as likely to be sampled as any
+ * other. Smaller blocks read less, at the cost of leaving the tails of the strata out.
+ *
+ * The sample is drawn as a whole on the first call to next(), which only keeps its RecordIds, and
+ * each call to next() then returns one of them. Records deleted in between are skipped.
+ */
+class BlockSamplingCursor final : public RecordCursor {
+public:
+    BlockSamplingCursor(OperationContext* opCtx,
+                        const RecordStore* rs,
+                        std::unique_ptr<RecordCursor> randomCursor,
+                        long long sampleSize,
+                        long long blockSize);
+
+    boost::optional<Record> next() final;
+
+    void save() final;
+    bool restore() final;
+    void detachFromOperationContext() final;
+    void reattachToOperationContext(OperationContext* opCtx) final;
+
+private:
+    void _drawSample();
+
+    OperationContext* _opCtx;
+    const RecordStore* const _rs;
+    const long long _sampleSize;
+    const long long _blockSize;
+
+    // Used to choose the strata, and released once the sample is drawn.
+    std::unique_ptr<RecordCursor> _randomCursor;
+    std::unique_ptr<SeekableRecordCursor> _cursor;
+
+    bool _drawn = false;
+    std::vector<RecordId> _sample;
+    size_t _position = 0;
+};
+
+}  // namespace mongo
@@ -33,6 +33,7 @@
 
 #include "mongo/db/exec/cached_plan.h"
 
+#include <cmath>
 #include <memory>
 
 #include "mongo/db/catalog/collection.h"
@@ -89,7 +90,7 @@ Status CachedPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
     // If we work this many times during the trial period, then we will replan the
     // query from scratch.
     size_t maxWorksBeforeReplan =
-        static_cast<size_t>(internalQueryCacheEvictionRatio * _decisionWorks);
+        static_cast<size_t>(internalQueryCacheEvictionRatio * expectedTrialWorks());
 
     // The trial period ends without replanning if the cached plan produces this many results.
     size_t numResults = MultiPlanStage::getTrialPeriodNumToReturn(*_canonicalQuery);
@@ -170,7 +171,7 @@ Status CachedPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
         "with only {decisionWorks} works. Evicting cache entry and replanning query: "
         "{canonicalQuery_Short} plan summary before replan: {Explain_getPlanSummary_child_get}",
         "maxWorksBeforeReplan"_attr = maxWorksBeforeReplan,
-        "decisionWorks"_attr = _decisionWorks,
+        "decisionWorks"_attr = expectedTrialWorks(),
         "canonicalQuery_Short"_attr = redact(_canonicalQuery->toStringShort()),
         "Explain_getPlanSummary_child_get"_attr = Explain::getPlanSummary(child().get()));
 
@@ -180,10 +181,25 @@ Status CachedPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
         shouldCache,
         str::stream()
             << "cached plan was less efficient than expected: expected trial execution to take "
-            << _decisionWorks << " works but it took at least " << maxWorksBeforeReplan
+            << expectedTrialWorks() << " works but it took at least " << maxWorksBeforeReplan
             << " works");
 }
 
+size_t CachedPlanStage::expectedTrialWorks() const {
+    if (!internalQueryCacheCardinalityFeedback.load()) {
+        return _decisionWorks;
+    }
+
+    // Trials of the cached plan may routinely take longer than the trial that picked it, for
+    // instance on skewed data. Each replan that picked the same plan again was wasted, so allow
+    // more works before the next one, up to a bound.
+    const long long kMaxUnchangedReplans = 8;
+    const size_t observedWorks = std::max(
+        _decisionWorks, static_cast<size_t>(std::ceil(_cardinalityFeedback.avgTrialWorks)));
+    return observedWorks *
+        (1 + std::min(_cardinalityFeedback.numUnchangedReplans, kMaxUnchangedReplans));
+}
+
 Status CachedPlanStage::tryYield(PlanYieldPolicy* yieldPolicy) {
     // These are the conditions which can cause us to yield:
     //   1) The yield policy's timer elapsed, or
@@ -248,9 +264,18 @@ Status CachedPlanStage::replan(PlanYieldPolicy* yieldPolicy, bool shouldCache, s
     // and so on. The working set will be shared by all candidate plans.
     auto cachingMode = shouldCache ? MultiPlanStage::CachingMode::AlwaysCache
                                    : MultiPlanStage::CachingMode::NeverCache;
-    _children.emplace_back(
-        new MultiPlanStage(getOpCtx(), collection(), _canonicalQuery, cachingMode));
+    // The cached plan did poorly for this query's literals, so have the new winner remembered for
+    // their selectivity bucket as well.
+    const bool probeSelectivity = shouldCache;
+    _children.emplace_back(new MultiPlanStage(
+        getOpCtx(), collection(), _canonicalQuery, cachingMode, probeSelectivity));
     MultiPlanStage* multiPlanStage = static_cast<MultiPlanStage*>(child().get());
+    if (internalQueryCacheCardinalityFeedback.load()) {
+        // Give the candidates at least as long as trials of the cached plan usually take, so that
+        // they are not judged on a shorter prefix of the results than the cached plan was.
+        multiPlanStage->setMinTrialPeriodWorks(
+            static_cast<size_t>(std::ceil(_cardinalityFeedback.avgTrialWorks)));
+    }
 
     for (size_t ix = 0; ix < solutions.size(); ++ix) {
         if (solutions[ix]->cacheData.get()) {
@@ -316,9 +341,15 @@ const SpecificStats* CachedPlanStage::getSpecificStats() const {
 }
 
 void CachedPlanStage::updatePlanCache() {
-    const double score = PlanRanker::scoreTree(getStats()->children[0].get());
+    const auto stats = getStats();
+    const double score = PlanRanker::scoreTree(stats->children[0].get());
 
     PlanCache* cache = CollectionQueryInfo::get(collection()).getPlanCache();
+    if (internalQueryCacheCardinalityFeedback.load()) {
+        const auto& trialStats = stats->children[0]->common;
+        cache->recordCardinalityFeedback(*_canonicalQuery, trialStats.works, trialStats.advanced)
+            .ignore();
+    }
     Status fbs = cache->feedback(*_canonicalQuery, score);
     if (!fbs.isOK()) {
         LOGV2_DEBUG(
@@ -36,6 +36,7 @@
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/query_planner_params.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/db/record_id.h"
@@ -88,6 +89,15 @@ public:
      */
     Status pickBestPlan(PlanYieldPolicy* yieldPolicy);
 
+    /**
+     * Supplies what earlier trials of the cached plan observed. With
+     * internalQueryCacheCardinalityFeedback enabled, it lengthens the trial period before a replan
+     * and the trial period of the replan.
+     */
+    void setCardinalityFeedback(const PlanCacheCardinalityFeedback& feedback) {
+        _cardinalityFeedback = feedback;
+    }
+
 private:
     /**
      * Passes stats from the trial period run of the cached plan to the plan cache.
@@ -117,6 +127,12 @@ private:
      */
     Status tryYield(PlanYieldPolicy* yieldPolicy);
 
+    /**
+     * Returns the number of works the trial period of the cached plan is expected to take, which
+     * the trial may exceed by internalQueryCacheEvictionRatio before the query is replanned.
+     */
+    size_t expectedTrialWorks() const;
+
     // Not owned.
     WorkingSet* _ws;
 
@@ -129,6 +145,8 @@ private:
     // cached.
     size_t _decisionWorks;
 
+    PlanCacheCardinalityFeedback _cardinalityFeedback;
+
     // If we fall back to re-planning the query, and there is just one resulting query solution,
     // that solution is owned here.
     std::unique_ptr<QuerySolution> _replannedQs;
@@ -41,6 +41,7 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/logv2/log.h"
@@ -70,6 +71,9 @@ CollectionScan::CollectionScan(OperationContext* opCtx,
     _specificStats.minTs = params.minTs;
     _specificStats.maxTs = params.maxTs;
     _specificStats.tailable = params.tailable;
+    if (_filter && internalQueryEnableFlatPredicatePrograms.load()) {
+        _filterProgram = FlatPredicateProgram::compile(_filter);
+    }
     if (params.minTs || params.maxTs) {
         // The 'minTs' and 'maxTs' parameters are used for a special optimization that
         // applies only to forwards scans of the oplog.
@@ -85,6 +89,14 @@ CollectionScan::CollectionScan(OperationContext* opCtx,
         invariant(params.direction == CollectionScanParams::FORWARD);
     }
 
+    if (params.minRecord || params.maxRecord) {
+        // RecordId ranges are used to partition a forward scan of a collection.
+        invariant(params.direction == CollectionScanParams::FORWARD);
+        invariant(!params.tailable);
+        invariant(!params.minTs && !params.maxTs);
+        invariant(!params.resumeAfterRecordId);
+    }
+
     // Set early stop condition.
     if (params.maxTs) {
         _endConditionBSON = BSON("$gte"_sd << *(params.maxTs));
@@ -121,7 +133,9 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
                 collection()->getRecordStore()->waitForAllEarlierOplogWritesToBeVisible(getOpCtx());
             }
 
-            _cursor = collection()->getCursor(getOpCtx(), forward);
+            // A collection scan reads through the collection in order, so let the storage engine
+            // read ahead of it.
+            _cursor = collection()->getRecordStore()->getSequentialCursor(getOpCtx(), forward);
 
             if (!_lastSeenId.isNull()) {
                 invariant(_params.tailable);
@@ -179,6 +193,16 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             }
         }
 
+        if (_lastSeenId.isNull() && _params.minRecord) {
+            // Range boundaries are normally RecordIds which existed when the ranges were chosen, so
+            // try to seek straight to the start of the range. If the boundary record has since
+            // been deleted, the cursor position is unspecified, so start over and skip forward.
+            record = _cursor->seekExact(*_params.minRecord);
+            if (!record) {
+                _cursor = collection()->getRecordStore()->getSequentialCursor(getOpCtx(), true);
+            }
+        }
+
         if (!record) {
             record = _cursor->next();
         }
@@ -203,7 +227,17 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_params.maxRecord && record->id >= *_params.maxRecord) {
+        // Forward scans see RecordIds in increasing order, so the rest are outside the range too.
+        _commonStats.isEOF = true;
+        return PlanStage::IS_EOF;
+    }
+
     _lastSeenId = record->id;
+    if (_params.minRecord && record->id < *_params.minRecord) {
+        return PlanStage::NEED_TIME;
+    }
+
     if (_params.shouldTrackLatestOplogTimestamp) {
         auto status = setLatestOplogEntryTimestamp(*record);
         if (!status.isOK()) {
@@ -222,6 +256,17 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
     return returnIfMatches(member, id, out);
 }
 
+PlanStage::StageState CollectionScan::doWorkBatch(size_t maxWorks,
+                                                  std::vector<WorkingSetID>* results,
+                                                  WorkingSetID* out) {
+    // doWork() is final, so naming it explicitly lets the compiler resolve and inline it rather
+    // than paying for a virtual call and a timer read per record.
+    return workBatchLoop([this](WorkingSetID* id) { return CollectionScan::doWork(id); },
+                         maxWorks,
+                         results,
+                         out);
+}
+
 Status CollectionScan::setLatestOplogEntryTimestamp(const Record& record) {
     auto tsElem = record.data.toBson()[repl::OpTime::kTimestampFieldName];
     if (tsElem.type() != BSONType::bsonTimestamp) {
@@ -239,9 +284,10 @@ PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
                                                       WorkingSetID memberID,
                                                       WorkingSetID* out) {
     ++_specificStats.docsTested;
-    if (Filter::passes(member, _filter)) {
+    if (Filter::passes(member, _filter, _filterProgram.get())) {
         if (_params.stopApplyingFilterAfterFirstMatch) {
             _filter = nullptr;
+            _filterProgram.reset();
         }
         *out = memberID;
         return PlanStage::ADVANCED;
@@ -34,6 +34,7 @@
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/flat_predicate_program.h"
 #include "mongo/db/record_id.h"
 
 namespace mongo {
@@ -82,6 +83,10 @@ public:
     const SpecificStats* getSpecificStats() const final;
 
 protected:
+    StageState doWorkBatch(size_t maxWorks,
+                           std::vector<WorkingSetID>* results,
+                           WorkingSetID* out) final;
+
     void doSaveStateRequiresCollection() final;
 
     void doRestoreStateRequiresCollection() final;
@@ -106,6 +111,9 @@ private:
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // A single-pass form of '_filter', if it has a suitable shape.
+    std::unique_ptr<FlatPredicateProgram> _filterProgram;
+
     // If a document does not pass '_filter' but passes '_endCondition', stop scanning and return
     // IS_EOF.
     BSONObj _endConditionBSON;
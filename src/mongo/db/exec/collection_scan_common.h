@@ -61,6 +61,14 @@ struct CollectionScanParams {
     // This field cannot be used in conjunction with 'minTs' or 'maxTs'.
     boost::optional<RecordId> resumeAfterRecordId;
 
+    // If present, the collection scan will only return records whose RecordId is at least
+    // 'minRecord' and, if 'maxRecord' is present, strictly less than 'maxRecord'. Together they let
+    // several scans cover disjoint, contiguous ranges of the same collection. Must only be set on
+    // forward, non-tailable collection scans.
+    // These fields cannot be used in conjunction with 'minTs', 'maxTs' or 'resumeAfterRecordId'.
+    boost::optional<RecordId> minRecord;
+    boost::optional<RecordId> maxRecord;
+
     Direction direction = FORWARD;
 
     // Do we want the scan to be 'tailable'?  Only meaningful if the collection is capped.
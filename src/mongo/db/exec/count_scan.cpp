@@ -81,7 +81,8 @@ CountScan::CountScan(OperationContext* opCtx, CountScanParams params, WorkingSet
       _startKey(std::move(params.startKey)),
       _startKeyInclusive(params.startKeyInclusive),
       _endKey(std::move(params.endKey)),
-      _endKeyInclusive(params.endKeyInclusive) {
+      _endKeyInclusive(params.endKeyInclusive),
+      _additionalRanges(std::move(params.additionalRanges)) {
     _specificStats.indexName = params.name;
     _specificStats.keyPattern = _keyPattern;
     _specificStats.isMultiKey = params.isMultiKey;
@@ -100,6 +101,28 @@ CountScan::CountScan(OperationContext* opCtx, CountScanParams params, WorkingSet
                                 /*compareFieldNames*/ false) <= 0);
 }
 
+boost::optional<IndexKeyEntry> CountScan::seekToCurrentRange() {
+    const BSONObj& startKey =
+        _currentRange == 0 ? _startKey : _additionalRanges[_currentRange - 1].startKey;
+    const bool startKeyInclusive = _currentRange == 0
+        ? _startKeyInclusive
+        : _additionalRanges[_currentRange - 1].startKeyInclusive;
+    if (_currentRange == 0) {
+        _cursor->setEndPosition(_endKey, _endKeyInclusive);
+    } else {
+        const IndexKeyRange& range = _additionalRanges[_currentRange - 1];
+        _cursor->setEndPosition(range.endKey, range.endKeyInclusive);
+    }
+
+    auto keyStringForSeek = IndexEntryComparison::makeKeyStringFromBSONKeyForSeek(
+        startKey,
+        indexAccessMethod()->getSortedDataInterface()->getKeyStringVersion(),
+        indexAccessMethod()->getSortedDataInterface()->getOrdering(),
+        true, /* forward */
+        startKeyInclusive);
+    return _cursor->seek(keyStringForSeek);
+}
+
 PlanStage::StageState CountScan::doWork(WorkingSetID* out) {
     if (_commonStats.isEOF)
         return PlanStage::IS_EOF;
@@ -113,15 +136,11 @@ PlanStage::StageState CountScan::doWork(WorkingSetID* out) {
         if (needInit) {
             // First call to work().  Perform cursor init.
             _cursor = indexAccessMethod()->newCursor(getOpCtx());
-            _cursor->setEndPosition(_endKey, _endKeyInclusive);
-
-            auto keyStringForSeek = IndexEntryComparison::makeKeyStringFromBSONKeyForSeek(
-                _startKey,
-                indexAccessMethod()->getSortedDataInterface()->getKeyStringVersion(),
-                indexAccessMethod()->getSortedDataInterface()->getOrdering(),
-                true, /* forward */
-                _startKeyInclusive);
-            entry = _cursor->seek(keyStringForSeek);
+            entry = seekToCurrentRange();
+            _needsSeek = false;
+        } else if (_needsSeek) {
+            entry = seekToCurrentRange();
+            _needsSeek = false;
         } else {
             entry = _cursor->next(kWantLoc);
         }
@@ -137,12 +156,19 @@ PlanStage::StageState CountScan::doWork(WorkingSetID* out) {
     ++_specificStats.keysExamined;
 
     if (!entry) {
+        if (_currentRange < _additionalRanges.size()) {
+            // Move on to the next range.
+            ++_currentRange;
+            _needsSeek = true;
+            return PlanStage::NEED_TIME;
+        }
+
         _commonStats.isEOF = true;
         _cursor.reset();
         return PlanStage::IS_EOF;
     }
 
-    if (_shouldDedup && !_returned.insert(entry->loc).second) {
+    if (_shouldDedup && !_returned.insert(entry->loc)) {
         // *loc was already in _returned.
         return PlanStage::NEED_TIME;
     }
@@ -186,8 +212,11 @@ unique_ptr<PlanStageStats> CountScan::getStats() {
 
     countStats->startKey = replaceBSONFieldNames(_startKey, countStats->keyPattern);
     countStats->startKeyInclusive = _startKeyInclusive;
-    countStats->endKey = replaceBSONFieldNames(_endKey, countStats->keyPattern);
-    countStats->endKeyInclusive = _endKeyInclusive;
+    // With several ranges, report the span from the start of the first to the end of the last.
+    const BSONObj& endKey = _additionalRanges.empty() ? _endKey : _additionalRanges.back().endKey;
+    countStats->endKey = replaceBSONFieldNames(endKey, countStats->keyPattern);
+    countStats->endKeyInclusive =
+        _additionalRanges.empty() ? _endKeyInclusive : _additionalRanges.back().endKeyInclusive;
 
     ret->specific = std::move(countStats);
 
@@ -29,12 +29,13 @@
 
 #pragma once
 
+#include "mongo/db/exec/record_id_set.h"
 #include "mongo/db/exec/requires_index_stage.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/query/index_bounds.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/sorted_data_interface.h"
-#include "mongo/stdx/unordered_set.h"
 
 namespace mongo {
 
@@ -74,6 +75,10 @@ struct CountScanParams {
 
     BSONObj endKey;
     bool endKeyInclusive{true};
+
+    // Further ranges to count after the one from 'startKey' to 'endKey'. They must be disjoint
+    // and in increasing index order.
+    std::vector<IndexKeyRange> additionalRanges;
 };
 
 /**
@@ -110,6 +115,11 @@ protected:
     void doRestoreStateRequiresIndex() final;
 
 private:
+    /**
+     * Positions '_cursor' at the first key of range number '_currentRange'.
+     */
+    boost::optional<IndexKeyEntry> seekToCurrentRange();
+
     // The WorkingSet we annotate with results.  Not owned by us.
     WorkingSet* _workingSet;
 
@@ -123,11 +133,18 @@ private:
     const BSONObj _endKey;
     const bool _endKeyInclusive = true;
 
+    const std::vector<IndexKeyRange> _additionalRanges;
+
+    // The range being counted: 0 for the one from '_startKey' to '_endKey', or one more than the
+    // position in '_additionalRanges'. Set '_needsSeek' when the cursor has yet to move into it.
+    size_t _currentRange = 0;
+    bool _needsSeek = false;
+
     std::unique_ptr<SortedDataInterface::Cursor> _cursor;
 
     // The set of record ids we've returned so far. Used to avoid returning duplicates, if
     // '_shouldDedup' is set to true.
-    stdx::unordered_set<RecordId, RecordId::Hasher> _returned;
+    RecordIdSet _returned;
 
     CountScanStats _specificStats;
 };
@@ -54,6 +54,9 @@ struct DeleteStageParams {
     // (a "single delete")?
     bool isMulti;
 
+    // Optional. When positive, a multi delete stops once it has deleted this many documents.
+    long long limit = 0;
+
     // Is this delete part of a migrate operation that is essentially like a no-op
     // when the cluster is observed by an external client.
     bool fromMigrate;
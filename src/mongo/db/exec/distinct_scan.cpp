@@ -46,13 +46,17 @@ using std::vector;
 // static
 const char* DistinctScan::kStageType = "DISTINCT_SCAN";
 
-DistinctScan::DistinctScan(OperationContext* opCtx, DistinctParams params, WorkingSet* workingSet)
+DistinctScan::DistinctScan(OperationContext* opCtx,
+                           DistinctParams params,
+                           WorkingSet* workingSet,
+                           const MatchExpression* filter)
     : RequiresIndexStage(kStageType, opCtx, params.indexDescriptor, workingSet),
       _workingSet(workingSet),
       _keyPattern(std::move(params.keyPattern)),
       _scanDirection(params.scanDirection),
       _bounds(std::move(params.bounds)),
       _fieldNo(params.fieldNo),
+      _filter(filter),
       _checker(&_bounds, _keyPattern, _scanDirection) {
     _specificStats.keyPattern = _keyPattern;
     _specificStats.indexName = params.name;
@@ -109,11 +113,20 @@ PlanStage::StageState DistinctScan::doWork(WorkingSetID* out) {
             return IS_EOF;
 
         case IndexBoundsChecker::VALID:
-            // Return this key. Adjust the _seekPoint so that it is exclusive on the field we
-            // are using.
-
             if (!kv->key.isOwned())
                 kv->key = kv->key.getOwned();
+
+            if (!Filter::passes(kv->key, _keyPattern, _filter)) {
+                // Another key with the same value for our field may still pass, so only move
+                // past this key. Every entry with the same key fails the filter the same way.
+                _seekPoint.keyPrefix = kv->key;
+                _seekPoint.prefixLen = _keyPattern.nFields();
+                _seekPoint.prefixExclusive = true;
+                return PlanStage::NEED_TIME;
+            }
+
+            // Return this key. Adjust the _seekPoint so that it is exclusive on the field we
+            // are using.
             _seekPoint.keyPrefix = kv->key;
             _seekPoint.prefixLen = _fieldNo + 1;
             _seekPoint.prefixExclusive = true;
@@ -160,6 +173,12 @@ void DistinctScan::doReattachToOperationContext() {
 }
 
 unique_ptr<PlanStageStats> DistinctScan::getStats() {
+    if (_filter) {
+        BSONObjBuilder bob;
+        _filter->serialize(&bob);
+        _commonStats.filter = bob.obj();
+    }
+
     // Serialize the bounds to BSON if we have not done so already. This is done here rather than in
     // the constructor in order to avoid the expensive serialization operation unless the distinct
     // command is being explained.
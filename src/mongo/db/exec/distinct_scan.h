@@ -91,11 +91,17 @@ struct DistinctParams {
  * for that field, so there is no point in examining all keys with the same value for that
  * field.
  *
+ * If a 'filter' over the index key fields is given, keys that fail it are stepped over one at a
+ * time, and the skip to the next value only happens once a key for the current value passes.
+ *
  * Only created through the getExecutorDistinct path.  See db/query/get_executor.cpp
  */
 class DistinctScan final : public RequiresIndexStage {
 public:
-    DistinctScan(OperationContext* opCtx, DistinctParams params, WorkingSet* workingSet);
+    DistinctScan(OperationContext* opCtx,
+                 DistinctParams params,
+                 WorkingSet* workingSet,
+                 const MatchExpression* filter = nullptr);
 
     StageState doWork(WorkingSetID* out) final;
     bool isEOF() final;
@@ -129,6 +135,9 @@ private:
 
     const int _fieldNo = 0;
 
+    // The filter is not owned by us.
+    const MatchExpression* const _filter;
+
     // The cursor we use to navigate the tree.
     std::unique_ptr<SortedDataInterface::Cursor> _cursor;
 
@@ -237,14 +237,16 @@ void DocumentStorage::addFieldToHashTable(Position pos) {
     *posPtr = Position(pos.index);
 }
 
-void DocumentStorage::alloc(unsigned newSize) {
+void DocumentStorage::alloc(unsigned newSize, size_t expectedFields) {
     const bool firstAlloc = !_cache;
-    const bool doingRehash = needRehash();
+    const unsigned oldBuckets = hashTabBuckets();
     const size_t oldCapacity = _cacheEnd - _cache;
 
     // make new bucket count big enough
-    while (needRehash() || hashTabBuckets() < HASH_TAB_INIT_SIZE)
+    while (needRehash() || hashTabBuckets() < HASH_TAB_INIT_SIZE ||
+           expectedFields * 2 > hashTabBuckets())
         _hashTabMask = hashTabBuckets() * 2 - 1;
+    const bool doingRehash = hashTabBuckets() != oldBuckets;
 
     // only allocate power-of-two sized space > 128 bytes
     size_t capacity = 128;
@@ -290,6 +292,27 @@ void DocumentStorage::reserveFields(size_t expectedFields) {
     _cacheEnd = _cache + newSize;
 }
 
+void DocumentStorage::reserveAdditionalFields(size_t additionalFields) {
+    if (!additionalFields) {
+        return;
+    }
+    if (!_cache) {
+        reserveFields(additionalFields);
+        return;
+    }
+
+    // Using additionalFields+1 to allow space for long field names
+    const size_t newSize =
+        _usedBytes + (additionalFields + 1) * ValueElement::align(sizeof(ValueElement));
+    const size_t expectedFields = _numFields + additionalFields;
+    if (_cache + newSize <= _cacheEnd && expectedFields * 2 <= hashTabBuckets()) {
+        return;
+    }
+
+    uassert(5212020, "Tried to make oversized document", newSize <= size_t(BufferMaxSize));
+    alloc(newSize, expectedFields);
+}
+
 intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
     auto out = make_intrusive<DocumentStorage>(_bson, _stripMetadata, _modified);
 
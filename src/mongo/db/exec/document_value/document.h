@@ -503,6 +503,15 @@ public:
         storage().reset(bson, stripMetadata);
     }
 
+    /** Hint that up to 'additionalFields' fields are about to be added. Like the constructor's
+     *  'expectedFields' this only affects memory allocation efficiency, but it also applies to a
+     *  MutableDocument which already has fields.
+     */
+    void reserveAdditionalFields(size_t additionalFields) {
+        if (additionalFields)
+            storage().reserveAdditionalFields(additionalFields);
+    }
+
     /** Add the given field to the Document.
      *
      *  BSON documents' fields are ordered; the new Field will be
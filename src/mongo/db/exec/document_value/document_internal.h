@@ -360,6 +360,11 @@ public:
      */
     void reserveFields(size_t expectedFields);
 
+    /** Makes room for 'additionalFields' more fields to be appended without growing the buffer or
+     *  the hash table once per few fields. Unlike reserveFields() this may be called at any time.
+     */
+    void reserveAdditionalFields(size_t additionalFields);
+
     /// This returns values from the cache and underlying BSON.
     DocumentStorageIterator iterator() const {
         return DocumentStorageIterator(const_cast<DocumentStorage*>(this), BSONObjIterator(_bson));
@@ -475,8 +480,9 @@ private:
     /// Returns the position of the named field in the cache or Position()
     Position findFieldInCache(StringData name) const;
 
-    /// Allocates space in _cache. Copies existing data if there is any.
-    void alloc(unsigned newSize);
+    /// Allocates space in _cache. Copies existing data if there is any. The hash table is sized for
+    /// at least 'expectedFields' fields.
+    void alloc(unsigned newSize, size_t expectedFields = 0);
 
     /// Call after adding field to _cache and increasing _numFields
     void addFieldToHashTable(Position pos);
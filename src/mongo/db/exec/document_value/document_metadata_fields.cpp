@@ -49,10 +49,10 @@ DocumentMetadataFields& DocumentMetadataFields::operator=(const DocumentMetadata
     return *this;
 }
 
-DocumentMetadataFields::DocumentMetadataFields(DocumentMetadataFields&& other)
+DocumentMetadataFields::DocumentMetadataFields(DocumentMetadataFields&& other) noexcept
     : _holder(std::move(other._holder)) {}
 
-DocumentMetadataFields& DocumentMetadataFields::operator=(DocumentMetadataFields&& other) {
+DocumentMetadataFields& DocumentMetadataFields::operator=(DocumentMetadataFields&& other) noexcept {
     _holder = std::move(other._holder);
     return *this;
 }
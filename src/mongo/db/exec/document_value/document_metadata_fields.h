@@ -117,8 +117,8 @@ public:
     DocumentMetadataFields(const DocumentMetadataFields& other);
     DocumentMetadataFields& operator=(const DocumentMetadataFields& other);
 
-    DocumentMetadataFields(DocumentMetadataFields&& other);
-    DocumentMetadataFields& operator=(DocumentMetadataFields&& other);
+    DocumentMetadataFields(DocumentMetadataFields&& other) noexcept;
+    DocumentMetadataFields& operator=(DocumentMetadataFields&& other) noexcept;
 
     /**
      * For all metadata fields that 'other' has but 'this' does not have, copies these fields from
@@ -175,6 +175,28 @@ TEST(DocumentSerialization, CannotSerializeDocumentThatExceedsDepthLimit) {
     throwaway.abandon();
 }
 
+TEST(MutableDocumentReserve, ReserveAdditionalFieldsAvoidsGrowingStorage) {
+    MutableDocument md;
+    md.addField("a", Value(1));
+    md.addField("b", Value(2));
+    md.reserveAdditionalFields(100);
+    const auto reservedSize = md.getApproximateSize();
+
+    for (int i = 0; i < 100; ++i) {
+        md.addField(str::stream() << "f" << i, Value(i));
+    }
+    ASSERT_EQ(reservedSize, md.getApproximateSize());
+
+    auto doc = md.freeze();
+    ASSERT_EQ(102ULL, doc.computeSize());
+    ASSERT_EQ(1, doc["a"].getInt());
+    ASSERT_EQ(2, doc["b"].getInt());
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(i, doc[str::stream() << "f" << i].getInt());
+    }
+    assertRoundTrips(doc);
+}
+
 /** Add Document fields. */
 class AddField {
 public:
@@ -676,11 +676,12 @@ inline static int cmp(const T& left, const T& right) {
     }
 }
 
-int Value::compare(const Value& rL,
-                   const Value& rR,
-                   const StringData::ComparatorInterface* stringComparator) {
+int Value::compareGeneric(const Value& rL,
+                          const Value& rR,
+                          const StringData::ComparatorInterface* stringComparator) {
     // Note, this function needs to behave identically to BSONElement::compareElements().
-    // Additionally, any changes here must be replicated in hash_combine().
+    // Additionally, any changes here must be replicated in hash_combine() and in the inline cases
+    // of compare().
     BSONType lType = rL.getType();
     BSONType rType = rR.getType();
 
@@ -904,9 +905,7 @@ void Value::hash_combine(size_t& seed,
         // applies for decimals when they are inside of the valid double range. See
         // the above case.)
         // SERVER-16851
-        case NumberDouble:
-        case NumberLong:
-        case NumberInt: {
+        case NumberDouble: {
             const double dbl = getDouble();
             if (std::isnan(dbl)) {
                 boost::hash_combine(seed, numeric_limits<double>::quiet_NaN());
@@ -916,6 +915,15 @@ void Value::hash_combine(size_t& seed,
             break;
         }
 
+        // Integers are never NaN, so hash their double value directly.
+        case NumberLong:
+            boost::hash_combine(seed, static_cast<double>(_storage.longValue));
+            break;
+
+        case NumberInt:
+            boost::hash_combine(seed, static_cast<double>(_storage.intValue));
+            break;
+
         case jstOID:
             getOid().hash_combine(seed);
             break;
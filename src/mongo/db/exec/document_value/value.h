@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/base/compare_numbers.h"
 #include "mongo/base/static_assert.h"
 #include "mongo/base/string_data.h"
 #include "mongo/db/exec/document_value/value_internal.h"
@@ -368,6 +369,11 @@ private:
     // May contain embedded NUL bytes, does not check the type.
     StringData getRawData() const;
 
+    // compare() for the cases it does not handle inline.
+    static int compareGeneric(const Value& lhs,
+                              const Value& rhs,
+                              const StringData::ComparatorInterface* stringComparator);
+
     ValueStorage _storage;
     friend class MutableValue;  // gets and sets _storage.genericRCPtr
 };
@@ -487,4 +493,32 @@ inline BSONBinData Value::getBinData() const {
     auto stringData = _storage.getString();
     return BSONBinData(stringData.rawData(), stringData.size(), _storage.binDataType());
 }
+
+inline int Value::compare(const Value& lhs,
+                          const Value& rhs,
+                          const StringData::ComparatorInterface* stringComparator) {
+    // Sorting and grouping mostly compare values of one numeric or string type, so compare those
+    // inline, skipping the type canonicalization and the nested switch of compareGeneric().
+    const BSONType type = lhs.getType();
+    if (type == rhs.getType()) {
+        switch (type) {
+            case NumberInt:
+                return compareInts(lhs._storage.intValue, rhs._storage.intValue);
+            case NumberLong:
+                return compareLongs(lhs._storage.longValue, rhs._storage.longValue);
+            case NumberDouble:
+                return compareDoubles(lhs._storage.doubleValue, rhs._storage.doubleValue);
+            case Date:
+                return compareLongs(lhs._storage.dateValue, rhs._storage.dateValue);
+            case String:
+                if (!stringComparator) {
+                    return lhs.getRawData().compare(rhs.getRawData());
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return compareGeneric(lhs, rhs, stringComparator);
+}
 }  // namespace mongo
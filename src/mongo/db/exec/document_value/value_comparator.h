@@ -36,6 +36,7 @@
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/stdx/unordered_set.h"
+#include "mongo/util/flat_hash_map.h"
 
 namespace mongo {
 
@@ -183,6 +184,15 @@ public:
         return stdx::unordered_map<Value, T, Hasher, EqualTo>(0, Hasher(this), EqualTo(this));
     }
 
+    /**
+     * Like makeUnorderedValueMap(), but the map stores its elements inline, so references into it
+     * are invalidated by insertions. This comparator must outlive the returned map.
+     */
+    template <typename T>
+    FlatHashMap<Value, T, Hasher, EqualTo> makeFlatHashValueMap() const {
+        return FlatHashMap<Value, T, Hasher, EqualTo>(0, Hasher(this), EqualTo(this));
+    }
+
 private:
     const StringData::ComparatorInterface* _stringComparator = nullptr;
 };
@@ -203,4 +213,7 @@ template <typename T>
 using ValueUnorderedMap =
     stdx::unordered_map<Value, T, ValueComparator::Hasher, ValueComparator::EqualTo>;
 
+template <typename T>
+using ValueFlatHashMap = FlatHashMap<Value, T, ValueComparator::Hasher, ValueComparator::EqualTo>;
+
 }  // namespace mongo
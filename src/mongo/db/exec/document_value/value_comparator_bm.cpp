@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/exec/document_value/value_comparator.h"
+
+namespace mongo {
+namespace {
+
+constexpr size_t kNumValues = 4096;
+
+std::vector<Value> makeValues(BSONType type) {
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int> dist(0, 1 << 20);
+    std::vector<Value> values;
+    values.reserve(kNumValues);
+    for (size_t i = 0; i < kNumValues; ++i) {
+        const int n = dist(gen);
+        switch (type) {
+            case NumberInt:
+                values.emplace_back(n);
+                break;
+            case NumberLong:
+                values.emplace_back(static_cast<long long>(n));
+                break;
+            case NumberDouble:
+                values.emplace_back(n / 3.0);
+                break;
+            case String:
+                values.emplace_back("key" + std::to_string(n));
+                break;
+            default:
+                MONGO_UNREACHABLE;
+        }
+    }
+    return values;
+}
+
+void BM_ValueSort(benchmark::State& state, BSONType type) {
+    const auto values = makeValues(type);
+    const auto lessThan = ValueComparator::kInstance.getLessThan();
+    for (auto _ : state) {
+        auto sorted = values;
+        std::sort(sorted.begin(), sorted.end(), lessThan);
+        benchmark::DoNotOptimize(sorted.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+void BM_ValueGroup(benchmark::State& state, BSONType type) {
+    const auto values = makeValues(type);
+    for (auto _ : state) {
+        auto groups = ValueComparator::kInstance.makeFlatHashValueMap<long long>();
+        for (auto&& value : values) {
+            ++groups[value];
+        }
+        benchmark::DoNotOptimize(groups.size());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+BENCHMARK_CAPTURE(BM_ValueSort, Int, NumberInt);
+BENCHMARK_CAPTURE(BM_ValueSort, Long, NumberLong);
+BENCHMARK_CAPTURE(BM_ValueSort, Double, NumberDouble);
+BENCHMARK_CAPTURE(BM_ValueSort, String, String);
+
+BENCHMARK_CAPTURE(BM_ValueGroup, Int, NumberInt);
+BENCHMARK_CAPTURE(BM_ValueGroup, Long, NumberLong);
+BENCHMARK_CAPTURE(BM_ValueGroup, Double, NumberDouble);
+BENCHMARK_CAPTURE(BM_ValueGroup, String, String);
+
+}  // namespace
+}  // namespace mongo
@@ -38,6 +38,7 @@
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/str.h"
 
@@ -59,13 +60,18 @@ FetchStage::FetchStage(OperationContext* opCtx,
       _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr),
       _idRetrying(WorkingSet::INVALID_ID) {
     _children.emplace_back(std::move(child));
+    if (_filter && internalQueryEnableFlatPredicatePrograms.load()) {
+        _filterProgram = FlatPredicateProgram::compile(_filter);
+    }
 }
 
 FetchStage::~FetchStage() {}
 
 bool FetchStage::isEOF() {
-    if (WorkingSet::INVALID_ID != _idRetrying) {
-        // We have a working set member that we need to retry.
+    if (WorkingSet::INVALID_ID != _idRetrying || !_batchedChildResults.empty() ||
+        _pendingChildState) {
+        // We have a working set member that we need to retry, or results from a batch which we
+        // have yet to process.
         return false;
     }
 
@@ -77,47 +83,28 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
-    // Either retry the last WSM we worked on or get a new one from our child.
+    // Either retry the last WSM we worked on, process one left over from a batch, or get a new
+    // one from our child.
     WorkingSetID id;
     StageState status;
-    if (_idRetrying == WorkingSet::INVALID_ID) {
-        status = child()->work(&id);
-    } else {
+    if (_idRetrying != WorkingSet::INVALID_ID) {
         status = ADVANCED;
         id = _idRetrying;
         _idRetrying = WorkingSet::INVALID_ID;
+    } else if (!_batchedChildResults.empty()) {
+        status = ADVANCED;
+        id = _batchedChildResults.front();
+        _batchedChildResults.pop_front();
+    } else if (_pendingChildState) {
+        status = *_pendingChildState;
+        id = _pendingChildOut;
+        _pendingChildState = boost::none;
+    } else {
+        status = child()->work(&id);
     }
 
     if (PlanStage::ADVANCED == status) {
-        WorkingSetMember* member = _ws->get(id);
-
-        // If there's an obj there, there is no fetching to perform.
-        if (member->hasObj()) {
-            ++_specificStats.alreadyHasObj;
-        } else {
-            // We need a valid RecordId to fetch from and this is the only state that has one.
-            verify(WorkingSetMember::RID_AND_IDX == member->getState());
-            verify(member->hasRecordId());
-
-            try {
-                if (!_cursor)
-                    _cursor = collection()->getCursor(getOpCtx());
-
-                if (!WorkingSetCommon::fetch(getOpCtx(), _ws, id, _cursor, collection()->ns())) {
-                    _ws->free(id);
-                    return NEED_TIME;
-                }
-            } catch (const WriteConflictException&) {
-                // Ensure that the BSONObj underlying the WorkingSetMember is owned because it may
-                // be freed when we yield.
-                member->makeObjOwnedIfNeeded();
-                _idRetrying = id;
-                *out = WorkingSet::INVALID_ID;
-                return NEED_YIELD;
-            }
-        }
-
-        return returnIfMatches(member, id, out);
+        return fetchAndFilter(id, out);
     } else if (PlanStage::FAILURE == status) {
         // The stage which produces a failure is responsible for allocating a working set member
         // with error details.
@@ -131,7 +118,144 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState FetchStage::doWorkBatch(size_t maxWorks,
+                                              std::vector<WorkingSetID>* results,
+                                              WorkingSetID* out) {
+    if (_idRetrying != WorkingSet::INVALID_ID || !_batchedChildResults.empty() ||
+        _pendingChildState) {
+        // Finish off whatever is left over from a previous batch one member at a time.
+        return workBatchLoop([this](WorkingSetID* id) { return FetchStage::doWork(id); },
+                             maxWorks,
+                             results,
+                             out);
+    }
+
+    // Pull a whole batch of index entries from our child before fetching any of them, so that the
+    // record lookups happen back to back against the same cursor.
+    const CommonStats* childStats = child()->getCommonStats();
+    const size_t childWorksBefore = childStats->works;
+    const size_t childAdvancedBefore = childStats->advanced;
+
+    _childBatch.clear();
+    WorkingSetID childOut = WorkingSet::INVALID_ID;
+    const StageState childState = child()->workBatch(maxWorks, &_childBatch, &childOut);
+
+    // Every unit of work done by our child which did not produce a result would have been a
+    // NEED_TIME from us had it been done through doWork().
+    const size_t childWorksWithoutResult =
+        (childStats->works - childWorksBefore) - (childStats->advanced - childAdvancedBefore);
+    const bool childEndedBatch =
+        PlanStage::ADVANCED != childState && PlanStage::NEED_TIME != childState;
+    const size_t childNeedTime = childWorksWithoutResult - (childEndedBatch ? 1 : 0);
+    _commonStats.works += childNeedTime;
+    _commonStats.needTime += childNeedTime;
+
+    lookupBatch();
+
+    const size_t numResultsBefore = results->size();
+    for (size_t i = 0; i < _childBatch.size(); ++i) {
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        StageState state = recordWork(fetchAndFilter(
+            _childBatch[i], &id, _batchRecords.empty() ? nullptr : &_batchRecords[i]));
+        if (PlanStage::ADVANCED == state) {
+            results->push_back(id);
+        } else if (PlanStage::NEED_YIELD == state) {
+            // Stash the rest of the batch, along with whatever ended our child's batch, to be
+            // processed once we've yielded. Their records are looked up again at that point, as
+            // the ones from lookupBatch() belong to the snapshot we are giving up.
+            _batchedChildResults.assign(_childBatch.begin() + i + 1, _childBatch.end());
+            if (childEndedBatch) {
+                _pendingChildState = childState;
+                _pendingChildOut = childOut;
+            }
+            *out = id;
+            return state;
+        }
+    }
+
+    if (childEndedBatch) {
+        recordWork(childState);
+        *out = childOut;
+        return childState;
+    }
+    return results->size() > numResultsBefore ? PlanStage::ADVANCED : PlanStage::NEED_TIME;
+}
+
+void FetchStage::lookupBatch() {
+    _batchRecords.clear();
+
+    std::vector<RecordId> ids;
+    for (auto&& id : _childBatch) {
+        WorkingSetMember* member = _ws->get(id);
+        if (!member->hasObj()) {
+            ids.push_back(member->recordId);
+        }
+    }
+    if (ids.size() < 2) {
+        return;
+    }
+
+    std::vector<boost::optional<Record>> records;
+    try {
+        if (!_cursor)
+            _cursor = collection()->getCursor(getOpCtx());
+        records = _cursor->seekExactBatch(ids);
+    } catch (const WriteConflictException&) {
+        // Leave the lookups to fetchAndFilter(), which knows how to yield and retry them.
+        return;
+    }
+
+    _batchRecords.resize(_childBatch.size());
+    auto record = records.begin();
+    for (size_t i = 0; i < _childBatch.size(); ++i) {
+        if (!_ws->get(_childBatch[i])->hasObj()) {
+            _batchRecords[i] = std::move(*record++);
+        }
+    }
+}
+
+PlanStage::StageState FetchStage::fetchAndFilter(WorkingSetID id,
+                                                 WorkingSetID* out,
+                                                 boost::optional<Record>* record) {
+    WorkingSetMember* member = _ws->get(id);
+
+    // If there's an obj there, there is no fetching to perform.
+    if (member->hasObj()) {
+        ++_specificStats.alreadyHasObj;
+    } else {
+        // We need a valid RecordId to fetch from and this is the only state that has one.
+        verify(WorkingSetMember::RID_AND_IDX == member->getState());
+        verify(member->hasRecordId());
+
+        try {
+            if (!_cursor)
+                _cursor = collection()->getCursor(getOpCtx());
+
+            const auto& ns = collection()->ns();
+            const bool fetched = record
+                ? WorkingSetCommon::fetch(getOpCtx(), _ws, id, std::move(*record), ns)
+                : WorkingSetCommon::fetch(getOpCtx(), _ws, id, _cursor, ns);
+            if (!fetched) {
+                _ws->free(id);
+                return NEED_TIME;
+            }
+        } catch (const WriteConflictException&) {
+            // Ensure that the BSONObj underlying the WorkingSetMember is owned because it may
+            // be freed when we yield.
+            member->makeObjOwnedIfNeeded();
+            _idRetrying = id;
+            *out = WorkingSet::INVALID_ID;
+            return NEED_YIELD;
+        }
+    }
+
+    return returnIfMatches(member, id, out);
+}
+
 void FetchStage::doSaveStateRequiresCollection() {
+    for (auto id : _batchedChildResults) {
+        _ws->get(id)->makeObjOwnedIfNeeded();
+    }
     if (_cursor) {
         _cursor->saveUnpositioned();
     }
@@ -173,7 +297,7 @@ PlanStage::StageState FetchStage::returnIfMatches(WorkingSetMember* member,
     // predicate.
     ++_specificStats.docsExamined;
 
-    if (Filter::passes(member, _filter)) {
+    if (Filter::passes(member, _filter, _filterProgram.get())) {
         *out = memberID;
         return PlanStage::ADVANCED;
     } else {
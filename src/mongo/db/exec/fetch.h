@@ -29,12 +29,17 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+#include <deque>
 #include <memory>
+#include <vector>
 
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/flat_predicate_program.h"
 #include "mongo/db/record_id.h"
+#include "mongo/db/storage/record_store.h"
 
 namespace mongo {
 
@@ -75,11 +80,31 @@ public:
     static const char* kStageType;
 
 protected:
+    StageState doWorkBatch(size_t maxWorks,
+                           std::vector<WorkingSetID>* results,
+                           WorkingSetID* out) final;
+
     void doSaveStateRequiresCollection() final;
 
     void doRestoreStateRequiresCollection() final;
 
 private:
+    /**
+     * Looks up the records for all members of '_childBatch' which need fetching with a single
+     * seekExactBatch() call, leaving the results in '_batchRecords'. Leaves '_batchRecords' empty
+     * if there is nothing to gain from a batched lookup, or if the lookup hit a write conflict.
+     */
+    void lookupBatch();
+
+    /**
+     * Fetches the document for the member with id 'id', if it does not already have one, and then
+     * applies our filter to it via returnIfMatches(). If 'record' is not null, it holds the result
+     * of looking up the member's record, and is used instead of seeking '_cursor'.
+     */
+    StageState fetchAndFilter(WorkingSetID id,
+                              WorkingSetID* out,
+                              boost::optional<Record>* record = nullptr);
+
     /**
      * If the member (with id memberID) passes our filter, set *out to memberID and return that
      * ADVANCED.  Otherwise, free memberID and return NEED_TIME.
@@ -95,9 +120,28 @@ private:
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // A single-pass form of '_filter', if it has a suitable shape.
+    std::unique_ptr<FlatPredicateProgram> _filterProgram;
+
     // If not Null, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
+    // Results produced by our child during doWorkBatch() which we did not get to before having to
+    // yield. These are processed, in order, before asking our child for anything else.
+    std::deque<WorkingSetID> _batchedChildResults;
+
+    // If our child's batch ended with a state other than ADVANCED or NEED_TIME and we had to yield
+    // before processing all of its results, that state and its WorkingSetID are held here until
+    // '_batchedChildResults' has been drained.
+    boost::optional<StageState> _pendingChildState;
+    WorkingSetID _pendingChildOut = WorkingSet::INVALID_ID;
+
+    // Scratch space for the results of a child batch, reused across calls to doWorkBatch().
+    std::vector<WorkingSetID> _childBatch;
+
+    // The records looked up by lookupBatch() for the members of '_childBatch', by position.
+    std::vector<boost::optional<Record>> _batchRecords;
+
     // Stats
     FetchStats _specificStats;
 };
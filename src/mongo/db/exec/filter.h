@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/flat_predicate_program.h"
 #include "mongo/db/matcher/matchable.h"
 
 namespace mongo {
@@ -159,6 +160,19 @@ public:
         return filter->matches(&doc, nullptr);
     }
 
+    /**
+     * Same as above, but evaluates 'program' instead of 'filter' when it is non-null and 'wsm' has
+     * a document. 'program' must have been compiled from 'filter'.
+     */
+    static bool passes(WorkingSetMember* wsm,
+                       const MatchExpression* filter,
+                       const FlatPredicateProgram* program) {
+        if (program && wsm->hasObj()) {
+            return program->matchesBSON(wsm->doc.value().toBson());
+        }
+        return passes(wsm, filter);
+    }
+
     static bool passes(const BSONObj& keyData,
                        const BSONObj& keyPattern,
                        const MatchExpression* filter) {
@@ -51,6 +51,7 @@
 #include "mongo/db/query/expression_index_knobs_gen.h"
 
 #include <algorithm>
+#include <cmath>
 
 namespace mongo {
 
@@ -535,6 +536,54 @@ private:
     // Owns matcher
     const unique_ptr<MatchExpression> _matcher;
 };
+/**
+ * Returns the width of the next interval, given the width 'boundsIncrement' of the last one.
+ *
+ * The width halves when the last interval returned more than 600 results and grows when it
+ * returned fewer than 300. Growth is at least a doubling, but once some results have been found,
+ * the density of the area searched so far predicts how far out the next interval must reach to
+ * return about 450 results. This lets sparse data skip many nearly empty intervals at once.
+ */
+double nextBoundsIncrement(double boundsIncrement,
+                           const R2Annulus& fullBounds,
+                           const R2Annulus& currBounds,
+                           const std::vector<IntervalStats>& intervalStats) {
+    const long long kMinResultsPerInterval = 300;
+    const long long kMaxResultsPerInterval = 600;
+    const double kTargetResultsPerInterval = 450;
+    const double kMaxGrowthFactor = 16;
+
+    if (intervalStats.empty()) {
+        return boundsIncrement;
+    }
+
+    // TODO: Generally we want small numbers of results fast, then larger numbers later
+    const IntervalStats& lastIntervalStats = intervalStats.back();
+    if (lastIntervalStats.numResultsReturned > kMaxResultsPerInterval) {
+        return boundsIncrement / 2;
+    }
+    if (lastIntervalStats.numResultsReturned >= kMinResultsPerInterval) {
+        return boundsIncrement;
+    }
+
+    long long numResults = 0;
+    for (const auto& stats : intervalStats) {
+        numResults += stats.numResultsReturned;
+    }
+
+    // Areas are compared as planar annuli, so the common factor of pi is left out.
+    const double inner = fullBounds.getInner();
+    const double outer = currBounds.getOuter();
+    const double searchedArea = outer * outer - inner * inner;
+    if (numResults == 0 || !(searchedArea > 0)) {
+        return boundsIncrement * 2;
+    }
+
+    const double neededArea = kTargetResultsPerInterval * searchedArea / numResults;
+    const double predictedIncrement = std::sqrt(outer * outer + neededArea) - outer;
+    return std::max(boundsIncrement * 2,
+                    std::min(predictedIncrement, boundsIncrement * kMaxGrowthFactor));
+}
 }  // namespace
 
 static double min2DBoundsIncrement(const GeoNearExpression& query,
@@ -582,15 +631,8 @@ GeoNear2DStage::nextInterval(OperationContext* opCtx,
     // Setup the next interval
     //
 
-    if (!_specificStats.intervalStats.empty()) {
-        const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
-
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
-            _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
-            _boundsIncrement /= 2;
-    }
+    _boundsIncrement = nextBoundsIncrement(
+        _boundsIncrement, _fullBounds, _currBounds, _specificStats.intervalStats);
 
     _boundsIncrement =
         max(_boundsIncrement, min2DBoundsIncrement(*_nearParams.nearQuery, indexDescriptor()));
@@ -978,15 +1020,8 @@ GeoNear2DSphereStage::nextInterval(OperationContext* opCtx,
     // Setup the next interval
     //
 
-    if (!_specificStats.intervalStats.empty()) {
-        const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
-
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
-            _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
-            _boundsIncrement /= 2;
-    }
+    _boundsIncrement = nextBoundsIncrement(
+        _boundsIncrement, _fullBounds, _currBounds, _specificStats.intervalStats);
 
     invariant(_boundsIncrement > 0.0);
 
@@ -33,6 +33,7 @@
 
 #include "mongo/db/exec/index_scan.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/catalog/index_catalog.h"
@@ -56,6 +57,24 @@ int sgn(int i) {
 
 namespace mongo {
 
+namespace {
+
+/**
+ * Returns true if 'bounds' consist of a single point for every field, in which case every entry
+ * scanned has the same key. Since an index holds at most one entry per key and RecordId, such a
+ * scan cannot return a RecordId twice, even over a multikey index.
+ */
+bool isSingleKeyScan(const IndexBounds& bounds) {
+    if (bounds.isSimpleRange || bounds.fields.empty()) {
+        return false;
+    }
+    return std::all_of(bounds.fields.begin(), bounds.fields.end(), [](const auto& oil) {
+        return oil.intervals.size() == 1 && oil.intervals[0].isPoint();
+    });
+}
+
+}  // namespace
+
 // static
 const char* IndexScan::kStageType = "IXSCAN";
 
@@ -70,7 +89,7 @@ IndexScan::IndexScan(OperationContext* opCtx,
       _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr),
       _direction(params.direction),
       _forward(params.direction == 1),
-      _shouldDedup(params.shouldDedup),
+      _shouldDedup(params.shouldDedup && !isSingleKeyScan(_bounds)),
       _addKeyMetadata(params.addKeyMetadata),
       _startKeyInclusive(IndexBounds::isStartIncludedInBound(params.bounds.boundInclusion)),
       _endKeyInclusive(IndexBounds::isEndIncludedInBound(params.bounds.boundInclusion)) {
@@ -212,11 +231,12 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
 
     if (_shouldDedup) {
         ++_specificStats.dupsTested;
-        if (!_returned.insert(kv->loc).second) {
+        if (!_returned.insert(kv->loc)) {
             // We've seen this RecordId before. Skip it this time.
             ++_specificStats.dupsDropped;
             return PlanStage::NEED_TIME;
         }
+        _specificStats.dedupMemoryUsageBytes = _returned.getMemUsage();
     }
 
     if (!Filter::passes(kv->key, _keyPattern, _filter)) {
@@ -242,6 +262,17 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
     return PlanStage::ADVANCED;
 }
 
+PlanStage::StageState IndexScan::doWorkBatch(size_t maxWorks,
+                                             std::vector<WorkingSetID>* results,
+                                             WorkingSetID* out) {
+    // doWork() is final, so naming it explicitly lets the compiler resolve and inline it rather
+    // than paying for a virtual call and a timer read per index key.
+    return workBatchLoop([this](WorkingSetID* id) { return IndexScan::doWork(id); },
+                         maxWorks,
+                         results,
+                         out);
+}
+
 bool IndexScan::isEOF() {
     return _commonStats.isEOF;
 }
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/db/exec/record_id_set.h"
 #include "mongo/db/exec/requires_index_stage.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/jsobj.h"
@@ -37,7 +38,6 @@
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/index_entry_comparison.h"
 #include "mongo/db/storage/sorted_data_interface.h"
-#include "mongo/stdx/unordered_set.h"
 
 namespace mongo {
 
@@ -129,6 +129,10 @@ public:
     static const char* kStageType;
 
 protected:
+    StageState doWorkBatch(size_t maxWorks,
+                           std::vector<WorkingSetID>* results,
+                           WorkingSetID* out) final;
+
     void doSaveStateRequiresIndex() final;
 
     void doRestoreStateRequiresIndex() final;
@@ -167,7 +171,7 @@ private:
     ScanState _scanState = ScanState::INITIALIZING;
 
     // Could our index have duplicates?  If so, we use _returned to dedup.
-    stdx::unordered_set<RecordId, RecordId::Hasher> _returned;
+    RecordIdSet _returned;
 
     //
     // This class employs one of two different algorithms for determining when the index scan
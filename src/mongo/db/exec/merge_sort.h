@@ -37,6 +37,7 @@
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/record_id.h"
+#include "mongo/util/flat_hash_map.h"
 
 namespace mongo {
 
@@ -116,7 +117,7 @@ private:
     const bool _dedup;
 
     // Which RecordIds have we seen?
-    stdx::unordered_set<RecordId, RecordId::Hasher> _seen;
+    FlatHashSet<RecordId, RecordId::Hasher> _seen;
 
     // In order to pick the next smallest value, we need each child work(...) until it produces
     // a result.  This is the queue of children that haven't given us a result yet.
@@ -47,7 +47,9 @@
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_cache_selectivity.h"
 #include "mongo/db/query/plan_ranker.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/str.h"
 
@@ -64,14 +66,17 @@ const char* MultiPlanStage::kStageType = "MULTI_PLAN";
 MultiPlanStage::MultiPlanStage(OperationContext* opCtx,
                                const Collection* collection,
                                CanonicalQuery* cq,
-                               CachingMode cachingMode)
+                               CachingMode cachingMode,
+                               bool probeSelectivity)
     : RequiresCollectionStage(kStageType, opCtx, collection),
       _cachingMode(cachingMode),
+      _probeSelectivity(probeSelectivity),
       _query(cq),
       _bestPlanIdx(kNoSuchPlan),
       _backupPlanIdx(kNoSuchPlan),
       _failure(false),
       _failureCount(0),
+      _prunedCount(0),
       _statusMemberId(WorkingSet::INVALID_ID) {}
 
 void MultiPlanStage::addPlan(std::unique_ptr<QuerySolution> solution,
@@ -203,8 +208,11 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
     // make sense.
     ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
 
-    size_t numWorks = getTrialPeriodWorks(getOpCtx(), collection());
+    size_t numWorks =
+        std::max(getTrialPeriodWorks(getOpCtx(), collection()), _minTrialPeriodWorks);
     size_t numResults = getTrialPeriodNumToReturn(*_query);
+    size_t pruneRoundWorks = internalQueryPlanEvaluationPruneRoundWorks.load();
+    double pruneRatio = internalQueryPlanEvaluationPruneRatio.load();
 
     try {
         // Work the plans, stopping when a plan hits EOF or returns some fixed number of results.
@@ -213,6 +221,10 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
             if (!moreToDo) {
                 break;
             }
+
+            if (pruneRoundWorks > 0 && (ix + 1) % pruneRoundWorks == 0) {
+                pruneDominatedPlans(pruneRatio);
+            }
         }
     } catch (DBException& e) {
         e.addContext("exception thrown while multiplanner was selecting best plan");
@@ -360,12 +372,20 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
         }
 
         if (validSolutions) {
+            boost::optional<PlanCacheSelectivityProbe> selectivityProbe;
+            if (_probeSelectivity) {
+                selectivityProbe =
+                    plan_cache_selectivity::probeSolutions(getOpCtx(), collection(), solutions);
+            }
+
             CollectionQueryInfo::get(collection())
                 .getPlanCache()
                 ->set(*_query,
                       solutions,
                       std::move(ranking),
-                      getOpCtx()->getServiceContext()->getPreciseClockSource()->now())
+                      getOpCtx()->getServiceContext()->getPreciseClockSource()->now(),
+                      boost::none,
+                      selectivityProbe.get_ptr())
                 .transitional_ignore();
         }
     }
@@ -378,7 +398,7 @@ bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolic
 
     for (size_t ix = 0; ix < _candidates.size(); ++ix) {
         CandidatePlan& candidate = _candidates[ix];
-        if (candidate.failed) {
+        if (candidate.failed || candidate.pruned) {
             continue;
         }
 
@@ -436,12 +456,32 @@ bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolic
                 _failure = true;
                 return false;
             }
+
+            if (_failureCount + _prunedCount == _candidates.size()) {
+                // Every plan still in the race has failed. Rather than failing the query, go back
+                // to working the plans that were pruned.
+                for (auto&& other : _candidates) {
+                    other.pruned = false;
+                }
+                _prunedCount = 0;
+            }
         }
     }
 
     return !doneWorking;
 }
 
+void MultiPlanStage::pruneDominatedPlans(double ratio) {
+    for (auto&& ix : PlanRanker::findDominatedCandidates(_candidates, ratio)) {
+        LOGV2_DEBUG(5212007,
+                    2,
+                    "Pruning dominated candidate plan: {planSummary}",
+                    "planSummary"_attr = Explain::getPlanSummary(_candidates[ix].root));
+        _candidates[ix].pruned = true;
+        ++_prunedCount;
+    }
+}
+
 bool MultiPlanStage::hasBackupPlan() const {
     return kNoSuchPlan != _backupPlanIdx;
 }
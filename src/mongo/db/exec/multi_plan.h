@@ -75,11 +75,16 @@ public:
      *
      * If 'shouldCache' is true, writes a cache entry for the winning plan to the plan cache
      * when possible. If 'shouldCache' is false, the plan cache will never be written.
+     *
+     * If 'probeSelectivity' is true, the selectivity of the query is probed before its winning
+     * plan is written to the cache, so that the cache also remembers the winner for the query's
+     * selectivity bucket. Used when replanning a query whose cached plan did poorly.
      */
     MultiPlanStage(OperationContext* opCtx,
                    const Collection* collection,
                    CanonicalQuery* cq,
-                   CachingMode cachingMode = CachingMode::AlwaysCache);
+                   CachingMode cachingMode = CachingMode::AlwaysCache,
+                   bool probeSelectivity = false);
 
     bool isEOF() final;
 
@@ -121,6 +126,14 @@ public:
      */
     static size_t getTrialPeriodWorks(OperationContext* opCtx, const Collection* collection);
 
+    /**
+     * Makes the trial period run for at least 'works' rounds, unless a plan hits EOF or returns
+     * enough results first. Used when replanning a shape whose cached plan needed longer trials.
+     */
+    void setMinTrialPeriodWorks(size_t works) {
+        _minTrialPeriodWorks = works;
+    }
+
     /**
      * Returns the max number of documents which we should allow any plan to return during the
      * trial period. As soon as any plan hits this number of documents, the trial period ends.
@@ -182,11 +195,20 @@ private:
      */
     Status tryYield(PlanYieldPolicy* yieldPolicy);
 
+    /**
+     * Stops working the candidate plans whose productivity so far is below 'ratio' times that of
+     * the most productive candidate. Pruned plans are still ranked once the trial period ends.
+     */
+    void pruneDominatedPlans(double ratio);
+
     static const int kNoSuchPlan = -1;
 
     // Describes the cases in which we should write an entry for the winning plan to the plan cache.
     const CachingMode _cachingMode;
 
+    // Whether to probe the query's selectivity when writing the winning plan to the cache.
+    const bool _probeSelectivity;
+
     // The query that we're trying to figure out the best solution to.
     // not owned here
     CanonicalQuery* _query;
@@ -221,6 +243,12 @@ private:
     // If everything fails during the plan competition, we can't pick one.
     size_t _failureCount;
 
+    // The number of candidate plans pruned from the trial period for being dominated.
+    size_t _prunedCount;
+
+    // The least number of rounds the trial period runs for.
+    size_t _minTrialPeriodWorks = 0;
+
     // if pickBestPlan fails, this is set to the wsid of the statusMember
     // returned by ::work()
     WorkingSetID _statusMemberId;
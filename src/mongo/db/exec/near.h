@@ -41,7 +41,7 @@
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/record_id.h"
-#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/flat_hash_map.h"
 
 namespace mongo {
 
@@ -175,7 +175,7 @@ private:
     } _searchState;
 
     // Tracks RecordIds from the child stage to do our own deduping.
-    stdx::unordered_map<RecordId, WorkingSetID, RecordId::Hasher> _seenDocuments;
+    FlatHashMap<RecordId, WorkingSetID, RecordId::Hasher> _seenDocuments;
 
     // Stats for the stage covering this interval
     // This is owned by _specificStats
@@ -33,7 +33,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
-#include "mongo/stdx/unordered_set.h"
+#include "mongo/util/flat_hash_map.h"
 
 namespace mongo {
 
@@ -78,7 +78,7 @@ private:
     const bool _dedup;
 
     // Which RecordIds have we returned?
-    stdx::unordered_set<RecordId, RecordId::Hasher> _seen;
+    FlatHashSet<RecordId, RecordId::Hasher> _seen;
 
     // Stats
     OrStats _specificStats;
@@ -42,21 +42,16 @@ namespace mongo {
 PlanStage::StageState PlanStage::work(WorkingSetID* out) {
     invariant(_opCtx);
     ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
-    ++_commonStats.works;
-
-    StageState workResult = doWork(out);
-
-    if (StageState::ADVANCED == workResult) {
-        ++_commonStats.advanced;
-    } else if (StageState::NEED_TIME == workResult) {
-        ++_commonStats.needTime;
-    } else if (StageState::NEED_YIELD == workResult) {
-        ++_commonStats.needYield;
-    } else if (StageState::FAILURE == workResult) {
-        _commonStats.failed = true;
-    }
+    return recordWork(doWork(out));
+}
 
-    return workResult;
+PlanStage::StageState PlanStage::workBatch(size_t maxWorks,
+                                           std::vector<WorkingSetID>* results,
+                                           WorkingSetID* out) {
+    invariant(_opCtx);
+    invariant(maxWorks > 0);
+    ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
+    return doWorkBatch(maxWorks, results, out);
 }
 
 void PlanStage::saveState() {
@@ -193,6 +193,22 @@ public:
      */
     StageState work(WorkingSetID* out);
 
+    /**
+     * Performs up to 'maxWorks' units of work on the query, appending the WorkingSetID of every
+     * ADVANCED result to 'results'. This amortizes the per-call overhead of work() when the caller
+     * wants many results at once, such as a PlanExecutor draining a large scan.
+     *
+     * The batch ends early at the first unit of work which returns IS_EOF, NEED_YIELD or FAILURE.
+     * That state is returned and *out is populated exactly as work() would have populated it. Any
+     * results appended to 'results' before the batch ended are still valid and must be consumed by
+     * the caller before acting on the returned state. If all 'maxWorks' units of work were done,
+     * returns ADVANCED if at least one result was produced and NEED_TIME otherwise.
+     *
+     * Stages which only implement doWork() support this through a default implementation that
+     * calls doWork() in a loop.
+     */
+    StageState workBatch(size_t maxWorks, std::vector<WorkingSetID>* results, WorkingSetID* out);
+
     /**
      * Returns true if no more work can be done on the query / out of results.
      */
@@ -341,6 +357,60 @@ protected:
      */
     virtual StageState doWork(WorkingSetID* out) = 0;
 
+    /**
+     * Performs a batch of work. See comment at workBatch() above. Stages which can produce results
+     * more cheaply in bulk than through repeated calls to doWork() should override this. Overrides
+     * are responsible for keeping '_commonStats' consistent with what the equivalent sequence of
+     * work() calls would have reported.
+     */
+    virtual StageState doWorkBatch(size_t maxWorks,
+                                   std::vector<WorkingSetID>* results,
+                                   WorkingSetID* out) {
+        return workBatchLoop([this](WorkingSetID* id) { return doWork(id); },
+                             maxWorks,
+                             results,
+                             out);
+    }
+
+    /**
+     * Updates '_commonStats' for a unit of work which returned 'state', and returns 'state'.
+     */
+    StageState recordWork(StageState state) {
+        ++_commonStats.works;
+        if (StageState::ADVANCED == state) {
+            ++_commonStats.advanced;
+        } else if (StageState::NEED_TIME == state) {
+            ++_commonStats.needTime;
+        } else if (StageState::NEED_YIELD == state) {
+            ++_commonStats.needYield;
+        } else if (StageState::FAILURE == state) {
+            _commonStats.failed = true;
+        }
+        return state;
+    }
+
+    /**
+     * Implements the workBatch() contract by repeatedly invoking 'doOneWork', which must behave
+     * like doWork(). Stages whose doWork() is final can pass a lambda which calls it with a
+     * qualified name, so that the loop is resolved statically.
+     */
+    template <typename DoOneWork>
+    StageState workBatchLoop(DoOneWork&& doOneWork,
+                             size_t maxWorks,
+                             std::vector<WorkingSetID>* results,
+                             WorkingSetID* out) {
+        const size_t numResultsBefore = results->size();
+        for (size_t i = 0; i < maxWorks; ++i) {
+            StageState state = recordWork(doOneWork(out));
+            if (StageState::ADVANCED == state) {
+                results->push_back(*out);
+            } else if (StageState::NEED_TIME != state) {
+                return state;
+            }
+        }
+        return results->size() > numResultsBefore ? StageState::ADVANCED : StageState::NEED_TIME;
+    }
+
     /**
      * Saves any stage-specific state required to resume where it was if the underlying data
      * changes.
@@ -465,6 +465,7 @@ struct IndexScanStats : public SpecificStats {
           isUnique(false),
           dupsTested(0),
           dupsDropped(0),
+          dedupMemoryUsageBytes(0),
           keysExamined(0),
           seeks(0) {}
 
@@ -523,6 +524,10 @@ struct IndexScanStats : public SpecificStats {
     size_t dupsTested;
     size_t dupsDropped;
 
+    // Approximate memory used to remember the RecordIds returned so far, in order to drop
+    // duplicates.
+    uint64_t dedupMemoryUsageBytes;
+
     // Number of entries retrieved from the index during the scan.
     size_t keysExamined;
 
@@ -39,6 +39,7 @@
 #include "mongo/db/exec/projection_executor_builder.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/field_ref.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
@@ -55,6 +56,13 @@ void transitionMemberToOwnedObj(Document&& doc, WorkingSetMember* member) {
     member->transitionToOwnedObj();
 }
 
+void transitionMemberToComputedObj(Document&& doc, WorkingSetMember* member) {
+    member->keyData.clear();
+    member->recordId = {};
+    member->doc = {{}, std::move(doc)};
+    member->transitionToComputedObj();
+}
+
 void transitionMemberToOwnedObj(const BSONObj& bo, WorkingSetMember* member) {
     // Use the DocumentStorage that already exists on the WorkingSetMember's document
     // field if possible.
@@ -161,6 +169,48 @@ PlanStage::StageState ProjectionStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState ProjectionStage::doWorkBatch(size_t maxWorks,
+                                                   std::vector<WorkingSetID>* results,
+                                                   WorkingSetID* out) {
+    // Each unit of work we do corresponds to exactly one unit of work done by our child, so our
+    // stats for the batch mirror our child's.
+    const CommonStats* childStats = child()->getCommonStats();
+    const CommonStats childStatsBefore = *childStats;
+
+    const size_t firstNewResult = results->size();
+    StageState status = child()->workBatch(maxWorks, results, out);
+
+    _commonStats.works += childStats->works - childStatsBefore.works;
+    _commonStats.needTime += childStats->needTime - childStatsBefore.needTime;
+    _commonStats.needYield += childStats->needYield - childStatsBefore.needYield;
+    _commonStats.failed = _commonStats.failed || childStats->failed;
+
+    for (size_t i = firstNewResult; i < results->size(); ++i) {
+        Status projStatus = transform(_ws.get((*results)[i]));
+        if (!projStatus.isOK()) {
+            LOGV2_WARNING(5212000,
+                          "Couldn't execute projection, status = {projStatus}",
+                          "projStatus"_attr = redact(projStatus));
+            // Discard the results we haven't projected yet, along with whatever ended our child's
+            // batch, since we can no longer make progress.
+            for (size_t j = i; j < results->size(); ++j) {
+                _ws.free((*results)[j]);
+            }
+            if (PlanStage::FAILURE == status && WorkingSet::INVALID_ID != *out) {
+                _ws.free(*out);
+            }
+            results->resize(i);
+            _commonStats.advanced += i - firstNewResult;
+            _commonStats.failed = true;
+            *out = WorkingSetCommon::allocateStatusMember(&_ws, projStatus);
+            return PlanStage::FAILURE;
+        }
+    }
+
+    _commonStats.advanced += results->size() - firstNewResult;
+    return status;
+}
+
 std::unique_ptr<PlanStageStats> ProjectionStage::getStats() {
     _commonStats.isEOF = isEOF();
     auto ret = std::make_unique<PlanStageStats>(_commonStats, stageType());
@@ -223,9 +273,10 @@ Status ProjectionStageDefault::transform(WorkingSetMember* member) const {
         : _executor->applyTransformation(input);
 
     // An exclusion projection can return an unowned object since the output document is
-    // constructed from the input one backed by BSON which is owned by the storage system, so we
-    // need to  make sure we transition an owned document.
-    transitionMemberToOwnedObj(projected.getOwned(), member);
+    // constructed from the input one backed by BSON which is owned by the storage system. Rather
+    // than copying it here, the member keeps pointing at the storage engine's data until it is
+    // serialized into the response, and is only made owned if it has to survive a yield.
+    transitionMemberToComputedObj(std::move(projected), member);
 
     return Status::OK();
 }
@@ -293,9 +344,18 @@ ProjectionStageSimple::ProjectionStageSimple(boost::intrusive_ptr<ExpressionCont
                                              WorkingSet* ws,
                                              std::unique_ptr<PlanStage> child)
     : ProjectionStage{expCtx, projObj, ws, std::move(child), "PROJECTION_SIMPLE"} {
-    invariant(projection->isSimple());
-    _includedFields = {projection->getRequiredFields().begin(),
-                       projection->getRequiredFields().end()};
+    invariant(projection->isSimpleIgnoringDottedPaths());
+    for (auto&& path : projection->getRequiredFields()) {
+        FieldRef fieldRef{path};
+        auto* node = &_includedFields;
+        for (size_t i = 0; i < fieldRef.numParts(); ++i) {
+            auto& child = node->children[fieldRef.getPart(i).toString()];
+            if (!child) {
+                child = std::make_unique<FieldNode>();
+            }
+            node = child.get();
+        }
+    }
 }
 
 Status ProjectionStageSimple::transform(WorkingSetMember* member) const {
@@ -305,22 +365,55 @@ Status ProjectionStageSimple::transform(WorkingSetMember* member) const {
     invariant(member->hasObj());
 
     // Apply the SIMPLE_DOC projection.
+    projectObject(_includedFields, member->doc.value().toBson(), &bob);
+
+    transitionMemberToOwnedObj(bob.obj(), member);
+    return Status::OK();
+}
+
+void ProjectionStageSimple::projectObject(const FieldNode& node,
+                                          const BSONObj& obj,
+                                          BSONObjBuilder* bob) {
     // Look at every field in the source document and see if we're including it.
-    auto objToProject = member->doc.value().toBson();
-    auto nFieldsNeeded = _includedFields.size();
-    for (auto&& elt : objToProject) {
+    auto nFieldsNeeded = node.children.size();
+    for (auto&& elt : obj) {
         auto fieldName{elt.fieldNameStringData()};
         absl::string_view fieldNameKey{fieldName.rawData(), fieldName.size()};
-        if (auto fieldIt = _includedFields.find(fieldNameKey); _includedFields.end() != fieldIt) {
-            bob.append(elt);
-            if (--nFieldsNeeded == 0) {
-                break;
-            }
+        auto childIt = node.children.find(fieldNameKey);
+        if (node.children.end() == childIt) {
+            continue;
+        }
+
+        const auto& child = *childIt->second;
+        if (child.children.empty()) {
+            bob->append(elt);
+        } else if (elt.type() == BSONType::Object) {
+            BSONObjBuilder subBob{bob->subobjStart(fieldName)};
+            projectObject(child, elt.embeddedObject(), &subBob);
+        } else if (elt.type() == BSONType::Array) {
+            BSONArrayBuilder subBab{bob->subarrayStart(fieldName)};
+            projectArray(child, elt.embeddedObject(), &subBab);
+        }
+        // Otherwise this is a dotted path through a scalar, so there is nothing to include.
+
+        if (--nFieldsNeeded == 0) {
+            break;
         }
     }
+}
 
-    transitionMemberToOwnedObj(bob.obj(), member);
-    return Status::OK();
+void ProjectionStageSimple::projectArray(const FieldNode& node,
+                                         const BSONObj& arr,
+                                         BSONArrayBuilder* bab) {
+    for (auto&& elt : arr) {
+        if (elt.type() == BSONType::Object) {
+            BSONObjBuilder subBob{bab->subobjStart()};
+            projectObject(node, elt.embeddedObject(), &subBob);
+        } else if (elt.type() == BSONType::Array) {
+            BSONArrayBuilder subBab{bab->subarrayStart()};
+            projectArray(node, elt.embeddedObject(), &subBab);
+        }
+    }
 }
 
 }  // namespace mongo
@@ -29,12 +29,15 @@
 
 #pragma once
 
+#include <memory>
+
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/exec/projection_executor.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/query/projection_ast.h"
 #include "mongo/db/record_id.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 /**
@@ -60,6 +63,10 @@ public:
     }
 
 protected:
+    StageState doWorkBatch(size_t maxWorks,
+                           std::vector<WorkingSetID>* results,
+                           WorkingSetID* out) final;
+
     using FieldSet = StringSet;
 
     // The raw BSON projection used to populate projection stats. Optional, since it is required
@@ -148,8 +155,10 @@ private:
 
 /**
  * This class is used when we expect an object and the following rules are met: the projection
- * consists only of inclusions e.g. '{field: 1}', it has no $meta projections, it is not a returnKey
- * projection and it has no dotted fields.
+ * consists only of inclusions e.g. '{field: 1}' or '{"a.b": 1}', it has no $meta projections and it
+ * is not a returnKey projection. The projection is applied directly to the BSON of the fetched
+ * document, which usually still points into storage engine memory, so a wide document is never
+ * materialized in full.
  */
 class ProjectionStageSimple final : public ProjectionStage {
 public:
@@ -167,10 +176,29 @@ public:
     }
 
 private:
+    /**
+     * A node in the tree of the paths included by the projection, holding the next component of
+     * each path below it. A node without children includes the whole field.
+     */
+    struct FieldNode {
+        stdx::unordered_map<std::string, std::unique_ptr<FieldNode>> children;
+    };
+
     Status transform(WorkingSetMember* member) const final;
 
-    // Has the field names present in the simple projection.
-    stdx::unordered_set<std::string> _includedFields;
+    /**
+     * Appends the fields of 'obj' included by 'node' to 'bob', in the order they appear in 'obj'.
+     */
+    static void projectObject(const FieldNode& node, const BSONObj& obj, BSONObjBuilder* bob);
+
+    /**
+     * Appends each object or nested array in 'arr', projected by 'node', to 'bab'. Any other
+     * element has no subfields to include, so it is dropped.
+     */
+    static void projectArray(const FieldNode& node, const BSONObj& arr, BSONArrayBuilder* bab);
+
+    // The paths present in the simple projection.
+    FieldNode _includedFields;
 };
 
 }  // namespace mongo
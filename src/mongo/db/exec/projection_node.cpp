@@ -176,6 +176,9 @@ void ProjectionNode::outputProjectedField(StringData field, Value val, MutableDo
 }
 
 void ProjectionNode::applyExpressions(const Document& root, MutableDocument* outputDoc) const {
+    // Every computed field or child may add a field, so make room for them all up front rather
+    // than growing the document's storage repeatedly as they are set.
+    outputDoc->reserveAdditionalFields(_orderToProcessAdditionsAndChildren.size());
     for (auto&& field : _orderToProcessAdditionsAndChildren) {
         auto childIt = _children.find(field);
         if (childIt != _children.end()) {
@@ -123,4 +123,64 @@ TEST_F(QueuedDataStageTest, validateStats) {
     unique_ptr<PlanStageStats> allStats(mock->getStats());
     ASSERT_TRUE(stats->isEOF);
 }
+
+//
+// Test that a batch of work stops at the first state which is neither ADVANCED nor NEED_TIME, and
+// that the results produced before it are still returned.
+//
+TEST_F(QueuedDataStageTest, workBatchStopsAtNeedYield) {
+    WorkingSet ws;
+    WorkingSetID wsID;
+    auto mock = std::make_unique<QueuedDataStage>(getOpCtx(), &ws);
+
+    WorkingSetID first = ws.allocate();
+    WorkingSetID second = ws.allocate();
+    WorkingSetID third = ws.allocate();
+    mock->pushBack(first);
+    mock->pushBack(PlanStage::NEED_TIME);
+    mock->pushBack(second);
+    mock->pushBack(PlanStage::NEED_YIELD);
+    mock->pushBack(third);
+
+    std::vector<WorkingSetID> results;
+    ASSERT_EQUALS(PlanStage::NEED_YIELD, mock->workBatch(10, &results, &wsID));
+    ASSERT_EQUALS(2U, results.size());
+    ASSERT_EQUALS(first, results[0]);
+    ASSERT_EQUALS(second, results[1]);
+
+    const CommonStats* stats = mock->getCommonStats();
+    ASSERT_EQUALS(stats->works, 4U);
+    ASSERT_EQUALS(stats->advanced, 2U);
+    ASSERT_EQUALS(stats->needTime, 1U);
+    ASSERT_EQUALS(stats->needYield, 1U);
+
+    results.clear();
+    ASSERT_EQUALS(PlanStage::IS_EOF, mock->workBatch(10, &results, &wsID));
+    ASSERT_EQUALS(1U, results.size());
+    ASSERT_EQUALS(third, results[0]);
+    ASSERT_EQUALS(stats->works, 6U);
+}
+
+//
+// Test that a batch of work never does more than the requested number of units of work.
+//
+TEST_F(QueuedDataStageTest, workBatchRespectsMaxWorks) {
+    WorkingSet ws;
+    WorkingSetID wsID;
+    auto mock = std::make_unique<QueuedDataStage>(getOpCtx(), &ws);
+
+    mock->pushBack(PlanStage::NEED_TIME);
+    mock->pushBack(PlanStage::NEED_TIME);
+    WorkingSetID id = ws.allocate();
+    mock->pushBack(id);
+
+    std::vector<WorkingSetID> results;
+    ASSERT_EQUALS(PlanStage::NEED_TIME, mock->workBatch(2, &results, &wsID));
+    ASSERT_TRUE(results.empty());
+    ASSERT_EQUALS(mock->getCommonStats()->works, 2U);
+
+    ASSERT_EQUALS(PlanStage::ADVANCED, mock->workBatch(1, &results, &wsID));
+    ASSERT_EQUALS(1U, results.size());
+    ASSERT_EQUALS(id, results[0]);
+}
 }  // namespace
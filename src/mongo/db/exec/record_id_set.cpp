@@ -0,0 +1,92 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_set.h"
+
+#include <algorithm>
+
+namespace mongo {
+
+namespace {
+// Approximate per-chunk overhead of the hash table node holding it.
+constexpr uint64_t kChunkOverheadBytes = 64;
+}  // namespace
+
+bool RecordIdSet::insert(const RecordId& rid) {
+    const uint64_t repr = static_cast<uint64_t>(rid.repr());
+    const int64_t key = static_cast<int64_t>(repr >> 16);
+    const uint16_t low = static_cast<uint16_t>(repr & 0xFFFF);
+
+    auto [it, isNewChunk] = _chunks.try_emplace(key);
+    Chunk& chunk = it->second;
+    if (isNewChunk) {
+        _memUsage += kChunkOverheadBytes;
+    }
+
+    if (chunk.bitmap) {
+        uint64_t& word = (*chunk.bitmap)[low / 64];
+        const uint64_t bit = uint64_t{1} << (low % 64);
+        if (word & bit) {
+            return false;
+        }
+        word |= bit;
+        ++_size;
+        return true;
+    }
+
+    auto pos = std::lower_bound(chunk.array.begin(), chunk.array.end(), low);
+    if (pos != chunk.array.end() && *pos == low) {
+        return false;
+    }
+
+    if (chunk.array.size() + 1 < kMaxArrayChunkSize) {
+        const auto oldCapacity = chunk.array.capacity();
+        chunk.array.insert(pos, low);
+        _memUsage += (chunk.array.capacity() - oldCapacity) * sizeof(uint16_t);
+    } else {
+        // Convert the chunk to a bitmap.
+        auto bitmap = std::make_unique<Bitmap>();
+        bitmap->fill(0);
+        for (auto value : chunk.array) {
+            (*bitmap)[value / 64] |= uint64_t{1} << (value % 64);
+        }
+        (*bitmap)[low / 64] |= uint64_t{1} << (low % 64);
+
+        _memUsage -= chunk.array.capacity() * sizeof(uint16_t);
+        _memUsage += sizeof(Bitmap);
+        chunk.array = std::vector<uint16_t>();
+        chunk.bitmap = std::move(bitmap);
+    }
+    ++_size;
+    return true;
+}
+
+}  // namespace mongo
@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/record_id.h"
+#include "mongo/util/flat_hash_map.h"
+
+namespace mongo {
+
+/**
+ * A set of RecordIds used by plan stages to drop RecordIds they have already returned, for
+ * instance when scanning a multikey index. RecordIds are split into their upper 48 bits, which
+ * select a chunk of 2^16 consecutive RecordIds, and their lower 16 bits, which are kept in the
+ * chunk. A chunk is a sorted array of 16-bit values while it is sparse and is converted to a
+ * bitmap once it is dense, as in a roaring bitmap. Since record stores allocate RecordIds mostly
+ * sequentially, this takes a few bytes per RecordId, rather than the tens of bytes per entry of a
+ * hash set.
+ */
+class RecordIdSet {
+public:
+    /**
+     * Adds 'rid' to the set. Returns true if 'rid' was not already in the set.
+     */
+    bool insert(const RecordId& rid);
+
+    /**
+     * Returns the number of RecordIds in the set.
+     */
+    size_t size() const {
+        return _size;
+    }
+
+    /**
+     * Returns an estimate of the memory used by the set, in bytes.
+     */
+    uint64_t getMemUsage() const {
+        return _memUsage;
+    }
+
+private:
+    // A chunk holding at least this many values is stored as a bitmap instead of an array, at
+    // which point the bitmap is no larger than the array.
+    static constexpr size_t kMaxArrayChunkSize = 4096;
+    static constexpr size_t kBitmapWords = (1 << 16) / 64;
+
+    using Bitmap = std::array<uint64_t, kBitmapWords>;
+
+    struct Chunk {
+        // Used while 'bitmap' is null. Kept sorted.
+        std::vector<uint16_t> array;
+        std::unique_ptr<Bitmap> bitmap;
+    };
+
+    FlatHashMap<int64_t, Chunk> _chunks;
+    size_t _size = 0;
+    uint64_t _memUsage = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,84 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_set.h"
+
+#include "mongo/platform/random.h"
+#include "mongo/stdx/unordered_set.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(RecordIdSetTest, InsertReportsDuplicates) {
+    RecordIdSet set;
+    ASSERT_TRUE(set.insert(RecordId(1)));
+    ASSERT_TRUE(set.insert(RecordId(2)));
+    ASSERT_FALSE(set.insert(RecordId(1)));
+    ASSERT_TRUE(set.insert(RecordId(1 << 16 | 1)));
+    ASSERT_FALSE(set.insert(RecordId(2)));
+    ASSERT_EQ(set.size(), 3U);
+}
+
+TEST(RecordIdSetTest, HandlesNegativeAndExtremeRecordIds) {
+    RecordIdSet set;
+    for (auto rid : {RecordId::min(), RecordId(-1), RecordId(0), RecordId::max()}) {
+        ASSERT_TRUE(set.insert(rid));
+    }
+    for (auto rid : {RecordId::min(), RecordId(-1), RecordId(0), RecordId::max()}) {
+        ASSERT_FALSE(set.insert(rid));
+    }
+    ASSERT_EQ(set.size(), 4U);
+}
+
+TEST(RecordIdSetTest, DenseChunksMatchHashSet) {
+    RecordIdSet set;
+    stdx::unordered_set<RecordId, RecordId::Hasher> expected;
+    PseudoRandom random(1234);
+    for (int i = 0; i < 200000; ++i) {
+        RecordId rid(1 + random.nextInt32(100000));
+        ASSERT_EQ(set.insert(rid), expected.insert(rid).second);
+    }
+    ASSERT_EQ(set.size(), expected.size());
+}
+
+TEST(RecordIdSetTest, SequentialRecordIdsUseLittleMemory) {
+    RecordIdSet set;
+    const int kNumRecordIds = 1000000;
+    for (int i = 1; i <= kNumRecordIds; ++i) {
+        ASSERT_TRUE(set.insert(RecordId(i)));
+    }
+    // Dense chunks take one bit per possible RecordId.
+    ASSERT_LTE(set.getMemUsage(), uint64_t{kNumRecordIds});
+}
+
+}  // namespace
+}  // namespace mongo
@@ -126,7 +126,8 @@ PlanStage::StageState SortStageDefault::unspool(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
-    auto&& [key, nextWsm] = _sortExecutor.getNext();
+    Value key;
+    auto nextWsm = _sortExecutor.getNext(_addSortKeyMetadata ? &key : nullptr);
     *out = _ws->emplace(nextWsm.extract());
 
     if (_addSortKeyMetadata) {
@@ -168,7 +169,8 @@ PlanStage::StageState SortStageSimple::unspool(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
-    auto&& [key, nextObj] = _sortExecutor.getNext();
+    Value key;
+    auto nextObj = _sortExecutor.getNext(_addSortKeyMetadata ? &key : nullptr);
 
     *out = _ws->allocate();
     auto member = _ws->get(*out);
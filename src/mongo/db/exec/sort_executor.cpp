@@ -31,7 +31,6 @@
 
 #include "mongo/db/exec/sort_executor.h"
 
-#include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/exec/working_set.h"
 
 namespace mongo {
@@ -54,10 +53,12 @@ std::string nextFileName() {
 
 #include "mongo/db/sorter/sorter.cpp"
 
-MONGO_CREATE_SORTER(mongo::Value,
+MONGO_CREATE_SORTER(mongo::KeyString::Value,
                     mongo::Document,
                     mongo::SortExecutor<mongo::Document>::Comparator);
-MONGO_CREATE_SORTER(mongo::Value,
+MONGO_CREATE_SORTER(mongo::KeyString::Value,
                     mongo::SortableWorkingSetMember,
                     mongo::SortExecutor<mongo::SortableWorkingSetMember>::Comparator);
-MONGO_CREATE_SORTER(mongo::Value, mongo::BSONObj, mongo::SortExecutor<mongo::BSONObj>::Comparator);
+MONGO_CREATE_SORTER(mongo::KeyString::Value,
+                    mongo::BSONObj,
+                    mongo::SortExecutor<mongo::BSONObj>::Comparator);
@@ -29,13 +29,15 @@
 
 #pragma once
 
+#include "mongo/bson/ordering.h"
 #include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/document_metadata_fields.h"
 #include "mongo/db/exec/plan_stats.h"
-#include "mongo/db/exec/sort_key_comparator.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/sorter/sorter.h"
+#include "mongo/db/storage/key_string.h"
 
 namespace mongo {
 /**
@@ -45,23 +47,21 @@ namespace mongo {
  * called to return the documents one by one in sorted order.
  *
  * The template parameter is the type of data being sorted. In DocumentSource execution, we sort
- * Document objects directly, but in the PlanStage layer we may sort WorkingSetMembers. The type of
- * the sort key, on the other hand, is always Value.
+ * Document objects directly, but in the PlanStage layer we may sort WorkingSetMembers. Callers
+ * provide and receive sort keys as Values, but the sorter holds each one as a KeyString with the
+ * directions of the sort pattern applied, so that sorting, merging spilled runs and applying a
+ * limit compare keys with memcmp. Sort keys are already collation comparison keys.
  */
 template <typename T>
 class SortExecutor {
 public:
-    using DocumentSorter = Sorter<Value, T>;
+    using DocumentSorter = Sorter<KeyString::Value, T>;
     class Comparator {
     public:
-        Comparator(const SortPattern& sortPattern) : _sortKeyComparator(sortPattern) {}
         int operator()(const typename DocumentSorter::Data& lhs,
                        const typename DocumentSorter::Data& rhs) const {
-            return _sortKeyComparator(lhs.first, rhs.first);
+            return lhs.first.compare(rhs.first);
         }
-
-    private:
-        SortKeyComparator _sortKeyComparator;
     };
 
     /**
@@ -73,6 +73,7 @@ public:
                  std::string tempDir,
                  bool allowDiskUse)
         : _sortPattern(std::move(sortPattern)),
+          _ordering(makeOrdering(_sortPattern)),
           _tempDir(std::move(tempDir)),
           _diskUseAllowed(allowDiskUse) {
         _stats.sortPattern =
@@ -124,9 +125,14 @@ public:
      */
     void add(const Value& sortKey, const T& data) {
         if (!_sorter) {
-            _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
+            _sorter.reset(makeSorter());
         }
-        _sorter->add(sortKey, data);
+        KeyString::Builder keyString(
+            kKeyStringVersion,
+            DocumentMetadataFields::serializeSortKeyAsObject(_sortPattern.isSingleElementKey(),
+                                                             sortKey),
+            _ordering);
+        _sorter->add(keyString.getValueCopy(), data);
 
         _stats.totalDataSizeBytes += data.memUsageForSorter();
     }
@@ -137,7 +143,7 @@ public:
     void loadingDone() {
         // This conditional should only pass if no documents were added to the sorter.
         if (!_sorter) {
-            _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
+            _sorter.reset(makeSorter());
         }
         _output.reset(_sorter->done());
         _stats.wasDiskUsed = _stats.wasDiskUsed || _sorter->usedDisk();
@@ -163,15 +169,37 @@ public:
     }
 
     /**
-     * Returns the next data item in the sorted stream, which is a pair consisting of the sort key
-     * and the corresponding item being sorted. Illegal to call if there is no next item;
-     * end-of-stream must be detected with 'hasNext()'.
+     * Returns the next data item in the sorted stream. If 'sortKey' is not null, it is set to the
+     * item's sort key, which is decoded from its KeyString only when asked for. Illegal to call if
+     * there is no next item; end-of-stream must be detected with 'hasNext()'.
      */
-    std::pair<Value, T> getNext() {
-        return _output->next();
+    T getNext(Value* sortKey = nullptr) {
+        auto next = _output->next();
+        if (sortKey) {
+            *sortKey = DocumentMetadataFields::deserializeSortKey(
+                _sortPattern.isSingleElementKey(), KeyString::toBson(next.first, _ordering));
+        }
+        return std::move(next.second);
     }
 
 private:
+    static constexpr KeyString::Version kKeyStringVersion = KeyString::Version::kLatestVersion;
+
+    static Ordering makeOrdering(const SortPattern& sortPattern) {
+        BSONObjBuilder directions;
+        for (auto&& part : sortPattern) {
+            directions.append("", part.isAscending ? 1 : -1);
+        }
+        return Ordering::make(directions.done());
+    }
+
+    DocumentSorter* makeSorter() const {
+        return DocumentSorter::make(
+            makeSortOptions(),
+            Comparator(),
+            {KeyString::Value::SorterDeserializeSettings(kKeyStringVersion), {}});
+    }
+
     SortOptions makeSortOptions() const {
         SortOptions opts;
         if (_stats.limit) {
@@ -188,6 +216,7 @@ private:
     }
 
     const SortPattern _sortPattern;
+    const Ordering _ordering;
     const std::string _tempDir;
     const bool _diskUseAllowed;
 
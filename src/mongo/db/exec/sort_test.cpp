@@ -36,6 +36,7 @@
 #include <boost/optional.hpp>
 #include <memory>
 
+#include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/exec/queued_data_stage.h"
 #include "mongo/db/json.h"
 #include "mongo/db/operation_context.h"
@@ -304,4 +305,41 @@ TEST_F(SortStageDefaultTest, SortDescendingWithCollation) {
              "{input: [{a: 'ba'}, {a: 'aa'}, {a: 'ab'}]}",
              "{output: [{a: 'ab'}, {a: 'ba'}, {a: 'aa'}]}");
 }
+
+TEST_F(SortStageDefaultTest, SortCompoundWithMixedDirectionsAndTypes) {
+    testWork("{a: 1, b: -1}",
+             nullptr,
+             0,
+             "{input: [{a: 2, b: 1}, {a: 1.5, b: 1}, {a: 1, b: 'z'}, {a: 1, b: 5}, {b: 3}, "
+             "{a: null, b: 4}]}",
+             "{output: [{a: null, b: 4}, {b: 3}, {a: 1, b: 'z'}, {a: 1, b: 5}, {a: 1.5, b: 1}, "
+             "{a: 2, b: 1}]}");
+}
+
+TEST_F(SortStageDefaultTest, SortExecutorReturnsTheSortKeysItWasGiven) {
+    auto expCtx = make_intrusive<ExpressionContext>(getOpCtx(), nullptr, NamespaceString("foo"));
+    SortExecutor<BSONObj> executor(
+        SortPattern{fromjson("{a: 1, b: -1}"), expCtx}, 0, kMaxMemoryUsageBytes, "", false);
+
+    const std::vector<Value> keys = {
+        Value(std::vector<Value>{Value(2), Value("x"_sd)}),
+        Value(std::vector<Value>{Value(1LL), Value(3.5)}),
+        Value(std::vector<Value>{Value(1LL), Value(Document{{"c", 1}})}),
+    };
+    for (size_t i = 0; i < keys.size(); ++i) {
+        executor.add(keys[i], BSON("i" << static_cast<int>(i)));
+    }
+    executor.loadingDone();
+
+    // Objects sort after numbers, so the descending 'b' puts the object first.
+    for (size_t expected : {2, 1, 0}) {
+        ASSERT_TRUE(executor.hasNext());
+        Value key;
+        auto obj = executor.getNext(&key);
+        ASSERT_EQ(obj["i"].numberInt(), static_cast<int>(expected));
+        ASSERT_VALUE_EQ(key, keys[expected]);
+        ASSERT_EQ(key[0].getType(), keys[expected][0].getType());
+    }
+    ASSERT_FALSE(executor.hasNext());
+}
 }  // namespace
@@ -126,6 +126,17 @@ unique_ptr<PlanStage> TextStage::buildTextTree(OperationContext* opCtx,
 
         textScorer->addChildren(std::move(indexScanList));
 
+        // Stopping early is only safe if every document scored by the TEXT_OR stage is returned
+        // by the TEXT_MATCH stage, that is, if the latter has no negations, phrases or positive
+        // term checks to apply.
+        const auto& query = _params.query;
+        if (_params.topK && query.getNegatedTerms().empty() && query.getPositivePhr().empty() &&
+            query.getNegatedPhr().empty() && !query.getCaseSensitive() &&
+            !query.getDiacriticSensitive()) {
+            const auto& terms = query.getTermsForBounds();
+            textScorer->setTopK(_params.topK, std::vector<std::string>(terms.begin(), terms.end()));
+        }
+
         textMatchStage = std::make_unique<TextMatchStage>(
             opCtx, std::move(textScorer), _params.query, _params.spec, ws);
     } else {
@@ -64,6 +64,10 @@ struct TextStageParams {
     // True if we need the text score in the output, because the projection includes the 'textScore'
     // metadata field.
     bool wantTextScore = true;
+
+    // If non-zero, only the 'topK' highest-scoring documents must be returned; see
+    // TextOrStage::setTopK().
+    size_t topK = 0;
 };
 
 /**
@@ -29,6 +29,8 @@
 
 #include "mongo/db/exec/text_or.h"
 
+#include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <vector>
@@ -39,6 +41,7 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/record_id.h"
 
@@ -74,6 +77,16 @@ void TextOrStage::addChildren(Children childrenToAdd) {
                      std::make_move_iterator(childrenToAdd.end()));
 }
 
+void TextOrStage::setTopK(size_t k, std::vector<std::string> terms) {
+    invariant(k > 0);
+    invariant(terms.size() == _children.size());
+    invariant(_internalState == State::kInit);
+    _topK = k;
+    _topKTerms = std::move(terms);
+    _childBounds.assign(_children.size(), std::numeric_limits<double>::infinity());
+    _childEOF.assign(_children.size(), false);
+}
+
 bool TextOrStage::isEOF() {
     return _internalState == State::kDone;
 }
@@ -182,20 +195,43 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     }
 
     if (PlanStage::ADVANCED == childState) {
-        return addTerm(id, out);
+        if (!_topK) {
+            return addTerm(id, out);
+        }
+
+        // In top-k mode the children are read round-robin so that all of their bounds drop
+        // together. A yield retries the same key, so it must stay on the same child.
+        StageState stageState = addTerm(id, out);
+        if (PlanStage::NEED_YIELD != stageState) {
+            if (topKSatisfied()) {
+                startReturningResults();
+            } else {
+                advanceToNextChild();
+            }
+        }
+        return stageState;
     } else if (PlanStage::IS_EOF == childState) {
         // Done with this child.
-        ++_currentChild;
+        if (_topK) {
+            _childBounds[_currentChild] = 0;
+            _childEOF[_currentChild] = true;
+            ++_numChildrenEOF;
+
+            if (_numChildrenEOF < _children.size() && !topKSatisfied()) {
+                advanceToNextChild();
+                return PlanStage::NEED_TIME;
+            }
+        } else {
+            ++_currentChild;
 
-        if (_currentChild < _children.size()) {
-            // We have another child to read from.
-            return PlanStage::NEED_TIME;
+            if (_currentChild < _children.size()) {
+                // We have another child to read from.
+                return PlanStage::NEED_TIME;
+            }
         }
 
         // If we're here we are done reading results.  Move to the next state.
-        _scoreIterator = _scores.begin();
-        _internalState = State::kReturningResults;
-
+        startReturningResults();
         return PlanStage::NEED_TIME;
     } else if (PlanStage::FAILURE == childState) {
         // If a stage fails, it may create a status WSM to indicate why it
@@ -217,6 +253,30 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     }
 }
 
+void TextOrStage::advanceToNextChild() {
+    invariant(_numChildrenEOF < _children.size());
+    do {
+        _currentChild = (_currentChild + 1) % _children.size();
+    } while (_childEOF[_currentChild]);
+}
+
+bool TextOrStage::topKSatisfied() const {
+    if (_topKScores.size() < _topK) {
+        return false;
+    }
+
+    double unseenBound = 0;
+    for (double bound : _childBounds) {
+        unseenBound += bound;
+    }
+    return _topKScores.top() >= unseenBound;
+}
+
+void TextOrStage::startReturningResults() {
+    _scoreIterator = _scores.begin();
+    _internalState = State::kReturningResults;
+}
+
 PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
     if (_scoreIterator == _scores.end()) {
         _internalState = State::kDone;
@@ -248,6 +308,21 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
     const IndexKeyDatum newKeyData = wsm->keyData.back();  // copy to keep it around.
     TextRecordData* textRecordData = &_scores[wsm->recordId];
 
+    // Locate score within possibly compound key: {prefix,term,score,suffix}.
+    BSONObjIterator keyIt(newKeyData.keyData);
+    for (unsigned i = 0; i < _ftsSpec.numExtraBefore(); i++) {
+        keyIt.next();
+    }
+
+    keyIt.next();  // Skip past 'term'.
+
+    BSONElement scoreElement = keyIt.next();
+    double documentTermScore = scoreElement.number();
+
+    if (_topK) {
+        _childBounds[_currentChild] = documentTermScore;
+    }
+
     if (textRecordData->score < 0) {
         // We have already rejected this document for not matching the filter.
         invariant(WorkingSet::INVALID_ID == textRecordData->wsid);
@@ -286,6 +361,25 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
 
         // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
         wsm->makeObjOwnedIfNeeded();
+
+        if (_topK) {
+            // Score the whole document now, so that its keys under the other children need not be
+            // read. These are the same per-term scores the index keys were built from.
+            fts::TermFrequencyMap termScores;
+            _ftsSpec.scoreDocument(wsm->doc.value().toBson(), &termScores);
+            for (const auto& term : _topKTerms) {
+                auto it = termScores.find(term);
+                if (it != termScores.end()) {
+                    textRecordData->score += it->second;
+                }
+            }
+
+            _topKScores.push(textRecordData->score);
+            if (_topKScores.size() > _topK) {
+                _topKScores.pop();
+            }
+            return NEED_TIME;
+        }
     } else {
         // We already have a working set member for this RecordId. Free the new WSM and retrieve the
         // old one. Note that since we don't keep all index keys, we could get a score that doesn't
@@ -293,20 +387,13 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
         // TODO something to improve the situation.
         invariant(wsid != textRecordData->wsid);
         _ws->free(wsid);
-        wsm = _ws->get(textRecordData->wsid);
-    }
 
-    // Locate score within possibly compound key: {prefix,term,score,suffix}.
-    BSONObjIterator keyIt(newKeyData.keyData);
-    for (unsigned i = 0; i < _ftsSpec.numExtraBefore(); i++) {
-        keyIt.next();
+        if (_topK) {
+            // The document was given its exact score when it was first seen.
+            return NEED_TIME;
+        }
     }
 
-    keyIt.next();  // Skip past 'term'.
-
-    BSONElement scoreElement = keyIt.next();
-    double documentTermScore = scoreElement.number();
-
     // Aggregate relevance score, term keys.
     textRecordData->score += documentTermScore;
     return NEED_TIME;
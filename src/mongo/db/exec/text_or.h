@@ -30,11 +30,15 @@
 #pragma once
 
 #include <memory>
+#include <queue>
+#include <string>
+#include <vector>
 
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
+#include "mongo/util/flat_hash_map.h"
 
 namespace mongo {
 
@@ -77,6 +81,15 @@ public:
 
     void addChildren(Children childrenToAdd);
 
+    /**
+     * Only the 'k' highest-scoring documents are needed; the remaining results may be any subset
+     * of the matching documents. 'terms' lists the term scanned by each child, in child order,
+     * and every child must return that term's keys in descending score order. Once the 'k' best
+     * exact scores seen so far can no longer be beaten by the sum of the scores under each
+     * child's cursor, the remaining keys are not read. Must be called before the first work().
+     */
+    void setTopK(size_t k, std::vector<std::string> terms);
+
     bool isEOF() final;
 
     StageState doWork(WorkingSetID* out) final;
@@ -118,6 +131,18 @@ private:
      */
     StageState addTerm(WorkingSetID wsid, WorkingSetID* out);
 
+    /**
+     * Helpers for top-k mode. Moves '_currentChild' to the next child that has not hit EOF, and
+     * returns whether no unseen document can score higher than the k-th best score seen so far.
+     */
+    void advanceToNextChild();
+    bool topKSatisfied() const;
+
+    /**
+     * Stops reading from the children and starts returning the scored documents.
+     */
+    void startReturningResults();
+
     /**
      * Worker for kReturningResults. Returns a wsm with RecordID and Score.
      */
@@ -146,12 +171,21 @@ private:
         double score;
     };
 
-    typedef stdx::unordered_map<RecordId, TextRecordData, RecordId::Hasher> ScoreMap;
+    typedef FlatHashMap<RecordId, TextRecordData, RecordId::Hasher> ScoreMap;
     ScoreMap _scores;
     ScoreMap::const_iterator _scoreIterator;
 
     TextOrStats _specificStats;
 
+    // Top-k mode, enabled by setTopK(). '_childBounds' holds the score of the last key read from
+    // each child, which bounds the score of every key that child has yet to return.
+    size_t _topK = 0;
+    std::vector<std::string> _topKTerms;
+    std::vector<double> _childBounds;
+    std::vector<bool> _childEOF;
+    size_t _numChildrenEOF = 0;
+    std::priority_queue<double, std::vector<double>, std::greater<double>> _topKScores;
+
     // Members needed only for using the TextMatchableDocument.
     const MatchExpression* _filter;
     WorkingSetID _idRetrying;
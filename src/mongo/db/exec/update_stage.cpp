@@ -280,7 +280,14 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
 
                 WriteUnitOfWork wunit(getOpCtx());
                 StatusWith<RecordData> newRecStatus = collection()->updateDocumentWithDamages(
-                    getOpCtx(), recordId, std::move(snap), source, _damages, &args);
+                    getOpCtx(),
+                    recordId,
+                    std::move(snap),
+                    source,
+                    _damages,
+                    driver->modsAffectIndices(),
+                    _params.opDebug,
+                    &args);
                 invariant(oldObj.snapshotId() == getOpCtx()->recoveryUnit()->getSnapshotId());
                 wunit.commit();
 
@@ -29,6 +29,8 @@
 
 #include "mongo/db/exec/working_set.h"
 
+#include <type_traits>
+
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/service_context.h"
@@ -39,39 +41,42 @@ using std::string;
 
 namespace dps = ::mongo::dotted_path_support;
 
+// Growing the working set relocates its members, which must then be moved rather than copied.
+static_assert(std::is_nothrow_move_constructible<WorkingSetMember>::value);
+
 WorkingSet::WorkingSet() : _freeList(INVALID_ID) {}
 
 WorkingSetID WorkingSet::allocate() {
     if (_freeList == INVALID_ID) {
         // The free list is empty so we need to make a single new WSM to return. This relies on
-        // vector::resize being amortized O(1) for efficient allocation. Note that the free list
-        // remains empty until something is returned by a call to free().
-        WorkingSetID id = _data.size();
-        _data.resize(_data.size() + 1);
-        _data.back().nextFreeOrSelf = id;
+        // vector::emplace_back being amortized O(1) for efficient allocation. Note that the free
+        // list remains empty until something is returned by a call to free().
+        WorkingSetID id = _members.size();
+        _members.emplace_back();
+        _nextFreeOrSelf.push_back(id);
         return id;
     }
 
     // Pop the head off the free list and return it.
     WorkingSetID id = _freeList;
-    _freeList = _data[id].nextFreeOrSelf;
-    _data[id].nextFreeOrSelf = id;  // set to self to mark as in-use
+    _freeList = _nextFreeOrSelf[id];
+    _nextFreeOrSelf[id] = id;  // set to self to mark as in-use
     return id;
 }
 
 void WorkingSet::free(WorkingSetID i) {
-    MemberHolder& holder = _data[i];
-    verify(i < _data.size());            // ID has been allocated.
-    verify(holder.nextFreeOrSelf == i);  // ID currently in use.
+    verify(i < _members.size());      // ID has been allocated.
+    verify(_nextFreeOrSelf[i] == i);  // ID currently in use.
 
     // Free resources and push this WSM to the head of the freelist.
-    holder.member.clear();
-    holder.nextFreeOrSelf = _freeList;
+    _members[i].clear();
+    _nextFreeOrSelf[i] = _freeList;
     _freeList = i;
 }
 
 void WorkingSet::clear() {
-    _data.clear();
+    _members.clear();
+    _nextFreeOrSelf.clear();
 
     // Since working set is now empty, the free list pointer should
     // point to nothing.
@@ -94,8 +99,8 @@ void WorkingSet::transitionToOwnedObj(WorkingSetID id) {
 }
 
 WorkingSetMember WorkingSet::extract(WorkingSetID wsid) {
-    invariant(wsid < _data.size());
-    WorkingSetMember ret = std::move(_data[wsid].member);
+    invariant(wsid < _members.size());
+    WorkingSetMember ret = std::move(_members[wsid]);
     free(wsid);
     return ret;
 }
@@ -111,7 +116,10 @@ WorkingSetID WorkingSet::emplace(WorkingSetMember&& wsm) {
 //
 
 void WorkingSetMember::clear() {
-    _metadata = DocumentMetadataFields{};
+    // Most members never carry metadata, so don't pay for resetting it.
+    if (_metadata) {
+        _metadata = DocumentMetadataFields{};
+    }
     keyData.clear();
     if (doc.value().hasExclusivelyOwnedStorage()) {
         // Reset the document to point to an empty BSON, which will preserve its underlying
@@ -134,6 +142,10 @@ void WorkingSetMember::transitionToOwnedObj() {
     _state = OWNED_OBJ;
 }
 
+void WorkingSetMember::transitionToComputedObj() {
+    _state = OWNED_OBJ;
+}
+
 void WorkingSetMember::transitionToRecordIdAndObj() {
     _state = WorkingSetMember::RID_AND_OBJ;
 }
@@ -151,7 +163,7 @@ bool WorkingSetMember::hasOwnedObj() const {
 }
 
 void WorkingSetMember::makeObjOwnedIfNeeded() {
-    if (_state == RID_AND_OBJ && !doc.value().isOwned()) {
+    if (hasObj() && !doc.value().isOwned()) {
         doc.value() = doc.value().getOwned();
     }
 }
@@ -124,8 +124,9 @@ public:
         RID_AND_OBJ,
 
         // The WSM doesn't correspond to an on-disk document anymore (e.g. is a computed
-        // expression). Since it doesn't correspond to a stored document, a WSM in this state has an
-        // owned BSONObj, but no record id.
+        // expression). Since it doesn't correspond to a stored document, a WSM in this state has no
+        // record id. Its BSONObj is owned, unless it entered this state through
+        // transitionToComputedObj().
         OWNED_OBJ,
     };
 
@@ -146,6 +147,14 @@ public:
 
     void transitionToOwnedObj();
 
+    /**
+     * Transitions to the OWNED_OBJ state with a computed document which may still point into the
+     * unowned storage engine data it was computed from, such as the output of an exclusion
+     * projection. The copy which would make it owned is left to makeObjOwnedIfNeeded(), so it is
+     * only paid for if the member has to survive a yield.
+     */
+    void transitionToComputedObj();
+
     //
     // Core attributes
     //
@@ -159,8 +168,8 @@ public:
     bool hasOwnedObj() const;
 
     /**
-     * Ensures that 'obj' of a WSM in the RID_AND_OBJ state is owned BSON. It is a no-op if the WSM
-     * is in a different state or if 'obj' is already owned.
+     * Ensures that 'obj' of a WSM in the RID_AND_OBJ or OWNED_OBJ state is owned BSON. It is a
+     * no-op if the WSM is in a different state or if 'obj' is already owned.
      *
      * It is illegal for unowned BSON to survive a yield, so this must be called on any working set
      * members which may stay alive across yield points.
@@ -321,22 +330,22 @@ public:
      * release it.
      */
     WorkingSetMember* get(WorkingSetID i) {
-        dassert(i < _data.size());              // ID has been allocated.
-        dassert(_data[i].nextFreeOrSelf == i);  // ID currently in use.
-        return &_data[i].member;
+        dassert(i < _members.size());      // ID has been allocated.
+        dassert(_nextFreeOrSelf[i] == i);  // ID currently in use.
+        return &_members[i];
     }
 
     const WorkingSetMember* get(WorkingSetID i) const {
-        dassert(i < _data.size());              // ID has been allocated.
-        dassert(_data[i].nextFreeOrSelf == i);  // ID currently in use.
-        return &_data[i].member;
+        dassert(i < _members.size());      // ID has been allocated.
+        dassert(_nextFreeOrSelf[i] == i);  // ID currently in use.
+        return &_members[i];
     }
 
     /**
      * Returns true if WorkingSetMember with id 'i' is free.
      */
     bool isFree(WorkingSetID i) const {
-        return _data[i].nextFreeOrSelf != i;
+        return _nextFreeOrSelf[i] != i;
     }
 
     /**
@@ -390,20 +399,19 @@ public:
     WorkingSetID emplace(WorkingSetMember&&);
 
 private:
-    struct MemberHolder {
-        // Free list link if freed. Points to self if in use.
-        WorkingSetID nextFreeOrSelf;
-
-        WorkingSetMember member;
-    };
-
     // All WorkingSetIDs are indexes into this, except for INVALID_ID.
-    // Elements are added to _freeList rather than removed when freed.
-    std::vector<MemberHolder> _data;
-
-    // Index into _data, forming a linked-list using MemberHolder::nextFreeOrSelf as the next
-    // link. INVALID_ID is the list terminator since 0 is a valid index.
-    // If _freeList == INVALID_ID, the free list is empty and all elements in _data are in use.
+    // Elements are added to _freeList rather than removed when freed, so a reused member keeps
+    // the capacity of its key data vector and its document storage.
+    std::vector<WorkingSetMember> _members;
+
+    // Free list link of each member of '_members' if freed. Points to self if in use. These are
+    // kept apart from the much larger members so that allocating and freeing ids only touches
+    // this compact array and the member being recycled.
+    std::vector<WorkingSetID> _nextFreeOrSelf;
+
+    // Index into _members, forming a linked-list using _nextFreeOrSelf as the next link.
+    // INVALID_ID is the list terminator since 0 is a valid index.
+    // If _freeList == INVALID_ID, the free list is empty and all elements in _members are in use.
     WorkingSetID _freeList;
 
     // Holds IndexAccessMethods that have been registered with 'registerIndexAccessMethod()`. The
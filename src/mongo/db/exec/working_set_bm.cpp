@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+namespace {
+
+const BSONObj kKeyPattern = BSON("a" << 1);
+
+std::vector<BSONObj> makeDocs(size_t count) {
+    std::vector<BSONObj> docs;
+    docs.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        docs.push_back(BSON("_id" << static_cast<long long>(i) << "a" << static_cast<int>(i)
+                                  << "b"
+                                  << "padding"));
+    }
+    return docs;
+}
+
+/**
+ * Does to a working set member what an IXSCAN followed by a FETCH do to each result.
+ */
+void scanAndFetch(WorkingSet* ws, WorkingSetID id, const BSONObj& doc, long long i) {
+    auto member = ws->get(id);
+    member->recordId = RecordId(i);
+    member->keyData.push_back(
+        IndexKeyDatum(kKeyPattern, BSON("" << static_cast<int>(i)), 0, SnapshotId()));
+    ws->transitionToRecordIdAndIdx(id);
+
+    member->resetDocument(SnapshotId(), doc);
+    member->keyData.clear();
+    ws->transitionToRecordIdAndObj(id);
+}
+
+// Each result is returned and freed before the next one is produced, as in a streaming plan.
+void BM_WorkingSetStreaming(benchmark::State& state) {
+    const auto docs = makeDocs(state.range(0));
+    WorkingSet ws;
+    for (auto _ : state) {
+        for (size_t i = 0; i < docs.size(); ++i) {
+            auto id = ws.allocate();
+            scanAndFetch(&ws, id, docs[i], i);
+            benchmark::DoNotOptimize(ws.get(id)->hasObj());
+            ws.free(id);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * docs.size());
+}
+
+// All results stay in the working set until the batch is complete, as below a blocking stage.
+void BM_WorkingSetBuffered(benchmark::State& state) {
+    const auto docs = makeDocs(state.range(0));
+    WorkingSet ws;
+    std::vector<WorkingSetID> ids(docs.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < docs.size(); ++i) {
+            ids[i] = ws.allocate();
+            scanAndFetch(&ws, ids[i], docs[i], i);
+        }
+        for (auto id : ids) {
+            ws.free(id);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * docs.size());
+}
+
+BENCHMARK(BM_WorkingSetStreaming)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_WorkingSetBuffered)->Arg(1000)->Arg(100000);
+
+}  // namespace
+}  // namespace mongo
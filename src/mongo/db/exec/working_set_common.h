@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/util/unowned_ptr.h"
@@ -39,6 +41,7 @@ class CanonicalQuery;
 class Collection;
 class OperationContext;
 class SeekableRecordCursor;
+struct Record;
 
 class WorkingSetCommon {
 public:
@@ -57,6 +60,17 @@ public:
                       unowned_ptr<SeekableRecordCursor> cursor,
                       const NamespaceString& ns);
 
+    /**
+     * As above, but transitions the member using 'record', which the caller has already looked up
+     * for the member's RecordId in the current snapshot. A boost::none 'record' means that there
+     * was no Record with that id.
+     */
+    static bool fetch(OperationContext* opCtx,
+                      WorkingSet* workingSet,
+                      WorkingSetID id,
+                      boost::optional<Record> record,
+                      const NamespaceString& ns);
+
     /**
      * Build a Document which represents a Status to return in a WorkingSet.
      */
@@ -114,6 +114,20 @@ TEST_F(WorkingSetFixture, getFieldOwned) {
     ASSERT_EQUALS(elt.numberInt(), 5);
 }
 
+TEST_F(WorkingSetFixture, ComputedObjIsMadeOwnedOnlyWhenRequested) {
+    BSONObj obj = BSON("x" << 5);
+    member->doc = {SnapshotId(), Document{BSONObj(obj.objdata())}};
+    member->transitionToComputedObj();
+    ASSERT_EQUALS(WorkingSetMember::OWNED_OBJ, member->getState());
+    ASSERT_FALSE(member->doc.value().isOwned());
+
+    member->makeObjOwnedIfNeeded();
+    ASSERT_TRUE(member->doc.value().isOwned());
+    BSONElement elt;
+    ASSERT_TRUE(member->getFieldDotted("x", &elt));
+    ASSERT_EQUALS(elt.numberInt(), 5);
+}
+
 TEST_F(WorkingSetFixture, getFieldFromIndex) {
     string firstName = "x";
     int firstValue = 5;
@@ -43,9 +43,10 @@
 
 namespace mongo {
 
-void FTDCCollectorCollection::add(std::unique_ptr<FTDCCollectorInterface> collector) {
+void FTDCCollectorCollection::add(std::unique_ptr<FTDCCollectorInterface> collector,
+                                  Milliseconds period) {
     // TODO: ensure the collectors all have unique names.
-    _collectors.emplace_back(std::move(collector));
+    _collectors.push_back({std::move(collector), period, Date_t(), BSONObj()});
 }
 
 std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
@@ -73,7 +74,18 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
     // Explicitly start future read transactions without a timestamp.
     opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kNoTimestamp);
 
-    for (auto& collector : _collectors) {
+    for (auto& entry : _collectors) {
+        auto& collector = entry.collector;
+
+        // Samples do not start exactly one controller period apart, so allow 5% of the
+        // collector's period of slack. Otherwise a collector whose period is a multiple of the
+        // controller's could be skipped one sample too many.
+        if (entry.period > Milliseconds(0) && !entry.lastSample.isEmpty() &&
+            start - entry.lastCollected < entry.period - entry.period / 20) {
+            builder.append(collector->name(), entry.lastSample);
+            continue;
+        }
+
         BSONObjBuilder subObjBuilder(builder.subobjStart(collector->name()));
 
         // Add a Date_t before and after each BSON is collected so that we can track timing of the
@@ -92,6 +104,11 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
 
         end = client->getServiceContext()->getPreciseClockSource()->now();
         subObjBuilder.appendDate(kFTDCCollectEndField, end);
+
+        if (entry.period > Milliseconds(0)) {
+            entry.lastCollected = start;
+            entry.lastSample = subObjBuilder.done().getOwned();
+        }
     }
 
     builder.appendDate(kFTDCCollectEndField, end);
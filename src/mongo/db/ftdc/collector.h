@@ -34,12 +34,13 @@
 #include <tuple>
 #include <vector>
 
+#include "mongo/bson/bsonobj.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
-class BSONObj;
 class BSONObjBuilder;
-class Date_t;
 class Client;
 class OperationContext;
 
@@ -89,8 +90,13 @@ public:
     /**
      * Add a metric collector to the collection.
      * Must be called before collect. Cannot be called after collect is called.
+     *
+     * A collector with a non-zero 'period' is only run once that much time has passed since it
+     * last ran. Samples in between repeat its last result, so the schema does not change and its
+     * metrics compress to runs of zero deltas.
      */
-    void add(std::unique_ptr<FTDCCollectorInterface> collector);
+    void add(std::unique_ptr<FTDCCollectorInterface> collector,
+             Milliseconds period = Milliseconds(0));
 
     /**
      * Collect a sample from all collectors. Called after all adding is complete.
@@ -111,8 +117,19 @@ public:
     std::tuple<BSONObj, Date_t> collect(Client* client);
 
 private:
+    struct CollectorEntry {
+        std::unique_ptr<FTDCCollectorInterface> collector;
+
+        // Minimum time between two runs of the collector, or zero to run it for every sample.
+        Milliseconds period;
+
+        // Time of, and owned sub-document produced by, the last run for a collector with a period.
+        Date_t lastCollected;
+        BSONObj lastSample;
+    };
+
     // collection of collectors
-    std::vector<std::unique_ptr<FTDCCollectorInterface>> _collectors;
+    std::vector<CollectorEntry> _collectors;
 };
 
 }  // namespace mongo
@@ -108,8 +108,11 @@ public:
 
     /**
      * Add a metric collector to collect periodically. i.e., serverStatus
+     *
+     * A non-zero 'period' runs the collector at most that often, see FTDCCollectorCollection::add.
      */
-    void addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector);
+    void addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector,
+                              Milliseconds period = Milliseconds(0));
 
     /**
      * Add a collector to collect on server start, and file rotation. i.e. hostInfo
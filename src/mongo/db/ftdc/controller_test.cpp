@@ -48,6 +48,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/clock_source_mock.h"
 
 namespace mongo {
 
@@ -157,6 +158,60 @@ public:
 };
 
 // Test a run of the controller and the data it logs to log file
+class FTDCCountingCollector : public FTDCCollectorInterface {
+public:
+    explicit FTDCCountingCollector(std::string name) : _name(std::move(name)) {}
+
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) final {
+        builder.append("count", ++_count);
+    }
+
+    std::string name() const final {
+        return _name;
+    }
+
+    int count() const {
+        return _count;
+    }
+
+private:
+    std::string _name;
+    int _count{0};
+};
+
+// A collector with a period runs at most that often, and samples in between repeat its last
+// result.
+TEST_F(FTDCControllerTest, TestCollectorPeriod) {
+    auto clockSource = std::make_unique<ClockSourceMock>();
+    auto clock = clockSource.get();
+    getServiceContext()->setPreciseClockSource(std::move(clockSource));
+
+    auto fast = std::make_unique<FTDCCountingCollector>("fast");
+    auto slow = std::make_unique<FTDCCountingCollector>("slow");
+    auto fastPtr = fast.get();
+    auto slowPtr = slow.get();
+
+    FTDCCollectorCollection collectors;
+    collectors.add(std::move(fast));
+    collectors.add(std::move(slow), Milliseconds(1000));
+
+    auto client = getServiceContext()->makeClient("ftdc");
+    std::vector<BSONObj> samples;
+    for (int i = 0; i < 25; ++i) {
+        samples.push_back(std::get<0>(collectors.collect(client.get())));
+        clock->advance(Milliseconds(100));
+    }
+
+    ASSERT_EQ(fastPtr->count(), 25);
+    ASSERT_EQ(slowPtr->count(), 3);
+    ASSERT_EQ(samples[24]["fast"]["count"].numberInt(), 25);
+
+    ASSERT_EQ(samples[9]["slow"]["count"].numberInt(), 1);
+    ASSERT_BSONOBJ_EQ(samples[0]["slow"].Obj(), samples[9]["slow"].Obj());
+    ASSERT_EQ(samples[10]["slow"]["count"].numberInt(), 2);
+    ASSERT_EQ(samples[20]["slow"]["count"].numberInt(), 3);
+}
+
 TEST_F(FTDCControllerTest, TestFull) {
     unittest::TempDir tempdir("metrics_testpath");
     boost::filesystem::path dir(tempdir.path());
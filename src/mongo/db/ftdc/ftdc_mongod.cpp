@@ -46,9 +46,15 @@ void registerMongoDCollectors(FTDCController* controller) {
     // These metrics are only collected if replication is enabled
     if (repl::ReplicationCoordinator::get(getGlobalServiceContext())->getReplicationMode() !=
         repl::ReplicationCoordinator::modeNone) {
+        // These are more expensive than the other periodic collectors, and may be collected less
+        // often than every sample.
+        const Milliseconds period(ftdcStartupParams.replicationMetricsPeriodMillis.load());
+
         // CmdReplSetGetStatus
-        controller->addPeriodicCollector(std::make_unique<FTDCSimpleInternalCommandCollector>(
-            "replSetGetStatus", "replSetGetStatus", "", BSON("replSetGetStatus" << 1)));
+        controller->addPeriodicCollector(
+            std::make_unique<FTDCSimpleInternalCommandCollector>(
+                "replSetGetStatus", "replSetGetStatus", "", BSON("replSetGetStatus" << 1)),
+            period);
 
         // CollectionStats
         controller->addPeriodicCollector(
@@ -56,7 +62,8 @@ void registerMongoDCollectors(FTDCController* controller) {
                                                                  "local.oplog.rs.stats",
                                                                  "local",
                                                                  BSON("collStats"
-                                                                      << "oplog.rs")));
+                                                                      << "oplog.rs")),
+            period);
         if (serverGlobalParams.clusterRole != ClusterRole::ShardServer) {
             // GetDefaultRWConcern
             controller->addOnRotateCollector(std::make_unique<FTDCSimpleInternalCommandCollector>(
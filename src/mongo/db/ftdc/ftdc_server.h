@@ -112,6 +112,9 @@ struct FTDCStartupParams {
     AtomicWord<int> maxSamplesPerArchiveMetricChunk;
     AtomicWord<int> maxSamplesPerInterimMetricChunk;
 
+    // Minimum period of the replication collectors, zero to collect them with every sample.
+    AtomicWord<int> replicationMetricsPeriodMillis;
+
     FTDCStartupParams()
         : enabled(FTDCConfig::kEnabledDefault),
           periodMillis(FTDCConfig::kPeriodMillisDefault),
@@ -119,7 +122,8 @@ struct FTDCStartupParams {
           maxDirectorySizeMB(FTDCConfig::kMaxDirectorySizeBytesDefault / (1024 * 1024)),
           maxFileSizeMB(FTDCConfig::kMaxFileSizeBytesDefault / (1024 * 1024)),
           maxSamplesPerArchiveMetricChunk(FTDCConfig::kMaxSamplesPerArchiveMetricChunkDefault),
-          maxSamplesPerInterimMetricChunk(FTDCConfig::kMaxSamplesPerInterimMetricChunkDefault) {}
+          maxSamplesPerInterimMetricChunk(FTDCConfig::kMaxSamplesPerInterimMetricChunkDefault),
+          replicationMetricsPeriodMillis(0) {}
 };
 
 extern FTDCStartupParams ftdcStartupParams;
@@ -44,6 +44,7 @@
 #include "mongo/db/fts/fts_basic_tokenizer.h"
 #include "mongo/db/fts/fts_unicode_phrase_matcher.h"
 #include "mongo/db/fts/fts_unicode_tokenizer.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo::fts {
@@ -193,6 +194,15 @@ const FTSLanguage& FTSLanguage::make(StringData langName, TextIndexVersion textI
     uasserted(ErrorCodes::BadValue, "invalid TextIndexVersion");
 }
 
+FTSTokenizer* FTSLanguage::getThreadTokenizer() const {
+    thread_local stdx::unordered_map<const FTSLanguage*, std::unique_ptr<FTSTokenizer>> tokenizers;
+    auto& tokenizer = tokenizers[this];
+    if (!tokenizer) {
+        tokenizer = createTokenizer();
+    }
+    return tokenizer.get();
+}
+
 std::unique_ptr<FTSTokenizer> BasicFTSLanguage::createTokenizer() const {
     return std::make_unique<BasicFTSTokenizer>(this);
 }
@@ -84,6 +84,14 @@ public:
      */
     virtual std::unique_ptr<FTSTokenizer> createTokenizer() const = 0;
 
+    /**
+     * Returns this thread's FTSTokenizer instance for this language, creating it on first use.
+     * Creating a tokenizer sets up a libstemmer instance, and keeping one around also keeps the
+     * stems it has already computed. Callers must be done with the tokenizer before anything else
+     * on the thread can ask for it again.
+     */
+    FTSTokenizer* getThreadTokenizer() const;
+
     /**
      * Returns a reference to the phrase matcher instance that this language owns.
      */
@@ -79,11 +79,14 @@ bool FTSMatcher::hasPositiveTerm(const BSONObj& obj) const {
 }
 
 bool FTSMatcher::_hasPositiveTerm_string(const FTSLanguage* language, const string& raw) const {
-    std::unique_ptr<FTSTokenizer> tokenizer(language->createTokenizer());
+    FTSTokenizer* tokenizer = language->getThreadTokenizer();
     tokenizer->reset(raw.c_str(), _getTokenizerOptions());
 
+    // Reuse one buffer for the set lookups rather than allocating a string per token.
+    string word;
     while (tokenizer->moveNext()) {
-        string word = tokenizer->get().toString();
+        StringData token = tokenizer->get();
+        word.assign(token.rawData(), token.size());
         if (_query.getPositiveTerms().count(word) > 0) {
             return true;
         }
@@ -109,11 +112,14 @@ bool FTSMatcher::hasNegativeTerm(const BSONObj& obj) const {
 }
 
 bool FTSMatcher::_hasNegativeTerm_string(const FTSLanguage* language, const string& raw) const {
-    std::unique_ptr<FTSTokenizer> tokenizer(language->createTokenizer());
+    FTSTokenizer* tokenizer = language->getThreadTokenizer();
     tokenizer->reset(raw.c_str(), _getTokenizerOptions());
 
+    // Reuse one buffer for the set lookups rather than allocating a string per token.
+    string word;
     while (tokenizer->moveNext()) {
-        string word = tokenizer->get().toString();
+        StringData token = tokenizer->get();
+        word.assign(token.rawData(), token.size());
         if (_query.getNegatedTerms().count(word) > 0) {
             return true;
         }
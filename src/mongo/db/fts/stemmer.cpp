@@ -53,6 +53,11 @@ StringData Stemmer::stem(StringData word) const {
     if (!_stemmer)
         return word;
 
+    auto it = _cache.find(word);
+    if (it != _cache.end()) {
+        return it->second;
+    }
+
     const sb_symbol* sb_sym =
         sb_stemmer_stem(_stemmer, (const sb_symbol*)word.rawData(), word.size());
 
@@ -61,7 +66,11 @@ StringData Stemmer::stem(StringData word) const {
         MONGO_UNREACHABLE;
     }
 
-    return StringData((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    if (_cache.size() >= kMaxCachedStems) {
+        _cache.clear();
+    }
+    return _cache.try_emplace(word, (const char*)(sb_sym), sb_stemmer_length(_stemmer))
+        .first->second;
 }
 }  // namespace fts
 }  // namespace mongo
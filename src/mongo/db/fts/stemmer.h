@@ -32,6 +32,7 @@
 
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_language.h"
+#include "mongo/util/string_map.h"
 #include "third_party/libstemmer_c/include/libstemmer.h"
 
 namespace mongo {
@@ -57,11 +58,19 @@ public:
      * The returned StringData is valid until the next call to any method on this object. Since the
      * input may be returned unmodified, the output's lifetime may also expire when the input's
      * does.
+     *
+     * Results are remembered, so stemming a word seen recently only costs a hash lookup.
      */
     StringData stem(StringData word) const;
 
+    // Upper bound on the number of words in '_cache', which is emptied when it fills up.
+    static constexpr size_t kMaxCachedStems = 1024;
+
 private:
     struct sb_stemmer* _stemmer;
+
+    // Maps words to their stems.
+    mutable StringMap<std::string> _cache;
 };
 }  // namespace fts
 }  // namespace mongo
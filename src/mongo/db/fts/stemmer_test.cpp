@@ -32,6 +32,7 @@
 
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/fts/stemmer.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 namespace fts {
@@ -56,5 +57,14 @@ TEST(English, Caps) {
     ASSERT_EQUALS("unit", s.stem("united"));
     ASSERT_EQUALS("Unite", s.stem("United"));
 }
+TEST(English, CachedStems) {
+    Stemmer s(languageEnglishV2());
+    for (size_t i = 0; i < Stemmer::kMaxCachedStems + 10; ++i) {
+        std::string word = str::stream() << "word" << i << "s";
+        std::string stemmed = s.stem(word).toString();
+        ASSERT_EQUALS(stemmed, s.stem(word));
+        ASSERT_EQUALS("run", s.stem("running"));
+    }
+}
 }  // namespace fts
 }  // namespace mongo
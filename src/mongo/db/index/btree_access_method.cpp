@@ -74,4 +74,11 @@ void BtreeAccessMethod::doGetKeys(const BSONObj& obj,
     _keyGenerator->getKeys(obj, keys, multikeyPaths, id);
 }
 
+bool BtreeAccessMethod::doGetKeysFromTopLevelFields(const TopLevelFieldLookup& topLevelFields,
+                                                    KeyStringSet* keys,
+                                                    MultikeyPaths* multikeyPaths,
+                                                    boost::optional<RecordId> id) const {
+    return _keyGenerator->getKeysFromTopLevelFields(topLevelFields, keys, multikeyPaths, id);
+}
+
 }  // namespace mongo
@@ -55,6 +55,11 @@ private:
                    MultikeyPaths* multikeyPaths,
                    boost::optional<RecordId> id) const final;
 
+    bool doGetKeysFromTopLevelFields(const TopLevelFieldLookup& topLevelFields,
+                                     KeyStringSet* keys,
+                                     MultikeyPaths* multikeyPaths,
+                                     boost::optional<RecordId> id) const final;
+
     // Our keys differ for V0 and V1.
     std::unique_ptr<BtreeKeyGenerator> _keyGenerator;
 };
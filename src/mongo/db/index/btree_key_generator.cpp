@@ -29,12 +29,15 @@
 
 #include "mongo/db/index/btree_key_generator.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
+#include <cstring>
 #include <memory>
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/field_ref.h"
+#include "mongo/db/index/top_level_field_lookup.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/util/assert_util.h"
@@ -53,6 +56,17 @@ const BSONElement nullElt = nullObj.firstElement();
 const BSONObj undefinedObj = BSON("" << BSONUndefined);
 const BSONElement undefinedElt = undefinedObj.firstElement();
 
+bool isTopLevelKeyPattern(const std::vector<const char*>& fieldNames,
+                          const std::vector<BSONElement>& fixed) {
+    for (const char* fieldName : fieldNames) {
+        if (*fieldName == '\0' || strchr(fieldName, '.')) {
+            return false;
+        }
+    }
+    return std::all_of(
+        fixed.begin(), fixed.end(), [](const BSONElement& elem) { return elem.eoo(); });
+}
+
 }  // namespace
 
 BtreeKeyGenerator::BtreeKeyGenerator(std::vector<const char*> fieldNames,
@@ -66,6 +80,7 @@ BtreeKeyGenerator::BtreeKeyGenerator(std::vector<const char*> fieldNames,
       _fieldNames(fieldNames),
       _isIdIndex(fieldNames.size() == 1 && std::string("_id") == fieldNames[0]),
       _isSparse(isSparse),
+      _isTopLevelKeyPattern(isTopLevelKeyPattern(fieldNames, fixed)),
       _nullKeyString(_buildNullKeyString()),
       _fixed(fixed),
       _emptyPositionalInfo(fieldNames.size()),
@@ -195,16 +210,92 @@ void BtreeKeyGenerator::getKeys(const BSONObj& obj,
             invariant(multikeyPaths->empty());
             multikeyPaths->resize(_fieldNames.size());
         }
-        // '_fieldNames' and '_fixed' are passed by value so that their copies can be mutated as
-        // part of the _getKeysWithArray method.
-        _getKeysWithArray(
-            _fieldNames, _fixed, obj, keys, 0, _emptyPositionalInfo, multikeyPaths, id);
+        if (!_isTopLevelKeyPattern || !_getKeysTopLevel(obj, keys, id)) {
+            // '_fieldNames' and '_fixed' are passed by value so that their copies can be mutated
+            // as part of the _getKeysWithArray method.
+            _getKeysWithArray(
+                _fieldNames, _fixed, obj, keys, 0, _emptyPositionalInfo, multikeyPaths, id);
+        }
     }
     if (keys->empty() && !_isSparse) {
         keys->insert(_nullKeyString);
     }
 }
 
+bool BtreeKeyGenerator::getKeysFromTopLevelFields(const TopLevelFieldLookup& fields,
+                                                  KeyStringSet* keys,
+                                                  MultikeyPaths* multikeyPaths,
+                                                  boost::optional<RecordId> id) const {
+    if (!_isTopLevelKeyPattern || _isIdIndex) {
+        return false;
+    }
+
+    KeyStringSet newKeys;
+    auto findField = [&](const char* fieldName, BSONElement* elem) {
+        return fields.find(fieldName, elem);
+    };
+    if (!_buildTopLevelKey(findField, &newKeys, id)) {
+        return false;
+    }
+
+    if (newKeys.empty() && !_isSparse) {
+        newKeys.insert(_nullKeyString);
+    }
+    keys->insert(newKeys.begin(), newKeys.end());
+    if (multikeyPaths) {
+        invariant(multikeyPaths->empty());
+        multikeyPaths->resize(_fieldNames.size());
+    }
+    return true;
+}
+
+bool BtreeKeyGenerator::_getKeysTopLevel(const BSONObj& obj,
+                                         KeyStringSet* keys,
+                                         boost::optional<RecordId> id) const {
+    auto findField = [&](const char* fieldName, BSONElement* elem) {
+        *elem = obj.getField(fieldName);
+        return true;
+    };
+    return _buildTopLevelKey(findField, keys, id);
+}
+
+template <typename FindField>
+bool BtreeKeyGenerator::_buildTopLevelKey(const FindField& findField,
+                                          KeyStringSet* keys,
+                                          boost::optional<RecordId> id) const {
+    KeyString::Builder keyString(_keyStringVersion, _ordering);
+    size_t numNotFound = 0;
+    for (const char* fieldName : _fieldNames) {
+        BSONElement elem;
+        if (!findField(fieldName, &elem)) {
+            return false;
+        }
+        if (elem.eoo()) {
+            elem = nullElt;
+            numNotFound++;
+        } else if (elem.type() == Array) {
+            return false;
+        }
+
+        if (_collator) {
+            keyString.appendBSONElement(elem, [&](StringData stringData) {
+                return _collator->getComparisonString(stringData);
+            });
+        } else {
+            keyString.appendBSONElement(elem);
+        }
+    }
+
+    if (_isSparse && numNotFound == _fieldNames.size()) {
+        return true;
+    }
+    if (id) {
+        keyString.appendRecordId(*id);
+    }
+    keys->insert(keyString.getValueCopy());
+    return true;
+}
+
 void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*> fieldNames,
                                           std::vector<BSONElement> fixed,
                                           const BSONObj& obj,
@@ -42,6 +42,7 @@
 namespace mongo {
 
 class CollatorInterface;
+class TopLevelFieldLookup;
 
 /**
  * Internal class used by BtreeAccessMethod to generate keys for indexed documents.
@@ -74,6 +75,17 @@ public:
                  MultikeyPaths* multikeyPaths,
                  boost::optional<RecordId> id = boost::none) const;
 
+    /**
+     * Like getKeys(), but reads the indexed fields of the document from 'fields' instead of
+     * searching the document for them. Returns false without modifying 'keys' or 'multikeyPaths'
+     * if the key pattern is not made only of top-level fields, if 'fields' does not track one of
+     * them, or if one of them holds an array; the caller must then fall back to getKeys().
+     */
+    bool getKeysFromTopLevelFields(const TopLevelFieldLookup& fields,
+                                   KeyStringSet* keys,
+                                   MultikeyPaths* multikeyPaths,
+                                   boost::optional<RecordId> id = boost::none) const;
+
 private:
     const KeyString::Version _keyStringVersion;
     const Ordering _ordering;
@@ -81,6 +93,9 @@ private:
     const std::vector<const char*> _fieldNames;
     const bool _isIdIndex;
     const bool _isSparse;
+    // True if every indexed field is a non-empty, undotted path with no fixed value, in which case
+    // keys for documents that have no array along those paths are built by _getKeysTopLevel().
+    const bool _isTopLevelKeyPattern;
     const KeyString::Value _nullKeyString;  // A full key with all fields null.
 
     std::vector<BSONElement> _fixed;
@@ -137,6 +152,24 @@ private:
         const char* remainingPath;
     };
 
+    /**
+     * Builds the single key for 'obj' when '_isTopLevelKeyPattern' is true, without the copies
+     * and recursion of _getKeysWithArray(). Returns false without modifying 'keys' if one of the
+     * indexed fields holds an array, in which case the caller must take the general path.
+     */
+    bool _getKeysTopLevel(const BSONObj& obj,
+                          KeyStringSet* keys,
+                          boost::optional<RecordId> id) const;
+
+    /**
+     * Shared by _getKeysTopLevel() and getKeysFromTopLevelFields(). 'findField' is called as
+     * findField(fieldName, &elem) and returns false if the field cannot be looked up.
+     */
+    template <typename FindField>
+    bool _buildTopLevelKey(const FindField& findField,
+                           KeyStringSet* keys,
+                           boost::optional<RecordId> id) const;
+
     /**
      * This recursive method does the heavy-lifting for getKeys().
      */
@@ -0,0 +1,84 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/index/btree_key_generator.h"
+
+namespace mongo {
+namespace {
+
+const int kSampleSize = 500;
+
+std::vector<BSONObj> generateDocs() {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < kSampleSize; i++) {
+        docs.push_back(BSON("_id" << i << "a" << i * 7 << "b"
+                                  << "value" << "c" << BSON("d" << i % 13) << "e" << i * 0.5));
+    }
+    return docs;
+}
+
+void BM_BtreeKeyGeneratorGetKeys(benchmark::State& state, BSONObj keyPattern) {
+    std::vector<const char*> fieldNames;
+    std::vector<BSONElement> fixed;
+    for (auto&& elem : keyPattern) {
+        fieldNames.push_back(elem.fieldName());
+        fixed.push_back(BSONElement());
+    }
+    BtreeKeyGenerator keyGen(fieldNames,
+                             fixed,
+                             false /* isSparse */,
+                             nullptr /* collator */,
+                             KeyString::Version::kLatestVersion,
+                             Ordering::make(keyPattern));
+
+    const std::vector<BSONObj> docs = generateDocs();
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        for (const auto& doc : docs) {
+            KeyStringSet keys;
+            MultikeyPaths multikeyPaths;
+            keyGen.getKeys(doc, &keys, &multikeyPaths, RecordId(1));
+            benchmark::DoNotOptimize(keys);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kSampleSize);
+}
+
+BENCHMARK_CAPTURE(BM_BtreeKeyGeneratorGetKeys, Single, BSON("a" << 1));
+BENCHMARK_CAPTURE(BM_BtreeKeyGeneratorGetKeys, Compound, BSON("a" << 1 << "b" << -1 << "e" << 1));
+BENCHMARK_CAPTURE(BM_BtreeKeyGeneratorGetKeys, Dotted, BSON("a" << 1 << "c.d" << 1));
+
+}  // namespace
+}  // namespace mongo
@@ -37,6 +37,7 @@
 #include <iostream>
 
 #include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/index/top_level_field_lookup.h"
 #include "mongo/db/json.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/logv2/log.h"
@@ -615,6 +616,22 @@ TEST(BtreeKeyGeneratorTest, SparseReverseUnevenNestedEmptyArray) {
     ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths, sparse));
 }
 
+TEST(BtreeKeyGeneratorTest, GetKeysFromCompoundTopLevelWithMissingField) {
+    BSONObj keyPattern = fromjson("{a: 1, b: 1, c: 1}");
+    BSONObj genKeysFrom = fromjson("{c: 'foo', a: 3}");
+    KeyString::HeapBuilder keyString(KeyString::Version::kLatestVersion,
+                                     fromjson("{'': 3, '': null, '': 'foo'}"),
+                                     Ordering::make(BSONObj()));
+    KeyStringSet expectedKeys{keyString.release()};
+    MultikeyPaths expectedMultikeyPaths(3);
+    ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths));
+
+    const bool sparse = true;
+    genKeysFrom = fromjson("{d: 1}");
+    expectedKeys.clear();
+    ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths, sparse));
+}
+
 TEST(BtreeKeyGeneratorTest, GetKeysFromSparseEmptyArray) {
     const bool sparse = true;
     BSONObj keyPattern = fromjson("{'a.b': 1}");
@@ -1361,4 +1378,95 @@ TEST(BtreeKeyGeneratorTest, GetCollationAwareKeysFromNestedArray) {
         testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths, false, &collator));
 }
 
+//
+// Tests for getKeysFromTopLevelFields()
+//
+
+std::unique_ptr<BtreeKeyGenerator> makeKeyGenerator(const BSONObj& kp, bool sparse = false) {
+    vector<const char*> fieldNames;
+    vector<BSONElement> fixed;
+    for (auto&& elt : kp) {
+        fieldNames.push_back(elt.fieldName());
+        fixed.push_back(BSONElement());
+    }
+    return std::make_unique<BtreeKeyGenerator>(fieldNames,
+                                               fixed,
+                                               sparse,
+                                               nullptr,
+                                               KeyString::Version::kLatestVersion,
+                                               Ordering::make(BSONObj()));
+}
+
+/**
+ * Returns true if the keys generated for 'obj' from a TopLevelFieldLookup over 'trackedFields' are
+ * the same as those generated by getKeys().
+ */
+bool topLevelKeysMatch(const BSONObj& kp,
+                       const BSONObj& obj,
+                       std::vector<std::string> trackedFields,
+                       bool sparse = false) {
+    auto keyGen = makeKeyGenerator(kp, sparse);
+    TopLevelFieldLookup fields(std::move(trackedFields));
+    fields.setDocument(obj);
+
+    KeyStringSet expectedKeys;
+    MultikeyPaths expectedMultikeyPaths;
+    keyGen->getKeys(obj, &expectedKeys, &expectedMultikeyPaths);
+
+    KeyStringSet actualKeys;
+    MultikeyPaths actualMultikeyPaths;
+    if (!keyGen->getKeysFromTopLevelFields(fields, &actualKeys, &actualMultikeyPaths)) {
+        return false;
+    }
+    return keysetsEqual(expectedKeys, actualKeys) && expectedMultikeyPaths == actualMultikeyPaths;
+}
+
+TEST(BtreeKeyGeneratorTest, TopLevelFieldsMatchGetKeys) {
+    BSONObj keyPattern = fromjson("{a: 1, c: -1}");
+    ASSERT(topLevelKeysMatch(keyPattern, fromjson("{a: 1, b: 2, c: 'x'}"), {"a", "b", "c"}));
+    ASSERT(topLevelKeysMatch(keyPattern, fromjson("{c: {d: 1}, a: null}"), {"a", "c"}));
+}
+
+TEST(BtreeKeyGeneratorTest, TopLevelFieldsMissingFieldsAreNull) {
+    BSONObj keyPattern = fromjson("{a: 1, b: 1}");
+    ASSERT(topLevelKeysMatch(keyPattern, fromjson("{b: 2}"), {"a", "b"}));
+    ASSERT(topLevelKeysMatch(keyPattern, fromjson("{x: 2}"), {"a", "b"}));
+}
+
+TEST(BtreeKeyGeneratorTest, TopLevelFieldsSparse) {
+    BSONObj keyPattern = fromjson("{a: 1, b: 1}");
+    ASSERT(topLevelKeysMatch(keyPattern, fromjson("{x: 2}"), {"a", "b"}, true));
+    ASSERT(topLevelKeysMatch(keyPattern, fromjson("{b: 2}"), {"a", "b"}, true));
+}
+
+TEST(BtreeKeyGeneratorTest, TopLevelFieldsUseFirstDuplicateField) {
+    BSONObj keyPattern = fromjson("{a: 1}");
+    ASSERT(topLevelKeysMatch(keyPattern, BSON("a" << 1 << "a" << 2), {"a"}));
+}
+
+TEST(BtreeKeyGeneratorTest, TopLevelFieldsFallBackForArrays) {
+    auto keyGen = makeKeyGenerator(fromjson("{a: 1, b: 1}"));
+    TopLevelFieldLookup fields({"a", "b"});
+    fields.setDocument(fromjson("{a: 1, b: [1, 2]}"));
+    KeyStringSet keys;
+    MultikeyPaths multikeyPaths;
+    ASSERT_FALSE(keyGen->getKeysFromTopLevelFields(fields, &keys, &multikeyPaths));
+    ASSERT(keys.empty());
+    ASSERT(multikeyPaths.empty());
+}
+
+TEST(BtreeKeyGeneratorTest, TopLevelFieldsFallBackForUntrackedOrDottedFields) {
+    TopLevelFieldLookup fields({"_id", "a", "c"});
+    fields.setDocument(fromjson("{_id: 0, a: 1, b: 2, c: {d: 3}}"));
+    KeyStringSet keys;
+    auto getKeys = [&](const char* keyPattern) {
+        return makeKeyGenerator(fromjson(keyPattern))
+            ->getKeysFromTopLevelFields(fields, &keys, nullptr);
+    };
+    ASSERT_FALSE(getKeys("{a: 1, b: 1}"));
+    ASSERT_FALSE(getKeys("{'c.d': 1}"));
+    ASSERT_FALSE(getKeys("{_id: 1}"));
+    ASSERT(keys.empty());
+}
+
 }  // namespace
@@ -44,6 +44,7 @@
 #include "mongo/db/geo/s2.h"
 #include "mongo/db/index/2d_common.h"
 #include "mongo/db/index/s2_common.h"
+#include "mongo/db/index/s2_covering_cache.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/logv2/log.h"
@@ -65,6 +66,11 @@ namespace dps = ::mongo::dotted_path_support;
 Status S2GetKeysForElement(const BSONElement& element,
                            const S2IndexingParams& params,
                            vector<S2CellId>* out) {
+    const bool useCoveringCache = params.coveringCache && S2CoveringCache::shouldCache(element);
+    if (useCoveringCache && params.coveringCache->find(element, out)) {
+        return Status::OK();
+    }
+
     GeometryContainer geoContainer;
     Status status = geoContainer.parseFromStorage(element);
     if (!status.isOK())
@@ -95,7 +101,24 @@ Status S2GetKeysForElement(const BSONElement& element,
 
     invariant(geoContainer.hasS2Region());
 
+    if (geoContainer.isPoint()) {
+        // The region of a point is the leaf cell containing it, and no other cell intersects it,
+        // so its covering is the single ancestor of that leaf at the coverer's finest level. Take
+        // it directly rather than have the coverer descend to it from the face cells.
+        const auto& leaf = static_cast<const S2Cell&>(geoContainer.getS2Region());
+        out->push_back(leaf.id().parent(coverer.max_level()));
+        if (kDebugBuild) {
+            vector<S2CellId> covering;
+            coverer.GetCovering(geoContainer.getS2Region(), &covering);
+            invariant(covering == *out);
+        }
+        return Status::OK();
+    }
+
     coverer.GetCovering(geoContainer.getS2Region(), out);
+    if (useCoveringCache) {
+        params.coveringCache->add(element, *out);
+    }
     return Status::OK();
 }
 
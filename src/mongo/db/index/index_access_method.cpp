@@ -463,6 +463,17 @@ public:
                   const RecordId& loc,
                   const InsertDeleteOptions& options) final;
 
+    Status generateKeys(const BSONObj& obj,
+                        const RecordId& loc,
+                        const InsertDeleteOptions& options,
+                        GeneratedKeys* out,
+                        const TopLevelFieldLookup* topLevelFields) const final;
+
+    Status insertKeys(OperationContext* opCtx,
+                      const BSONObj& obj,
+                      const RecordId& loc,
+                      GeneratedKeys generatedKeys) final;
+
     const MultikeyPaths& getMultikeyPaths() const final;
 
     bool isMultikey() const final;
@@ -516,36 +527,63 @@ Status AbstractIndexAccessMethod::BulkBuilderImpl::insert(OperationContext* opCt
                                                           const BSONObj& obj,
                                                           const RecordId& loc,
                                                           const InsertDeleteOptions& options) {
-    KeyStringSet keys;
-    MultikeyPaths multikeyPaths;
+    GeneratedKeys generatedKeys;
+    Status status = generateKeys(obj, loc, options, &generatedKeys, nullptr);
+    if (!status.isOK()) {
+        return status;
+    }
+    return insertKeys(opCtx, obj, loc, std::move(generatedKeys));
+}
 
+Status AbstractIndexAccessMethod::BulkBuilderImpl::generateKeys(const BSONObj& obj,
+                                                                const RecordId& loc,
+                                                                const InsertDeleteOptions& options,
+                                                                GeneratedKeys* out,
+                                                                const TopLevelFieldLookup*
+                                                                    topLevelFields) const {
     try {
         _indexCatalogEntry->accessMethod()->getKeys(
             obj,
             options.getKeysMode,
             GetKeysContext::kReadOrAddKeys,
-            &keys,
-            &_multikeyMetadataKeys,
-            &multikeyPaths,
+            &out->keys,
+            &out->multikeyMetadataKeys,
+            &out->multikeyPaths,
             loc,
             [&](Status status, const BSONObj&, boost::optional<RecordId>) {
-                // If a key generation error was suppressed, record the document as "skipped" so the
-                // index builder can retry at a point when data is consistent.
-                auto interceptor = _indexCatalogEntry->indexBuildInterceptor();
-                if (interceptor && interceptor->getSkippedRecordTracker()) {
-                    LOGV2_DEBUG(20684,
-                                1,
-                                "Recording suppressed key generation error to retry later: "
-                                "{status} on {loc}: {obj}",
-                                "status"_attr = status,
-                                "loc"_attr = loc,
-                                "obj"_attr = redact(obj));
-                    interceptor->getSkippedRecordTracker()->record(opCtx, loc);
-                }
-            });
+                out->suppressedError = std::move(status);
+            },
+            topLevelFields);
     } catch (...) {
         return exceptionToStatus();
     }
+    return Status::OK();
+}
+
+Status AbstractIndexAccessMethod::BulkBuilderImpl::insertKeys(OperationContext* opCtx,
+                                                              const BSONObj& obj,
+                                                              const RecordId& loc,
+                                                              GeneratedKeys generatedKeys) {
+    if (generatedKeys.suppressedError) {
+        // If a key generation error was suppressed, record the document as "skipped" so the index
+        // builder can retry at a point when data is consistent.
+        auto interceptor = _indexCatalogEntry->indexBuildInterceptor();
+        if (interceptor && interceptor->getSkippedRecordTracker()) {
+            LOGV2_DEBUG(20684,
+                        1,
+                        "Recording suppressed key generation error to retry later: "
+                        "{status} on {loc}: {obj}",
+                        "status"_attr = *generatedKeys.suppressedError,
+                        "loc"_attr = loc,
+                        "obj"_attr = redact(obj));
+            interceptor->getSkippedRecordTracker()->record(opCtx, loc);
+        }
+    }
+
+    const auto& keys = generatedKeys.keys;
+    const auto& multikeyPaths = generatedKeys.multikeyPaths;
+    _multikeyMetadataKeys.insert(generatedKeys.multikeyMetadataKeys.begin(),
+                                 generatedKeys.multikeyMetadataKeys.end());
 
     if (!multikeyPaths.empty()) {
         if (_indexMultikeyPaths.empty()) {
@@ -718,7 +756,8 @@ void AbstractIndexAccessMethod::getKeys(const BSONObj& obj,
                                         KeyStringSet* multikeyMetadataKeys,
                                         MultikeyPaths* multikeyPaths,
                                         boost::optional<RecordId> id,
-                                        OnSuppressedErrorFn onSuppressedError) const {
+                                        OnSuppressedErrorFn onSuppressedError,
+                                        const TopLevelFieldLookup* topLevelFields) const {
     static stdx::unordered_set<int> whiteList{ErrorCodes::CannotBuildIndexKeys,
                                               // Btree
                                               ErrorCodes::CannotIndexParallelArrays,
@@ -745,6 +784,10 @@ void AbstractIndexAccessMethod::getKeys(const BSONObj& obj,
                                               13026,
                                               13027};
     try {
+        if (topLevelFields &&
+            doGetKeysFromTopLevelFields(*topLevelFields, keys, multikeyPaths, id)) {
+            return;
+        }
         doGetKeys(obj, context, keys, multikeyMetadataKeys, multikeyPaths, id);
     } catch (const AssertionException& ex) {
         // Suppress all indexing errors when mode is kRelaxConstraints.
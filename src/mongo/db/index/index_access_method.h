@@ -47,6 +47,7 @@ namespace mongo {
 
 class BSONObjBuilder;
 class MatchExpression;
+class TopLevelFieldLookup;
 struct UpdateTicket;
 struct InsertResult;
 struct InsertDeleteOptions;
@@ -210,6 +211,37 @@ public:
                               const RecordId& loc,
                               const InsertDeleteOptions& options) = 0;
 
+        /**
+         * The keys generated for a single document by generateKeys().
+         */
+        struct GeneratedKeys {
+            KeyStringSet keys;
+            KeyStringSet multikeyMetadataKeys;
+            MultikeyPaths multikeyPaths;
+
+            // Set if a key generation error was suppressed for the document.
+            boost::optional<Status> suppressedError;
+        };
+
+        /**
+         * Generates the keys that insert() would add for 'obj' without modifying the BulkBuilder.
+         * This may be called concurrently from several threads. insert() is equivalent to calling
+         * generateKeys() followed by insertKeys().
+         */
+        virtual Status generateKeys(const BSONObj& obj,
+                                    const RecordId& loc,
+                                    const InsertDeleteOptions& options,
+                                    GeneratedKeys* out,
+                                    const TopLevelFieldLookup* topLevelFields = nullptr) const = 0;
+
+        /**
+         * Adds the keys that generateKeys() produced for the document 'obj' at 'loc'.
+         */
+        virtual Status insertKeys(OperationContext* opCtx,
+                                  const BSONObj& obj,
+                                  const RecordId& loc,
+                                  GeneratedKeys generatedKeys) = 0;
+
         virtual const MultikeyPaths& getMultikeyPaths() const = 0;
 
         virtual bool isMultikey() const = 0;
@@ -300,6 +332,9 @@ public:
      *
      * If any key generation errors are encountered and suppressed due to the provided GetKeysMode,
      * 'onSuppressedErrorFn' is called.
+     *
+     * If 'topLevelFields' is non-null, it must have been set to 'obj', and index types that can
+     * build their keys from the top-level fields it tracks do so instead of searching 'obj'.
      */
     using OnSuppressedErrorFn =
         std::function<void(Status status, const BSONObj& obj, boost::optional<RecordId> loc)>;
@@ -310,7 +345,8 @@ public:
                          KeyStringSet* multikeyMetadataKeys,
                          MultikeyPaths* multikeyPaths,
                          boost::optional<RecordId> id,
-                         OnSuppressedErrorFn onSuppressedError) const = 0;
+                         OnSuppressedErrorFn onSuppressedError,
+                         const TopLevelFieldLookup* topLevelFields = nullptr) const = 0;
 
     static OnSuppressedErrorFn kNoopOnSuppressedErrorFn;
 
@@ -519,7 +555,8 @@ public:
                  KeyStringSet* multikeyMetadataKeys,
                  MultikeyPaths* multikeyPaths,
                  boost::optional<RecordId> id,
-                 OnSuppressedErrorFn onSuppressedError) const final;
+                 OnSuppressedErrorFn onSuppressedError,
+                 const TopLevelFieldLookup* topLevelFields = nullptr) const final;
 
     bool shouldMarkIndexAsMultikey(size_t numberOfKeys,
                                    const std::vector<KeyString::Value>& multikeyMetadataKeys,
@@ -549,6 +586,18 @@ protected:
                            MultikeyPaths* multikeyPaths,
                            boost::optional<RecordId> id) const = 0;
 
+    /**
+     * Same as doGetKeys(), but reads the indexed fields of 'obj' from 'topLevelFields'. Returns
+     * false without generating any keys if this index cannot build its keys that way for 'obj', in
+     * which case doGetKeys() is used instead.
+     */
+    virtual bool doGetKeysFromTopLevelFields(const TopLevelFieldLookup& topLevelFields,
+                                             KeyStringSet* keys,
+                                             MultikeyPaths* multikeyPaths,
+                                             boost::optional<RecordId> id) const {
+        return false;
+    }
+
     IndexCatalogEntry* const _indexCatalogEntry;  // owned by IndexCatalog
     const IndexDescriptor* const _descriptor;
 
@@ -33,6 +33,7 @@
 
 #include "mongo/db/index/index_build_interceptor.h"
 
+#include <map>
 #include <vector>
 
 #include "mongo/bson/bsonobj.h"
@@ -192,6 +193,11 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
         // table matters.
         std::vector<RecordId> recordsAddedToIndex;
 
+        // Whether a key ends up in the index only depends on the last write to it, so only that
+        // one is kept. The keys include the RecordId, so writes for different documents never
+        // replace each other. The remaining writes are applied in key order for locality.
+        std::map<KeyString::Value, Op> batchWrites;
+
         while (!atEof) {
             opCtx->checkForInterrupt();
 
@@ -213,11 +219,8 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
             batchSize += 1;
             batchSizeBytes += objSize;
 
-            if (auto status =
-                    _applyWrite(opCtx, unownedDoc, options, &totalInserted, &totalDeleted);
-                !status.isOK()) {
-                return status;
-            }
+            auto [keyString, opType] = _parseWrite(unownedDoc);
+            batchWrites.insert_or_assign(std::move(keyString), opType);
 
             // Save the record ids of the documents inserted into the index for deletion later.
             // We can't delete records while holding a positioned cursor.
@@ -229,6 +232,14 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
             }
         }
 
+        for (const auto& [keyString, opType] : batchWrites) {
+            if (auto status =
+                    _applyWrite(opCtx, keyString, opType, options, &totalInserted, &totalDeleted);
+                !status.isOK()) {
+                return status;
+            }
+        }
+
         // Delete documents from the side table as soon as they have been inserted into the index.
         // This ensures that no key is ever inserted twice and no keys are skipped.
         for (const auto& recordId : recordsAddedToIndex) {
@@ -283,22 +294,30 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
     return Status::OK();
 }
 
-Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
-                                          const BSONObj& operation,
-                                          const InsertDeleteOptions& options,
-                                          int64_t* const keysInserted,
-                                          int64_t* const keysDeleted) {
+std::pair<KeyString::Value, IndexBuildInterceptor::Op> IndexBuildInterceptor::_parseWrite(
+    const BSONObj& operation) const {
     // Deserialize the encoded KeyString::Value.
     int keyLen;
     const char* binKey = operation["key"].binData(keyLen);
     BufReader reader(binKey, keyLen);
-    const KeyString::Value keyString = KeyString::Value::deserialize(
+    KeyString::Value keyString = KeyString::Value::deserialize(
         reader,
         _indexCatalogEntry->accessMethod()->getSortedDataInterface()->getKeyStringVersion());
 
     const Op opType =
         (strcmp(operation.getStringField("op"), "i") == 0) ? Op::kInsert : Op::kDelete;
+    if (kDebugBuild && opType == Op::kDelete)
+        invariant(strcmp(operation.getStringField("op"), "d") == 0);
+
+    return {std::move(keyString), opType};
+}
 
+Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
+                                          const KeyString::Value& keyString,
+                                          Op opType,
+                                          const InsertDeleteOptions& options,
+                                          int64_t* const keysInserted,
+                                          int64_t* const keysDeleted) {
     const KeyStringSet keySet{keyString};
     const RecordId opRecordId =
         KeyString::decodeRecordIdAtEnd(keyString.getBuffer(), keyString.getSize());
@@ -331,8 +350,6 @@ Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
             [keysInserted, numInserted] { *keysInserted -= numInserted; });
     } else {
         invariant(opType == Op::kDelete);
-        if (kDebugBuild)
-            invariant(strcmp(operation.getStringField("op"), "d") == 0);
 
         int64_t numDeleted;
         Status s = accessMethod->removeKeys(
@@ -169,8 +169,14 @@ public:
 private:
     using SideWriteRecord = std::pair<RecordId, BSONObj>;
 
+    /**
+     * Decodes the index key and operation type of a side write record.
+     */
+    std::pair<KeyString::Value, Op> _parseWrite(const BSONObj& doc) const;
+
     Status _applyWrite(OperationContext* opCtx,
-                       const BSONObj& doc,
+                       const KeyString::Value& keyString,
+                       Op opType,
                        const InsertDeleteOptions& options,
                        int64_t* const keysInserted,
                        int64_t* const keysDeleted);
@@ -54,6 +54,8 @@ S2AccessMethod::S2AccessMethod(IndexCatalogEntry* btreeState,
 
     ExpressionParams::initialize2dsphereParams(
         descriptor->infoObj(), btreeState->getCollator(), &_params);
+    _coveringCache = std::make_unique<S2CoveringCache>();
+    _params.coveringCache = _coveringCache.get();
 
     int geoFields = 0;
 
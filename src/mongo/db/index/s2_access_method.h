@@ -34,6 +34,7 @@
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/s2_common.h"
+#include "mongo/db/index/s2_covering_cache.h"
 #include "mongo/db/jsobj.h"
 
 namespace mongo {
@@ -73,6 +74,9 @@ private:
 
     S2IndexingParams _params;
 
+    // Shared by every key generation on this index, through '_params.coveringCache'.
+    std::unique_ptr<S2CoveringCache> _coveringCache;
+
     // Null if this index orders strings according to the simple binary compare. If non-null,
     // represents the collator used to generate index keys for indexed strings.
     const CollatorInterface* _collator;
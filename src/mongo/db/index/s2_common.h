@@ -41,6 +41,7 @@ class S2RegionCoverer;
 namespace mongo {
 
 class GeometryContainer;
+class S2CoveringCache;
 
 // An enum describing the version of an S2 index.
 enum S2IndexVersion {
@@ -77,6 +78,9 @@ struct S2IndexingParams {
     // Null if this index orders strings according to the simple binary compare. If non-null,
     // represents the collator used to generate index keys for indexed strings.
     const CollatorInterface* collator = nullptr;
+    // Null if coverings are computed anew for every geometry. If non-null, caches the coverings of
+    // large geometries for reuse by later documents. Owned by the index access method.
+    S2CoveringCache* coveringCache = nullptr;
 
     std::string toString() const;
 
@@ -0,0 +1,112 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/s2_covering_cache.h"
+
+#include <limits>
+
+#include "mongo/db/index/s2_covering_cache_gen.h"
+
+namespace mongo {
+
+S2CoveringCache::S2CoveringCache() : _cache(std::numeric_limits<size_t>::max()) {}
+
+bool S2CoveringCache::shouldCache(const BSONElement& geometry) {
+    const auto maxSizeMB = s2CoveringCacheMaxSizeMB.load();
+    return maxSizeMB > 0 && geometry.valuesize() >= s2CoveringCacheMinGeometryBytes.load();
+}
+
+std::string S2CoveringCache::_makeKey(const BSONElement& geometry) {
+    // The type byte is part of the key, so that an array of coordinate pairs never matches an
+    // object with the same bytes.
+    std::string key;
+    key.reserve(geometry.valuesize() + 1);
+    key.push_back(static_cast<char>(geometry.type()));
+    key.append(geometry.value(), geometry.valuesize());
+    return key;
+}
+
+size_t S2CoveringCache::_entrySize(const std::string& key, const std::vector<S2CellId>& cells) {
+    return sizeof(std::string) + key.capacity() + sizeof(cells) + cells.size() * sizeof(S2CellId);
+}
+
+bool S2CoveringCache::find(const BSONElement& geometry, std::vector<S2CellId>* out) {
+    const auto key = _makeKey(geometry);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _cache.find(key);
+    if (it == _cache.end()) {
+        ++_misses;
+        return false;
+    }
+
+    ++_hits;
+    *out = _cache.promote(it)->second;
+    return true;
+}
+
+void S2CoveringCache::add(const BSONElement& geometry, const std::vector<S2CellId>& cells) {
+    const size_t maxBytes = static_cast<size_t>(s2CoveringCacheMaxSizeMB.load()) * 1024 * 1024;
+    auto key = _makeKey(geometry);
+    const size_t entrySize = _entrySize(key, cells);
+    if (entrySize > maxBytes) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (auto it = _cache.find(key); it != _cache.end()) {
+        // Another thread computed the same covering concurrently.
+        _cache.promote(it);
+        return;
+    }
+
+    _bytes += entrySize;
+    _cache.add(std::move(key), cells);
+
+    // Iteration order runs from the most to the least recently used entry.
+    while (_bytes > maxBytes) {
+        auto lru = std::prev(_cache.end());
+        _bytes -= _entrySize(lru->first, lru->second);
+        _cache.erase(lru);
+    }
+}
+
+S2CoveringCache::Stats S2CoveringCache::getStats() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    Stats stats;
+    stats.hits = _hits;
+    stats.misses = _misses;
+    stats.entries = static_cast<long long>(_cache.size());
+    stats.bytes = static_cast<long long>(_bytes);
+    return stats;
+}
+
+}  // namespace mongo
@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonelement.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
+
+#include "third_party/s2/s2cellid.h"
+
+namespace mongo {
+
+/**
+ * A cache of the S2 cell coverings computed for large geometries in one 2dsphere index, keyed by
+ * the exact BSON of the geometry. Documents which share a shape, like a store boundary referenced
+ * by many delivery events, then pay for its covering just once. Entries are evicted in least
+ * recently used order once the cache outgrows 's2CoveringCacheMaxSizeMB'.
+ *
+ * This class is thread safe.
+ */
+class S2CoveringCache {
+    S2CoveringCache(const S2CoveringCache&) = delete;
+    S2CoveringCache& operator=(const S2CoveringCache&) = delete;
+
+public:
+    struct Stats {
+        long long hits = 0;
+        long long misses = 0;
+        long long entries = 0;
+        long long bytes = 0;
+    };
+
+    S2CoveringCache();
+
+    /**
+     * Returns true if the covering of 'geometry' is expensive enough to compute that it is worth
+     * caching, judging by its size against 's2CoveringCacheMinGeometryBytes'.
+     */
+    static bool shouldCache(const BSONElement& geometry);
+
+    /**
+     * Fills 'out' with the cached covering of 'geometry' and returns true, or returns false if
+     * there is none.
+     */
+    bool find(const BSONElement& geometry, std::vector<S2CellId>* out);
+
+    /**
+     * Caches 'cells' as the covering of 'geometry'.
+     */
+    void add(const BSONElement& geometry, const std::vector<S2CellId>& cells);
+
+    Stats getStats() const;
+
+private:
+    static std::string _makeKey(const BSONElement& geometry);
+
+    static size_t _entrySize(const std::string& key, const std::vector<S2CellId>& cells);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("S2CoveringCache::_mutex");
+
+    LRUCache<std::string, std::vector<S2CellId>> _cache;
+
+    // The approximate memory used by the entries of '_cache'.
+    size_t _bytes = 0;
+
+    long long _hits = 0;
+    long long _misses = 0;
+};
+
+}  // namespace mongo
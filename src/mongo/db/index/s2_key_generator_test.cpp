@@ -39,12 +39,17 @@
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/index/s2_common.h"
+#include "mongo/db/index/s2_covering_cache.h"
 #include "mongo/db/json.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/logv2/log.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/str.h"
 
+#include "third_party/s2/s2cell.h"
+#include "third_party/s2/s2latlng.h"
+#include "third_party/s2/s2regioncoverer.h"
+
 using namespace mongo;
 
 namespace {
@@ -647,4 +652,63 @@ TEST(S2KeyGeneratorTest, MidPathSingleElementArrayIsConsideredMultikey) {
     assertMultikeyPathsEqual(MultikeyPaths{{0U}, std::set<size_t>{}}, actualMultikeyPaths);
 }
 
+TEST(S2KeyGeneratorTest, PointCellIdMatchesRegionCoverer) {
+    for (auto&& [x, y] : std::vector<std::pair<int, int>>{{0, 0}, {3, 3}, {-73, 40}, {180, -90}}) {
+        S2RegionCoverer coverer;
+        coverer.set_min_level(S2::kMaxCellLevel);
+        coverer.set_max_level(S2::kMaxCellLevel);
+        std::vector<S2CellId> covering;
+        coverer.GetCovering(S2Cell(S2LatLng::FromDegrees(y, x).ToPoint()), &covering);
+
+        ASSERT_EQUALS(1U, covering.size());
+        ASSERT_EQUALS(static_cast<long long>(covering[0].id()), getCellID(x, y));
+    }
+}
+
+TEST(S2KeyGeneratorTest, CoveringCacheReusesCoveringOfRepeatedGeometry) {
+    // A polygon whose BSON is large enough for its covering to be cached.
+    BSONArrayBuilder ring;
+    const int kNumVertices = 100;
+    for (int i = 0; i < kNumVertices; ++i) {
+        const double angle = 2 * M_PI * i / kNumVertices;
+        ring.append(BSON_ARRAY(std::cos(angle) << std::sin(angle)));
+    }
+    ring.append(BSON_ARRAY(1.0 << 0.0));
+    BSONObj obj = BSON("a" << BSON("type"
+                                   << "Polygon"
+                                   << "coordinates" << BSON_ARRAY(ring.arr())));
+    ASSERT_TRUE(S2CoveringCache::shouldCache(obj["a"]));
+
+    BSONObj keyPattern = fromjson("{a: '2dsphere'}");
+    BSONObj infoObj = fromjson("{key: {a: '2dsphere'}, '2dsphereIndexVersion': 3}");
+    S2IndexingParams params;
+    ExpressionParams::initialize2dsphereParams(infoObj, nullptr, &params);
+
+    auto getKeys = [&] {
+        KeyStringSet keys;
+        ExpressionKeysPrivate::getS2Keys(obj,
+                                         keyPattern,
+                                         params,
+                                         &keys,
+                                         nullptr,
+                                         KeyString::Version::kLatestVersion,
+                                         Ordering::make(BSONObj()));
+        return keys;
+    };
+
+    const auto uncachedKeys = getKeys();
+    ASSERT_GT(uncachedKeys.size(), 1U);
+
+    S2CoveringCache cache;
+    params.coveringCache = &cache;
+    ASSERT_TRUE(areKeysetsEqual(uncachedKeys, getKeys()));
+    ASSERT_TRUE(areKeysetsEqual(uncachedKeys, getKeys()));
+
+    auto stats = cache.getStats();
+    ASSERT_EQUALS(1, stats.misses);
+    ASSERT_EQUALS(1, stats.hits);
+    ASSERT_EQUALS(1, stats.entries);
+    ASSERT_GT(stats.bytes, 0);
+}
+
 }  // namespace
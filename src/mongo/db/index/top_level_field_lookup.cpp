@@ -0,0 +1,74 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/top_level_field_lookup.h"
+
+#include <algorithm>
+
+namespace mongo {
+
+TopLevelFieldLookup::TopLevelFieldLookup(std::vector<std::string> fieldNames)
+    : _fieldNames(std::move(fieldNames)) {
+    std::sort(_fieldNames.begin(), _fieldNames.end());
+    _fieldNames.erase(std::unique(_fieldNames.begin(), _fieldNames.end()), _fieldNames.end());
+    _elements.resize(_fieldNames.size());
+}
+
+void TopLevelFieldLookup::setDocument(const BSONObj& obj) {
+    std::fill(_elements.begin(), _elements.end(), BSONElement());
+
+    size_t numFound = 0;
+    for (auto&& elem : obj) {
+        auto it = std::lower_bound(
+            _fieldNames.begin(), _fieldNames.end(), elem.fieldNameStringData(), std::less<>());
+        if (it == _fieldNames.end() || *it != elem.fieldNameStringData()) {
+            continue;
+        }
+        auto& found = _elements[it - _fieldNames.begin()];
+        if (found.eoo()) {
+            found = elem;
+            if (++numFound == _fieldNames.size()) {
+                break;
+            }
+        }
+    }
+}
+
+bool TopLevelFieldLookup::find(StringData fieldName, BSONElement* elem) const {
+    auto it = std::lower_bound(_fieldNames.begin(), _fieldNames.end(), fieldName, std::less<>());
+    if (it == _fieldNames.end() || *it != fieldName) {
+        return false;
+    }
+    *elem = _elements[it - _fieldNames.begin()];
+    return true;
+}
+
+}  // namespace mongo
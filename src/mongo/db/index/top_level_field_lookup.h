@@ -0,0 +1,72 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+/**
+ * Looks up a fixed set of top-level fields of a document in a single pass over the document. When
+ * several indexes are built together, their key generators can share one lookup per document
+ * rather than each scanning the document for its own fields.
+ *
+ * The elements returned point into the document passed to setDocument(), which must outlive them.
+ */
+class TopLevelFieldLookup {
+public:
+    explicit TopLevelFieldLookup(std::vector<std::string> fieldNames);
+
+    /**
+     * Finds the tracked fields of 'obj'. As with BSONObj::getField(), the first occurrence of a
+     * duplicated field name wins.
+     */
+    void setDocument(const BSONObj& obj);
+
+    /**
+     * Sets '*elem' to the field named 'fieldName' in the current document, or to EOO if the
+     * document does not have the field. Returns false if 'fieldName' is not tracked.
+     */
+    bool find(StringData fieldName, BSONElement* elem) const;
+
+private:
+    // Sorted and without duplicates.
+    std::vector<std::string> _fieldNames;
+
+    // The element of the current document for each entry of '_fieldNames'.
+    std::vector<BSONElement> _elements;
+};
+
+}  // namespace mongo
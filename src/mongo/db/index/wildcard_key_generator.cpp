@@ -44,22 +44,18 @@ namespace {
 // to prevent the _id field from being indexed, since it already has its own dedicated index.
 static const BSONObj kDefaultProjection = BSON("_id"_sd << 0);
 
-// If the enclosing object is an array, then the current element's fieldname is the array index, so
-// we omit this when computing the full path. Otherwise, the full path is the pathPrefix plus the
-// element's fieldname.
-void pushPathComponent(BSONElement elem, bool enclosingObjIsArray, FieldRef* pathPrefix) {
-    if (!enclosingObjIsArray) {
-        pathPrefix->appendPart(elem.fieldNameStringData());
-    }
-}
+// Holds the element used as the key value for an object that is empty after projection.
+static const BSONObj kEmptyObjectHolder = BSON("" << BSONObj());
 
-// If the enclosing object is not an array, then the final path component should be its field name.
-// Verify that this is the case and then pop it off the FieldRef.
-void popPathComponent(BSONElement elem, bool enclosingObjIsArray, FieldRef* pathToElem) {
-    if (!enclosingObjIsArray) {
-        invariant(pathToElem->getPart(pathToElem->numParts() - 1) == elem.fieldNameStringData());
-        pathToElem->removeLastPart();
+// Appends 'field' to the dotted path 'path', returning the length of the path beforehand so that
+// the caller can truncate back to it once done with the field.
+size_t pushPathComponent(StringData field, std::string* path) {
+    const size_t prevSize = path->size();
+    if (prevSize) {
+        path->push_back('.');
     }
+    path->append(field.rawData(), field.size());
+    return prevSize;
 }
 }  // namespace
 
@@ -102,98 +98,161 @@ WildcardKeyGenerator::WildcardKeyGenerator(BSONObj keyPattern,
                                            KeyString::Version keyStringVersion,
                                            Ordering ordering)
     : _proj(createProjectionExecutor(keyPattern, pathProjection)),
+      _projIsInclusion(_proj.exec()->getType() ==
+                       TransformerInterface::TransformerType::kInclusionProjection),
       _collator(collator),
       _keyPattern(keyPattern),
       _keyStringVersion(keyStringVersion),
-      _ordering(ordering) {}
+      _ordering(ordering) {
+    _projTrie =
+        _buildProjectionTrie(_proj.exec()->serializeTransformation(boost::none), _projIsInclusion);
+}
+
+std::unique_ptr<WildcardKeyGenerator::ProjectionTrieNode>
+WildcardKeyGenerator::_buildProjectionTrie(const Document& projSpec, bool isInclusion) {
+    // The serialized projection is a tree of booleans, such as {_id: false, a: {b: true}}. Only
+    // the leaves which match the kind of projection are of interest; the others, like the
+    // explicit '_id: false' of an inclusion projection, leave the field out either way.
+    auto node = std::make_unique<ProjectionTrieNode>();
+    for (auto it = projSpec.fieldIterator(); it.more();) {
+        auto&& [fieldName, value] = it.next();
+        if (value.getType() == BSONType::Object) {
+            node->children.emplace(fieldName.toString(),
+                                   _buildProjectionTrie(value.getDocument(), isInclusion));
+        } else if (value.coerceToBool() == isInclusion) {
+            node->children.emplace(fieldName.toString(), nullptr);
+        }
+    }
+    return node;
+}
 
 void WildcardKeyGenerator::generateKeys(BSONObj inputDoc,
                                         KeyStringSet* keys,
                                         KeyStringSet* multikeyPaths,
                                         boost::optional<RecordId> id) const {
-    FieldRef rootPath;
-    _traverseWildcard(_proj.exec()->applyTransformation(Document{inputDoc}).toBson(),
-                      false,
-                      &rootPath,
-                      keys,
-                      multikeyPaths,
-                      id);
+    std::string rootPath;
+    _traverseWildcard(inputDoc, false, _projTrie.get(), &rootPath, keys, multikeyPaths, id);
 }
 
-void WildcardKeyGenerator::_traverseWildcard(BSONObj obj,
+bool WildcardKeyGenerator::_traverseWildcard(BSONObj obj,
                                              bool objIsArray,
-                                             FieldRef* path,
+                                             const ProjectionTrieNode* node,
+                                             std::string* path,
                                              KeyStringSet* keys,
                                              KeyStringSet* multikeyPaths,
                                              boost::optional<RecordId> id) const {
-    for (const auto elem : obj) {
-        // If the element's fieldName contains a ".", fast-path skip it because it's not queryable.
-        if (elem.fieldNameStringData().find('.', 0) != std::string::npos)
-            continue;
+    // This mirrors the semantics of the wildcard projection executor. An inclusion projection
+    // keeps only the projected fields of an object, stops reading it once all of them have been
+    // seen, and applies the same node to each object in an array while dropping scalars and nested
+    // arrays. An exclusion projection keeps everything except the projected fields, and leaves
+    // scalars and nested arrays within an array untouched.
+    bool projectedAny = false;
+    size_t fieldsNeeded = (node && _projIsInclusion) ? node->children.size() : 0;
 
-        // Append the element's fieldname to the path, if the enclosing object is not an array.
-        pushPathComponent(elem, objIsArray, path);
+    for (const auto elem : obj) {
+        const ProjectionTrieNode* childNode = nullptr;
+        if (node && objIsArray) {
+            if (elem.type() == BSONType::Object) {
+                childNode = node;
+            } else if (_projIsInclusion) {
+                continue;
+            }
+        } else if (node) {
+            if (_projIsInclusion && fieldsNeeded == 0) {
+                break;
+            }
 
-        switch (elem.type()) {
-            case BSONType::Array:
-                // If this is a nested array, we don't descend it but instead index it as a value.
-                if (_addKeyForNestedArray(elem, *path, objIsArray, keys, id))
-                    break;
+            auto childIt = node->children.find(elem.fieldNameStringData());
+            if (childIt == node->children.end()) {
+                if (_projIsInclusion) {
+                    continue;
+                }
+            } else {
+                if (_projIsInclusion) {
+                    --fieldsNeeded;
+                } else if (!childIt->second) {
+                    continue;
+                }
 
-                // Add an entry for the multi-key path, and then fall through to BSONType::Object.
-                _addMultiKey(*path, multikeyPaths);
+                // A projection over a subpath of a scalar keeps the scalar for an exclusion, and
+                // drops it for an inclusion.
+                if (childIt->second && elem.isABSONObj()) {
+                    childNode = childIt->second.get();
+                } else if (childIt->second && _projIsInclusion) {
+                    continue;
+                }
+            }
+        }
 
-            case BSONType::Object:
-                if (_addKeyForEmptyLeaf(elem, *path, keys, id))
-                    break;
+        projectedAny = true;
 
-                _traverseWildcard(
-                    elem.Obj(), elem.type() == BSONType::Array, path, keys, multikeyPaths, id);
-                break;
+        // If the element's fieldName contains a ".", fast-path skip it because it's not queryable.
+        if (!objIsArray && elem.fieldNameStringData().find('.', 0) != std::string::npos)
+            continue;
 
-            default:
-                _addKey(elem, *path, keys, id);
+        // Append the element's fieldname to the path, if the enclosing object is not an array. In
+        // the array case the current element's fieldname is the array index, so we omit it.
+        if (objIsArray) {
+            _traverseElement(elem, true, childNode, path, keys, multikeyPaths, id);
+        } else {
+            const size_t prevSize = pushPathComponent(elem.fieldNameStringData(), path);
+            _traverseElement(elem, false, childNode, path, keys, multikeyPaths, id);
+            path->resize(prevSize);
         }
-
-        // Remove the element's fieldname from the path, if it was pushed onto it earlier.
-        popPathComponent(elem, objIsArray, path);
     }
-}
 
-bool WildcardKeyGenerator::_addKeyForNestedArray(BSONElement elem,
-                                                 const FieldRef& fullPath,
-                                                 bool enclosingObjIsArray,
-                                                 KeyStringSet* keys,
-                                                 boost::optional<RecordId> id) const {
-    // If this element is an array whose parent is also an array, index it as a value.
-    if (enclosingObjIsArray && elem.type() == BSONType::Array) {
-        _addKey(elem, fullPath, keys, id);
-        return true;
-    }
-    return false;
+    return projectedAny;
 }
 
-bool WildcardKeyGenerator::_addKeyForEmptyLeaf(BSONElement elem,
-                                               const FieldRef& fullPath,
-                                               KeyStringSet* keys,
-                                               boost::optional<RecordId> id) const {
-    invariant(elem.isABSONObj());
-    if (elem.embeddedObject().isEmpty()) {
-        // In keeping with the behaviour of regular indexes, an empty object is indexed as-is while
-        // empty arrays are indexed as 'undefined'.
-        _addKey(elem.type() == BSONType::Array ? BSONElement{} : elem, fullPath, keys, id);
-        return true;
+void WildcardKeyGenerator::_traverseElement(BSONElement elem,
+                                            bool enclosingObjIsArray,
+                                            const ProjectionTrieNode* node,
+                                            std::string* path,
+                                            KeyStringSet* keys,
+                                            KeyStringSet* multikeyPaths,
+                                            boost::optional<RecordId> id) const {
+    switch (elem.type()) {
+        case BSONType::Array:
+            // If this is a nested array, we don't descend it but instead index it as a value.
+            if (enclosingObjIsArray) {
+                _addKey(elem, *path, keys, id);
+                break;
+            }
+
+            // Add an entry for the multi-key path, and then fall through to BSONType::Object.
+            _addMultiKey(*path, multikeyPaths);
+
+        case BSONType::Object:
+            if (!_traverseWildcard(elem.Obj(),
+                                   elem.type() == BSONType::Array,
+                                   node,
+                                   path,
+                                   keys,
+                                   multikeyPaths,
+                                   id)) {
+                // In keeping with the behaviour of regular indexes, an empty object is indexed
+                // as-is while empty arrays are indexed as 'undefined'. The object may only be
+                // empty after projection, so index an empty object rather than 'elem' itself.
+                _addKey(elem.type() == BSONType::Array ? BSONElement{}
+                                                       : kEmptyObjectHolder.firstElement(),
+                        *path,
+                        keys,
+                        id);
+            }
+            break;
+
+        default:
+            _addKey(elem, *path, keys, id);
     }
-    return false;
 }
 
 void WildcardKeyGenerator::_addKey(BSONElement elem,
-                                   const FieldRef& fullPath,
+                                   StringData fullPath,
                                    KeyStringSet* keys,
                                    boost::optional<RecordId> id) const {
     // Wildcard keys are of the form { "": "path.to.field", "": <collation-aware value> }.
     KeyString::HeapBuilder keyString(_keyStringVersion, _ordering);
-    keyString.appendString(fullPath.dottedField());
+    keyString.appendString(fullPath);
     if (_collator && elem) {
         keyString.appendBSONElement(elem, [&](StringData stringData) {
             return _collator->getComparisonString(stringData);
@@ -210,13 +269,12 @@ void WildcardKeyGenerator::_addKey(BSONElement elem,
     keys->insert(keyString.release());
 }
 
-void WildcardKeyGenerator::_addMultiKey(const FieldRef& fullPath,
-                                        KeyStringSet* multikeyPaths) const {
+void WildcardKeyGenerator::_addMultiKey(StringData fullPath, KeyStringSet* multikeyPaths) const {
     // Multikey paths are denoted by a key of the form { "": 1, "": "path.to.array" }. The argument
     // 'multikeyPaths' may be nullptr if the access method is being used in an operation which does
     // not require multikey path generation.
     if (multikeyPaths) {
-        auto key = BSON("" << 1 << "" << fullPath.dottedField());
+        auto key = BSON("" << 1 << "" << fullPath);
         KeyString::HeapBuilder keyString(
             _keyStringVersion,
             key,
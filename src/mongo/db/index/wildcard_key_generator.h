@@ -34,6 +34,7 @@
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/sorted_data_interface.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -80,33 +81,49 @@ public:
                       boost::optional<RecordId> id = boost::none) const;
 
 private:
-    // Traverses every path of the post-projection document, adding keys to the set as it goes.
-    void _traverseWildcard(BSONObj obj,
+    /**
+     * The wildcard projection compiled into a trie of field names. This lets the key generator
+     * apply the projection while it walks the input document, rather than materializing the
+     * projected document first. A child which is null marks a path projected in its entirety:
+     * included wholesale by an inclusion projection, or dropped by an exclusion projection.
+     */
+    struct ProjectionTrieNode {
+        StringMap<std::unique_ptr<ProjectionTrieNode>> children;
+    };
+
+    static std::unique_ptr<ProjectionTrieNode> _buildProjectionTrie(const Document& projSpec,
+                                                                    bool isInclusion);
+
+    // Traverses every path of 'obj' which survives the projection described by 'node', adding
+    // keys to the set as it goes. A null 'node' means that all of 'obj' survives. Returns false if
+    // the projection would leave nothing of 'obj', i.e. if the projected object or array is empty.
+    bool _traverseWildcard(BSONObj obj,
                            bool objIsArray,
-                           FieldRef* path,
+                           const ProjectionTrieNode* node,
+                           std::string* path,
                            KeyStringSet* keys,
                            KeyStringSet* multikeyPaths,
                            boost::optional<RecordId> id) const;
 
+    // Adds the keys for a single element of the projected document, found at 'path'.
+    void _traverseElement(BSONElement elem,
+                          bool enclosingObjIsArray,
+                          const ProjectionTrieNode* node,
+                          std::string* path,
+                          KeyStringSet* keys,
+                          KeyStringSet* multikeyPaths,
+                          boost::optional<RecordId> id) const;
+
     // Helper functions to format the entry appropriately before adding it to the key/path tracker.
-    void _addMultiKey(const FieldRef& fullPath, KeyStringSet* multikeyPaths) const;
+    void _addMultiKey(StringData fullPath, KeyStringSet* multikeyPaths) const;
     void _addKey(BSONElement elem,
-                 const FieldRef& fullPath,
+                 StringData fullPath,
                  KeyStringSet* keys,
                  boost::optional<RecordId> id) const;
 
-    // Helper to check whether the element is a nested array, and conditionally add it to 'keys'.
-    bool _addKeyForNestedArray(BSONElement elem,
-                               const FieldRef& fullPath,
-                               bool enclosingObjIsArray,
-                               KeyStringSet* keys,
-                               boost::optional<RecordId> id) const;
-    bool _addKeyForEmptyLeaf(BSONElement elem,
-                             const FieldRef& fullPath,
-                             KeyStringSet* keys,
-                             boost::optional<RecordId> id) const;
-
     WildcardProjection _proj;
+    std::unique_ptr<ProjectionTrieNode> _projTrie;
+    bool _projIsInclusion;
     const CollatorInterface* _collator;
     const BSONObj _keyPattern;
     const KeyString::Version _keyStringVersion;
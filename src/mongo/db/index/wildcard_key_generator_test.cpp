@@ -1161,5 +1161,131 @@ TEST(WildcardKeyGeneratorDottedFieldsTest, DoNotIndexDottedFieldsWithSimilarSubp
     ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
 }
 
+// Tests which check that the projection is applied during the traversal exactly as it would be by
+// the projection executor.
+
+TEST(WildcardKeyGeneratorProjectionTraversalTest, InclusionDropsScalarsAndNestedArraysInArrays) {
+    WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"),
+                                fromjson("{'a.b': 1}"),
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSONObj())};
+
+    auto inputDoc = fromjson("{a: [1, {b: 2}, [{b: 3}], {c: 4}]}");
+
+    auto expectedKeys =
+        makeKeySet({fromjson("{'': 'a.b', '': 2}"), fromjson("{'': 'a', '': {}}")});
+    auto expectedMultikeyPaths =
+        makeKeySet({fromjson("{'': 1, '': 'a'}")},
+                   RecordId{RecordId::ReservedId::kWildcardMultikeyMetadataId});
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeys(inputDoc, &outputKeys, &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+}
+
+TEST(WildcardKeyGeneratorProjectionTraversalTest, InclusionIndexesObjectsEmptiedByProjection) {
+    WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"),
+                                fromjson("{'a.b': 1, 'c.d': 1, 'e.f': 1}"),
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSONObj())};
+
+    auto inputDoc = fromjson("{a: {x: 1}, c: [1, 2], e: 3, g: 4}");
+
+    auto expectedKeys =
+        makeKeySet({fromjson("{'': 'a', '': {}}"), fromjson("{'': 'c', '': undefined}")});
+    auto expectedMultikeyPaths =
+        makeKeySet({fromjson("{'': 1, '': 'c'}")},
+                   RecordId{RecordId::ReservedId::kWildcardMultikeyMetadataId});
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeys(inputDoc, &outputKeys, &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+}
+
+TEST(WildcardKeyGeneratorProjectionTraversalTest, ExclusionKeepsScalarsAndNestedArraysInArrays) {
+    WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"),
+                                fromjson("{'a.b': 0}"),
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSONObj())};
+
+    auto inputDoc = fromjson("{a: [1, {b: 2, c: 3}, [{b: 4}], {b: 5}], b: 6}");
+
+    auto expectedKeys = makeKeySet({fromjson("{'': 'a', '': 1}"),
+                                    fromjson("{'': 'a.c', '': 3}"),
+                                    fromjson("{'': 'a', '': [{b: 4}]}"),
+                                    fromjson("{'': 'a', '': {}}"),
+                                    fromjson("{'': 'b', '': 6}")});
+    auto expectedMultikeyPaths =
+        makeKeySet({fromjson("{'': 1, '': 'a'}")},
+                   RecordId{RecordId::ReservedId::kWildcardMultikeyMetadataId});
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeys(inputDoc, &outputKeys, &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+}
+
+TEST(WildcardKeyGeneratorProjectionTraversalTest, KeysMatchThoseOfTheProjectedDocument) {
+    const std::vector<std::pair<BSONObj, BSONObj>> specs = {
+        {fromjson("{'a.$**': 1}"), BSONObj()},
+        {fromjson("{'a.b.$**': 1}"), BSONObj()},
+        {fromjson("{'$**': 1}"), fromjson("{a: 1, 'b.c': 1}")},
+        {fromjson("{'$**': 1}"), fromjson("{'a.b': 1, 'a.c.d': 1, e: 1}")},
+        {fromjson("{'$**': 1}"), fromjson("{a: 0, 'b.c': 0}")},
+        {fromjson("{'$**': 1}"), fromjson("{'a.b': 0, 'a.c.d': 0}")}};
+    const std::vector<BSONObj> docs = {
+        fromjson("{a: 1, b: 2, e: 3}"),
+        fromjson("{a: {}, b: {}, e: {}}"),
+        fromjson("{a: {b: 1, c: {d: 2, e: 3}, f: 4}, b: {c: [1, {c: 2}], d: 5}}"),
+        fromjson("{a: [1, {b: 2}, [{b: 3}], {c: [{d: 4}, 5, [6]]}], b: [{c: 7, x: 8}, 9, [10]]}"),
+        fromjson("{a: {b: [], c: []}, b: [], e: [[]]}"),
+        fromjson("{a: {'b.c': 1, b: {'x.y': 2}}, 'a.b': 3, e: {'f.g': 4}}"),
+        fromjson("{e: [{f: 1}, []], a: [[{b: 1}], {c: {d: {e: 4}}}]}")};
+
+    // Generates the keys for the document as produced by the projection executor, using a key
+    // generator whose projection has no effect on that document.
+    WildcardKeyGenerator fullDocKeyGen{fromjson("{'$**': 1}"),
+                                       {},
+                                       nullptr,
+                                       KeyString::Version::kLatestVersion,
+                                       Ordering::make(BSONObj())};
+
+    for (auto&& [keyPattern, pathProjection] : specs) {
+        WildcardKeyGenerator keyGen{keyPattern,
+                                    pathProjection,
+                                    nullptr,
+                                    KeyString::Version::kLatestVersion,
+                                    Ordering::make(BSONObj())};
+        for (auto&& doc : docs) {
+            auto projected =
+                keyGen.getWildcardProjection()->exec()->applyTransformation(Document{doc}).toBson();
+
+            auto expectedKeys = makeKeySet();
+            auto expectedMultikeyPaths = makeKeySet();
+            fullDocKeyGen.generateKeys(projected, &expectedKeys, &expectedMultikeyPaths);
+
+            auto outputKeys = makeKeySet();
+            auto multikeyMetadataKeys = makeKeySet();
+            keyGen.generateKeys(doc, &outputKeys, &multikeyMetadataKeys);
+
+            ASSERT(assertKeysetsEqual(expectedKeys, outputKeys))
+                << keyPattern << " " << pathProjection << " " << doc;
+            ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys))
+                << keyPattern << " " << pathProjection << " " << doc;
+        }
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -324,6 +324,9 @@ MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
             lv2Config.fileOpenMode = serverGlobalParams.logAppend
                 ? logv2::LogDomainGlobal::ConfigurationOptions::OpenMode::kAppend
                 : logv2::LogDomainGlobal::ConfigurationOptions::OpenMode::kTruncate;
+            lv2Config.fileAsyncBufferSizeBytes =
+                static_cast<size_t>(gLogAsyncBufferSizeKB) * 1024;
+            lv2Config.fileAsyncBlockOnOverflow = gLogAsyncBlockOnOverflow;
 
             if (serverGlobalParams.logAppend && exists) {
                 writeServerRestartedAfterLogConfig = true;
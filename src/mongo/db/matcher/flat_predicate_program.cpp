@@ -0,0 +1,134 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/flat_predicate_program.h"
+
+#include <algorithm>
+
+namespace mongo {
+
+namespace {
+
+bool isSupportedLeaf(const MatchExpression* expr) {
+    switch (expr->matchType()) {
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+        case MatchExpression::MATCH_IN:
+            break;
+        default:
+            return false;
+    }
+
+    // Dotted paths may traverse arrays in the middle of the path, which the single pass over the
+    // top-level fields of the document does not handle.
+    auto path = expr->path();
+    return !path.empty() && path.find('.') == std::string::npos;
+}
+
+}  // namespace
+
+std::unique_ptr<FlatPredicateProgram> FlatPredicateProgram::compile(const MatchExpression* expr) {
+    if (!expr) {
+        return nullptr;
+    }
+
+    std::unique_ptr<FlatPredicateProgram> program(new FlatPredicateProgram());
+    if (expr->matchType() == MatchExpression::AND) {
+        if (expr->numChildren() == 0) {
+            return nullptr;
+        }
+        for (size_t i = 0; i < expr->numChildren(); ++i) {
+            if (!program->_addPredicate(expr->getChild(i))) {
+                return nullptr;
+            }
+        }
+    } else if (!program->_addPredicate(expr)) {
+        return nullptr;
+    }
+    return program;
+}
+
+bool FlatPredicateProgram::_addPredicate(const MatchExpression* leaf) {
+    if (!isSupportedLeaf(leaf)) {
+        return false;
+    }
+
+    auto path = leaf->path();
+    auto it = std::find(_fieldNames.begin(), _fieldNames.end(), path);
+    size_t slot = it - _fieldNames.begin();
+    if (it == _fieldNames.end()) {
+        if (_fieldNames.size() == kMaxFields) {
+            return false;
+        }
+        _fieldNames.push_back(path);
+    }
+    _predicates.push_back({leaf, slot});
+    return true;
+}
+
+bool FlatPredicateProgram::matchesBSON(const BSONObj& doc) const {
+    // Elements which are not found stay EOO, which is also what the ElementPath based evaluation
+    // passes to matchesSingleElement() for a missing top-level field.
+    std::array<BSONElement, kMaxFields> slots;
+    const size_t numFields = _fieldNames.size();
+    size_t numFound = 0;
+
+    for (auto&& elem : doc) {
+        auto fieldName = elem.fieldNameStringData();
+        for (size_t i = 0; i < numFields; ++i) {
+            // Only the first occurrence of a field name is visible to the MatchExpression.
+            if (slots[i].eoo() && _fieldNames[i] == fieldName) {
+                slots[i] = elem;
+                ++numFound;
+                break;
+            }
+        }
+        if (numFound == numFields) {
+            break;
+        }
+    }
+
+    for (auto&& predicate : _predicates) {
+        const BSONElement& elem = slots[predicate.slot];
+        const bool matches = elem.type() == BSONType::Array
+            ? predicate.leaf->matchesBSON(doc)
+            : predicate.leaf->matchesSingleElement(elem);
+        if (!matches) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace mongo
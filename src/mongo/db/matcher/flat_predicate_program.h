@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/matcher/expression.h"
+
+namespace mongo {
+
+/**
+ * A FlatPredicateProgram is a compiled form of a conjunction of simple comparisons against
+ * top-level fields, such as {a: 1, b: {$gt: 5}, c: {$in: [1, 2, 3]}}.
+ *
+ * Evaluating the MatchExpression tree walks the document once per leaf, through an ElementPath
+ * and a BSONElementIterator. The program instead locates every referenced field in a single pass
+ * over the document, and then evaluates each comparison against the element it found. Fields
+ * which turn out to be arrays require the full implicit array traversal semantics, so the leaves
+ * which reference them are evaluated through the MatchExpression as usual.
+ *
+ * The program holds pointers into the MatchExpression it was compiled from, which must outlive
+ * it and must not be modified after the program is compiled.
+ */
+class FlatPredicateProgram {
+public:
+    // The maximum number of distinct top-level fields that a program can reference.
+    static constexpr size_t kMaxFields = 32;
+
+    /**
+     * Returns a program equivalent to 'expr', or nullptr if 'expr' is not a supported shape. A
+     * supported shape is either a single supported leaf or an $and whose children are all
+     * supported leaves. The supported leaves are $eq, $lt, $lte, $gt, $gte and $in over a
+     * non-empty, non-dotted path.
+     */
+    static std::unique_ptr<FlatPredicateProgram> compile(const MatchExpression* expr);
+
+    /**
+     * Returns the same result as calling matchesBSON() on the MatchExpression this program was
+     * compiled from.
+     */
+    bool matchesBSON(const BSONObj& doc) const;
+
+    size_t numFields() const {
+        return _fieldNames.size();
+    }
+
+    size_t numPredicates() const {
+        return _predicates.size();
+    }
+
+private:
+    struct Predicate {
+        // The leaf to evaluate. Not owned.
+        const MatchExpression* leaf;
+
+        // Index into '_fieldNames' of the field which 'leaf' compares against.
+        size_t slot;
+    };
+
+    FlatPredicateProgram() = default;
+
+    /**
+     * Adds 'leaf' to the program. Returns false if 'leaf' is not supported or would cause the
+     * program to reference too many fields.
+     */
+    bool _addPredicate(const MatchExpression* leaf);
+
+    // The distinct field names referenced by the program. These point into the paths of the
+    // compiled MatchExpression.
+    std::vector<StringData> _fieldNames;
+
+    // The predicates, in the order they appear in the compiled MatchExpression.
+    std::vector<Predicate> _predicates;
+};
+
+}  // namespace mongo
@@ -0,0 +1,137 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/flat_predicate_program.h"
+
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<MatchExpression> parse(const char* json) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto expr = MatchExpressionParser::parse(fromjson(json), expCtx);
+    ASSERT_OK(expr.getStatus());
+    return MatchExpression::optimize(std::move(expr.getValue()));
+}
+
+std::vector<BSONObj> sampleDocuments() {
+    return {fromjson("{}"),
+            fromjson("{a: 1}"),
+            fromjson("{a: 1, b: 2, c: 3}"),
+            fromjson("{c: 3, b: 2, a: 1}"),
+            fromjson("{a: 2, b: 7, c: 'foo'}"),
+            fromjson("{a: [1, 2, 3], b: 6}"),
+            fromjson("{a: [[1], 4], b: [6, 7]}"),
+            fromjson("{a: null, b: 6}"),
+            fromjson("{a: 1, a: 5, b: 6}"),
+            fromjson("{a: {b: 1}, b: 6}"),
+            fromjson("{x: 1, y: 2, z: 3, b: 10}")};
+}
+
+/**
+ * Asserts that 'json' compiles to a program and that the program agrees with the MatchExpression
+ * on every sample document.
+ */
+void assertEquivalent(const char* json) {
+    auto expr = parse(json);
+    auto program = FlatPredicateProgram::compile(expr.get());
+    ASSERT(program) << json;
+    for (auto&& doc : sampleDocuments()) {
+        ASSERT_EQ(expr->matchesBSON(doc), program->matchesBSON(doc))
+            << "query: " << json << ", document: " << doc;
+    }
+}
+
+TEST(FlatPredicateProgramTest, SingleLeaf) {
+    assertEquivalent("{a: 1}");
+    assertEquivalent("{a: {$gt: 1}}");
+    assertEquivalent("{a: {$lte: 2}}");
+    assertEquivalent("{a: {$in: [2, 5]}}");
+    assertEquivalent("{a: null}");
+}
+
+TEST(FlatPredicateProgramTest, Conjunction) {
+    auto expr = parse("{a: {$gte: 1}, b: {$lt: 7}, c: {$in: [3, 'foo']}, a: {$lt: 2}}");
+    auto program = FlatPredicateProgram::compile(expr.get());
+    ASSERT(program);
+    ASSERT_EQ(3U, program->numFields());
+    ASSERT_EQ(4U, program->numPredicates());
+
+    assertEquivalent("{a: {$gte: 1}, b: {$lt: 7}, c: {$in: [3, 'foo']}}");
+    assertEquivalent("{a: 1, b: 6}");
+    assertEquivalent("{a: {$in: [[1], 4]}, b: {$gt: 6}}");
+    assertEquivalent("{b: {$gte: 6}, a: null}");
+}
+
+TEST(FlatPredicateProgramTest, ArraysFallBackToFullTraversal) {
+    auto expr = parse("{a: 2, b: 6}");
+    auto program = FlatPredicateProgram::compile(expr.get());
+    ASSERT(program);
+    ASSERT_TRUE(program->matchesBSON(fromjson("{a: [1, 2, 3], b: 6}")));
+    ASSERT_TRUE(program->matchesBSON(fromjson("{a: 2, b: [5, 6]}")));
+    ASSERT_FALSE(program->matchesBSON(fromjson("{a: [1, 3], b: 6}")));
+}
+
+TEST(FlatPredicateProgramTest, OnlyFirstOccurrenceOfAFieldIsConsidered) {
+    auto expr = parse("{a: 5}");
+    auto program = FlatPredicateProgram::compile(expr.get());
+    ASSERT(program);
+    auto doc = fromjson("{a: 1, a: 5}");
+    ASSERT_FALSE(expr->matchesBSON(doc));
+    ASSERT_FALSE(program->matchesBSON(doc));
+}
+
+TEST(FlatPredicateProgramTest, UnsupportedShapesDoNotCompile) {
+    ASSERT_FALSE(FlatPredicateProgram::compile(nullptr));
+    ASSERT_FALSE(FlatPredicateProgram::compile(parse("{'a.b': 1}").get()));
+    ASSERT_FALSE(FlatPredicateProgram::compile(parse("{a: {$exists: true}}").get()));
+    ASSERT_FALSE(FlatPredicateProgram::compile(parse("{$or: [{a: 1}, {b: 1}]}").get()));
+    ASSERT_FALSE(FlatPredicateProgram::compile(parse("{a: 1, b: {$ne: 1}}").get()));
+    ASSERT_FALSE(FlatPredicateProgram::compile(parse("{a: /foo/}").get()));
+}
+
+TEST(FlatPredicateProgramTest, TooManyFieldsDoNotCompile) {
+    BSONObjBuilder bob;
+    for (size_t i = 0; i <= FlatPredicateProgram::kMaxFields; ++i) {
+        bob.append(str::stream() << "f" << i, 1);
+    }
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto expr = MatchExpressionParser::parse(bob.obj(), expCtx);
+    ASSERT_OK(expr.getStatus());
+    ASSERT_FALSE(FlatPredicateProgram::compile(expr.getValue().get()));
+}
+
+}  // namespace
+}  // namespace mongo
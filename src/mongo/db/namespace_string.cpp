@@ -62,6 +62,10 @@ const NamespaceString NamespaceString::kLogicalSessionsNamespace(NamespaceString
 const NamespaceString NamespaceString::kSessionTransactionsTableNamespace(
     NamespaceString::kConfigDb, "transactions");
 
+// Pre- and post-images of retryable findAndModify operations, one per session.
+const NamespaceString NamespaceString::kConfigImagesNamespace(NamespaceString::kConfigDb,
+                                                              "image_collection");
+
 // Persisted state for a shard coordinating a cross-shard transaction.
 const NamespaceString NamespaceString::kTransactionCoordinatorsNamespace(
     NamespaceString::kConfigDb, "transaction_coordinators");
@@ -78,6 +78,10 @@ public:
     // Namespace for storing the transaction information for each session
     static const NamespaceString kSessionTransactionsTableNamespace;
 
+    // Namespace for storing the pre- or post-image of the latest retryable findAndModify of each
+    // session
+    static const NamespaceString kConfigImagesNamespace;
+
     // Name for a shard's collections metadata collection, each document of which indicates the
     // state of a specific collection
     static const NamespaceString kShardConfigCollectionsNamespace;
@@ -36,6 +36,7 @@
 #include <limits>
 
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_holder.h"
@@ -52,6 +53,7 @@
 #include "mongo/db/read_write_concern_defaults.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_entry_gen.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/server_options.h"
@@ -146,6 +148,30 @@ struct OpTimeBundle {
     Date_t wallClockTime;
 };
 
+/**
+ * Returns whether the image of a retryable findAndModify should be stored in
+ * config.image_collection rather than in a no-op oplog entry. This requires the collection to
+ * exist, which MongoDSessionCatalog::onStepUp ensures.
+ */
+bool shouldStoreImageInSideCollection(OperationContext* opCtx) {
+    return opCtx->getTxnNumber() && repl::storeFindAndModifyImagesInSideCollection.load() &&
+        CollectionCatalog::get(opCtx).lookupCollectionByNamespace(
+            opCtx, NamespaceString::kConfigImagesNamespace);
+}
+
+void storeImageInSideCollection(OperationContext* opCtx,
+                                repl::RetryImageEnum imageKind,
+                                const BSONObj& image,
+                                const repl::OpTime& writeOpTime) {
+    repl::ImageEntry imageEntry;
+    imageEntry.set_id(*opCtx->getLogicalSessionId());
+    imageEntry.setTxnNum(*opCtx->getTxnNumber());
+    imageEntry.setTs(writeOpTime.getTimestamp());
+    imageEntry.setImageKind(imageKind);
+    imageEntry.setImage(image);
+    repl::writeToImageCollection(opCtx, imageEntry);
+}
+
 /**
  * Write oplog entry(ies) for the update operation.
  */
@@ -158,9 +184,18 @@ OpTimeBundle replLogUpdate(OperationContext* opCtx, const OplogUpdateEntryArgs&
     repl::appendOplogEntryChainInfo(opCtx, &oplogEntry, &oplogLink, args.updateArgs.stmtId);
 
     OpTimeBundle opTimes;
+    boost::optional<repl::RetryImageEnum> sideImage;
+    if (args.updateArgs.storeDocOption != CollectionUpdateArgs::StoreDocOption::None &&
+        shouldStoreImageInSideCollection(opCtx)) {
+        sideImage =
+            args.updateArgs.storeDocOption == CollectionUpdateArgs::StoreDocOption::PreImage
+            ? repl::RetryImageEnum::kPreImage
+            : repl::RetryImageEnum::kPostImage;
+    }
+
     const auto storePreImageForRetryableWrite =
         (args.updateArgs.storeDocOption == CollectionUpdateArgs::StoreDocOption::PreImage &&
-         opCtx->getTxnNumber());
+         opCtx->getTxnNumber() && !sideImage);
     if (storePreImageForRetryableWrite || args.updateArgs.preImageRecordingEnabledForCollection) {
         MutableOplogEntry noopEntry = oplogEntry;
         invariant(args.updateArgs.preImageDoc);
@@ -174,7 +209,7 @@ OpTimeBundle replLogUpdate(OperationContext* opCtx, const OplogUpdateEntryArgs&
 
     // This case handles storing the post image for retryable findAndModify's.
     if (args.updateArgs.storeDocOption == CollectionUpdateArgs::StoreDocOption::PostImage &&
-        opCtx->getTxnNumber()) {
+        opCtx->getTxnNumber() && !sideImage) {
         MutableOplogEntry noopEntry = oplogEntry;
         noopEntry.setOpType(repl::OpTypeEnum::kNoop);
         noopEntry.setObject(args.updateArgs.updatedDoc);
@@ -187,10 +222,20 @@ OpTimeBundle replLogUpdate(OperationContext* opCtx, const OplogUpdateEntryArgs&
     oplogEntry.setObject(args.updateArgs.update);
     oplogEntry.setObject2(args.updateArgs.criteria);
     oplogEntry.setFromMigrateIfTrue(args.updateArgs.fromMigrate);
+    oplogEntry.setNeedsRetryImage(sideImage);
     // oplogLink could have been changed to include pre/postImageOpTime by the previous no-op write.
     repl::appendOplogEntryChainInfo(opCtx, &oplogEntry, &oplogLink, args.updateArgs.stmtId);
     opTimes.writeOpTime = logOperation(opCtx, &oplogEntry);
     opTimes.wallClockTime = oplogEntry.getWallClockTime();
+
+    if (sideImage) {
+        storeImageInSideCollection(opCtx,
+                                   *sideImage,
+                                   *sideImage == repl::RetryImageEnum::kPreImage
+                                       ? *args.updateArgs.preImageDoc
+                                       : args.updateArgs.updatedDoc,
+                                   opTimes.writeOpTime);
+    }
     return opTimes;
 }
 
@@ -210,8 +255,14 @@ OpTimeBundle replLogDelete(OperationContext* opCtx,
     repl::OplogLink oplogLink;
     repl::appendOplogEntryChainInfo(opCtx, &oplogEntry, &oplogLink, stmtId);
 
+    // A collection that records pre-images needs the no-op entry even when the image of a
+    // retryable findAndModify goes to the side collection.
+    const auto coll = CollectionCatalog::get(opCtx).lookupCollectionByNamespace(opCtx, nss);
+    const bool sideImage = deletedDoc && !(coll && coll->getRecordPreImages()) &&
+        shouldStoreImageInSideCollection(opCtx);
+
     OpTimeBundle opTimes;
-    if (deletedDoc) {
+    if (deletedDoc && !sideImage) {
         MutableOplogEntry noopEntry = oplogEntry;
         noopEntry.setOpType(repl::OpTypeEnum::kNoop);
         noopEntry.setObject(*deletedDoc);
@@ -223,10 +274,18 @@ OpTimeBundle replLogDelete(OperationContext* opCtx,
     oplogEntry.setOpType(repl::OpTypeEnum::kDelete);
     oplogEntry.setObject(documentKeyDecoration(opCtx));
     oplogEntry.setFromMigrateIfTrue(fromMigrate);
+    if (sideImage) {
+        oplogEntry.setNeedsRetryImage(repl::RetryImageEnum::kPreImage);
+    }
     // oplogLink could have been changed to include preImageOpTime by the previous no-op write.
     repl::appendOplogEntryChainInfo(opCtx, &oplogEntry, &oplogLink, stmtId);
     opTimes.writeOpTime = logOperation(opCtx, &oplogEntry);
     opTimes.wallClockTime = oplogEntry.getWallClockTime();
+
+    if (sideImage) {
+        storeImageInSideCollection(
+            opCtx, repl::RetryImageEnum::kPreImage, *deletedDoc, opTimes.writeOpTime);
+    }
     return opTimes;
 }
 
@@ -445,7 +504,7 @@ void OpObserverImpl::onInserts(OperationContext* opCtx,
     size_t index = 0;
     for (auto it = first; it != last; it++, index++) {
         auto opTime = opTimeList.empty() ? repl::OpTime() : opTimeList[index];
-        shardObserveInsertOp(opCtx, nss, it->doc, opTime, fromMigrate, inMultiDocumentTransaction);
+        shardObserveInsertOp(opCtx, nss, *it, opTime, fromMigrate, inMultiDocumentTransaction);
     }
 
     if (nss.coll() == "system.js") {
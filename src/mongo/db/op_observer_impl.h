@@ -167,7 +167,7 @@ private:
                                            BSONObj const& doc) {}
     virtual void shardObserveInsertOp(OperationContext* opCtx,
                                       const NamespaceString nss,
-                                      const BSONObj& insertedDoc,
+                                      const InsertStatement& insertStatement,
                                       const repl::OpTime& opTime,
                                       const bool fromMigrate,
                                       const bool inMultiDocumentTransaction) {}
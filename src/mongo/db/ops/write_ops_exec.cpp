@@ -61,6 +61,7 @@
 #include "mongo/db/ops/write_ops_gen.h"
 #include "mongo/db/ops/write_ops_retryability.h"
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
+#include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
@@ -504,6 +505,22 @@ StmtId getStmtIdForWriteOp(OperationContext* opCtx, const T& wholeOp, size_t opI
                                  : kUninitializedStmtId;
 }
 
+/**
+ * Returns the maximum number of documents to insert in one storage transaction. Unacknowledged
+ * inserts can opt into larger batches, trading the granularity of their commits for fewer of them.
+ */
+size_t getMaxInsertBatchSize(OperationContext* opCtx) {
+    const WriteConcernOptions& writeConcern = opCtx->getWriteConcern();
+    const bool unacknowledged = writeConcern.wMode.empty() && writeConcern.wNumNodes == 0 &&
+        (writeConcern.syncMode == WriteConcernOptions::SyncMode::NONE ||
+         writeConcern.syncMode == WriteConcernOptions::SyncMode::UNSET);
+    const auto unacknowledgedBatchSize = internalInsertUnacknowledgedMaxBatchSize.load();
+    if (unacknowledged && unacknowledgedBatchSize > 0 && !opCtx->inMultiDocumentTransaction()) {
+        return unacknowledgedBatchSize;
+    }
+    return internalInsertMaxBatchSize.load();
+}
+
 SingleWriteResult makeWriteResultForInsertOrDeleteRetry() {
     SingleWriteResult res;
     res.setN(1);
@@ -559,7 +576,7 @@ WriteResult performInserts(OperationContext* opCtx,
     size_t stmtIdIndex = 0;
     size_t bytesInBatch = 0;
     std::vector<InsertStatement> batch;
-    const size_t maxBatchSize = internalInsertMaxBatchSize.load();
+    const size_t maxBatchSize = getMaxInsertBatchSize(opCtx);
     const size_t maxBatchBytes = write_ops::insertVectorMaxBytes;
     batch.reserve(std::min(wholeOp.getDocuments().size(), maxBatchSize));
 
@@ -807,7 +824,35 @@ WriteResult performUpdates(OperationContext* opCtx, const write_ops::Update& who
     const auto& runtimeConstants =
         wholeOp.getRuntimeConstants().value_or(Variables::generateRuntimeConstants(opCtx));
 
+    // Consecutive statements that each update one document by _id run under a collection lock
+    // held across up to internalUpdateMaxBatchSize of them, so they share one lock and ticket
+    // acquisition. Each statement still locks, plans and commits on its own under it; the IDHACK
+    // plan such a statement gets needs no plan selection. The lock is only held while the
+    // collection exists, since an upsert may have to create it.
+    const auto& ns = wholeOp.getNamespace();
+    const bool canBatchLocks =
+        wholeOp.getUpdates().size() > 1 && !opCtx->inMultiDocumentTransaction();
+    const size_t maxBatchSize = internalUpdateMaxBatchSize.load();
+    boost::optional<AutoGetCollection> batchLock;
+    size_t statementsUnderBatchLock = 0;
+
     for (auto&& singleOp : wholeOp.getUpdates()) {
+        const bool isBatchable = canBatchLocks && !singleOp.getMulti() &&
+            CanonicalQuery::isSimpleIdQuery(singleOp.getQ());
+        if (!isBatchable || statementsUnderBatchLock >= maxBatchSize) {
+            batchLock.reset();
+            statementsUnderBatchLock = 0;
+        }
+        if (isBatchable && !batchLock) {
+            batchLock.emplace(opCtx, ns, fixLockModeForSystemDotViewsChanges(ns, MODE_IX));
+            if (!batchLock->getCollection()) {
+                batchLock.reset();
+            }
+        }
+        if (batchLock) {
+            ++statementsUnderBatchLock;
+        }
+
         const auto stmtId = getStmtIdForWriteOp(opCtx, wholeOp, stmtIdIndex++);
         if (opCtx->getTxnNumber()) {
             if (!opCtx->inMultiDocumentTransaction()) {
@@ -836,6 +881,9 @@ WriteResult performUpdates(OperationContext* opCtx, const write_ops::Update& who
                 opCtx, wholeOp.getNamespace(), stmtId, singleOp, runtimeConstants));
             lastOpFixer.finishedOpSuccessfully();
         } catch (const DBException& ex) {
+            // Handle the error, and any retry of the next statement, without the batch's lock.
+            batchLock.reset();
+            statementsUnderBatchLock = 0;
             const bool canContinue =
                 handleError(opCtx, ex, wholeOp.getNamespace(), wholeOp.getWriteCommandBase(), &out);
             if (!canContinue)
@@ -35,6 +35,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/ops/find_and_modify_result.h"
 #include "mongo/db/query/find_and_modify_request.h"
+#include "mongo/db/repl/image_collection_entry_gen.h"
 #include "mongo/logger/redaction.h"
 
 namespace mongo {
@@ -62,7 +63,8 @@ void validateFindAndModifyRetryability(const FindAndModifyRequest& request,
         uassert(40607,
                 str::stream() << "No pre-image available for findAndModify retry request:"
                               << redact(request.toBSON({})),
-                oplogWithCorrectLinks.getPreImageOpTime());
+                oplogWithCorrectLinks.getPreImageOpTime() ||
+                    oplogWithCorrectLinks.getNeedsRetryImage() == repl::RetryImageEnum::kPreImage);
     } else if (opType == repl::OpTypeEnum::kInsert) {
         uassert(
             40608,
@@ -86,23 +88,61 @@ void validateFindAndModifyRetryability(const FindAndModifyRequest& request,
                                   << " wants the document after update returned, but only before "
                                      "update document is stored, oplogTs: "
                                   << ts.toString() << ", oplog: " << redact(oplogEntry.toBSON()),
-                    oplogWithCorrectLinks.getPostImageOpTime());
+                    oplogWithCorrectLinks.getPostImageOpTime() ||
+                        oplogWithCorrectLinks.getNeedsRetryImage() ==
+                            repl::RetryImageEnum::kPostImage);
         } else {
             uassert(40612,
                     str::stream() << "findAndModify retry request: " << redact(request.toBSON({}))
                                   << " wants the document before update returned, but only after "
                                      "update document is stored, oplogTs: "
                                   << ts.toString() << ", oplog: " << redact(oplogEntry.toBSON()),
-                    oplogWithCorrectLinks.getPreImageOpTime());
+                    oplogWithCorrectLinks.getPreImageOpTime() ||
+                        oplogWithCorrectLinks.getNeedsRetryImage() ==
+                            repl::RetryImageEnum::kPreImage);
         }
     }
 }
 
+/**
+ * Extracts the image of a findAndModify whose write was logged with needsRetryImage from
+ * config.image_collection. The collection keeps only the latest image of each session, so the
+ * entry must belong to this very write.
+ */
+BSONObj extractImageFromSideCollection(OperationContext* opCtx, const repl::OplogEntry& oplog) {
+    invariant(oplog.getSessionId() && oplog.getTxnNumber());
+    DBDirectClient client(opCtx);
+    auto imageDoc =
+        client.findOne(NamespaceString::kConfigImagesNamespace.ns(),
+                       BSON(repl::ImageEntry::k_idFieldName << oplog.getSessionId()->toBSON()));
+
+    const auto matchesWrite = [&](const repl::ImageEntry& image) {
+        return image.getTxnNum() == *oplog.getTxnNumber() &&
+            image.getTs() == oplog.getTimestamp() &&
+            image.getImageKind() == *oplog.getNeedsRetryImage();
+    };
+    boost::optional<repl::ImageEntry> image;
+    if (!imageDoc.isEmpty()) {
+        image = repl::ImageEntry::parse(IDLParserErrorContext("image entry"), imageDoc);
+    }
+    uassert(ErrorCodes::IncompleteTransactionHistory,
+            str::stream() << "Incomplete history detected for this transaction, the image of the "
+                             "write with oplogTs "
+                          << oplog.getTimestamp().toString() << " cannot be found in "
+                          << NamespaceString::kConfigImagesNamespace,
+            image && matchesWrite(*image));
+    return image->getImage().getOwned();
+}
+
 /**
  * Extracts either the pre or post image (cannot be both) of the findAndModify operation from the
- * oplog.
+ * oplog or from config.image_collection.
  */
 BSONObj extractPreOrPostImage(OperationContext* opCtx, const repl::OplogEntry& oplog) {
+    if (oplog.getNeedsRetryImage()) {
+        return extractImageFromSideCollection(opCtx, oplog);
+    }
+
     invariant(oplog.getPreImageOpTime() || oplog.getPostImageOpTime());
     auto opTime = oplog.getPreImageOpTime() ? oplog.getPreImageOpTime().value()
                                             : oplog.getPostImageOpTime().value();
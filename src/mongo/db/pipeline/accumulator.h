@@ -178,6 +178,49 @@ private:
     int _maxMemUsageBytes;
 };
 
+/**
+ * Approximates the number of distinct values that $addToSet would collect, using a HyperLogLog
+ * sketch. Until more than kMaxExactHashes distinct values are seen, they are counted exactly.
+ */
+class AccumulatorApproxCountDistinct final : public AccumulatorState {
+public:
+    // The number of bits of a value's hash used to choose its HyperLogLog register.
+    static constexpr int kPrecision = 12;
+    static constexpr size_t kNumRegisters = size_t{1} << kPrecision;
+
+    // The number of distinct hashes kept before switching to registers.
+    static constexpr size_t kMaxExactHashes = 256;
+
+    explicit AccumulatorApproxCountDistinct(const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) final;
+    const char* getOpName() const final;
+    void reset() final;
+
+    static boost::intrusive_ptr<AccumulatorState> create(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    bool isAssociative() const final {
+        return true;
+    }
+
+    bool isCommutative() const final {
+        return true;
+    }
+
+private:
+    void addHash(uint64_t hash);
+    void addHashToRegisters(uint64_t hash);
+    void switchToRegisters();
+    void updateMemUsage();
+
+    stdx::unordered_set<uint64_t> _exactHashes;
+
+    // Empty until more than kMaxExactHashes distinct hashes have been seen.
+    std::vector<uint8_t> _registers;
+};
+
 class AccumulatorFirst final : public AccumulatorState {
 public:
     explicit AccumulatorFirst(const boost::intrusive_ptr<ExpressionContext>& expCtx);
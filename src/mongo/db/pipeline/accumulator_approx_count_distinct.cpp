@@ -0,0 +1,188 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/accumulator.h"
+
+#include <cmath>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/platform/bits.h"
+
+namespace mongo {
+
+REGISTER_ACCUMULATOR(approxCountDistinct,
+                     genericParseSingleExpressionAccumulator<AccumulatorApproxCountDistinct>);
+
+namespace {
+// The partial results sent to a merger are either the exact list of hashes seen so far or the
+// HyperLogLog registers.
+constexpr auto kHashesField = "hashes"_sd;
+constexpr auto kRegistersField = "registers"_sd;
+
+/**
+ * The value comparator's hash is not well distributed across all 64 bits, so mix it with the
+ * MurmurHash3 finalizer before using it to choose a register.
+ */
+uint64_t mixHash(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+}  // namespace
+
+const char* AccumulatorApproxCountDistinct::getOpName() const {
+    return "$approxCountDistinct";
+}
+
+void AccumulatorApproxCountDistinct::processInternal(const Value& input, bool merging) {
+    if (!merging) {
+        if (!input.missing()) {
+            addHash(mixHash(getExpressionContext()->getValueComparator().hash(input)));
+        }
+        return;
+    }
+
+    invariant(input.getType() == Object);
+    auto partial = input.getDocument();
+    auto hashes = partial[kHashesField];
+    if (!hashes.missing()) {
+        for (auto&& hash : hashes.getArray()) {
+            addHash(static_cast<uint64_t>(hash.getLong()));
+        }
+        return;
+    }
+
+    auto registers = partial[kRegistersField].getBinData();
+    invariant(static_cast<size_t>(registers.length) == kNumRegisters);
+    switchToRegisters();
+    auto data = static_cast<const uint8_t*>(registers.data);
+    for (size_t i = 0; i < kNumRegisters; ++i) {
+        _registers[i] = std::max(_registers[i], data[i]);
+    }
+}
+
+void AccumulatorApproxCountDistinct::addHash(uint64_t hash) {
+    if (!_registers.empty()) {
+        addHashToRegisters(hash);
+        return;
+    }
+
+    if (_exactHashes.insert(hash).second) {
+        if (_exactHashes.size() > kMaxExactHashes) {
+            switchToRegisters();
+        }
+        updateMemUsage();
+    }
+}
+
+void AccumulatorApproxCountDistinct::addHashToRegisters(uint64_t hash) {
+    auto index = hash >> (64 - kPrecision);
+    // Setting a bit just past the remaining bits caps the run of leading zeros.
+    auto remaining = (hash << kPrecision) | (uint64_t{1} << (kPrecision - 1));
+    auto rank = static_cast<uint8_t>(countLeadingZeros64(remaining) + 1);
+    _registers[index] = std::max(_registers[index], rank);
+}
+
+void AccumulatorApproxCountDistinct::switchToRegisters() {
+    if (!_registers.empty()) {
+        return;
+    }
+    _registers.resize(kNumRegisters, 0);
+    for (auto hash : _exactHashes) {
+        addHashToRegisters(hash);
+    }
+    _exactHashes = {};
+    updateMemUsage();
+}
+
+void AccumulatorApproxCountDistinct::updateMemUsage() {
+    _memUsageBytes = sizeof(*this) + _exactHashes.size() * sizeof(uint64_t) + _registers.size();
+}
+
+Value AccumulatorApproxCountDistinct::getValue(bool toBeMerged) {
+    if (toBeMerged) {
+        if (_registers.empty()) {
+            std::vector<Value> hashes;
+            hashes.reserve(_exactHashes.size());
+            for (auto hash : _exactHashes) {
+                hashes.emplace_back(static_cast<long long>(hash));
+            }
+            return Value(DOC(kHashesField << Value(std::move(hashes))));
+        }
+        return Value(DOC(kRegistersField << Value(BSONBinData(
+                             _registers.data(), _registers.size(), BinDataGeneral))));
+    }
+
+    if (_registers.empty()) {
+        return Value(static_cast<long long>(_exactHashes.size()));
+    }
+
+    const double m = kNumRegisters;
+    double sum = 0;
+    size_t zeroRegisters = 0;
+    for (auto reg : _registers) {
+        sum += std::ldexp(1.0, -reg);
+        zeroRegisters += (reg == 0);
+    }
+
+    const double alpha = 0.7213 / (1 + 1.079 / m);
+    double estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m && zeroRegisters > 0) {
+        // Linear counting is more accurate for small cardinalities.
+        estimate = m * std::log(m / zeroRegisters);
+    }
+    return Value(std::llround(estimate));
+}
+
+AccumulatorApproxCountDistinct::AccumulatorApproxCountDistinct(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx)
+    : AccumulatorState(expCtx) {
+    updateMemUsage();
+}
+
+void AccumulatorApproxCountDistinct::reset() {
+    _exactHashes = {};
+    _registers = {};
+    updateMemUsage();
+}
+
+boost::intrusive_ptr<AccumulatorState> AccumulatorApproxCountDistinct::create(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    return new AccumulatorApproxCountDistinct(expCtx);
+}
+
+}  // namespace mongo
@@ -0,0 +1,284 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/accumulator_approx_percentile.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+REGISTER_ACCUMULATOR(approxPercentile, AccumulatorApproxPercentile::parse);
+
+namespace {
+constexpr auto kInputField = "input"_sd;
+constexpr auto kPercentilesField = "p"_sd;
+
+// Fields of the partial result sent to a merger.
+constexpr auto kMeansField = "means"_sd;
+constexpr auto kWeightsField = "weights"_sd;
+constexpr auto kMinField = "min"_sd;
+constexpr auto kMaxField = "max"_sd;
+
+/**
+ * The t-digest scale function, which maps a quantile to a scale where each centroid may span at
+ * most one unit. It is steepest near the tails, so centroids there stay small and accurate.
+ */
+double quantileToScale(double quantile) {
+    return AccumulatorApproxPercentile::kCompression / (2 * M_PI) * std::asin(2 * quantile - 1);
+}
+
+double scaleToQuantile(double scale) {
+    scale = std::min(scale, AccumulatorApproxPercentile::kCompression / 4);
+    return (std::sin(scale * 2 * M_PI / AccumulatorApproxPercentile::kCompression) + 1) / 2;
+}
+}  // namespace
+
+AccumulationExpression AccumulatorApproxPercentile::parse(
+    boost::intrusive_ptr<ExpressionContext> expCtx, BSONElement elem, VariablesParseState vps) {
+    uassert(5212022,
+            str::stream() << kAccumulatorName << " requires a document argument, but found "
+                          << elem.type(),
+            elem.type() == BSONType::Object);
+    BSONObj obj = elem.embeddedObject();
+
+    boost::intrusive_ptr<Expression> argument;
+    boost::optional<std::vector<double>> percentiles;
+
+    for (auto&& element : obj) {
+        if (element.fieldNameStringData() == kInputField) {
+            argument = Expression::parseOperand(expCtx, element, vps);
+        } else if (element.fieldNameStringData() == kPercentilesField) {
+            auto badPercentiles = [&] {
+                uasserted(5212023,
+                          str::stream()
+                              << kAccumulatorName << " requires '" << kPercentilesField
+                              << "' to be a non-empty array of numbers between 0 and 1, but found "
+                              << element.toString(false));
+            };
+            if (element.type() != BSONType::Array || element.embeddedObject().isEmpty()) {
+                badPercentiles();
+            }
+            percentiles.emplace();
+            for (auto&& p : element.embeddedObject()) {
+                if (!p.isNumber() || !(p.numberDouble() >= 0 && p.numberDouble() <= 1)) {
+                    badPercentiles();
+                }
+                percentiles->push_back(p.numberDouble());
+            }
+        } else {
+            uasserted(5212024,
+                      str::stream() << "Invalid argument specified to " << kAccumulatorName << ": "
+                                    << element.toString());
+        }
+    }
+    uassert(5212025,
+            str::stream() << kAccumulatorName << " requires '" << kInputField << "' and '"
+                          << kPercentilesField << "' arguments, received input: "
+                          << obj.toString(false),
+            argument && percentiles);
+
+    auto factory = [expCtx, percentiles = std::move(*percentiles)]() {
+        return AccumulatorApproxPercentile::create(expCtx, percentiles);
+    };
+
+    auto initializer = ExpressionConstant::create(expCtx, Value(BSONNULL));
+    return {std::move(initializer), std::move(argument), std::move(factory)};
+}
+
+boost::intrusive_ptr<AccumulatorState> AccumulatorApproxPercentile::create(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, std::vector<double> percentiles) {
+    return new AccumulatorApproxPercentile(expCtx, std::move(percentiles));
+}
+
+AccumulatorApproxPercentile::AccumulatorApproxPercentile(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, std::vector<double> percentiles)
+    : AccumulatorState(expCtx), _percentiles(std::move(percentiles)) {
+    updateMemUsage();
+}
+
+const char* AccumulatorApproxPercentile::getOpName() const {
+    return kAccumulatorName.rawData();
+}
+
+void AccumulatorApproxPercentile::processInternal(const Value& input, bool merging) {
+    if (!merging) {
+        if (!input.numeric()) {
+            return;
+        }
+        double value = input.coerceToDouble();
+        if (std::isnan(value)) {
+            return;
+        }
+        _min = std::min(_min, value);
+        _max = std::max(_max, value);
+        add({value, 1});
+        return;
+    }
+
+    invariant(input.getType() == Object);
+    auto partial = input.getDocument();
+    auto means = partial[kMeansField].getArray();
+    auto weights = partial[kWeightsField].getArray();
+    invariant(means.size() == weights.size());
+    if (means.empty()) {
+        return;
+    }
+    _min = std::min(_min, partial[kMinField].getDouble());
+    _max = std::max(_max, partial[kMaxField].getDouble());
+    for (size_t i = 0; i < means.size(); ++i) {
+        add({means[i].getDouble(), weights[i].getDouble()});
+    }
+}
+
+void AccumulatorApproxPercentile::add(Centroid centroid) {
+    _buffer.push_back(centroid);
+    _totalWeight += centroid.weight;
+    if (_buffer.size() >= kMaxBufferedValues) {
+        compress();
+    }
+}
+
+void AccumulatorApproxPercentile::compress() {
+    if (_buffer.empty()) {
+        return;
+    }
+
+    _buffer.insert(_buffer.end(), _centroids.begin(), _centroids.end());
+    std::sort(_buffer.begin(), _buffer.end(), [](const Centroid& lhs, const Centroid& rhs) {
+        return lhs.mean < rhs.mean;
+    });
+
+    _centroids.clear();
+    Centroid current = _buffer.front();
+    double weightBefore = 0;
+    double weightLimit = _totalWeight * scaleToQuantile(quantileToScale(0) + 1);
+    for (auto it = std::next(_buffer.begin()); it != _buffer.end(); ++it) {
+        if (weightBefore + current.weight + it->weight <= weightLimit) {
+            current.weight += it->weight;
+            current.mean += (it->mean - current.mean) * it->weight / current.weight;
+        } else {
+            weightBefore += current.weight;
+            _centroids.push_back(current);
+            weightLimit =
+                _totalWeight * scaleToQuantile(quantileToScale(weightBefore / _totalWeight) + 1);
+            current = *it;
+        }
+    }
+    _centroids.push_back(current);
+    _buffer.clear();
+    updateMemUsage();
+}
+
+double AccumulatorApproxPercentile::estimate(double percentile) const {
+    invariant(!_centroids.empty() && _buffer.empty());
+
+    // Each centroid's mean is taken to sit at the middle of its weight. The minimum and maximum
+    // anchor the ends, and values in between are linearly interpolated.
+    const double target = percentile * _totalWeight;
+    double prevPosition = 0;
+    double prevValue = _min;
+    double weightBefore = 0;
+    for (auto&& centroid : _centroids) {
+        double position = weightBefore + centroid.weight / 2;
+        if (target <= position) {
+            if (position == prevPosition || prevValue == centroid.mean) {
+                return centroid.mean;
+            }
+            return prevValue +
+                (centroid.mean - prevValue) * (target - prevPosition) / (position - prevPosition);
+        }
+        prevPosition = position;
+        prevValue = centroid.mean;
+        weightBefore += centroid.weight;
+    }
+    if (_totalWeight == prevPosition || prevValue == _max) {
+        return _max;
+    }
+    return prevValue + (_max - prevValue) * (target - prevPosition) / (_totalWeight - prevPosition);
+}
+
+Value AccumulatorApproxPercentile::getValue(bool toBeMerged) {
+    compress();
+
+    if (toBeMerged) {
+        std::vector<Value> means;
+        std::vector<Value> weights;
+        means.reserve(_centroids.size());
+        weights.reserve(_centroids.size());
+        for (auto&& centroid : _centroids) {
+            means.emplace_back(centroid.mean);
+            weights.emplace_back(centroid.weight);
+        }
+        return Value(DOC(kMeansField << Value(std::move(means)) << kWeightsField
+                                     << Value(std::move(weights)) << kMinField << _min
+                                     << kMaxField << _max));
+    }
+
+    if (_centroids.empty()) {
+        return Value(BSONNULL);
+    }
+
+    std::vector<Value> results;
+    results.reserve(_percentiles.size());
+    for (auto percentile : _percentiles) {
+        results.emplace_back(estimate(percentile));
+    }
+    return Value(std::move(results));
+}
+
+void AccumulatorApproxPercentile::reset() {
+    _centroids = {};
+    _buffer = {};
+    _totalWeight = 0;
+    _min = std::numeric_limits<double>::infinity();
+    _max = -std::numeric_limits<double>::infinity();
+    updateMemUsage();
+}
+
+void AccumulatorApproxPercentile::updateMemUsage() {
+    _memUsageBytes = sizeof(*this) + _percentiles.capacity() * sizeof(double) +
+        (_centroids.capacity() + _buffer.capacity()) * sizeof(Centroid);
+}
+
+Document AccumulatorApproxPercentile::serialize(boost::intrusive_ptr<Expression> initializer,
+                                                boost::intrusive_ptr<Expression> argument,
+                                                bool explain) const {
+    std::vector<Value> percentiles(_percentiles.begin(), _percentiles.end());
+    return DOC(getOpName() << DOC(kInputField << argument->serialize(explain) << kPercentilesField
+                                              << Value(std::move(percentiles))));
+}
+
+}  // namespace mongo
@@ -0,0 +1,109 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/intrusive_ptr.hpp>
+#include <limits>
+#include <vector>
+
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/pipeline/expression_context.h"
+
+namespace mongo {
+
+/**
+ * Approximates percentiles of the numeric values in a group with a t-digest, which uses a bounded
+ * amount of memory regardless of the number of values. Non-numeric values are ignored.
+ *
+ * Syntax: {$approxPercentile: {input: <expression>, p: [<number between 0 and 1>, ...]}}
+ */
+class AccumulatorApproxPercentile final : public AccumulatorState {
+public:
+    static constexpr auto kAccumulatorName = "$approxPercentile"_sd;
+
+    // Bounds the number of t-digest centroids to about twice this value.
+    static constexpr double kCompression = 100;
+
+    // The number of values buffered before they are merged into the centroids.
+    static constexpr size_t kMaxBufferedValues = 500;
+
+    static AccumulationExpression parse(boost::intrusive_ptr<ExpressionContext> expCtx,
+                                        BSONElement elem,
+                                        VariablesParseState vps);
+
+    static boost::intrusive_ptr<AccumulatorState> create(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx, std::vector<double> percentiles);
+
+    AccumulatorApproxPercentile(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                std::vector<double> percentiles);
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) final;
+    const char* getOpName() const final;
+    void reset() final;
+
+    Document serialize(boost::intrusive_ptr<Expression> initializer,
+                       boost::intrusive_ptr<Expression> argument,
+                       bool explain) const final;
+
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    void add(Centroid centroid);
+
+    /**
+     * Merges the buffered centroids into '_centroids', combining neighbours as the t-digest scale
+     * function allows.
+     */
+    void compress();
+
+    /**
+     * Returns the estimated value at 'percentile'. Requires at least one value and no buffered
+     * centroids.
+     */
+    double estimate(double percentile) const;
+
+    void updateMemUsage();
+
+    const std::vector<double> _percentiles;
+
+    // Sorted by mean.
+    std::vector<Centroid> _centroids;
+    std::vector<Centroid> _buffer;
+    double _totalWeight = 0;
+    double _min = std::numeric_limits<double>::infinity();
+    double _max = -std::numeric_limits<double>::infinity();
+};
+
+}  // namespace mongo
@@ -32,6 +32,7 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/pipeline/accumulator_js_reduce.h"
 #include "mongo/db/pipeline/make_js_function.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 
@@ -319,6 +320,7 @@ Value AccumulatorJs::getValue(bool toBeMerged) {
     // empty groups: even in a {$group: {_id: 1, ...}}, we will return zero groups rather than one
     // empty group.
     invariant(_state);
+    flushPendingAccumulates();
 
     // If toBeMerged then we return the current state, to be fed back in to accumulate / merge /
     // finalize later. If not toBeMerged then we return the final value, by calling finalize.
@@ -363,6 +365,8 @@ void AccumulatorJs::startNewGroup(Value const& input) {
 
 void AccumulatorJs::reset() {
     _state = std::nullopt;
+    _pendingAccumulateArgs.clear();
+    _pendingAccumulateArgsBytes = 0;
     recomputeMemUsageBytes();
 }
 
@@ -376,28 +380,63 @@ void AccumulatorJs::processInternal(const Value& input, bool merging) {
     if (merging) {
         // input is an intermediate state from another instance of this kind of accumulator. Call
         // the user's merge function.
+        flushPendingAccumulates();
         auto func = makeJsFunc(expCtx, _merge);
         _state = jsExec->callFunction(func, BSON_ARRAY(*_state << input), {});
         recomputeMemUsageBytes();
     } else {
-        // input is a value produced by our AccumulationExpression::argument. Call the user's
-        // accumulate function.
-        auto func = makeJsFunc(expCtx, _accumulate);
+        // input is a value produced by our AccumulationExpression::argument. Buffer it for the
+        // user's accumulate function.
         uassert(4544712,
                 str::stream() << "$accumulator accumulateArgs must evaluate to an array: "
                               << input.toString(),
                 input.getType() == BSONType::Array);
 
-        size_t index = 0;
-        BSONArrayBuilder bob;
-        _state->addToBsonArray(&bob, index++);
-        for (auto&& arg : input.getArray()) {
-            arg.addToBsonArray(&bob, index++);
+        _pendingAccumulateArgs.push_back(input);
+        _pendingAccumulateArgsBytes += input.getApproximateSize();
+        if (_pendingAccumulateArgs.size() >=
+            static_cast<size_t>(internalQueryJavaScriptAccumulatorBatchSize.load())) {
+            flushPendingAccumulates();
+        } else {
+            recomputeMemUsageBytes();
         }
+    }
+}
 
-        _state = jsExec->callFunction(func, bob.done(), {});
-        recomputeMemUsageBytes();
+void AccumulatorJs::flushPendingAccumulates() {
+    if (_pendingAccumulateArgs.empty()) {
+        return;
     }
+
+    auto& expCtx = getExpressionContext();
+    auto jsExec = expCtx->getJsExecWithScope();
+
+    // Function signature: batchedAccumulate(state, [accumulateArgs, ...]). It calls the user's
+    // function, defined as a global so that it is parsed like the other $accumulator functions,
+    // once per document in order, with the same arguments as an unbatched call.
+    const auto& accumulate = jsExec->defineGlobalFunction(_accumulate);
+    auto func = makeJsFunc(expCtx,
+                           str::stream() << "function(state, batch) {\n"
+                                         << "    for (let i = 0; i < batch.length; ++i) {\n"
+                                         << "        state = " << accumulate
+                                         << ".apply(this, [state].concat(batch[i]));\n"
+                                         << "    }\n"
+                                         << "    return state;\n"
+                                         << "}");
+
+    BSONArrayBuilder bob;
+    _state->addToBsonArray(&bob);
+    {
+        BSONArrayBuilder batch(bob.subarrayStart());
+        for (auto&& args : _pendingAccumulateArgs) {
+            args.addToBsonArray(&batch);
+        }
+    }
+    _pendingAccumulateArgs.clear();
+    _pendingAccumulateArgsBytes = 0;
+
+    _state = jsExec->callFunction(func, bob.done(), {});
+    recomputeMemUsageBytes();
 }
 
 void AccumulatorJs::recomputeMemUsageBytes() {
@@ -406,7 +445,7 @@ void AccumulatorJs::recomputeMemUsageBytes() {
             str::stream() << "$accumulator state exceeded max BSON size: " << stateSize,
             stateSize <= BSONObjMaxUserSize);
     _memUsageBytes = sizeof(*this) + stateSize + _init.capacity() + _accumulate.capacity() +
-        _merge.capacity() + _finalize.capacity();
+        _merge.capacity() + _finalize.capacity() + _pendingAccumulateArgsBytes;
 }
 
 }  // namespace mongo
@@ -120,6 +120,10 @@ private:
     }
     void recomputeMemUsageBytes();
 
+    // Calls the user's accumulate function on '_pendingAccumulateArgs', in a single call into
+    // JavaScript that converts '_state' to and from BSON only once.
+    void flushPendingAccumulates();
+
     // static arguments
     std::string _init, _accumulate, _merge, _finalize;
 
@@ -129,6 +133,12 @@ private:
     //   functions, and _state gets a Value.
     // - When the accumulator is reset, _state becomes empty again.
     std::optional<Value> _state;
+
+    // accumulateArgs of the documents whose accumulate calls are buffered. They are applied to
+    // '_state' once internalQueryJavaScriptAccumulatorBatchSize of them are buffered, and before
+    // '_state' is merged or returned.
+    std::vector<Value> _pendingAccumulateArgs;
+    size_t _pendingAccumulateArgsBytes = 0;
 };
 
 }  // namespace mongo
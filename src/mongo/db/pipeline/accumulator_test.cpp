@@ -35,6 +35,7 @@
 #include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/pipeline/accumulator_approx_percentile.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/dbtests/dbtests.h"
@@ -362,6 +363,138 @@ TEST(Accumulators, PushRespectsMaxMemoryConstraint) {
         ErrorCodes::ExceededMemoryLimit);
 }
 
+TEST(Accumulators, ApproxCountDistinctIsExactForFewDistinctValues) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    assertExpectedResults<AccumulatorApproxCountDistinct>(
+        expCtx,
+        {// No documents evaluated.
+         {{}, Value(0LL)},
+         // Missing values are ignored, but null is counted.
+         {{Value(), Value(BSONNULL)}, Value(1LL)},
+         // Numerically equal values are counted once.
+         {{Value(1), Value(1LL), Value(1.0), Value(Decimal128(1))}, Value(1LL)},
+         {{Value("a"_sd), Value(2), Value("a"_sd), Value(3.5), Value(2)}, Value(3LL)}});
+}
+
+TEST(Accumulators, ApproxCountDistinctRespectsCollation) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kAlwaysEqual);
+    expCtx->setCollator(&collator);
+    assertExpectedResults<AccumulatorApproxCountDistinct>(
+        expCtx, {{{Value("a"_sd), Value("b"_sd), Value("c"_sd)}, Value(1LL)}});
+}
+
+TEST(Accumulators, ApproxCountDistinctEstimatesManyDistinctValues) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    const long long numDistinct = 100000;
+
+    auto unsharded = AccumulatorApproxCountDistinct::create(expCtx);
+    auto merger = AccumulatorApproxCountDistinct::create(expCtx);
+    std::vector<intrusive_ptr<AccumulatorState>> shards;
+    for (int i = 0; i < 3; ++i) {
+        shards.push_back(AccumulatorApproxCountDistinct::create(expCtx));
+    }
+    for (long long i = 0; i < numDistinct; ++i) {
+        // Every value is seen twice, once as an int and once as a double.
+        for (auto&& val : {Value(i), Value(static_cast<double>(i))}) {
+            unsharded->process(val, false);
+            shards[i % shards.size()]->process(val, false);
+        }
+    }
+    for (auto&& shard : shards) {
+        merger->process(shard->getValue(true), true);
+    }
+
+    auto estimate = unsharded->getValue(false);
+    ASSERT_EQ(estimate.getType(), NumberLong);
+    ASSERT_LT(std::abs(estimate.getLong() - numDistinct), numDistinct / 10);
+
+    // Merging registers loses no information, so the result does not depend on the split.
+    ASSERT_VALUE_EQ(merger->getValue(false), estimate);
+}
+
+namespace {
+Value approxPercentiles(const intrusive_ptr<ExpressionContext>& expCtx,
+                        std::vector<double> percentiles,
+                        const std::vector<Value>& inputs,
+                        bool splitAcrossShards) {
+    auto accum = AccumulatorApproxPercentile::create(expCtx, percentiles);
+    if (!splitAcrossShards) {
+        for (auto&& val : inputs) {
+            accum->process(val, false);
+        }
+        return accum->getValue(false);
+    }
+    for (auto&& val : inputs) {
+        auto shard = AccumulatorApproxPercentile::create(expCtx, percentiles);
+        shard->process(val, false);
+        accum->process(shard->getValue(true), true);
+    }
+    return accum->getValue(false);
+}
+}  // namespace
+
+TEST(Accumulators, ApproxPercentileIsExactForFewValues) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    for (bool split : {false, true}) {
+        ASSERT_VALUE_EQ(approxPercentiles(expCtx, {0.5}, {}, split), Value(BSONNULL));
+        // Non-numeric values are ignored.
+        ASSERT_VALUE_EQ(approxPercentiles(expCtx, {0.5}, {Value("a"_sd), Value()}, split),
+                        Value(BSONNULL));
+        ASSERT_VALUE_EQ(
+            approxPercentiles(expCtx,
+                              {0, 0.5, 1},
+                              {Value(4), Value(2LL), Value("a"_sd), Value(5.0), Value(1), Value(3)},
+                              split),
+            Value(std::vector<Value>{Value(1.0), Value(3.0), Value(5.0)}));
+    }
+}
+
+TEST(Accumulators, ApproxPercentileEstimatesManyValues) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    std::vector<Value> inputs;
+    for (int i = 1; i <= 10000; ++i) {
+        inputs.emplace_back((i * 7919) % 10000 + 1);
+    }
+    for (bool split : {false, true}) {
+        auto results = approxPercentiles(expCtx, {0.5, 0.99}, inputs, split).getArray();
+        ASSERT_EQ(results.size(), 2U);
+        ASSERT_APPROX_EQUAL(results[0].getDouble(), 5000, 50);
+        ASSERT_APPROX_EQUAL(results[1].getDouble(), 9900, 20);
+    }
+}
+
+TEST(Accumulators, ApproxPercentileSerializesInputAndPercentiles) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    auto spec = BSON("$approxPercentile" << BSON("input"
+                                                 << "$x"
+                                                 << "p" << BSON_ARRAY(0.25 << 1)));
+    auto parsed = AccumulatorApproxPercentile::parse(
+        expCtx, spec.firstElement(), expCtx->variablesParseState);
+    auto accum = parsed.factory();
+    ASSERT_DOCUMENT_EQ(
+        accum->serialize(parsed.initializer, parsed.argument, false),
+        Document(fromjson("{$approxPercentile: {input: '$x', p: [0.25, 1.0]}}")));
+}
+
+TEST(Accumulators, ApproxPercentileRejectsInvalidArguments) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    auto assertFailsToParse = [&](BSONObj spec, int code) {
+        ASSERT_THROWS_CODE(AccumulatorApproxPercentile::parse(
+                               expCtx, spec.firstElement(), expCtx->variablesParseState),
+                           AssertionException,
+                           code);
+    };
+    assertFailsToParse(fromjson("{$approxPercentile: '$x'}"), 5212022);
+    assertFailsToParse(fromjson("{$approxPercentile: {input: '$x', p: 0.5}}"), 5212023);
+    assertFailsToParse(fromjson("{$approxPercentile: {input: '$x', p: []}}"), 5212023);
+    assertFailsToParse(fromjson("{$approxPercentile: {input: '$x', p: [1.5]}}"), 5212023);
+    assertFailsToParse(fromjson("{$approxPercentile: {input: '$x', p: ['a']}}"), 5212023);
+    assertFailsToParse(fromjson("{$approxPercentile: {input: '$x', p: [0.5], q: 1}}"), 5212024);
+    assertFailsToParse(fromjson("{$approxPercentile: {p: [0.5]}}"), 5212025);
+    assertFailsToParse(fromjson("{$approxPercentile: {input: '$x'}}"), 5212025);
+}
+
 /* ------------------------- AccumulatorMergeObjects -------------------------- */
 
 TEST(AccumulatorMergeObjects, MergingZeroObjectsShouldReturnEmptyDocument) {
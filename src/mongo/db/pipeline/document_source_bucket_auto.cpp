@@ -31,6 +31,8 @@
 
 #include "mongo/db/pipeline/document_source_bucket_auto.h"
 
+#include <algorithm>
+
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 
@@ -89,13 +91,17 @@ const char* DocumentSourceBucketAuto::getSourceName() const {
 
 DocumentSource::GetNextResult DocumentSourceBucketAuto::doGetNext() {
     if (!_populated) {
-        const auto populationResult = populateSorter();
+        const auto populationResult = _approximate ? populateCentroids() : populateSorter();
         if (populationResult.isPaused()) {
             return populationResult;
         }
         invariant(populationResult.isEOF());
 
-        populateBuckets();
+        if (_approximate) {
+            populateBucketsFromCentroids();
+        } else {
+            populateBuckets();
+        }
 
         _populated = true;
         _bucketsIterator = _buckets.begin();
@@ -193,17 +199,158 @@ Value DocumentSourceBucketAuto::extractKey(const Document& doc) {
     return key.missing() ? Value(BSONNULL) : std::move(key);
 }
 
-void DocumentSourceBucketAuto::addDocumentToBucket(const pair<Value, Document>& entry,
-                                                   Bucket& bucket) {
-    invariant(pExpCtx->getValueComparator().evaluate(entry.first >= bucket._max));
-    bucket._max = entry.first;
+DocumentSource::GetNextResult DocumentSourceBucketAuto::populateCentroids() {
+    auto next = pSource->getNext();
+    for (; next.isAdvanced(); next = pSource->getNext()) {
+        auto nextDoc = next.releaseDocument();
+        _approximateBufferBytes += nextDoc.getApproximateSize();
+        _approximateBuffer.emplace_back(extractKey(nextDoc), std::move(nextDoc));
+        _nDocuments++;
+
+        if (_approximateBuffer.size() >= kApproximateMaxBufferedDocuments ||
+            _approximateBufferBytes >= _maxMemoryUsageBytes / 2) {
+            flushApproximateBuffer();
+        }
+    }
+    if (next.isEOF()) {
+        flushApproximateBuffer();
+    }
+    return next;
+}
+
+void DocumentSourceBucketAuto::flushApproximateBuffer() {
+    const auto& valueCmp = pExpCtx->getValueComparator();
+    std::stable_sort(_approximateBuffer.begin(),
+                     _approximateBuffer.end(),
+                     [&](const auto& lhs, const auto& rhs) {
+                         return valueCmp.evaluate(lhs.first < rhs.first);
+                     });
+
+    // Merge the sorted buffer into the existing ranges. A document whose value falls within an
+    // existing range is accumulated into it, so that the ranges stay disjoint. Any other document
+    // starts a new range, unless the range just before it ends with the same value.
+    vector<Bucket> merged;
+    merged.reserve(_centroids.size() + _approximateBuffer.size());
+    auto centroid = _centroids.begin();
+    for (auto&& [key, doc] : _approximateBuffer) {
+        while (centroid != _centroids.end() && valueCmp.evaluate(centroid->_max < key)) {
+            merged.push_back(std::move(*centroid++));
+        }
+
+        if (centroid != _centroids.end() && valueCmp.evaluate(centroid->_min <= key)) {
+            accumulate(doc, *centroid);
+        } else if (!merged.empty() && valueCmp.evaluate(merged.back()._max == key)) {
+            accumulate(doc, merged.back());
+        } else {
+            merged.emplace_back(pExpCtx, key, key, _accumulatedFields);
+            initializeAccumulators(merged.back());
+            accumulate(doc, merged.back());
+        }
+    }
+    std::move(centroid, _centroids.end(), std::back_inserter(merged));
+    _approximateBuffer.clear();
+    _approximateBufferBytes = 0;
+
+    const size_t maxCentroids = static_cast<size_t>(_nBuckets) * kApproximateCentroidsPerBucket;
+    if (merged.size() > maxCentroids) {
+        // Merge neighbouring ranges as long as the result holds no more than an even share of the
+        // documents. A range which alone holds more than that is left as is.
+        const long long maxCount = (_nDocuments + maxCentroids - 1) / maxCentroids;
+        _centroids.clear();
+        for (auto&& range : merged) {
+            if (!_centroids.empty() && _centroids.back()._count + range._count <= maxCount) {
+                mergeBuckets(_centroids.back(), range);
+            } else {
+                _centroids.push_back(std::move(range));
+            }
+        }
+    } else {
+        _centroids = std::move(merged);
+    }
+}
+
+void DocumentSourceBucketAuto::populateBucketsFromCentroids() {
+    // If there are no buckets, then we don't need to populate anything.
+    if (_nBuckets == 0) {
+        return;
+    }
+
+    // Calculate the approximate bucket size the same way as populateBuckets() does.
+    long long approxBucketSize = std::round(double(_nDocuments) / double(_nBuckets));
+    if (approxBucketSize < 1) {
+        approxBucketSize = 1;
+    }
+
+    const auto& valueCmp = pExpCtx->getValueComparator();
+    auto centroid = _centroids.begin();
+    for (int i = 0; i < _nBuckets && centroid != _centroids.end(); i++) {
+        const bool isLastBucket = (i == _nBuckets - 1);
+
+        // Keep adding whole ranges until the bucket is full. The last bucket takes all of the
+        // remaining ranges.
+        Bucket currentBucket = std::move(*centroid++);
+        while (centroid != _centroids.end() &&
+               (isLastBucket || currentBucket._count < approxBucketSize)) {
+            mergeBuckets(currentBucket, *centroid++);
+        }
+
+        if (_granularityRounder && !isLastBucket) {
+            // Absorb any ranges which now start below the rounded boundary, rounding again if that
+            // moved the bucket's maximum.
+            Value boundaryValue = _granularityRounder->roundUp(currentBucket._max);
+            while (centroid != _centroids.end() &&
+                   valueCmp.evaluate(boundaryValue > centroid->_min)) {
+                mergeBuckets(currentBucket, *centroid++);
+                boundaryValue = _granularityRounder->roundUp(currentBucket._max);
+            }
+            if (centroid != _centroids.end()) {
+                currentBucket._max = boundaryValue;
+            }
+        }
 
+        addBucket(currentBucket);
+    }
+    _centroids.clear();
+
+    roundOuterBucketBoundaries();
+}
+
+void DocumentSourceBucketAuto::initializeAccumulators(Bucket& bucket) {
+    // Evaluate each initializer against an empty document. Normally the
+    // initializer can refer to the group key, but in $bucketAuto there is no single
+    // group key per bucket.
+    Document emptyDoc;
+    for (size_t k = 0; k < _accumulatedFields.size(); ++k) {
+        Value initializerValue =
+            _accumulatedFields[k].expr.initializer->evaluate(emptyDoc, &pExpCtx->variables);
+        bucket._accums[k]->startNewGroup(initializerValue);
+    }
+}
+
+void DocumentSourceBucketAuto::accumulate(const Document& doc, Bucket& bucket) {
     const size_t numAccumulators = _accumulatedFields.size();
     for (size_t k = 0; k < numAccumulators; k++) {
         bucket._accums[k]->process(
-            _accumulatedFields[k].expr.argument->evaluate(entry.second, &pExpCtx->variables),
-            false);
+            _accumulatedFields[k].expr.argument->evaluate(doc, &pExpCtx->variables), false);
+    }
+    bucket._count++;
+}
+
+void DocumentSourceBucketAuto::mergeBuckets(Bucket& into, Bucket& from) {
+    const bool merging = true;
+    const size_t numAccumulators = _accumulatedFields.size();
+    for (size_t k = 0; k < numAccumulators; k++) {
+        into._accums[k]->process(from._accums[k]->getValue(merging), merging);
     }
+    into._max = from._max;
+    into._count += from._count;
+}
+
+void DocumentSourceBucketAuto::addDocumentToBucket(const pair<Value, Document>& entry,
+                                                   Bucket& bucket) {
+    invariant(pExpCtx->getValueComparator().evaluate(entry.first >= bucket._max));
+    bucket._max = entry.first;
+    accumulate(entry.second, bucket);
 }
 
 void DocumentSourceBucketAuto::populateBuckets() {
@@ -246,16 +393,7 @@ void DocumentSourceBucketAuto::populateBuckets() {
 
         // Initialize the current bucket.
         Bucket currentBucket(pExpCtx, currentValue.first, currentValue.first, _accumulatedFields);
-
-        // Evaluate each initializer against an empty document. Normally the
-        // initializer can refer to the group key, but in $bucketAuto there is no single
-        // group key per bucket.
-        Document emptyDoc;
-        for (size_t k = 0; k < _accumulatedFields.size(); ++k) {
-            Value initializerValue =
-                _accumulatedFields[k].expr.initializer->evaluate(emptyDoc, &pExpCtx->variables);
-            currentBucket._accums[k]->startNewGroup(initializerValue);
-        }
+        initializeAccumulators(currentBucket);
 
         // Add the first value into the current bucket.
         addDocumentToBucket(currentValue, currentBucket);
@@ -315,6 +453,10 @@ void DocumentSourceBucketAuto::populateBuckets() {
         addBucket(currentBucket);
     }
 
+    roundOuterBucketBoundaries();
+}
+
+void DocumentSourceBucketAuto::roundOuterBucketBoundaries() {
     if (!_buckets.empty() && _granularityRounder) {
         // If we we have a granularity, we round the first bucket's minimum down and the last
         // bucket's maximum up. This way all of the bucket boundaries are rounded to numbers in the
@@ -389,6 +531,8 @@ Document DocumentSourceBucketAuto::makeDocument(const Bucket& bucket) {
 
 void DocumentSourceBucketAuto::doDispose() {
     _sortedInput.reset();
+    _approximateBuffer.clear();
+    _centroids.clear();
     _bucketsIterator = _buckets.end();
 }
 
@@ -403,6 +547,10 @@ Value DocumentSourceBucketAuto::serialize(
         insides["granularity"] = Value(_granularityRounder->getName());
     }
 
+    if (_approximate) {
+        insides["approximate"] = Value(true);
+    }
+
     MutableDocument outputSpec(_accumulatedFields.size());
     for (auto&& accumulatedField : _accumulatedFields) {
         intrusive_ptr<AccumulatorState> accum = accumulatedField.makeAccumulator();
@@ -422,7 +570,8 @@ intrusive_ptr<DocumentSourceBucketAuto> DocumentSourceBucketAuto::create(
     int numBuckets,
     std::vector<AccumulationStatement> accumulationStatements,
     const boost::intrusive_ptr<GranularityRounder>& granularityRounder,
-    uint64_t maxMemoryUsageBytes) {
+    uint64_t maxMemoryUsageBytes,
+    bool approximate) {
     uassert(40243,
             str::stream() << "The $bucketAuto 'buckets' field must be greater than 0, but found: "
                           << numBuckets,
@@ -440,7 +589,8 @@ intrusive_ptr<DocumentSourceBucketAuto> DocumentSourceBucketAuto::create(
                                         numBuckets,
                                         accumulationStatements,
                                         granularityRounder,
-                                        maxMemoryUsageBytes);
+                                        maxMemoryUsageBytes,
+                                        approximate);
 }
 
 DocumentSourceBucketAuto::DocumentSourceBucketAuto(
@@ -449,12 +599,14 @@ DocumentSourceBucketAuto::DocumentSourceBucketAuto(
     int numBuckets,
     std::vector<AccumulationStatement> accumulationStatements,
     const boost::intrusive_ptr<GranularityRounder>& granularityRounder,
-    uint64_t maxMemoryUsageBytes)
+    uint64_t maxMemoryUsageBytes,
+    bool approximate)
     : DocumentSource(kStageName, pExpCtx),
       _nBuckets(numBuckets),
       _maxMemoryUsageBytes(maxMemoryUsageBytes),
       _groupByExpression(groupByExpression),
-      _granularityRounder(granularityRounder) {
+      _granularityRounder(granularityRounder),
+      _approximate(approximate) {
 
     invariant(!accumulationStatements.empty());
     for (auto&& accumulationStatement : accumulationStatements) {
@@ -482,6 +634,7 @@ intrusive_ptr<DocumentSource> DocumentSourceBucketAuto::createFromBson(
     boost::intrusive_ptr<Expression> groupByExpression;
     boost::optional<int> numBuckets;
     boost::intrusive_ptr<GranularityRounder> granularityRounder;
+    bool approximate = false;
 
     for (auto&& argument : elem.Obj()) {
         const auto argName = argument.fieldNameStringData();
@@ -527,6 +680,13 @@ intrusive_ptr<DocumentSource> DocumentSourceBucketAuto::createFromBson(
                         << typeName(argument.type()),
                     argument.type() == BSONType::String);
             granularityRounder = GranularityRounder::getGranularityRounder(pExpCtx, argument.str());
+        } else if ("approximate" == argName) {
+            uassert(5212021,
+                    str::stream()
+                        << "The $bucketAuto 'approximate' field must be a boolean, but found type: "
+                        << typeName(argument.type()),
+                    argument.type() == BSONType::Bool);
+            approximate = argument.boolean();
         } else {
             uasserted(40245, str::stream() << "Unrecognized option to $bucketAuto: " << argName);
         }
@@ -536,8 +696,13 @@ intrusive_ptr<DocumentSource> DocumentSourceBucketAuto::createFromBson(
             "$bucketAuto requires 'groupBy' and 'buckets' to be specified",
             groupByExpression && numBuckets);
 
-    return DocumentSourceBucketAuto::create(
-        pExpCtx, groupByExpression, numBuckets.get(), accumulationStatements, granularityRounder);
+    return DocumentSourceBucketAuto::create(pExpCtx,
+                                            groupByExpression,
+                                            numBuckets.get(),
+                                            accumulationStatements,
+                                            granularityRounder,
+                                            kDefaultMaxMemoryUsageBytes,
+                                            approximate);
 }
 
 }  // namespace mongo
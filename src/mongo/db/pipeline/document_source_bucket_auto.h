@@ -72,11 +72,25 @@ public:
 
     static const uint64_t kDefaultMaxMemoryUsageBytes = 100 * 1024 * 1024;
 
+    /**
+     * In approximate mode, the number of ranges of 'groupBy' values kept per requested bucket.
+     */
+    static constexpr size_t kApproximateCentroidsPerBucket = 32;
+
+    /**
+     * In approximate mode, the maximum number of input documents held before they are folded into
+     * the ranges of 'groupBy' values seen so far.
+     */
+    static constexpr size_t kApproximateMaxBufferedDocuments = 4096;
+
     /**
      * Convenience method to create a $bucketAuto stage.
      *
      * If 'accumulationStatements' is the empty vector, it will be filled in with the statement
      * 'count: {$sum: 1}'.
+     *
+     * If 'approximate' is true, bucket boundaries are chosen in a single pass with bounded memory
+     * instead of by sorting the whole input. See populateCentroids().
      */
     static boost::intrusive_ptr<DocumentSourceBucketAuto> create(
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
@@ -84,7 +98,8 @@ public:
         int numBuckets,
         std::vector<AccumulationStatement> accumulationStatements = {},
         const boost::intrusive_ptr<GranularityRounder>& granularityRounder = nullptr,
-        uint64_t maxMemoryUsageBytes = kDefaultMaxMemoryUsageBytes);
+        uint64_t maxMemoryUsageBytes = kDefaultMaxMemoryUsageBytes,
+        bool approximate = false);
 
     /**
      * Parses a $bucketAuto stage from the user-supplied BSON.
@@ -105,7 +120,8 @@ private:
                              int numBuckets,
                              std::vector<AccumulationStatement> accumulationStatements,
                              const boost::intrusive_ptr<GranularityRounder>& granularityRounder,
-                             uint64_t maxMemoryUsageBytes);
+                             uint64_t maxMemoryUsageBytes,
+                             bool approximate);
 
     // struct for holding information about a bucket.
     struct Bucket {
@@ -116,6 +132,7 @@ private:
         Value _min;
         Value _max;
         std::vector<boost::intrusive_ptr<AccumulatorState>> _accums;
+        long long _count = 0;
     };
 
     /**
@@ -136,6 +153,41 @@ private:
      */
     void populateBuckets();
 
+    /**
+     * Approximate mode counterpart of populateSorter(). Rather than sorting the input, keeps a
+     * sorted list of disjoint ranges of 'groupBy' values, each with the accumulated results of the
+     * documents falling into it. Documents are buffered and then folded into these ranges, and
+     * neighbouring ranges are merged whenever there are more than kApproximateCentroidsPerBucket
+     * per requested bucket. As with populateSorter(), returns the last GetNextResult encountered.
+     */
+    GetNextResult populateCentroids();
+
+    /**
+     * Folds the buffered documents into '_centroids', then merges neighbouring ranges if needed.
+     */
+    void flushApproximateBuffer();
+
+    /**
+     * Approximate mode counterpart of populateBuckets(), which forms the buckets from whole ranges
+     * in '_centroids'.
+     */
+    void populateBucketsFromCentroids();
+
+    /**
+     * Evaluates the accumulators' initializers and starts a new group in each of them.
+     */
+    void initializeAccumulators(Bucket& bucket);
+
+    /**
+     * Updates the accumulators in 'bucket' with the document 'doc'.
+     */
+    void accumulate(const Document& doc, Bucket& bucket);
+
+    /**
+     * Merges the accumulators of 'from' into 'into', which must hold the lower range of values.
+     */
+    void mergeBuckets(Bucket& into, Bucket& from);
+
     /**
      * Adds the document in 'entry' to 'bucket' by updating the accumulators in 'bucket'.
      */
@@ -146,6 +198,12 @@ private:
      */
     void addBucket(Bucket& newBucket);
 
+    /**
+     * When a granularity is specified, rounds the first bucket's minimum down and the last
+     * bucket's maximum up.
+     */
+    void roundOuterBucketBoundaries();
+
     /**
      * Makes a document using the information from bucket. This is what is returned when getNext()
      * is called.
@@ -165,6 +223,13 @@ private:
     boost::intrusive_ptr<Expression> _groupByExpression;
     boost::intrusive_ptr<GranularityRounder> _granularityRounder;
     long long _nDocuments = 0;
+
+    const bool _approximate;
+
+    // Only used in approximate mode. '_centroids' is sorted by the 'groupBy' ranges it covers.
+    std::vector<std::pair<Value, Document>> _approximateBuffer;
+    size_t _approximateBufferBytes = 0;
+    std::vector<Bucket> _centroids;
 };
 
 }  // namespace mongo
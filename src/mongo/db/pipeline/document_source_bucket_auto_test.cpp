@@ -314,6 +314,54 @@ TEST_F(BucketAutoTests, RespectsCanonicalTypeOrderingOfValues) {
     ASSERT_DOCUMENT_EQ(results[1], Document(fromjson("{_id : {min : 'a', max : 'b'}, count : 2}")));
 }
 
+TEST_F(BucketAutoTests, ApproximateMatchesExactWhenFewDistinctValues) {
+    deque<Document> inputs;
+    for (int i = 0; i < 200; ++i) {
+        inputs.push_back(Document{{"x", (i * 7) % 23}, {"y", i}});
+    }
+    const auto output = fromjson("{count: {$sum: 1}, y: {$sum: '$y'}, m: {$max: '$y'}}");
+    for (auto&& buckets : {1, 3, 5, 40}) {
+        auto makeSpec = [&](bool approximate) {
+            return BSON("$bucketAuto" << BSON("groupBy"
+                                              << "$x"
+                                              << "buckets" << buckets << "approximate"
+                                              << approximate << "output" << output));
+        };
+        auto exactResults = getResults(makeSpec(false), inputs);
+        auto approximateResults = getResults(makeSpec(true), inputs);
+        ASSERT_EQ(exactResults.size(), approximateResults.size());
+        for (size_t i = 0; i < exactResults.size(); ++i) {
+            ASSERT_DOCUMENT_EQ(exactResults[i], approximateResults[i]);
+        }
+    }
+}
+
+TEST_F(BucketAutoTests, ApproximateProducesRoughlyEvenBucketsForManyDistinctValues) {
+    const int nDocs = 20000;
+    deque<Document> inputs;
+    for (int i = 0; i < nDocs; ++i) {
+        // Visit every value once, out of order.
+        inputs.push_back(Document{{"x", (i * 7919) % nDocs}});
+    }
+    auto spec = fromjson("{$bucketAuto : {groupBy : '$x', buckets : 4, approximate : true}}");
+    auto results = getResults(spec, inputs);
+
+    ASSERT_EQUALS(results.size(), 4UL);
+    long long total = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto count = results[i]["count"].coerceToLong();
+        total += count;
+        ASSERT_GT(count, nDocs / 4 * 0.9);
+        ASSERT_LT(count, nDocs / 4 * 1.1);
+        if (i > 0) {
+            ASSERT_VALUE_EQ(results[i - 1]["_id"]["max"], results[i]["_id"]["min"]);
+        }
+    }
+    ASSERT_EQ(total, nDocs);
+    ASSERT_VALUE_EQ(results.front()["_id"]["min"], Value(0));
+    ASSERT_VALUE_EQ(results.back()["_id"]["max"], Value(nDocs - 1));
+}
+
 TEST_F(BucketAutoTests, ShouldPropagatePauses) {
     auto bucketAutoSpec = fromjson("{$bucketAuto : {groupBy : '$x', buckets : 2}}");
     auto bucketAutoStage = createBucketAuto(bucketAutoSpec);
@@ -506,6 +554,23 @@ TEST_F(BucketAutoTests, SerializesGranularityFieldIfSpecified) {
     testSerialize(spec, expected);
 }
 
+TEST_F(BucketAutoTests, SerializesApproximateFieldIfSpecified) {
+    BSONObj spec = fromjson("{$bucketAuto : {groupBy : '$x', buckets : 2, approximate : true}}");
+    BSONObj expected = fromjson(
+        "{groupBy : '$x', buckets : 2, approximate : true, output : {count : {$sum : {$const : "
+        "1}}}}");
+    testSerialize(spec, expected);
+
+    spec = fromjson("{$bucketAuto : {groupBy : '$x', buckets : 2, approximate : false}}");
+    expected = fromjson("{groupBy : '$x', buckets : 2, output : {count : {$sum : {$const : 1}}}}");
+    testSerialize(spec, expected);
+}
+
+TEST_F(BucketAutoTests, FailsWithNonBooleanApproximate) {
+    auto spec = fromjson("{$bucketAuto : {groupBy : '$x', buckets : 2, approximate : 1}}");
+    ASSERT_THROWS_CODE(createBucketAuto(spec), AssertionException, 5212021);
+}
+
 TEST_F(BucketAutoTests, ShouldBeAbleToReParseSerializedStage) {
     auto bucketAuto =
         createBucketAuto(fromjson("{$bucketAuto : {groupBy : '$x', buckets : 2, granularity: 'R5', "
@@ -240,6 +240,26 @@ std::string DocumentSourceChangeStream::getNsRegexForChangeStream(const Namespac
     }
 }
 
+namespace {
+
+/**
+ * Returns a predicate matching 'fieldName' against the namespaces a change stream on 'nss' reports
+ * on. Every open change stream evaluates its filter against every oplog entry, so a stream on a
+ * single collection matches its namespace by equality rather than by the equivalent anchored regex.
+ */
+BSONObj buildNsMatch(StringData fieldName, const NamespaceString& nss) {
+    BSONObjBuilder builder;
+    if (DocumentSourceChangeStream::getChangeStreamType(nss) ==
+        DocumentSourceChangeStream::ChangeStreamType::kSingleCollection) {
+        builder.append(fieldName, nss.ns());
+    } else {
+        builder.appendRegex(fieldName, DocumentSourceChangeStream::getNsRegexForChangeStream(nss));
+    }
+    return builder.obj();
+}
+
+}  // namespace
+
 BSONObj DocumentSourceChangeStream::buildMatchFilter(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     Timestamp startFromInclusive,
@@ -277,7 +297,7 @@ BSONObj DocumentSourceChangeStream::buildMatchFilter(
         BSON("$and" << BSON_ARRAY(cmdNsFilter << BSON("$or" << relevantCommands.arr())));
 
     // 1.2) Supported commands that have arbitrary db namespaces in "ns" field.
-    auto renameDropTarget = BSON("o.to" << BSONRegEx(getNsRegexForChangeStream(nss)));
+    auto renameDropTarget = buildNsMatch("o.to", nss);
 
     // 1.3) Transaction commit commands.
     auto transactionCommit = BSON("o.commitTransaction" << 1);
@@ -289,7 +309,7 @@ BSONObj DocumentSourceChangeStream::buildMatchFilter(
 
     // 2) Supported operations on the operation namespace, optionally including those from
     // migrations.
-    BSONObj opNsMatch = BSON("ns" << BSONRegEx(getNsRegexForChangeStream(nss)));
+    BSONObj opNsMatch = buildNsMatch("ns", nss);
 
     // 2.1) Normal CRUD ops.
     auto normalOpTypeMatch = BSON("op" << NE << "n");
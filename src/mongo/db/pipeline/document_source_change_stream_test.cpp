@@ -1464,6 +1464,20 @@ TEST_F(ChangeStreamStageTest, MatchFiltersNoOp) {
     checkTransformation(noOp, boost::none);
 }
 
+TEST_F(ChangeStreamStageTest, MatchFiltersOtherCollectionsByNamespaceEquality) {
+    // A single-collection stream matches its namespace by equality rather than by regex.
+    auto filter = DSChangeStream::buildMatchFilter(getExpCtx(), kDefaultTs, false);
+    ASSERT_EQ(filter.toString().find("/^"), std::string::npos) << filter;
+
+    for (auto&& ns : {NamespaceString("unittests.change_stream2"),
+                      NamespaceString("unittests.change_strea"),
+                      NamespaceString("unittestsxchange_stream"),
+                      NamespaceString("other.change_stream")}) {
+        auto insert = makeOplogEntry(OpTypeEnum::kInsert, ns, BSON("_id" << 1));
+        checkTransformation(insert, boost::none);
+    }
+}
+
 TEST_F(ChangeStreamStageTest, TransformationShouldBeAbleToReParseSerializedStage) {
     auto expCtx = getExpCtx();
 
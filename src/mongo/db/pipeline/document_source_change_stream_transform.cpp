@@ -186,18 +186,21 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
     checkValueType(input[repl::OplogEntry::kOpTypeFieldName],
                    repl::OplogEntry::kOpTypeFieldName,
                    BSONType::String);
-    string op = input[repl::OplogEntry::kOpTypeFieldName].getString();
+    Value op = input[repl::OplogEntry::kOpTypeFieldName];
     Value ts = input[repl::OplogEntry::kTimestampFieldName];
     Value ns = input[repl::OplogEntry::kNssFieldName];
     checkValueType(ns, repl::OplogEntry::kNssFieldName, BSONType::String);
     Value uuid = input[repl::OplogEntry::kUuidFieldName];
     Value preImageOpTime = input[repl::OplogEntry::kPreImageOpTimeFieldName];
-    std::vector<FieldPath> documentKeyFields;
+    // Points into '_documentKeyCache', which is not modified again while this event is built.
+    static const std::vector<FieldPath> kNoDocumentKeyFields;
+    const std::vector<FieldPath>* documentKeyFields = &kNoDocumentKeyFields;
 
     // Deal with CRUD operations and commands.
-    auto opType = repl::OpType_parse(IDLParserErrorContext("ChangeStreamEntry.op"), op);
+    auto opType =
+        repl::OpType_parse(IDLParserErrorContext("ChangeStreamEntry.op"), op.getStringData());
 
-    NamespaceString nss(ns.getString());
+    NamespaceString nss(ns.getStringData());
     // Ignore commands in the oplog when looking up the document key fields since a command implies
     // that the change stream is about to be invalidated (e.g. collection drop).
     if (!uuid.missing() && opType != repl::OpTypeEnum::kCommand) {
@@ -215,9 +218,10 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
             }
         }
 
-        documentKeyFields = _documentKeyCache.find(uuid.getUuid())->second.documentKeyFields;
+        documentKeyFields = &_documentKeyCache.find(uuid.getUuid())->second.documentKeyFields;
     }
-    Value id = input.getNestedField("o._id");
+    static const FieldPath kIdPath("o._id");
+    Value id = input.getNestedField(kIdPath);
     // Non-replace updates have the _id in field "o2".
     StringData operationType;
     Value fullDocument;
@@ -229,7 +233,7 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
             operationType = DocumentSourceChangeStream::kInsertOpType;
             fullDocument = input[repl::OplogEntry::kObjectFieldName];
             documentKey = Value(document_path_support::extractPathsFromDoc(
-                fullDocument.getDocument(), documentKeyFields));
+                fullDocument.getDocument(), *documentKeyFields));
             break;
         }
         case repl::OpTypeEnum::kDelete: {
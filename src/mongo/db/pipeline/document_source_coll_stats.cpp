@@ -70,6 +70,9 @@ intrusive_ptr<DocumentSource> DocumentSourceCollStats::createFromBson(
                                       << elem << "of type " << typeName(elem.type()),
                         elem["histograms"].isBoolean());
             }
+            if (auto percentiles = elem["percentiles"]) {
+                OperationLatencyHistogram::parsePercentiles(percentiles);
+            }
         } else if ("storageStats" == fieldName) {
             uassert(40279,
                     str::stream() << "storageStats argument must be an object, but got " << elem
@@ -121,11 +124,15 @@ DocumentSource::GetNextResult DocumentSourceCollStats::doGetNext() {
     if (_collStatsSpec.hasField("latencyStats")) {
         // If the latencyStats field exists, it must have been validated as an object when parsing.
         bool includeHistograms = false;
+        std::vector<double> percentiles;
         if (_collStatsSpec["latencyStats"].type() == BSONType::Object) {
             includeHistograms = _collStatsSpec["latencyStats"]["histograms"].boolean();
+            if (auto percentilesElem = _collStatsSpec["latencyStats"]["percentiles"]) {
+                percentiles = OperationLatencyHistogram::parsePercentiles(percentilesElem);
+            }
         }
         pExpCtx->mongoProcessInterface->appendLatencyStats(
-            pExpCtx->opCtx, pExpCtx->ns, includeHistograms, &builder);
+            pExpCtx->opCtx, pExpCtx->ns, includeHistograms, percentiles, &builder);
     }
 
     if (_collStatsSpec.hasField("storageStats")) {
@@ -38,6 +38,7 @@
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/bsontypes.h"
+#include "mongo/db/client.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/document_source_tee_consumer.h"
@@ -45,7 +46,10 @@
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/tee_buffer.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -56,14 +60,23 @@ using std::string;
 using std::vector;
 
 DocumentSourceFacet::DocumentSourceFacet(std::vector<FacetPipeline> facetPipelines,
-                                         const intrusive_ptr<ExpressionContext>& expCtx)
+                                         const intrusive_ptr<ExpressionContext>& expCtx,
+                                         bool runFacetsConcurrently)
     : DocumentSource(kStageName, expCtx),
       _teeBuffer(TeeBuffer::create(facetPipelines.size())),
-      _facets(std::move(facetPipelines)) {
+      _facets(std::move(facetPipelines)),
+      _runsFacetsConcurrently(runFacetsConcurrently) {
+    if (_runsFacetsConcurrently) {
+        _teeBuffer->setConcurrentConsumers();
+    }
     for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
         auto& facet = _facets[facetId];
-        facet.pipeline->addInitialSource(
-            DocumentSourceTeeConsumer::create(pExpCtx, facetId, _teeBuffer));
+        // The consumer shares the ExpressionContext of its sub-pipeline, since it runs on the same
+        // thread.
+        facet.pipeline->addInitialSource(DocumentSourceTeeConsumer::create(
+            _runsFacetsConcurrently ? facet.pipeline->getContext() : pExpCtx,
+            facetId,
+            _teeBuffer));
     }
 }
 
@@ -104,6 +117,63 @@ vector<pair<string, vector<BSONObj>>> extractRawPipelines(const BSONElement& ele
     return rawFacetPipelines;
 }
 
+/**
+ * Parses and validates the sub-pipelines of a $facet. If 'withOwnExpressionContexts' is true, each
+ * of them is parsed with its own copy of 'expCtx'.
+ */
+std::vector<DocumentSourceFacet::FacetPipeline> parseFacetPipelines(
+    const vector<pair<string, vector<BSONObj>>>& rawFacets,
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    bool withOwnExpressionContexts) {
+    boost::optional<std::string> needsMongoS;
+    boost::optional<std::string> needsShard;
+
+    std::vector<DocumentSourceFacet::FacetPipeline> facetPipelines;
+    for (auto&& rawFacet : rawFacets) {
+        const auto facetName = rawFacet.first;
+
+        auto facetExpCtx = withOwnExpressionContexts ? expCtx->copyWith(expCtx->ns, expCtx->uuid)
+                                                     : expCtx;
+        auto pipeline = Pipeline::parse(rawFacet.second, facetExpCtx, [](const Pipeline& pipeline) {
+            auto sources = pipeline.getSources();
+            uassert(ErrorCodes::BadValue,
+                    "sub-pipeline in $facet stage cannot be empty",
+                    !sources.empty());
+
+            std::for_each(sources.begin(), sources.end(), [](auto& stage) {
+                auto stageConstraints = stage->constraints();
+                uassert(40600,
+                        str::stream() << stage->getSourceName()
+                                      << " is not allowed to be used within a $facet stage",
+                        stageConstraints.isAllowedInsideFacetStage());
+                // We expect a stage within a $facet stage to have these properties.
+                invariant(stageConstraints.requiredPosition ==
+                          StageConstraints::PositionRequirement::kNone);
+                invariant(!stageConstraints.isIndependentOfAnyCollection);
+            });
+        });
+
+        // Validate that none of the facet pipelines have any conflicting HostTypeRequirements. This
+        // verifies both that all stages within each pipeline are consistent, and that the pipelines
+        // are consistent with one another.
+        if (!needsShard && pipeline->needsShard()) {
+            needsShard.emplace(facetName);
+        }
+        if (!needsMongoS && pipeline->needsMongosMerger()) {
+            needsMongoS.emplace(facetName);
+        }
+        uassert(ErrorCodes::IllegalOperation,
+                str::stream() << "$facet pipeline '" << *needsMongoS
+                              << "' must run on mongoS, but '" << *needsShard
+                              << "' requires a shard",
+                !(needsShard && needsMongoS));
+
+        facetPipelines.emplace_back(facetName, std::move(pipeline));
+    }
+
+    return facetPipelines;
+}
+
 }  // namespace
 
 std::unique_ptr<DocumentSourceFacet::LiteParsed> DocumentSourceFacet::LiteParsed::parse(
@@ -136,6 +206,9 @@ void DocumentSourceFacet::doDispose() {
         facet.pipeline.get_deleter().dismissDisposal();
         facet.pipeline->dispose(pExpCtx->opCtx);
     }
+    if (_runsFacetsConcurrently) {
+        _teeBuffer->disposeSourceIfUnused();
+    }
 }
 
 DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
@@ -144,7 +217,10 @@ DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
     }
 
     vector<vector<Value>> results(_facets.size());
-    bool allPipelinesEOF = false;
+    bool allPipelinesEOF = _runsFacetsConcurrently;
+    if (_runsFacetsConcurrently) {
+        runFacetsConcurrently(&results);
+    }
     while (!allPipelinesEOF) {
         allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
         for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
@@ -166,6 +242,73 @@ DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
     return resultDoc.freeze();
 }
 
+void DocumentSourceFacet::runFacetsConcurrently(std::vector<std::vector<Value>>* results) {
+    auto opCtx = pExpCtx->opCtx;
+
+    ThreadPool::Options options;
+    options.poolName = "FacetThreadPool";
+    options.threadNamePrefix = "facet-";
+    options.maxThreads = std::min(_facets.size(),
+                                  static_cast<size_t>(internalQueryFacetMaxConcurrency.load()));
+    options.onCreateThread = [](const std::string& threadName) {
+        Client::initThread(threadName.c_str());
+    };
+    ThreadPool pool(options);
+    pool.startup();
+    ON_BLOCK_EXIT([&] {
+        pool.shutdown();
+        pool.join();
+    });
+
+    // Each sub-pipeline only touches its own slot of these while it runs.
+    std::vector<char> eof(_facets.size(), false);
+    std::vector<Status> statuses(_facets.size(), Status::OK());
+
+    while (std::find(eof.begin(), eof.end(), false) != eof.end()) {
+        opCtx->checkForInterrupt();
+        _teeBuffer->loadNextBatchForConcurrentConsumers();
+
+        for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+            if (eof[facetId]) {
+                continue;
+            }
+            pool.schedule([&, facetId](Status status) {
+                if (!status.isOK()) {
+                    statuses[facetId] = status;
+                    return;
+                }
+                try {
+                    auto facetOpCtx = cc().makeOperationContext();
+                    if (opCtx->hasDeadline()) {
+                        facetOpCtx->setDeadlineByDate(opCtx->getDeadline(),
+                                                      opCtx->getTimeoutError());
+                    }
+
+                    const auto& pipeline = _facets[facetId].pipeline;
+                    pipeline->reattachToOperationContext(facetOpCtx.get());
+                    ON_BLOCK_EXIT([&] { pipeline->detachFromOperationContext(); });
+
+                    auto next = pipeline->getSources().back()->getNext();
+                    for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
+                        (*results)[facetId].emplace_back(next.releaseDocument());
+                    }
+                    eof[facetId] = next.isEOF();
+                } catch (const DBException& ex) {
+                    statuses[facetId] = ex.toStatus();
+                }
+            });
+        }
+        pool.waitForIdle();
+
+        for (auto&& facet : _facets) {
+            facet.pipeline->reattachToOperationContext(opCtx);
+        }
+        for (auto&& status : statuses) {
+            uassertStatusOK(status);
+        }
+    }
+}
+
 Value DocumentSourceFacet::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
     MutableDocument serialized;
     for (auto&& facet : _facets) {
@@ -283,51 +426,26 @@ DepsTracker::State DocumentSourceFacet::getDependencies(DepsTracker* deps) const
 
 intrusive_ptr<DocumentSource> DocumentSourceFacet::createFromBson(
     BSONElement elem, const intrusive_ptr<ExpressionContext>& expCtx) {
-
-    boost::optional<std::string> needsMongoS;
-    boost::optional<std::string> needsShard;
-
-    std::vector<FacetPipeline> facetPipelines;
-    for (auto&& rawFacet : extractRawPipelines(elem)) {
-        const auto facetName = rawFacet.first;
-
-        auto pipeline = Pipeline::parse(rawFacet.second, expCtx, [](const Pipeline& pipeline) {
-            auto sources = pipeline.getSources();
-            uassert(ErrorCodes::BadValue,
-                    "sub-pipeline in $facet stage cannot be empty",
-                    !sources.empty());
-
-            std::for_each(sources.begin(), sources.end(), [](auto& stage) {
-                auto stageConstraints = stage->constraints();
-                uassert(40600,
-                        str::stream() << stage->getSourceName()
-                                      << " is not allowed to be used within a $facet stage",
-                        stageConstraints.isAllowedInsideFacetStage());
-                // We expect a stage within a $facet stage to have these properties.
-                invariant(stageConstraints.requiredPosition ==
-                          StageConstraints::PositionRequirement::kNone);
-                invariant(!stageConstraints.isIndependentOfAnyCollection);
-            });
+    const auto rawFacets = extractRawPipelines(elem);
+    auto facetPipelines = parseFacetPipelines(rawFacets, expCtx, false);
+
+    // The sub-pipelines may run concurrently if none of them reads another collection, since that
+    // would share locks and storage state between threads, and if this $facet is not itself part
+    // of a sub-pipeline whose variables are rebound for each input. They are then parsed again,
+    // each with a copy of 'expCtx', since expression evaluation writes to its variables.
+    const bool runFacetsConcurrently = internalQueryFacetMaxConcurrency.load() > 1 &&
+        facetPipelines.size() > 1 && !expCtx->inMongos && expCtx->subPipelineDepth == 0 &&
+        std::all_of(facetPipelines.begin(), facetPipelines.end(), [](const auto& facet) {
+            stdx::unordered_set<NamespaceString> involvedNamespaces;
+            for (auto&& source : facet.pipeline->getSources()) {
+                source->addInvolvedCollections(&involvedNamespaces);
+            }
+            return involvedNamespaces.empty();
         });
-
-        // Validate that none of the facet pipelines have any conflicting HostTypeRequirements. This
-        // verifies both that all stages within each pipeline are consistent, and that the pipelines
-        // are consistent with one another.
-        if (!needsShard && pipeline->needsShard()) {
-            needsShard.emplace(facetName);
-        }
-        if (!needsMongoS && pipeline->needsMongosMerger()) {
-            needsMongoS.emplace(facetName);
-        }
-        uassert(ErrorCodes::IllegalOperation,
-                str::stream() << "$facet pipeline '" << *needsMongoS
-                              << "' must run on mongoS, but '" << *needsShard
-                              << "' requires a shard",
-                !(needsShard && needsMongoS));
-
-        facetPipelines.emplace_back(facetName, std::move(pipeline));
+    if (runFacetsConcurrently) {
+        facetPipelines = parseFacetPipelines(rawFacets, expCtx, true);
     }
 
-    return new DocumentSourceFacet(std::move(facetPipelines), expCtx);
+    return new DocumentSourceFacet(std::move(facetPipelines), expCtx, runFacetsConcurrently);
 }
 }  // namespace mongo
@@ -140,6 +140,13 @@ public:
     StageConstraints constraints(Pipeline::SplitState pipeState) const final;
     bool usedDisk() final;
 
+    /**
+     * Returns whether the sub-pipelines are run concurrently. See createFromBson().
+     */
+    bool runsFacetsConcurrently() const {
+        return _runsFacetsConcurrently;
+    }
+
 protected:
     /**
      * Blocking call. Will consume all input and produces one output document.
@@ -149,13 +156,26 @@ protected:
 
 private:
     DocumentSourceFacet(std::vector<FacetPipeline> facetPipelines,
-                        const boost::intrusive_ptr<ExpressionContext>& expCtx);
+                        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                        bool runFacetsConcurrently = false);
+
+    /**
+     * Feeds the input to the sub-pipelines one batch at a time, draining every sub-pipeline on a
+     * thread pool of up to 'internalQueryFacetMaxConcurrency' threads between batches. Each
+     * sub-pipeline runs under an OperationContext of its own, which inherits the deadline of this
+     * stage's. Appends the results of each sub-pipeline to 'results'.
+     */
+    void runFacetsConcurrently(std::vector<std::vector<Value>>* results);
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
 
     boost::intrusive_ptr<TeeBuffer> _teeBuffer;
     std::vector<FacetPipeline> _facets;
 
+    // Set when each sub-pipeline was parsed with an ExpressionContext of its own, allowing them
+    // to run on separate threads.
+    const bool _runsFacetsConcurrently;
+
     bool _done = false;
 };
 }  // namespace mongo
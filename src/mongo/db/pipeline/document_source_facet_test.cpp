@@ -44,8 +44,10 @@
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_skip.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 using std::deque;
@@ -433,6 +435,45 @@ TEST_F(DocumentSourceFacetTest, ShouldBeAbleToEvaluateMultipleStagesWithinOneSub
     ASSERT_DOCUMENT_EQ(output.getDocument(), Document(fromjson("{subPipe: [{_id: 0}, {_id: 1}]}")));
 }
 
+TEST_F(DocumentSourceFacetTest, ShouldRunSubPipelinesConcurrentlyWhenEnabled) {
+    const auto oldMaxConcurrency = internalQueryFacetMaxConcurrency.load();
+    const auto oldBufferSizeBytes = internalQueryFacetBufferSizeBytes.load();
+    internalQueryFacetMaxConcurrency.store(2);
+    internalQueryFacetBufferSizeBytes.store(1);  // Each document is a batch of its own.
+    ON_BLOCK_EXIT([&] {
+        internalQueryFacetMaxConcurrency.store(oldMaxConcurrency);
+        internalQueryFacetBufferSizeBytes.store(oldBufferSizeBytes);
+    });
+
+    auto ctx = getExpCtx();
+    auto spec = fromjson(
+        "{$facet: {sum: [{$group: {_id: null, total: {$sum: '$x'}}}],"
+        "          big: [{$match: {x: {$gt: 1}}}, {$project: {_id: 0, y: {$multiply: ['$x', 2]}}}],"
+        "          first: [{$limit: 1}]}}");
+    auto facetStage = DocumentSourceFacet::createFromBson(spec.firstElement(), ctx);
+    ASSERT_TRUE(static_cast<DocumentSourceFacet*>(facetStage.get())->runsFacetsConcurrently());
+
+    auto mock = DocumentSourceMock::createForTest({Document{{"_id", 0}, {"x", 1}},
+                                                   Document{{"_id", 1}, {"x", 2}},
+                                                   Document{{"_id", 2}, {"x", 3}}});
+    facetStage->setSource(mock.get());
+
+    auto output = facetStage->getNext();
+    ASSERT(output.isAdvanced());
+    ASSERT_DOCUMENT_EQ(output.getDocument(),
+                       Document(fromjson("{sum: [{_id: null, total: 6}],"
+                                         " big: [{y: 4}, {y: 6}],"
+                                         " first: [{_id: 0, x: 1}]}")));
+    ASSERT(facetStage->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceFacetTest, ShouldNotRunSubPipelinesConcurrentlyByDefault) {
+    auto ctx = getExpCtx();
+    auto spec = fromjson("{$facet: {a: [{$skip: 1}], b: [{$limit: 1}]}}");
+    auto facetStage = DocumentSourceFacet::createFromBson(spec.firstElement(), ctx);
+    ASSERT_FALSE(static_cast<DocumentSourceFacet*>(facetStage.get())->runsFacetsConcurrently());
+}
+
 TEST_F(DocumentSourceFacetTest, ShouldPropagateDisposeThroughToSource) {
     auto ctx = getExpCtx();
 
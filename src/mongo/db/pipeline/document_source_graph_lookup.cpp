@@ -31,6 +31,7 @@
 
 #include "mongo/db/pipeline/document_source_graph_lookup.h"
 
+#include <boost/filesystem/operations.hpp>
 #include <memory>
 
 #include "mongo/base/init.h"
@@ -44,10 +45,22 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/util/destructor_guard.h"
 
 namespace mongo {
 
 namespace {
+
+/**
+ * Generates a new file name on each call using a static, atomic and monotonically increasing
+ * number. See the equivalent function in document_source_group.cpp.
+ */
+std::string nextFileName() {
+    static AtomicWord<unsigned> documentSourceGraphLookUpFileCounter;
+    return "extsort-doc-graph-lookup." +
+        std::to_string(documentSourceGraphLookUpFileCounter.fetchAndAdd(1));
+}
+
 void assertIsValidCollectionState(const boost::intrusive_ptr<ExpressionContext>& expCtx) {
     if (expCtx->mongoProcessInterface->isSharded(expCtx->opCtx, expCtx->ns)) {
         const bool foreignShardedAllowed =
@@ -61,6 +74,23 @@ void assertIsValidCollectionState(const boost::intrusive_ptr<ExpressionContext>&
 
 using boost::intrusive_ptr;
 
+bool DocumentSourceGraphLookUp::canRunOnShards() const {
+    if (_canRunOnShards) {
+        return *_canRunOnShards;
+    }
+
+    _canRunOnShards = [&] {
+        if (!pExpCtx->inMongos || !internalQueryPushLookupToShards.load() ||
+            !(getTestCommandsEnabled() && internalQueryAllowShardedLookup.load())) {
+            return false;
+        }
+        const auto size = pExpCtx->mongoProcessInterface->getUnshardedCollectionSize(
+            pExpCtx->opCtx, _fromExpCtx->ns);
+        return size && *size <= internalDocumentSourceGraphLookupMaxMemoryBytes.load();
+    }();
+    return *_canRunOnShards;
+}
+
 namespace dps = ::mongo::dotted_path_support;
 
 std::unique_ptr<DocumentSourceGraphLookUp::LiteParsed> DocumentSourceGraphLookUp::LiteParsed::parse(
@@ -112,11 +142,9 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
     performSearch();
 
     std::vector<Value> results;
-    while (!_visited.empty()) {
+    while (hasVisited()) {
         // Remove elements one at a time to avoid consuming more memory.
-        auto it = _visited.begin();
-        results.push_back(Value(it->second));
-        _visited.erase(it);
+        results.push_back(Value(popVisited()));
     }
 
     MutableDocument output(*_input);
@@ -124,7 +152,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
 
     _visitedUsageBytes = 0;
 
-    invariant(_visited.empty());
+    invariant(!hasVisited());
 
     return output.freeze();
 }
@@ -135,7 +163,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
     // If the unwind is not preserving empty arrays, we might have to process multiple inputs before
     // we get one that will produce an output.
     while (true) {
-        if (_visited.empty()) {
+        if (!hasVisited()) {
             // No results are left for the current input, so we should move on to the next one and
             // perform a new search.
 
@@ -151,7 +179,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
         }
         MutableDocument unwound(*_input);
 
-        if (_visited.empty()) {
+        if (!hasVisited()) {
             if ((*_unwind)->preserveNullAndEmptyArrays()) {
                 // Since "preserveNullAndEmptyArrays" was specified, output a document even though
                 // we had no result.
@@ -165,13 +193,11 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
                 continue;
             }
         } else {
-            auto it = _visited.begin();
-            unwound.setNestedField(_as, Value(it->second));
+            unwound.setNestedField(_as, Value(popVisited()));
             if (indexPath) {
                 unwound.setNestedField(*indexPath, Value(_outputIndex));
                 ++_outputIndex;
             }
-            _visited.erase(it);
         }
 
         return unwound.freeze();
@@ -182,6 +208,61 @@ void DocumentSourceGraphLookUp::doDispose() {
     _cache.clear();
     _frontier.clear();
     _visited.clear();
+    _spilledVisitedRuns.clear();
+    _spilledVisitedRunIsOpen = false;
+    _spilledVisitedIds.clear();
+}
+
+Document DocumentSourceGraphLookUp::popVisited() {
+    if (!_visited.empty()) {
+        auto it = _visited.begin();
+        auto result = std::move(it->second);
+        _visited.erase(it);
+        return result;
+    }
+
+    invariant(!_spilledVisitedRuns.empty());
+    auto& run = _spilledVisitedRuns.front();
+    if (!_spilledVisitedRunIsOpen) {
+        run->openSource();
+        _spilledVisitedRunIsOpen = true;
+    }
+    auto result = run->next().second.getDocument();
+    if (!run->more()) {
+        run->closeSource();
+        _spilledVisitedRunIsOpen = false;
+        _spilledVisitedRuns.pop_front();
+    }
+    return result;
+}
+
+void DocumentSourceGraphLookUp::resetVisited() {
+    invariant(!hasVisited());
+    _visitedUsageBytes = 0;
+    _spilledVisitedIds.clear();
+
+    // Every run from the previous input has been returned, so the spill file can start over.
+    if (_nextSpillFileOffset != 0) {
+        boost::filesystem::remove(_spillFileName);
+        _nextSpillFileOffset = 0;
+    }
+}
+
+void DocumentSourceGraphLookUp::spillVisited() {
+    invariant(_allowDiskUse);
+    _usedDisk = true;
+
+    SortedFileWriter<Value, Value> writer(
+        SortOptions().TempDir(pExpCtx->tempDir), _spillFileName, _nextSpillFileOffset);
+    for (auto&& [id, result] : _visited) {
+        // Visited documents are returned in no particular order, so runs need not be sorted.
+        writer.addAlreadySorted(id, Value(result));
+        _visitedUsageBytes -= result.getApproximateSize();
+        _spilledVisitedIds.insert(id);
+    }
+    _spilledVisitedRuns.emplace_back(writer.done());
+    _nextSpillFileOffset = writer.getFileEndOffset();
+    _visited.clear();
 }
 
 void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
@@ -230,8 +311,9 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
                 shouldPerformAnotherQuery =
                     addToVisitedAndFrontier(*next, depth) || shouldPerformAnotherQuery;
                 addToCache(std::move(*next), queried);
+                checkMemoryUsage();
             }
-            checkMemoryUsage();
+            _usedDisk = _usedDisk || pipeline->usedDisk();
         }
 
         ++depth;
@@ -245,7 +327,8 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 bool DocumentSourceGraphLookUp::addToVisitedAndFrontier(Document result, long long depth) {
     auto id = result.getField("_id");
 
-    if (_visited.find(id) != _visited.end()) {
+    if (_visited.find(id) != _visited.end() ||
+        _spilledVisitedIds.find(id) != _spilledVisitedIds.end()) {
         // We've already seen this object, don't repeat any work.
         return false;
     }
@@ -344,6 +427,7 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
 void DocumentSourceGraphLookUp::performSearch() {
     // Make sure _input is set before calling performSearch().
     invariant(_input);
+    resetVisited();
 
     Value startingValue = _startWith->evaluate(*_input, &pExpCtx->variables);
 
@@ -392,7 +476,10 @@ Pipeline::SourceContainer::iterator DocumentSourceGraphLookUp::doOptimizeAt(
 }
 
 void DocumentSourceGraphLookUp::checkMemoryUsage() {
-    // TODO SERVER-23980: Implement spilling to disk if allowDiskUse is specified.
+    if (_allowDiskUse && !_visited.empty() &&
+        (_visitedUsageBytes + _frontierUsageBytes) >= _maxMemoryUsageBytes) {
+        spillVisited();
+    }
     uassert(40099,
             "$graphLookup reached maximum memory consumption",
             (_visitedUsageBytes + _frontierUsageBytes) < _maxMemoryUsageBytes);
@@ -438,6 +525,14 @@ void DocumentSourceGraphLookUp::serializeToArray(
     }
 }
 
+DocumentSourceGraphLookUp::~DocumentSourceGraphLookUp() {
+    if (_nextSpillFileOffset != 0) {
+        // Runs must be released before their file can be removed on some systems.
+        _spilledVisitedRuns.clear();
+        DESTRUCTOR_GUARD(boost::filesystem::remove(_spillFileName));
+    }
+}
+
 void DocumentSourceGraphLookUp::detachFromOperationContext() {
     _fromExpCtx->opCtx = nullptr;
 }
@@ -466,10 +561,17 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
       _additionalFilter(additionalFilter),
       _depthField(depthField),
       _maxDepth(maxDepth),
+      _maxMemoryUsageBytes(internalDocumentSourceGraphLookupMaxMemoryBytes.load()),
       _frontier(pExpCtx->getValueComparator().makeUnorderedValueSet()),
       _visited(ValueComparator::kInstance.makeUnorderedValueMap<Document>()),
+      _allowDiskUse(pExpCtx->allowDiskUse && !pExpCtx->inMongos),
+      _spilledVisitedIds(ValueComparator::kInstance.makeUnorderedValueSet()),
       _cache(pExpCtx->getValueComparator()),
       _unwind(unwindSrc) {
+    if (_allowDiskUse) {
+        _spillFileName = pExpCtx->tempDir + "/" + nextFileName();
+    }
+
     const auto& resolvedNamespace = pExpCtx->getResolvedNamespace(_from);
     _fromExpCtx = pExpCtx->copyWith(resolvedNamespace.ns);
 
@@ -613,3 +715,6 @@ void DocumentSourceGraphLookUp::addInvolvedCollections(
     }
 }
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+// Explicit instantiation unneeded since we aren't exposing Sorter outside of this file.
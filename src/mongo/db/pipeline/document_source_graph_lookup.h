@@ -29,11 +29,14 @@
 
 #pragma once
 
+#include <deque>
+
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
+#include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
 
@@ -60,6 +63,8 @@ public:
         }
     };
 
+    ~DocumentSourceGraphLookUp();
+
     const char* getSourceName() const final;
 
     const FieldPath& getConnectFromField() const {
@@ -94,8 +99,9 @@ public:
     StageConstraints constraints(Pipeline::SplitState pipeState) const final {
         StageConstraints constraints(StreamType::kStreaming,
                                      PositionRequirement::kNone,
-                                     HostTypeRequirement::kPrimaryShard,
-                                     DiskUseRequirement::kNoDiskUse,
+                                     canRunOnShards() ? HostTypeRequirement::kNone
+                                                      : HostTypeRequirement::kPrimaryShard,
+                                     DiskUseRequirement::kWritesTmpData,
                                      FacetRequirement::kAllowed,
                                      TransactionRequirement::kAllowed,
                                      LookupRequirement::kAllowed,
@@ -106,6 +112,9 @@ public:
     }
 
     boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
+        if (canRunOnShards()) {
+            return boost::none;
+        }
         // {shardsStage, mergingStage, sortPattern}
         return DistributedPlanLogic{nullptr, this, boost::none};
     }
@@ -117,6 +126,10 @@ public:
 
     void addInvolvedCollections(stdx::unordered_set<NamespaceString>* collectionNames) const final;
 
+    bool usedDisk() final {
+        return _usedDisk;
+    }
+
     void detachFromOperationContext() final;
 
     void reattachToOperationContext(OperationContext* opCtx) final;
@@ -201,10 +214,37 @@ private:
 
     /**
      * Assert that '_visited' and '_frontier' have not exceeded the maximum meory usage, and then
-     * evict from '_cache' until this source is using less than '_maxMemoryUsageBytes'.
+     * evict from '_cache' until this source is using less than '_maxMemoryUsageBytes'. If disk use
+     * is allowed, '_visited' is spilled rather than failing the search.
      */
     void checkMemoryUsage();
 
+    /**
+     * Writes the documents in '_visited' to a new run in the spill file, keeping only their '_id'
+     * values in memory in '_spilledVisitedIds'.
+     */
+    void spillVisited();
+
+    /**
+     * Returns whether any visited documents remain to be returned for the current input, in
+     * memory or spilled.
+     */
+    bool hasVisited() const {
+        return !_visited.empty() || !_spilledVisitedRuns.empty();
+    }
+
+    /**
+     * Removes and returns one of the remaining visited documents. May only be called if
+     * hasVisited() is true.
+     */
+    Document popVisited();
+
+    /**
+     * Clears the visited state left from the previous input, removing the spill file if it is no
+     * longer needed.
+     */
+    void resetVisited();
+
     /**
      * Process 'result', adding it to '_visited' with the given 'depth', and updating '_frontier'
      * with the object's 'connectTo' values.
@@ -213,6 +253,16 @@ private:
      */
     bool addToVisitedAndFrontier(Document result, long long depth);
 
+    /**
+     * Returns true if, with internalQueryPushLookupToShards set on mongos, this stage should run on
+     * each shard holding the local collection rather than on the merger, because the foreign
+     * collection is unsharded and within the memory a traversal may use, so that each shard's
+     * queries against it stay cheap. The answer is computed once.
+     */
+    bool canRunOnShards() const;
+
+    mutable boost::optional<bool> _canRunOnShards;
+
     // $graphLookup options.
     NamespaceString _from;
     FieldPath _as;
@@ -230,7 +280,7 @@ private:
     // The aggregation pipeline to perform against the '_from' namespace.
     std::vector<BSONObj> _fromPipeline;
 
-    size_t _maxMemoryUsageBytes = 100 * 1024 * 1024;
+    size_t _maxMemoryUsageBytes;
 
     // Track memory usage to ensure we don't exceed '_maxMemoryUsageBytes'.
     size_t _visitedUsageBytes = 0;
@@ -244,6 +294,19 @@ private:
     // using the simple collation.
     ValueUnorderedMap<Document> _visited;
 
+    // Whether '_visited' may be spilled to disk once the search exceeds '_maxMemoryUsageBytes'.
+    const bool _allowDiskUse;
+    bool _usedDisk = false;
+
+    // Runs of visited documents spilled for the current input, which are returned after those in
+    // '_visited', and the '_id' values of those documents, which are used for de-duplication. The
+    // runs are appended to the file at '_spillFileName'.
+    std::string _spillFileName;
+    std::streampos _nextSpillFileOffset = 0;
+    std::deque<std::shared_ptr<Sorter<Value, Value>::Iterator>> _spilledVisitedRuns;
+    bool _spilledVisitedRunIsOpen = false;
+    ValueUnorderedSet _spilledVisitedIds;
+
     // Caches query results to avoid repeating any work. This structure is maintained across calls
     // to getNext().
     LookupSetCache _cache;
@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <deque>
+#include <numeric>
 
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/document_value_test_util.h"
@@ -38,8 +39,11 @@
 #include "mongo/db/pipeline/document_source_graph_lookup.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/process_interface/stub_mongo_process_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -237,6 +241,74 @@ TEST_F(DocumentSourceGraphLookUpTest,
     }
 }
 
+/**
+ * Builds a $graphLookup over a chain of 'numNodes' padded documents, starting from its first node,
+ * with a memory limit that only fits a few of them.
+ */
+boost::intrusive_ptr<DocumentSourceGraphLookUp> makeGraphLookupOverPaddedChain(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, int numNodes) {
+    const std::string padding(1000, 'x');
+    std::deque<DocumentSource::GetNextResult> fromContents;
+    for (int i = 0; i < numNodes; ++i) {
+        fromContents.push_back(
+            Document{{"_id", i}, {"to", i}, {"from", i + 1}, {"padding", padding}});
+    }
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+    expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(std::move(fromContents));
+    return DocumentSourceGraphLookUp::create(expCtx,
+                                             fromNs,
+                                             "results",
+                                             "from",
+                                             "to",
+                                             ExpressionFieldPath::create(expCtx, "_id"),
+                                             boost::none,
+                                             boost::none,
+                                             boost::none,
+                                             boost::none);
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldSpillVisitedDocumentsWhenDiskUseIsAllowed) {
+    const auto oldMaxMemoryBytes = internalDocumentSourceGraphLookupMaxMemoryBytes.load();
+    internalDocumentSourceGraphLookupMaxMemoryBytes.store(3000);
+    ON_BLOCK_EXIT(
+        [&] { internalDocumentSourceGraphLookupMaxMemoryBytes.store(oldMaxMemoryBytes); });
+
+    auto expCtx = getExpCtx();
+    unittest::TempDir tempDir("DocumentSourceGraphLookUpTest");
+    expCtx->tempDir = tempDir.path();
+    const int numNodes = 10;
+
+    // Without allowDiskUse, the search fails once the visited documents exceed the limit.
+    auto inputMock = DocumentSourceMock::createForTest(Document{{"_id", 0}});
+    auto graphLookupStage = makeGraphLookupOverPaddedChain(expCtx, numNodes);
+    graphLookupStage->setSource(inputMock.get());
+    ASSERT_THROWS_CODE(graphLookupStage->getNext(), AssertionException, 40099);
+
+    // With allowDiskUse, they are spilled and every node is returned exactly once.
+    expCtx->allowDiskUse = true;
+    inputMock = DocumentSourceMock::createForTest({Document{{"_id", 0}}, Document{{"_id", 5}}});
+    graphLookupStage = makeGraphLookupOverPaddedChain(expCtx, numNodes);
+    graphLookupStage->setSource(inputMock.get());
+
+    for (int start : {0, 5}) {
+        auto next = graphLookupStage->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        std::vector<int> ids;
+        for (auto&& result : next.releaseDocument()["results"].getArray()) {
+            ids.push_back(result["_id"].getInt());
+        }
+        std::sort(ids.begin(), ids.end());
+        std::vector<int> expectedIds(numNodes - start);
+        std::iota(expectedIds.begin(), expectedIds.end(), start);
+        ASSERT(ids == expectedIds);
+    }
+    ASSERT_TRUE(graphLookupStage->getNext().isEOF());
+    ASSERT_TRUE(graphLookupStage->usedDisk());
+}
+
 TEST_F(DocumentSourceGraphLookUpTest, ShouldPropagatePauses) {
     auto expCtx = getExpCtx();
 
@@ -132,6 +132,12 @@ const char* DocumentSourceGroup::getSourceName() const {
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::doGetNext() {
+    if (_streaming) {
+        if (auto result = getNextStreaming()) {
+            return std::move(*result);
+        }
+    }
+
     if (!_initialized) {
         const auto initializationResult = initialize();
         if (initializationResult.isPaused()) {
@@ -144,10 +150,13 @@ DocumentSource::GetNextResult DocumentSourceGroup::doGetNext() {
         accum->reset();  // Prep accumulators for a new group.
     }
 
-    if (_spilled) {
-        return getNextSpilled();
-    } else {
-        return getNextStandard();
+    while (true) {
+        auto result = _spilled ? getNextSpilled() : getNextStandard();
+        // When $group has spilled hash partitions, the groups which stayed in memory are returned
+        // first, followed by each spilled partition in turn.
+        if (!result.isEOF() || !loadNextSpilledPartition()) {
+            return result;
+        }
     }
 }
 
@@ -172,21 +181,14 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
     while (pExpCtx->getValueComparator().evaluate(_currentId == _firstPartOfNextGroup.first)) {
         // Inside of this loop, _firstPartOfNextGroup is the current data being processed.
         // At loop exit, it is the first value to be processed in the next group.
-        switch (numAccumulators) {  // mirrors switch in spill()
-            case 1:                 // Single accumulators serialize as a single Value.
-                _currentAccumulators[0]->process(_firstPartOfNextGroup.second, true);
-            case 0:  // No accumulators so no Values.
-                break;
-            default: {  // Multiple accumulators serialize as an array of Values.
-                const vector<Value>& accumulatorStates = _firstPartOfNextGroup.second.getArray();
-                for (size_t i = 0; i < numAccumulators; i++) {
-                    _currentAccumulators[i]->process(accumulatorStates[i], true);
-                }
-            }
-        }
+        mergeSpilledAccumulatorState(_firstPartOfNextGroup.second, &_currentAccumulators);
 
         if (!_sorterIterator->more()) {
-            dispose();
+            if (_pendingSpilledPartitions.empty()) {
+                dispose();
+            } else {
+                _sorterIterator.reset();
+            }
             break;
         }
 
@@ -196,14 +198,58 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
     return makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge);
 }
 
+boost::optional<DocumentSource::GetNextResult> DocumentSourceGroup::getNextStreaming() {
+    GetNextResult input = pSource->getNext();
+    for (; input.isAdvanced(); input = pSource->getNext()) {
+        auto rootDocument = input.releaseDocument();
+        Value id = computeId(rootDocument);
+        if (!isStreamableId(id)) {
+            // Groups returned so far cannot recur, but the current group and the rest of the input
+            // have to go through the hash table.
+            _streaming = false;
+            _unprocessedInput = std::move(rootDocument);
+            return boost::none;
+        }
+
+        boost::optional<Document> finishedGroup;
+        if (!_groups->empty() &&
+            !pExpCtx->getValueComparator().evaluate(_groups->begin()->first == id)) {
+            auto& [currentId, currentGroup] = *_groups->begin();
+            finishedGroup = makeDocument(currentId, currentGroup, pExpCtx->needsMerge);
+            _groups->clear();
+            _memoryUsageBytes = 0;
+        }
+
+        accumulateDocument(rootDocument, id);
+
+        if (finishedGroup) {
+            return GetNextResult(std::move(*finishedGroup));
+        }
+    }
+
+    if (input.isEOF()) {
+        // Any further calls see an exhausted hash table.
+        _streaming = false;
+        _initialized = true;
+        if (!_groups->empty()) {
+            auto& [currentId, currentGroup] = *_groups->begin();
+            Document out = makeDocument(currentId, currentGroup, pExpCtx->needsMerge);
+            dispose();
+            return GetNextResult(std::move(out));
+        }
+        dispose();
+    }
+    return input;
+}
+
 DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     // Not spilled, and not streaming.
-    if (_groups->empty())
+    if (groupsIterator == _groups->end())
         return GetNextResult::makeEOF();
 
     Document out = makeDocument(groupsIterator->first, groupsIterator->second, pExpCtx->needsMerge);
 
-    if (++groupsIterator == _groups->end())
+    if (++groupsIterator == _groups->end() && _pendingSpilledPartitions.empty())
         dispose();
 
     return std::move(out);
@@ -211,8 +257,10 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
 
 void DocumentSourceGroup::doDispose() {
     // Free our resources.
-    _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+    _groups = pExpCtx->getValueComparator().makeFlatHashValueMap<Accumulators>();
     _sorterIterator.reset();
+    _partitionRuns.clear();
+    _pendingSpilledPartitions.clear();
 
     // Make us look done.
     groupsIterator = _groups->end();
@@ -345,12 +393,16 @@ DocumentSourceGroup::DocumentSourceGroup(const intrusive_ptr<ExpressionContext>&
       _maxMemoryUsageBytes(maxMemoryUsageBytes ? *maxMemoryUsageBytes
                                                : internalDocumentSourceGroupMaxMemoryBytes.load()),
       _initialized(false),
-      _groups(pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>()),
+      _groups(pExpCtx->getValueComparator().makeFlatHashValueMap<Accumulators>()),
       _spilled(false),
-      _allowDiskUse(pExpCtx->allowDiskUse && !pExpCtx->inMongos) {
+      _allowDiskUse(pExpCtx->allowDiskUse && !pExpCtx->inMongos),
+      _numSpillPartitions(internalDocumentSourceGroupSpillPartitions.load()) {
     if (!pExpCtx->inMongos && (pExpCtx->allowDiskUse || kDebugBuild)) {
         // We spill to disk in debug mode, regardless of allowDiskUse, to stress the system.
         _fileName = pExpCtx->tempDir + "/" + nextFileName();
+        if (_numSpillPartitions > 0) {
+            _partitionFileName = pExpCtx->tempDir + "/" + nextFileName();
+        }
     }
 }
 
@@ -358,6 +410,11 @@ DocumentSourceGroup::~DocumentSourceGroup() {
     if (_ownsFileDeletion) {
         DESTRUCTOR_GUARD(boost::filesystem::remove(_fileName));
     }
+    if (!_partitionFileName.empty()) {
+        // Runs must be released before their file can be removed on some systems.
+        _partitionRuns.clear();
+        DESTRUCTOR_GUARD(boost::filesystem::remove(_partitionFileName));
+    }
 }
 
 void DocumentSourceGroup::addAccumulator(AccumulationStatement accumulationStatement) {
@@ -477,73 +534,44 @@ private:
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
-    const size_t numAccumulators = _accumulatedFields.size();
-
     // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
-    GetNextResult input = pSource->getNext();
+    GetNextResult input =
+        _unprocessedInput ? GetNextResult(std::move(*_unprocessedInput)) : pSource->getNext();
+    _unprocessedInput = boost::none;
     for (; input.isAdvanced(); input = pSource->getNext()) {
         if (_memoryUsageBytes > _maxMemoryUsageBytes) {
             uassert(16945,
                     "Exceeded memory limit for $group, but didn't allow external sort."
                     " Pass allowDiskUse:true to opt in.",
                     _allowDiskUse);
-            _sortedFiles.push_back(spill());
-            _memoryUsageBytes = 0;
+            if (_numSpillPartitions > 0) {
+                // Leave some headroom so that we do not have to spill again after only a few more
+                // documents.
+                spillPartitions(_maxMemoryUsageBytes / 2);
+            } else {
+                _sortedFiles.push_back(spill());
+                _memoryUsageBytes = 0;
+            }
         }
 
         // We release the result document here so that it does not outlive the end of this loop
         // iteration. Not releasing could lead to an array copy when this group follows an unwind.
         auto rootDocument = input.releaseDocument();
         Value id = computeId(rootDocument);
-
-        // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
-        // looking it up in '_groups' multiple times.
-        const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<AccumulatorState>>& group = (*_groups)[id];
-        const bool inserted = _groups->size() != oldSize;
-
-        if (inserted) {
-            _memoryUsageBytes += id.getApproximateSize();
-
-            // Initialize and add the accumulators
-            Value expandedId = expandId(id);
-            Document idDoc =
-                expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
-            group.reserve(numAccumulators);
-            for (auto&& accumulatedField : _accumulatedFields) {
-                auto accum = accumulatedField.makeAccumulator();
-                Value initializerValue =
-                    accumulatedField.expr.initializer->evaluate(idDoc, &pExpCtx->variables);
-                accum->startNewGroup(initializerValue);
-                group.push_back(accum);
-            }
-        } else {
-            for (auto&& groupObj : group) {
-                // subtract old mem usage. New usage added back after processing.
-                _memoryUsageBytes -= groupObj->memUsageForSorter();
-            }
-        }
-
-        /* tickle all the accumulators for the group we found */
-        dassert(numAccumulators == group.size());
-
-        for (size_t i = 0; i < numAccumulators; i++) {
-            group[i]->process(
-                _accumulatedFields[i].expr.argument->evaluate(rootDocument, &pExpCtx->variables),
-                _doingMerge);
-
-            _memoryUsageBytes += group[i]->memUsageForSorter();
-        }
+        const bool inserted = accumulateDocument(rootDocument, id);
 
         if (kDebugBuild && !storageGlobalParams.readOnly) {
             // In debug mode, spill every time we have a duplicate id to stress merge logic.
-            if (!inserted &&                 // is a dup
-                !pExpCtx->inMongos &&        // can't spill to disk in mongos
-                !_allowDiskUse &&            // don't change behavior when testing external sort
-                _sortedFiles.size() < 20) {  // don't open too many FDs
-
-                _sortedFiles.push_back(spill());
+            if (!inserted &&           // is a dup
+                !pExpCtx->inMongos &&  // can't spill to disk in mongos
+                !_allowDiskUse) {      // don't change behavior when testing external sort
+                if (_numSpillPartitions > 0) {
+                    if (_numPartitionSpills < 20) {  // don't write too many runs
+                        spillPartitions(_maxMemoryUsageBytes, true);
+                    }
+                } else if (_sortedFiles.size() < 20) {  // don't open too many FDs
+                    _sortedFiles.push_back(spill());
+                }
             }
         }
     }
@@ -564,23 +592,20 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
                 }
 
                 // We won't be using groups again so free its memory.
-                _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
-
-                _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
-                    _sortedFiles,
-                    _fileName,
-                    SortOptions(),
-                    SorterComparator(pExpCtx->getValueComparator())));
-                _ownsFileDeletion = false;
-
-                // prepare current to accumulate data
-                _currentAccumulators.reserve(numAccumulators);
-                for (auto&& accumulatedField : _accumulatedFields) {
-                    _currentAccumulators.push_back(accumulatedField.makeAccumulator());
+                _groups = pExpCtx->getValueComparator().makeFlatHashValueMap<Accumulators>();
+
+                startMergingSortedRuns();
+            } else if (!_partitionRuns.empty()) {
+                // Groups of spilled partitions which accumulated since the last spill must join
+                // the rest of their partition on disk. Whatever remains belongs to partitions that
+                // never spilled and can be returned straight from memory.
+                spillPartitions(_maxMemoryUsageBytes);
+                for (size_t partition = 0; partition < _partitionRuns.size(); ++partition) {
+                    if (!_partitionRuns[partition].empty()) {
+                        _pendingSpilledPartitions.push_back(partition);
+                    }
                 }
-
-                verify(_sorterIterator->more());  // we put data in, we should get something out.
-                _firstPartOfNextGroup = _sorterIterator->next();
+                groupsIterator = _groups->begin();
             } else {
                 // start the group iterator
                 groupsIterator = _groups->begin();
@@ -595,10 +620,300 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     MONGO_UNREACHABLE;
 }
 
+bool DocumentSourceGroup::accumulateDocument(const Document& root, const Value& id) {
+    const size_t numAccumulators = _accumulatedFields.size();
+
+    // Look for the _id value in the map. If it's not there, add a new entry with a blank
+    // accumulator.
+    auto [groupPtr, inserted] = findOrCreateGroup(id);
+    Accumulators& group = *groupPtr;
+
+    if (!inserted) {
+        for (auto&& groupObj : group) {
+            // subtract old mem usage. New usage added back after processing.
+            _memoryUsageBytes -= groupObj->memUsageForSorter();
+        }
+    }
+
+    /* tickle all the accumulators for the group we found */
+    dassert(numAccumulators == group.size());
+
+    for (size_t i = 0; i < numAccumulators; i++) {
+        group[i]->process(_accumulatedFields[i].expr.argument->evaluate(root, &pExpCtx->variables),
+                          _doingMerge);
+
+        _memoryUsageBytes += group[i]->memUsageForSorter();
+    }
+    return inserted;
+}
+
+void DocumentSourceGroup::setInputSortPattern(const SortPattern& inputSortPattern) {
+    _streaming = false;
+    if (!internalDocumentSourceGroupEnableStreaming.load() || _doingMerge || _initialized) {
+        return;
+    }
+
+    std::set<std::string> groupPaths;
+    for (auto&& idExpression : _idExpressions) {
+        auto fieldPathExpr = dynamic_cast<ExpressionFieldPath*>(idExpression.get());
+        if (!fieldPathExpr || !fieldPathExpr->isRootFieldPath() ||
+            fieldPathExpr->getFieldPath().getPathLength() == 1) {
+            return;
+        }
+        groupPaths.insert(fieldPathExpr->getFieldPath().tail().fullPath());
+    }
+
+    // The group keys must be exactly the leading fields of the sort, in any order.
+    if (groupPaths.size() > inputSortPattern.size()) {
+        return;
+    }
+    std::set<std::string> sortPaths;
+    for (size_t i = 0; i < groupPaths.size(); ++i) {
+        if (!inputSortPattern[i].fieldPath) {
+            return;
+        }
+        sortPaths.insert(inputSortPattern[i].fieldPath->fullPath());
+    }
+    _streaming = (sortPaths == groupPaths);
+}
+
+bool DocumentSourceGroup::isStreamableId(const Value& id) const {
+    // $sort orders an array by its smallest or largest element, and treats a missing field as
+    // null. computeId() already turns a missing single key into null.
+    if (_idExpressions.size() == 1) {
+        return id.getType() != BSONType::Array;
+    }
+    return std::none_of(id.getArray().begin(), id.getArray().end(), [](const Value& key) {
+        return key.missing() || key.getType() == BSONType::Array;
+    });
+}
+
 bool DocumentSourceGroup::usedDisk() {
     return _usedDisk;
 }
 
+void DocumentSourceGroup::startMergingSortedRuns() {
+    _sorterIterator.reset(
+        Sorter<Value, Value>::Iterator::merge(_sortedFiles,
+                                              _fileName,
+                                              SortOptions(),
+                                              SorterComparator(pExpCtx->getValueComparator())));
+    _ownsFileDeletion = false;
+    _sortedFiles.clear();
+
+    // prepare current to accumulate data
+    if (_currentAccumulators.empty()) {
+        _currentAccumulators.reserve(_accumulatedFields.size());
+        for (auto&& accumulatedField : _accumulatedFields) {
+            _currentAccumulators.push_back(accumulatedField.makeAccumulator());
+        }
+    }
+
+    verify(_sorterIterator->more());  // we put data in, we should get something out.
+    _firstPartOfNextGroup = _sorterIterator->next();
+}
+
+std::pair<DocumentSourceGroup::Accumulators*, bool> DocumentSourceGroup::findOrCreateGroup(
+    const Value& id) {
+    // This is done in a somewhat odd way in order to avoid hashing 'id' and looking it up in
+    // '_groups' multiple times.
+    const size_t oldSize = _groups->size();
+    Accumulators& group = (*_groups)[id];
+    const bool inserted = _groups->size() != oldSize;
+
+    if (inserted) {
+        _memoryUsageBytes += id.getApproximateSize();
+
+        // Initialize and add the accumulators
+        Value expandedId = expandId(id);
+        Document idDoc =
+            expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
+        group.reserve(_accumulatedFields.size());
+        for (auto&& accumulatedField : _accumulatedFields) {
+            auto accum = accumulatedField.makeAccumulator();
+            Value initializerValue =
+                accumulatedField.expr.initializer->evaluate(idDoc, &pExpCtx->variables);
+            accum->startNewGroup(initializerValue);
+            group.push_back(accum);
+        }
+    }
+    return {&group, inserted};
+}
+
+Value DocumentSourceGroup::getSpillableAccumulatorState(const Accumulators& accums) const {
+    switch (accums.size()) {  // mirrors switch in mergeSpilledAccumulatorState()
+        case 0:               // no values, essentially a distinct
+            return Value();
+        case 1:  // just one value, use optimized serialization as single Value
+            return accums[0]->getValue(/*toBeMerged=*/true);
+        default: {  // multiple values, serialize as array-typed Value
+            vector<Value> states;
+            states.reserve(accums.size());
+            for (auto&& accum : accums) {
+                states.push_back(accum->getValue(/*toBeMerged=*/true));
+            }
+            return Value(std::move(states));
+        }
+    }
+}
+
+void DocumentSourceGroup::mergeSpilledAccumulatorState(const Value& state,
+                                                       Accumulators* accums) const {
+    switch (accums->size()) {  // mirrors switch in getSpillableAccumulatorState()
+        case 0:                // No accumulators so no Values.
+            break;
+        case 1:  // Single accumulators serialize as a single Value.
+            (*accums)[0]->process(state, true);
+            break;
+        default: {  // Multiple accumulators serialize as an array of Values.
+            const vector<Value>& accumulatorStates = state.getArray();
+            for (size_t i = 0; i < accums->size(); i++) {
+                (*accums)[i]->process(accumulatorStates[i], true);
+            }
+        }
+    }
+}
+
+size_t DocumentSourceGroup::partitionForId(const Value& id) const {
+    // '_groups' buckets on the low bits of the same hash, so mix it before picking a partition to
+    // keep partitions and buckets independent.
+    const uint64_t hash = pExpCtx->getValueComparator().hash(id);
+    return ((hash * 0x9E3779B97F4A7C15ULL) >> 32) % _numSpillPartitions;
+}
+
+void DocumentSourceGroup::spillPartitions(size_t targetMemoryUsageBytes,
+                                          bool spillAtLeastOnePartition) {
+    if (_partitionRuns.empty()) {
+        _partitionRuns.resize(_numSpillPartitions);
+    }
+
+    vector<vector<GroupsMap::iterator>> partitionGroups(_numSpillPartitions);
+    vector<size_t> partitionBytes(_numSpillPartitions, 0);
+    size_t totalBytes = 0;
+    for (auto it = _groups->begin(); it != _groups->end(); ++it) {
+        const size_t partition = partitionForId(it->first);
+        size_t groupBytes = it->first.getApproximateSize();
+        for (auto&& accum : it->second) {
+            groupBytes += accum->memUsageForSorter();
+        }
+        partitionGroups[partition].push_back(it);
+        partitionBytes[partition] += groupBytes;
+        totalBytes += groupBytes;
+    }
+
+    // Partitions that have spilled before are re-aggregated from disk regardless, so keeping their
+    // groups in memory would only take room from partitions which can still avoid the disk.
+    vector<bool> toSpill(_numSpillPartitions, false);
+    for (size_t partition = 0; partition < _numSpillPartitions; ++partition) {
+        if (!_partitionRuns[partition].empty() && !partitionGroups[partition].empty()) {
+            toSpill[partition] = true;
+            totalBytes -= partitionBytes[partition];
+        }
+    }
+
+    // Then spill the largest of the remaining partitions until we are under the target.
+    vector<size_t> bySize;
+    for (size_t partition = 0; partition < _numSpillPartitions; ++partition) {
+        if (!toSpill[partition] && !partitionGroups[partition].empty()) {
+            bySize.push_back(partition);
+        }
+    }
+    std::sort(bySize.begin(), bySize.end(), [&](size_t lhs, size_t rhs) {
+        return partitionBytes[lhs] > partitionBytes[rhs];
+    });
+    for (size_t i = 0; i < bySize.size(); ++i) {
+        const bool forced = spillAtLeastOnePartition && i == 0;
+        if (!forced && totalBytes <= targetMemoryUsageBytes) {
+            break;
+        }
+        toSpill[bySize[i]] = true;
+        totalBytes -= partitionBytes[bySize[i]];
+    }
+
+    for (size_t partition = 0; partition < _numSpillPartitions; ++partition) {
+        if (!toSpill[partition]) {
+            continue;
+        }
+
+        _usedDisk = true;
+        SortedFileWriter<Value, Value> writer(SortOptions().TempDir(pExpCtx->tempDir),
+                                              _partitionFileName,
+                                              _nextPartitionFileOffset);
+        // Runs of a partition are re-aggregated through a hash table, so they need not be sorted.
+        for (auto&& it : partitionGroups[partition]) {
+            writer.addAlreadySorted(it->first, getSpillableAccumulatorState(it->second));
+        }
+        _partitionRuns[partition].emplace_back(writer.done());
+        _nextPartitionFileOffset = writer.getFileEndOffset();
+        ++_numPartitionSpills;
+
+        for (auto&& it : partitionGroups[partition]) {
+            _groups->erase(it);
+        }
+    }
+
+    _memoryUsageBytes = totalBytes;
+}
+
+bool DocumentSourceGroup::loadNextSpilledPartition() {
+    if (_pendingSpilledPartitions.empty()) {
+        return false;
+    }
+
+    const size_t partition = _pendingSpilledPartitions.front();
+    _pendingSpilledPartitions.pop_front();
+    auto runs = std::move(_partitionRuns[partition]);
+    _partitionRuns[partition].clear();
+
+    _groups = pExpCtx->getValueComparator().makeFlatHashValueMap<Accumulators>();
+    _memoryUsageBytes = 0;
+    _spilled = false;
+    invariant(_sortedFiles.empty());
+
+    for (auto&& run : runs) {
+        run->openSource();
+        while (run->more()) {
+            if (_memoryUsageBytes > _maxMemoryUsageBytes) {
+                // This partition does not fit in memory by itself. Fall back to sorted runs, which
+                // are merged once the whole partition has been read. A previous merge removes its
+                // file when it finishes, so each fallback needs a file of its own.
+                if (!_ownsFileDeletion) {
+                    _fileName = pExpCtx->tempDir + "/" + nextFileName();
+                    _nextSortedFileWriterOffset = 0;
+                    _ownsFileDeletion = true;
+                }
+                _sortedFiles.push_back(spill());
+                _memoryUsageBytes = 0;
+            }
+
+            auto spilledGroup = run->next();
+            auto [group, inserted] = findOrCreateGroup(spilledGroup.first);
+            if (!inserted) {
+                for (auto&& accum : *group) {
+                    _memoryUsageBytes -= accum->memUsageForSorter();
+                }
+            }
+            mergeSpilledAccumulatorState(spilledGroup.second, group);
+            for (auto&& accum : *group) {
+                _memoryUsageBytes += accum->memUsageForSorter();
+            }
+        }
+        run->closeSource();
+    }
+
+    if (!_sortedFiles.empty()) {
+        _spilled = true;
+        if (!_groups->empty()) {
+            _sortedFiles.push_back(spill());
+        }
+        _groups = pExpCtx->getValueComparator().makeFlatHashValueMap<Accumulators>();
+        startMergingSortedRuns();
+    } else {
+        groupsIterator = _groups->begin();
+    }
+    return true;
+}
+
 shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     _usedDisk = true;
     vector<const GroupsMap::value_type*> ptrs;  // using pointers to speed sorting
@@ -611,29 +926,8 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
 
     SortedFileWriter<Value, Value> writer(
         SortOptions().TempDir(pExpCtx->tempDir), _fileName, _nextSortedFileWriterOffset);
-    switch (_accumulatedFields.size()) {  // same as ptrs[i]->second.size() for all i.
-        case 0:                           // no values, essentially a distinct
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first, Value());
-            }
-            break;
-
-        case 1:  // just one value, use optimized serialization as single Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first,
-                                        ptrs[i]->second[0]->getValue(/*toBeMerged=*/true));
-            }
-            break;
-
-        default:  // multiple values, serialize as array-typed Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                vector<Value> accums;
-                for (size_t j = 0; j < ptrs[i]->second.size(); j++) {
-                    accums.push_back(ptrs[i]->second[j]->getValue(/*toBeMerged=*/true));
-                }
-                writer.addAlreadySorted(ptrs[i]->first, Value(std::move(accums)));
-            }
-            break;
+    for (size_t i = 0; i < ptrs.size(); i++) {
+        writer.addAlreadySorted(ptrs[i]->first, getSpillableAccumulatorState(ptrs[i]->second));
     }
 
     _groups->clear();
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
 #include <utility>
 
@@ -36,6 +37,7 @@
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/transformer_interface.h"
+#include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
@@ -89,7 +91,7 @@ private:
 class DocumentSourceGroup final : public DocumentSource {
 public:
     using Accumulators = std::vector<boost::intrusive_ptr<AccumulatorState>>;
-    using GroupsMap = ValueUnorderedMap<Accumulators>;
+    using GroupsMap = ValueFlatHashMap<Accumulators>;
 
     static constexpr StringData kStageName = "$group"_sd;
 
@@ -156,6 +158,21 @@ public:
         _doingMerge = doingMerge;
     }
 
+    /**
+     * Tells this $group that its input arrives sorted by 'inputSortPattern'. If every group key is
+     * a plain field path and together they form a prefix of the sort, documents in the same group
+     * are adjacent, and each group is returned as soon as the group key changes rather than after
+     * building a hash table of all groups.
+     */
+    void setInputSortPattern(const SortPattern& inputSortPattern);
+
+    /**
+     * Returns true if this $group returns groups as soon as they are complete.
+     */
+    bool isStreaming() const {
+        return _streaming;
+    }
+
     /**
      * Returns true if this $group stage used disk during execution and false otherwise.
      */
@@ -195,6 +212,25 @@ private:
     GetNextResult getNextSpilled();
     GetNextResult getNextStandard();
 
+    /**
+     * Used instead of initialize() while '_streaming' is true. Returns boost::none after switching
+     * back to a hash table because the input order cannot be relied on for the current key.
+     */
+    boost::optional<GetNextResult> getNextStreaming();
+
+    /**
+     * Returns false if documents with the group key 'id' may be interleaved with documents of
+     * other groups in input sorted on the group keys. This is the case for keys which $sort
+     * orders by something other than the key itself, such as arrays.
+     */
+    bool isStreamableId(const Value& id) const;
+
+    /**
+     * Adds 'root', whose group key is 'id', to its group in '_groups' and returns whether the
+     * group was created.
+     */
+    bool accumulateDocument(const Document& root, const Value& id);
+
     /**
      * Before returning anything, this source must prepare itself. In a streaming $group,
      * initialize() requests the first document from the previous source, and uses it to prepare the
@@ -214,6 +250,49 @@ private:
      */
     std::shared_ptr<Sorter<Value, Value>::Iterator> spill();
 
+    /**
+     * Hash partitioned alternative to spill(), used when '_numSpillPartitions' is non-zero. Writes
+     * every in-memory group of an already spilled partition to a new run for that partition, then
+     * spills the largest remaining partitions until memory usage is at most
+     * 'targetMemoryUsageBytes'. Partitions which have not spilled stay in memory, and are returned
+     * without ever touching disk. If 'spillAtLeastOnePartition' is true, the largest partition is
+     * spilled even when the target has already been met.
+     */
+    void spillPartitions(size_t targetMemoryUsageBytes, bool spillAtLeastOnePartition = false);
+
+    /**
+     * Re-aggregates the next spilled partition from its runs on disk into '_groups' so that its
+     * groups can be returned. If the partition does not fit in memory on its own, it falls back to
+     * spill() and a merge of sorted runs for that partition only. Returns false if there are no
+     * more spilled partitions.
+     */
+    bool loadNextSpilledPartition();
+
+    /**
+     * Returns the spill partition to which the group with key 'id' belongs.
+     */
+    size_t partitionForId(const Value& id) const;
+
+    /**
+     * Looks up the group for 'id', creating it and initializing its accumulators if it does not
+     * exist yet. The size of a newly created key is added to '_memoryUsageBytes'. The returned
+     * boolean indicates whether the group was inserted.
+     */
+    std::pair<Accumulators*, bool> findOrCreateGroup(const Value& id);
+
+    /**
+     * Serializes and deserializes the accumulator states of a group to and from the single Value
+     * format written to disk by spill() and spillPartitions().
+     */
+    Value getSpillableAccumulatorState(const Accumulators& accums) const;
+    void mergeSpilledAccumulatorState(const Value& state, Accumulators* accums) const;
+
+    /**
+     * Creates a merge iterator over '_sortedFiles' and prepares '_currentAccumulators' and
+     * '_firstPartOfNextGroup' for getNextSpilled().
+     */
+    void startMergingSortedRuns();
+
     Document makeDocument(const Value& id, const Accumulators& accums, bool mergeableOutput);
 
     /**
@@ -247,6 +326,13 @@ private:
 
     bool _initialized;
 
+    // True while groups are returned as soon as the group key changes. '_groups' then holds only
+    // the group currently being accumulated.
+    bool _streaming = false;
+
+    // A document read while streaming whose group has to be built by initialize() instead.
+    boost::optional<Document> _unprocessedInput;
+
     Value _currentId;
     Accumulators _currentAccumulators;
 
@@ -266,6 +352,20 @@ private:
     const bool _allowDiskUse;
 
     std::pair<Value, Value> _firstPartOfNextGroup;
+
+    // Number of hash partitions to use when spilling, or 0 to spill the whole of '_groups' as a
+    // sorted run each time.
+    const size_t _numSpillPartitions;
+
+    // Runs written by spillPartitions(), indexed by partition. A partition with no runs has never
+    // spilled. All runs share '_partitionFileName'.
+    std::vector<std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>>> _partitionRuns;
+    std::string _partitionFileName;
+    std::streampos _nextPartitionFileOffset = 0;
+    size_t _numPartitionSpills = 0;
+
+    // Spilled partitions which still need to be re-aggregated and returned, in order.
+    std::deque<size_t> _pendingSpilledPartitions;
 };
 
 }  // namespace mongo
@@ -47,13 +47,16 @@
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -145,6 +148,74 @@ TEST_F(DocumentSourceGroupTest, ShouldBeAbleToPauseLoadingWhileSpilled) {
     ASSERT_EQ(idSet.count(2), 1UL);
 }
 
+/**
+ * Groups a few hundred distinct ids, each seen several times, with a memory limit small enough to
+ * force spilling under the given 'internalDocumentSourceGroupSpillPartitions' setting. Asserts that
+ * every group is returned exactly once with all of its values.
+ */
+void assertSpilledGroupsAreComplete(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                    int numSpillPartitions) {
+    const int oldNumSpillPartitions = internalDocumentSourceGroupSpillPartitions.load();
+    internalDocumentSourceGroupSpillPartitions.store(numSpillPartitions);
+    ON_BLOCK_EXIT([&] { internalDocumentSourceGroupSpillPartitions.store(oldNumSpillPartitions); });
+
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+    const size_t maxMemoryUsageBytes = 10 * 1024;
+    const int numIds = 200;
+    const int numRepeats = 3;
+
+    auto&& pushParser = AccumulationStatement::getParser("$push");
+    auto pushArg = BSON(""
+                        << "$str");
+    AccumulationStatement pushStatement{
+        "strs", pushParser(expCtx, pushArg.firstElement(), expCtx->variablesParseState)};
+    auto&& sumParser = AccumulationStatement::getParser("$sum");
+    auto sumArg = BSON("" << 1);
+    AccumulationStatement countStatement{
+        "count", sumParser(expCtx, sumArg.firstElement(), expCtx->variablesParseState)};
+    auto groupByExpression =
+        ExpressionFieldPath::parse(expCtx, "$_id", expCtx->variablesParseState);
+    auto group = DocumentSourceGroup::create(
+        expCtx, groupByExpression, {pushStatement, countStatement}, maxMemoryUsageBytes);
+
+    std::deque<DocumentSource::GetNextResult> inputs;
+    const string str(100, 'x');
+    for (int repeat = 0; repeat < numRepeats; ++repeat) {
+        for (int id = 0; id < numIds; ++id) {
+            inputs.emplace_back(Document{{"_id", id}, {"str", str}});
+        }
+    }
+    auto mock = DocumentSourceMock::createForTest(std::move(inputs));
+    group->setSource(mock.get());
+
+    stdx::unordered_set<int> idSet;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        ASSERT_TRUE(idSet.insert(doc["_id"].coerceToInt()).second);
+        ASSERT_EQ(doc["count"].coerceToInt(), numRepeats);
+        ASSERT_EQ(doc["strs"].getArrayLength(), static_cast<size_t>(numRepeats));
+    }
+    ASSERT_TRUE(group->getNext().isEOF());
+    ASSERT_EQ(idSet.size(), static_cast<size_t>(numIds));
+    ASSERT_TRUE(group->usedDisk());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldReturnAllGroupsAfterSpillingHashPartitions) {
+    assertSpilledGroupsAreComplete(getExpCtx(), 32);
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldReturnAllGroupsWhenASpilledPartitionDoesNotFitInMemory) {
+    // With a single partition, re-aggregating it needs as much memory as the whole input, so it
+    // has to fall back to merging sorted runs.
+    assertSpilledGroupsAreComplete(getExpCtx(), 1);
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldReturnAllGroupsAfterSpillingSortedRuns) {
+    assertSpilledGroupsAreComplete(getExpCtx(), 0);
+}
+
 TEST_F(DocumentSourceGroupTest, ShouldErrorIfNotAllowedToSpillToDiskAndResultSetIsTooLarge) {
     auto expCtx = getExpCtx();
     const size_t maxMemoryUsageBytes = 1000;
@@ -238,6 +309,112 @@ TEST_F(DocumentSourceGroupTest, ShouldNotReportDottedGroupKeyAsARename) {
     ASSERT_EQ(modifiedPathsRet.renames.size(), 0UL);
 }
 
+bool isStreamingGroupAfterOptimizing(const intrusive_ptr<ExpressionContext>& expCtx,
+                                     const std::vector<BSONObj>& rawPipeline) {
+    auto pipeline = Pipeline::parse(rawPipeline, expCtx);
+    pipeline->optimizePipeline();
+    auto group = dynamic_cast<DocumentSourceGroup*>(pipeline->getSources().back().get());
+    ASSERT(group);
+    return group->isStreaming();
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldStreamWhenGroupKeysArePrefixOfPrecedingSort) {
+    auto expCtx = getExpCtx();
+    ASSERT_TRUE(isStreamingGroupAfterOptimizing(
+        expCtx, {fromjson("{$sort: {a: 1}}"), fromjson("{$group: {_id: '$a', n: {$sum: 1}}}")}));
+    ASSERT_TRUE(isStreamingGroupAfterOptimizing(expCtx,
+                                                {fromjson("{$sort: {a: -1, b: 1, c: 1}}"),
+                                                 fromjson("{$group: {_id: {x: '$b', y: '$a'}}}")}));
+    ASSERT_TRUE(isStreamingGroupAfterOptimizing(
+        expCtx, {fromjson("{$sort: {'a.b': 1}}"), fromjson("{$group: {_id: '$a.b'}}")}));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldNotStreamWhenGroupKeysAreNotPrefixOfPrecedingSort) {
+    auto expCtx = getExpCtx();
+    ASSERT_FALSE(isStreamingGroupAfterOptimizing(expCtx, {fromjson("{$group: {_id: '$a'}}")}));
+    ASSERT_FALSE(isStreamingGroupAfterOptimizing(
+        expCtx, {fromjson("{$sort: {b: 1, a: 1}}"), fromjson("{$group: {_id: '$a'}}")}));
+    ASSERT_FALSE(isStreamingGroupAfterOptimizing(
+        expCtx, {fromjson("{$sort: {a: 1}}"), fromjson("{$group: {_id: {x: '$a', y: '$b'}}}")}));
+    ASSERT_FALSE(isStreamingGroupAfterOptimizing(
+        expCtx, {fromjson("{$sort: {a: 1}}"), fromjson("{$group: {_id: {$toLower: '$a'}}}")}));
+    ASSERT_FALSE(isStreamingGroupAfterOptimizing(
+        expCtx, {fromjson("{$sort: {a: 1}}"), fromjson("{$group: {_id: '$$ROOT'}}")}));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldNotStreamIfDisabled) {
+    auto expCtx = getExpCtx();
+    const bool oldValue = internalDocumentSourceGroupEnableStreaming.load();
+    internalDocumentSourceGroupEnableStreaming.store(false);
+    ON_BLOCK_EXIT([&] { internalDocumentSourceGroupEnableStreaming.store(oldValue); });
+    ASSERT_FALSE(isStreamingGroupAfterOptimizing(
+        expCtx, {fromjson("{$sort: {a: 1}}"), fromjson("{$group: {_id: '$a'}}")}));
+}
+
+TEST_F(DocumentSourceGroupTest, StreamingGroupReturnsEachGroupWhenTheKeyChanges) {
+    auto expCtx = getExpCtx();
+    auto group = DocumentSourceGroup::createFromBson(
+        fromjson("{$group: {_id: '$a', n: {$sum: 1}}}").firstElement(), expCtx);
+    static_cast<DocumentSourceGroup*>(group.get())
+        ->setInputSortPattern(SortPattern(BSON("a" << 1), expCtx));
+    auto mock =
+        DocumentSourceMock::createForTest({Document{{"a", 1}},
+                                           Document{{"a", 1}},
+                                           Document{{"a", 2}},
+                                           DocumentSource::GetNextResult::makePauseExecution(),
+                                           Document{{"a", 2}},
+                                           Document{{"b", 1}}});
+    group->setSource(mock.get());
+
+    // The first group is complete as soon as a document with another key is seen.
+    auto next = group->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"_id", 1}, {"n", 2}}));
+    ASSERT_TRUE(group->getNext().isPaused());
+
+    next = group->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"_id", 2}, {"n", 2}}));
+
+    // A missing key sorts and groups as null.
+    next = group->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"_id", BSONNULL}, {"n", 1}}));
+    ASSERT_TRUE(group->getNext().isEOF());
+    ASSERT_TRUE(group->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGroupTest, StreamingGroupFallsBackToHashTableForArrayKeys) {
+    auto expCtx = getExpCtx();
+    auto group = DocumentSourceGroup::createFromBson(
+        fromjson("{$group: {_id: '$a', n: {$sum: 1}}}").firstElement(), expCtx);
+    static_cast<DocumentSourceGroup*>(group.get())
+        ->setInputSortPattern(SortPattern(BSON("a" << 1), expCtx));
+
+    // $sort orders the array by its smallest element, so it may sit between documents with a: 1.
+    auto mock = DocumentSourceMock::createForTest({Document{{"a", 0}},
+                                                   Document{{"a", 1}},
+                                                   Document{{"a", BSON_ARRAY(1 << 5)}},
+                                                   Document{{"a", 1}}});
+    group->setSource(mock.get());
+
+    auto next = group->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"_id", 0}, {"n", 1}}));
+
+    std::vector<Document> rest;
+    for (next = group->getNext(); next.isAdvanced(); next = group->getNext()) {
+        rest.push_back(next.releaseDocument());
+    }
+    ASSERT_TRUE(next.isEOF());
+    ASSERT_EQ(rest.size(), 2UL);
+    std::sort(rest.begin(), rest.end(), [](const Document& lhs, const Document& rhs) {
+        return Value::compare(lhs["_id"], rhs["_id"], nullptr) < 0;
+    });
+    ASSERT_DOCUMENT_EQ(rest[0], (Document{{"_id", 1}, {"n", 2}}));
+    ASSERT_DOCUMENT_EQ(rest[1], (Document{{"_id", BSON_ARRAY(1 << 5)}, {"n", 1}}));
+}
+
 BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     vector<Value> arr;
     source->serializeToArray(arr);
@@ -0,0 +1,302 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+REGISTER_DOCUMENT_SOURCE(_internalUnpackBucket,
+                         LiteParsedDocumentSourceDefault::parse,
+                         DocumentSourceInternalUnpackBucket::createFromBson);
+
+constexpr StringData DocumentSourceInternalUnpackBucket::kStageName;
+constexpr StringData DocumentSourceInternalUnpackBucket::kTimeFieldName;
+constexpr StringData DocumentSourceInternalUnpackBucket::kMetaFieldName;
+constexpr StringData DocumentSourceInternalUnpackBucket::kBucketControlFieldName;
+constexpr StringData DocumentSourceInternalUnpackBucket::kBucketMetaFieldName;
+constexpr StringData DocumentSourceInternalUnpackBucket::kBucketDataFieldName;
+
+namespace {
+
+/**
+ * Returns the top-level field name held by the string option 'elem'.
+ */
+std::string parseFieldName(const BSONElement& elem) {
+    uassert(5212034,
+            str::stream() << "'" << elem.fieldNameStringData() << "' option to "
+                          << DocumentSourceInternalUnpackBucket::kStageName
+                          << " must be a string, but found: " << typeName(elem.type()),
+            elem.type() == BSONType::String);
+
+    auto fieldName = elem.str();
+    uassert(5212035,
+            str::stream() << "'" << elem.fieldNameStringData() << "' option to "
+                          << DocumentSourceInternalUnpackBucket::kStageName
+                          << " must name a top-level field, but found: " << fieldName,
+            !fieldName.empty() && fieldName[0] != '$' &&
+                fieldName.find('.') == std::string::npos);
+    return fieldName;
+}
+
+/**
+ * Returns true if the measurement at position 'lhs' in a bucket column precedes the one at 'rhs'.
+ * Positions are decimal field names, so a shorter one is always the smaller.
+ */
+bool positionLessThan(StringData lhs, StringData rhs) {
+    return lhs.size() < rhs.size() || (lhs.size() == rhs.size() && lhs < rhs);
+}
+
+/**
+ * Returns a predicate on the bucket's bounds for 'timeField' which every bucket holding a
+ * measurement that matches 'expr' satisfies, or an empty object if 'expr' is not a comparison of
+ * 'timeField' with a date. A bucket whose bound is not a date is always kept.
+ */
+BSONObj makeBucketBoundsPredicate(const MatchExpression* expr, StringData timeField) {
+    auto comparison = dynamic_cast<const ComparisonMatchExpressionBase*>(expr);
+    if (!comparison || comparison->path() != timeField ||
+        comparison->getData().type() != BSONType::Date) {
+        return BSONObj();
+    }
+
+    const auto controlPath = DocumentSourceInternalUnpackBucket::kBucketControlFieldName;
+    const std::string minPath = str::stream() << controlPath << ".min." << timeField;
+    const std::string maxPath = str::stream() << controlPath << ".max." << timeField;
+    const auto date = comparison->getData().date();
+    auto boundPredicate = [](const std::string& path, StringData op, Date_t date) {
+        return BSON("$or" << BSON_ARRAY(BSON(path << BSON(op << date))
+                                        << BSON(path << BSON("$not" << BSON("$type"
+                                                                            << "date")))));
+    };
+
+    switch (expr->matchType()) {
+        case MatchExpression::EQ:
+            return BSON("$and" << BSON_ARRAY(boundPredicate(minPath, "$lte", date)
+                                             << boundPredicate(maxPath, "$gte", date)));
+        case MatchExpression::LT:
+            return boundPredicate(minPath, "$lt", date);
+        case MatchExpression::LTE:
+            return boundPredicate(minPath, "$lte", date);
+        case MatchExpression::GT:
+            return boundPredicate(maxPath, "$gt", date);
+        case MatchExpression::GTE:
+            return boundPredicate(maxPath, "$gte", date);
+        default:
+            return BSONObj();
+    }
+}
+
+}  // namespace
+
+boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createFromBson(
+    BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    uassert(5212036,
+            str::stream() << kStageName << " must take a nested object but found: " << elem,
+            elem.type() == BSONType::Object);
+
+    boost::optional<std::string> timeField;
+    boost::optional<std::string> metaField;
+    for (auto&& option : elem.embeddedObject()) {
+        const auto optionName = option.fieldNameStringData();
+        if (optionName == kTimeFieldName) {
+            timeField = parseFieldName(option);
+        } else if (optionName == kMetaFieldName) {
+            metaField = parseFieldName(option);
+        } else {
+            uasserted(5212037,
+                      str::stream() << "unrecognized option to " << kStageName << ": "
+                                    << optionName);
+        }
+    }
+
+    uassert(5212038,
+            str::stream() << kStageName << " requires a '" << kTimeFieldName << "' option",
+            timeField);
+    uassert(5212039,
+            str::stream() << "'" << kTimeFieldName << "' and '" << kMetaFieldName
+                          << "' options to " << kStageName << " must name different fields",
+            timeField != metaField);
+
+    return create(expCtx, std::move(*timeField), std::move(metaField));
+}
+
+boost::intrusive_ptr<DocumentSourceInternalUnpackBucket> DocumentSourceInternalUnpackBucket::create(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    std::string timeField,
+    boost::optional<std::string> metaField) {
+    return new DocumentSourceInternalUnpackBucket(
+        expCtx, std::move(timeField), std::move(metaField));
+}
+
+DocumentSourceInternalUnpackBucket::DocumentSourceInternalUnpackBucket(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    std::string timeField,
+    boost::optional<std::string> metaField)
+    : DocumentSource(kStageName, expCtx),
+      _timeField(std::move(timeField)),
+      _metaField(std::move(metaField)) {}
+
+Value DocumentSourceInternalUnpackBucket::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    MutableDocument spec;
+    spec[kTimeFieldName] = Value(_timeField);
+    if (_metaField) {
+        spec[kMetaFieldName] = Value(*_metaField);
+    }
+    return Value(Document{{getSourceName(), spec.freezeToValue()}});
+}
+
+DepsTracker::State DocumentSourceInternalUnpackBucket::getDependencies(DepsTracker* deps) const {
+    deps->fields.insert(kBucketDataFieldName.toString());
+    if (_metaField) {
+        deps->fields.insert(kBucketMetaFieldName.toString());
+    }
+    return DepsTracker::State::EXHAUSTIVE_FIELDS;
+}
+
+DocumentSource::GetModPathsReturn DocumentSourceInternalUnpackBucket::getModifiedPaths() const {
+    if (!_metaField) {
+        return {GetModPathsReturn::Type::kAllPaths, std::set<std::string>{}, {}};
+    }
+    return {GetModPathsReturn::Type::kAllExcept,
+            std::set<std::string>{},
+            {{*_metaField, kBucketMetaFieldName.toString()}}};
+}
+
+void DocumentSourceInternalUnpackBucket::setBucket(BSONObj bucket) {
+    _bucket = std::move(bucket);
+    _bucketMeta = _metaField ? _bucket[kBucketMetaFieldName] : BSONElement();
+    _columns.clear();
+    _timeColumn.reset();
+
+    auto data = _bucket[kBucketDataFieldName];
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "bucket field '" << kBucketDataFieldName
+                          << "' must be an object, but found: " << typeName(data.type()),
+            data.type() == BSONType::Object);
+    for (auto&& column : data.embeddedObject()) {
+        uassert(ErrorCodes::BadValue,
+                str::stream() << "bucket column '" << column.fieldNameStringData()
+                              << "' must be an object, but found: " << typeName(column.type()),
+                column.type() == BSONType::Object);
+        if (column.fieldNameStringData() == _timeField) {
+            _timeColumn.emplace(column.embeddedObject());
+        }
+        // The bucket's metadata takes the place of any measurement field of the same name.
+        if (_metaField && column.fieldNameStringData() == *_metaField) {
+            continue;
+        }
+        _columns.emplace_back(column.fieldNameStringData(), column.embeddedObject());
+    }
+
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "bucket has no column for time field '" << _timeField << "'",
+            _timeColumn);
+}
+
+DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::doGetNext() {
+    while (!_timeColumn || !_timeColumn->more()) {
+        auto nextResult = pSource->getNext();
+        if (!nextResult.isAdvanced()) {
+            return nextResult;
+        }
+        setBucket(nextResult.releaseDocument().toBson());
+    }
+
+    auto time = _timeColumn->next();
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "time field '" << _timeField
+                          << "' of a measurement must be a date, but found: "
+                          << typeName(time.type()),
+            time.type() == BSONType::Date);
+    const auto position = time.fieldNameStringData();
+
+    MutableDocument measurement;
+    for (auto&& [fieldName, column] : _columns) {
+        while (column.more() && positionLessThan((*column).fieldNameStringData(), position)) {
+            // There is no time for this measurement, so it is not part of the bucket.
+            column.next();
+        }
+        if (column.more() && (*column).fieldNameStringData() == position) {
+            measurement.addField(fieldName, Value(column.next()));
+        }
+    }
+    if (!_bucketMeta.eoo()) {
+        measurement.addField(*_metaField, Value(_bucketMeta));
+    }
+    return measurement.freeze();
+}
+
+Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    if (_triedBucketBoundsPushdown || std::next(itr) == container->end()) {
+        return std::next(itr);
+    }
+    auto nextMatch = dynamic_cast<DocumentSourceMatch*>(std::next(itr)->get());
+    if (!nextMatch) {
+        return std::next(itr);
+    }
+    _triedBucketBoundsPushdown = true;
+
+    auto matchExpr = nextMatch->getMatchExpression();
+    BSONArrayBuilder boundsPredicates;
+    if (matchExpr->matchType() == MatchExpression::AND) {
+        for (size_t i = 0; i < matchExpr->numChildren(); ++i) {
+            auto predicate = makeBucketBoundsPredicate(matchExpr->getChild(i), _timeField);
+            if (!predicate.isEmpty()) {
+                boundsPredicates.append(predicate);
+            }
+        }
+    } else if (auto predicate = makeBucketBoundsPredicate(matchExpr, _timeField);
+               !predicate.isEmpty()) {
+        boundsPredicates.append(predicate);
+    }
+
+    if (boundsPredicates.arrSize() == 0) {
+        return std::next(itr);
+    }
+
+    // Keep the original $match after this stage, since the bounds only rule out whole buckets.
+    container->insert(itr,
+                      DocumentSourceMatch::create(BSON("$and" << boundsPredicates.arr()), pExpCtx));
+
+    // The new $match may be able to optimize further with the stage before it, if there is one.
+    auto newMatch = std::prev(itr);
+    return newMatch == container->begin() ? newMatch : std::prev(newMatch);
+}
+
+}  // namespace mongo
@@ -0,0 +1,144 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/pipeline/document_source.h"
+
+namespace mongo {
+
+/**
+ * Unpacks each bucket of time-series measurements produced by its source into one document per
+ * measurement. A bucket stores the measurements column-wise, along with the metadata they share
+ * and the bounds of their values:
+ *
+ *   {
+ *     _id: <bucket id>,
+ *     control: {min: {<field>: <min value>, ...}, max: {<field>: <max value>, ...}},
+ *     meta: <metadata common to all measurements>,
+ *     data: {<field>: {"0": <value of measurement 0>, "1": <value of measurement 1>, ...}, ...}
+ *   }
+ *
+ * Every measurement has a Date under 'timeField', and the others may omit any field. Each unpacked
+ * measurement holds its fields in the order of the columns, followed by the bucket's metadata
+ * under 'metaField' if one is configured.
+ *
+ * A $match that follows this stage is partly applied to the buckets: predicates on 'metaField'
+ * move ahead of it onto 'meta', and comparisons of 'timeField' with a date also prune the buckets
+ * whose control.min and control.max rule them out.
+ */
+class DocumentSourceInternalUnpackBucket final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalUnpackBucket"_sd;
+    static constexpr StringData kTimeFieldName = "timeField"_sd;
+    static constexpr StringData kMetaFieldName = "metaField"_sd;
+
+    static constexpr StringData kBucketControlFieldName = "control"_sd;
+    static constexpr StringData kBucketMetaFieldName = "meta"_sd;
+    static constexpr StringData kBucketDataFieldName = "data"_sd;
+
+    static boost::intrusive_ptr<DocumentSource> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    static boost::intrusive_ptr<DocumentSourceInternalUnpackBucket> create(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        std::string timeField,
+        boost::optional<std::string> metaField);
+
+    const char* getSourceName() const final {
+        return kStageName.rawData();
+    }
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        StageConstraints constraints(StreamType::kStreaming,
+                                     PositionRequirement::kNone,
+                                     HostTypeRequirement::kNone,
+                                     DiskUseRequirement::kNoDiskUse,
+                                     FacetRequirement::kAllowed,
+                                     TransactionRequirement::kAllowed,
+                                     LookupRequirement::kAllowed,
+                                     UnionRequirement::kAllowed);
+
+        constraints.canSwapWithMatch = true;
+        return constraints;
+    }
+
+    boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
+        return boost::none;
+    }
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+    /**
+     * A bucket is read only through its data and metadata, whatever the later stages need.
+     */
+    DepsTracker::State getDependencies(DepsTracker* deps) const final;
+
+    /**
+     * Every path is new except 'metaField', which is the bucket's 'meta' under another name.
+     */
+    GetModPathsReturn getModifiedPaths() const final;
+
+private:
+    DocumentSourceInternalUnpackBucket(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                       std::string timeField,
+                                       boost::optional<std::string> metaField);
+
+    GetNextResult doGetNext() final;
+
+    /**
+     * If the next stage is a $match with comparisons of 'timeField' to a date, inserts a $match on
+     * the bucket bounds ahead of this stage which drops the buckets that cannot hold a match.
+     */
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
+    /**
+     * Starts unpacking 'bucket'.
+     */
+    void setBucket(BSONObj bucket);
+
+    const std::string _timeField;
+    const boost::optional<std::string> _metaField;
+
+    // Whether doOptimizeAt() has already derived a $match on the bucket bounds, so it does not add
+    // another each time the pipeline is optimized.
+    bool _triedBucketBoundsPushdown = false;
+
+    // The bucket currently being unpacked, with an iterator over each of its data columns. The
+    // time column decides which measurements the bucket holds.
+    BSONObj _bucket;
+    BSONElement _bucketMeta;
+    std::vector<std::pair<StringData, BSONObjIterator>> _columns;
+    boost::optional<BSONObjIterator> _timeColumn;
+};
+
+}  // namespace mongo
@@ -0,0 +1,153 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonmisc.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using InternalUnpackBucketTest = AggregationContextFixture;
+
+TEST_F(InternalUnpackBucketTest, UnpacksEachMeasurementOfEachBucket) {
+    auto spec = fromjson("{$_internalUnpackBucket: {timeField: 't', metaField: 'tag'}}");
+    auto unpack = DocumentSourceInternalUnpackBucket::createFromBson(spec.firstElement(),
+                                                                     getExpCtx());
+    auto mock = DocumentSourceMock::createForTest(
+        {"{meta: 'a', data: {t: {'0': {$date: 1}, '1': {$date: 2}}, x: {'1': 5}, tag: {'0': 1}}}",
+         "{data: {t: {}}}",
+         "{meta: 'b', data: {t: {'0': {$date: 3}}, x: {'0': 7}}}"});
+    unpack->setSource(mock.get());
+
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), Document(fromjson("{t: {$date: 1}, tag: 'a'}")));
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{t: {$date: 2}, x: 5, tag: 'a'}")));
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{t: {$date: 3}, x: 7, tag: 'b'}")));
+    ASSERT_TRUE(unpack->getNext().isEOF());
+}
+
+TEST_F(InternalUnpackBucketTest, RejectsBucketWithoutTimeColumn) {
+    auto unpack = DocumentSourceInternalUnpackBucket::create(getExpCtx(), "t", boost::none);
+    auto mock = DocumentSourceMock::createForTest({"{data: {x: {'0': 1}}}"});
+    unpack->setSource(mock.get());
+    ASSERT_THROWS_CODE(unpack->getNext(), AssertionException, ErrorCodes::BadValue);
+}
+
+TEST_F(InternalUnpackBucketTest, RejectsInvalidSpecs) {
+    auto parse = [&](const char* json) {
+        return DocumentSourceInternalUnpackBucket::createFromBson(fromjson(json).firstElement(),
+                                                                  getExpCtx());
+    };
+    ASSERT_THROWS_CODE(parse("{$_internalUnpackBucket: 't'}"), AssertionException, 5212036);
+    ASSERT_THROWS_CODE(parse("{$_internalUnpackBucket: {}}"), AssertionException, 5212038);
+    ASSERT_THROWS_CODE(
+        parse("{$_internalUnpackBucket: {timeField: 1}}"), AssertionException, 5212034);
+    ASSERT_THROWS_CODE(
+        parse("{$_internalUnpackBucket: {timeField: 'a.b'}}"), AssertionException, 5212035);
+    ASSERT_THROWS_CODE(parse("{$_internalUnpackBucket: {timeField: 't', foo: 1}}"),
+                       AssertionException,
+                       5212037);
+    ASSERT_THROWS_CODE(parse("{$_internalUnpackBucket: {timeField: 't', metaField: 't'}}"),
+                       AssertionException,
+                       5212039);
+}
+
+TEST_F(InternalUnpackBucketTest, SerializesToOriginalSpec) {
+    auto spec = fromjson("{$_internalUnpackBucket: {timeField: 't', metaField: 'tag'}}");
+    auto unpack = DocumentSourceInternalUnpackBucket::createFromBson(spec.firstElement(),
+                                                                     getExpCtx());
+    std::vector<Value> serialized;
+    unpack->serializeToArray(serialized);
+    ASSERT_EQ(serialized.size(), 1U);
+    ASSERT_VALUE_EQ(serialized[0], Value(spec));
+}
+
+TEST_F(InternalUnpackBucketTest, MovesMatchOnMetaFieldBeforeItselfAsMatchOnBucketMeta) {
+    Pipeline::SourceContainer container;
+    container.push_back(
+        DocumentSourceInternalUnpackBucket::create(getExpCtx(), "t", std::string("tag")));
+    container.push_back(DocumentSourceMatch::create(fromjson("{tag: 'a', x: 1}"), getExpCtx()));
+
+    auto pipeline = Pipeline::create(std::move(container), getExpCtx());
+    pipeline->optimizePipeline();
+
+    auto serialized = pipeline->serialize();
+    ASSERT_EQ(serialized.size(), 3U);
+    ASSERT_VALUE_EQ(serialized[0], Value(fromjson("{$match: {meta: {$eq: 'a'}}}")));
+    ASSERT_VALUE_EQ(
+        serialized[1],
+        Value(fromjson("{$_internalUnpackBucket: {timeField: 't', metaField: 'tag'}}")));
+    ASSERT_VALUE_EQ(serialized[2], Value(fromjson("{$match: {x: {$eq: 1}}}")));
+}
+
+TEST_F(InternalUnpackBucketTest, AddsMatchOnBucketBoundsForTimePredicates) {
+    Pipeline::SourceContainer container;
+    container.push_back(DocumentSourceInternalUnpackBucket::create(getExpCtx(), "t", boost::none));
+    container.push_back(DocumentSourceMatch::create(
+        fromjson("{t: {$gte: {$date: 10}, $lt: {$date: 20}}, x: 1}"), getExpCtx()));
+
+    auto pipeline = Pipeline::create(std::move(container), getExpCtx());
+    pipeline->optimizePipeline();
+
+    // The original $match stays after the stage, behind one on the bucket bounds.
+    auto& sources = pipeline->getSources();
+    ASSERT_EQ(sources.size(), 3U);
+    auto boundsMatch = dynamic_cast<DocumentSourceMatch*>(sources.front().get());
+    ASSERT(boundsMatch);
+    ASSERT(dynamic_cast<DocumentSourceMatch*>(sources.back().get()));
+
+    auto matchesBucket = [&](const char* control) {
+        return boundsMatch->getMatchExpression()->matchesBSON(fromjson(control));
+    };
+    ASSERT_TRUE(matchesBucket("{control: {min: {t: {$date: 5}}, max: {t: {$date: 10}}}}"));
+    ASSERT_TRUE(matchesBucket("{control: {min: {t: {$date: 15}}, max: {t: {$date: 30}}}}"));
+    ASSERT_FALSE(matchesBucket("{control: {min: {t: {$date: 1}}, max: {t: {$date: 9}}}}"));
+    ASSERT_FALSE(matchesBucket("{control: {min: {t: {$date: 20}}, max: {t: {$date: 30}}}}"));
+    // A bucket without date bounds might still hold matching measurements.
+    ASSERT_TRUE(matchesBucket("{control: {}}"));
+}
+
+}  // namespace
+}  // namespace mongo
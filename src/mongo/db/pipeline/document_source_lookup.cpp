@@ -27,6 +27,8 @@
  *    it in the license file.
  */
 
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kQuery
+
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/pipeline/document_source_lookup.h"
@@ -34,14 +36,17 @@
 #include <memory>
 
 #include "mongo/base/init.h"
+#include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
+#include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/logv2/log.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/util/fail_point.h"
 
@@ -175,11 +180,36 @@ const char* DocumentSourceLookUp::getSourceName() const {
     return kStageName.rawData();
 }
 
+bool DocumentSourceLookUp::canRunOnShards() const {
+    if (_canRunOnShards) {
+        return *_canRunOnShards;
+    }
+
+    _canRunOnShards = [&] {
+        if (!pExpCtx->inMongos || !internalQueryPushLookupToShards.load() ||
+            !(getTestCommandsEnabled() && internalQueryAllowShardedLookup.load())) {
+            return false;
+        }
+        const auto opCtx = pExpCtx->opCtx;
+        const auto& processInterface = pExpCtx->mongoProcessInterface;
+        if (processInterface->isSharded(opCtx, _fromNs)) {
+            return !wasConstructedWithPipelineSyntax() &&
+                processInterface->haveSameChunkDistribution(
+                    opCtx, pExpCtx->ns, *_localField, _fromNs, *_foreignField);
+        }
+        const auto size = processInterface->getUnshardedCollectionSize(opCtx, _resolvedNs);
+        return size && *size <= internalLookupHashJoinMaxMemoryBytes.load();
+    }();
+    return *_canRunOnShards;
+}
+
 StageConstraints DocumentSourceLookUp::constraints(Pipeline::SplitState) const {
-    // If executing on mongos and the foreign collection is sharded, then this stage can run on
-    // mongos or any shard.
+    // If executing on mongos and the foreign collection is sharded, or this stage runs on the
+    // shards, then this stage can run on mongos or any shard.
     HostTypeRequirement hostRequirement =
-        (pExpCtx->inMongos && pExpCtx->mongoProcessInterface->isSharded(pExpCtx->opCtx, _fromNs))
+        (pExpCtx->inMongos &&
+         (canRunOnShards() ||
+          pExpCtx->mongoProcessInterface->isSharded(pExpCtx->opCtx, _fromNs)))
         ? HostTypeRequirement::kNone
         : HostTypeRequirement::kPrimaryShard;
 
@@ -251,17 +281,92 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         return unwindResult();
     }
 
+    // If we have not absorbed a $unwind, we cannot absorb a $match. If we have absorbed a $unwind,
+    // '_unwindSrc' would be non-null, and we would not have made it here.
+    invariant(!_matchSrc);
+
+    if (!wasConstructedWithPipelineSyntax()) {
+        return getNextBatched();
+    }
+
     auto nextInput = pSource->getNext();
     if (!nextInput.isAdvanced()) {
         return nextInput;
     }
 
     auto inputDoc = nextInput.releaseDocument();
+    auto results = lookUpWithForeignQuery(inputDoc);
 
-    // If we have not absorbed a $unwind, we cannot absorb a $match. If we have absorbed a $unwind,
-    // '_unwindSrc' would be non-null, and we would not have made it here.
-    invariant(!_matchSrc);
+    MutableDocument output(std::move(inputDoc));
+    output.setNestedField(_as, Value(std::move(results)));
+    return output.freeze();
+}
+
+DocumentSource::GetNextResult DocumentSourceLookUp::getNextBatched() {
+    if (!_batchedOutput.empty()) {
+        auto output = std::move(_batchedOutput.front());
+        _batchedOutput.pop_front();
+        return output;
+    }
+
+    if (_batchedPendingResult) {
+        auto pendingResult = std::move(*_batchedPendingResult);
+        _batchedPendingResult = boost::none;
+        return pendingResult;
+    }
+
+    // Collect the next batch of input documents, stopping early at a pause or EOF, which is then
+    // returned once the batch has been drained.
+    const auto maxBatchSize = static_cast<size_t>(internalLookupBatchedProbeMaxBatchSize.load());
+    std::vector<Document> batch;
+    std::vector<boost::optional<std::vector<Value>>> batchResults;
+    while (batch.size() < maxBatchSize) {
+        auto nextInput = pSource->getNext();
+        if (!nextInput.isAdvanced()) {
+            if (batch.empty()) {
+                return nextInput;
+            }
+            _batchedPendingResult = std::move(nextInput);
+            break;
+        }
+        batch.push_back(nextInput.releaseDocument());
+        batchResults.push_back(lookUpWithHashJoin(batch.back()));
+    }
+
+    // Query the foreign collection once for all the documents the hash join could not answer.
+    std::vector<const Document*> docsToProbe;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (!batchResults[i]) {
+            docsToProbe.push_back(&batch[i]);
+        }
+    }
+
+    std::vector<std::vector<Value>> probeResults;
+    if (docsToProbe.size() == 1) {
+        probeResults.push_back(lookUpWithForeignQuery(*docsToProbe.front()));
+    } else if (docsToProbe.size() > 1) {
+        probeResults = lookUpBatchWithForeignQuery(docsToProbe);
+    }
+
+    auto probeResultsIt = probeResults.begin();
+    for (auto&& results : batchResults) {
+        if (!results) {
+            results = std::move(*probeResultsIt++);
+        }
+    }
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        MutableDocument output(std::move(batch[i]));
+        output.setNestedField(_as, Value(std::move(*batchResults[i])));
+        _batchedOutput.push_back(output.freeze());
+    }
 
+    auto output = std::move(_batchedOutput.front());
+    _batchedOutput.pop_front();
+    return output;
+}
+
+std::vector<Value> DocumentSourceLookUp::lookUpWithForeignQuery(const Document& inputDoc) {
     if (!wasConstructedWithPipelineSyntax()) {
         auto matchStage =
             makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
@@ -288,10 +393,214 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         results.emplace_back(std::move(*result));
     }
     _usedDisk = _usedDisk || pipeline->usedDisk();
+    return results;
+}
 
-    MutableDocument output(std::move(inputDoc));
-    output.setNestedField(_as, Value(std::move(results)));
-    return output.freeze();
+std::vector<std::vector<Value>> DocumentSourceLookUp::lookUpBatchWithForeignQuery(
+    const std::vector<const Document*>& inputDocs) {
+    invariant(!wasConstructedWithPipelineSyntax());
+    const auto foreignField = _foreignField->fullPath();
+
+    // Gather the distinct local values of the whole batch, along with each document's own join
+    // predicate, which is used to hand the foreign documents back to the input documents.
+    auto localValues = _fromExpCtx->getValueComparator().makeOrderedValueSet();
+    std::vector<BSONObj> matchStages;
+    std::vector<std::unique_ptr<MatchExpression>> predicates;
+    for (auto inputDoc : inputDocs) {
+        bool sawValue = false;
+        document_path_support::visitAllValuesAtPath(
+            *inputDoc, *_localField, [&](const Value& localValue) {
+                sawValue = true;
+                localValues.insert(localValue);
+            });
+        if (!sawValue) {
+            // Missing values are treated as null.
+            localValues.insert(Value(BSONNULL));
+        }
+
+        matchStages.push_back(
+            makeMatchStageFromInput(*inputDoc, *_localField, foreignField, BSONObj()));
+        predicates.push_back(uassertStatusOK(
+            MatchExpressionParser::parse(matchStages.back().firstElement().embeddedObject(),
+                                         _fromExpCtx)));
+    }
+
+    // Join on all of the local values at once. Wrapping them in a single array field lets
+    // makeMatchStageFromInput() build the same $in, or $or when there are regexes, that it would
+    // build for a single document with an array local field.
+    const FieldPath batchField("localValues");
+    const Document batchDoc{
+        {batchField.fullPath(), Value(std::vector<Value>(localValues.begin(), localValues.end()))}};
+    _resolvedPipeline.back() =
+        makeMatchStageFromInput(batchDoc, batchField, foreignField, BSONObj());
+    auto pipeline = buildPipeline(*inputDocs.front());
+
+    std::vector<std::vector<Value>> results(inputDocs.size());
+    std::vector<long long> objsizes(inputDocs.size(), 0);
+    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+
+    while (auto result = pipeline->getNext()) {
+        const auto foreignObj = result->toBson();
+        const Value foreignDoc(std::move(*result));
+        for (size_t i = 0; i < inputDocs.size(); ++i) {
+            if (!predicates[i]->matchesBSON(foreignObj)) {
+                continue;
+            }
+            long long safeSum = 0;
+            bool hasOverflowed =
+                overflow::add(objsizes[i], foreignDoc.getApproximateSize(), &safeSum);
+            uassert(4568,
+                    str::stream() << "Total size of documents in " << _fromNs.coll()
+                                  << " matching pipeline's $lookup stage exceeds " << maxBytes
+                                  << " bytes",
+                    !hasOverflowed && objsizes[i] <= maxBytes);
+            objsizes[i] = safeSum;
+            results[i].push_back(foreignDoc);
+        }
+    }
+    _usedDisk = _usedDisk || pipeline->usedDisk();
+    return results;
+}
+
+namespace {
+
+/**
+ * Returns true if values of type 'type' can be used as hash join keys. These are the types for
+ * which an equality match on a path is satisfied exactly by the scalar values found along that
+ * path, and whose hash is consistent with comparison under the collation.
+ */
+bool isHashJoinKeyType(BSONType type) {
+    switch (type) {
+        case NumberInt:
+        case NumberLong:
+        case NumberDouble:
+        case NumberDecimal:
+        case String:
+        case jstOID:
+        case Bool:
+        case Date:
+        case bsonTimestamp:
+            return true;
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
+boost::optional<std::vector<Value>> DocumentSourceLookUp::lookUpWithHashJoin(
+    const Document& inputDoc) {
+    invariant(!wasConstructedWithPipelineSyntax());
+
+    if (_hashJoinState == HashJoinState::kNotStarted) {
+        if (internalLookupHashJoinMaxMemoryBytes.load() == 0 ||
+            _numInputDocsBeforeHashJoin < internalLookupHashJoinMinInputDocuments.load()) {
+            ++_numInputDocsBeforeHashJoin;
+            return boost::none;
+        }
+        _hashJoinState =
+            buildHashJoinTable(inputDoc) ? HashJoinState::kBuilt : HashJoinState::kAbandoned;
+    }
+
+    if (_hashJoinState != HashJoinState::kBuilt) {
+        return boost::none;
+    }
+    return probeHashJoinTable(inputDoc);
+}
+
+bool DocumentSourceLookUp::buildHashJoinTable(const Document& inputDoc) {
+    // Scan the whole foreign collection, through any view stages, by replacing the trailing $match
+    // with one that matches everything. The per-document $match is restored on fallback.
+    _resolvedPipeline.back() = BSON("$match" << BSONObj());
+    auto pipeline = buildPipeline(inputDoc);
+
+    _hashJoinTable.emplace(
+        _fromExpCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>());
+    const auto maxBytes = internalLookupHashJoinMaxMemoryBytes.load();
+    const auto foreignField = _foreignField->fullPath();
+    long long memoryUsageBytes = 0;
+
+    while (auto result = pipeline->getNext()) {
+        const auto docIndex = _hashJoinDocs.size();
+        memoryUsageBytes += result->getApproximateSize();
+
+        // Collect the values an index on the foreign field would hold for this document. Only
+        // values which may be used as keys are added to the table; a foreign document can only
+        // match a local value of a key type through one of them.
+        BSONElementSet foreignValues;
+        dotted_path_support::extractAllElementsAlongPath(
+            result->toBson(), foreignField, foreignValues);
+        for (auto&& elem : foreignValues) {
+            if (!isHashJoinKeyType(elem.type()) && elem.type() != Symbol) {
+                continue;
+            }
+            // Symbols compare equal to strings, so they are hashed as strings.
+            auto key = elem.type() == Symbol ? Value(elem.valueStringData()) : Value(elem);
+            auto& positions = (*_hashJoinTable)[key];
+            if (positions.empty() || positions.back() != docIndex) {
+                positions.push_back(docIndex);
+                memoryUsageBytes += key.getApproximateSize() + sizeof(size_t);
+            }
+        }
+
+        if (memoryUsageBytes > maxBytes) {
+            LOGV2_DEBUG(5212018,
+                        1,
+                        "Abandoning $lookup hash join because the foreign collection exceeds the "
+                        "memory limit",
+                        "namespace"_attr = _fromNs,
+                        "maxMemoryUsageBytes"_attr = maxBytes);
+            _hashJoinTable.reset();
+            _hashJoinDocs = std::vector<Document>();
+            return false;
+        }
+        _hashJoinDocs.push_back(std::move(*result));
+    }
+    _usedDisk = _usedDisk || pipeline->usedDisk();
+    return true;
+}
+
+boost::optional<std::vector<Value>> DocumentSourceLookUp::probeHashJoinTable(
+    const Document& inputDoc) {
+    std::vector<size_t> positions;
+    bool sawValue = false;
+    bool canProbe = true;
+    document_path_support::visitAllValuesAtPath(
+        inputDoc, *_localField, [&](const Value& localValue) {
+            sawValue = true;
+            if (!canProbe || !isHashJoinKeyType(localValue.getType())) {
+                canProbe = false;
+                return;
+            }
+            auto it = _hashJoinTable->find(localValue);
+            if (it != _hashJoinTable->end()) {
+                positions.insert(positions.end(), it->second.begin(), it->second.end());
+            }
+        });
+
+    // A missing local field matches foreign documents on null, which the table does not index.
+    if (!sawValue || !canProbe) {
+        return boost::none;
+    }
+
+    // Return the matches in the order the foreign documents were scanned, once each.
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+    std::vector<Value> results;
+    long long objsize = 0;
+    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+    for (auto position : positions) {
+        const auto& foreignDoc = _hashJoinDocs[position];
+        objsize += foreignDoc.getApproximateSize();
+        uassert(4568,
+                str::stream() << "Total size of documents in " << _fromNs.coll()
+                              << " matching pipeline's $lookup stage exceeds " << maxBytes
+                              << " bytes",
+                objsize <= maxBytes);
+        results.emplace_back(foreignDoc);
+    }
+    return results;
 }
 
 std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/pipeline/document_source.h"
@@ -106,6 +107,9 @@ public:
     DepsTracker::State getDependencies(DepsTracker* deps) const final;
 
     boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
+        if (canRunOnShards()) {
+            return boost::none;
+        }
         // {shardsStage, mergingStage, sortPattern}
         return DistributedPlanLogic{nullptr, this, boost::none};
     }
@@ -266,11 +270,66 @@ private:
      */
     std::unique_ptr<Pipeline, PipelineDeleter> buildPipeline(const Document& inputDoc);
 
+    /**
+     * Implements getNext() for the localField/foreignField syntax when no $unwind has been
+     * absorbed. Input documents are read in batches of up to
+     * 'internalLookupBatchedProbeMaxBatchSize', and the documents in a batch which the hash join
+     * cannot answer are joined using a single foreign query. The joined documents are buffered in
+     * '_batchedOutput' and returned in input order.
+     */
+    GetNextResult getNextBatched();
+
+    /**
+     * Runs the foreign pipeline for 'inputDoc' and returns the documents it produces.
+     */
+    std::vector<Value> lookUpWithForeignQuery(const Document& inputDoc);
+
+    /**
+     * Runs one foreign query matching the local values of all of 'inputDocs', and returns the
+     * foreign documents matching each of them, in the same order as 'inputDocs'. May only be
+     * called if this DSLookup was created with localField/foreignField syntax.
+     */
+    std::vector<std::vector<Value>> lookUpBatchWithForeignQuery(
+        const std::vector<const Document*>& inputDocs);
+
+    /**
+     * Attempts to compute the $lookup results for 'inputDoc' from a hash table built over the
+     * foreign collection, rather than by issuing a foreign query. The table is built once, after
+     * 'internalLookupHashJoinMinInputDocuments' input documents have been processed with foreign
+     * queries, and only if it fits in 'internalLookupHashJoinMaxMemoryBytes'. Returns boost::none
+     * if the caller must fall back to running the foreign query for this document. May only be
+     * called if this DSLookup was created with localField/foreignField syntax.
+     */
+    boost::optional<std::vector<Value>> lookUpWithHashJoin(const Document& inputDoc);
+
+    /**
+     * Runs the foreign pipeline without the join predicate and indexes the results by the values
+     * at '_foreignField'. Returns false, leaving no table behind, if the memory budget is exceeded.
+     */
+    bool buildHashJoinTable(const Document& inputDoc);
+
+    /**
+     * Returns the foreign documents whose '_foreignField' matches the '_localField' of 'inputDoc',
+     * or boost::none if 'inputDoc' has a local value which cannot be looked up in the hash table,
+     * such as null, a regex, an array or an object.
+     */
+    boost::optional<std::vector<Value>> probeHashJoinTable(const Document& inputDoc);
+
     /**
      * Reinitialize the cache with a new max size. May only be called if this DSLookup was created
      * with pipeline syntax, the cache has not been frozen or abandoned, and no data has been added
      * to it.
      */
+    /**
+     * Returns true if, with internalQueryPushLookupToShards set on mongos, this stage should run on
+     * each shard holding the local collection rather than on the merger: either the foreign
+     * collection is sharded on '_foreignField' with the same chunks as the local one on
+     * '_localField', so that the foreign query for each document targets the shard it is on, or
+     * the foreign collection is unsharded and small enough for each shard to scan it once and
+     * join against it in memory. The answer is computed once.
+     */
+    bool canRunOnShards() const;
+
     void reInitializeCache(size_t maxCacheSizeBytes) {
         invariant(wasConstructedWithPipelineSyntax());
         invariant(!_cache || (_cache->isBuilding() && _cache->sizeBytes() == 0));
@@ -278,6 +337,7 @@ private:
     }
 
     bool _usedDisk = false;
+    mutable boost::optional<bool> _canRunOnShards;
     NamespaceString _fromNs;
     NamespaceString _resolvedNs;
     FieldPath _as;
@@ -318,6 +378,20 @@ private:
     boost::intrusive_ptr<DocumentSourceMatch> _matchSrc;
     boost::intrusive_ptr<DocumentSourceUnwind> _unwindSrc;
 
+    // State of the hash join used for the localField/foreignField syntax. '_hashJoinDocs' holds the
+    // foreign documents, and '_hashJoinTable' maps each value found at '_foreignField' to the
+    // positions in '_hashJoinDocs' of the documents containing it, in ascending order.
+    enum class HashJoinState { kNotStarted, kBuilt, kAbandoned };
+    HashJoinState _hashJoinState = HashJoinState::kNotStarted;
+    long long _numInputDocsBeforeHashJoin = 0;
+    std::vector<Document> _hashJoinDocs;
+    boost::optional<ValueUnorderedMap<std::vector<size_t>>> _hashJoinTable;
+
+    // Joined documents of the current batch which have not yet been returned, and the pause or EOF
+    // which ended the batch, if any. See getNextBatched().
+    std::deque<Document> _batchedOutput;
+    boost::optional<GetNextResult> _batchedPendingResult;
+
     // The following members are used to hold onto state across getNext() calls when '_unwindSrc' is
     // not null.
     long long _cursorIndex = 0;
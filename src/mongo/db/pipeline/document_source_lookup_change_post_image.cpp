@@ -32,6 +32,8 @@
 #include "mongo/db/pipeline/document_source_lookup_change_post_image.h"
 
 #include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 
@@ -52,19 +54,32 @@ Value assertFieldHasType(const Document& fullDoc, StringData fieldName, BSONType
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceLookupChangePostImage::doGetNext() {
-    auto input = pSource->getNext();
-    if (!input.isAdvanced()) {
-        return input;
-    }
-    auto opTypeVal = assertFieldHasType(
-        input.getDocument(), DocumentSourceChangeStream::kOperationTypeField, BSONType::String);
-    if (opTypeVal.getString() != DocumentSourceChangeStream::kUpdateOpType) {
-        return input;
+    if (_bufferedEvents.empty()) {
+        if (_pendingResult) {
+            auto pending = std::move(*_pendingResult);
+            _pendingResult = boost::none;
+            return pending;
+        }
+
+        const auto batchSize =
+            static_cast<size_t>(internalChangeStreamPostImageLookupBatchSize.load());
+        while (_bufferedEvents.size() < batchSize) {
+            auto input = pSource->getNext();
+            if (!input.isAdvanced()) {
+                if (_bufferedEvents.empty()) {
+                    return input;
+                }
+                _pendingResult = std::move(input);
+                break;
+            }
+            _bufferedEvents.push_back(input.releaseDocument());
+        }
+        lookupPostImages();
     }
 
-    MutableDocument output(input.releaseDocument());
-    output[kFullDocumentFieldName] = lookupPostImage(output.peek());
-    return output.freeze();
+    auto next = std::move(_bufferedEvents.front());
+    _bufferedEvents.pop_front();
+    return next;
 }
 
 NamespaceString DocumentSourceLookupChangePostImage::assertValidNamespace(
@@ -88,41 +103,89 @@ NamespaceString DocumentSourceLookupChangePostImage::assertValidNamespace(
     return nss;
 }
 
-Value DocumentSourceLookupChangePostImage::lookupPostImage(const Document& updateOp) const {
-    // Make sure we have a well-formed input.
-    auto nss = assertValidNamespace(updateOp);
-
-    auto documentKey = assertFieldHasType(updateOp,
-                                          DocumentSourceChangeStream::kDocumentKeyField,
-                                          BSONType::Object)
-                           .getDocument();
-
-    // Extract the UUID from resume token and do change stream lookups by UUID.
-    auto resumeToken =
-        ResumeToken::parse(updateOp[DocumentSourceChangeStream::kIdField].getDocument());
-
-    const auto readConcern = pExpCtx->inMongos
-        ? boost::optional<BSONObj>(BSON("level"
-                                        << "majority"
-                                        << "afterClusterTime" << resumeToken.getData().clusterTime))
-        : boost::none;
-
-
-    // Update lookup queries sent from mongoS to shards are allowed to use speculative majority
-    // reads.
-    const auto allowSpeculativeMajorityRead = pExpCtx->inMongos;
-    invariant(resumeToken.getData().uuid);
-    auto lookedUpDoc =
-        pExpCtx->mongoProcessInterface->lookupSingleDocument(pExpCtx,
-                                                             nss,
-                                                             *resumeToken.getData().uuid,
-                                                             documentKey,
-                                                             readConcern,
-                                                             allowSpeculativeMajorityRead);
-
-    // Check whether the lookup returned any documents. Even if the lookup itself succeeded, it may
-    // not have returned any results if the document was deleted in the time since the update op.
-    return (lookedUpDoc ? Value(*lookedUpDoc) : Value(BSONNULL));
+void DocumentSourceLookupChangePostImage::lookupPostImages() {
+    // The updates to look up in a single collection. Updates to the same document share a lookup.
+    struct Lookup {
+        NamespaceString nss;
+        UUID uuid;
+        Timestamp clusterTime;
+        std::vector<Document> documentKeys;
+        BSONObjIndexedMap<size_t> keyIndexes =
+            SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<size_t>();
+        std::vector<std::pair<size_t, size_t>> eventKeys;
+    };
+    std::vector<Lookup> lookups;
+
+    for (size_t i = 0; i < _bufferedEvents.size(); ++i) {
+        const auto& event = _bufferedEvents[i];
+        auto opTypeVal = assertFieldHasType(
+            event, DocumentSourceChangeStream::kOperationTypeField, BSONType::String);
+        if (opTypeVal.getString() != DocumentSourceChangeStream::kUpdateOpType) {
+            continue;
+        }
+
+        // Make sure we have a well-formed input.
+        auto nss = assertValidNamespace(event);
+
+        auto documentKey = assertFieldHasType(event,
+                                              DocumentSourceChangeStream::kDocumentKeyField,
+                                              BSONType::Object)
+                               .getDocument();
+
+        // Extract the UUID from resume token and do change stream lookups by UUID.
+        auto resumeToken =
+            ResumeToken::parse(event[DocumentSourceChangeStream::kIdField].getDocument());
+        invariant(resumeToken.getData().uuid);
+        const auto& uuid = *resumeToken.getData().uuid;
+
+        auto lookup = std::find_if(lookups.begin(), lookups.end(), [&](const Lookup& lookup) {
+            return lookup.uuid == uuid && lookup.nss == nss;
+        });
+        if (lookup == lookups.end()) {
+            lookups.push_back({nss, uuid, resumeToken.getData().clusterTime});
+            lookup = std::prev(lookups.end());
+        }
+        lookup->clusterTime = std::max(lookup->clusterTime, resumeToken.getData().clusterTime);
+
+        auto keyIndex =
+            lookup->keyIndexes.emplace(documentKey.toBson(), lookup->documentKeys.size());
+        if (keyIndex.second) {
+            lookup->documentKeys.push_back(std::move(documentKey));
+        }
+        lookup->eventKeys.emplace_back(i, keyIndex.first->second);
+    }
+
+    for (auto&& lookup : lookups) {
+        // Reading at the latest cluster time in the batch is as recent as reading each document at
+        // the cluster time of its own update.
+        const auto readConcern = pExpCtx->inMongos
+            ? boost::optional<BSONObj>(BSON("level"
+                                            << "majority"
+                                            << "afterClusterTime" << lookup.clusterTime))
+            : boost::none;
+
+        // Update lookup queries sent from mongoS to shards are allowed to use speculative majority
+        // reads.
+        const auto allowSpeculativeMajorityRead = pExpCtx->inMongos;
+        auto lookedUpDocs =
+            pExpCtx->mongoProcessInterface->lookupDocuments(pExpCtx,
+                                                            lookup.nss,
+                                                            lookup.uuid,
+                                                            lookup.documentKeys,
+                                                            readConcern,
+                                                            allowSpeculativeMajorityRead);
+        invariant(lookedUpDocs.size() == lookup.documentKeys.size());
+
+        // Check whether the lookup returned any documents. Even if the lookup itself succeeded, it
+        // may not have returned any results if the document was deleted in the time since the
+        // update op.
+        for (auto&& [eventIndex, keyIndex] : lookup.eventKeys) {
+            auto& lookedUpDoc = lookedUpDocs[keyIndex];
+            MutableDocument output(std::move(_bufferedEvents[eventIndex]));
+            output[kFullDocumentFieldName] = lookedUpDoc ? Value(*lookedUpDoc) : Value(BSONNULL);
+            _bufferedEvents[eventIndex] = output.freeze();
+        }
+    }
 }
 
 }  // namespace mongo
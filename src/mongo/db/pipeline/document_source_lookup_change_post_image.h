@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 
@@ -37,6 +39,11 @@ namespace mongo {
 /**
  * Part of the change stream API machinery used to look up the post-image of a document. Uses the
  * "documentKey" field of the input to look up the new version of the document.
+ *
+ * Events which are already available from the source are buffered, up to
+ * 'internalChangeStreamPostImageLookupBatchSize' of them, so that the post-images of all the
+ * updates among them can be looked up together. Every lookup still happens after its event was
+ * read, so it observes the document as of that event or later, just as a lookup per event would.
  */
 class DocumentSourceLookupChangePostImage final : public DocumentSource {
 public:
@@ -110,15 +117,17 @@ private:
         : DocumentSource(kStageName, expCtx) {}
 
     /**
-     * Performs the lookup to retrieve the full document.
+     * Returns the next buffered event, refilling the buffer and performing the lookups to retrieve
+     * the full documents once it is empty.
      */
     GetNextResult doGetNext() final;
 
     /**
-     * Uses the "documentKey" field from 'updateOp' to look up the current version of the document.
-     * Returns Value(BSONNULL) if the document couldn't be found.
+     * Uses the "documentKey" field of each update in '_bufferedEvents' to look up the current
+     * version of its document, one lookup per namespace, and stores it in the event's
+     * "fullDocument" field. Stores Value(BSONNULL) if the document couldn't be found.
      */
-    Value lookupPostImage(const Document& updateOp) const;
+    void lookupPostImages();
 
     /**
      * Throws a AssertionException if the namespace found in 'inputDoc' doesn't match the one on the
@@ -126,6 +135,14 @@ private:
      * function verifies that the only the database names match.
      */
     NamespaceString assertValidNamespace(const Document& inputDoc) const;
+
+    // Events read from the source whose post-images have been looked up, but which have not yet
+    // been returned.
+    std::deque<Document> _bufferedEvents;
+
+    // A non-advanced result which ended the last batch, to be returned once '_bufferedEvents' has
+    // been drained.
+    boost::optional<GetNextResult> _pendingResult;
 };
 
 }  // namespace mongo
@@ -54,6 +54,28 @@ using std::vector;
 
 using MockMongoInterface = StubLookupSingleDocumentProcessInterface;
 
+/**
+ * Records the number of document keys passed to each lookupDocuments() call.
+ */
+class BatchRecordingMongoInterface final : public MockMongoInterface {
+public:
+    using MockMongoInterface::MockMongoInterface;
+
+    std::vector<boost::optional<Document>> lookupDocuments(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const NamespaceString& nss,
+        UUID collectionUUID,
+        const std::vector<Document>& documentKeys,
+        boost::optional<BSONObj> readConcern,
+        bool allowSpeculativeMajorityRead) final {
+        batchSizes.push_back(documentKeys.size());
+        return MockMongoInterface::lookupDocuments(
+            expCtx, nss, collectionUUID, documentKeys, readConcern, allowSpeculativeMajorityRead);
+    }
+
+    std::vector<size_t> batchSizes;
+};
+
 // This provides access to getExpCtx(), but we'll use a different name for this test suite.
 class DocumentSourceLookupChangePostImageTest : public AggregationContextFixture {
 public:
@@ -324,5 +346,58 @@ TEST_F(DocumentSourceLookupChangePostImageTest, ShouldPropagatePauses) {
     ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceLookupChangePostImageTest, ShouldLookUpAvailableUpdatesTogether) {
+    auto expCtx = getExpCtx();
+    const auto ns = Document{{"db", expCtx->ns.db()}, {"coll", expCtx->ns.coll()}};
+    auto makeUpdate = [&](int id) {
+        return Document{{"_id", makeResumeToken(id)},
+                        {"documentKey", Document{{"_id", id}}},
+                        {"operationType", "update"_sd},
+                        {"ns", ns}};
+    };
+
+    auto lookupChangeStage = DocumentSourceLookupChangePostImage::create(expCtx);
+    auto mockLocalSource = DocumentSourceMock::createForTest(
+        {makeUpdate(0),
+         Document{{"_id", makeResumeToken(1)},
+                  {"documentKey", Document{{"_id", 1}}},
+                  {"operationType", "insert"_sd},
+                  {"ns", ns},
+                  {"fullDocument", Document{{"_id", 1}}}},
+         makeUpdate(2),
+         makeUpdate(0),
+         makeUpdate(3),
+         DocumentSource::GetNextResult::makePauseExecution(),
+         makeUpdate(2)});
+    lookupChangeStage->setSource(mockLocalSource.get());
+
+    // Document 3 has been deleted since its update.
+    deque<DocumentSource::GetNextResult> mockForeignContents{
+        Document{{"_id", 0}, {"x", 0}}, Document{{"_id", 1}}, Document{{"_id", 2}, {"x", 2}}};
+    auto mongoInterface =
+        std::make_unique<BatchRecordingMongoInterface>(std::move(mockForeignContents));
+    auto recordingInterface = mongoInterface.get();
+    expCtx->mongoProcessInterface = std::move(mongoInterface);
+
+    auto assertNextHasFullDocument = [&](Value fullDocument) {
+        auto next = lookupChangeStage->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_VALUE_EQ(next.getDocument()["fullDocument"], fullDocument);
+    };
+    assertNextHasFullDocument(Value(Document{{"_id", 0}, {"x", 0}}));
+    assertNextHasFullDocument(Value(Document{{"_id", 1}}));
+    assertNextHasFullDocument(Value(Document{{"_id", 2}, {"x", 2}}));
+    assertNextHasFullDocument(Value(Document{{"_id", 0}, {"x", 0}}));
+    assertNextHasFullDocument(Value(BSONNULL));
+
+    // The four updates before the pause needed only three distinct lookups, made together.
+    ASSERT(recordingInterface->batchSizes == std::vector<size_t>{3});
+
+    ASSERT_TRUE(lookupChangeStage->getNext().isPaused());
+    assertNextHasFullDocument(Value(Document{{"_id", 2}, {"x", 2}}));
+    ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
+    ASSERT(recordingInterface->batchSizes == (std::vector<size_t>{3, 1}));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -48,6 +48,7 @@
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/server_options.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -569,6 +570,84 @@ TEST_F(DocumentSourceLookUpTest, ShouldPropagatePauses) {
     lookup->dispose();
 }
 
+/**
+ * Runs a localField/foreignField $lookup of a fixed set of local documents against a fixed foreign
+ * collection, switching to the hash join after the first local document when the memory budget
+ * allows it, and joining up to 'maxBatchSize' local documents per foreign query otherwise. Asserts
+ * that the results match those of the per-document foreign queries.
+ */
+void assertLookUpResultsMatchNestedLoop(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                        long long maxMemoryBytes,
+                                        int maxBatchSize) {
+    const auto oldMinInputDocs = internalLookupHashJoinMinInputDocuments.load();
+    const auto oldMaxMemoryBytes = internalLookupHashJoinMaxMemoryBytes.load();
+    const auto oldMaxBatchSize = internalLookupBatchedProbeMaxBatchSize.load();
+    internalLookupHashJoinMinInputDocuments.store(1);
+    internalLookupHashJoinMaxMemoryBytes.store(maxMemoryBytes);
+    internalLookupBatchedProbeMaxBatchSize.store(maxBatchSize);
+    ON_BLOCK_EXIT([&] {
+        internalLookupHashJoinMinInputDocuments.store(oldMinInputDocs);
+        internalLookupHashJoinMaxMemoryBytes.store(oldMaxMemoryBytes);
+        internalLookupBatchedProbeMaxBatchSize.store(oldMaxBatchSize);
+    });
+
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    auto mockLocalSource = DocumentSourceMock::createForTest({Document{{"k", 1}},
+                                                              Document{{"k", 1}},
+                                                              Document{{"k", 2.0}},
+                                                              Document{{"k", "x"_sd}},
+                                                              Document{{"k", BSONNULL}},
+                                                              Document{{"k", 3}},
+                                                              Document{},
+                                                              Document{{"k", BSONRegEx("x")}}});
+    expCtx->mongoProcessInterface =
+        std::make_shared<MockMongoInterface>(deque<DocumentSource::GetNextResult>{
+            Document{{"_id", 0}, {"k", 1}},
+            Document{{"_id", 1}, {"k", vector<Value>{Value(1), Value(2)}}},
+            Document{{"_id", 2}, {"k", "x"_sd}},
+            Document{{"_id", 3}}});
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "k"_sd},
+                                         {"foreignField", "k"_sd},
+                                         {"as", "ids"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+    lookup->setSource(mockLocalSource.get());
+
+    const std::vector<std::vector<int>> expectedIds{{0, 1}, {0, 1}, {1}, {2}, {3}, {}, {3}, {}};
+    for (auto&& ids : expectedIds) {
+        auto next = lookup->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        auto foreignDocs = next.releaseDocument()["ids"].getArray();
+        ASSERT_EQ(foreignDocs.size(), ids.size());
+        for (size_t i = 0; i < ids.size(); ++i) {
+            ASSERT_VALUE_EQ(foreignDocs[i]["_id"], Value(ids[i]));
+        }
+    }
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    lookup->dispose();
+}
+
+TEST_F(DocumentSourceLookUpTest, HashJoinMatchesPerDocumentForeignQueries) {
+    assertLookUpResultsMatchNestedLoop(getExpCtx(), 100 * 1024 * 1024, 1);
+}
+
+TEST_F(DocumentSourceLookUpTest, HashJoinFallsBackToForeignQueriesWhenOverMemoryLimit) {
+    assertLookUpResultsMatchNestedLoop(getExpCtx(), 1, 1);
+}
+
+TEST_F(DocumentSourceLookUpTest, BatchedForeignQueryMatchesPerDocumentForeignQueries) {
+    assertLookUpResultsMatchNestedLoop(getExpCtx(), 1, 3);
+    assertLookUpResultsMatchNestedLoop(getExpCtx(), 1, 100);
+    assertLookUpResultsMatchNestedLoop(getExpCtx(), 100 * 1024 * 1024, 100);
+}
+
 TEST_F(DocumentSourceLookUpTest, ShouldPropagatePausesWhileUnwinding) {
     auto expCtx = getExpCtx();
     NamespaceString fromNs("test", "foreign");
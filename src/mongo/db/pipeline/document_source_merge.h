@@ -214,15 +214,16 @@ private:
         return bob.obj();
     }
 
-    void spill(BatchedObjects&& batch) override {
-        DocumentSourceWriteBlock writeBlock(pExpCtx->opCtx);
+    void spill(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+               BatchedObjects&& batch) override {
+        DocumentSourceWriteBlock writeBlock(expCtx->opCtx);
 
         try {
             auto targetEpoch = _targetCollectionVersion
                 ? boost::optional<OID>(_targetCollectionVersion->epoch())
                 : boost::none;
 
-            _descriptor.strategy(pExpCtx, _outputNs, _writeConcern, targetEpoch, std::move(batch));
+            _descriptor.strategy(expCtx, _outputNs, _writeConcern, targetEpoch, std::move(batch));
         } catch (const ExceptionFor<ErrorCodes::ImmutableField>& ex) {
             uassertStatusOKWithContext(ex.toStatus(),
                                        "$merge failed to update the matching document, did you "
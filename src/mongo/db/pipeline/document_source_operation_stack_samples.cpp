@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_operation_stack_samples.h"
+
+#include "mongo/util/hex.h"
+#include "mongo/util/stacktrace.h"
+
+#ifndef _WIN32
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+namespace mongo {
+
+REGISTER_DOCUMENT_SOURCE(operationStackSamples,
+                         DocumentSourceOperationStackSamples::LiteParsed::parse,
+                         DocumentSourceOperationStackSamples::createFromBson);
+
+namespace {
+
+/**
+ * Describes a sampled frame as its demangled symbol, or failing that its file, plus the offset of
+ * the address into it.
+ */
+class FrameSymbolizer {
+public:
+    FrameSymbolizer() = default;
+    FrameSymbolizer(const FrameSymbolizer&) = delete;
+    FrameSymbolizer& operator=(const FrameSymbolizer&) = delete;
+
+    ~FrameSymbolizer() {
+        free(_demangleBuf);
+    }
+
+    std::string operator()(void* address) {
+        std::string frame;
+#ifndef _WIN32
+        const auto& meta = _metaGen.load(address);
+        uintptr_t base = 0;
+        if (meta.symbol()) {
+            std::string name = meta.symbol().name().toString();
+            int status = 0;
+            if (char* demangled =
+                    abi::__cxa_demangle(name.c_str(), _demangleBuf, &_demangleBufSize, &status)) {
+                _demangleBuf = demangled;
+                name = demangled;
+            }
+            frame = std::move(name);
+            base = meta.symbol().base();
+        } else if (meta.file()) {
+            frame = meta.file().name().toString();
+            base = meta.file().base();
+        }
+        if (base) {
+            return frame + "+0x" + integerToHex<unsigned long long>(meta.address() - base);
+        }
+#endif
+        return "0x" + integerToHex<unsigned long long>(reinterpret_cast<std::uintptr_t>(address));
+    }
+
+private:
+#ifndef _WIN32
+    StackTraceAddressMetadataGenerator _metaGen;
+#endif
+    char* _demangleBuf = nullptr;
+    size_t _demangleBufSize = 0;
+};
+
+}  // namespace
+
+DocumentSource::GetNextResult DocumentSourceOperationStackSamples::doGetNext() {
+    if (_samples.empty()) {
+        return GetNextResult::makeEOF();
+    }
+
+    const auto samples = std::move(_samples.back());
+    _samples.pop_back();
+
+    FrameSymbolizer symbolize;
+    BSONObjBuilder bob;
+    bob.append("command", samples.command);
+    if (samples.queryHash) {
+        bob.append("queryHash", unsignedIntToFixedLengthHex(*samples.queryHash));
+    }
+    bob.append("samples", samples.count);
+    BSONArrayBuilder stack(bob.subarrayStart("stack"));
+    for (auto address : samples.frames) {
+        stack.append(symbolize(address));
+    }
+    stack.done();
+    return Document(bob.obj());
+}
+
+boost::intrusive_ptr<DocumentSource> DocumentSourceOperationStackSamples::createFromBson(
+    BSONElement spec, const boost::intrusive_ptr<ExpressionContext>& pExpCtx) {
+    uassert(ErrorCodes::InvalidNamespace,
+            str::stream() << kStageName
+                          << " must be run against the 'admin' database with {aggregate: 1}",
+            pExpCtx->ns.db() == NamespaceString::kAdminDb &&
+                pExpCtx->ns.isCollectionlessAggregateNS());
+
+    uassert(ErrorCodes::BadValue,
+            str::stream() << kStageName << " must be run as { " << kStageName << ": {}}",
+            spec.isABSONObj() && spec.Obj().isEmpty());
+
+    return new DocumentSourceOperationStackSamples(pExpCtx);
+}
+
+DocumentSourceOperationStackSamples::DocumentSourceOperationStackSamples(
+    const boost::intrusive_ptr<ExpressionContext>& pExpCtx)
+    : DocumentSource(kStageName, pExpCtx),
+      _samples(OperationStackSampler::get(pExpCtx->opCtx->getServiceContext())->getSamples()) {
+    // Emit the most sampled stacks first.
+    std::sort(_samples.begin(), _samples.end(), [](const auto& left, const auto& right) {
+        return left.count < right.count;
+    });
+}
+
+}  // namespace mongo
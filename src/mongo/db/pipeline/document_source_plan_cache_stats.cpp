@@ -44,27 +44,38 @@ boost::intrusive_ptr<DocumentSource> DocumentSourcePlanCacheStats::createFromBso
                           << " value must be an object. Found: " << typeName(spec.type()),
             spec.type() == BSONType::Object);
 
-    uassert(ErrorCodes::FailedToParse,
-            str::stream() << kStageName
-                          << " parameters object must be empty. Found: " << typeName(spec.type()),
-            spec.embeddedObject().isEmpty());
+    bool partitions = false;
+    for (auto&& elem : spec.embeddedObject()) {
+        uassert(ErrorCodes::FailedToParse,
+                str::stream() << kStageName << " parameters object may only contain the '"
+                              << kPartitionsFieldName << "' option. Found: " << elem.fieldName(),
+                elem.fieldNameStringData() == kPartitionsFieldName);
+        uassert(ErrorCodes::FailedToParse,
+                str::stream() << kStageName << " '" << kPartitionsFieldName
+                              << "' option must be a boolean. Found: " << typeName(elem.type()),
+                elem.type() == BSONType::Bool);
+        partitions = elem.boolean();
+    }
 
-    return new DocumentSourcePlanCacheStats(pExpCtx);
+    return new DocumentSourcePlanCacheStats(pExpCtx, partitions);
 }
 
 DocumentSourcePlanCacheStats::DocumentSourcePlanCacheStats(
-    const boost::intrusive_ptr<ExpressionContext>& expCtx)
-    : DocumentSource(kStageName, expCtx) {}
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, bool partitions)
+    : DocumentSource(kStageName, expCtx), _partitions(partitions) {}
 
 void DocumentSourcePlanCacheStats::serializeToArray(
     std::vector<Value>& array, boost::optional<ExplainOptions::Verbosity> explain) const {
+    const Value partitions = _partitions ? Value{true} : Value{};
     if (explain) {
         array.push_back(Value{
             Document{{kStageName,
-                      Document{{"match"_sd,
+                      Document{{kPartitionsFieldName, partitions},
+                               {"match"_sd,
                                 _absorbedMatch ? Value{_absorbedMatch->getQuery()} : Value{}}}}}});
     } else {
-        array.push_back(Value{Document{{kStageName, Document{}}}});
+        array.push_back(
+            Value{Document{{kStageName, Document{{kPartitionsFieldName, partitions}}}}});
         if (_absorbedMatch) {
             _absorbedMatch->serializeToArray(array);
         }
@@ -90,8 +101,11 @@ Pipeline::SourceContainer::iterator DocumentSourcePlanCacheStats::doOptimizeAt(
 DocumentSource::GetNextResult DocumentSourcePlanCacheStats::doGetNext() {
     if (!_haveRetrievedStats) {
         const auto matchExpr = _absorbedMatch ? _absorbedMatch->getMatchExpression() : nullptr;
-        _results = pExpCtx->mongoProcessInterface->getMatchingPlanCacheEntryStats(
-            pExpCtx->opCtx, pExpCtx->ns, matchExpr);
+        _results = _partitions
+            ? pExpCtx->mongoProcessInterface->getMatchingPlanCachePartitionStats(
+                  pExpCtx->opCtx, pExpCtx->ns, matchExpr)
+            : pExpCtx->mongoProcessInterface->getMatchingPlanCacheEntryStats(
+                  pExpCtx->opCtx, pExpCtx->ns, matchExpr);
 
         _resultsIter = _results.begin();
         _haveRetrievedStats = true;
@@ -101,6 +115,7 @@ DocumentSource::GetNextResult DocumentSourcePlanCacheStats::doGetNext() {
         return GetNextResult::makeEOF();
     }
 
+    // Partition documents are augmented with the host and shard in the same way as entries.
     MutableDocument nextPlanCacheEntry{Document{*_resultsIter++}};
 
     // Augment each plan cache entry with this node's host and port string.
@@ -37,6 +37,7 @@ namespace mongo {
 class DocumentSourcePlanCacheStats final : public DocumentSource {
 public:
     static constexpr StringData kStageName = "$planCacheStats"_sd;
+    static constexpr StringData kPartitionsFieldName = "partitions"_sd;
 
     class LiteParsed final : public LiteParsedDocumentSource {
     public:
@@ -119,7 +120,8 @@ public:
         boost::optional<ExplainOptions::Verbosity> explain = boost::none) const override;
 
 private:
-    DocumentSourcePlanCacheStats(const boost::intrusive_ptr<ExpressionContext>& expCtx);
+    DocumentSourcePlanCacheStats(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                 bool partitions);
 
     GetNextResult doGetNext() final;
 
@@ -136,6 +138,10 @@ private:
     // be appended to each plan cache entry document.
     std::string _hostAndPort;
 
+    // Set by the 'partitions' option: produce one document per plan cache partition describing
+    // its counters, rather than one document per plan cache entry.
+    const bool _partitions;
+
     // The result set for this change is produced through the mongo process interface on the first
     // call to getNext(), and then held by this data member.
     std::vector<BSONObj> _results;
@@ -46,23 +46,22 @@ using DocumentSourcePlanCacheStatsTest = AggregationContextFixture;
  */
 class PlanCacheStatsMongoProcessInterface final : public StubMongoProcessInterface {
 public:
-    PlanCacheStatsMongoProcessInterface(std::vector<BSONObj> planCacheStats)
-        : _planCacheStats(std::move(planCacheStats)) {}
+    PlanCacheStatsMongoProcessInterface(std::vector<BSONObj> planCacheStats,
+                                        std::vector<BSONObj> partitionStats = {})
+        : _planCacheStats(std::move(planCacheStats)), _partitionStats(std::move(partitionStats)) {}
 
     std::vector<BSONObj> getMatchingPlanCacheEntryStats(
         OperationContext* opCtx,
         const NamespaceString& nss,
         const MatchExpression* matchExpr) const override {
-        if (!matchExpr) {
-            return _planCacheStats;
-        }
+        return filter(_planCacheStats, matchExpr);
+    }
 
-        std::vector<BSONObj> filteredStats{};
-        std::copy_if(_planCacheStats.begin(),
-                     _planCacheStats.end(),
-                     std::back_inserter(filteredStats),
-                     [&matchExpr](const BSONObj& obj) { return matchExpr->matchesBSON(obj); });
-        return filteredStats;
+    std::vector<BSONObj> getMatchingPlanCachePartitionStats(
+        OperationContext* opCtx,
+        const NamespaceString& nss,
+        const MatchExpression* matchExpr) const override {
+        return filter(_partitionStats, matchExpr);
     }
 
     std::string getShardName(OperationContext* opCtx) const override {
@@ -74,7 +73,22 @@ public:
     }
 
 private:
+    static std::vector<BSONObj> filter(const std::vector<BSONObj>& stats,
+                                       const MatchExpression* matchExpr) {
+        if (!matchExpr) {
+            return stats;
+        }
+
+        std::vector<BSONObj> filteredStats{};
+        std::copy_if(stats.begin(),
+                     stats.end(),
+                     std::back_inserter(filteredStats),
+                     [&matchExpr](const BSONObj& obj) { return matchExpr->matchesBSON(obj); });
+        return filteredStats;
+    }
+
     std::vector<BSONObj> _planCacheStats;
+    std::vector<BSONObj> _partitionStats;
 };
 
 TEST_F(DocumentSourcePlanCacheStatsTest, ShouldFailToParseIfSpecIsNotObject) {
@@ -93,6 +107,23 @@ TEST_F(DocumentSourcePlanCacheStatsTest, ShouldFailToParseIfSpecIsANonEmptyObjec
         ErrorCodes::FailedToParse);
 }
 
+TEST_F(DocumentSourcePlanCacheStatsTest, ShouldFailToParseIfPartitionsIsNotBoolean) {
+    const auto specObj = fromjson("{$planCacheStats: {partitions: 1}}");
+    ASSERT_THROWS_CODE(
+        DocumentSourcePlanCacheStats::createFromBson(specObj.firstElement(), getExpCtx()),
+        AssertionException,
+        ErrorCodes::FailedToParse);
+}
+
+TEST_F(DocumentSourcePlanCacheStatsTest, CanParseAndSerializePartitionsSuccessfully) {
+    const auto specObj = fromjson("{$planCacheStats: {partitions: true}}");
+    auto stage = DocumentSourcePlanCacheStats::createFromBson(specObj.firstElement(), getExpCtx());
+    std::vector<Value> serialized;
+    stage->serializeToArray(serialized);
+    ASSERT_EQ(1u, serialized.size());
+    ASSERT_BSONOBJ_EQ(specObj, serialized[0].getDocument().toBson());
+}
+
 TEST_F(DocumentSourcePlanCacheStatsTest, CanParseAndSerializeSuccessfully) {
     const auto specObj = fromjson("{$planCacheStats: {}}");
     auto stage = DocumentSourcePlanCacheStats::createFromBson(specObj.firstElement(), getExpCtx());
@@ -241,4 +272,25 @@ TEST_F(DocumentSourcePlanCacheStatsTest, ReturnsShardAndHostNameWhenFromMongos)
     ASSERT(!pipeline->getNext());
 }
 
+TEST_F(DocumentSourcePlanCacheStatsTest, ReturnsPartitionStatsWhenRequested) {
+    std::vector<BSONObj> entryStats{BSON("foo"
+                                         << "bar")};
+    std::vector<BSONObj> partitionStats{BSON("partition" << 0 << "numEntries" << 3),
+                                        BSON("partition" << 1 << "numEntries" << 0)};
+    getExpCtx()->mongoProcessInterface =
+        std::make_shared<PlanCacheStatsMongoProcessInterface>(entryStats, partitionStats);
+
+    const auto specObj = fromjson("{$planCacheStats: {partitions: true}}");
+    auto planCacheStats =
+        DocumentSourcePlanCacheStats::createFromBson(specObj.firstElement(), getExpCtx());
+    auto match = DocumentSourceMatch::create(fromjson("{numEntries: {$gt: 0}}"), getExpCtx());
+    auto pipeline = Pipeline::create({planCacheStats, match}, getExpCtx());
+    pipeline->optimizePipeline();
+
+    ASSERT_BSONOBJ_EQ(pipeline->getNext()->toBson(),
+                      BSON("partition" << 0 << "numEntries" << 3 << "host"
+                                       << "testHostName"));
+    ASSERT(!pipeline->getNext());
+}
+
 }  // namespace mongo
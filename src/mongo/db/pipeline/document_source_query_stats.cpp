@@ -0,0 +1,96 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_query_stats.h"
+
+#include "mongo/util/hex.h"
+
+namespace mongo {
+
+REGISTER_DOCUMENT_SOURCE(queryStats,
+                         DocumentSourceQueryStats::LiteParsed::parse,
+                         DocumentSourceQueryStats::createFromBson);
+
+DocumentSource::GetNextResult DocumentSourceQueryStats::doGetNext() {
+    if (_entries.empty()) {
+        return GetNextResult::makeEOF();
+    }
+
+    const auto entry = std::move(_entries.back());
+    _entries.pop_back();
+
+    BSONObjBuilder bob;
+    bob.append("ns", entry.ns);
+    bob.append("queryHash", unsignedIntToFixedLengthHex(entry.queryHash));
+    bob.append("execCount", entry.execCount);
+    bob.append("totalExecMicros", entry.totalExecMicros);
+    bob.append("maxExecMicros", entry.maxExecMicros);
+    {
+        BSONObjBuilder percentiles(bob.subobjStart("execMicrosPercentiles"));
+        percentiles.append("p50", entry.latencyPercentileMicros(0.5));
+        percentiles.append("p95", entry.latencyPercentileMicros(0.95));
+        percentiles.append("p99", entry.latencyPercentileMicros(0.99));
+    }
+    bob.append("docsExamined", entry.docsExamined);
+    bob.append("keysExamined", entry.keysExamined);
+    bob.append("nreturned", entry.nreturned);
+    bob.append("bytesReturned", entry.bytesReturned);
+    bob.append("firstSeen", entry.firstSeen);
+    bob.append("lastSeen", entry.lastSeen);
+    return Document(bob.obj());
+}
+
+boost::intrusive_ptr<DocumentSource> DocumentSourceQueryStats::createFromBson(
+    BSONElement spec, const boost::intrusive_ptr<ExpressionContext>& pExpCtx) {
+    uassert(ErrorCodes::InvalidNamespace,
+            str::stream() << kStageName
+                          << " must be run against the 'admin' database with {aggregate: 1}",
+            pExpCtx->ns.db() == NamespaceString::kAdminDb &&
+                pExpCtx->ns.isCollectionlessAggregateNS());
+
+    uassert(ErrorCodes::BadValue,
+            str::stream() << kStageName << " must be run as { " << kStageName << ": {}}",
+            spec.isABSONObj() && spec.Obj().isEmpty());
+
+    return new DocumentSourceQueryStats(pExpCtx);
+}
+
+DocumentSourceQueryStats::DocumentSourceQueryStats(
+    const boost::intrusive_ptr<ExpressionContext>& pExpCtx)
+    : DocumentSource(kStageName, pExpCtx),
+      _entries(QueryShapeStats::get(pExpCtx->opCtx->getServiceContext())->getEntries()) {
+    // Emit the shapes that took the most time first.
+    std::sort(_entries.begin(), _entries.end(), [](const auto& left, const auto& right) {
+        return left.totalExecMicros < right.totalExecMicros;
+    });
+}
+
+}  // namespace mongo
@@ -37,6 +37,7 @@
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_skip.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
@@ -90,7 +91,7 @@ DocumentSource::GetNextResult DocumentSourceSort::doGetNext() {
         return GetNextResult::makeEOF();
     }
 
-    return GetNextResult{_sortExecutor->getNext().second};
+    return GetNextResult{_sortExecutor->getNext()};
 }
 
 void DocumentSourceSort::serializeToArray(
@@ -169,6 +170,12 @@ Pipeline::SourceContainer::iterator DocumentSourceSort::doOptimizeAt(
         _sortExecutor->setLimit(*limit);
     }
 
+    if (auto nextItr = std::next(itr); nextItr != container->end()) {
+        if (auto group = dynamic_cast<DocumentSourceGroup*>(nextItr->get())) {
+            group->setInputSortPattern(_sortExecutor->sortPattern());
+        }
+    }
+
     return std::next(itr);
 }
 
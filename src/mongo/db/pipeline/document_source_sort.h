@@ -149,7 +149,8 @@ public:
 protected:
     GetNextResult doGetNext() final;
     /**
-     * Attempts to absorb a subsequent $limit stage so that it can perform a top-k sort.
+     * Attempts to absorb a subsequent $limit stage so that it can perform a top-k sort, and tells a
+     * subsequent $group the order of its input.
      */
     Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
                                                      Pipeline::SourceContainer* container) final;
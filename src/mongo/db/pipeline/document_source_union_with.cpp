@@ -30,14 +30,21 @@
 
 #include "mongo/platform/basic.h"
 
+#include <deque>
 #include <iterator>
 
+#include "mongo/db/client.h"
 #include "mongo/db/commands/test_commands_enabled.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/document_source_union_with.h"
 #include "mongo/db/pipeline/document_source_union_with_gen.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/repl/read_concern_args.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 
 namespace mongo {
 
@@ -80,6 +87,155 @@ std::unique_ptr<Pipeline, PipelineDeleter> buildPipelineFromViewDefinition(
 
 }  // namespace
 
+class DocumentSourceUnionWith::Prefetcher {
+public:
+    /**
+     * Starts a thread which attaches a cursor source to 'pipeline' and reads from it until at
+     * least 'maxBufferBytes' worth of documents are waiting to be returned by getNext().
+     */
+    Prefetcher(std::shared_ptr<MongoProcessInterface> processInterface,
+               std::unique_ptr<Pipeline, PipelineDeleter> pipeline,
+               const repl::ReadConcernArgs& readConcern,
+               size_t maxBufferBytes)
+        : _processInterface(std::move(processInterface)),
+          _pipeline(std::move(pipeline)),
+          _maxBufferBytes(maxBufferBytes) {
+        _thread = stdx::thread([this, readConcern] { run(readConcern); });
+    }
+
+    ~Prefetcher() {
+        shutdown();
+    }
+
+    /**
+     * Blocks until the next result of the sub-pipeline is available and returns it, or returns
+     * boost::none once the sub-pipeline is exhausted. Throws if the sub-pipeline failed.
+     */
+    boost::optional<Document> getNext(OperationContext* opCtx) {
+        stdx::unique_lock<Latch> lk(_mutex);
+        opCtx->waitForConditionOrInterrupt(_cv, lk, [&] { return !_buffer.empty() || _done; });
+        if (_buffer.empty()) {
+            uassertStatusOK(_status);
+            return boost::none;
+        }
+
+        auto [next, size] = std::move(_buffer.front());
+        _buffer.pop_front();
+        _bufferedBytes -= size;
+        _cv.notify_all();
+        return std::move(next);
+    }
+
+    /**
+     * Interrupts the prefetching thread and waits for it to dispose of the sub-pipeline.
+     */
+    void shutdown() {
+        if (!_thread.joinable()) {
+            return;
+        }
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _shutdown = true;
+            if (_opCtx) {
+                stdx::lock_guard<Client> clientLock(*_opCtx->getClient());
+                _opCtx->getServiceContext()->killOperation(clientLock, _opCtx);
+            }
+            _cv.notify_all();
+        }
+        _thread.join();
+    }
+
+    /**
+     * Only meaningful once shutdown() has returned.
+     */
+    bool usedDisk() const {
+        return _usedDisk;
+    }
+
+private:
+    void run(const repl::ReadConcernArgs& readConcern) {
+        Client::initThread("UnionWithPrefetch");
+        auto opCtx = cc().makeOperationContext();
+        repl::ReadConcernArgs::get(opCtx.get()) = readConcern;
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (_shutdown) {
+                opCtx->markKilled();
+            }
+            _opCtx = opCtx.get();
+        }
+
+        Status status = Status::OK();
+        try {
+            auto ctx = _pipeline->getContext();
+            _pipeline->reattachToOperationContext(opCtx.get());
+            _pipeline = _processInterface->attachCursorSourceToPipeline(ctx, _pipeline.release());
+            LOGV2_DEBUG(
+                5212019, 3, "$unionWith attached cursor to pipeline on the prefetching thread");
+
+            while (auto next = _pipeline->getNext()) {
+                const auto size = next->getApproximateSize();
+                stdx::unique_lock<Latch> lk(_mutex);
+                _cv.wait(lk, [&] { return _shutdown || _bufferedBytes < _maxBufferBytes; });
+                if (_shutdown) {
+                    break;
+                }
+                _buffer.emplace_back(std::move(*next), size);
+                _bufferedBytes += size;
+                _cv.notify_all();
+            }
+        } catch (const DBException& ex) {
+            status = ex.toStatus();
+        }
+
+        try {
+            _usedDisk = _pipeline->usedDisk();
+            _pipeline->dispose(opCtx.get());
+        } catch (const DBException& ex) {
+            if (status.isOK()) {
+                status = ex.toStatus();
+            }
+        }
+        _pipeline.get_deleter().dismissDisposal();
+        _pipeline.reset();
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        _opCtx = nullptr;
+        _status = std::move(status);
+        _done = true;
+        _cv.notify_all();
+    }
+
+    const std::shared_ptr<MongoProcessInterface> _processInterface;
+    std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
+    const size_t _maxBufferBytes;
+    stdx::thread _thread;
+    bool _usedDisk = false;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("DocumentSourceUnionWith::Prefetcher::_mutex");
+
+    // Signaled whenever a document is added to or removed from '_buffer', when the prefetching
+    // thread finishes, and on shutdown.
+    stdx::condition_variable _cv;
+
+    // Everything below is protected by '_mutex'.
+    std::deque<std::pair<Document, size_t>> _buffer;
+    size_t _bufferedBytes = 0;
+    OperationContext* _opCtx = nullptr;
+    bool _shutdown = false;
+    bool _done = false;
+    Status _status = Status::OK();
+};
+
+DocumentSourceUnionWith::DocumentSourceUnionWith(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline)
+    : DocumentSource(kStageName, expCtx), _pipeline(std::move(pipeline)) {}
+
+DocumentSourceUnionWith::~DocumentSourceUnionWith() {
+    stopPrefetching();
+}
+
 std::unique_ptr<DocumentSourceUnionWith::LiteParsed> DocumentSourceUnionWith::LiteParsed::parse(
     const NamespaceString& nss, const BSONElement& spec) {
     uassert(ErrorCodes::FailedToParse,
@@ -156,7 +312,44 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceUnionWith::createFromBson(
             expCtx, expCtx->getResolvedNamespace(std::move(unionNss)), std::move(pipeline)));
 }
 
+bool DocumentSourceUnionWith::canPrefetch() const {
+    if (internalQueryUnionWithPrefetchMaxBufferBytes.load() <= 0 || pExpCtx->explain ||
+        pExpCtx->inMongos || pExpCtx->fromMongos || pExpCtx->needsMerge) {
+        return false;
+    }
+    if (pExpCtx->opCtx->inMultiDocumentTransaction()) {
+        return false;
+    }
+
+    // The prefetching thread reads on its own OperationContext without a timestamped read source,
+    // so only read concerns which do not need one can be honored.
+    const auto& readConcern = repl::ReadConcernArgs::get(pExpCtx->opCtx);
+    const auto level = readConcern.getLevel();
+    return (level == repl::ReadConcernLevel::kLocalReadConcern ||
+            level == repl::ReadConcernLevel::kAvailableReadConcern) &&
+        !readConcern.getArgsAfterClusterTime() && !readConcern.getArgsAtClusterTime() &&
+        !readConcern.getArgsOpTime();
+}
+
+void DocumentSourceUnionWith::stopPrefetching() {
+    if (_prefetcher) {
+        _prefetcher->shutdown();
+        _usedDisk = _usedDisk || _prefetcher->usedDisk();
+        _prefetcher.reset();
+    }
+}
+
 DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
+    if (!_cursorAttached && !_prefetcher && canPrefetch()) {
+        // Start filling the buffer from the sub-pipeline while the main pipeline is still being
+        // read.
+        _prefetcher = std::make_unique<Prefetcher>(
+            pExpCtx->mongoProcessInterface,
+            std::move(_pipeline),
+            repl::ReadConcernArgs::get(pExpCtx->opCtx),
+            static_cast<size_t>(internalQueryUnionWithPrefetchMaxBufferBytes.load()));
+    }
+
     if (!_sourceExhausted) {
         auto nextInput = pSource->getNext();
         if (!nextInput.isEOF()) {
@@ -167,6 +360,13 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
         // pipeline by falling through below.
     }
 
+    if (_prefetcher) {
+        if (auto res = _prefetcher->getNext(pExpCtx->opCtx))
+            return std::move(*res);
+
+        return GetNextResult::makeEOF();
+    }
+
     if (!_cursorAttached) {
         auto ctx = _pipeline->getContext();
         _pipeline =
@@ -207,6 +407,7 @@ bool DocumentSourceUnionWith::usedDisk() {
 }
 
 void DocumentSourceUnionWith::doDispose() {
+    stopPrefetching();
     if (_pipeline) {
         _usedDisk = _usedDisk || _pipeline->usedDisk();
         _pipeline->dispose(pExpCtx->opCtx);
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <memory>
 
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
@@ -61,8 +62,9 @@ public:
     };
 
     DocumentSourceUnionWith(const boost::intrusive_ptr<ExpressionContext>& expCtx,
-                            std::unique_ptr<Pipeline, PipelineDeleter> pipeline)
-        : DocumentSource(kStageName, expCtx), _pipeline(std::move(pipeline)) {}
+                            std::unique_ptr<Pipeline, PipelineDeleter> pipeline);
+
+    ~DocumentSourceUnionWith();
 
     const char* getSourceName() const final {
         return kStageName.rawData();
@@ -143,10 +145,30 @@ private:
         MONGO_UNREACHABLE;
     }
 
+    /**
+     * Runs the sub-pipeline on a background thread, buffering its results until they are needed.
+     */
+    class Prefetcher;
+
+    /**
+     * Returns true if the sub-pipeline may be run on a background thread while the main pipeline
+     * is still being read. See 'internalQueryUnionWithPrefetchMaxBufferBytes'.
+     */
+    bool canPrefetch() const;
+
+    /**
+     * Stops the prefetching thread, if any, and disposes of the sub-pipeline it was running.
+     */
+    void stopPrefetching();
+
     std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
     bool _sourceExhausted = false;
     bool _cursorAttached = false;
     bool _usedDisk = false;
+
+    // Set when the sub-pipeline is handed to a prefetching thread, in which case '_pipeline' is
+    // null.
+    std::unique_ptr<Prefetcher> _prefetcher;
 };
 
 }  // namespace mongo
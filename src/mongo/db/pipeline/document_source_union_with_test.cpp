@@ -48,8 +48,10 @@
 #include "mongo/db/pipeline/document_source_union_with.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/process_interface/stub_lookup_single_document_process_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/intrusive_counter.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -324,6 +326,71 @@ TEST_F(DocumentSourceUnionWithTest, PropagatePauses) {
     ASSERT_TRUE(unionWithTwo.getNext().isEOF());
 }
 
+TEST_F(DocumentSourceUnionWithTest, PrefetchedSubPipelineResultsFollowMainPipelineResults) {
+    const auto originalMaxBufferBytes = internalQueryUnionWithPrefetchMaxBufferBytes.load();
+    ON_BLOCK_EXIT(
+        [&] { internalQueryUnionWithPrefetchMaxBufferBytes.store(originalMaxBufferBytes); });
+    // Allow only a single document to be buffered at a time.
+    internalQueryUnionWithPrefetchMaxBufferBytes.store(1);
+
+    const auto mock =
+        DocumentSourceMock::createForTest({Document{{"a", 0}},
+                                           DocumentSource::GetNextResult::makePauseExecution(),
+                                           Document{{"a", 1}}});
+    auto mockDeque = std::deque<DocumentSource::GetNextResult>{};
+    for (int i = 0; i < 5; ++i) {
+        mockDeque.push_back(Document{{"b", i}});
+    }
+    const auto mockCtx = getExpCtx()->copyWith({});
+    mockCtx->mongoProcessInterface = std::make_unique<MockMongoInterface>(mockDeque);
+    auto unionWith = DocumentSourceUnionWith(
+        mockCtx,
+        Pipeline::create(std::list<boost::intrusive_ptr<DocumentSource>>{},
+                         getExpCtx()->copyWith({})));
+    unionWith.setSource(mock.get());
+
+    auto next = unionWith.getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"a", 0}}));
+    ASSERT_TRUE(unionWith.getNext().isPaused());
+    next = unionWith.getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"a", 1}}));
+    for (int i = 0; i < 5; ++i) {
+        next = unionWith.getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"b", i}}));
+    }
+    ASSERT_TRUE(unionWith.getNext().isEOF());
+    ASSERT_TRUE(unionWith.getNext().isEOF());
+    unionWith.dispose();
+}
+
+TEST_F(DocumentSourceUnionWithTest, DisposeStopsPrefetchingSubPipeline) {
+    const auto originalMaxBufferBytes = internalQueryUnionWithPrefetchMaxBufferBytes.load();
+    ON_BLOCK_EXIT(
+        [&] { internalQueryUnionWithPrefetchMaxBufferBytes.store(originalMaxBufferBytes); });
+    internalQueryUnionWithPrefetchMaxBufferBytes.store(1);
+
+    const auto mock = DocumentSourceMock::createForTest(Document{{"a", 0}});
+    auto mockDeque = std::deque<DocumentSource::GetNextResult>{};
+    for (int i = 0; i < 5; ++i) {
+        mockDeque.push_back(Document{{"b", i}});
+    }
+    const auto mockCtx = getExpCtx()->copyWith({});
+    mockCtx->mongoProcessInterface = std::make_unique<MockMongoInterface>(mockDeque);
+    auto unionWith = DocumentSourceUnionWith(
+        mockCtx,
+        Pipeline::create(std::list<boost::intrusive_ptr<DocumentSource>>{},
+                         getExpCtx()->copyWith({})));
+    unionWith.setSource(mock.get());
+
+    ASSERT_TRUE(unionWith.getNext().isAdvanced());
+    // The prefetching thread is blocked on a full buffer, so disposing must not wait for it to
+    // drain the sub-pipeline.
+    unionWith.dispose();
+}
+
 TEST_F(DocumentSourceUnionWithTest, DependencyAnalysisReportsFullDoc) {
     auto expCtx = getExpCtx();
     const auto replaceRoot =
@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_writer.h"
+
+#include "mongo/db/client.h"
+
+namespace mongo {
+
+ConcurrentBatchWriter::ConcurrentBatchWriter(OperationContext* opCtx, size_t maxInFlight)
+    : _opCtx(opCtx), _maxInFlight(maxInFlight), _pool([&] {
+          ThreadPool::Options options;
+          options.poolName = "BatchWriterThreadPool";
+          options.threadNamePrefix = "batchWriter-";
+          options.maxThreads = maxInFlight;
+          options.onCreateThread = [](const std::string& threadName) {
+              Client::initThread(threadName.c_str());
+          };
+          return options;
+      }()) {
+    _pool.startup();
+}
+
+ConcurrentBatchWriter::~ConcurrentBatchWriter() {
+    _pool.shutdown();
+    _pool.join();
+}
+
+void ConcurrentBatchWriter::schedule(Write write) {
+    {
+        stdx::unique_lock<Latch> lk(_mutex);
+        _opCtx->waitForConditionOrInterrupt(_cv, lk, [&] { return _numInFlight < _maxInFlight; });
+        uassertStatusOK(_status);
+        ++_numInFlight;
+    }
+
+    _pool.schedule([this, write = std::move(write)](Status status) mutable {
+        if (status.isOK()) {
+            // A write queued behind others does not start once the stage's operation is killed.
+            stdx::lock_guard<Client> clientLock(*_opCtx->getClient());
+            if (auto killCode = _opCtx->getKillStatus()) {
+                status = Status(killCode, "operation was interrupted");
+            }
+        }
+        if (status.isOK()) {
+            try {
+                auto writeOpCtx = cc().makeOperationContext();
+                if (_opCtx->hasDeadline()) {
+                    writeOpCtx->setDeadlineByDate(_opCtx->getDeadline(),
+                                                  _opCtx->getTimeoutError());
+                }
+                write(writeOpCtx.get());
+            } catch (const DBException& ex) {
+                status = ex.toStatus();
+            }
+        }
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (!status.isOK() && _status.isOK()) {
+            _status = std::move(status);
+        }
+        --_numInFlight;
+        _cv.notify_all();
+    });
+}
+
+void ConcurrentBatchWriter::waitForAll() {
+    stdx::unique_lock<Latch> lk(_mutex);
+    _opCtx->waitForConditionOrInterrupt(_cv, lk, [&] { return _numInFlight == 0; });
+    uassertStatusOK(_status);
+}
+
+}  // namespace mongo
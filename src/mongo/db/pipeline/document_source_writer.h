@@ -36,8 +36,13 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/read_concern.h"
 #include "mongo/db/storage/recovery_unit.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/functional.h"
 
 namespace mongo {
 using namespace fmt::literals;
@@ -70,6 +75,49 @@ public:
     }
 };
 
+/**
+ * Runs the writes of a writer stage on background threads, each with an OperationContext of its
+ * own, so that the stage can read its next batch while earlier ones are written. At most
+ * 'maxInFlight' writes run or wait to run at once; scheduling another blocks until one completes,
+ * pushing back on the pipeline. The writes may complete in any order.
+ *
+ * Destroying the writer waits for the writes in flight, so they never outlive the call to the
+ * stage's getNext() that scheduled them.
+ */
+class ConcurrentBatchWriter {
+    ConcurrentBatchWriter(const ConcurrentBatchWriter&) = delete;
+    ConcurrentBatchWriter& operator=(const ConcurrentBatchWriter&) = delete;
+
+public:
+    using Write = unique_function<void(OperationContext*)>;
+
+    ConcurrentBatchWriter(OperationContext* opCtx, size_t maxInFlight);
+    ~ConcurrentBatchWriter();
+
+    /**
+     * Waits until fewer than 'maxInFlight' writes are in flight, then starts 'write'. Throws if
+     * the stage's operation is interrupted while waiting, or if an earlier write failed.
+     */
+    void schedule(Write write);
+
+    /**
+     * Waits for the writes in flight, and throws the error of the first one that failed. Throws if
+     * the stage's operation is interrupted while waiting; the destructor still waits for them.
+     */
+    void waitForAll();
+
+private:
+    // The stage's operation, which the writes take their deadline from.
+    OperationContext* const _opCtx;
+    const size_t _maxInFlight;
+    ThreadPool _pool;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("ConcurrentBatchWriter::_mutex");
+    stdx::condition_variable _cv;
+    size_t _numInFlight = 0;
+    Status _status = Status::OK();
+};
+
 /**
  * This is a base abstract class for all stages performing a write operation into an output
  * collection. The writes are organized in batches in which elements are objects of the templated
@@ -82,6 +130,10 @@ public:
  * Two other virtual methods exist which a subclass may override: 'initialize()' and 'finalize()',
  * which are called before the first element is read from the input source, and after the last one
  * has been read, respectively.
+ *
+ * With internalDocumentSourceWriterMaxInFlightBatches set, 'spill()' is called on background
+ * threads, concurrently with itself, with an ExpressionContext whose OperationContext belongs to
+ * that thread. It must then only read the state of the stage.
  */
 template <typename B>
 class DocumentSourceWriter : public DocumentSource {
@@ -133,9 +185,11 @@ protected:
     virtual void finalize() {}
 
     /**
-     * Writes the documents in 'batch' to the output namespace.
+     * Writes the documents in 'batch' to the output namespace, using the OperationContext of
+     * 'expCtx'.
      */
-    virtual void spill(BatchedObjects&& batch) = 0;
+    virtual void spill(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                       BatchedObjects&& batch) = 0;
 
     /**
      * Creates a batch object from the given document and returns it to the caller along with the
@@ -183,6 +237,23 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
             _initialized = true;
         }
 
+        boost::optional<ConcurrentBatchWriter> concurrentWriter;
+        if (auto maxInFlight = internalDocumentSourceWriterMaxInFlightBatches.load()) {
+            concurrentWriter.emplace(pExpCtx->opCtx, maxInFlight);
+        }
+        auto spillBatch = [&](BatchedObjects&& batch) {
+            if (!concurrentWriter) {
+                spill(pExpCtx, std::move(batch));
+                return;
+            }
+            concurrentWriter->schedule(
+                [this, expCtx = pExpCtx->copyWith(pExpCtx->ns), batch = std::move(batch)](
+                    OperationContext* opCtx) mutable {
+                    expCtx->opCtx = opCtx;
+                    spill(expCtx, std::move(batch));
+                });
+        };
+
         BatchedObjects batch;
         int bufferedBytes = 0;
 
@@ -197,16 +268,19 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
             if (!batch.empty() &&
                 (bufferedBytes > BSONObjMaxUserSize ||
                  batch.size() >= write_ops::kMaxWriteBatchSize)) {
-                spill(std::move(batch));
+                spillBatch(std::move(batch));
                 batch.clear();
                 bufferedBytes = objSize;
             }
             batch.push_back(obj);
         }
         if (!batch.empty()) {
-            spill(std::move(batch));
+            spillBatch(std::move(batch));
             batch.clear();
         }
+        if (concurrentWriter) {
+            concurrentWriter->waitForAll();
+        }
 
         switch (nextInput.getStatus()) {
             case GetNextResult::ReturnStatus::kAdvanced: {
@@ -276,10 +276,33 @@ Value ExpressionAdd::evaluate(const Document& root, Variables* variables) const
     BSONType totalType = NumberInt;
     bool haveDate = false;
 
+    // As long as every operand is an int or a long and their sum fits in a long, which is by far
+    // the most common case, sum them directly in 'longTotal'. The compensated sum is only started
+    // once that no longer holds, at which point 'longTotal' is exactly the sum so far.
+    long long longTotal = 0;
+    bool onlyLongTotal = true;
+
     const size_t n = _children.size();
     for (size_t i = 0; i < n; ++i) {
         Value val = _children[i]->evaluate(root, variables);
 
+        if (onlyLongTotal) {
+            long long newTotal;
+            if (val.getType() == NumberInt &&
+                !overflow::add(longTotal, static_cast<long long>(val.getInt()), &newTotal)) {
+                longTotal = newTotal;
+                continue;
+            }
+            if (val.getType() == NumberLong &&
+                !overflow::add(longTotal, val.getLong(), &newTotal)) {
+                longTotal = newTotal;
+                totalType = NumberLong;
+                continue;
+            }
+            onlyLongTotal = false;
+            nonDecimalTotal.addLong(longTotal);
+        }
+
         switch (val.getType()) {
             case NumberDecimal:
                 decimalTotal = decimalTotal.add(val.getDecimal());
@@ -312,8 +335,11 @@ Value ExpressionAdd::evaluate(const Document& root, Variables* variables) const
         }
     }
 
+    if (onlyLongTotal) {
+        return totalType == NumberLong ? Value(longTotal) : Value::createIntOrLong(longTotal);
+    }
+
     if (haveDate) {
-        int64_t longTotal;
         if (totalType == NumberDecimal) {
             longTotal = decimalTotal.add(nonDecimalTotal.getDecimal()).toLong();
         } else {
@@ -493,6 +493,21 @@ class LongDoubleNoOverflow : public TwoOperandBase {
     }
 };
 
+/** An intermediate long overflow does not change the type of a sum that fits in a long. */
+class LongIntIntIntermediateOverflow {
+public:
+    void run() {
+        intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+        intrusive_ptr<ExpressionNary> expression = new ExpressionAdd(expCtx);
+        expression->addOperand(
+            ExpressionConstant::create(expCtx, Value(numeric_limits<long long>::max())));
+        expression->addOperand(ExpressionConstant::create(expCtx, Value(1)));
+        expression->addOperand(ExpressionConstant::create(expCtx, Value(-1)));
+        ASSERT_BSONOBJ_EQ(BSON("" << numeric_limits<long long>::max()),
+                          toBson(expression->evaluate({}, &expCtx->variables)));
+    }
+};
+
 /** Adding an int and null. */
 class IntNull : public TwoOperandBase {
     BSONObj operand1() {
@@ -2841,6 +2856,7 @@ public:
         add<Add::IntDate>();
         add<Add::LongDouble>();
         add<Add::LongDoubleNoOverflow>();
+        add<Add::LongIntIntIntermediateOverflow>();
         add<Add::IntNull>();
         add<Add::LongUndefined>();
 
@@ -35,6 +35,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/scripting/engine.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -102,12 +103,29 @@ public:
         }
     }
 
+    /**
+     * Defines the user-defined function 'code' as a global of the scope, parsed as by makeJsFunc(),
+     * so that other functions run in the scope can call it. Returns the name of the global, which
+     * is the same for every call with the same 'code'.
+     */
+    const std::string& defineGlobalFunction(const std::string& code) {
+        auto it = _globalFunctions.find(code);
+        if (it == _globalFunctions.end()) {
+            std::string name = str::stream() << "__jsExecutionFunction" << _globalFunctions.size();
+            _scope->setFunction(name.c_str(), code.c_str());
+            it = _globalFunctions.emplace(code, std::move(name)).first;
+        }
+        return it->second;
+    }
+
     Scope* getScope() {
         return _scope.get();
     }
 
 private:
     BSONObj _scopeVars;
+    // Names of the globals defined by defineGlobalFunction(), by function source.
+    stdx::unordered_map<std::string, std::string> _globalFunctions;
     std::unique_ptr<Scope> _scope;
     bool _emitCreated = false;
     bool _storedProceduresLoaded = false;
@@ -48,6 +48,7 @@
 #include "mongo/db/curop.h"
 #include "mongo/db/cursor_manager.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/pipeline/document_source_cursor.h"
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
@@ -197,6 +198,12 @@ std::vector<Document> CommonMongodProcessInterface::getIndexStats(OperationConte
             doc["building"] = Value(true);
         }
 
+        auto keyFilterStats =
+            entry->accessMethod()->getSortedDataInterface()->getDuplicateKeyFilterStats();
+        if (!keyFilterStats.isEmpty()) {
+            doc["duplicateKeyFilter"] = Value(keyFilterStats);
+        }
+
         indexStats.push_back(doc.freeze());
     }
     return indexStats;
@@ -205,8 +212,10 @@ std::vector<Document> CommonMongodProcessInterface::getIndexStats(OperationConte
 void CommonMongodProcessInterface::appendLatencyStats(OperationContext* opCtx,
                                                       const NamespaceString& nss,
                                                       bool includeHistograms,
+                                                      const std::vector<double>& percentiles,
                                                       BSONObjBuilder* builder) const {
-    Top::get(opCtx->getServiceContext()).appendLatencyStats(nss, includeHistograms, builder);
+    Top::get(opCtx->getServiceContext())
+        .appendLatencyStats(nss, includeHistograms, percentiles, builder);
 }
 
 Status CommonMongodProcessInterface::appendStorageStats(OperationContext* opCtx,
@@ -349,21 +358,88 @@ boost::optional<Document> CommonMongodProcessInterface::lookupSingleDocument(
                                 << ", " << next->toString() << "]");
     }
 
+    _setSpeculativeReadTimestampAfterLookup(expCtx->opCtx);
+    return lookedUpDocument;
+}
+
+std::vector<boost::optional<Document>> CommonMongodProcessInterface::lookupDocuments(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    UUID collectionUUID,
+    const std::vector<Document>& documentKeys,
+    boost::optional<BSONObj> readConcern,
+    bool allowSpeculativeMajorityRead) {
+    if (documentKeys.size() <= 1) {
+        return MongoProcessInterface::lookupDocuments(
+            expCtx, nss, collectionUUID, documentKeys, readConcern, allowSpeculativeMajorityRead);
+    }
+    invariant(!readConcern);
+    invariant(!allowSpeculativeMajorityRead);
+
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
+    try {
+        auto foreignExpCtx = expCtx->copyWith(
+            nss,
+            collectionUUID,
+            _getCollectionDefaultCollator(expCtx->opCtx, nss.db(), collectionUUID));
+        MakePipelineOptions opts;
+        opts.allowTargetingShards = false;
+        BSONArrayBuilder orBuilder;
+        for (auto&& documentKey : documentKeys) {
+            orBuilder.append(documentKey.toBson());
+        }
+        pipeline = Pipeline::makePipeline(
+            {BSON("$match" << BSON("$or" << orBuilder.arr()))}, foreignExpCtx, opts);
+    } catch (const ExceptionFor<ErrorCodes::NamespaceNotFound>&) {
+        return std::vector<boost::optional<Document>>(documentKeys.size());
+    }
+
+    // Attribute each document to the key whose fields it holds exactly. The $or is evaluated with
+    // the collection's collation, so a key matching no document, or several, is looked up on its
+    // own; that lookup also reports duplicates as lookupSingleDocument() always has.
+    std::vector<boost::optional<Document>> results(documentKeys.size());
+    std::vector<int> numMatches(documentKeys.size(), 0);
+    while (auto doc = pipeline->getNext()) {
+        for (size_t i = 0; i < documentKeys.size(); ++i) {
+            bool matches = true;
+            for (auto it = documentKeys[i].fieldIterator(); matches && it.more();) {
+                auto field = it.next();
+                matches = ValueComparator::kInstance.evaluate(
+                    doc->getNestedField(FieldPath(field.first)) == field.second);
+            }
+            if (matches) {
+                results[i] = *doc;
+                ++numMatches[i];
+            }
+        }
+    }
+    pipeline.reset();
+
+    for (size_t i = 0; i < documentKeys.size(); ++i) {
+        if (numMatches[i] != 1) {
+            results[i] =
+                lookupSingleDocument(expCtx, nss, collectionUUID, documentKeys[i], boost::none);
+        }
+    }
+
+    _setSpeculativeReadTimestampAfterLookup(expCtx->opCtx);
+    return results;
+}
+
+void CommonMongodProcessInterface::_setSpeculativeReadTimestampAfterLookup(
+    OperationContext* opCtx) {
     // Set the speculative read timestamp appropriately after we do a document lookup locally. We
     // set the speculative read timestamp based on the timestamp used by the transaction.
     repl::SpeculativeMajorityReadInfo& speculativeMajorityReadInfo =
-        repl::SpeculativeMajorityReadInfo::get(expCtx->opCtx);
+        repl::SpeculativeMajorityReadInfo::get(opCtx);
     if (speculativeMajorityReadInfo.isSpeculativeRead()) {
         // Speculative majority reads are required to use the 'kNoOverlap' read source.
-        invariant(expCtx->opCtx->recoveryUnit()->getTimestampReadSource() ==
+        invariant(opCtx->recoveryUnit()->getTimestampReadSource() ==
                   RecoveryUnit::ReadSource::kNoOverlap);
-        boost::optional<Timestamp> readTs =
-            expCtx->opCtx->recoveryUnit()->getPointInTimeReadTimestamp();
+        boost::optional<Timestamp> readTs = opCtx->recoveryUnit()->getPointInTimeReadTimestamp();
         invariant(readTs);
         speculativeMajorityReadInfo.setSpeculativeReadTimestampForward(*readTs);
     }
-
-    return lookedUpDocument;
 }
 
 BackupCursorState CommonMongodProcessInterface::openBackupCursor(
@@ -419,6 +495,27 @@ std::vector<BSONObj> CommonMongodProcessInterface::getMatchingPlanCacheEntryStat
     return planCache->getMatchingStats(serializer, predicate);
 }
 
+std::vector<BSONObj> CommonMongodProcessInterface::getMatchingPlanCachePartitionStats(
+    OperationContext* opCtx, const NamespaceString& nss, const MatchExpression* matchExp) const {
+    AutoGetCollection autoColl(opCtx, nss, MODE_IS);
+    const auto collection = autoColl.getCollection();
+    uassert(5212005,
+            str::stream() << "collection '" << nss.toString() << "' does not exist",
+            collection);
+
+    const auto planCache = CollectionQueryInfo::get(collection).getPlanCache();
+    invariant(planCache);
+
+    std::vector<BSONObj> results;
+    for (auto&& partitionStats : planCache->getPartitionStats()) {
+        auto serializedStats = partitionStats.toBSON();
+        if (!matchExp || matchExp->matchesBSON(serializedStats)) {
+            results.push_back(std::move(serializedStats));
+        }
+    }
+    return results;
+}
+
 bool CommonMongodProcessInterface::fieldsHaveSupportingUniqueIndex(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     const NamespaceString& nss,
@@ -55,6 +55,19 @@ public:
     std::unique_ptr<TransactionHistoryIteratorBase> createTransactionHistoryIterator(
         repl::OpTime time) const final;
 
+    bool haveSameChunkDistribution(OperationContext* opCtx,
+                                   const NamespaceString& nss,
+                                   const FieldPath& field,
+                                   const NamespaceString& otherNss,
+                                   const FieldPath& otherField) final {
+        return false;
+    }
+
+    boost::optional<long long> getUnshardedCollectionSize(OperationContext* opCtx,
+                                                          const NamespaceString& nss) final {
+        return boost::none;
+    }
+
     std::vector<Document> getIndexStats(OperationContext* opCtx,
                                         const NamespaceString& ns,
                                         StringData host,
@@ -63,6 +76,7 @@ public:
     void appendLatencyStats(OperationContext* opCtx,
                             const NamespaceString& nss,
                             bool includeHistograms,
+                            const std::vector<double>& percentiles,
                             BSONObjBuilder* builder) const final;
     Status appendStorageStats(OperationContext* opCtx,
                               const NamespaceString& nss,
@@ -86,6 +100,13 @@ public:
         const Document& documentKey,
         boost::optional<BSONObj> readConcern,
         bool allowSpeculativeMajorityRead = false) final;
+    std::vector<boost::optional<Document>> lookupDocuments(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const NamespaceString& nss,
+        UUID collectionUUID,
+        const std::vector<Document>& documentKeys,
+        boost::optional<BSONObj> readConcern,
+        bool allowSpeculativeMajorityRead = false) final;
     std::vector<GenericCursor> getIdleCursors(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                               CurrentOpUserMode userMode) const final;
     BackupCursorState openBackupCursor(OperationContext* opCtx,
@@ -99,6 +120,10 @@ public:
                                                         const NamespaceString&,
                                                         const MatchExpression*) const final;
 
+    std::vector<BSONObj> getMatchingPlanCachePartitionStats(OperationContext*,
+                                                            const NamespaceString&,
+                                                            const MatchExpression*) const final;
+
     bool fieldsHaveSupportingUniqueIndex(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                          const NamespaceString& nss,
                                          const std::set<FieldPath>& fieldPaths) const;
@@ -153,6 +178,12 @@ private:
                                                                      StringData dbName,
                                                                      UUID collectionUUID);
 
+    /**
+     * Advances the speculative majority read timestamp to the one a local document lookup read at,
+     * if the operation is a speculative majority read.
+     */
+    void _setSpeculativeReadTimestampAfterLookup(OperationContext* opCtx);
+
     std::map<UUID, std::unique_ptr<const CollatorInterface>> _collatorCache;
 
     // Object which contains a JavaScript Scope, used for executing JS in pipeline stages and
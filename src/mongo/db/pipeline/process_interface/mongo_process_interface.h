@@ -133,6 +133,26 @@ public:
      */
     virtual bool isSharded(OperationContext* opCtx, const NamespaceString& ns) = 0;
 
+    /**
+     * Returns true if 'nss' is sharded on the single field 'field', and 'otherNss' on the single
+     * field 'otherField', with the same kind of shard key and the same chunks owned by the same
+     * shards, so that documents of the two collections with equal keys live on the same shard.
+     * Only mongos knows the chunk distribution; other processes return false.
+     */
+    virtual bool haveSameChunkDistribution(OperationContext* opCtx,
+                                           const NamespaceString& nss,
+                                           const FieldPath& field,
+                                           const NamespaceString& otherNss,
+                                           const FieldPath& otherField) = 0;
+
+    /**
+     * Returns the size in bytes of the documents of the unsharded collection 'nss', as reported by
+     * its primary shard, or boost::none if it is sharded, does not exist, or this process does not
+     * route to it.
+     */
+    virtual boost::optional<long long> getUnshardedCollectionSize(OperationContext* opCtx,
+                                                                  const NamespaceString& nss) = 0;
+
     /**
      * Inserts 'objs' into 'ns' and returns an error Status if the insert fails. If 'targetEpoch' is
      * set, throws ErrorCodes::StaleEpoch if the targeted collection does not have the same epoch or
@@ -176,11 +196,13 @@ public:
                                              bool includeBuildUUIDs) = 0;
 
     /**
-     * Appends operation latency statistics for collection "nss" to "builder"
+     * Appends operation latency statistics for collection "nss" to "builder", including the
+     * latency at each of "percentiles"
      */
     virtual void appendLatencyStats(OperationContext* opCtx,
                                     const NamespaceString& nss,
                                     bool includeHistograms,
+                                    const std::vector<double>& percentiles,
                                     BSONObjBuilder* builder) const = 0;
 
     /**
@@ -345,6 +367,31 @@ public:
         boost::optional<BSONObj> readConcern,
         bool allowSpeculativeMajorityRead = false) = 0;
 
+    /**
+     * Looks up the documents with each of 'documentKeys' as lookupSingleDocument() does, returning
+     * the results in the same order. Implementations may fetch them together; by default, each is
+     * looked up separately.
+     */
+    virtual std::vector<boost::optional<Document>> lookupDocuments(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const NamespaceString& nss,
+        UUID collectionUUID,
+        const std::vector<Document>& documentKeys,
+        boost::optional<BSONObj> readConcern,
+        bool allowSpeculativeMajorityRead = false) {
+        std::vector<boost::optional<Document>> results;
+        results.reserve(documentKeys.size());
+        for (auto&& documentKey : documentKeys) {
+            results.push_back(lookupSingleDocument(expCtx,
+                                                   nss,
+                                                   collectionUUID,
+                                                   documentKey,
+                                                   readConcern,
+                                                   allowSpeculativeMajorityRead));
+        }
+        return results;
+    }
+
     /**
      * Returns a vector of all idle (non-pinned) local cursors.
      */
@@ -373,6 +420,14 @@ public:
                                                                 const NamespaceString&,
                                                                 const MatchExpression*) const = 0;
 
+    /**
+     * Returns a vector of BSON objects, where each entry in the vector describes the counters of
+     * one partition of the plan cache for the given namespace. Only those partitions whose
+     * description matches the supplied MatchExpression are returned.
+     */
+    virtual std::vector<BSONObj> getMatchingPlanCachePartitionStats(
+        OperationContext*, const NamespaceString&, const MatchExpression*) const = 0;
+
     /**
      * Returns true if there is an index on 'nss' with properties that will guarantee that a
      * document with non-array values for each of 'fieldPaths' will have at most one matching
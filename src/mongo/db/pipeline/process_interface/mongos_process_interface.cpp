@@ -291,6 +291,68 @@ bool MongosProcessInterface::isSharded(OperationContext* opCtx, const NamespaceS
     return routingInfo.isOK() && routingInfo.getValue().cm();
 }
 
+bool MongosProcessInterface::haveSameChunkDistribution(OperationContext* opCtx,
+                                                       const NamespaceString& nss,
+                                                       const FieldPath& field,
+                                                       const NamespaceString& otherNss,
+                                                       const FieldPath& otherField) {
+    auto catalogCache = Grid::get(opCtx)->catalogCache();
+    auto routingInfo = catalogCache->getCollectionRoutingInfo(opCtx, nss);
+    auto otherRoutingInfo = catalogCache->getCollectionRoutingInfo(opCtx, otherNss);
+    if (!routingInfo.isOK() || !otherRoutingInfo.isOK()) {
+        return false;
+    }
+    const auto cm = routingInfo.getValue().cm();
+    const auto otherCm = otherRoutingInfo.getValue().cm();
+    if (!cm || !otherCm) {
+        return false;
+    }
+
+    // Both collections must be sharded on just the given field, in the same way: {a: 1} and
+    // {b: 1}, or {a: "hashed"} and {b: "hashed"}.
+    const auto key = cm->getShardKeyPattern().toBSON();
+    const auto otherKey = otherCm->getShardKeyPattern().toBSON();
+    if (key.nFields() != 1 || otherKey.nFields() != 1 ||
+        key.firstElementFieldNameStringData() != field.fullPath() ||
+        otherKey.firstElementFieldNameStringData() != otherField.fullPath() ||
+        key.firstElement().woCompare(otherKey.firstElement(), false) != 0) {
+        return false;
+    }
+
+    if (cm->numChunks() != otherCm->numChunks()) {
+        return false;
+    }
+    auto otherIt = otherCm->chunks().begin();
+    for (auto&& chunk : cm->chunks()) {
+        const auto otherChunk = *otherIt++;
+        if (chunk.getShardId() != otherChunk.getShardId() ||
+            chunk.getMin().woCompare(otherChunk.getMin(), BSONObj(), false) != 0 ||
+            chunk.getMax().woCompare(otherChunk.getMax(), BSONObj(), false) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+boost::optional<long long> MongosProcessInterface::getUnshardedCollectionSize(
+    OperationContext* opCtx, const NamespaceString& nss) {
+    auto routingInfo = Grid::get(opCtx)->catalogCache()->getCollectionRoutingInfo(opCtx, nss);
+    if (!routingInfo.isOK() || routingInfo.getValue().cm()) {
+        return boost::none;
+    }
+
+    auto response = routingInfo.getValue().db().primary()->runCommandWithFixedRetryAttempts(
+        opCtx,
+        ReadPreferenceSetting(ReadPreference::PrimaryOnly),
+        nss.db().toString(),
+        BSON("collStats" << nss.coll()),
+        Shard::RetryPolicy::kIdempotent);
+    if (!response.isOK() || !response.getValue().commandStatus.isOK()) {
+        return boost::none;
+    }
+    return response.getValue().response["size"].safeNumberLong();
+}
+
 bool MongosProcessInterface::fieldsHaveSupportingUniqueIndex(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     const NamespaceString& nss,
@@ -63,6 +63,15 @@ public:
 
     bool isSharded(OperationContext* opCtx, const NamespaceString& nss) final;
 
+    bool haveSameChunkDistribution(OperationContext* opCtx,
+                                   const NamespaceString& nss,
+                                   const FieldPath& field,
+                                   const NamespaceString& otherNss,
+                                   const FieldPath& otherField) final;
+
+    boost::optional<long long> getUnshardedCollectionSize(OperationContext* opCtx,
+                                                          const NamespaceString& nss) final;
+
     Status insert(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                   const NamespaceString& ns,
                   std::vector<BSONObj>&& objs,
@@ -97,6 +106,7 @@ public:
     void appendLatencyStats(OperationContext* opCtx,
                             const NamespaceString& nss,
                             bool includeHistograms,
+                            const std::vector<double>& percentiles,
                             BSONObjBuilder* builder) const final {
         MONGO_UNREACHABLE;
     }
@@ -203,6 +213,12 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    std::vector<BSONObj> getMatchingPlanCachePartitionStats(OperationContext*,
+                                                            const NamespaceString&,
+                                                            const MatchExpression*) const final {
+        MONGO_UNREACHABLE;
+    }
+
     bool fieldsHaveSupportingUniqueIndex(const boost::intrusive_ptr<ExpressionContext>&,
                                          const NamespaceString&,
                                          const std::set<FieldPath>& fieldPaths) const;
@@ -62,7 +62,7 @@ public:
 /**
  * A mock MongoProcessInterface which allows mocking a foreign pipeline.
  */
-class StubLookupSingleDocumentProcessInterface final : public StubMongoProcessInterface {
+class StubLookupSingleDocumentProcessInterface : public StubMongoProcessInterface {
 public:
     StubLookupSingleDocumentProcessInterface(std::deque<DocumentSource::GetNextResult> mockResults)
         : _mockResults(std::move(mockResults)) {}
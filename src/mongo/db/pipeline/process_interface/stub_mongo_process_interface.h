@@ -55,6 +55,19 @@ public:
         return false;
     }
 
+    bool haveSameChunkDistribution(OperationContext* opCtx,
+                                   const NamespaceString& nss,
+                                   const FieldPath& field,
+                                   const NamespaceString& otherNss,
+                                   const FieldPath& otherField) override {
+        return false;
+    }
+
+    boost::optional<long long> getUnshardedCollectionSize(OperationContext* opCtx,
+                                                          const NamespaceString& nss) override {
+        return boost::none;
+    }
+
     Status insert(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                   const NamespaceString& ns,
                   std::vector<BSONObj>&& objs,
@@ -89,6 +102,7 @@ public:
     void appendLatencyStats(OperationContext* opCtx,
                             const NamespaceString& nss,
                             bool includeHistograms,
+                            const std::vector<double>& percentiles,
                             BSONObjBuilder* builder) const override {
         MONGO_UNREACHABLE;
     }
@@ -219,6 +233,11 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    std::vector<BSONObj> getMatchingPlanCachePartitionStats(
+        OperationContext*, const NamespaceString&, const MatchExpression*) const override {
+        MONGO_UNREACHABLE;
+    }
+
     bool fieldsHaveSupportingUniqueIndex(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                          const NamespaceString& nss,
                                          const std::set<FieldPath>& fieldPaths) const override {
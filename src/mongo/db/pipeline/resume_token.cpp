@@ -148,7 +148,7 @@ ResumeTokenData ResumeToken::getData() const {
             "resume token string was not a valid hex string",
             isValidHex(_hexKeyString));
 
-    BufBuilder hexDecodeBuf;  // Keep this in scope until we've decoded the bytes.
+    StackBufBuilder hexDecodeBuf;  // Keep this in scope until we've decoded the bytes.
     fromHexString(_hexKeyString, &hexDecodeBuf);
     BSONBinData keyStringBinData =
         BSONBinData(hexDecodeBuf.buf(), hexDecodeBuf.len(), BinDataType::BinDataGeneral);
@@ -50,6 +50,20 @@ boost::intrusive_ptr<TeeBuffer> TeeBuffer::create(size_t nConsumers, int bufferS
 }
 
 DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
+    if (_concurrentConsumers) {
+        // Batches are loaded by the caller, so only this consumer's own state may be touched here.
+        if (_concurrentBuffer.empty()) {
+            return DocumentSource::GetNextResult::makeEOF();
+        }
+        auto& consumer = _consumers[consumerId];
+        if (consumer.nLeftToReturn == 0) {
+            return DocumentSource::GetNextResult::makePauseExecution();
+        }
+        const size_t bufferIndex = _concurrentBuffer.size() - consumer.nLeftToReturn;
+        --consumer.nLeftToReturn;
+        return Document::fromBsonWithMetaData(_concurrentBuffer[bufferIndex]);
+    }
+
     size_t nConsumersStillProcessingThisBatch =
         std::count_if(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
             return info.nLeftToReturn > 0;
@@ -76,14 +90,30 @@ DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
     return _buffer[bufferIndex];
 }
 
+void TeeBuffer::loadNextBatchForConcurrentConsumers() {
+    invariant(_concurrentConsumers);
+    disposeSourceIfUnused();
+    if (std::any_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
+            return info.stillInUse;
+        })) {
+        loadNextBatch();
+    }
+}
+
 void TeeBuffer::loadNextBatch() {
     _buffer.clear();
+    _concurrentBuffer.clear();
     size_t bytesInBuffer = 0;
 
     auto input = _source->getNext();
     for (; input.isAdvanced(); input = _source->getNext()) {
         bytesInBuffer += input.getDocument().getApproximateSize();
-        _buffer.push_back(std::move(input));
+        if (_concurrentConsumers) {
+            _concurrentBuffer.push_back(
+                input.getDocument().toBsonWithMetaData(SortKeyFormat::k44SortKey));
+        } else {
+            _buffer.push_back(std::move(input));
+        }
 
         if (bytesInBuffer >= _bufferSizeBytes) {
             break;  // Need to break here so we don't get the next input and accidentally ignore it.
@@ -99,7 +129,8 @@ void TeeBuffer::loadNextBatch() {
     // Populate the pending returns.
     for (size_t consumerId = 0; consumerId < _consumers.size(); ++consumerId) {
         if (_consumers[consumerId].stillInUse) {
-            _consumers[consumerId].nLeftToReturn = _buffer.size();
+            _consumers[consumerId].nLeftToReturn =
+                _concurrentConsumers ? _concurrentBuffer.size() : _buffer.size();
         }
     }
 }
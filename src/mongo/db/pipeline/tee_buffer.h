@@ -66,10 +66,37 @@ public:
     void dispose(size_t consumerId) {
         _consumers[consumerId].stillInUse = false;
         _consumers[consumerId].nLeftToReturn = 0;
+        if (!_concurrentConsumers) {
+            disposeSourceIfUnused();
+        }
+    }
+
+    /**
+     * Lets the consumers run on separate threads while they consume a batch. Batches are then only
+     * loaded by loadNextBatchForConcurrentConsumers(), and each consumer is handed its own copy of
+     * every document, since a Document may not be read from several threads at once. dispose() no
+     * longer releases the source; the caller must call disposeSourceIfUnused() once all consumers
+     * have stopped running.
+     */
+    void setConcurrentConsumers() {
+        _concurrentConsumers = true;
+    }
+
+    /**
+     * Loads the next batch for all the consumers still in use, or releases the source if there
+     * are none. Only valid with concurrent consumers, and never while any of them is running.
+     */
+    void loadNextBatchForConcurrentConsumers();
+
+    /**
+     * Clears the buffer and disposes of the source if no consumer is still in use.
+     */
+    void disposeSourceIfUnused() {
         if (std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
                 return info.stillInUse;
             })) {
             _buffer.clear();
+            _concurrentBuffer.clear();
             if (_source) {
                 _source->dispose();
             }
@@ -98,6 +125,11 @@ private:
     const size_t _bufferSizeBytes;
     std::vector<DocumentSource::GetNextResult> _buffer;
 
+    // With concurrent consumers, the current batch is held as BSON instead of in '_buffer', so that
+    // each consumer can build its own Document from it.
+    bool _concurrentConsumers = false;
+    std::vector<BSONObj> _concurrentBuffer;
+
     struct ConsumerInfo {
         bool stillInUse = true;
         int nLeftToReturn = 0;
@@ -167,5 +167,32 @@ TEST(TeeBufferTest, ShouldAllowOtherConsumersToAdvanceOnceTrailingConsumerIsDisp
     ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
     ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
 }
+TEST(TeeBufferTest, ConcurrentConsumersShouldPauseUntilCallerLoadsNextBatch) {
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"a", 1}}, Document{{"a", 2}}};
+    auto mock = DocumentSourceMock::createForTest(inputs);
+
+    const size_t nConsumers = 2;
+    const size_t bufferBytes = 1;  // Both docs won't fit in a single batch.
+    auto teeBuffer = TeeBuffer::create(nConsumers, bufferBytes);
+    teeBuffer->setSource(mock.get());
+    teeBuffer->setConcurrentConsumers();
+
+    for (auto&& input : inputs) {
+        teeBuffer->loadNextBatchForConcurrentConsumers();
+        for (size_t consumerId = 0; consumerId < nConsumers; ++consumerId) {
+            auto next = teeBuffer->getNext(consumerId);
+            ASSERT_TRUE(next.isAdvanced());
+            ASSERT_DOCUMENT_EQ(next.getDocument(), input.getDocument());
+
+            // Consumers which finish the batch never load the next one themselves.
+            ASSERT_TRUE(teeBuffer->getNext(consumerId).isPaused());
+        }
+    }
+
+    teeBuffer->loadNextBatchForConcurrentConsumers();
+    ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
+    ASSERT_TRUE(teeBuffer->getNext(1).isEOF());
+}
+
 }  // namespace
 }  // namespace mongo
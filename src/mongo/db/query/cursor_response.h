@@ -77,6 +77,21 @@ public:
         return _options.useDocumentSequences ? _docSeqBuilder->len() : _batch->len();
     }
 
+    /**
+     * Grows the reply buffer so that at least 'bytes' bytes of results can be appended without
+     * reallocating. Callers that can predict the size of a batch use this to avoid growing the
+     * buffer repeatedly while the batch is built.
+     */
+    void reserve(int bytes) {
+        invariant(_active);
+        if (_options.useDocumentSequences) {
+            _docSeqBuilder->reserve(bytes);
+        } else {
+            _batch->bb().reserveBytes(bytes);
+            _batch->bb().claimReservedBytes(bytes);
+        }
+    }
+
     void append(const BSONObj& obj) {
         invariant(_active);
         if (_options.useDocumentSequences) {
@@ -88,7 +103,9 @@ public:
     }
 
     void setPostBatchResumeToken(BSONObj token) {
-        _postBatchResumeToken = token.getOwned();
+        // This is called once per document appended to the batch, and most executors do not
+        // produce a token. Avoid copying the empty object, which would allocate every time.
+        _postBatchResumeToken = token.isEmpty() ? BSONObj() : token.getOwned();
     }
 
     void setPartialResultsReturned(bool partialResults) {
@@ -392,6 +392,39 @@ TEST(CursorResponseTest, cursorReturnDocumentSequences) {
     ASSERT_BSONOBJ_EQ(opMsg.body, expectedBody);
 }
 
+TEST(CursorResponseTest, reserveDoesNotChangeTheReply) {
+    BSONObj doc = BSON("_id" << 1 << "test"
+                             << "123");
+
+    for (bool useDocumentSequences : {false, true}) {
+        CursorResponseBuilder::Options options;
+        options.useDocumentSequences = useDocumentSequences;
+        rpc::OpMsgReplyBuilder builder;
+
+        CursorResponseBuilder crb(&builder, options);
+        const auto bytesUsed = crb.bytesUsed();
+        crb.reserve(1024 * 1024);
+        ASSERT_EQ(crb.bytesUsed(), bytesUsed);
+        crb.append(doc);
+        crb.append(doc);
+        crb.done(CursorId(123), "db.coll");
+
+        auto opMsg = OpMsg::parse(builder.done());
+        std::vector<BSONObj> batch;
+        if (useDocumentSequences) {
+            ASSERT_EQ(opMsg.sequences.size(), 1U);
+            batch = opMsg.sequences[0].objs;
+        } else {
+            for (auto&& elem : opMsg.body["cursor"]["nextBatch"].Obj()) {
+                batch.push_back(elem.Obj());
+            }
+        }
+        ASSERT_EQ(batch.size(), 2U);
+        ASSERT_BSONOBJ_EQ(batch[0], doc);
+        ASSERT_BSONOBJ_EQ(batch[1], doc);
+    }
+}
+
 }  // namespace
 
 }  // namespace mongo
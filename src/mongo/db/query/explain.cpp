@@ -507,6 +507,8 @@ void Explain::statsToBSON(const PlanStageStats& stats,
             bob->appendNumber("seeks", spec->seeks);
             bob->appendNumber("dupsTested", spec->dupsTested);
             bob->appendNumber("dupsDropped", spec->dupsDropped);
+            bob->appendNumber("dedupMemoryUsageBytes",
+                              static_cast<long long>(spec->dedupMemoryUsageBytes));
         }
     } else if (STAGE_OR == stats.stageType) {
         OrStats* spec = static_cast<OrStats*>(stats.specific.get());
@@ -1046,6 +1048,30 @@ void Explain::planCacheEntryToBSON(const PlanCacheEntry& entry, BSONObjBuilder*
     out->append("isActive", entry.isActive);
     out->append("works", static_cast<long long>(entry.works));
 
+    // Describe the selectivity buckets the entry keeps a plan for, if any.
+    if (!entry.selectivityPlans.empty()) {
+        BSONObjBuilder selectivityBob(out->subobjStart("selectivityPlans"));
+        selectivityBob.append("probeIndex", entry.selectivityProbeIndex);
+        BSONArrayBuilder bucketsBuilder(selectivityBob.subarrayStart("buckets"));
+        for (auto&& [bucket, plan] : entry.selectivityPlans) {
+            bucketsBuilder.append(
+                BSON("bucket" << bucket << "works" << static_cast<long long>(plan.works)));
+        }
+        bucketsBuilder.doneFast();
+        selectivityBob.doneFast();
+    }
+
+    // Describe what trials of the cached plan observed, if anything.
+    const auto& feedback = entry.cardinalityFeedback;
+    if (feedback.numTrials > 0 || feedback.numUnchangedReplans > 0) {
+        BSONObjBuilder feedbackBob(out->subobjStart("cardinalityFeedback"));
+        feedbackBob.append("trials", feedback.numTrials);
+        feedbackBob.append("avgTrialWorks", feedback.avgTrialWorks);
+        feedbackBob.append("avgTrialSelectivity", feedback.avgTrialSelectivity);
+        feedbackBob.append("unchangedReplans", feedback.numUnchangedReplans);
+        feedbackBob.doneFast();
+    }
+
     BSONObjBuilder cachedPlanBob(out->subobjStart("cachedPlan"));
     Explain::statsToBSON(
         *entry.decision->stats[0], &cachedPlanBob, ExplainOptions::Verbosity::kQueryPlanner);
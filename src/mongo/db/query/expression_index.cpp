@@ -29,8 +29,11 @@
 
 #include "mongo/db/query/expression_index.h"
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <unordered_set>
+#include <vector>
 
 #include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/geo/r2_region_coverer.h"
@@ -163,6 +166,58 @@ void S2CellIdsToIntervalsUnsorted(const std::vector<S2CellId>& intervalSet,
         }
     }
 }
+
+/**
+ * Merges neighbouring intervals of a sorted, non-overlapping list of version 3 cell id intervals,
+ * so that the index scan walks through them instead of seeking to each one. Leaf cell ids are odd,
+ * so when one interval ends at the leaf just before the first leaf of the next, the only id left
+ * between them is that of a cell containing both leaves. Such a cell is an ancestor of a cell in
+ * the covering, which the bounds either already include or which is coarser than anything
+ * indexed. Since 2dsphere bounds are always inexact and the geo predicate is applied to the
+ * fetched documents, scanning it anyway is harmless.
+ */
+void mergeAdjacentCellIntervals(OrderedIntervalList* oil) {
+    auto& intervals = oil->intervals;
+    if (intervals.size() < 2) {
+        return;
+    }
+
+    std::vector<Interval> merged;
+    merged.reserve(intervals.size());
+    long long start = intervals[0].start.numberLong();
+    long long end = intervals[0].end.numberLong();
+    bool needsRebuild = false;
+
+    auto flush = [&](size_t lastIndex, bool wasMerged) {
+        if (!wasMerged) {
+            merged.push_back(std::move(intervals[lastIndex]));
+            return;
+        }
+        BSONObjBuilder b;
+        b.append("start", start);
+        b.append("end", end);
+        merged.push_back(IndexBoundsBuilder::makeRangeInterval(
+            b.obj(), BoundInclusion::kIncludeBothStartAndEndKeys));
+    };
+
+    for (size_t i = 1; i < intervals.size(); ++i) {
+        const long long nextStart = intervals[i].start.numberLong();
+        const long long nextEnd = intervals[i].end.numberLong();
+        if (end < std::numeric_limits<long long>::max() - 1 && nextStart <= end + 2) {
+            end = std::max(end, nextEnd);
+            needsRebuild = true;
+            continue;
+        }
+
+        flush(i - 1, needsRebuild);
+        start = nextStart;
+        end = nextEnd;
+        needsRebuild = false;
+    }
+    flush(intervals.size() - 1, needsRebuild);
+
+    intervals = std::move(merged);
+}
 }  // namespace
 
 void ExpressionMapping::S2CellIdsToIntervals(const std::vector<S2CellId>& intervalSet,
@@ -173,6 +228,9 @@ void ExpressionMapping::S2CellIdsToIntervals(const std::vector<S2CellId>& interv
     // intervals are made
     S2CellIdsToIntervalsUnsorted(intervalSet, indexVersion, oilOut);
     std::sort(oilOut->intervals.begin(), oilOut->intervals.end(), compareIntervals);
+    if (indexVersion >= S2_INDEX_VERSION_3) {
+        mergeAdjacentCellIntervals(oilOut);
+    }
     // Make sure that our intervals don't overlap each other and are ordered correctly.
     // This perhaps should only be done in debug mode.
     if (!oilOut->isValidFor(1)) {
@@ -220,6 +278,9 @@ void ExpressionMapping::S2CellIdsToIntervalsWithParents(const std::vector<S2Cell
 
     S2CellIdsToIntervalsUnsorted(intervalSet, indexParams.indexVersion, oilOut);
     std::sort(oilOut->intervals.begin(), oilOut->intervals.end(), compareIntervals);
+    if (indexParams.indexVersion >= S2_INDEX_VERSION_3) {
+        mergeAdjacentCellIntervals(oilOut);
+    }
     // Make sure that our intervals don't overlap each other and are ordered correctly.
     // This perhaps should only be done in debug mode.
     if (!oilOut->isValidFor(1)) {
@@ -33,6 +33,8 @@
 
 #include "mongo/db/query/find_common.h"
 
+#include <algorithm>
+
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/curop_failpoint_helpers.h"
@@ -78,6 +80,26 @@ bool FindCommon::haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int
     return (bytesBuffered + nextDoc.objsize()) <= kMaxBytesToReturnToClientAtOnce;
 }
 
+int FindCommon::predictGetMoreBytes(std::uint64_t docsReturned,
+                                    std::uint64_t bytesReturned,
+                                    std::uint64_t batchesReturned,
+                                    long long effectiveBatchSize) {
+    if (!docsReturned || !batchesReturned) {
+        return 0;
+    }
+
+    const std::uint64_t maxBytes = kMaxBytesToReturnToClientAtOnce;
+    if (effectiveBatchSize <= 0) {
+        return std::min(bytesReturned / batchesReturned, maxBytes);
+    }
+
+    const std::uint64_t avgDocBytes = std::max<std::uint64_t>(bytesReturned / docsReturned, 1);
+    if (static_cast<std::uint64_t>(effectiveBatchSize) > maxBytes / avgDocBytes) {
+        return maxBytes;
+    }
+    return effectiveBatchSize * avgDocBytes;
+}
+
 void FindCommon::waitInFindBeforeMakingBatch(OperationContext* opCtx, const CanonicalQuery& cq) {
     auto whileWaitingFunc = [&, hasLogged = false]() mutable {
         if (!std::exchange(hasLogged, true)) {
@@ -120,6 +120,18 @@ public:
      */
     static bool haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int bytesBuffered);
 
+    /**
+     * Predicts the number of bytes of results the next getMore on a cursor will return, given the
+     * documents, bytes and batches the cursor has returned so far. With a batch size, this is the
+     * batch size times the average document size; without one, it is the average batch size in
+     * bytes. The prediction is capped at the size of the largest batch we will return, and is
+     * zero if the cursor has not returned any documents yet.
+     */
+    static int predictGetMoreBytes(std::uint64_t docsReturned,
+                                   std::uint64_t bytesReturned,
+                                   std::uint64_t batchesReturned,
+                                   long long effectiveBatchSize);
+
     /**
      * This function wraps waitWhileFailPointEnabled() on waitInFindBeforeMakingBatch.
      *
@@ -33,6 +33,7 @@
 
 #include "mongo/db/query/get_executor.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <limits>
 #include <memory>
@@ -69,6 +70,7 @@
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_cache_selectivity.h"
 #include "mongo/db/query/plan_executor.h"
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
@@ -86,6 +88,7 @@
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/operation_stack_sampler.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/logv2/log.h"
 #include "mongo/scripting/engine.h"
@@ -237,6 +240,44 @@ void applyIndexFilters(Collection* collection,
     }
 }
 
+namespace {
+/**
+ * Returns the union of the intervals of the leading shard key field which are spanned by the chunks
+ * owned according to 'collectionFilter', or boost::none if the collection has too many chunks for
+ * computing them on every query to be worthwhile.
+ */
+boost::optional<OrderedIntervalList> getShardKeyPrefixOwnedIntervals(
+    const ScopedCollectionFilter& collectionFilter) {
+    const auto& cm = *collectionFilter->getChunkManager();
+    if (cm.numChunks() > internalQueryShardFilterIndexBoundsMaxChunks.load()) {
+        return boost::none;
+    }
+
+    const auto& shardKeyPattern = cm.getShardKeyPattern().toBSON();
+
+    // With a compound shard key, a chunk may contain documents whose leading field is equal to the
+    // leading field of the chunk's upper bound, so the interval must include its end.
+    const auto boundInclusion = shardKeyPattern.nFields() == 1
+        ? BoundInclusion::kIncludeStartKeyOnly
+        : BoundInclusion::kIncludeBothStartAndEndKeys;
+
+    OrderedIntervalList oil(shardKeyPattern.firstElementFieldName());
+    for (const auto& chunk : cm.chunks()) {
+        if (chunk.getShardId() != collectionFilter->shardId()) {
+            continue;
+        }
+
+        BSONObjBuilder bob;
+        bob.appendAs(chunk.getMin().firstElement(), "");
+        bob.appendAs(chunk.getMax().firstElement(), "");
+        oil.intervals.push_back(IndexBoundsBuilder::makeRangeInterval(bob.obj(), boundInclusion));
+    }
+    IndexBoundsBuilder::unionize(&oil);
+
+    return oil;
+}
+}  // namespace
+
 void fillOutPlannerParams(OperationContext* opCtx,
                           Collection* collection,
                           CanonicalQuery* canonicalQuery,
@@ -274,6 +315,15 @@ void fillOutPlannerParams(OperationContext* opCtx,
             CollectionShardingState::get(opCtx, canonicalQuery->nss())->getCurrentMetadata();
         if (collMetadata->isSharded()) {
             plannerParams->shardKey = collMetadata->getKeyPattern();
+
+            // Use the same filter as the SHARDING_FILTER stage, which may be tied to the
+            // operation's 'atClusterTime', so that the intervals match what it lets through.
+            auto collectionFilter = CollectionShardingState::get(opCtx, canonicalQuery->nss())
+                                        ->getOwnershipFilter(opCtx);
+            if (collectionFilter.isSharded()) {
+                plannerParams->shardKeyPrefixOwnedIntervals =
+                    getShardKeyPrefixOwnedIntervals(collectionFilter);
+            }
         } else {
             // If there's no metadata don't bother w/the shard filter since we won't know what
             // the key pattern is anyway...
@@ -285,6 +335,10 @@ void fillOutPlannerParams(OperationContext* opCtx,
         plannerParams->options |= QueryPlannerParams::INDEX_INTERSECTION;
     }
 
+    if (internalQueryPlannerEnableIndexSkipScan.load()) {
+        plannerParams->options |= QueryPlannerParams::INDEX_SKIP_SCAN;
+    }
+
     if (internalQueryPlannerGenerateCoveredWholeIndexScans.load()) {
         plannerParams->options |= QueryPlannerParams::GENERATE_COVERED_IXSCANS;
     }
@@ -434,7 +488,7 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
             // document, so we don't support covered projections. However, we might use the
             // simple inclusion fast path.
             // Stuff the right data into the params depending on what proj impl we use.
-            if (!cqProjection->isSimple()) {
+            if (!cqProjection->isSimpleIgnoringDottedPaths()) {
                 root = std::make_unique<ProjectionStageDefault>(
                     canonicalQuery->getExpCtx(),
                     canonicalQuery->getQueryRequest().getProj(),
@@ -470,6 +524,7 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
             CollectionQueryInfo::get(collection).getPlanCache()->computeKey(*canonicalQuery);
         CurOp::get(opCtx)->debug().queryHash =
             canonical_query_encoder::computeHash(planCacheKey.getStableKeyStringData());
+        OperationStackSampler::setQueryHash(*CurOp::get(opCtx)->debug().queryHash);
         CurOp::get(opCtx)->debug().planCacheKey =
             canonical_query_encoder::computeHash(planCacheKey.toString());
 
@@ -477,6 +532,11 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
         if (auto cs = CollectionQueryInfo::get(collection)
                           .getPlanCache()
                           ->getCacheEntryIfActive(planCacheKey)) {
+            // If the entry remembers plans for different selectivities of this shape, start from
+            // the one recorded for the selectivity of this query's literals.
+            plan_cache_selectivity::choosePlanForSelectivity(
+                opCtx, collection, *canonicalQuery, plannerParams, cs.get());
+
             // We have a CachedSolution.  Have the planner turn it into a QuerySolution.
             auto statusWithQs = QueryPlanner::planFromCache(*canonicalQuery, plannerParams, *cs);
 
@@ -505,6 +565,7 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
                                                                          plannerParams,
                                                                          cs->decisionWorks,
                                                                          std::move(root));
+                cachedPlanStage->setCardinalityFeedback(cs->cardinalityFeedback);
                 return PrepareExecutionResult(std::move(canonicalQuery),
                                               std::move(querySolution),
                                               std::move(cachedPlanStage));
@@ -1066,9 +1127,28 @@ bool turnIxscanIntoCount(QuerySolution* soln) {
     BSONObj endKey;
     bool endKeyInclusive;
 
+    // Bounds made of several such intervals, like those of an $in, are counted one range after
+    // the other.
+    std::vector<IndexKeyRange> additionalRanges;
     if (!IndexBoundsBuilder::isSingleInterval(
             isn->bounds, &startKey, &startKeyInclusive, &endKey, &endKeyInclusive)) {
-        return false;
+        std::vector<IndexKeyRange> ranges;
+        if (!IndexBoundsBuilder::isUnionOfIntervals(
+                isn->bounds, internalQueryMaxScansToExplode.load(), &ranges)) {
+            return false;
+        }
+        invariant(ranges.size() > 1);
+
+        // The ranges are listed in the order of the index scan; the count scan wants index order.
+        if (isn->direction < 0) {
+            std::reverse(ranges.begin(), ranges.end());
+        }
+        startKey = std::move(ranges[0].startKey);
+        startKeyInclusive = ranges[0].startKeyInclusive;
+        endKey = std::move(ranges[0].endKey);
+        endKeyInclusive = ranges[0].endKeyInclusive;
+        additionalRanges.assign(std::make_move_iterator(ranges.begin() + 1),
+                                std::make_move_iterator(ranges.end()));
     }
 
     // Since count scans return no data, they are always forward scans. Index scans, on the other
@@ -1077,6 +1157,10 @@ bool turnIxscanIntoCount(QuerySolution* soln) {
     if (isn->direction < 0) {
         startKey.swap(endKey);
         std::swap(startKeyInclusive, endKeyInclusive);
+        for (auto& range : additionalRanges) {
+            range.startKey.swap(range.endKey);
+            std::swap(range.startKeyInclusive, range.endKeyInclusive);
+        }
     }
 
     // Make the count node that we replace the fetch + ixscan with.
@@ -1085,6 +1169,7 @@ bool turnIxscanIntoCount(QuerySolution* soln) {
     csn->startKeyInclusive = startKeyInclusive;
     csn->endKey = endKey;
     csn->endKeyInclusive = endKeyInclusive;
+    csn->additionalRanges = std::move(additionalRanges);
     // Takes ownership of 'cn' and deletes the old root.
     soln->root.reset(csn);
     return true;
@@ -1249,6 +1334,18 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorCount(
 // Distinct hack
 //
 
+namespace {
+
+/**
+ * Returns true if 'oil' is the single interval [MinKey, MaxKey], in either direction.
+ */
+bool isAllValues(const OrderedIntervalList& oil) {
+    return oil.intervals.size() == 1 &&
+        (oil.intervals[0].isMinToMax() || oil.intervals[0].reverseClone().isMinToMax());
+}
+
+}  // namespace
+
 bool turnIxscanIntoDistinctIxscan(QuerySolution* soln,
                                   const string& field,
                                   bool strictDistinctOnly) {
@@ -1312,13 +1409,6 @@ bool turnIxscanIntoDistinctIxscan(QuerySolution* soln,
         }
     }
 
-    // An additional filter must be applied to the data in the key, so we can't just skip
-    // all the keys with a given value; we must examine every one to find the one that (may)
-    // pass the filter.
-    if (indexScanNode->filter) {
-        return false;
-    }
-
     // We only set this when we have special query modifiers (.max() or .min()) or other
     // special cases.  Don't want to handle the interactions between those and distinct.
     // Don't think this will ever really be true but if it somehow is, just ignore this
@@ -1354,19 +1444,20 @@ bool turnIxscanIntoDistinctIxscan(QuerySolution* soln,
         }
     }
 
-    // We should not use a distinct scan if the field over which we are computing the distinct is
-    // multikey.
+    // A distinct scan over a field that may be multikey skips over the other array elements of
+    // the documents it visits. That is only safe when the values are then read from the fetched
+    // documents, which the distinct command does unless 'strictDistinctOnly' is set, and when
+    // every element of every matching document is itself within the bounds. This holds if the
+    // field's bounds cover all values and the key-level filter, which cannot be trusted on a
+    // multikey index, is absent.
     if (indexScanNode->index.multikey) {
         const auto& multikeyPaths = indexScanNode->index.multikeyPaths;
-        if (multikeyPaths.empty()) {
-            // We don't have path-level multikey information available.
-            return false;
-        }
-
-        if (!multikeyPaths[fieldNo].empty()) {
-            // Path-level multikey information indicates that the distinct key contains at least one
-            // array component.
-            return false;
+        if (multikeyPaths.empty() || !multikeyPaths[fieldNo].empty()) {
+            // The distinct key may contain, or is known to contain, an array component.
+            if (strictDistinctOnly || !fetchNode || indexScanNode->filter ||
+                !isAllValues(indexScanNode->bounds.fields[fieldNo])) {
+                return false;
+            }
         }
     }
 
@@ -1377,6 +1468,11 @@ bool turnIxscanIntoDistinctIxscan(QuerySolution* soln,
     distinctNode->queryCollator = indexScanNode->queryCollator;
     distinctNode->fieldNo = fieldNo;
 
+    // An additional filter must be applied to the data in the key. The distinct scan applies it
+    // to each key before skipping to the next value, so that a key that fails it does not hide a
+    // later key with the same value that passes.
+    distinctNode->filter = std::move(indexScanNode->filter);
+
     if (fetchNode) {
         // If the original plan had PROJECT and FETCH stages, we can get rid of the PROJECT
         // transforming the plan from PROJECT=>FETCH=>IXSCAN to FETCH=>DISTINCT_SCAN.
@@ -642,6 +642,11 @@ IndexBoundsChecker::KeyState IndexBoundsChecker::checkKey(const BSONObj& key, In
     // Field number 'firstNonContainedField' of the index key is after interval we think it's
     // in.  Fields 0 through 'firstNonContained-1' are within their current intervals and we can
     // ignore them.
+    //
+    // The search for that field's new interval can start right after its current one. Fields to
+    // its right may be anywhere relative to their current intervals once it moves, so they are
+    // searched from the start.
+    size_t searchStart = _curInterval[firstNonContainedField] + 1;
     while (firstNonContainedField < _curInterval.size()) {
         // Find the interval that contains our field.
         size_t newIntervalForField;
@@ -649,7 +654,9 @@ IndexBoundsChecker::KeyState IndexBoundsChecker::checkKey(const BSONObj& key, In
         Location where = findIntervalForField(keyValues[firstNonContainedField],
                                               _bounds->fields[firstNonContainedField],
                                               _expectedDirection[firstNonContainedField],
-                                              &newIntervalForField);
+                                              &newIntervalForField,
+                                              searchStart);
+        searchStart = 0;
 
         if (WITHIN == where) {
             // Found a new interval for field firstNonContainedField.  Move our internal choice
@@ -729,19 +736,33 @@ IndexBoundsChecker::Location IndexBoundsChecker::findIntervalForField(
     const BSONElement& elt,
     const OrderedIntervalList& oil,
     const int expectedDirection,
-    size_t* newIntervalIndex) {
+    size_t* newIntervalIndex,
+    size_t startIndex) {
     // Binary search for interval.
     // Intervals are ordered in the same direction as our keys.
     // Key behind all intervals: [BEHIND, ..., BEHIND]
     // Key ahead of all intervals: [AHEAD, ..., AHEAD]
     // Key within one interval: [AHEAD, ..., WITHIN, BEHIND, ...]
     // Key not in any inteval: [AHEAD, ..., AHEAD, BEHIND, ...]
+    invariant(startIndex <= oil.intervals.size());
+    const auto keyAndDirection = std::make_pair(elt, expectedDirection);
+
+    // Gallop forward from 'startIndex' with doubling steps until an interval the key is not
+    // ahead of is found, which narrows the binary search to the last step taken.
+    vector<Interval>::const_iterator lo = oil.intervals.begin() + startIndex;
+    vector<Interval>::const_iterator hi = oil.intervals.end();
+    for (size_t step = 1; step <= static_cast<size_t>(hi - lo); step *= 2) {
+        vector<Interval>::const_iterator probe = lo + (step - 1);
+        if (!isKeyAheadOfInterval(*probe, keyAndDirection)) {
+            hi = probe + 1;
+            break;
+        }
+        lo = probe + 1;
+    }
 
     // Find left-most BEHIND/WITHIN interval.
-    vector<Interval>::const_iterator i = std::lower_bound(oil.intervals.begin(),
-                                                          oil.intervals.end(),
-                                                          std::make_pair(elt, expectedDirection),
-                                                          isKeyAheadOfInterval);
+    vector<Interval>::const_iterator i =
+        std::lower_bound(lo, hi, keyAndDirection, isKeyAheadOfInterval);
 
     // Key ahead of all intervals.
     if (i == oil.intervals.end()) {
@@ -91,6 +91,17 @@ struct OrderedIntervalList {
     bool isMinToMax() const;
 };
 
+/**
+ * A contiguous range of keys of an index, from 'startKey' to 'endKey' in index order.
+ */
+struct IndexKeyRange {
+    BSONObj startKey;
+    bool startKeyInclusive = true;
+
+    BSONObj endKey;
+    bool endKeyInclusive = true;
+};
+
 /**
  * Tied to an index.  Permissible values for all fields in the index.  Requires the index to
  * interpret.  Previously known as FieldRangeVector.
@@ -260,14 +271,17 @@ public:
      *
      * If 'elt' cannot be advanced to any interval, return AHEAD.
      *
-     * Exposed for testing only.
+     * The caller may pass 'startIndex' if 'elt' is known to be ahead of every interval before it.
+     * The search gallops forward from there, so that moving to a nearby interval of a long list
+     * costs a few comparisons rather than a binary search of the whole list.
      *
-     * TODO(efficiency): Start search from a given index.
+     * Exposed for testing only.
      */
     static Location findIntervalForField(const BSONElement& elt,
                                          const OrderedIntervalList& oil,
                                          const int expectedDirection,
-                                         size_t* newIntervalIndex);
+                                         size_t* newIntervalIndex,
+                                         size_t startIndex = 0);
 
 private:
     /**
@@ -1327,4 +1327,56 @@ bool IndexBoundsBuilder::isSingleInterval(const IndexBounds& bounds,
     }
 }
 
+bool IndexBoundsBuilder::isUnionOfIntervals(const IndexBounds& bounds,
+                                            size_t maxRanges,
+                                            std::vector<IndexKeyRange>* rangesOut) {
+    // Each combination of one interval per field is a candidate range.
+    size_t numRanges = 1;
+    for (const auto& oil : bounds.fields) {
+        if (oil.intervals.empty()) {
+            return false;
+        }
+        numRanges *= oil.intervals.size();
+        if (numRanges > maxRanges) {
+            return false;
+        }
+    }
+
+    // Enumerate the combinations with the first field varying slowest, which visits them in the
+    // order the bounds traverse the index.
+    std::vector<IndexKeyRange> ranges;
+    ranges.reserve(numRanges);
+    std::vector<size_t> intervalIndexes(bounds.fields.size(), 0);
+    IndexBounds singleBounds;
+    singleBounds.fields.resize(bounds.fields.size());
+    for (size_t rangeNo = 0; rangeNo < numRanges; ++rangeNo) {
+        for (size_t fieldNo = 0; fieldNo < bounds.fields.size(); ++fieldNo) {
+            singleBounds.fields[fieldNo].intervals = {
+                bounds.fields[fieldNo].intervals[intervalIndexes[fieldNo]]};
+        }
+
+        IndexKeyRange range;
+        if (!isSingleInterval(singleBounds,
+                              &range.startKey,
+                              &range.startKeyInclusive,
+                              &range.endKey,
+                              &range.endKeyInclusive)) {
+            return false;
+        }
+        ranges.push_back(std::move(range));
+
+        for (size_t fieldNo = bounds.fields.size(); fieldNo-- > 0;) {
+            if (++intervalIndexes[fieldNo] < bounds.fields[fieldNo].intervals.size()) {
+                break;
+            }
+            intervalIndexes[fieldNo] = 0;
+        }
+    }
+
+    rangesOut->insert(rangesOut->end(),
+                      std::make_move_iterator(ranges.begin()),
+                      std::make_move_iterator(ranges.end()));
+    return true;
+}
+
 }  // namespace mongo
@@ -208,6 +208,16 @@ public:
                                  BSONObj* endKey,
                                  bool* endKeyInclusive);
 
+    /**
+     * Returns 'true' if the bounds 'bounds' can be represented as the union of at most
+     * 'maxRanges' disjoint key ranges, each of which satisfies isSingleInterval(). The ranges are
+     * appended to 'rangesOut' in the order the bounds traverse the index. Returns 'false'
+     * otherwise, in which case 'rangesOut' is left unchanged.
+     */
+    static bool isUnionOfIntervals(const IndexBounds& bounds,
+                                   size_t maxRanges,
+                                   std::vector<IndexKeyRange>* rangesOut);
+
 private:
     /**
      * Performs the heavy lifting for IndexBoundsBuilder::translate().
@@ -1072,4 +1072,33 @@ TEST(IndexBoundsCheckerTest, FindIntervalForField) {
     testFindIntervalForField(0, pointsObj, -1, IndexBoundsChecker::AHEAD, 0U);
 }
 
+TEST(IndexBoundsCheckerTest, FindIntervalForFieldFromStartIndex) {
+    // Point intervals on the even numbers 0 through 98.
+    OrderedIntervalList oil("foo");
+    for (int i = 0; i < 100; i += 2) {
+        oil.intervals.push_back(Interval(BSON("" << i << "" << i), true, true));
+    }
+
+    for (int key = -1; key <= 100; ++key) {
+        BSONObj keyObj = BSON("" << key);
+        size_t expectedIndex = 0;
+        IndexBoundsChecker::Location expected = IndexBoundsChecker::findIntervalForField(
+            keyObj.firstElement(), oil, 1, &expectedIndex);
+
+        // Any start index at or before the answer gives the same result as a full search.
+        size_t lastStart = expected == IndexBoundsChecker::AHEAD ? oil.intervals.size()
+                                                                  : expectedIndex;
+        for (size_t start = 0; start <= lastStart; ++start) {
+            size_t index = 0;
+            ASSERT_EQ(expected,
+                      IndexBoundsChecker::findIntervalForField(
+                          keyObj.firstElement(), oil, 1, &index, start))
+                << "key: " << key << ", start: " << start;
+            if (expected != IndexBoundsChecker::AHEAD) {
+                ASSERT_EQ(expectedIndex, index) << "key: " << key << ", start: " << start;
+            }
+        }
+    }
+}
+
 }  // namespace
@@ -31,6 +31,7 @@
 
 #include "mongo/db/query/internal_plans.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/catalog/database.h"
@@ -75,6 +76,41 @@ std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> InternalPlanner::collection
     return std::move(statusWithPlanExecutor.getValue());
 }
 
+std::vector<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>>
+InternalPlanner::partitionedCollectionScan(OperationContext* opCtx,
+                                           Collection* collection,
+                                           PlanExecutor::YieldPolicy yieldPolicy,
+                                           size_t numPartitions) {
+    invariant(collection);
+    invariant(numPartitions > 0);
+
+    const std::vector<RecordId> splitPoints =
+        _chooseRecordIdSplitPoints(opCtx, collection, numPartitions);
+
+    std::vector<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> executors;
+    executors.reserve(splitPoints.size() + 1);
+    for (size_t i = 0; i <= splitPoints.size(); ++i) {
+        boost::optional<RecordId> minRecord;
+        boost::optional<RecordId> maxRecord;
+        if (i > 0) {
+            minRecord = splitPoints[i - 1];
+        }
+        if (i < splitPoints.size()) {
+            maxRecord = splitPoints[i];
+        }
+
+        auto ws = std::make_unique<WorkingSet>();
+        auto cs = _collectionScan(opCtx, ws.get(), collection, FORWARD, minRecord, maxRecord);
+
+        // Takes ownership of 'ws' and 'cs'.
+        auto statusWithPlanExecutor =
+            PlanExecutor::make(opCtx, std::move(ws), std::move(cs), collection, yieldPolicy);
+        invariant(statusWithPlanExecutor.isOK());
+        executors.push_back(std::move(statusWithPlanExecutor.getValue()));
+    }
+    return executors;
+}
+
 std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> InternalPlanner::deleteWithCollectionScan(
     OperationContext* opCtx,
     Collection* collection,
@@ -183,11 +219,15 @@ std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> InternalPlanner::updateWith
 std::unique_ptr<PlanStage> InternalPlanner::_collectionScan(OperationContext* opCtx,
                                                             WorkingSet* ws,
                                                             const Collection* collection,
-                                                            Direction direction) {
+                                                            Direction direction,
+                                                            boost::optional<RecordId> minRecord,
+                                                            boost::optional<RecordId> maxRecord) {
     invariant(collection);
 
     CollectionScanParams params;
     params.shouldWaitForOplogVisibility = shouldWaitForOplogVisibility(opCtx, collection, false);
+    params.minRecord = std::move(minRecord);
+    params.maxRecord = std::move(maxRecord);
 
     if (FORWARD == direction) {
         params.direction = CollectionScanParams::FORWARD;
@@ -198,6 +238,52 @@ std::unique_ptr<PlanStage> InternalPlanner::_collectionScan(OperationContext* op
     return std::make_unique<CollectionScan>(opCtx, collection, params, ws, nullptr);
 }
 
+std::vector<RecordId> InternalPlanner::_chooseRecordIdSplitPoints(OperationContext* opCtx,
+                                                                  const Collection* collection,
+                                                                  size_t numPartitions) {
+    // Sampling several records per partition evens out the ranges without reading much of the
+    // collection.
+    const size_t kSamplesPerPartition = 10;
+
+    std::vector<RecordId> splitPoints;
+    if (numPartitions < 2) {
+        return splitPoints;
+    }
+
+    auto cursor = collection->getRecordStore()->getRandomCursor(opCtx);
+    if (!cursor) {
+        return splitPoints;
+    }
+
+    std::vector<RecordId> samples;
+    const size_t numSamples = numPartitions * kSamplesPerPartition;
+    samples.reserve(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+        samples.push_back(record->id);
+    }
+
+    // Random cursors may return the same record more than once.
+    std::sort(samples.begin(), samples.end());
+    samples.erase(std::unique(samples.begin(), samples.end()), samples.end());
+
+    if (samples.empty()) {
+        return splitPoints;
+    }
+
+    for (size_t i = 1; i < numPartitions; ++i) {
+        const RecordId& candidate = samples[i * samples.size() / numPartitions];
+        // With fewer samples than partitions the same sample may be picked more than once.
+        if (splitPoints.empty() || splitPoints.back() != candidate) {
+            splitPoints.push_back(candidate);
+        }
+    }
+    return splitPoints;
+}
+
 std::unique_ptr<PlanStage> InternalPlanner::_indexScan(OperationContext* opCtx,
                                                        WorkingSet* ws,
                                                        const Collection* collection,
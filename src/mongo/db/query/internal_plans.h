@@ -75,6 +75,22 @@ public:
         PlanExecutor::YieldPolicy yieldPolicy,
         const Direction direction = FORWARD);
 
+    /**
+     * Returns up to 'numPartitions' forward collection scans which between them return every record
+     * in 'collection' exactly once. Each scan covers a contiguous range of RecordIds, with range
+     * boundaries picked from a random sample of the collection so that the ranges hold a similar
+     * number of records. The executors are independent of one another, so they may be run
+     * concurrently once each has been attached to its own OperationContext.
+     *
+     * Fewer scans than requested are returned when the collection is too small to split that
+     * finely, and a single full scan is returned if the storage engine cannot sample records.
+     */
+    static std::vector<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>>
+    partitionedCollectionScan(OperationContext* opCtx,
+                              Collection* collection,
+                              PlanExecutor::YieldPolicy yieldPolicy,
+                              size_t numPartitions);
+
     /**
      * Returns a FETCH => DELETE plan.
      */
@@ -130,10 +146,22 @@ private:
      *
      * Used as a helper for collectionScan() and deleteWithCollectionScan().
      */
-    static std::unique_ptr<PlanStage> _collectionScan(OperationContext* opCtx,
-                                                      WorkingSet* ws,
-                                                      const Collection* collection,
-                                                      Direction direction);
+    static std::unique_ptr<PlanStage> _collectionScan(
+        OperationContext* opCtx,
+        WorkingSet* ws,
+        const Collection* collection,
+        Direction direction,
+        boost::optional<RecordId> minRecord = boost::none,
+        boost::optional<RecordId> maxRecord = boost::none);
+
+    /**
+     * Picks at most 'numPartitions' - 1 distinct RecordIds, in increasing order, which split
+     * 'collection' into ranges of similar size. Returns no split points if the storage engine
+     * cannot provide a random cursor.
+     */
+    static std::vector<RecordId> _chooseRecordIdSplitPoints(OperationContext* opCtx,
+                                                            const Collection* collection,
+                                                            size_t numPartitions);
 
     /**
      * Returns a plan stage that is either an index scan or an index scan with a fetch stage.
@@ -163,6 +163,20 @@ bool PlanCache::shouldCacheQuery(const CanonicalQuery& query) {
     return true;
 }
 
+//
+// PlanCacheCardinalityFeedback
+//
+
+void PlanCacheCardinalityFeedback::recordTrial(size_t works, size_t results) {
+    // Average the first trials evenly, then keep a moving average over about this many trials.
+    const long long kWindow = 16;
+    ++numTrials;
+    const double weight = 1.0 / std::min(numTrials, kWindow);
+    const double selectivity = static_cast<double>(results) / std::max<size_t>(works, 1);
+    avgTrialWorks += weight * (works - avgTrialWorks);
+    avgTrialSelectivity += weight * (selectivity - avgTrialSelectivity);
+}
+
 //
 // CachedSolution
 //
@@ -174,13 +188,19 @@ CachedSolution::CachedSolution(const PlanCacheKey& key, const PlanCacheEntry& en
       sort(entry.sort.getOwned()),
       projection(entry.projection.getOwned()),
       collation(entry.collation.getOwned()),
-      decisionWorks(entry.works) {
+      decisionWorks(entry.works),
+      selectivityProbeIndex(entry.selectivityProbeIndex),
+      selectivityProbePlan(entry.selectivityProbePlan),
+      cardinalityFeedback(entry.cardinalityFeedback) {
     // CachedSolution should not having any references into
     // cache entry. All relevant data should be cloned/copied.
     for (size_t i = 0; i < entry.plannerData.size(); ++i) {
         verify(entry.plannerData[i]);
         plannerData[i] = entry.plannerData[i]->clone();
     }
+    for (auto&& [bucket, plan] : entry.selectivityPlans) {
+        selectivityPlans.emplace(bucket, plan.clone());
+    }
 }
 
 CachedSolution::~CachedSolution() {
@@ -287,18 +307,25 @@ std::unique_ptr<PlanCacheEntry> PlanCacheEntry::clone() const {
     }
 
     auto decisionPtr = std::unique_ptr<PlanRankingDecision>(decision->clone());
-    return std::unique_ptr<PlanCacheEntry>(new PlanCacheEntry(std::move(solutionCacheData),
-                                                              query,
-                                                              sort,
-                                                              projection,
-                                                              collation,
-                                                              timeOfCreation,
-                                                              queryHash,
-                                                              planCacheKey,
-                                                              std::move(decisionPtr),
-                                                              feedback,
-                                                              isActive,
-                                                              works));
+    auto entry = std::unique_ptr<PlanCacheEntry>(new PlanCacheEntry(std::move(solutionCacheData),
+                                                                    query,
+                                                                    sort,
+                                                                    projection,
+                                                                    collation,
+                                                                    timeOfCreation,
+                                                                    queryHash,
+                                                                    planCacheKey,
+                                                                    std::move(decisionPtr),
+                                                                    feedback,
+                                                                    isActive,
+                                                                    works));
+    for (auto&& [bucket, plan] : selectivityPlans) {
+        entry->selectivityPlans.emplace(bucket, plan.clone());
+    }
+    entry->selectivityProbeIndex = selectivityProbeIndex;
+    entry->selectivityProbePlan = selectivityProbePlan;
+    entry->cardinalityFeedback = cardinalityFeedback;
+    return entry;
 }
 
 uint64_t PlanCacheEntry::_estimateObjectSizeInBytes() const {
@@ -428,9 +455,31 @@ std::string SolutionCacheData::toString() const {
 // PlanCache
 //
 
-PlanCache::PlanCache() : PlanCache(internalQueryCacheSize.load()) {}
+namespace {
+/**
+ * Records 'winner' as the plan to use for queries whose probed selectivity falls in the bucket
+ * of 'selectivityProbe'.
+ */
+void recordSelectivityPlan(const PlanCacheSelectivityProbe& selectivityProbe,
+                           const QuerySolution& winner,
+                           size_t works,
+                           PlanCacheEntry* entry) {
+    invariant(winner.cacheData);
+    entry->selectivityPlans[selectivityProbe.bucket] = {
+        std::unique_ptr<const SolutionCacheData>(winner.cacheData->clone()), works};
+}
+}  // namespace
+
+PlanCache::PlanCache()
+    : PlanCache(internalQueryCacheSize.load(), internalQueryCachePartitions.load()) {}
 
-PlanCache::PlanCache(size_t size) : _cache(size) {}
+PlanCache::PlanCache(size_t size, size_t numPartitions) {
+    invariant(numPartitions > 0);
+    const size_t partitionSize = (size + numPartitions - 1) / numPartitions;
+    for (size_t i = 0; i < numPartitions; i++) {
+        _partitions.push_back(std::make_unique<Partition>(partitionSize));
+    }
+}
 
 PlanCache::~PlanCache() {}
 
@@ -572,7 +621,8 @@ Status PlanCache::set(const CanonicalQuery& query,
                       const std::vector<QuerySolution*>& solns,
                       std::unique_ptr<PlanRankingDecision> why,
                       Date_t now,
-                      boost::optional<double> worksGrowthCoefficient) {
+                      boost::optional<double> worksGrowthCoefficient,
+                      const PlanCacheSelectivityProbe* selectivityProbe) {
     invariant(why);
 
     if (solns.empty()) {
@@ -596,18 +646,25 @@ Status PlanCache::set(const CanonicalQuery& query,
 
     const auto key = computeKey(query);
     const size_t newWorks = why->stats[0]->common.works;
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& partition = _getPartition(key);
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
     bool isNewEntryActive = false;
     uint32_t queryHash;
     uint32_t planCacheKey;
+    PlanCacheEntry* oldEntry = nullptr;
     if (internalQueryCacheDisableInactiveEntries.load()) {
         // All entries are always active.
         isNewEntryActive = true;
         planCacheKey = canonical_query_encoder::computeHash(key.stringData());
         queryHash = canonical_query_encoder::computeHash(key.getStableKeyStringData());
+        if (selectivityProbe || internalQueryCacheCardinalityFeedback.load()) {
+            // Only needed to carry the selectivity plans and cardinality feedback over to the new
+            // entry.
+            Status cacheStatus = partition.cache.get(key, &oldEntry);
+            invariant(cacheStatus.isOK() || cacheStatus == ErrorCodes::NoSuchKey);
+        }
     } else {
-        PlanCacheEntry* oldEntry = nullptr;
-        Status cacheStatus = _cache.get(key, &oldEntry);
+        Status cacheStatus = partition.cache.get(key, &oldEntry);
         invariant(cacheStatus.isOK() || cacheStatus == ErrorCodes::NoSuchKey);
         if (oldEntry) {
             queryHash = oldEntry->queryHash;
@@ -626,6 +683,10 @@ Status PlanCache::set(const CanonicalQuery& query,
             worksGrowthCoefficient.get_value_or(internalQueryCacheWorksGrowthCoefficient));
 
         if (!newState.shouldBeCreated) {
+            if (selectivityProbe && oldEntry &&
+                oldEntry->selectivityProbeIndex == selectivityProbe->indexName) {
+                recordSelectivityPlan(*selectivityProbe, *solns[0], newWorks, oldEntry);
+            }
             return Status::OK();
         }
         isNewEntryActive = newState.shouldBeActive;
@@ -634,9 +695,31 @@ Status PlanCache::set(const CanonicalQuery& query,
     auto newEntry(PlanCacheEntry::create(
         solns, std::move(why), query, queryHash, planCacheKey, now, isNewEntryActive, newWorks));
 
-    std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(key, newEntry.release());
+    if (selectivityProbe) {
+        // Keep what earlier replans learnt about other buckets, as long as it was measured
+        // against the same index.
+        if (oldEntry && oldEntry->selectivityProbeIndex == selectivityProbe->indexName) {
+            for (auto&& [bucket, plan] : oldEntry->selectivityPlans) {
+                newEntry->selectivityPlans.emplace(bucket, plan.clone());
+            }
+        }
+        newEntry->selectivityProbeIndex = selectivityProbe->indexName;
+        newEntry->selectivityProbePlan = selectivityProbe->solutionIndex;
+        recordSelectivityPlan(*selectivityProbe, *solns[0], newWorks, newEntry.get());
+    }
+
+    if (oldEntry && internalQueryCacheCardinalityFeedback.load() &&
+        oldEntry->plannerData[0]->toString() == newEntry->plannerData[0]->toString()) {
+        // Replanning picked the plan that was already cached, so what its trials observed still
+        // holds.
+        newEntry->cardinalityFeedback = oldEntry->cardinalityFeedback;
+        ++newEntry->cardinalityFeedback.numUnchangedReplans;
+    }
+
+    std::unique_ptr<PlanCacheEntry> evictedEntry = partition.cache.add(key, newEntry.release());
 
     if (nullptr != evictedEntry.get()) {
+        partition.numEvictions++;
         LOGV2_DEBUG(20942,
                     1,
                     "{query_nss}: plan cache maximum size exceeded - removed least recently used "
@@ -655,9 +738,10 @@ void PlanCache::deactivate(const CanonicalQuery& query) {
     }
 
     PlanCacheKey key = computeKey(query);
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& partition = _getPartition(key);
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
     PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         invariant(cacheStatus == ErrorCodes::NoSuchKey);
         return;
@@ -672,14 +756,17 @@ PlanCache::GetResult PlanCache::get(const CanonicalQuery& query) const {
 }
 
 PlanCache::GetResult PlanCache::get(const PlanCacheKey& key) const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& partition = _getPartition(key);
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
     PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         invariant(cacheStatus == ErrorCodes::NoSuchKey);
+        partition.numMisses++;
         return {CacheEntryState::kNotPresent, nullptr};
     }
     invariant(entry);
+    partition.numHits++;
 
     auto state =
         entry->isActive ? CacheEntryState::kPresentActive : CacheEntryState::kPresentInactive;
@@ -689,9 +776,10 @@ PlanCache::GetResult PlanCache::get(const PlanCacheKey& key) const {
 Status PlanCache::feedback(const CanonicalQuery& cq, double score) {
     PlanCacheKey ck = computeKey(cq);
 
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& partition = _getPartition(ck);
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(ck, &entry);
+    Status cacheStatus = partition.cache.get(ck, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -705,14 +793,36 @@ Status PlanCache::feedback(const CanonicalQuery& cq, double score) {
     return Status::OK();
 }
 
+Status PlanCache::recordCardinalityFeedback(const CanonicalQuery& cq,
+                                            size_t trialWorks,
+                                            size_t trialResults) {
+    PlanCacheKey ck = computeKey(cq);
+
+    auto& partition = _getPartition(ck);
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
+    PlanCacheEntry* entry;
+    Status cacheStatus = partition.cache.get(ck, &entry);
+    if (!cacheStatus.isOK()) {
+        return cacheStatus;
+    }
+    invariant(entry);
+
+    entry->cardinalityFeedback.recordTrial(trialWorks, trialResults);
+    return Status::OK();
+}
+
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    PlanCacheKey key = computeKey(canonicalQuery);
+    auto& partition = _getPartition(key);
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
+    return partition.cache.remove(key);
 }
 
 void PlanCache::clear() {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    _cache.clear();
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> cacheLock(partition->mutex);
+        partition->cache.clear();
+    }
 }
 
 PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
@@ -726,9 +836,10 @@ PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
 StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQuery& query) const {
     PlanCacheKey key = computeKey(query);
 
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& partition = _getPartition(key);
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -738,20 +849,26 @@ StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQ
 }
 
 std::vector<std::unique_ptr<PlanCacheEntry>> PlanCache::getAllEntries() const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
     std::vector<std::unique_ptr<PlanCacheEntry>> entries;
 
-    for (auto&& cacheEntry : _cache) {
-        auto entry = cacheEntry.second;
-        entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> cacheLock(partition->mutex);
+        for (auto&& cacheEntry : partition->cache) {
+            auto entry = cacheEntry.second;
+            entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
+        }
     }
 
     return entries;
 }
 
 size_t PlanCache::size() const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    return _cache.size();
+    size_t size = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> cacheLock(partition->mutex);
+        size += partition->cache.size();
+    }
+    return size;
 }
 
 void PlanCache::notifyOfIndexUpdates(const std::vector<CoreIndexInfo>& indexCores) {
@@ -762,17 +879,54 @@ std::vector<BSONObj> PlanCache::getMatchingStats(
     const std::function<BSONObj(const PlanCacheEntry&)>& serializationFunc,
     const std::function<bool(const BSONObj&)>& filterFunc) const {
     std::vector<BSONObj> results;
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
 
-    for (auto&& cacheEntry : _cache) {
-        const auto entry = cacheEntry.second;
-        auto serializedEntry = serializationFunc(*entry);
-        if (filterFunc(serializedEntry)) {
-            results.push_back(serializedEntry);
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> cacheLock(partition->mutex);
+        for (auto&& cacheEntry : partition->cache) {
+            const auto entry = cacheEntry.second;
+            auto serializedEntry = serializationFunc(*entry);
+            if (filterFunc(serializedEntry)) {
+                results.push_back(serializedEntry);
+            }
         }
     }
 
     return results;
 }
 
+std::vector<PlanCache::PartitionStats> PlanCache::getPartitionStats() const {
+    std::vector<PartitionStats> results;
+
+    for (size_t i = 0; i < _partitions.size(); i++) {
+        auto& partition = *_partitions[i];
+        stdx::lock_guard<Latch> cacheLock(partition.mutex);
+
+        PartitionStats stats;
+        stats.partition = i;
+        stats.numEntries = partition.cache.size();
+        stats.maxEntries = partition.maxEntries;
+        stats.numHits = partition.numHits;
+        stats.numMisses = partition.numMisses;
+        stats.numEvictions = partition.numEvictions;
+        results.push_back(stats);
+    }
+
+    return results;
+}
+
+BSONObj PlanCache::PartitionStats::toBSON() const {
+    BSONObjBuilder bob;
+    bob.appendNumber("partition", static_cast<long long>(partition));
+    bob.appendNumber("numEntries", static_cast<long long>(numEntries));
+    bob.appendNumber("maxEntries", static_cast<long long>(maxEntries));
+    bob.appendNumber("numHits", numHits);
+    bob.appendNumber("numMisses", numMisses);
+    bob.appendNumber("numEvictions", numEvictions);
+    return bob.obj();
+}
+
+PlanCache::Partition& PlanCache::_getPartition(const PlanCacheKey& key) const {
+    return *_partitions[PlanCacheKeyHasher{}(key) % _partitions.size()];
+}
+
 }  // namespace mongo
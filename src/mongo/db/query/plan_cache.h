@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional/optional.hpp>
+#include <map>
 #include <set>
 
 #include "mongo/db/exec/plan_stats.h"
@@ -264,6 +265,55 @@ struct SolutionCacheData {
     bool indexFilterApplied;
 };
 
+/**
+ * A plan recorded as the winner for one selectivity bucket of a query shape, along with the
+ * number of works it took to win.
+ */
+struct PlanCacheSelectivityPlan {
+    PlanCacheSelectivityPlan clone() const {
+        return {std::unique_ptr<const SolutionCacheData>(solution->clone()), works};
+    }
+
+    std::unique_ptr<const SolutionCacheData> solution;
+    size_t works = 0;
+};
+
+/**
+ * The result of probing the selectivity of a query before its winning plan is written to the
+ * cache. See plan_cache_selectivity.h.
+ */
+struct PlanCacheSelectivityProbe {
+    // The index whose keys were counted.
+    std::string indexName;
+
+    // The position, among the solutions passed to PlanCache::set(), of the solution whose leading
+    // index scan supplied the bounds that were probed.
+    size_t solutionIndex = 0;
+
+    // The coarse selectivity bucket the count of keys fell in.
+    int bucket = 0;
+};
+
+/**
+ * What the trials of a cached plan observed about the cardinality of its shape, kept when
+ * internalQueryCacheCardinalityFeedback is enabled.
+ */
+struct PlanCacheCardinalityFeedback {
+    /**
+     * Adds a trial of the cached plan that ended without a replan after 'works' works and
+     * 'results' results. The averages weigh recent trials more once there have been many.
+     */
+    void recordTrial(size_t works, size_t results);
+
+    // The trials recorded, and the average number of works and of results per work they took.
+    long long numTrials = 0;
+    double avgTrialWorks = 0;
+    double avgTrialSelectivity = 0;
+
+    // How many times in a row replanning the shape picked the plan that was already cached.
+    long long numUnchangedReplans = 0;
+};
+
 class PlanCacheEntry;
 
 /**
@@ -298,6 +348,14 @@ public:
     // The number of work cycles taken to decide on a winning plan when the plan was first
     // cached.
     size_t decisionWorks;
+
+    // Copies of the entry's selectivity bucket plans and of the description of its probe.
+    std::map<int, PlanCacheSelectivityPlan> selectivityPlans;
+    std::string selectivityProbeIndex;
+    size_t selectivityProbePlan = 0;
+
+    // A copy of the entry's cardinality feedback.
+    PlanCacheCardinalityFeedback cardinalityFeedback;
 };
 
 /**
@@ -378,6 +436,20 @@ public:
     // cause this value to be increased.
     size_t works = 0;
 
+    // Winning plans recorded for coarse selectivity buckets of this shape, keyed by bucket. A
+    // query whose probed selectivity falls in one of these buckets starts with that bucket's plan
+    // instead of plannerData[0]. Empty until a replan of the shape records a bucket.
+    std::map<int, PlanCacheSelectivityPlan> selectivityPlans;
+
+    // The index whose keys the selectivity probe counts, and the position in 'plannerData' of the
+    // plan whose leading index scan on that index supplies the bounds to count within.
+    std::string selectivityProbeIndex;
+    size_t selectivityProbePlan = 0;
+
+    // What trials of the cached plan observed. Carried over to the entry that replaces this one
+    // if it caches the same plan.
+    PlanCacheCardinalityFeedback cardinalityFeedback;
+
     /**
      * Tracks the approximate cumulative size of the plan cache entries across all the collections.
      */
@@ -457,11 +529,32 @@ public:
     static bool shouldCacheQuery(const CanonicalQuery& query);
 
     /**
-     * If omitted, namespace set to empty string.
+     * Counters describing one partition of the cache. Reported by $planCacheStats when it is asked
+     * for partition statistics.
+     */
+    struct PartitionStats {
+        BSONObj toBSON() const;
+
+        size_t partition = 0;
+        size_t numEntries = 0;
+        size_t maxEntries = 0;
+        long long numHits = 0;
+        long long numMisses = 0;
+        long long numEvictions = 0;
+    };
+
+    /**
+     * Sized by 'internalQueryCacheSize' and split into 'internalQueryCachePartitions' partitions.
      */
     PlanCache();
 
-    PlanCache(size_t size);
+    /**
+     * The 'size' entries are spread over 'numPartitions' partitions, each of which is an
+     * independent LRU store with its own lock. Keys are assigned to partitions by hash, so the
+     * entry evicted when a partition is full is the least recently used one of that partition
+     * rather than of the whole cache.
+     */
+    PlanCache(size_t size, size_t numPartitions = 1);
 
     ~PlanCache();
 
@@ -477,13 +570,18 @@ public:
      * an inactive cache entry.  If boost::none is provided, the function will use
      * 'internalQueryCacheWorksGrowthCoefficient'.
      *
+     * If 'selectivityProbe' is provided, the winning plan is also recorded, along with any plans
+     * already recorded against the same probe index, as the plan for the probed selectivity
+     * bucket.
+     *
      * If the mapping was set successfully, returns Status::OK(), even if it evicted another entry.
      */
     Status set(const CanonicalQuery& query,
                const std::vector<QuerySolution*>& solns,
                std::unique_ptr<PlanRankingDecision> why,
                Date_t now,
-               boost::optional<double> worksGrowthCoefficient = boost::none);
+               boost::optional<double> worksGrowthCoefficient = boost::none,
+               const PlanCacheSelectivityProbe* selectivityProbe = nullptr);
 
     /**
      * Set a cache entry back to the 'inactive' state. Rather than completely evicting an entry
@@ -531,6 +629,15 @@ public:
      */
     Status feedback(const CanonicalQuery& cq, double score);
 
+    /**
+     * Records in the entry corresponding to 'cq' that a trial of its cached plan ended without a
+     * replan after 'trialWorks' works and 'trialResults' results. Returns an error Status if the
+     * entry isn't in the cache anymore.
+     */
+    Status recordCardinalityFeedback(const CanonicalQuery& cq,
+                                     size_t trialWorks,
+                                     size_t trialResults);
+
     /**
      * Remove the entry corresponding to 'ck' from the cache.  Returns Status::OK() if the plan
      * was present and removed and an error status otherwise.
@@ -588,7 +695,32 @@ public:
         const std::function<BSONObj(const PlanCacheEntry&)>& serializationFunc,
         const std::function<bool(const BSONObj&)>& filterFunc) const;
 
+    /**
+     * Returns the counters of every partition, ordered by partition number.
+     */
+    std::vector<PartitionStats> getPartitionStats() const;
+
 private:
+    /**
+     * An independent LRU store holding the entries whose keys hash to it.
+     */
+    struct Partition {
+        explicit Partition(size_t maxEntries) : maxEntries(maxEntries), cache(maxEntries) {}
+
+        const size_t maxEntries;
+
+        // Protects all of the members below.
+        Mutex mutex = MONGO_MAKE_LATCH("PlanCache::Partition::mutex");
+
+        LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> cache;
+
+        long long numHits = 0;
+        long long numMisses = 0;
+        long long numEvictions = 0;
+    };
+
+    Partition& _getPartition(const PlanCacheKey& key) const;
+
     struct NewEntryState {
         bool shouldBeCreated = false;
         bool shouldBeActive = false;
@@ -601,10 +733,9 @@ private:
                                    size_t newWorks,
                                    double growthCoefficient);
 
-    LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> _cache;
-
-    // Protects _cache.
-    mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("PlanCache::_cacheMutex");
+    // The cache entries, sharded by key hash so that lookups of different query shapes rarely
+    // contend on the same lock. The set of partitions is fixed at construction.
+    std::vector<std::unique_ptr<Partition>> _partitions;
 
     // Holds computed information about the collection's indexes.  Used for generating plan
     // cache keys.
@@ -0,0 +1,199 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cache_selectivity.h"
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_planner.h"
+#include "mongo/logv2/log.h"
+
+namespace mongo {
+namespace plan_cache_selectivity {
+
+int bucketForKeyCount(long long numKeys) {
+    int bucket = 0;
+    for (; numKeys > 0; numKeys /= 10) {
+        bucket++;
+    }
+    return bucket;
+}
+
+const IndexScanNode* findLeadingIndexScan(const QuerySolutionNode* root) {
+    const QuerySolutionNode* node = root;
+    while (node && node->getType() != STAGE_IXSCAN) {
+        if (node->children.size() != 1) {
+            return nullptr;
+        }
+        node = node->children[0];
+    }
+    return static_cast<const IndexScanNode*>(node);
+}
+
+boost::optional<int> probe(OperationContext* opCtx,
+                           const Collection* collection,
+                           const IndexScanNode& ixscan) {
+    const long long maxKeys = internalQueryCacheSelectivityProbeMaxKeys.load();
+    if (maxKeys <= 0) {
+        return boost::none;
+    }
+
+    BSONObj startKey;
+    bool startKeyInclusive;
+    BSONObj endKey;
+    bool endKeyInclusive;
+    if (!IndexBoundsBuilder::isSingleInterval(
+            ixscan.bounds, &startKey, &startKeyInclusive, &endKey, &endKeyInclusive)) {
+        return boost::none;
+    }
+
+    // The keys are always counted in index order.
+    if (ixscan.direction < 0) {
+        startKey.swap(endKey);
+        std::swap(startKeyInclusive, endKeyInclusive);
+    }
+
+    const auto indexCatalog = collection->getIndexCatalog();
+    const auto descriptor =
+        indexCatalog->findIndexByName(opCtx, ixscan.index.identifier.catalogName);
+    if (!descriptor) {
+        return boost::none;
+    }
+    const auto accessMethod = indexCatalog->getEntry(descriptor)->accessMethod();
+
+    long long numKeys = 0;
+    try {
+        auto cursor = accessMethod->newCursor(opCtx);
+        cursor->setEndPosition(endKey, endKeyInclusive);
+
+        auto keyStringForSeek = IndexEntryComparison::makeKeyStringFromBSONKeyForSeek(
+            startKey,
+            accessMethod->getSortedDataInterface()->getKeyStringVersion(),
+            accessMethod->getSortedDataInterface()->getOrdering(),
+            true, /* forward */
+            startKeyInclusive);
+
+        const auto kJustExistance = SortedDataInterface::Cursor::kJustExistance;
+        for (auto entry = cursor->seek(keyStringForSeek); entry && numKeys < maxKeys;
+             entry = cursor->next(kJustExistance)) {
+            numKeys++;
+        }
+    } catch (const WriteConflictException&) {
+        return boost::none;
+    }
+
+    return bucketForKeyCount(numKeys);
+}
+
+boost::optional<PlanCacheSelectivityProbe> probeSolutions(
+    OperationContext* opCtx,
+    const Collection* collection,
+    const std::vector<QuerySolution*>& solutions) {
+    const IndexScanNode* probeScan = nullptr;
+    size_t probeSolution = 0;
+    for (size_t i = 0; i < solutions.size(); i++) {
+        const auto ixscan = findLeadingIndexScan(solutions[i]->root.get());
+        if (ixscan &&
+            (!probeScan ||
+             ixscan->index.identifier.catalogName < probeScan->index.identifier.catalogName)) {
+            probeScan = ixscan;
+            probeSolution = i;
+        }
+    }
+
+    if (!probeScan) {
+        return boost::none;
+    }
+
+    const auto bucket = probe(opCtx, collection, *probeScan);
+    if (!bucket) {
+        return boost::none;
+    }
+
+    return PlanCacheSelectivityProbe{
+        probeScan->index.identifier.catalogName, probeSolution, *bucket};
+}
+
+bool choosePlanForSelectivity(OperationContext* opCtx,
+                              const Collection* collection,
+                              const CanonicalQuery& query,
+                              const QueryPlannerParams& params,
+                              CachedSolution* cachedSolution) {
+    if (cachedSolution->selectivityPlans.empty() ||
+        internalQueryCacheSelectivityProbeMaxKeys.load() <= 0) {
+        return false;
+    }
+    invariant(cachedSolution->selectivityProbePlan < cachedSolution->plannerData.size());
+
+    // Rebuild the plan whose leading index scan was probed when the buckets were recorded, to get
+    // that scan's bounds for this query's literals.
+    auto probeSolution = QueryPlanner::planFromCache(
+        query, params, *cachedSolution->plannerData[cachedSolution->selectivityProbePlan]);
+    if (!probeSolution.isOK()) {
+        return false;
+    }
+
+    const auto probeScan = findLeadingIndexScan(probeSolution.getValue()->root.get());
+    if (!probeScan ||
+        probeScan->index.identifier.catalogName != cachedSolution->selectivityProbeIndex) {
+        return false;
+    }
+
+    const auto bucket = probe(opCtx, collection, *probeScan);
+    if (!bucket) {
+        return false;
+    }
+
+    auto plan = cachedSolution->selectivityPlans.find(*bucket);
+    if (plan == cachedSolution->selectivityPlans.end()) {
+        return false;
+    }
+
+    LOGV2_DEBUG(5212006,
+                2,
+                "Using the cached plan recorded for the selectivity bucket of the query",
+                "query"_attr = redact(query.toStringShort()),
+                "bucket"_attr = *bucket);
+
+    delete cachedSolution->plannerData[0];
+    cachedSolution->plannerData[0] = plan->second.solution->clone();
+    cachedSolution->decisionWorks = plan->second.works;
+    return true;
+}
+
+}  // namespace plan_cache_selectivity
+}  // namespace mongo
@@ -0,0 +1,102 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <vector>
+
+#include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/query_planner_params.h"
+#include "mongo/db/query/query_solution.h"
+
+namespace mongo {
+
+class Collection;
+class OperationContext;
+
+/**
+ * Coarse selectivity estimates used to keep several plans per plan cache entry.
+ *
+ * The selectivity of a query is measured by counting, up to
+ * 'internalQueryCacheSelectivityProbeMaxKeys', the keys within the bounds of the leading index
+ * scan of one of its candidate plans. The count is reduced to a bucket per order of magnitude, so
+ * queries of one shape whose literals select similar numbers of keys share a bucket. Replanning
+ * a cached query records its new winner for its bucket, and later queries which probe into that
+ * bucket start from that plan rather than replanning again.
+ */
+namespace plan_cache_selectivity {
+
+/**
+ * Maps a count of index keys to a selectivity bucket: 0 for no keys, and otherwise one plus the
+ * number of decimal digits after the first, so 1-9 keys map to 1, 10-99 to 2 and so on.
+ */
+int bucketForKeyCount(long long numKeys);
+
+/**
+ * Returns the index scan at the bottom of the chain of single-child nodes starting at 'root', or
+ * nullptr if the chain ends with anything else. The bounds of such a scan bound the whole result
+ * of the plan.
+ */
+const IndexScanNode* findLeadingIndexScan(const QuerySolutionNode* root);
+
+/**
+ * Counts the keys within the bounds of 'ixscan', stopping once
+ * 'internalQueryCacheSelectivityProbeMaxKeys' have been seen, and returns their bucket. Returns
+ * boost::none if probing is disabled, the bounds are not a single interval, the index no longer
+ * exists or the probe hit a write conflict.
+ */
+boost::optional<int> probe(OperationContext* opCtx,
+                           const Collection* collection,
+                           const IndexScanNode& ixscan);
+
+/**
+ * Probes the selectivity of the query the candidate 'solutions' answer. The probe uses the
+ * leading index scan on the index with the smallest name, so that every query of a shape is
+ * measured against the same index whichever plan wins for it. Returns boost::none if no solution
+ * has a leading index scan or the probe fails.
+ */
+boost::optional<PlanCacheSelectivityProbe> probeSolutions(
+    OperationContext* opCtx,
+    const Collection* collection,
+    const std::vector<QuerySolution*>& solutions);
+
+/**
+ * If 'cachedSolution' has plans recorded for selectivity buckets, probes the selectivity of
+ * 'query' and, if a plan was recorded for its bucket, makes that plan the one 'cachedSolution'
+ * is planned from and that plan's works its 'decisionWorks'. Returns whether it did so.
+ */
+bool choosePlanForSelectivity(OperationContext* opCtx,
+                              const Collection* collection,
+                              const CanonicalQuery& query,
+                              const QueryPlannerParams& params,
+                              CachedSolution* cachedSolution);
+
+}  // namespace plan_cache_selectivity
+}  // namespace mongo
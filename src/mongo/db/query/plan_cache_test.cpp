@@ -569,6 +569,149 @@ TEST(PlanCacheTest, PlanCacheLRUPolicyRemovesInactiveEntries) {
     ASSERT_EQ(planCache.get(*cqC).state, PlanCache::CacheEntryState::kPresentInactive);
 }
 
+TEST(PlanCacheTest, PartitionedPlanCacheTracksEntriesAndCountersPerPartition) {
+    const size_t kCacheSize = 100;
+    const size_t kNumPartitions = 4;
+    PlanCache planCache(kCacheSize, kNumPartitions);
+    QueryTestServiceContext serviceContext;
+
+    const std::vector<std::string> fields = {"a", "b", "c", "d", "e", "f", "g", "h"};
+    std::vector<unique_ptr<CanonicalQuery>> queries;
+    for (auto&& field : fields) {
+        queries.push_back(canonicalize(BSON(field << 1)));
+        ASSERT_EQ(planCache.get(*queries.back()).state, PlanCache::CacheEntryState::kNotPresent);
+        addCacheEntryForShape(*queries.back(), &planCache);
+    }
+
+    ASSERT_EQ(planCache.size(), fields.size());
+    ASSERT_EQ(planCache.getAllEntries().size(), fields.size());
+    for (auto&& cq : queries) {
+        ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kPresentInactive);
+        assertGet(planCache.getEntry(*cq));
+    }
+
+    // Each get() above counted as a miss before its entry was added and as a hit after, in the
+    // partition its key belongs to.
+    auto stats = planCache.getPartitionStats();
+    ASSERT_EQ(stats.size(), kNumPartitions);
+    size_t numEntries = 0;
+    long long numHits = 0;
+    long long numMisses = 0;
+    for (size_t i = 0; i < stats.size(); i++) {
+        ASSERT_EQ(stats[i].partition, i);
+        ASSERT_EQ(stats[i].maxEntries, kCacheSize / kNumPartitions);
+        ASSERT_EQ(stats[i].numEvictions, 0);
+        numEntries += stats[i].numEntries;
+        numHits += stats[i].numHits;
+        numMisses += stats[i].numMisses;
+    }
+    ASSERT_EQ(numEntries, fields.size());
+    ASSERT_EQ(numHits, static_cast<long long>(fields.size()));
+    ASSERT_EQ(numMisses, static_cast<long long>(fields.size()));
+
+    ASSERT_OK(planCache.remove(*queries.front()));
+    ASSERT_EQ(planCache.size(), fields.size() - 1);
+
+    planCache.clear();
+    ASSERT_EQ(planCache.size(), 0U);
+    for (auto&& cq : queries) {
+        ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kNotPresent);
+    }
+}
+
+TEST(PlanCacheTest, SetRecordsPlansForSelectivityBuckets) {
+    PlanCache planCache;
+    QueryTestServiceContext serviceContext;
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get()};
+
+    // Without a probe no bucket is recorded.
+    ASSERT_OK(planCache.set(*cq, solns, createDecision(1U, 10), Date_t{}));
+    ASSERT_TRUE(assertGet(planCache.getEntry(*cq))->selectivityPlans.empty());
+
+    // A worse plan keeps the inactive entry in place. That entry was created without a probe, so
+    // it has no probe index the new bucket could be measured against and nothing is recorded.
+    PlanCacheSelectivityProbe probe{"a_1", 0, 2};
+    ASSERT_OK(planCache.set(*cq, solns, createDecision(1U, 20), Date_t{}, boost::none, &probe));
+    auto entry = assertGet(planCache.getEntry(*cq));
+    ASSERT_FALSE(entry->isActive);
+    ASSERT_EQ(entry->selectivityProbeIndex, "");
+    ASSERT_TRUE(entry->selectivityPlans.empty());
+
+    // Promoting an entry to active replaces it, keeping the buckets recorded against the same
+    // probe index.
+    planCache.clear();
+    ASSERT_OK(planCache.set(*cq, solns, createDecision(1U, 10), Date_t{}, boost::none, &probe));
+    PlanCacheSelectivityProbe otherBucketProbe{"a_1", 0, 4};
+    ASSERT_OK(planCache.set(
+        *cq, solns, createDecision(1U, 5), Date_t{}, boost::none, &otherBucketProbe));
+    entry = assertGet(planCache.getEntry(*cq));
+    ASSERT_TRUE(entry->isActive);
+    ASSERT_EQ(entry->selectivityProbeIndex, "a_1");
+    ASSERT_EQ(entry->selectivityPlans.size(), 2U);
+    ASSERT_EQ(entry->selectivityPlans.at(2).works, 10U);
+    ASSERT_EQ(entry->selectivityPlans.at(4).works, 5U);
+
+    // The cached solution handed to the planner carries copies of the buckets.
+    auto cachedSolution = planCache.getCacheEntryIfActive(planCache.computeKey(*cq));
+    ASSERT(cachedSolution);
+    ASSERT_EQ(cachedSolution->selectivityProbeIndex, "a_1");
+    ASSERT_EQ(cachedSolution->selectivityPlans.size(), 2U);
+
+    // A probe against a different index starts the buckets over.
+    PlanCacheSelectivityProbe otherIndexProbe{"b_1", 0, 1};
+    ASSERT_OK(planCache.set(
+        *cq, solns, createDecision(1U, 1), Date_t{}, boost::none, &otherIndexProbe));
+    entry = assertGet(planCache.getEntry(*cq));
+    ASSERT_EQ(entry->selectivityProbeIndex, "b_1");
+    ASSERT_EQ(entry->selectivityPlans.size(), 1U);
+    ASSERT_EQ(entry->selectivityPlans.count(1), 1U);
+}
+
+TEST(PlanCacheTest, CardinalityFeedbackIsKeptWhileTheSamePlanIsCached) {
+    internalQueryCacheCardinalityFeedback.store(true);
+    ON_BLOCK_EXIT([] { internalQueryCacheCardinalityFeedback.store(false); });
+
+    PlanCache planCache;
+    QueryTestServiceContext serviceContext;
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get()};
+
+    ASSERT_OK(planCache.set(*cq, solns, createDecision(1U, 10), Date_t{}));
+    ASSERT_OK(planCache.recordCardinalityFeedback(*cq, 20, 10));
+    ASSERT_OK(planCache.recordCardinalityFeedback(*cq, 40, 10));
+    auto entry = assertGet(planCache.getEntry(*cq));
+    ASSERT_EQ(entry->cardinalityFeedback.numTrials, 2);
+    ASSERT_EQ(entry->cardinalityFeedback.avgTrialWorks, 30.0);
+    ASSERT_EQ(entry->cardinalityFeedback.avgTrialSelectivity, 0.375);
+    ASSERT_EQ(entry->cardinalityFeedback.numUnchangedReplans, 0);
+
+    // Replacing the entry with the same plan keeps the feedback and counts the replan.
+    ASSERT_OK(planCache.set(*cq, solns, createDecision(1U, 5), Date_t{}));
+    entry = assertGet(planCache.getEntry(*cq));
+    ASSERT_TRUE(entry->isActive);
+    ASSERT_EQ(entry->cardinalityFeedback.numTrials, 2);
+    ASSERT_EQ(entry->cardinalityFeedback.numUnchangedReplans, 1);
+    auto cachedSolution = planCache.getCacheEntryIfActive(planCache.computeKey(*cq));
+    ASSERT(cachedSolution);
+    ASSERT_EQ(cachedSolution->cardinalityFeedback.numUnchangedReplans, 1);
+
+    // A different plan starts over.
+    auto collScan = getQuerySolutionForCaching();
+    collScan->cacheData->solnType = SolutionCacheData::COLLSCAN_SOLN;
+    std::vector<QuerySolution*> collScanSolns = {collScan.get()};
+    ASSERT_OK(planCache.set(*cq, collScanSolns, createDecision(1U, 1), Date_t{}));
+    entry = assertGet(planCache.getEntry(*cq));
+    ASSERT_EQ(entry->cardinalityFeedback.numTrials, 0);
+    ASSERT_EQ(entry->cardinalityFeedback.numUnchangedReplans, 0);
+
+    // Feedback for a query whose entry is gone is an error.
+    planCache.clear();
+    ASSERT_NOT_OK(planCache.recordCardinalityFeedback(*cq, 20, 10));
+}
+
 TEST(PlanCacheTest, PlanCacheRemoveDeletesInactiveEntries) {
     PlanCache planCache;
     unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
@@ -35,6 +35,7 @@
 
 #include "mongo/db/query/index_tag.h"
 #include "mongo/db/query/indexability.h"
+#include "mongo/db/query/planner_ixselect.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/string_map.h"
 
@@ -259,15 +260,12 @@ PlanEnumerator::PlanEnumerator(const PlanEnumeratorParams& params)
     : _root(params.root),
       _indices(params.indices),
       _ixisect(params.intersect),
+      _skipScan(params.skipScan),
       _orLimit(params.maxSolutionsPerOr),
-      _intersectLimit(params.maxIntersectPerAnd) {}
+      _intersectLimit(params.maxIntersectPerAnd),
+      _arena(params.arena ? params.arena : &_ownArena) {}
 
-PlanEnumerator::~PlanEnumerator() {
-    typedef stdx::unordered_map<MemoID, NodeAssignment*> MemoMap;
-    for (MemoMap::iterator it = _memo.begin(); it != _memo.end(); ++it) {
-        delete it->second;
-    }
-}
+PlanEnumerator::~PlanEnumerator() = default;
 
 Status PlanEnumerator::init() {
     // Fill out our memo structure from the tagged _root.
@@ -380,7 +378,7 @@ void PlanEnumerator::allocateAssignment(MatchExpression* expr,
     verify(_nodeToId.end() == _nodeToId.find(expr));
     _nodeToId[expr] = newID;
     verify(_memo.end() == _memo.find(newID));
-    NodeAssignment* newAssignment = new NodeAssignment();
+    NodeAssignment* newAssignment = _arena->make<NodeAssignment>();
     _memo[newID] = newAssignment;
     *assign = newAssignment;
     *id = newID;
@@ -841,10 +839,11 @@ void PlanEnumerator::enumerateOneIndex(
     AndAssignment* andAssignment) {
     // Each choice in the 'andAssignment' will consist of a single subnode to index (an OR or array
     // operator) or a OneIndexAssignment. When creating a OneIndexAssignment, we ensure that at
-    // least one predicate can fulfill the first position in the key pattern, then we assign all
-    // predicates that can use the key pattern to the index. However, if the index is multikey,
-    // certain predicates cannot be combined/compounded. We determine which predicates can be
-    // combined/compounded using path-level multikey info, if available.
+    // least one predicate can fulfill the first position in the key pattern (unless we are
+    // enumerating skip scans), then we assign all predicates that can use the key pattern to the
+    // index. However, if the index is multikey, certain predicates cannot be combined/compounded.
+    // We determine which predicates can be combined/compounded using path-level multikey info, if
+    // available.
 
     // First, add the state of using each subnode.
     for (size_t i = 0; i < subnodes.size(); ++i) {
@@ -984,6 +983,35 @@ void PlanEnumerator::enumerateOneIndex(
             andAssignment->choices.push_back(std::move(state));
         }
     }
+
+    if (!_skipScan) {
+        return;
+    }
+
+    // Finally, consider skip scans over the indices which only have predicates over non-leading
+    // fields. The leading fields are left unconstrained, and the index scan seeks to each distinct
+    // key prefix in turn before applying the bounds on the trailing fields. Skip scan candidates
+    // are never multikey, so all of the predicates can be assigned to the index.
+    for (const auto& [index, preds] : idxToNotFirst) {
+        const IndexEntry& thisIndex = (*_indices)[index];
+        if (idxToFirst.find(index) != idxToFirst.end() ||
+            !QueryPlannerIXSelect::canUseForSkipScan(thisIndex)) {
+            continue;
+        }
+
+        OneIndexAssignment indexAssign;
+        indexAssign.index = index;
+        for (auto pred : preds) {
+            assignPredicate(outsidePreds, pred, getPosition(thisIndex, pred), &indexAssign);
+        }
+
+        // Do not output this assignment if it consists only of outside predicates.
+        if (!indexAssign.preds.empty()) {
+            AndEnumerableState state;
+            state.assignments.push_back(std::move(indexAssign));
+            andAssignment->choices.push_back(std::move(state));
+        }
+    }
 }
 
 void PlanEnumerator::enumerateAndIntersect(const IndexToPredMap& idxToFirst,
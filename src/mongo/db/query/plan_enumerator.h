@@ -37,12 +37,14 @@
 #include "mongo/db/query/index_tag.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/monotonic_arena.h"
 
 namespace mongo {
 
 struct PlanEnumeratorParams {
     PlanEnumeratorParams()
         : intersect(false),
+          skipScan(false),
           maxSolutionsPerOr(internalQueryEnumerationMaxOrSolutions.load()),
           maxIntersectPerAnd(internalQueryEnumerationMaxIntersectPerAnd.load()) {}
 
@@ -50,12 +52,20 @@ struct PlanEnumeratorParams {
     // an indexed solution?
     bool intersect;
 
+    // Do we provide solutions that use a compound index without a predicate over its leading
+    // field? See QueryPlannerIXSelect::canUseForSkipScan().
+    bool skipScan;
+
     // Not owned here.
     MatchExpression* root;
 
     // Not owned here.
     const std::vector<IndexEntry>* indices;
 
+    // Where the memo is allocated, typically the operation's arena. Not owned here. If null, the
+    // enumerator uses an arena of its own.
+    MonotonicArena* arena = nullptr;
+
     // How many plans are we willing to ouput from an OR? We currently consider
     // all possibly OR plans, which means the product of the number of possibilities
     // for each clause of the OR. This could grow disastrously large.
@@ -531,7 +541,7 @@ private:
     // Map from expression to its MemoID.
     stdx::unordered_map<MatchExpression*, MemoID> _nodeToId;
 
-    // Map from MemoID to its precomputed solution info.
+    // Map from MemoID to its precomputed solution info. The NodeAssignments live in '_arena'.
     stdx::unordered_map<MemoID, NodeAssignment*> _memo;
 
     // If true, there are no further enumeration states, and getNext should return false.
@@ -551,11 +561,17 @@ private:
     // Do we output >1 index per AND (index intersection)?
     bool _ixisect;
 
+    // Do we enumerate skip scans over compound indices with an unconstrained leading field?
+    bool _skipScan;
+
     // How many enumerations are we willing to produce from each OR?
     size_t _orLimit;
 
     // How many things do we want from each AND?
     size_t _intersectLimit;
+
+    MonotonicArena _ownArena;
+    MonotonicArena* _arena;
 };
 
 }  // namespace mongo
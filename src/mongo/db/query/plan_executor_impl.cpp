@@ -54,6 +54,7 @@
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/mock_yield_policies.h"
 #include "mongo/db/query/plan_yield_policy.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
@@ -237,6 +238,12 @@ PlanExecutorImpl::PlanExecutorImpl(OperationContext* opCtx,
     invariant(!_expCtx || _expCtx->opCtx == _opCtx);
     invariant(!_cq || !_expCtx || _cq->getExpCtx() == _expCtx);
 
+    // Stages which write are left to do one unit of work per call, so that the yield policy gets
+    // a chance to run between every write.
+    if (!getStageByType(_root.get(), STAGE_UPDATE) && !getStageByType(_root.get(), STAGE_DELETE)) {
+        _workBatchSize = internalQueryExecWorkBatchSize.load();
+    }
+
     // We may still need to initialize _nss from either collection or _cq.
     if (!_nss.isEmpty()) {
         return;  // We already have an _nss set, so there's nothing more to do.
@@ -331,6 +338,12 @@ const boost::intrusive_ptr<ExpressionContext>& PlanExecutorImpl::getExpCtx() con
 void PlanExecutorImpl::saveState() {
     invariant(_currentState == kUsable || _currentState == kSaved);
 
+    // Results we have buffered from a batch may point into storage engine memory which is not
+    // guaranteed to stay valid once the plan yields.
+    for (size_t i = _batchedResultsPos; i < _batchedResults.size(); ++i) {
+        _workingSet->get(_batchedResults[i])->makeObjOwnedIfNeeded();
+    }
+
     if (!isMarkedAsKilled()) {
         _root->saveState();
     }
@@ -560,7 +573,7 @@ PlanExecutor::ExecState PlanExecutorImpl::_getNextImpl(Snapshotted<Document>* ob
         }
 
         WorkingSetID id = WorkingSet::INVALID_ID;
-        PlanStage::StageState code = _root->work(&id);
+        PlanStage::StageState code = _workRoot(&id);
 
         if (code != PlanStage::NEED_YIELD)
             writeConflictsInARow = 0;
@@ -663,9 +676,43 @@ PlanExecutor::ExecState PlanExecutorImpl::_getNextImpl(Snapshotted<Document>* ob
     }
 }
 
+PlanStage::StageState PlanExecutorImpl::_workRoot(WorkingSetID* out) {
+    if (_workBatchSize <= 1) {
+        return _root->work(out);
+    }
+
+    if (_hasBatchedResults()) {
+        *out = _batchedResults[_batchedResultsPos++];
+        return PlanStage::ADVANCED;
+    }
+
+    if (_pendingBatchState) {
+        auto state = *_pendingBatchState;
+        *out = _pendingBatchOut;
+        _pendingBatchState = boost::none;
+        return state;
+    }
+
+    _batchedResults.clear();
+    _batchedResultsPos = 0;
+    auto state = _root->workBatch(_workBatchSize, &_batchedResults, out);
+    if (_batchedResults.empty()) {
+        return state;
+    }
+
+    // The batch produced results, which must be returned before whatever ended the batch.
+    if (PlanStage::ADVANCED != state && PlanStage::NEED_TIME != state) {
+        _pendingBatchState = state;
+        _pendingBatchOut = *out;
+    }
+    *out = _batchedResults[_batchedResultsPos++];
+    return PlanStage::ADVANCED;
+}
+
 bool PlanExecutorImpl::isEOF() {
     invariant(_currentState == kUsable);
-    return isMarkedAsKilled() || (_stash.empty() && _root->isEOF());
+    return isMarkedAsKilled() ||
+        (_stash.empty() && !_hasBatchedResults() && !_pendingBatchState && _root->isEOF());
 }
 
 void PlanExecutorImpl::markAsKilled(Status killStatus) {
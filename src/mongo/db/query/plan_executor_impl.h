@@ -31,7 +31,10 @@
 
 #include <boost/optional.hpp>
 #include <queue>
+#include <vector>
 
+#include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/working_set.h"
 #include "mongo/db/query/plan_executor.h"
 
 namespace mongo {
@@ -155,6 +158,21 @@ private:
      */
     ExecState _getNextImpl(Snapshotted<Document>* objOut, RecordId* dlOut);
 
+    /**
+     * Asks the root stage for its next unit of work, following the contract of PlanStage::work().
+     * When batched execution is enabled, results are obtained from the root through
+     * PlanStage::workBatch() and handed out one at a time from '_batchedResults'.
+     */
+    PlanStage::StageState _workRoot(WorkingSetID* out);
+
+    /**
+     * Returns true if there are results from the last call to PlanStage::workBatch() which have
+     * not yet been returned by _workRoot().
+     */
+    bool _hasBatchedResults() const {
+        return _batchedResultsPos < _batchedResults.size();
+    }
+
     // The OperationContext that we're executing within. This can be updated if necessary by using
     // detachFromOperationContext() and reattachToOperationContext().
     OperationContext* _opCtx;
@@ -189,6 +207,20 @@ private:
     // stages.
     std::queue<Document> _stash;
 
+    // The maximum number of units of work to request from '_root' per PlanStage::workBatch() call.
+    // A value of 1 means that results are obtained through PlanStage::work() instead.
+    size_t _workBatchSize = 1;
+
+    // Results of the last PlanStage::workBatch() call. Those at or after '_batchedResultsPos' have
+    // not been returned yet.
+    std::vector<WorkingSetID> _batchedResults;
+    size_t _batchedResultsPos = 0;
+
+    // The state which ended the last batch, if it was IS_EOF, NEED_YIELD or FAILURE and there were
+    // still results to return first, along with its WorkingSetID.
+    boost::optional<PlanStage::StageState> _pendingBatchState;
+    WorkingSetID _pendingBatchOut = WorkingSet::INVALID_ID;
+
     // The output document that is used by getNext BSON API. This allows us to avoid constantly
     // allocating and freeing DocumentStorage.
     Document _docOutput;
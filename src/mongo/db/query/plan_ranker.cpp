@@ -236,8 +236,7 @@ double PlanRanker::scoreTree(const PlanStageStats* stats) {
 
     // How much did a plan produce?
     // Range: [0, 1]
-    double productivity =
-        static_cast<double>(stats->common.advanced) / static_cast<double>(workUnits);
+    double productivity = PlanRanker::productivity(stats->common);
 
     // Just enough to break a tie. Must be small enough to ensure that a more productive
     // plan doesn't lose to a less productive plan due to tie breaking.
@@ -299,4 +298,40 @@ double PlanRanker::scoreTree(const PlanStageStats* stats) {
     return score;
 }
 
+// static
+double PlanRanker::productivity(const CommonStats& stats) {
+    if (stats.works == 0) {
+        return 0;
+    }
+    return static_cast<double>(stats.advanced) / static_cast<double>(stats.works);
+}
+
+// static
+std::vector<size_t> PlanRanker::findDominatedCandidates(const vector<CandidatePlan>& candidates,
+                                                        double ratio) {
+    vector<double> productivities(candidates.size(), 0);
+    double bestProductivity = 0;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (candidates[i].failed || candidates[i].pruned) {
+            continue;
+        }
+        productivities[i] = productivity(*candidates[i].root->getCommonStats());
+        bestProductivity = std::max(bestProductivity, productivities[i]);
+    }
+
+    vector<size_t> dominated;
+    if (bestProductivity == 0) {
+        return dominated;
+    }
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (candidates[i].failed || candidates[i].pruned) {
+            continue;
+        }
+        if (productivities[i] < ratio * bestProductivity) {
+            dominated.push_back(i);
+        }
+    }
+    return dominated;
+}
+
 }  // namespace mongo
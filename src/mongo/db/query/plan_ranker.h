@@ -65,6 +65,19 @@ public:
      * the plan. The exact value isn't meaningful except for imposing a ranking.
      */
     static double scoreTree(const PlanStageStats* stats);
+
+    /**
+     * Returns the fraction of its works in which a plan produced a result. Range: [0, 1]
+     */
+    static double productivity(const CommonStats& stats);
+
+    /**
+     * Returns the indices of the candidates, neither failed nor pruned, whose productivity is
+     * below 'ratio' times that of the most productive candidate. Nothing is dominated until some
+     * candidate has produced a result.
+     */
+    static std::vector<size_t> findDominatedCandidates(const std::vector<CandidatePlan>& candidates,
+                                                       double ratio);
 };
 
 /**
@@ -73,7 +86,7 @@ public:
  */
 struct CandidatePlan {
     CandidatePlan(std::unique_ptr<QuerySolution> solution, PlanStage* r, WorkingSet* w)
-        : solution(std::move(solution)), root(r), ws(w), failed(false) {}
+        : solution(std::move(solution)), root(r), ws(w), failed(false), pruned(false) {}
 
     std::unique_ptr<QuerySolution> solution;
     PlanStage* root;  // Not owned here.
@@ -83,6 +96,10 @@ struct CandidatePlan {
     std::queue<WorkingSetID> results;
 
     bool failed;
+
+    // Set when the plan was outperformed early in the trial period and is no longer worked. A
+    // pruned plan is still ranked using the stats it had gathered.
+    bool pruned;
 };
 
 /**
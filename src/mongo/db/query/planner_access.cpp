@@ -60,6 +60,84 @@ using namespace mongo;
 namespace wcp = ::mongo::wildcard_planning;
 namespace dps = ::mongo::dotted_path_support;
 
+/**
+ * Returns true if a predicate over the field at position 'pos' of 'index' can be evaluated
+ * against each index key in place of the document. This holds for any index that is not
+ * multikey, and for a multikey index whose path-level metadata shows that the field at 'pos'
+ * never contains an array: every key generated for a document then carries the same value for
+ * that field, so the predicate gives the same answer for each of them.
+ */
+bool canFilterOnIndexField(const IndexEntry& index, size_t pos) {
+    if (!index.multikey) {
+        return true;
+    }
+    if (index.type == INDEX_WILDCARD || index.multikeyPaths.empty()) {
+        return false;
+    }
+    invariant(pos < index.multikeyPaths.size());
+    return index.multikeyPaths[pos].empty();
+}
+
+/**
+ * Returns true if 'expr' gives the same answer when evaluated against the keys of 'index' as it
+ * does against the documents they point to. Each field 'expr' reads must be in the index and pass
+ * canFilterOnIndexField(), and the index must not store collation keys in place of strings. The
+ * index stores null for a missing field, so 'expr' must also treat a missing field like a null.
+ */
+bool canFilterOnIndexKeys(const IndexEntry& index, const MatchExpression* expr) {
+    switch (expr->matchType()) {
+        case MatchExpression::AND:
+        case MatchExpression::OR:
+        case MatchExpression::NOR:
+        case MatchExpression::NOT:
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                if (!canFilterOnIndexKeys(index, expr->getChild(i))) {
+                    return false;
+                }
+            }
+            return true;
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+        case MatchExpression::MATCH_IN:
+        case MatchExpression::REGEX:
+        case MatchExpression::MOD:
+            break;
+        default:
+            return false;
+    }
+
+    if (index.type != INDEX_BTREE || index.collator) {
+        return false;
+    }
+
+    size_t pos = 0;
+    BSONObjIterator it(index.keyPattern);
+    while (it.more() && it.next().fieldNameStringData() != expr->path()) {
+        ++pos;
+    }
+    if (pos == static_cast<size_t>(index.keyPattern.nFields()) ||
+        !canFilterOnIndexField(index, pos)) {
+        return false;
+    }
+
+    static const BSONObj nullKey = BSON("" << BSONNULL);
+    return expr->matchesSingleElement(nullKey.firstElement()) == expr->matchesBSON(BSONObj());
+}
+
+/**
+ * Returns the index tag assigned to the indexed predicate 'expr', looking through a
+ * bounds-generating $not.
+ */
+const IndexTag* getIndexTag(const MatchExpression* expr) {
+    if (MatchExpression::NOT == expr->matchType()) {
+        expr = expr->getChild(0);
+    }
+    return static_cast<const IndexTag*>(expr->getTag());
+}
+
 /**
  * Text node functors.
  */
@@ -615,7 +693,18 @@ bool QueryPlannerAccess::orNeedsFetch(const ScanBuildingState* scanState) {
     } else {
         invariant(scanState->loosestBounds == IndexBoundsBuilder::INEXACT_COVERED);
         const IndexEntry& index = scanState->indices[scanState->currentIndexNumber];
-        return index.multikey;
+        if (!index.multikey) {
+            return false;
+        }
+        // The $or can still be evaluated against the index keys if every disjunct is over a
+        // field that never holds an array.
+        for (size_t i = 0; i < scanState->curOr->numChildren(); ++i) {
+            const IndexTag* tag = getIndexTag(scanState->curOr->getChild(i));
+            if (!tag || !canFilterOnIndexField(index, tag->pos)) {
+                return true;
+            }
+        }
+        return false;
     }
 }
 
@@ -1295,7 +1384,7 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::_buildIndexedDataAccess(
             if (tightness == IndexBoundsBuilder::EXACT) {
                 return soln;
             } else if (tightness == IndexBoundsBuilder::INEXACT_COVERED &&
-                       !indices[tag->index].multikey) {
+                       canFilterOnIndexField(indices[tag->index], tag->pos)) {
                 verify(nullptr == soln->filter.get());
                 soln->filter = std::move(ownedRoot);
                 return soln;
@@ -1370,6 +1459,25 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::scanWholeIndex(
     return solnRoot;
 }
 
+std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::scanWholeIndexFilteringKeys(
+    const IndexEntry& index, const CanonicalQuery& query) {
+    unique_ptr<MatchExpression> filter = query.root()->shallowClone();
+    const bool isEmptyFilter =
+        MatchExpression::AND == filter->matchType() && 0 == filter->numChildren();
+    if (!isEmptyFilter && !canFilterOnIndexKeys(index, filter.get())) {
+        return nullptr;
+    }
+
+    auto isn = std::make_unique<IndexScanNode>(index);
+    isn->addKeyMetadata = query.metadataDeps()[DocumentMetadataFields::kIndexKey];
+    isn->queryCollator = query.getCollator();
+    IndexBoundsBuilder::allValuesBounds(index.keyPattern, &isn->bounds);
+    if (!isEmptyFilter) {
+        isn->filter = std::move(filter);
+    }
+    return isn;
+}
+
 void QueryPlannerAccess::addFilterToSolutionNode(QuerySolutionNode* node,
                                                  MatchExpression* match,
                                                  MatchExpression::MatchType type) {
@@ -1443,7 +1551,8 @@ void QueryPlannerAccess::handleFilterAnd(ScanBuildingState* scanState) {
         root->getChildVector()->erase(root->getChildVector()->begin() + scanState->curChild);
         delete child;
     } else if (scanState->tightness == IndexBoundsBuilder::INEXACT_COVERED &&
-               (INDEX_TEXT == index.type || !index.multikey)) {
+               (INDEX_TEXT == index.type ||
+                canFilterOnIndexField(index, scanState->ixtag->pos))) {
         // The bounds are not exact, but the information needed to
         // evaluate the predicate is in the index key. Remove the
         // MatchExpression from its parent and attach it to the filter
@@ -1454,7 +1563,8 @@ void QueryPlannerAccess::handleFilterAnd(ScanBuildingState* scanState) {
         // {x: ["a", "b"]}. Now if we query for {x: /b/} the filter might
         // ever only be applied to the index key "a". We'd incorrectly
         // conclude that the document does not match the query :( so we
-        // gotta stick to non-multikey indices.
+        // gotta stick to fields which the index metadata shows are not
+        // multikey.
         root->getChildVector()->erase(root->getChildVector()->begin() + scanState->curChild);
 
         addFilterToSolutionNode(scanState->currentScan.get(), child, root->matchType());
@@ -110,6 +110,15 @@ public:
                                                              const QueryPlannerParams& params,
                                                              int direction = 1);
 
+    /**
+     * Return a plan that scans the whole of the provided index and applies the query's filter to
+     * the index keys rather than to the fetched documents, so that a query over a handful of
+     * indexed fields can read just the index. Returns nullptr if the filter cannot be evaluated
+     * against the keys of 'index'.
+     */
+    static std::unique_ptr<QuerySolutionNode> scanWholeIndexFilteringKeys(
+        const IndexEntry& index, const CanonicalQuery& query);
+
     /**
      * Return a plan that scans the provided index from [startKey to endKey).
      */
@@ -38,8 +38,10 @@
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/index/s2_common.h"
+#include "mongo/db/index_names.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_geo.h"
+#include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/logv2/log.h"
@@ -360,31 +362,30 @@ std::unique_ptr<ProjectionNode> analyzeProjection(const CanonicalQuery& query,
     }
 
     // There are two projection fast paths available for simple inclusion projections that don't
-    // need a sort key, don't have any dotted-path inclusions, don't have a positional projection,
-    // and don't have the 'requiresDocument' property: the ProjectionNodeSimple fast-path for plans
-    // that have a fetch stage and the ProjectionNodeCovered for plans with an index scan that the
-    // projection can cover. Plans that don't meet all the requirements for these fast path
-    // projections will all use ProjectionNodeDefault, which is able to handle all projections,
-    // covered or otherwise.
-    if (query.getProj()->isSimple()) {
+    // need a sort key, don't have a positional projection, and don't have the 'requiresDocument'
+    // property: the ProjectionNodeSimple fast-path for plans that have a fetch stage, which also
+    // handles dotted-path inclusions, and the ProjectionNodeCovered for plans with an index scan
+    // that the projection can cover, which does not. Plans that don't meet all the requirements for
+    // these fast path projections will all use ProjectionNodeDefault, which is able to handle all
+    // projections, covered or otherwise.
+    if (solnRoot->fetched() && query.getProj()->isSimpleIgnoringDottedPaths()) {
         // If the projection is simple, but not covered, use 'ProjectionNodeSimple'.
-        if (solnRoot->fetched()) {
-            return std::make_unique<ProjectionNodeSimple>(
+        return std::make_unique<ProjectionNodeSimple>(
+            addSortKeyGeneratorStageIfNeeded(query, hasSortStage, std::move(solnRoot)),
+            *query.root(),
+            *query.getProj());
+    }
+
+    if (!solnRoot->fetched() && query.getProj()->isSimple()) {
+        // If we're here we're not fetched so we're covered. Let's see if we can get out of using
+        // the default projType. If 'solnRoot' is an index scan we can use the faster covered impl.
+        BSONObj coveredKeyObj = produceCoveredKeyObj(solnRoot.get());
+        if (!coveredKeyObj.isEmpty()) {
+            return std::make_unique<ProjectionNodeCovered>(
                 addSortKeyGeneratorStageIfNeeded(query, hasSortStage, std::move(solnRoot)),
                 *query.root(),
-                *query.getProj());
-        } else {
-            // If we're here we're not fetched so we're covered. Let's see if we can get out of
-            // using the default projType. If 'solnRoot' is an index scan we can use the faster
-            // covered impl.
-            BSONObj coveredKeyObj = produceCoveredKeyObj(solnRoot.get());
-            if (!coveredKeyObj.isEmpty()) {
-                return std::make_unique<ProjectionNodeCovered>(
-                    addSortKeyGeneratorStageIfNeeded(query, hasSortStage, std::move(solnRoot)),
-                    *query.root(),
-                    *query.getProj(),
-                    std::move(coveredKeyObj));
-            }
+                *query.getProj(),
+                std::move(coveredKeyObj));
         }
     }
 
@@ -492,6 +493,77 @@ bool canUseSimpleSort(const QuerySolutionNode& solnRoot,
         && !splitLimitedSortEligible;
 }
 
+/**
+ * Returns true if the bounds on the leading field of 'index' are bounds on the raw or hashed value
+ * of 'shardKeyField', in the same form as the chunk ranges of a collection with that shard key.
+ */
+bool indexLeadingFieldMatchesShardKeyField(const IndexEntry& index,
+                                           const BSONElement& shardKeyField) {
+    if (index.type != INDEX_BTREE && index.type != INDEX_HASHED) {
+        return false;
+    }
+
+    // Chunk ranges are compared with the simple collation and shard key values are never arrays.
+    if (index.collator ||
+        (index.multikey && (index.multikeyPaths.empty() || !index.multikeyPaths[0].empty()))) {
+        return false;
+    }
+
+    const auto indexField = index.keyPattern.firstElement();
+    if (indexField.fieldNameStringData() != shardKeyField.fieldNameStringData()) {
+        return false;
+    }
+
+    const bool shardKeyFieldIsHashed = shardKeyField.valueStringDataSafe() == IndexNames::HASHED;
+    return shardKeyFieldIsHashed ? indexField.valueStringDataSafe() == IndexNames::HASHED
+                                 : indexField.isNumber();
+}
+
+/**
+ * Intersects the bounds on the leading field of every index scan in the tree 'root' whose index
+ * leads with the first field of 'shardKey' with 'ownedIntervals', which are the ascending intervals
+ * of that field that are spanned by the chunks this shard owns. The documents excluded this way
+ * would otherwise be dropped by the SHARDING_FILTER stage, so this never changes the results.
+ */
+void restrictIndexScansToOwnedIntervals(const BSONObj& shardKey,
+                                        const OrderedIntervalList& ownedIntervals,
+                                        QuerySolutionNode* root) {
+    for (auto* child : root->children) {
+        restrictIndexScansToOwnedIntervals(shardKey, ownedIntervals, child);
+    }
+
+    if (root->getType() != STAGE_IXSCAN) {
+        return;
+    }
+
+    auto* isn = static_cast<IndexScanNode*>(root);
+    if (isn->bounds.isSimpleRange || isn->bounds.fields.empty() ||
+        !indexLeadingFieldMatchesShardKeyField(isn->index, shardKey.firstElement())) {
+        return;
+    }
+
+    // The bounds have already been aligned with the index key pattern, so the intervals on a
+    // descending leading field have to be reversed for the intersection.
+    const bool descending = isn->index.keyPattern.firstElement().number() < 0;
+
+    OrderedIntervalList oil = descending ? isn->bounds.fields[0].reverseClone()
+                                         : isn->bounds.fields[0];
+    OrderedIntervalList owned = ownedIntervals;
+    owned.name = oil.name;
+    IndexBoundsBuilder::intersectize(owned, &oil);
+
+    // An empty intersection means the scan can only return orphans; leave such a scan alone rather
+    // than constructing bounds which match nothing, as the shard filter drops its results anyway.
+    if (oil.intervals.empty()) {
+        return;
+    }
+
+    if (descending) {
+        oil.reverse();
+    }
+    isn->bounds.fields[0] = std::move(oil);
+}
+
 }  // namespace
 
 // static
@@ -762,6 +834,14 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         // We have a true limit. The limit can be combined with the SORT stage.
         sortNodeRaw->limit =
             static_cast<size_t>(*qr.getLimit()) + static_cast<size_t>(qr.getSkip().value_or(0));
+
+        // A sort on the text score alone only needs the best 'limit' documents from the text
+        // stage beneath it.
+        auto child = sortNodeRaw->children[0];
+        if (STAGE_TEXT == child->getType() && sortObj.nFields() == 1 &&
+            QueryRequest::isTextScoreMeta(sortObj.firstElement())) {
+            static_cast<TextNode*>(child)->topK = sortNodeRaw->limit;
+        }
     } else if (qr.getNToReturn()) {
         // We have an ntoreturn specified by an OP_QUERY style find. This is used
         // by clients to mean both batchSize and limit.
@@ -836,6 +916,12 @@ std::unique_ptr<QuerySolution> QueryPlannerAnalysis::analyzeDataAccess(
     soln->filterData = query.getQueryObj();
     soln->indexFilterApplied = params.indexFiltersApplied;
 
+    if ((params.options & QueryPlannerParams::INCLUDE_SHARD_FILTER) &&
+        params.shardKeyPrefixOwnedIntervals) {
+        restrictIndexScansToOwnedIntervals(
+            params.shardKey, *params.shardKeyPrefixOwnedIntervals, solnRoot.get());
+    }
+
     solnRoot->computeProperties();
 
     analyzeGeo(params, solnRoot.get());
@@ -311,7 +311,9 @@ std::vector<IndexEntry> QueryPlannerIXSelect::findIndexesByHint(
 
 // static
 std::vector<IndexEntry> QueryPlannerIXSelect::findRelevantIndices(
-    const stdx::unordered_set<std::string>& fields, const std::vector<IndexEntry>& allIndices) {
+    const stdx::unordered_set<std::string>& fields,
+    const std::vector<IndexEntry>& allIndices,
+    bool allowSkipScan) {
 
     std::vector<IndexEntry> out;
     for (auto&& entry : allIndices) {
@@ -319,12 +321,27 @@ std::vector<IndexEntry> QueryPlannerIXSelect::findRelevantIndices(
         BSONElement elt = it.next();
         if (fields.end() != fields.find(elt.fieldName())) {
             out.push_back(entry);
+            continue;
+        }
+
+        if (allowSkipScan && canUseForSkipScan(entry)) {
+            while (it.more()) {
+                if (fields.end() != fields.find(it.next().fieldName())) {
+                    out.push_back(entry);
+                    break;
+                }
+            }
         }
     }
 
     return out;
 }
 
+bool QueryPlannerIXSelect::canUseForSkipScan(const IndexEntry& index) {
+    return index.type == IndexType::INDEX_BTREE && !index.multikey && !index.sparse &&
+        index.keyPattern.nFields() > 1;
+}
+
 std::vector<IndexEntry> QueryPlannerIXSelect::expandIndexes(
     const stdx::unordered_set<std::string>& fields, std::vector<IndexEntry> relevantIndices) {
     std::vector<IndexEntry> out;
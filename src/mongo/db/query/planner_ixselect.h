@@ -69,10 +69,21 @@ public:
 
     /**
      * Finds all indices prefixed by fields we have predicates over.  Only these indices are
-     * useful in answering the query.
+     * useful in answering the query. If 'allowSkipScan' is true, also includes indices which can
+     * be skip-scanned over a predicate on one of their non-leading fields.
      */
     static std::vector<IndexEntry> findRelevantIndices(
-        const stdx::unordered_set<std::string>& fields, const std::vector<IndexEntry>& allIndices);
+        const stdx::unordered_set<std::string>& fields,
+        const std::vector<IndexEntry>& allIndices,
+        bool allowSkipScan = false);
+
+    /**
+     * Returns true if 'index' may be scanned without any predicate over its leading field, by
+     * seeking to each distinct value of the key prefix in turn. Only compound btree indices that
+     * are neither sparse nor multikey qualify, so that every document has exactly one key and
+     * the unconstrained prefix can be given [MinKey, MaxKey] bounds.
+     */
+    static bool canUseForSkipScan(const IndexEntry& index);
 
     /**
      * Determine how useful all of our relevant 'indices' are to all predicates in the subtree
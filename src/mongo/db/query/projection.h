@@ -116,8 +116,17 @@ public:
      * metadata.
      */
     bool isSimple() const {
-        return !_deps.hasDottedPath && !_deps.requiresMatchDetails &&
-            !_deps.metadataRequested.any() && !_deps.requiresDocument && !_deps.hasExpressions;
+        return !_deps.hasDottedPath && isSimpleIgnoringDottedPaths();
+    }
+
+    /**
+     * Returns true if this projection would be "simple" but for including dotted paths. Such a
+     * projection can still be applied by walking the BSON of a fetched document, but cannot be
+     * covered by the fast path over a single index key.
+     */
+    bool isSimpleIgnoringDottedPaths() const {
+        return !_deps.requiresMatchDetails && !_deps.metadataRequested.any() &&
+            !_deps.requiresDocument && !_deps.hasExpressions;
     }
 
     /**
@@ -44,6 +44,7 @@
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/matcher/expression_text.h"
+#include "mongo/db/operation_arena.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_interface.h"
@@ -86,6 +87,36 @@ static bool is2DIndex(const BSONObj& pattern) {
     return false;
 }
 
+static bool isAllValuesForField(const OrderedIntervalList& oil) {
+    if (oil.intervals.size() != 1) {
+        return false;
+    }
+    const Interval& interval = oil.intervals[0];
+    return interval.isMinToMax() ||
+        (interval.start.type() == BSONType::MaxKey && interval.end.type() == BSONType::MinKey);
+}
+
+/**
+ * Returns true if the solution tree rooted at 'node' contains an index scan which leaves its
+ * leading field unconstrained but has bounds on a later field, i.e. an index skip scan.
+ */
+static bool hasSkipScan(const QuerySolutionNode* node) {
+    if (STAGE_IXSCAN == node->getType()) {
+        const auto& bounds = static_cast<const IndexScanNode*>(node)->bounds;
+        if (bounds.isSimpleRange || bounds.fields.size() < 2 ||
+            !isAllValuesForField(bounds.fields[0])) {
+            return false;
+        }
+        return std::any_of(bounds.fields.begin() + 1,
+                           bounds.fields.end(),
+                           [](const auto& oil) { return !isAllValuesForField(oil); });
+    }
+
+    return std::any_of(node->children.begin(), node->children.end(), [](const auto* child) {
+        return hasSkipScan(child);
+    });
+}
+
 string optionString(size_t options) {
     str::stream ss;
 
@@ -132,6 +163,9 @@ string optionString(size_t options) {
             case QueryPlannerParams::PRESERVE_RECORD_ID:
                 ss << "PRESERVE_RECORD_ID ";
                 break;
+            case QueryPlannerParams::INDEX_SKIP_SCAN:
+                ss << "INDEX_SKIP_SCAN ";
+                break;
             case QueryPlannerParams::DEFAULT:
                 MONGO_UNREACHABLE;
                 break;
@@ -440,12 +474,17 @@ StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
     const CachedSolution& cachedSoln) {
     invariant(!cachedSoln.plannerData.empty());
 
+    // Look up winning solution in cached solution's array.
+    return planFromCache(query, params, *cachedSoln.plannerData[0]);
+}
+
+StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
+    const CanonicalQuery& query,
+    const QueryPlannerParams& params,
+    const SolutionCacheData& winnerCacheData) {
     // A query not suitable for caching should not have made its way into the cache.
     invariant(PlanCache::shouldCacheQuery(query));
 
-    // Look up winning solution in cached solution's array.
-    const SolutionCacheData& winnerCacheData = *cachedSoln.plannerData[0];
-
     if (SolutionCacheData::WHOLE_IXSCAN_SOLN == winnerCacheData.solnType) {
         // The solution can be constructed by a scan over the entire index.
         auto soln = buildWholeIXSoln(
@@ -657,7 +696,8 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
     std::vector<IndexEntry> relevantIndices;
 
     if (!hintedIndexEntry) {
-        relevantIndices = QueryPlannerIXSelect::findRelevantIndices(fields, fullIndexList);
+        relevantIndices = QueryPlannerIXSelect::findRelevantIndices(
+            fields, fullIndexList, params.options & QueryPlannerParams::INDEX_SKIP_SCAN);
     } else {
         relevantIndices = fullIndexList;
 
@@ -821,8 +861,12 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         // The enumerator spits out trees tagged with IndexTag(s).
         PlanEnumeratorParams enumParams;
         enumParams.intersect = params.options & QueryPlannerParams::INDEX_INTERSECTION;
+        enumParams.skipScan = params.options & QueryPlannerParams::INDEX_SKIP_SCAN;
         enumParams.root = query.root();
         enumParams.indices = &relevantIndices;
+        if (auto opCtx = query.getExpCtx()->opCtx) {
+            enumParams.arena = &operationArena(opCtx);
+        }
 
         PlanEnumerator isp(enumParams);
         isp.init().transitional_ignore();
@@ -1016,10 +1060,11 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
     }
 
     // If a projection exists, there may be an index that allows for a covered plan, even if none
-    // were considered earlier.
+    // were considered earlier. Scanning the whole of an index which holds every field the query
+    // reads, and filtering its keys, reads far less than scanning the full documents.
     const auto projection = query.getProj();
     if (params.options & QueryPlannerParams::GENERATE_COVERED_IXSCANS && out.size() == 0 &&
-        query.getQueryObj().isEmpty() && projection && !projection->requiresDocument()) {
+        projection && !projection->requiresDocument()) {
 
         const auto* indicesToConsider = hintedIndex.isEmpty() ? &fullIndexList : &relevantIndices;
         for (auto&& index : *indicesToConsider) {
@@ -1028,8 +1073,14 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
                 continue;
             }
 
+            auto solnRoot = QueryPlannerAccess::scanWholeIndexFilteringKeys(index, query);
+            if (!solnRoot) {
+                continue;
+            }
+
             QueryPlannerParams paramsForCoveredIxScan;
-            auto soln = buildWholeIXSoln(index, query, paramsForCoveredIxScan);
+            auto soln = QueryPlannerAnalysis::analyzeDataAccess(
+                query, paramsForCoveredIxScan, std::move(solnRoot));
             if (soln && !soln->root->fetched()) {
                 LOGV2_DEBUG(
                     20983, 5, "Planner: outputting soln that uses index to provide projection.");
@@ -1051,6 +1102,17 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
     // The caller can explicitly ask for a collscan.
     bool collscanRequested = (params.options & QueryPlannerParams::INCLUDE_COLLSCAN);
 
+    // A skip scan costs about one seek per distinct value of its unconstrained key prefix, which
+    // the planner has no way to estimate. If every indexed plan relies on a skip scan, race them
+    // against a collection scan so that the trial period charges for those seeks and a prefix with
+    // too many distinct values loses to the collscan.
+    if ((params.options & QueryPlannerParams::INDEX_SKIP_SCAN) && hintedIndex.isEmpty() &&
+        !out.empty() && std::all_of(out.begin(), out.end(), [](const auto& soln) {
+            return hasSkipScan(soln->root.get());
+        })) {
+        collscanRequested = true;
+    }
+
     // No indexed plans?  We must provide a collscan if possible or else we can't run the query.
     bool collScanRequired = 0 == out.size();
     if (collScanRequired && !canTableScan) {
@@ -67,6 +67,15 @@ public:
         const QueryPlannerParams& params,
         const CachedSolution& cachedSoln);
 
+    /**
+     * Like the above, but builds the solution described by 'winnerCacheData', which need not be
+     * the winning plan of a CachedSolution.
+     */
+    static StatusWith<std::unique_ptr<QuerySolution>> planFromCache(
+        const CanonicalQuery& query,
+        const QueryPlannerParams& params,
+        const SolutionCacheData& winnerCacheData);
+
     /**
      * Generates and returns the index tag tree that will be inserted into the plan cache. This data
      * gets stashed inside a QuerySolution until it can be inserted into the cache proper.
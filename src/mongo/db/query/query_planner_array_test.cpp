@@ -2768,4 +2768,61 @@ TEST_F(QueryPlannerTest, MustFetchBeforeDottedMultiKeyPathSort) {
         "  }"
         "}}");
 }
+
+TEST_F(QueryPlannerTest, CoveredPredicateOnNonMultikeyFieldIsAttachedToIndexScan) {
+    MultikeyPaths multikeyPaths{std::set<size_t>{}, {0U}};
+    addIndex(BSON("a" << 1 << "b" << 1), multikeyPaths);
+    runQuery(fromjson("{a: /foo/}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {a: /foo/}}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {filter: {a: /foo/}, pattern: {a: 1, b: 1}}}}}");
+}
+
+TEST_F(QueryPlannerTest, CoveredPredicateOnMultikeyFieldIsAttachedToFetch) {
+    MultikeyPaths multikeyPaths{{0U}, std::set<size_t>{}};
+    addIndex(BSON("a" << 1 << "b" << 1), multikeyPaths);
+    runQuery(fromjson("{a: /foo/}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {a: /foo/}}}");
+    assertSolutionExists(
+        "{fetch: {filter: {a: /foo/}, node: {ixscan: {filter: null, pattern: {a: 1, b: 1}}}}}");
+}
+
+TEST_F(QueryPlannerTest, CoveredPredicateInAndOnNonMultikeyFieldIsAttachedToIndexScan) {
+    MultikeyPaths multikeyPaths{{0U}, std::set<size_t>{}};
+    addIndex(BSON("a" << 1 << "b" << 1), multikeyPaths);
+    runQuery(fromjson("{a: 2, b: /foo/}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {$and: [{a: 2}, {b: /foo/}]}}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {filter: {b: /foo/}, pattern: {a: 1, b: 1}}}}}");
+}
+
+TEST_F(QueryPlannerTest, CoveredOrOnNonMultikeyFieldIsAttachedToIndexScan) {
+    MultikeyPaths multikeyPaths{std::set<size_t>{}, {0U}};
+    addIndex(BSON("a" << 1 << "b" << 1), multikeyPaths);
+    runQuery(fromjson("{$or: [{a: /0/}, {a: /1/}]}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {$or: [{a: /0/}, {a: /1/}]}}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {filter: {$or: [{a: /0/}, {a: /1/}]}, "
+        "pattern: {a: 1, b: 1}}}}}");
+}
+
+TEST_F(QueryPlannerTest, CoveredOrOnMultikeyFieldIsAttachedToFetch) {
+    MultikeyPaths multikeyPaths{{0U}, std::set<size_t>{}};
+    addIndex(BSON("a" << 1 << "b" << 1), multikeyPaths);
+    runQuery(fromjson("{$or: [{a: /0/}, {a: /1/}]}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {$or: [{a: /0/}, {a: /1/}]}}}");
+    assertSolutionExists(
+        "{fetch: {filter: {$or: [{a: /0/}, {a: /1/}]}, node: {ixscan: "
+        "{filter: null, pattern: {a: 1, b: 1}}}}}");
+}
 }  // namespace
@@ -262,6 +262,19 @@ TEST_F(QueryPlannerTest, DottedFieldCovering) {
         "bounds: {'a.b': [[5,5,true,true]]}}}}}");
 }
 
+TEST_F(QueryPlannerTest, DottedFieldProjectionOfFetchedDocumentUsesSimpleFastPath) {
+    addIndex(BSON("a.b" << 1));
+    runQuerySortProj(fromjson("{'a.b': 5}"), BSONObj(), fromjson("{_id: 0, 'a.b': 1, c: 1}"));
+
+    ASSERT_EQUALS(getNumSolutions(), 2U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, 'a.b': 1, c: 1}, type: 'simple', node: "
+        "{cscan: {dir: 1, filter: {'a.b': 5}}}}}");
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, 'a.b': 1, c: 1}, type: 'simple', node: {fetch: {filter: null, "
+        "node: {ixscan: {filter: null, pattern: {'a.b': 1}}}}}}}");
+}
+
 TEST_F(QueryPlannerTest, IdCovering) {
     runQuerySortProj(fromjson("{_id: {$gt: 10}}"), BSONObj(), fromjson("{_id: 1}"));
 
@@ -1247,6 +1260,40 @@ TEST_F(QueryPlannerTest, EmptyQueryWithProjectionUsesCollscanIfIndexCollationDif
         "{cscan: {dir: 1}}}}");
 }
 
+TEST_F(QueryPlannerTest, QueryWithProjectionUsesCoveredIxscanFilteringKeysIfEnabled) {
+    params.options = QueryPlannerParams::GENERATE_COVERED_IXSCANS;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQueryAsCommand(fromjson(
+        "{find: 'testns', filter: {b: {$gt: 5, $ne: 7}}, projection: {_id: 0, a: 1}}"));
+    assertNumSolutions(1);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: "
+        "{ixscan: {filter: {b: {$gt: 5, $ne: 7}}, pattern: {a: 1, b: 1},"
+        "bounds: {a: [['MinKey', 'MaxKey', true, true]], b: [['MinKey', 'MaxKey', true, true]]}"
+        "}}}}");
+}
+
+TEST_F(QueryPlannerTest, QueryWithProjectionUsesCollscanIfFilterReadsUnindexedField) {
+    params.options = QueryPlannerParams::GENERATE_COVERED_IXSCANS;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {b: {$gt: 5}, c: 1}, projection: {_id: 0, a: 1}}"));
+    assertNumSolutions(1);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: "
+        "{cscan: {dir: 1, filter: {b: {$gt: 5}, c: 1}}}}}");
+}
+
+TEST_F(QueryPlannerTest, QueryWithProjectionUsesCollscanIfFilterTellsMissingFromNull) {
+    params.options = QueryPlannerParams::GENERATE_COVERED_IXSCANS;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQueryAsCommand(fromjson(
+        "{find: 'testns', filter: {b: {$exists: false}}, projection: {_id: 0, a: 1}}"));
+    assertNumSolutions(1);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: "
+        "{cscan: {dir: 1, filter: {b: {$exists: false}}}}}}");
+}
 
 TEST_F(QueryPlannerTest, NoFetchStageWhenSingleFieldSortIsCoveredByIndex) {
     params.options &= ~QueryPlannerParams::INCLUDE_COLLSCAN;
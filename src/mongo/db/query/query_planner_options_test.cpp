@@ -30,6 +30,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_test_fixture.h"
 #include "mongo/unittest/unittest.h"
@@ -553,6 +554,76 @@ TEST_F(QueryPlannerTest, ShardFilterNoIndexNotCovered) {
         "{ixscan: {pattern: {b: 1}}}}}}}}}");
 }
 
+/**
+ * Returns the intervals [0, 10) and [20, 30) on field 'a', as owned by a shard with chunks on a
+ * shard key {a: 1}.
+ */
+OrderedIntervalList makeOwnedIntervalsOnA() {
+    OrderedIntervalList oil("a");
+    oil.intervals.push_back(IndexBoundsBuilder::makeRangeInterval(
+        BSON("" << 0 << "" << 10), BoundInclusion::kIncludeStartKeyOnly));
+    oil.intervals.push_back(IndexBoundsBuilder::makeRangeInterval(
+        BSON("" << 20 << "" << 30), BoundInclusion::kIncludeStartKeyOnly));
+    return oil;
+}
+
+TEST_F(QueryPlannerTest, ShardFilterRestrictsIndexBoundsToOwnedIntervals) {
+    params.options = QueryPlannerParams::INCLUDE_SHARD_FILTER;
+    params.shardKey = BSON("a" << 1);
+    params.shardKeyPrefixOwnedIntervals = makeOwnedIntervalsOnA();
+    addIndex(BSON("a" << 1));
+
+    runQuery(fromjson("{a: {$gte: 5}}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {node: {sharding_filter: {node: {ixscan: {pattern: {a: 1}, "
+        "bounds: {a: [[5, 10, true, false], [20, 30, true, false]]}}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, ShardFilterRestrictsDescendingIndexBoundsToOwnedIntervals) {
+    params.options = QueryPlannerParams::INCLUDE_SHARD_FILTER;
+    params.shardKey = BSON("a" << 1);
+    params.shardKeyPrefixOwnedIntervals = makeOwnedIntervalsOnA();
+    addIndex(BSON("a" << -1 << "b" << 1));
+
+    runQuery(fromjson("{a: {$lte: 25}, b: 1}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {node: {sharding_filter: {node: {ixscan: {pattern: {a: -1, b: 1}, "
+        "bounds: {a: [[25, 20, true, true], [10, 0, false, true]], b: [[1, 1, true, true]]}}}"
+        "}}}}");
+}
+
+TEST_F(QueryPlannerTest, ShardFilterDoesNotRestrictBoundsOfIndexNotLeadingWithShardKey) {
+    params.options = QueryPlannerParams::INCLUDE_SHARD_FILTER;
+    params.shardKey = BSON("a" << 1);
+    params.shardKeyPrefixOwnedIntervals = makeOwnedIntervalsOnA();
+    addIndex(BSON("b" << 1 << "a" << 1));
+
+    runQuery(fromjson("{b: 1, a: {$gte: 5}}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {node: {sharding_filter: {node: {ixscan: {pattern: {b: 1, a: 1}, "
+        "bounds: {b: [[1, 1, true, true]], a: [[5, Infinity, true, true]]}}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, ShardFilterKeepsIndexBoundsDisjointFromOwnedIntervals) {
+    params.options = QueryPlannerParams::INCLUDE_SHARD_FILTER;
+    params.shardKey = BSON("a" << 1);
+    params.shardKeyPrefixOwnedIntervals = makeOwnedIntervalsOnA();
+    addIndex(BSON("a" << 1));
+
+    runQuery(fromjson("{a: 15}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {node: {sharding_filter: {node: {ixscan: {pattern: {a: 1}, "
+        "bounds: {a: [[15, 15, true, true]]}}}}}}}");
+}
+
 TEST_F(QueryPlannerTest, CannotTrimIxisectParam) {
     params.options = QueryPlannerParams::INDEX_INTERSECTION;
     params.options |= QueryPlannerParams::NO_TABLE_SCAN;
@@ -934,5 +1005,60 @@ TEST_F(QueryPlannerTest, PreserveRecordIdOptionPrecludesSimpleSort) {
         "{sort: {pattern: {a: 1}, limit: 0, type: 'default', node: {cscan: {dir: 1}}}}");
 }
 
+TEST_F(QueryPlannerTest, NoSkipScanWithoutOption) {
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuery(fromjson("{b: 5}"));
+    assertHasOnlyCollscan();
+}
+
+TEST_F(QueryPlannerTest, SkipScanOverUnconstrainedLeadingField) {
+    params.options = QueryPlannerParams::INDEX_SKIP_SCAN;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuery(fromjson("{b: 5}"));
+
+    // The skip scan is raced against a collection scan even though INCLUDE_COLLSCAN is not set.
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {b: 5}}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {a: 1, b: 1}, "
+        "bounds: {a: [['MinKey', 'MaxKey', true, true]], b: [[5, 5, true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanOverDescendingLeadingField) {
+    params.options = QueryPlannerParams::INDEX_SKIP_SCAN;
+    addIndex(BSON("a" << -1 << "b" << 1 << "c" << 1));
+    runQuery(fromjson("{c: {$gt: 1}, b: 2}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {a: -1, b: 1, c: 1}, "
+        "bounds: {a: [['MaxKey', 'MinKey', true, true]], b: [[2, 2, true, true]], "
+        "c: [[1, Infinity, false, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanDoesNotForceCollscanWhenAnotherIndexApplies) {
+    params.options = QueryPlannerParams::INDEX_SKIP_SCAN;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    addIndex(BSON("b" << 1));
+    runQuery(fromjson("{b: 5}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {b: 1}, bounds: {b: [[5, 5, true, "
+        "true]]}}}}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {a: 1, b: 1}, "
+        "bounds: {a: [['MinKey', 'MaxKey', true, true]], b: [[5, 5, true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, NoSkipScanOverMultikeyOrSparseIndex) {
+    params.options = QueryPlannerParams::INDEX_SKIP_SCAN;
+    addIndex(BSON("a" << 1 << "b" << 1), true);
+    addIndex(BSON("c" << 1 << "b" << 1), false, true);
+    runQuery(fromjson("{b: 5}"));
+    assertHasOnlyCollscan();
+}
+
 }  // namespace
 }  // namespace mongo
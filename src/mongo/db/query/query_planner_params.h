@@ -32,6 +32,7 @@
 #include <vector>
 
 #include "mongo/db/jsobj.h"
+#include "mongo/db/query/index_bounds.h"
 #include "mongo/db/query/index_entry.h"
 #include "mongo/db/query/query_knobs_gen.h"
 
@@ -97,6 +98,11 @@ struct QueryPlannerParams {
         // ids. In some cases, record ids can be discarded as an optimization when they will not be
         // consumed downstream.
         PRESERVE_RECORD_ID = 1 << 10,
+
+        // Set this to allow index scans over compound indexes whose leading fields have no
+        // predicates. Such a scan seeks to each distinct leading key prefix in turn and applies the
+        // bounds on the trailing fields within it.
+        INDEX_SKIP_SCAN = 1 << 11,
     };
 
     // See Options enum above.
@@ -110,6 +116,12 @@ struct QueryPlannerParams {
     // forcing a fetch.
     BSONObj shardKey;
 
+    // If INCLUDE_SHARD_FILTER is set, this may contain the ascending union of the intervals of the
+    // leading shard key field spanned by the chunks this shard owns. Index scans whose leading
+    // field is that shard key field have their bounds intersected with these intervals, so that
+    // ranges which can only contain orphan documents are not scanned at all.
+    boost::optional<OrderedIntervalList> shardKeyPrefixOwnedIntervals;
+
     // Were index filters applied to indices?
     bool indexFiltersApplied;
 
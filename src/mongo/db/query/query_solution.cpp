@@ -208,6 +208,10 @@ void TextNode::appendToString(str::stream* ss, int indent) const {
     *ss << "diacriticSensitive= " << ftsQuery->getDiacriticSensitive() << '\n';
     addIndent(ss, indent + 1);
     *ss << "indexPrefix = " << indexPrefix.toString() << '\n';
+    if (topK) {
+        addIndent(ss, indent + 1);
+        *ss << "topK = " << topK << '\n';
+    }
     if (nullptr != filter) {
         addIndent(ss, indent + 1);
         *ss << " filter = " << filter->debugString();
@@ -222,6 +226,7 @@ QuerySolutionNode* TextNode::clone() const {
     copy->_sort = this->_sort;
     copy->ftsQuery = this->ftsQuery->clone();
     copy->indexPrefix = this->indexPrefix;
+    copy->topK = this->topK;
 
     return copy;
 }
@@ -1280,6 +1285,10 @@ void DistinctNode::appendToString(str::stream* ss, int indent) const {
     *ss << "direction = " << direction << '\n';
     addIndent(ss, indent + 1);
     *ss << "bounds = " << bounds.toString() << '\n';
+    if (filter) {
+        addIndent(ss, indent + 1);
+        *ss << "filter = " << filter->debugString();
+    }
 }
 
 QuerySolutionNode* DistinctNode::clone() const {
@@ -1318,6 +1327,12 @@ void CountScanNode::appendToString(str::stream* ss, int indent) const {
     *ss << "startKey = " << startKey << '\n';
     addIndent(ss, indent + 1);
     *ss << "endKey = " << endKey << '\n';
+    for (const auto& range : additionalRanges) {
+        addIndent(ss, indent + 1);
+        *ss << "startKey = " << range.startKey << '\n';
+        addIndent(ss, indent + 1);
+        *ss << "endKey = " << range.endKey << '\n';
+    }
 }
 
 QuerySolutionNode* CountScanNode::clone() const {
@@ -1329,6 +1344,7 @@ QuerySolutionNode* CountScanNode::clone() const {
     copy->startKeyInclusive = this->startKeyInclusive;
     copy->endKey = this->endKey;
     copy->endKeyInclusive = this->endKeyInclusive;
+    copy->additionalRanges = this->additionalRanges;
 
     return copy;
 }
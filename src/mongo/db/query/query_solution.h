@@ -309,6 +309,9 @@ struct TextNode : public QuerySolutionNode {
     // text node while creating the text leaf node and convert them into a BSONObj index prefix
     // when we finish the text leaf node.
     BSONObj indexPrefix;
+
+    // If non-zero, the parent only keeps the 'topK' documents with the highest text score.
+    size_t topK = 0;
 };
 
 struct CollectionScanNode : public QuerySolutionNode {
@@ -1097,6 +1100,9 @@ struct CountScanNode : public QuerySolutionNode {
 
     BSONObj endKey;
     bool endKeyInclusive;
+
+    // Further ranges to count after the one from 'startKey' to 'endKey', in index order.
+    std::vector<IndexKeyRange> additionalRanges;
 };
 
 /**
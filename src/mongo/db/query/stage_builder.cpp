@@ -291,6 +291,7 @@ std::unique_ptr<PlanStage> buildStages(OperationContext* opCtx,
             // created by planning a query that contains "no-op" expressions.
             params.query = static_cast<FTSQueryImpl&>(*node->ftsQuery);
             params.wantTextScore = cq.metadataDeps()[DocumentMetadataFields::kTextScore];
+            params.topK = node->topK;
             return std::make_unique<TextStage>(opCtx, params, ws, node->filter.get());
         }
         case STAGE_SHARDING_FILTER: {
@@ -320,7 +321,7 @@ std::unique_ptr<PlanStage> buildStages(OperationContext* opCtx,
             params.scanDirection = dn->direction;
             params.bounds = dn->bounds;
             params.fieldNo = dn->fieldNo;
-            return std::make_unique<DistinctScan>(opCtx, std::move(params), ws);
+            return std::make_unique<DistinctScan>(opCtx, std::move(params), ws, dn->filter.get());
         }
         case STAGE_COUNT_SCAN: {
             const CountScanNode* csn = static_cast<const CountScanNode*>(root);
@@ -342,6 +343,7 @@ std::unique_ptr<PlanStage> buildStages(OperationContext* opCtx,
             params.startKeyInclusive = csn->startKeyInclusive;
             params.endKey = csn->endKey;
             params.endKeyInclusive = csn->endKeyInclusive;
+            params.additionalRanges = csn->additionalRanges;
             return std::make_unique<CountScan>(opCtx, std::move(params), ws);
         }
         case STAGE_ENSURE_SORTED: {
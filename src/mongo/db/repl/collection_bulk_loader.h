@@ -64,6 +64,11 @@ public:
      */
     virtual Status commit() = 0;
 
+    /**
+     * Returns how long building the indexes took, once commit() has succeeded.
+     */
+    virtual BSONObj getIndexBuildStats() const = 0;
+
     virtual std::string toString() const = 0;
     virtual BSONObj toBSON() const = 0;
 };
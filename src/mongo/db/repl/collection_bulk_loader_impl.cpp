@@ -109,6 +109,13 @@ Status CollectionBulkLoaderImpl::init(const std::vector<BSONObj>& secondaryIndex
             _idIndexBlock.reset();
         }
 
+        // Documents are only inserted through insertDocumentForBulkLoader() when there are index
+        // blocks to feed, see insertDocuments().
+        if ((_idIndexBlock || _secondaryIndexesBlock) &&
+            collectionBulkLoaderUsesRecordStoreBulkLoader) {
+            _recordBulkLoader = coll->getRecordStore()->makeBulkLoader(_opCtx.get());
+        }
+
         return Status::OK();
     });
 }
@@ -119,8 +126,18 @@ Status CollectionBulkLoaderImpl::_insertDocumentsForUncappedCollection(
     auto iter = begin;
     while (iter != end) {
         std::vector<RecordId> locs;
+        bool appendedToRecordStore = false;
         Status status = writeConflictRetry(
             _opCtx.get(), "CollectionBulkLoaderImpl/insertDocumentsUncapped", _nss.ns(), [&] {
+                // Documents appended through the record store bulk loader are not removed when the
+                // WriteUnitOfWork rolls back, so retrying the batch would insert them twice.
+                if (appendedToRecordStore) {
+                    return Status(ErrorCodes::WriteConflict,
+                                  str::stream() << "Write conflict while bulk loading documents "
+                                                   "into "
+                                                << _nss.ns());
+                }
+
                 WriteUnitOfWork wunit(_opCtx.get());
                 auto insertIter = iter;
                 int bytesInBlock = 0;
@@ -134,9 +151,10 @@ Status CollectionBulkLoaderImpl::_insertDocumentsForUncappedCollection(
                 while (insertIter != end && bytesInBlock < collectionBulkLoaderBatchSizeInBytes) {
                     const auto& doc = *insertIter++;
                     bytesInBlock += doc.objsize();
+                    appendedToRecordStore = appendedToRecordStore || _recordBulkLoader;
                     // This version of insert will not update any indexes.
                     const auto status = _autoColl->getCollection()->insertDocumentForBulkLoader(
-                        _opCtx.get(), doc, onRecordInserted);
+                        _opCtx.get(), doc, onRecordInserted, _recordBulkLoader.get());
                     if (!status.isOK()) {
                         return status;
                     }
@@ -214,6 +232,16 @@ Status CollectionBulkLoaderImpl::commit() {
         _stats.startBuildingIndexes = Date_t::now();
         LOGV2_DEBUG(21130, 2, "Creating indexes for ns: {nss_ns}", "nss_ns"_attr = _nss.ns());
         UnreplicatedWritesBlock uwb(_opCtx.get());
+        BSONObjBuilder indexBulkLoadMillis;
+
+        // The documents have to be visible before duplicates can be deleted below.
+        if (_recordBulkLoader) {
+            auto status = _recordBulkLoader->finish();
+            if (!status.isOK()) {
+                return status;
+            }
+            _recordBulkLoader.reset();
+        }
 
         // Commit before deleting dups, so the dups will be removed from secondary indexes when
         // deleted.
@@ -222,6 +250,7 @@ Status CollectionBulkLoaderImpl::commit() {
             if (!status.isOK()) {
                 return status;
             }
+            _secondaryIndexesBlock->appendBulkLoadMillis(&indexBulkLoadMillis);
 
             // This should always return Status::OK() as secondary index builds ignore duplicate key
             // constraints causing them to not be recorded.
@@ -254,6 +283,7 @@ Status CollectionBulkLoaderImpl::commit() {
             if (!status.isOK()) {
                 return status;
             }
+            _idIndexBlock->appendBulkLoadMillis(&indexBulkLoadMillis);
 
             // If we were to delete the documents after committing the index build, it's possible
             // that the storage engine unindexes a different record with the same key, but different
@@ -309,6 +339,7 @@ Status CollectionBulkLoaderImpl::commit() {
         }
 
         _stats.endBuildingIndexes = Date_t::now();
+        _stats.indexBulkLoadMillis = indexBulkLoadMillis.obj();
         LOGV2_DEBUG(21131,
                     2,
                     "Done creating indexes for ns: {nss_ns}, stats: {stats}",
@@ -322,6 +353,8 @@ Status CollectionBulkLoaderImpl::commit() {
 
 void CollectionBulkLoaderImpl::_releaseResources() {
     invariant(&cc() == _opCtx->getClient());
+    _recordBulkLoader.reset();
+
     if (_secondaryIndexesBlock) {
         _secondaryIndexesBlock->cleanUpAfterBuild(
             _opCtx.get(), _collection, MultiIndexBlock::kNoopOnCleanUpFn);
@@ -372,6 +405,10 @@ Status CollectionBulkLoaderImpl::_addDocumentToIndexBlocks(const BSONObj& doc,
     return Status::OK();
 }
 
+BSONObj CollectionBulkLoaderImpl::getIndexBuildStats() const {
+    return _stats.toBSON();
+}
+
 CollectionBulkLoaderImpl::Stats CollectionBulkLoaderImpl::getStats() const {
     return _stats;
 }
@@ -387,6 +424,7 @@ BSONObj CollectionBulkLoaderImpl::Stats::toBSON() const {
     auto indexElapsed = endBuildingIndexes - startBuildingIndexes;
     long long indexElapsedMillis = duration_cast<Milliseconds>(indexElapsed).count();
     bob.appendNumber("indexElapsedMillis", indexElapsedMillis);
+    bob.append("indexBulkLoadMillis", indexBulkLoadMillis);
     return bob.obj();
 }
 
@@ -55,6 +55,8 @@ public:
     struct Stats {
         Date_t startBuildingIndexes;
         Date_t endBuildingIndexes;
+        // Time spent loading each index from its external sorter, keyed by index name.
+        BSONObj indexBulkLoadMillis;
 
         std::string toString() const;
         BSONObj toBSON() const;
@@ -72,6 +74,8 @@ public:
                                    const std::vector<BSONObj>::const_iterator end) override;
     virtual Status commit() override;
 
+    virtual BSONObj getIndexBuildStats() const override;
+
     CollectionBulkLoaderImpl::Stats getStats() const;
 
     virtual std::string toString() const override;
@@ -109,6 +113,7 @@ private:
     NamespaceString _nss;
     std::unique_ptr<MultiIndexBlock> _idIndexBlock;
     std::unique_ptr<MultiIndexBlock> _secondaryIndexesBlock;
+    std::unique_ptr<RecordStoreBulkLoader> _recordBulkLoader;
     BSONObj _idIndexSpec;
     Stats _stats;
 };
@@ -200,6 +200,10 @@ BaseCloner::AfterStageBehavior CollectionCloner::queryStage() {
     // We want to free the _collLoader regardless of whether the commit succeeds.
     std::unique_ptr<CollectionBulkLoader> loader = std::move(_collLoader);
     uassertStatusOK(loader->commit());
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _stats.indexBuilds = loader->getIndexBuildStats();
+    }
     return kContinueNormally;
 }
 
@@ -300,7 +304,11 @@ void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
     _firstBatchOfQueryRound = false;
 
     {
-        stdx::lock_guard<Latch> lk(_mutex);
+        stdx::unique_lock<Latch> lk(_mutex);
+        // Only queue this batch once the database work thread has taken the previous one. This
+        // lets receiving a batch overlap with inserting the one before it, while never buffering
+        // more than one batch ahead of the inserts.
+        _documentsToInsertTaken.wait(lk, [&] { return _documentsToInsert.empty(); });
         _stats.receivedBatches++;
         while (iter.moreInCurrentBatch()) {
             _documentsToInsert.emplace_back(iter.nextSafe());
@@ -343,28 +351,32 @@ void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
 }
 
 void CollectionCloner::insertDocumentsCallback(const executor::TaskExecutor::CallbackArgs& cbd) {
-    uassertStatusOK(cbd.status);
-
+    std::vector<BSONObj> docs;
     {
+        // Take the documents even if this callback was canceled, so handleNextBatch() never waits
+        // for a batch that will not be inserted.
         stdx::lock_guard<Latch> lk(_mutex);
-        std::vector<BSONObj> docs;
-        if (_documentsToInsert.size() == 0) {
+        _documentsToInsert.swap(docs);
+        _documentsToInsertTaken.notify_all();
+        uassertStatusOK(cbd.status);
+
+        if (docs.empty()) {
             LOGV2_WARNING(21145,
                           "insertDocumentsCallback, but no documents to insert for ns:{sourceNss}",
                           "sourceNss"_attr = _sourceNss);
             return;
         }
-        _documentsToInsert.swap(docs);
         _stats.documentsCopied += docs.size();
         ++_stats.fetchedBatches;
         _progressMeter.hit(int(docs.size()));
         invariant(_collLoader);
-
-        // The insert must be done within the lock, because CollectionBulkLoader is not
-        // thread safe.
-        uassertStatusOK(_collLoader->insertDocuments(docs.cbegin(), docs.cend()));
     }
 
+    // CollectionBulkLoader is not thread safe, but only tasks on '_dbWorkTaskRunner' use it and
+    // they run one at a time, so the insert does not need to hold the lock. Not holding it lets
+    // handleNextBatch() receive the next batch while this one is inserted.
+    uassertStatusOK(_collLoader->insertDocuments(docs.cbegin(), docs.cend()));
+
     initialSyncHangDuringCollectionClone.executeIf(
         [&](const BSONObj&) {
             LOGV2(21138,
@@ -457,6 +469,9 @@ void CollectionCloner::Stats::append(BSONObjBuilder* builder) const {
         }
     }
     builder->appendNumber("receivedBatches", receivedBatches);
+    if (!indexBuilds.isEmpty()) {
+        builder->append("indexBuilds", indexBuilds);
+    }
 }
 
 }  // namespace repl
@@ -34,6 +34,7 @@
 
 #include "mongo/db/repl/base_cloner.h"
 #include "mongo/db/repl/task_runner.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/util/progress_meter.h"
 
 namespace mongo {
@@ -58,6 +59,7 @@ public:
         size_t indexes{0};
         size_t fetchedBatches{0};  // This is actually inserted batches.
         size_t receivedBatches{0};
+        BSONObj indexBuilds;  // Reported by the CollectionBulkLoader once it commits.
 
         std::string toString() const;
         BSONObj toBSON() const;
@@ -263,6 +265,8 @@ private:
     ScheduleDbWorkFn _scheduleDbWorkFn;  // (R)
     // Documents read from source to insert.
     std::vector<BSONObj> _documentsToInsert;  // (M)
+    // Signalled when the database work thread takes '_documentsToInsert'.
+    stdx::condition_variable _documentsToInsertTaken;  // (M)
     Stats _stats;                             // (M)
     // Putting _dbWorkTaskRunner last ensures anything the database work threads depend on,
     // like _documentsToInsert, is destroyed after those threads exit.
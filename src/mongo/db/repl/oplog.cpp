@@ -36,6 +36,7 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <deque>
 #include <memory>
 #include <set>
@@ -360,6 +361,52 @@ OpTime logOp(OperationContext* opCtx, MutableOplogEntry* oplogEntry) {
     return slot;
 }
 
+void writeToImageCollection(OperationContext* opCtx, const ImageEntry& imageEntry) {
+    invariant(opCtx->lockState()->inAWriteUnitOfWork());
+    UnreplicatedWritesBlock unreplicated(opCtx);
+    AutoGetCollection autoColl(opCtx, NamespaceString::kConfigImagesNamespace, MODE_IX);
+    auto collection = autoColl.getCollection();
+    uassert(5212033,
+            str::stream() << "Unable to store the image of a retryable findAndModify because the "
+                          << NamespaceString::kConfigImagesNamespace << " collection is missing",
+            collection);
+
+    const auto imageDoc = imageEntry.toBSON();
+    const auto idQuery = BSON(ImageEntry::k_idFieldName << imageEntry.get_id().toBSON());
+    const auto recordId = Helpers::findById(opCtx, collection, idQuery);
+    if (recordId.isNull()) {
+        auto status = collection->insertDocument(opCtx, InsertStatement(imageDoc), nullptr, false);
+        if (status == ErrorCodes::DuplicateKey) {
+            // Another writer for the same session raced this one; retry as an update.
+            throw WriteConflictException();
+        }
+        uassertStatusOK(status);
+        return;
+    }
+
+    // Oplog application may apply the findAndModifies of one session on different writer threads,
+    // so never let an older image replace a newer one.
+    const auto existingDoc = collection->docFor(opCtx, recordId);
+    const auto existing = ImageEntry::parse(IDLParserErrorContext("writeToImageCollection"),
+                                            existingDoc.value());
+    if (existing.getTxnNum() > imageEntry.getTxnNum() ||
+        (existing.getTxnNum() == imageEntry.getTxnNum() &&
+         existing.getTs() >= imageEntry.getTs())) {
+        return;
+    }
+
+    CollectionUpdateArgs args;
+    args.update = imageDoc;
+    args.criteria = idQuery;
+    collection->updateDocument(opCtx,
+                               recordId,
+                               existingDoc,
+                               imageDoc,
+                               false,  // indexesAffected = false because _id is the only index
+                               nullptr,
+                               &args);
+}
+
 std::vector<OpTime> logInsertOps(OperationContext* opCtx,
                                  MutableOplogEntry* oplogEntryTemplate,
                                  std::vector<InsertStatement>::const_iterator begin,
@@ -390,18 +437,26 @@ std::vector<OpTime> logInsertOps(OperationContext* opCtx,
 
     WriteUnitOfWork wuow(opCtx);
 
+    // Fetch the optimes not already fetched by the caller with a single reservation.
+    const size_t missingSlots = std::count_if(
+        begin, end, [](const InsertStatement& stmt) { return stmt.oplogSlot.isNull(); });
+    std::vector<OplogSlot> reservedSlots;
+    if (missingSlots > 0) {
+        reservedSlots = oplogInfo->getNextOpTimes(opCtx, missingSlots);
+    }
+    auto nextReservedSlot = reservedSlots.begin();
+
     std::vector<OpTime> opTimes(count);
     std::vector<Timestamp> timestamps(count);
     std::vector<BSONObj> bsonOplogEntries(count);
     std::vector<Record> records(count);
+    // Every field that differs between the entries of the batch is set on each iteration, so a
+    // single copy of the template serves all of them.
+    MutableOplogEntry oplogEntry = *oplogEntryTemplate;
     for (size_t i = 0; i < count; i++) {
-        // Make a copy from the template for each insert oplog entry.
-        MutableOplogEntry oplogEntry = *oplogEntryTemplate;
-        // Make a mutable copy.
         auto insertStatementOplogSlot = begin[i].oplogSlot;
-        // Fetch optime now, if not already fetched.
         if (insertStatementOplogSlot.isNull()) {
-            insertStatementOplogSlot = oplogInfo->getNextOpTimes(opCtx, 1U)[0];
+            insertStatementOplogSlot = *nextReservedSlot++;
         }
         oplogEntry.setObject(begin[i].doc);
         oplogEntry.setOpTime(insertStatementOplogSlot);
@@ -927,6 +982,31 @@ StatusWith<OplogApplication::Mode> OplogApplication::parseMode(const std::string
     MONGO_UNREACHABLE;
 }
 
+namespace {
+
+/**
+ * Mirrors the primary's write of a retryable findAndModify image to config.image_collection. The
+ * image is dropped if the document or the image collection is absent, which only happens while
+ * replaying history that a later oplog entry supersedes.
+ */
+void writeRetryImage(OperationContext* opCtx, const OplogEntry& op, const BSONObj& image) {
+    if (image.isEmpty() || !op.getSessionId() || !op.getTxnNumber() ||
+        !CollectionCatalog::get(opCtx).lookupCollectionByNamespace(
+            opCtx, NamespaceString::kConfigImagesNamespace)) {
+        return;
+    }
+
+    ImageEntry imageEntry;
+    imageEntry.set_id(*op.getSessionId());
+    imageEntry.setTxnNum(*op.getTxnNumber());
+    imageEntry.setTs(op.getTimestamp());
+    imageEntry.setImageKind(*op.getNeedsRetryImage());
+    imageEntry.setImage(image);
+    writeToImageCollection(opCtx, imageEntry);
+}
+
+}  // namespace
+
 // @return failure status if an update should have happened and the document DNE.
 // See replset initial sync code.
 Status applyOperation_inlock(OperationContext* opCtx,
@@ -1240,6 +1320,12 @@ Status applyOperation_inlock(OperationContext* opCtx,
                     uassertStatusOK(opCtx->recoveryUnit()->setTimestamp(timestamp));
                 }
 
+                BSONObj preImage;
+                if (collection && op.getNeedsRetryImage() == RetryImageEnum::kPreImage) {
+                    Helpers::findOne(opCtx, collection, updateCriteria, preImage);
+                    preImage = preImage.getOwned();
+                }
+
                 UpdateResult ur = update(opCtx, db, request);
                 if (ur.numMatched == 0 && ur.upserted.isEmpty()) {
                     if (ur.modifiers) {
@@ -1283,6 +1369,17 @@ Status applyOperation_inlock(OperationContext* opCtx,
                     }
                 }
 
+                if (op.getNeedsRetryImage() == RetryImageEnum::kPreImage) {
+                    writeRetryImage(opCtx, op, preImage);
+                } else if (op.getNeedsRetryImage() == RetryImageEnum::kPostImage) {
+                    BSONObj postImage;
+                    if (auto coll = CollectionCatalog::get(opCtx).lookupCollectionByNamespace(
+                            opCtx, requestNss)) {
+                        Helpers::findOne(opCtx, coll, updateCriteria, postImage);
+                    }
+                    writeRetryImage(opCtx, op, postImage);
+                }
+
                 wuow.commit();
                 return Status::OK();
             });
@@ -1325,7 +1422,15 @@ Status applyOperation_inlock(OperationContext* opCtx,
                 if (timestamp != Timestamp::min()) {
                     uassertStatusOK(opCtx->recoveryUnit()->setTimestamp(timestamp));
                 }
+                BSONObj preImage;
+                if (collection && op.getNeedsRetryImage()) {
+                    Helpers::findOne(opCtx, collection, deleteCriteria, preImage);
+                    preImage = preImage.getOwned();
+                }
                 deleteObjects(opCtx, collection, requestNss, deleteCriteria, true /* justOne */);
+                if (op.getNeedsRetryImage()) {
+                    writeRetryImage(opCtx, op, preImage);
+                }
                 wuow.commit();
             });
 
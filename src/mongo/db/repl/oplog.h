@@ -67,6 +67,12 @@ public:
     StmtId stmtId = kUninitializedStmtId;
     OplogSlot oplogSlot;
     BSONObj doc;
+
+    // The shard key of 'doc' and the key pattern it was extracted with. Populated lazily by
+    // shardkeyutil::extractShardKeyFromInsertStatement, so that the several sharding observers of
+    // an insert extract (and, for hashed shard keys, hash) the shard key only once per document.
+    mutable BSONObj shardKeyPattern;
+    mutable BSONObj shardKey;
 };
 
 namespace repl {
@@ -134,6 +140,15 @@ std::vector<OpTime> logInsertOps(OperationContext* opCtx,
  */
 OpTime logOp(OperationContext* opCtx, MutableOplogEntry* oplogEntry);
 
+/**
+ * Upserts 'imageEntry' into config.image_collection without replicating the write. Primaries call
+ * this when logging a retryable findAndModify marked with "needsRetryImage", and every other member
+ * calls it when applying that oplog entry, which keeps the collection in step on all of them.
+ *
+ * Must be called within the WriteUnitOfWork of the write the image belongs to.
+ */
+void writeToImageCollection(OperationContext* opCtx, const ImageEntry& imageEntry);
+
 // Flush out the cached pointer to the oplog.
 void clearLocalOplogPtr();
 
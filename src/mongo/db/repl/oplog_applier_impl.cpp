@@ -32,6 +32,10 @@
 
 #include "mongo/db/repl/oplog_applier_impl.h"
 
+#include <algorithm>
+#include <numeric>
+#include <queue>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/database.h"
@@ -51,12 +55,16 @@
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log.h"
 #include "mongo/util/log_with_sampling.h"
+#include "mongo/util/timer.h"
 #include "third_party/murmurhash3/MurmurHash3.h"
 
 namespace mongo {
 namespace repl {
 namespace {
 
+// Number of hash buckets per writer vector that fillWriterVectors() balances over the writers.
+const size_t kBucketsPerWriterVector = 8;
+
 MONGO_FAIL_POINT_DEFINE(pauseBatchApplicationBeforeCompletion);
 MONGO_FAIL_POINT_DEFINE(pauseBatchApplicationAfterWritingOplogEntries);
 MONGO_FAIL_POINT_DEFINE(hangAfterRecordingOpApplicationStartTime);
@@ -72,6 +80,19 @@ ServerStatusMetricField<Counter64> displayOplogApplicationBatchSize("repl.apply.
 // Number and time of each ApplyOps worker pool round
 TimerStats applyBatchStats;
 ServerStatusMetricField<TimerStats> displayOpBatchesApplied("repl.apply.batches", &applyBatchStats);
+// Time spent in each stage of batch application. The applier thread waits on the batcher, while
+// writing the batch to the oplog overlaps with partitioning it into writer vectors.
+TimerStats waitForBatchStats;
+ServerStatusMetricField<TimerStats> displayWaitForBatch("repl.apply.stages.waitForBatch",
+                                                        &waitForBatchStats);
+TimerStats fillWriterVectorsStats;
+ServerStatusMetricField<TimerStats> displayFillWriterVectors("repl.apply.stages.fillWriterVectors",
+                                                             &fillWriterVectorsStats);
+TimerStats writeOplogStats;
+ServerStatusMetricField<TimerStats> displayWriteOplog("repl.apply.stages.writeOplog",
+                                                      &writeOplogStats);
+TimerStats applyOpsStats;
+ServerStatusMetricField<TimerStats> displayApplyOps("repl.apply.stages.applyOps", &applyOpsStats);
 
 NamespaceString parseUUIDOrNs(OperationContext* opCtx, const OplogEntry& oplogEntry) {
     auto optionalUuid = oplogEntry.getUuid();
@@ -276,6 +297,41 @@ void addDerivedOps(OperationContext* opCtx,
     }
 }
 
+/**
+ * Moves the operations of each bucket to one of the writer vectors, largest bucket first, picking
+ * the writer vector with the fewest operations so far. Operations that must be applied in order
+ * hash to the same bucket, so they remain in order in a single writer vector, while independent
+ * buckets are spread evenly even when the hashes are skewed towards a few of them.
+ */
+void assignBucketsToWriterVectors(std::vector<std::vector<const OplogEntry*>>* buckets,
+                                  std::vector<std::vector<const OplogEntry*>>* writerVectors) {
+    std::vector<size_t> order(buckets->size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t l, size_t r) {
+        return (*buckets)[l].size() > (*buckets)[r].size();
+    });
+
+    // Pairs of the number of operations in a writer vector and its index, least loaded on top.
+    using WriterLoad = std::pair<size_t, size_t>;
+    std::priority_queue<WriterLoad, std::vector<WriterLoad>, std::greater<WriterLoad>> writers;
+    for (size_t i = 0; i < writerVectors->size(); i++) {
+        writers.emplace((*writerVectors)[i].size(), i);
+    }
+
+    for (auto bucketIndex : order) {
+        auto& bucket = (*buckets)[bucketIndex];
+        if (bucket.empty()) {
+            break;
+        }
+
+        auto load = writers.top();
+        writers.pop();
+        auto& writer = (*writerVectors)[load.second];
+        writer.insert(writer.end(), bucket.begin(), bucket.end());
+        writers.emplace(load.first + bucket.size(), load.second);
+    }
+}
+
 void _addOplogChainOpsToWriterVectors(OperationContext* opCtx,
                                       std::vector<OplogEntry*>* partialTxnList,
                                       std::vector<std::vector<OplogEntry>>* derivedOps,
@@ -465,7 +521,11 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
 
         // Blocks up to a second waiting for a batch to be ready to apply. If one doesn't become
         // ready in time, we'll loop again so we can do the above checks periodically.
+        Timer waitForBatchTimer;
         OplogBatch ops = _oplogBatcher->getNextBatch(Seconds(1));
+        if (!ops.empty()) {
+            waitForBatchStats.record(waitForBatchTimer);
+        }
         if (ops.empty()) {
             if (ops.mustShutdown()) {
                 // Shut down and exit oplog application loop.
@@ -649,6 +709,7 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         ON_BLOCK_EXIT([&] { _writerPool->waitForIdle(); });
 
         // Write batch of ops into oplog.
+        Timer writeOplogTimer;
         if (!getOptions().skipWritesToOplog) {
             _consistencyMarkers->setOplogTruncateAfterPoint(
                 opCtx, _replCoord->getMyLastAppliedOpTime().getTimestamp());
@@ -666,10 +727,16 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
 
         std::vector<std::vector<const OplogEntry*>> writerVectors(
             _writerPool->getStats().numThreads);
-        fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
+        {
+            TimerHolder fillWriterVectorsTimer(&fillWriterVectorsStats);
+            fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
+        }
 
         // Wait for writes to finish before applying ops.
         _writerPool->waitForIdle();
+        if (!getOptions().skipWritesToOplog) {
+            writeOplogStats.record(writeOplogTimer);
+        }
 
         // Use this fail point to hold the PBWM lock after we have written the oplog entries but
         // before we have applied them.
@@ -687,6 +754,7 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         }
 
         {
+            TimerHolder applyOpsTimer(&applyOpsStats);
             std::vector<Status> statusVector(_writerPool->getStats().numThreads, Status::OK());
 
             // Doles out all the work to the writer pool threads. writerVectors is not modified,
@@ -902,15 +970,21 @@ void OplogApplierImpl::fillWriterVectors(
     std::vector<std::vector<const OplogEntry*>>* writerVectors,
     std::vector<std::vector<OplogEntry>>* derivedOps) noexcept {
 
+    // Hash the operations into more buckets than there are writers, so that the buckets can then
+    // be balanced over the writers.
+    std::vector<std::vector<const OplogEntry*>> buckets(writerVectors->size() *
+                                                        kBucketsPerWriterVector);
+
     SessionUpdateTracker sessionUpdateTracker;
-    _deriveOpsAndFillWriterVectors(opCtx, ops, writerVectors, derivedOps, &sessionUpdateTracker);
+    _deriveOpsAndFillWriterVectors(opCtx, ops, &buckets, derivedOps, &sessionUpdateTracker);
 
     auto newOplogWrites = sessionUpdateTracker.flushAll();
     if (!newOplogWrites.empty()) {
         derivedOps->emplace_back(std::move(newOplogWrites));
-        _deriveOpsAndFillWriterVectors(
-            opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr);
+        _deriveOpsAndFillWriterVectors(opCtx, &derivedOps->back(), &buckets, derivedOps, nullptr);
     }
+
+    assignBucketsToWriterVectors(&buckets, writerVectors);
 }
 
 Status applyOplogEntryOrGroupedInserts(OperationContext* opCtx,
@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -383,6 +384,59 @@ TEST_F(OplogApplierImplTest,
                                                      createOplogCollectionOptions()));
 }
 
+/**
+ * Test only subclass of OplogApplierImpl that does not apply oplog entries, but records how many
+ * ops each writer was given.
+ */
+class TrackWriterVectorSizesApplier : public OplogApplierImpl {
+public:
+    using OplogApplierImpl::OplogApplierImpl;
+
+    Status applyOplogBatchPerWorker(OperationContext* opCtx,
+                                    std::vector<const OplogEntry*>* ops,
+                                    WorkerMultikeyPathInfo* workerMultikeyPathInfo) override {
+        stdx::lock_guard<Latch> lock(_mutex);
+        writerVectorSizes.push_back(ops->size());
+        return Status::OK();
+    }
+
+    std::vector<size_t> writerVectorSizes;
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("TrackWriterVectorSizesApplier::_mutex");
+};
+
+TEST_F(OplogApplierImplTest, MultiApplyBalancesSingleCollectionInsertsOverWriters) {
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    createCollection(_opCtx.get(), nss, {});
+
+    const int numOps = 800;
+    std::vector<OplogEntry> ops;
+    for (int i = 0; i < numOps; i++) {
+        ops.push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(1), i + 1), 1LL}, nss, BSON("_id" << i)));
+    }
+
+    auto writerPool = makeReplWriterPool();
+    NoopOplogApplierObserver observer;
+    TrackWriterVectorSizesApplier oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        getStorageInterface(),
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+    ASSERT_OK(oplogApplier.applyOplogBatch(_opCtx.get(), ops).getStatus());
+
+    const auto& sizes = oplogApplier.writerVectorSizes;
+    ASSERT_EQ(writerPool->getStats().numThreads, sizes.size());
+    ASSERT_EQ(size_t(numOps), std::accumulate(sizes.begin(), sizes.end(), size_t(0)));
+    auto minmax = std::minmax_element(sizes.begin(), sizes.end());
+    ASSERT_LTE(*minmax.second, 2 * *minmax.first);
+}
+
 TEST_F(OplogApplierImplTest,
        OplogApplicationThreadFuncUsesApplyOplogEntryOrGroupedInsertsToApplyOperation) {
     NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
@@ -755,14 +809,14 @@ TEST_F(MultiOplogEntryOplogApplierImplTest, MultiApplyTwoTransactionsOneBatch) {
     // Note the insert counter so we can check it later.  It is necessary to use opCounters as
     // inserts are idempotent so we will not detect duplicate inserts just by checking inserts in
     // the opObserver.
-    int insertsBefore = replOpCounters.getInsert()->load();
+    int insertsBefore = replOpCounters.getInsert();
     // Insert all the oplog entries in one batch.  All inserts should be executed, in order, exactly
     // once.
     ASSERT_OK(oplogApplier.applyOplogBatch(
         _opCtx.get(),
         {insertOps1[0], insertOps1[1], commitOp1, insertOps2[0], insertOps2[1], commitOp2}));
     ASSERT_EQ(6U, oplogDocs().size());
-    ASSERT_EQ(4, replOpCounters.getInsert()->load() - insertsBefore);
+    ASSERT_EQ(4, replOpCounters.getInsert() - insertsBefore);
     ASSERT_EQ(4U, _insertedDocs[_nss1].size());
     checkTxnTable(_lsid,
                   txnNum2,
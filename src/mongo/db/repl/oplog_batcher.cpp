@@ -221,6 +221,12 @@ StatusWith<std::vector<OplogEntry>> OplogBatcher::getNextApplierBatch(
         totalBytes += opBytes;
         ops.push_back(std::move(entry));
         _consume(opCtx, _oplogBuffer);
+
+        if (!batchLimits.earliestWaiter.isNull() &&
+            totalOps >= batchLimits.minOpsBeforeEndingAtWaiter &&
+            ops.back().getOpTime().getTimestamp() >= batchLimits.earliestWaiter) {
+            return std::move(ops);
+        }
     }
     return std::move(ops);
 }
@@ -264,6 +270,12 @@ void OplogBatcher::_run(StorageInterface* storageInterface) {
         // Check the limits once per batch since users can change them at runtime.
         batchLimits.ops = getBatchLimitOplogEntries();
 
+        auto earliestWaiter = ReplicationCoordinator::get(cc().getServiceContext())
+                                  ->getEarliestAppliedOpTimeWaiter();
+        batchLimits.earliestWaiter = earliestWaiter ? earliestWaiter->getTimestamp() : Timestamp();
+        batchLimits.minOpsBeforeEndingAtWaiter =
+            std::size_t(replBatchMinOperationsBeforeEndingAtWaiter.load());
+
         // Use the OplogBuffer to populate a local OplogBatch. Note that the buffer may be empty.
         OplogBatch ops(batchLimits.ops);
         {
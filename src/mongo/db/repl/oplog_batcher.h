@@ -137,6 +137,12 @@ public:
         // If non-null, the batch will include operations with timestamps either
         // before-and-including this point or after it, not both.
         Timestamp forceBatchBoundaryAfter;
+
+        // If non-null, the batch ends with the first operation at or after this point once it
+        // holds at least 'minOpsBeforeEndingAtWaiter' operations, so that an operation waiting for
+        // it to be applied does not also wait for the rest of the batch.
+        Timestamp earliestWaiter;
+        size_t minOpsBeforeEndingAtWaiter = 0;
     };
 
     /**
@@ -43,6 +43,9 @@ namespace repl {
 
 namespace {
 
+// Room for the fields of an oplog entry besides the documents it embeds.
+constexpr int kOplogEntryOverheadBytes = 256;
+
 OplogEntry::CommandType parseCommandType(const BSONObj& objectField) {
     StringData commandString(objectField.firstElementFieldName());
     if (commandString == "create") {
@@ -106,7 +109,9 @@ BSONObj makeOplogEntryDoc(OpTime opTime,
                           const boost::optional<OpTime>& prevWriteOpTimeInTransaction,
                           const boost::optional<OpTime>& preImageOpTime,
                           const boost::optional<OpTime>& postImageOpTime) {
-    BSONObjBuilder builder;
+    // Size the builder for the documents it embeds, so a large 'o' does not regrow it repeatedly.
+    BSONObjBuilder builder(kOplogEntryOverheadBytes + oField.objsize() +
+                           (o2Field ? o2Field->objsize() : 0));
     sessionInfo.serialize(&builder);
     builder.append(OplogEntryBase::kTimestampFieldName, opTime.getTimestamp());
     builder.append(OplogEntryBase::kTermFieldName, opTime.getTerm());
@@ -223,7 +228,7 @@ ReplOperation MutableOplogEntry::makeCreateIndexesCommand(const NamespaceString
     op.setNss(nss.getCommandNS());
     op.setUuid(uuid);
 
-    BSONObjBuilder builder;
+    BSONObjBuilder builder(kOplogEntryOverheadBytes + indexDoc.objsize());
     builder.append("createIndexes", nss.coll());
     builder.appendElements(indexDoc);
 
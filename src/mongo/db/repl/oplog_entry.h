@@ -204,6 +204,7 @@ public:
     using MutableOplogEntry::kOperationSessionInfoFieldName;
     using MutableOplogEntry::kOplogVersion;
     using MutableOplogEntry::kOpTypeFieldName;
+    using MutableOplogEntry::kNeedsRetryImageFieldName;
     using MutableOplogEntry::kPostImageOpTimeFieldName;
     using MutableOplogEntry::kPreImageOpTimeFieldName;
     using MutableOplogEntry::kPrevWriteOpTimeInTransactionFieldName;
@@ -227,6 +228,7 @@ public:
     using MutableOplogEntry::getObject2;
     using MutableOplogEntry::getOperationSessionInfo;
     using MutableOplogEntry::getOpType;
+    using MutableOplogEntry::getNeedsRetryImage;
     using MutableOplogEntry::getPostImageOpTime;
     using MutableOplogEntry::getPreImageOpTime;
     using MutableOplogEntry::getPrevWriteOpTimeInTransaction;
@@ -272,6 +274,8 @@ public:
     // Get the in-memory size in bytes of a ReplOperation.
     static size_t getDurableReplOperationSize(const DurableReplOperation& op);
 
+    // Parses 'object' without copying it when it is owned or shares ownership of a buffer (such as
+    // a batch fetched from the sync source); the parsed sub-objects are views into that buffer.
     static StatusWith<OplogEntry> parse(const BSONObj& object);
 
     OplogEntry(OpTime opTime,
@@ -103,6 +103,23 @@ TEST(OplogEntryTest, Create) {
     ASSERT_EQ(entry.getOpTime(), entryOpTime);
 }
 
+TEST(OplogEntryTest, ParsingSharesBufferWithFetchedBatch) {
+    // Oplog entries fetched from a sync source are views into the reply buffer. Parsing them must
+    // not copy the entry or its sub-objects.
+    const BSONObj doc = BSON("_id" << docId << "a" << 5);
+    const BSONObj reply =
+        BSON("cursor" << BSON("nextBatch" << BSON_ARRAY(
+                                  makeInsertDocumentOplogEntry(entryOpTime, nss, doc).toBSON())));
+    BSONObj fetched = reply["cursor"]["nextBatch"].Obj().firstElement().Obj();
+    fetched.shareOwnershipWith(reply);
+
+    const auto entry = unittest::assertGet(OplogEntry::parse(fetched));
+    ASSERT_EQ(entry.getRaw().objdata(), fetched.objdata());
+    ASSERT_GTE(entry.getObject().objdata(), reply.objdata());
+    ASSERT_LT(entry.getObject().objdata(), reply.objdata() + reply.objsize());
+    ASSERT_BSONOBJ_EQ(entry.getObject(), doc);
+}
+
 TEST(OplogEntryTest, OpTimeAndWallTimeBaseNonStrictParsing) {
     const BSONObj oplogEntryExtraField = BSON("ts" << Timestamp(0, 0) << "t" << 0LL << "op"
                                                    << "c"
@@ -127,6 +127,42 @@ TEST_F(OplogTest, LogOpReturnsOpTimeOnSuccessfulInsertIntoOplogCollection) {
     ASSERT_EQUALS(ReplClientInfo::forClient(&cc()).getLastOp(), opTime);
 }
 
+TEST_F(OplogTest, LogInsertOpsReservesOpTimesForWholeBatch) {
+    auto opCtx = cc().makeOperationContext();
+    const NamespaceString nss("test.coll");
+
+    std::vector<InsertStatement> inserts;
+    for (int i = 0; i < 3; ++i) {
+        inserts.emplace_back(BSON("_id" << i));
+    }
+
+    std::vector<OpTime> opTimes;
+    {
+        MutableOplogEntry oplogEntryTemplate;
+        oplogEntryTemplate.setNss(nss);
+        oplogEntryTemplate.setWallClockTime(Date_t::now());
+        AutoGetDb autoDb(opCtx.get(), nss.db(), MODE_X);
+        WriteUnitOfWork wunit(opCtx.get());
+        opTimes = logInsertOps(opCtx.get(), &oplogEntryTemplate, inserts.begin(), inserts.end());
+        wunit.commit();
+    }
+    ASSERT_EQUALS(3U, opTimes.size());
+    ASSERT_LT(opTimes[0], opTimes[1]);
+    ASSERT_LT(opTimes[1], opTimes[2]);
+
+    // The oplog iterator returns the newest entry first.
+    OplogInterfaceLocal oplogInterface(opCtx.get());
+    auto oplogIter = oplogInterface.makeIterator();
+    for (int i = 2; i >= 0; --i) {
+        auto oplogEntry =
+            unittest::assertGet(OplogEntry::parse(unittest::assertGet(oplogIter->next()).first));
+        ASSERT(OpTypeEnum::kInsert == oplogEntry.getOpType());
+        ASSERT_EQUALS(opTimes[i], oplogEntry.getOpTime());
+        ASSERT_BSONOBJ_EQ(BSON("_id" << i), oplogEntry.getObject());
+    }
+    ASSERT_EQUALS(ErrorCodes::CollectionIsEmpty, oplogIter->next().getStatus());
+}
+
 /**
  * Checks optime and namespace in oplog entry.
  */
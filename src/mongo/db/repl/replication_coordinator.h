@@ -200,6 +200,11 @@ public:
      */
     virtual Seconds getSlaveDelaySecs() const = 0;
 
+    /**
+     * Returns the earliest opTime that an operation is waiting for this node to apply, if any.
+     */
+    virtual boost::optional<OpTime> getEarliestAppliedOpTimeWaiter() const = 0;
+
     /**
      * Blocks the calling thread for up to writeConcern.wTimeout millis, or until "opTime" has
      * been replicated to at least a set of nodes that satisfies the writeConcern, whichever
@@ -263,6 +263,13 @@ void ReplicationCoordinatorImpl::WaiterList::setValueAll_inlock() {
     _waiters.clear();
 }
 
+boost::optional<OpTime> ReplicationCoordinatorImpl::WaiterList::getEarliestOpTime_inlock() const {
+    if (_waiters.empty()) {
+        return boost::none;
+    }
+    return _waiters.begin()->first;
+}
+
 void ReplicationCoordinatorImpl::WaiterList::setErrorAll_inlock(Status status) {
     invariant(!status.isOK());
     for (auto& [opTime, waiter] : _waiters) {
@@ -995,6 +1002,11 @@ Status ReplicationCoordinatorImpl::waitForMemberState(MemberState expectedState,
     return Status::OK();
 }
 
+boost::optional<OpTime> ReplicationCoordinatorImpl::getEarliestAppliedOpTimeWaiter() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _opTimeWaiterList.getEarliestOpTime_inlock();
+}
+
 Seconds ReplicationCoordinatorImpl::getSlaveDelaySecs() const {
     stdx::lock_guard<Latch> lk(_mutex);
     invariant(_rsConfig.isInitialized());
@@ -1275,6 +1287,7 @@ void ReplicationCoordinatorImpl::_setMyLastAppliedOpTimeAndWallTime(
 
     _topCoord->setMyLastAppliedOpTimeAndWallTime(
         opTimeAndWallTime, _replExecutor->now(), isRollbackAllowed);
+    _lastAppliedTimestampShadow.store(_topCoord->getMyLastAppliedOpTime().getTimestamp().asULL());
     // If we are using applied times to calculate the commit level, update it now.
     if (!_rsConfig.getWriteConcernMajorityShouldJournal()) {
         _updateLastCommittedOpTimeAndWallTime(lk);
@@ -1459,7 +1472,12 @@ Status ReplicationCoordinatorImpl::_waitUntilOpTime(OperationContext* opCtx,
         return {ErrorCodes::NotYetInitialized, "The oplog does not exist."};
     }
 
-    {
+    // A cluster time read (which carries no term) that has already been applied needs no waiting,
+    // so check the shadow copy of lastApplied first to keep such reads off the mutex.
+    const bool alreadyApplied = targetOpTime.getTerm() == OpTime::kUninitializedTerm &&
+        targetOpTime.getTimestamp() <= Timestamp(_lastAppliedTimestampShadow.load());
+
+    if (!alreadyApplied) {
         stdx::unique_lock lock(_mutex);
         if (targetOpTime > _getMyLastAppliedOpTime_inlock()) {
             if (_inShutdown) {
@@ -3799,10 +3817,28 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig(WithLock lk,
 }
 
 void ReplicationCoordinatorImpl::_wakeReadyWaiters(WithLock lk, boost::optional<OpTime> opTime) {
+    // Waiters are visited in opTime order, and a write concern that is not satisfied at some
+    // opTime cannot be satisfied at a later one. Remember the write concerns that were found
+    // unsatisfied so that the waiters behind them with an equivalent write concern are skipped
+    // instead of re-evaluated, which keeps the work under '_mutex' proportional to the number of
+    // distinct write concerns rather than to the number of waiters.
+    std::vector<const WriteConcernOptions*> unsatisfied;
     _replicationWaiterList.setValueIf_inlock(
-        [this](const OpTime& opTime, const SharedWaiterHandle& waiter) {
+        [this, &unsatisfied](const OpTime& opTime, const SharedWaiterHandle& waiter) {
             invariant(waiter->writeConcern);
-            return _doneWaitingForReplication_inlock(opTime, waiter->writeConcern.get());
+            const auto& writeConcern = waiter->writeConcern.get();
+            auto isEquivalent = [&](const WriteConcernOptions* other) {
+                return other->wNumNodes == writeConcern.wNumNodes &&
+                    other->syncMode == writeConcern.syncMode && other->wMode == writeConcern.wMode;
+            };
+            if (std::any_of(unsatisfied.begin(), unsatisfied.end(), isEquivalent)) {
+                return false;
+            }
+            if (_doneWaitingForReplication_inlock(opTime, writeConcern)) {
+                return true;
+            }
+            unsatisfied.push_back(&writeConcern);
+            return false;
         },
         opTime);
 }
@@ -128,6 +128,8 @@ public:
 
     virtual Seconds getSlaveDelaySecs() const override;
 
+    virtual boost::optional<OpTime> getEarliestAppliedOpTimeWaiter() const override;
+
     virtual void clearSyncSourceBlacklist() override;
 
     virtual ReplicationCoordinator::StatusAndDuration awaitReplication(
@@ -645,6 +647,8 @@ private:
         void setValueAll_inlock();
         // Signals all waiters from the list and fulfills promises with Error status.
         void setErrorAll_inlock(Status status);
+        // Returns the smallest opTime being waited for, if any.
+        boost::optional<OpTime> getEarliestOpTime_inlock() const;
 
     private:
         // Waiters sorted by OpTime.
@@ -1560,6 +1564,12 @@ private:
     // Reading this value does not require the replication coordinator mutex to be locked.
     AtomicWord<long long> _termShadow;  // (S)
 
+    // Atomic-synchronized copy of the timestamp of Topology Coordinator's last applied optime, so
+    // that reads whose afterClusterTime has already been applied can skip the mutex.
+    // This variable must be written immediately after the last applied optime, and thus its value
+    // can lag. Reading this value does not require the replication coordinator mutex to be locked.
+    AtomicWord<unsigned long long> _lastAppliedTimestampShadow;  // (S)
+
     // When we decide to step down due to hearing about a higher term, we remember the term we heard
     // here so we can update our term to match as part of finishing stepdown.
     boost::optional<long long> _pendingTermUpdateDuringStepDown;  // (M)
@@ -1099,6 +1099,54 @@ TEST_F(ReplCoordTest, NodeReturnsOkWhenAWriteConcernWithNoTimeoutHasBeenSatisfie
     awaiter.reset();
 }
 
+TEST_F(ReplCoordTest, NodeWakesSatisfiedWaitersBehindAnUnsatisfiedWriteConcern) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version" << 2 << "members"
+                            << BSON_ARRAY(BSON("host"
+                                               << "node1:12345"
+                                               << "_id" << 0)
+                                          << BSON("host"
+                                                  << "node2:12345"
+                                                  << "_id" << 1)
+                                          << BSON("host"
+                                                  << "node3:12345"
+                                                  << "_id" << 2))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    replCoordSetMyLastAppliedOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    simulateSuccessfulV1Election();
+
+    ReplicationAwaiter awaiterW3(getReplCoord(), getServiceContext());
+    ReplicationAwaiter awaiterW2(getReplCoord(), getServiceContext());
+
+    OpTimeWithTermOne time1(100, 1);
+    OpTimeWithTermOne time2(100, 2);
+
+    WriteConcernOptions writeConcern;
+    writeConcern.wTimeout = WriteConcernOptions::kNoTimeout;
+    writeConcern.wNumNodes = 3;
+    awaiterW3.setOpTime(time1);
+    awaiterW3.setWriteConcern(writeConcern);
+    awaiterW3.start();
+
+    writeConcern.wNumNodes = 2;
+    awaiterW2.setOpTime(time2);
+    awaiterW2.setWriteConcern(writeConcern);
+    awaiterW2.start();
+
+    // The w:2 waiter at the later opTime must be released even though the w:3 waiter ahead of it
+    // is not satisfied yet.
+    replCoordSetMyLastAppliedOpTime(time2, Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(time2, Date_t() + Seconds(100));
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time2));
+    ASSERT_OK(awaiterW2.getResult().status);
+
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 2, time1));
+    ASSERT_OK(awaiterW3.getResult().status);
+}
+
 TEST_F(ReplCoordTest, NodeReturnsWriteConcernFailedWhenAWriteConcernTimesOutBeforeBeingSatisified) {
     assertStartSuccess(BSON("_id"
                             << "mySet"
@@ -5478,6 +5526,41 @@ TEST_F(ReplCoordTest, ReadAfterCommittedDeferredEqualOpTime) {
 }
 
 
+TEST_F(ReplCoordTest, ReadAfterClusterTimeAlreadyAppliedDoesNotWait) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version" << 2 << "members"
+                            << BSON_ARRAY(BSON("host"
+                                               << "node1:12345"
+                                               << "_id" << 0))),
+                       HostAndPort("node1", 12345));
+    auto opCtx = makeOperationContext();
+    runSingleNodeElection(opCtx.get());
+
+    replCoordSetMyLastAppliedOpTime(OpTime(Timestamp(100, 1), 1), Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(OpTime(Timestamp(100, 1), 1), Date_t() + Seconds(100));
+
+    // An interrupted operation can still read at a cluster time which has already been applied,
+    // but has to wait, and so fails, for a later one.
+    killOperation(opCtx.get());
+    ASSERT_OK(getReplCoord()->waitUntilOpTimeForRead(
+        opCtx.get(),
+        ReadConcernArgs(LogicalTime(Timestamp(100, 1)), ReadConcernLevel::kLocalReadConcern)));
+    ASSERT_EQUALS(ErrorCodes::Interrupted,
+                  getReplCoord()->waitUntilOpTimeForRead(
+                      opCtx.get(),
+                      ReadConcernArgs(LogicalTime(Timestamp(100, 2)),
+                                      ReadConcernLevel::kLocalReadConcern)));
+
+    // Resetting the last applied optime means an earlier cluster time has to be waited for again.
+    getReplCoord()->resetMyLastOpTimes();
+    ASSERT_EQUALS(ErrorCodes::Interrupted,
+                  getReplCoord()->waitUntilOpTimeForRead(
+                      opCtx.get(),
+                      ReadConcernArgs(LogicalTime(Timestamp(50, 1)),
+                                      ReadConcernLevel::kLocalReadConcern)));
+}
+
 TEST_F(ReplCoordTest, WaitUntilOpTimeforReadRejectsUnsupportedMajorityReadConcern) {
     assertStartSuccess(BSON("_id"
                             << "mySet"
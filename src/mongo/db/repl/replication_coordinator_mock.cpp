@@ -139,6 +139,10 @@ Seconds ReplicationCoordinatorMock::getSlaveDelaySecs() const {
     return Seconds(0);
 }
 
+boost::optional<OpTime> ReplicationCoordinatorMock::getEarliestAppliedOpTimeWaiter() const {
+    return boost::none;
+}
+
 void ReplicationCoordinatorMock::clearSyncSourceBlacklist() {}
 
 ReplicationCoordinator::StatusAndDuration ReplicationCoordinatorMock::awaitReplication(
@@ -94,6 +94,8 @@ public:
 
     virtual Seconds getSlaveDelaySecs() const;
 
+    virtual boost::optional<OpTime> getEarliestAppliedOpTimeWaiter() const;
+
     virtual void clearSyncSourceBlacklist();
 
     virtual ReplicationCoordinator::StatusAndDuration awaitReplication(
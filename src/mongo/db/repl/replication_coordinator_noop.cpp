@@ -166,6 +166,10 @@ Seconds ReplicationCoordinatorNoOp::getSlaveDelaySecs() const {
     MONGO_UNREACHABLE;
 }
 
+boost::optional<OpTime> ReplicationCoordinatorNoOp::getEarliestAppliedOpTimeWaiter() const {
+    MONGO_UNREACHABLE;
+}
+
 void ReplicationCoordinatorNoOp::clearSyncSourceBlacklist() {
     MONGO_UNREACHABLE;
 }
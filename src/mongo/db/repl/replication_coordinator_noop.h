@@ -101,6 +101,8 @@ public:
 
     Seconds getSlaveDelaySecs() const final;
 
+    boost::optional<OpTime> getEarliestAppliedOpTimeWaiter() const final;
+
     void clearSyncSourceBlacklist() final;
 
     ReplicationCoordinator::StatusAndDuration awaitReplication(OperationContext*,
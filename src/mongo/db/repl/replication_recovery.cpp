@@ -51,7 +51,11 @@
 #include "mongo/db/transaction_history_iterator.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/timer.h"
 
 namespace mongo {
@@ -217,6 +221,111 @@ private:
     std::unique_ptr<DBClientCursor> _cursor;
 };
 
+/**
+ * Reads the batches to replay from an OplogBufferLocalOplog on a separate thread, so that the next
+ * batch is read from the oplog while the current one is applied, like the OplogBatcher does for
+ * steady state replication. At most one batch is read ahead of the one being applied.
+ */
+class RecoveryOplogBatcher {
+public:
+    RecoveryOplogBatcher(OplogApplier* oplogApplier,
+                         OplogBufferLocalOplog* oplogBuffer,
+                         OplogApplier::BatchLimits batchLimits)
+        : _oplogApplier(oplogApplier), _oplogBuffer(oplogBuffer), _batchLimits(batchLimits) {
+        _thread = stdx::thread([this] { _run(); });
+    }
+
+    ~RecoveryOplogBatcher() {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _inShutdown = true;
+            _cv.notify_all();
+        }
+        _thread.join();
+    }
+
+    /**
+     * Returns the next batch to apply, or an empty batch once the end of the oplog is reached.
+     * Throws if reading the oplog failed.
+     */
+    std::vector<OplogEntry> getNextBatch() {
+        stdx::unique_lock<Latch> lk(_mutex);
+        _cv.wait(lk, [&] { return _batch || !_status.isOK(); });
+        uassertStatusOK(_status);
+        auto batch = std::move(*_batch);
+        _batch.reset();
+        _cv.notify_all();
+        return batch;
+    }
+
+    /**
+     * Returns whether the whole oplog buffer was consumed. Must only be called after
+     * getNextBatch() returned an empty batch.
+     */
+    bool oplogBufferExhausted() {
+        stdx::unique_lock<Latch> lk(_mutex);
+        _cv.wait(lk, [&] { return _finished; });
+        return _oplogBufferExhausted;
+    }
+
+private:
+    void _run() {
+        Client::initThread("ReplRecoveryBatcher");
+        auto opCtx = cc().makeOperationContext();
+
+        // Like the OplogBatcher, this thread must not be interrupted, and it must not wait for the
+        // ParallelBatchWriterMode lock held by the applier while it applies the previous batch.
+        // The oplog is not written to during recovery.
+        UninterruptibleLockGuard noInterrupt(opCtx->lockState());
+        ShouldNotConflictWithSecondaryBatchApplicationBlock shouldNotConflictBlock(
+            opCtx->lockState());
+
+        try {
+            _oplogBuffer->startup(opCtx.get());
+            ON_BLOCK_EXIT([&] { _oplogBuffer->shutdown(opCtx.get()); });
+
+            while (true) {
+                auto batch =
+                    fassert(50763, _oplogApplier->getNextApplierBatch(opCtx.get(), _batchLimits));
+                const bool endOfOplog = batch.empty();
+
+                stdx::unique_lock<Latch> lk(_mutex);
+                _cv.wait(lk, [&] { return !_batch || _inShutdown; });
+                if (_inShutdown) {
+                    break;
+                }
+                _batch = std::move(batch);
+                _cv.notify_all();
+                if (endOfOplog) {
+                    _oplogBufferExhausted = _oplogBuffer->isEmpty();
+                    break;
+                }
+            }
+        } catch (...) {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _status = exceptionToStatus();
+        }
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        _finished = true;
+        _cv.notify_all();
+    }
+
+    OplogApplier* const _oplogApplier;
+    OplogBufferLocalOplog* const _oplogBuffer;
+    const OplogApplier::BatchLimits _batchLimits;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("RecoveryOplogBatcher::_mutex");
+    stdx::condition_variable _cv;
+    boost::optional<std::vector<OplogEntry>> _batch;
+    Status _status = Status::OK();
+    bool _inShutdown = false;
+    bool _finished = false;
+    bool _oplogBufferExhausted = false;
+
+    stdx::thread _thread;
+};
+
 boost::optional<Timestamp> recoverFromOplogPrecursor(OperationContext* opCtx,
                                                      StorageInterface* storageInterface) {
     if (!storageInterface->supportsRecoveryTimestamp(opCtx->getServiceContext())) {
@@ -565,7 +674,6 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
           "endPoint"_attr = endPoint);
 
     OplogBufferLocalOplog oplogBuffer(startPoint, endPoint);
-    oplogBuffer.startup(opCtx);
 
     RecoveryOplogApplierStats stats;
 
@@ -584,17 +692,33 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
     batchLimits.ops = getBatchLimitOplogEntries();
 
     OpTime applyThroughOpTime;
-    std::vector<OplogEntry> batch;
-    while (
-        !(batch = fassert(50763, oplogApplier.getNextApplierBatch(opCtx, batchLimits))).empty()) {
-        applyThroughOpTime = uassertStatusOK(oplogApplier.applyOplogBatch(opCtx, std::move(batch)));
+    bool oplogBufferExhausted;
+    if (!opCtx->lockState()->isLocked()) {
+        RecoveryOplogBatcher batcher(&oplogApplier, &oplogBuffer, batchLimits);
+        std::vector<OplogEntry> batch;
+        while (!(batch = batcher.getNextBatch()).empty()) {
+            applyThroughOpTime =
+                uassertStatusOK(oplogApplier.applyOplogBatch(opCtx, std::move(batch)));
+        }
+        oplogBufferExhausted = batcher.oplogBufferExhausted();
+    } else {
+        // The batcher thread could block behind locks held by the caller, so read each batch on
+        // this thread instead.
+        oplogBuffer.startup(opCtx);
+        std::vector<OplogEntry> batch;
+        while (!(batch = fassert(50763, oplogApplier.getNextApplierBatch(opCtx, batchLimits)))
+                    .empty()) {
+            applyThroughOpTime =
+                uassertStatusOK(oplogApplier.applyOplogBatch(opCtx, std::move(batch)));
+        }
+        oplogBufferExhausted = oplogBuffer.isEmpty();
+        oplogBuffer.shutdown(opCtx);
     }
     stats.complete(applyThroughOpTime);
-    invariant(oplogBuffer.isEmpty(),
+    invariant(oplogBufferExhausted,
               str::stream() << "Oplog buffer not empty after applying operations. Last operation "
                                "applied with optime: "
                             << applyThroughOpTime.toBSON());
-    oplogBuffer.shutdown(opCtx);
 
     // The applied up to timestamp will be null if no oplog entries were applied.
     if (applyThroughOpTime.isNull()) {
@@ -54,6 +54,16 @@ Counter64 numUpdatePosition;
 ServerStatusMetricField<Counter64> displayNumUpdatePosition(
     "repl.network.replSetUpdatePosition.num", &numUpdatePosition);
 
+// The number of times a node asked to report its progress to its sync source, and how many of
+// those requests were folded into a replSetUpdatePosition command that was already waiting to be
+// sent behind the one in flight.
+Counter64 numUpdatePositionTriggered;
+ServerStatusMetricField<Counter64> displayNumUpdatePositionTriggered(
+    "repl.network.replSetUpdatePosition.triggered", &numUpdatePositionTriggered);
+Counter64 numUpdatePositionCoalesced;
+ServerStatusMetricField<Counter64> displayNumUpdatePositionCoalesced(
+    "repl.network.replSetUpdatePosition.coalesced", &numUpdatePositionCoalesced);
+
 /**
  * Returns configuration version in update command object.
  * Returns -1 on failure.
@@ -172,6 +182,7 @@ Status Reporter::trigger() {
         return _status;
     }
 
+    numUpdatePositionTriggered.increment();
     if (_keepAliveTimeoutWhen != Date_t()) {
         // Reset keep alive expiration to signal handler that it was canceled internally.
         invariant(_prepareAndSendCommandCallbackHandle.isValid());
@@ -179,6 +190,11 @@ Status Reporter::trigger() {
         _executor->cancel(_prepareAndSendCommandCallbackHandle);
         return Status::OK();
     } else if (_isActive_inlock()) {
+        // Only one command is in flight at a time. Progress made while it is outstanding is
+        // reported by a single command sent once it completes.
+        if (_isWaitingToSendReporter) {
+            numUpdatePositionCoalesced.increment();
+        }
         _isWaitingToSendReporter = true;
         return Status::OK();
     }
@@ -1023,6 +1023,27 @@ boost::optional<BSONObj> StorageInterfaceImpl::findOplogEntryLessThanOrEqualToTi
     invariant(oplog);
     invariant(opCtx->lockState()->isLocked());
 
+    // A record id in the oplog collection is equivalent to the document's timestamp field.
+    RecordId desiredRecordId = RecordId(timestamp.asULL());
+
+    // If the storage engine can position an oplog cursor by timestamp, seek straight to the newest
+    // entry <= 'timestamp' rather than walking back to it from the top of the oplog. The seek does
+    // not look past the oplog visibility point, which is the top of the oplog whenever this is
+    // called: during recovery, with no concurrent oplog writers.
+    auto rs = oplog->getRecordStore();
+    if (auto startLoc = rs->oplogStartHack(opCtx, desiredRecordId)) {
+        if (startLoc->isNull()) {
+            return boost::none;
+        }
+
+        auto record = rs->getCursor(opCtx)->seekExact(*startLoc);
+        invariant(record,
+                  str::stream() << "Oplog entry " << Timestamp(startLoc->repr()).toString()
+                                << " found while searching for an oplog entry <= "
+                                << timestamp.toString() << " could not be read");
+        return record->data.toBson().getOwned();
+    }
+
     std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec =
         InternalPlanner::collectionScan(opCtx,
                                         NamespaceString::kRsOplogNamespace.ns(),
@@ -1030,9 +1051,6 @@ boost::optional<BSONObj> StorageInterfaceImpl::findOplogEntryLessThanOrEqualToTi
                                         PlanExecutor::NO_YIELD,
                                         InternalPlanner::BACKWARD);
 
-    // A record id in the oplog collection is equivalent to the document's timestamp field.
-    RecordId desiredRecordId = RecordId(timestamp.asULL());
-
     // Iterate the collection in reverse until the desiredRecordId, or one less than, is found.
     BSONObj bson;
     RecordId recordId;
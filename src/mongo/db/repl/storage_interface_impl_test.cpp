@@ -569,6 +569,7 @@ TEST_F(StorageInterfaceImplTest, CreateCollectionWithIDIndexCommits) {
     std::vector<BSONObj> docs = {BSON("_id" << 1), BSON("_id" << 1), BSON("_id" << 2)};
     ASSERT_OK(loader->insertDocuments(docs.begin(), docs.end()));
     ASSERT_OK(loader->commit());
+    ASSERT(loader->getIndexBuildStats()["indexBulkLoadMillis"].Obj().hasField("_id_"));
 
     AutoGetCollectionForReadCommand autoColl(opCtx, nss);
     auto coll = autoColl.getCollection();
@@ -68,6 +68,10 @@ public:
                            const std::vector<BSONObj>::const_iterator end) override;
     Status commit() override;
 
+    BSONObj getIndexBuildStats() const override {
+        return BSONObj();
+    }
+
     std::string toString() const override {
         return toBSON().toString();
     };
@@ -86,6 +86,7 @@ const auto getBalancer = ServiceContext::declareDecoration<std::unique_ptr<Balan
 static constexpr StringData kBalancerPolicyStatusDraining = "draining"_sd;
 static constexpr StringData kBalancerPolicyStatusZoneViolation = "zoneViolation"_sd;
 static constexpr StringData kBalancerPolicyStatusChunksImbalance = "chunksImbalance"_sd;
+static constexpr StringData kBalancerPolicyStatusLoadImbalance = "loadImbalance"_sd;
 
 /**
  * Utility class to generate timing and statistics for a single balancer round.
@@ -748,6 +749,8 @@ Balancer::BalancerStatus Balancer::getBalancerStatusForNs(OperationContext* opCt
             return {false, kBalancerPolicyStatusZoneViolation.toString()};
         case MigrateInfo::chunksImbalance:
             return {false, kBalancerPolicyStatusChunksImbalance.toString()};
+        case MigrateInfo::loadImbalance:
+            return {false, kBalancerPolicyStatusLoadImbalance.toString()};
     }
 
     return {true, boost::none};
@@ -523,11 +523,12 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::_getMigrateCandi
         }
     }
 
-    return BalancerPolicy::balance(
-        shardStats,
-        distribution,
-        usedShards,
-        Grid::get(opCtx)->getBalancerConfiguration()->attemptToBalanceJumboChunks());
+    const auto balancerConfig = Grid::get(opCtx)->getBalancerConfiguration();
+    return BalancerPolicy::balance(shardStats,
+                                   distribution,
+                                   usedShards,
+                                   balancerConfig->attemptToBalanceJumboChunks(),
+                                   balancerConfig->getLoadImbalanceRatio());
 }
 
 }  // namespace mongo
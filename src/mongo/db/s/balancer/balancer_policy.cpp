@@ -359,7 +359,8 @@ MigrateInfo chooseRandomMigration(const ShardStatisticsVector& shardStats,
 vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardStats,
                                             const DistributionStatus& distribution,
                                             std::set<ShardId>* usedShards,
-                                            bool forceJumbo) {
+                                            bool forceJumbo,
+                                            double loadImbalanceRatio) {
     vector<MigrateInfo> migrations;
 
     if (MONGO_unlikely(balancerShouldReturnRandomMigrations.shouldFail()) &&
@@ -485,6 +486,10 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
 
     // 3) for each tag balance
 
+    // Leave room for the chunk count deviations which load balancing introduces
+    const size_t imbalanceThreshold =
+        kDefaultImbalanceThreshold + (loadImbalanceRatio > 0 ? 1 : 0);
+
     vector<string> tagsPlusEmpty(distribution.tags().begin(), distribution.tags().end());
     tagsPlusEmpty.push_back("");
 
@@ -524,6 +529,7 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
                                   distribution,
                                   tag,
                                   idealNumberOfChunksPerShardForTag,
+                                  imbalanceThreshold,
                                   &migrations,
                                   usedShards,
                                   forceJumbo ? MoveChunkRequest::ForceJumbo::kForceBalancer
@@ -531,6 +537,22 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
             ;
     }
 
+    // 4) if the chunk counts are balanced, even out the load of the shards
+    if (migrations.empty() && loadImbalanceRatio > 0 && !shardStats.empty()) {
+        const size_t idealNumberOfChunksPerShard =
+            (size_t)std::roundf(distribution.totalChunks() / (float)shardStats.size());
+
+        _singleLoadBalance(shardStats,
+                           distribution,
+                           loadImbalanceRatio,
+                           idealNumberOfChunksPerShard,
+                           imbalanceThreshold,
+                           &migrations,
+                           usedShards,
+                           forceJumbo ? MoveChunkRequest::ForceJumbo::kForceBalancer
+                                      : MoveChunkRequest::ForceJumbo::kDoNotForce);
+    }
+
     return migrations;
 }
 
@@ -554,6 +576,7 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
                                         const DistributionStatus& distribution,
                                         const string& tag,
                                         size_t idealNumberOfChunksPerShardForTag,
+                                        size_t imbalanceThreshold,
                                         vector<MigrateInfo>* migrations,
                                         set<ShardId>* usedShards,
                                         MoveChunkRequest::ForceJumbo forceJumbo) {
@@ -597,11 +620,11 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
                 "idealNumberOfChunksPerShardForTag"_attr = idealNumberOfChunksPerShardForTag);
     LOGV2_DEBUG(21888,
                 1,
-                "threshold  : {kDefaultImbalanceThreshold}",
-                "kDefaultImbalanceThreshold"_attr = kDefaultImbalanceThreshold);
+                "threshold  : {imbalanceThreshold}",
+                "imbalanceThreshold"_attr = imbalanceThreshold);
 
     // Check whether it is necessary to balance within this zone
-    if (imbalance < kDefaultImbalanceThreshold)
+    if (imbalance < imbalanceThreshold)
         return false;
 
     const vector<ChunkType>& chunks = distribution.getChunks(from);
@@ -636,6 +659,69 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
     return false;
 }
 
+bool BalancerPolicy::_singleLoadBalance(const ShardStatisticsVector& shardStats,
+                                        const DistributionStatus& distribution,
+                                        double loadImbalanceRatio,
+                                        size_t idealNumberOfChunksPerShard,
+                                        size_t imbalanceThreshold,
+                                        vector<MigrateInfo>* migrations,
+                                        set<ShardId>* usedShards,
+                                        MoveChunkRequest::ForceJumbo forceJumbo) {
+    const ClusterStatistics::ShardStatistics* busiest = nullptr;
+    const ClusterStatistics::ShardStatistics* idlest = nullptr;
+
+    for (const auto& stat : shardStats) {
+        if (usedShards->count(stat.shardId))
+            continue;
+
+        if (!busiest || stat.opsPerSecond > busiest->opsPerSecond) {
+            busiest = &stat;
+        }
+
+        if (!isShardSuitableReceiver(stat, "").isOK())
+            continue;
+
+        if (!idlest || stat.opsPerSecond < idlest->opsPerSecond) {
+            idlest = &stat;
+        }
+    }
+
+    if (!busiest || !idlest || busiest == idlest || busiest->opsPerSecond <= 0 ||
+        busiest->opsPerSecond < loadImbalanceRatio * idlest->opsPerSecond)
+        return false;
+
+    // Do not move a chunk if the receiver would end up with enough chunks to be balanced again
+    const size_t receiverChunks = distribution.numberOfChunksInShard(idlest->shardId);
+    if (receiverChunks + 1 >= idealNumberOfChunksPerShard + imbalanceThreshold)
+        return false;
+
+    for (const auto& chunk : distribution.getChunks(busiest->shardId)) {
+        if (!distribution.getTagForChunk(chunk).empty())
+            continue;
+
+        if (chunk.getJumbo() && forceJumbo == MoveChunkRequest::ForceJumbo::kDoNotForce)
+            continue;
+
+        LOGV2_DEBUG(5212017,
+                    1,
+                    "Moving chunk {chunk} of {namespace} from {from} at {fromOpsPerSecond} ops/s "
+                    "to {to} at {toOpsPerSecond} ops/s to even out load",
+                    "chunk"_attr = redact(chunk.toString()),
+                    "namespace"_attr = distribution.nss(),
+                    "from"_attr = busiest->shardId,
+                    "fromOpsPerSecond"_attr = busiest->opsPerSecond,
+                    "to"_attr = idlest->shardId,
+                    "toOpsPerSecond"_attr = idlest->opsPerSecond);
+
+        migrations->emplace_back(idlest->shardId, chunk, forceJumbo, MigrateInfo::loadImbalance);
+        invariant(usedShards->insert(busiest->shardId).second);
+        invariant(usedShards->insert(idlest->shardId).second);
+        return true;
+    }
+
+    return false;
+}
+
 ZoneRange::ZoneRange(const BSONObj& a_min, const BSONObj& a_max, const std::string& _zone)
     : min(a_min.getOwned()), max(a_max.getOwned()), zone(_zone) {}
 
@@ -54,7 +54,7 @@ struct ZoneRange {
 };
 
 struct MigrateInfo {
-    enum MigrationReason { drain, zoneViolation, chunksImbalance };
+    enum MigrationReason { drain, zoneViolation, chunksImbalance, loadImbalance };
 
     MigrateInfo(const ShardId& a_to,
                 const ChunkType& a_chunk,
@@ -196,11 +196,18 @@ public:
      * The usedShards parameter is in/out and it contains the set of shards, which have already been
      * used for migrations. Used so we don't return multiple conflicting migrations for the same
      * shard.
+     *
+     * If 'loadImbalanceRatio' is non-zero and the chunk counts do not call for any migration, also
+     * suggests moving a chunk, which is not in a zone, from the shard serving the most operations
+     * to the one serving the fewest, if the former serves at least 'loadImbalanceRatio' times as
+     * many. Chunk counts are then allowed to deviate from the optimum by one more chunk, so that
+     * such moves are not undone for chunk count reasons.
      */
     static std::vector<MigrateInfo> balance(const ShardStatisticsVector& shardStats,
                                             const DistributionStatus& distribution,
                                             std::set<ShardId>* usedShards,
-                                            bool forceJumbo);
+                                            bool forceJumbo,
+                                            double loadImbalanceRatio = 0);
 
     /**
      * Using the specified distribution information, returns a suggested better location for the
@@ -238,6 +245,9 @@ private:
      * each shard must have and is used to determine the imbalance and also to prevent chunks from
      * moving when not necessary.
      *
+     * The 'imbalanceThreshold' indicates by how many chunks a shard must exceed the ideal number
+     * for chunks to be moved off of it.
+     *
      * Returns true if a migration was suggested, false otherwise. This method is intented to be
      * called multiple times until all posible migrations for a zone have been selected.
      */
@@ -245,6 +255,25 @@ private:
                                    const DistributionStatus& distribution,
                                    const std::string& tag,
                                    size_t idealNumberOfChunksPerShardForTag,
+                                   size_t imbalanceThreshold,
+                                   std::vector<MigrateInfo>* migrations,
+                                   std::set<ShardId>* usedShards,
+                                   MoveChunkRequest::ForceJumbo forceJumbo);
+
+    /**
+     * Selects one chunk, which is not in a zone, to be moved from the shard serving the most
+     * operations to the shard serving the fewest, as long as the former serves at least
+     * 'loadImbalanceRatio' times as many and the move leaves the receiver with fewer than
+     * 'idealNumberOfChunksPerShard' + 'imbalanceThreshold' chunks. Takes into account and updates
+     * the shards, which have already been used for migrations.
+     *
+     * Returns true if a migration was suggested, false otherwise.
+     */
+    static bool _singleLoadBalance(const ShardStatisticsVector& shardStats,
+                                   const DistributionStatus& distribution,
+                                   double loadImbalanceRatio,
+                                   size_t idealNumberOfChunksPerShard,
+                                   size_t imbalanceThreshold,
                                    std::vector<MigrateInfo>* migrations,
                                    std::set<ShardId>* usedShards,
                                    MoveChunkRequest::ForceJumbo forceJumbo);
@@ -692,6 +692,79 @@ TEST(BalancerPolicy, BalancerHandlesNoShardsWithTag) {
     ASSERT(balanceChunks(cluster.first, distribution, false, false).empty());
 }
 
+ShardStatistics makeShardStatsWithLoad(const ShardId& shardId, double opsPerSecond) {
+    ShardStatistics stats(shardId, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion);
+    stats.opsPerSecond = opsPerSecond;
+    return stats;
+}
+
+TEST(BalancerPolicy, LoadImbalanceMovesChunkFromBusiestToIdlestShard) {
+    auto cluster = generateCluster({{makeShardStatsWithLoad(kShardId0, 1000), 3},
+                                    {makeShardStatsWithLoad(kShardId1, 100), 3},
+                                    {makeShardStatsWithLoad(kShardId2, 10), 3}});
+    const DistributionStatus distribution(kNamespace, cluster.second);
+
+    {
+        std::set<ShardId> usedShards;
+        ASSERT(BalancerPolicy::balance(cluster.first, distribution, &usedShards, false).empty());
+    }
+
+    std::set<ShardId> usedShards;
+    const auto migrations(
+        BalancerPolicy::balance(cluster.first, distribution, &usedShards, false, 2));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId2, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMin(), migrations[0].minKey);
+    ASSERT_EQ(MigrateInfo::loadImbalance, migrations[0].reason);
+}
+
+TEST(BalancerPolicy, LoadImbalanceBelowRatioDoesNotMoveChunks) {
+    auto cluster = generateCluster({{makeShardStatsWithLoad(kShardId0, 150), 3},
+                                    {makeShardStatsWithLoad(kShardId1, 100), 3},
+                                    {makeShardStatsWithLoad(kShardId2, 80), 3}});
+
+    std::set<ShardId> usedShards;
+    ASSERT(BalancerPolicy::balance(cluster.first,
+                                   DistributionStatus(kNamespace, cluster.second),
+                                   &usedShards,
+                                   false,
+                                   2)
+               .empty());
+}
+
+TEST(BalancerPolicy, LoadImbalanceDoesNotOverloadReceiverWithChunks) {
+    // The idlest shard already has one chunk more than the ideal of three, so taking another one
+    // would have the chunk count balancing move it back
+    auto cluster = generateCluster({{makeShardStatsWithLoad(kShardId0, 1000), 3},
+                                    {makeShardStatsWithLoad(kShardId1, 100), 3},
+                                    {makeShardStatsWithLoad(kShardId2, 10), 4}});
+
+    std::set<ShardId> usedShards;
+    ASSERT(BalancerPolicy::balance(cluster.first,
+                                   DistributionStatus(kNamespace, cluster.second),
+                                   &usedShards,
+                                   false,
+                                   2)
+               .empty());
+}
+
+TEST(BalancerPolicy, LoadImbalanceToleratesOneExtraChunkWhenBalancingChunkCounts) {
+    auto cluster = generateCluster({{makeShardStatsWithLoad(kShardId0, 10), 2},
+                                    {makeShardStatsWithLoad(kShardId1, 10), 3},
+                                    {makeShardStatsWithLoad(kShardId2, 10), 4}});
+    const DistributionStatus distribution(kNamespace, cluster.second);
+
+    {
+        std::set<ShardId> usedShards;
+        ASSERT_EQ(1U,
+                  BalancerPolicy::balance(cluster.first, distribution, &usedShards, false).size());
+    }
+
+    std::set<ShardId> usedShards;
+    ASSERT(BalancerPolicy::balance(cluster.first, distribution, &usedShards, false, 2).empty());
+}
+
 TEST(DistributionStatus, AddTagRangeOverlap) {
     DistributionStatus d(kNamespace, ShardToChunksMap{});
 
@@ -93,6 +93,10 @@ public:
 
         // Version of mongod, which runs on this shard's primary
         std::string mongoVersion;
+
+        // Rate of CRUD operations served by this shard's primary since the previous statistics
+        // collection. Zero if it is unknown.
+        double opsPerSecond{0};
     };
 
     virtual ~ClusterStatistics();
@@ -49,16 +49,18 @@ namespace mongo {
 namespace {
 
 const char kVersionField[] = "version";
+const char kOpCountersField[] = "opcounters";
+
+// The opcounters which count CRUD operations, as opposed to commands
+const char* const kCrudOpCounters[] = {"insert", "query", "update", "delete", "getmore"};
 
 /**
- * Executes the serverStatus command against the specified shard and obtains the version of the
- * running MongoD service.
+ * Executes the serverStatus command against the specified shard.
  *
- * Returns the MongoD version in strig format or an error. Known error codes are:
+ * Returns the serverStatus response or an error. Known error codes are:
  *  ShardNotFound if shard by that id is not available on the registry
- *  NoSuchKey if the version could not be retrieved
  */
-StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, ShardId shardId) {
+StatusWith<BSONObj> retrieveShardServerStatus(OperationContext* opCtx, ShardId shardId) {
     auto shardRegistry = Grid::get(opCtx)->shardRegistry();
     auto shardStatus = shardRegistry->getShard(opCtx, shardId);
     if (!shardStatus.isOK()) {
@@ -79,15 +81,26 @@ StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, Shar
         return commandResponse.getValue().commandStatus;
     }
 
-    BSONObj serverStatus = std::move(commandResponse.getValue().response);
+    return std::move(commandResponse.getValue().response);
+}
 
-    std::string version;
-    Status status = bsonExtractStringField(serverStatus, kVersionField, &version);
+/**
+ * Returns the total number of CRUD operations the serverStatus response reports, or NoSuchKey if it
+ * has no opcounters.
+ */
+StatusWith<long long> extractNumCrudOperations(const BSONObj& serverStatus) {
+    BSONElement opCounters;
+    Status status = bsonExtractTypedField(serverStatus, kOpCountersField, Object, &opCounters);
     if (!status.isOK()) {
         return status;
     }
 
-    return version;
+    long long numOperations = 0;
+    for (const auto opCounter : kCrudOpCounters) {
+        numOperations += opCounters.Obj()[opCounter].safeNumberLong();
+    }
+
+    return numOperations;
 }
 
 }  // namespace
@@ -134,19 +147,29 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
         }
 
         std::string mongoDVersion;
+        boost::optional<long long> numCrudOperations;
 
-        auto mongoDVersionStatus = retrieveShardMongoDVersion(opCtx, shard.getName());
-        if (mongoDVersionStatus.isOK()) {
-            mongoDVersion = std::move(mongoDVersionStatus.getValue());
-        } else {
+        auto mongoDVersionStatus = [&]() -> Status {
+            auto serverStatus = retrieveShardServerStatus(opCtx, shard.getName());
+            if (!serverStatus.isOK()) {
+                return serverStatus.getStatus();
+            }
+
+            auto swNumCrudOperations = extractNumCrudOperations(serverStatus.getValue());
+            if (swNumCrudOperations.isOK()) {
+                numCrudOperations = swNumCrudOperations.getValue();
+            }
+
+            return bsonExtractStringField(serverStatus.getValue(), kVersionField, &mongoDVersion);
+        }();
+        if (!mongoDVersionStatus.isOK()) {
             // Since the mongod version is only used for reporting, there is no need to fail the
             // entire round if it cannot be retrieved, so just leave it empty
             LOGV2(21895,
                   "Unable to obtain shard version for "
                   "{shard_getName}{causedBy_mongoDVersionStatus_getStatus}",
                   "shard_getName"_attr = shard.getName(),
-                  "causedBy_mongoDVersionStatus_getStatus"_attr =
-                      causedBy(mongoDVersionStatus.getStatus()));
+                  "causedBy_mongoDVersionStatus_getStatus"_attr = causedBy(mongoDVersionStatus));
         }
 
         std::set<std::string> shardTags;
@@ -161,9 +184,39 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
                            shard.getDraining(),
                            std::move(shardTags),
                            std::move(mongoDVersion));
+
+        // The operation rate is only used to even out load once chunk counts are balanced, so a
+        // shard which does not report it is treated as idle
+        if (numCrudOperations) {
+            stats.back().opsPerSecond =
+                _updateOpsPerSecond(shard.getName(), *numCrudOperations, Date_t::now());
+        }
     }
 
     return stats;
 }
 
+double ClusterStatisticsImpl::_updateOpsPerSecond(const ShardId& shardId,
+                                                  long long numOperations,
+                                                  Date_t now) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    auto it = _lastOperationsSamples.find(shardId);
+    if (it == _lastOperationsSamples.end()) {
+        _lastOperationsSamples.emplace(shardId, OperationsSample{numOperations, now});
+        return 0;
+    }
+
+    const auto previous = it->second;
+    it->second = {numOperations, now};
+
+    // The counters restart from zero when the shard's primary restarts or changes
+    const auto elapsed = now - previous.sampledAt;
+    if (numOperations < previous.numOperations || elapsed <= Milliseconds(0)) {
+        return 0;
+    }
+
+    return (numOperations - previous.numOperations) * 1000.0 / durationCount<Milliseconds>(elapsed);
+}
+
 }  // namespace mongo
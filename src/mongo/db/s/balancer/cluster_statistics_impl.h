@@ -29,15 +29,20 @@
 
 #pragma once
 
+#include <map>
+
 #include "mongo/db/s/balancer/balancer_random.h"
 #include "mongo/db/s/balancer/cluster_statistics.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
 /**
  * Default implementation for the cluster statistics gathering utility. Uses a blocking method to
- * fetch the statistics and does not perform any caching. If any of the shards fails to report
- * statistics fails the entire refresh.
+ * fetch the statistics and does not perform any caching, other than remembering each shard's
+ * operation count to derive its operation rate on the next refresh. If any of the shards fails to
+ * report statistics fails the entire refresh.
  */
 class ClusterStatisticsImpl final : public ClusterStatistics {
 public:
@@ -47,8 +52,28 @@ public:
     StatusWith<std::vector<ShardStatistics>> getStats(OperationContext* opCtx) override;
 
 private:
+    /**
+     * Number of operations a shard had served when its statistics were last collected.
+     */
+    struct OperationsSample {
+        long long numOperations;
+        Date_t sampledAt;
+    };
+
+    /**
+     * Records the number of operations served by the specified shard and returns the rate at which
+     * it served them since the previous call for the same shard, or zero on the first call.
+     */
+    double _updateOpsPerSecond(const ShardId& shardId, long long numOperations, Date_t now);
+
     // Source of randomness when metadata needs to be randomized.
     BalancerRandomSource& _random;
+
+    // Protects the entries below
+    Mutex _mutex = MONGO_MAKE_LATCH("ClusterStatisticsImpl::_mutex");
+
+    // Most recent operation counts collected from each shard
+    std::map<ShardId, OperationsSample> _lastOperationsSamples;
 };
 
 }  // namespace mongo
@@ -0,0 +1,125 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/s/config/changed_chunks_coalescer.h"
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getChangedChunksCoalescer = ServiceContext::declareDecoration<ChangedChunksCoalescer>();
+
+}  // namespace
+
+ChangedChunksCoalescer& ChangedChunksCoalescer::get(ServiceContext* serviceContext) {
+    return getChangedChunksCoalescer(serviceContext);
+}
+
+ChangedChunksCoalescer& ChangedChunksCoalescer::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+BSONObj ChangedChunksCoalescer::load(OperationContext* opCtx,
+                                     StringData key,
+                                     const LoadFn& loadFn) {
+    std::shared_ptr<Load> load;
+    std::shared_ptr<Load> previous;
+    bool isLeader = false;
+
+    {
+        stdx::lock_guard<Latch> lg(_mutex);
+        auto& state = _keys[key];
+        if (!state.current) {
+            state.current = load = std::make_shared<Load>();
+            isLeader = true;
+        } else if (!state.next) {
+            state.next = load = std::make_shared<Load>();
+            previous = state.current;
+            isLeader = true;
+        } else {
+            load = state.next;
+            ++load->numCallers;
+        }
+    }
+
+    if (!isLeader) {
+        auto swResult = load->promise.getFuture().getNoThrow(opCtx);
+        if (swResult.isOK()) {
+            return swResult.getValue();
+        }
+
+        opCtx->checkForInterrupt();
+        return loadFn(opCtx);
+    }
+
+    // The callers which joined this load rely on it being run, so waiting for the previous load is
+    // not interruptible. The previous load promotes this one to 'current' when it completes.
+    if (previous) {
+        previous->promise.getFuture().getNoThrow().getStatus().ignore();
+    }
+
+    auto swResult = [&]() -> StatusWith<BSONObj> {
+        try {
+            return loadFn(opCtx);
+        } catch (const DBException& ex) {
+            return ex.toStatus();
+        }
+    }();
+
+    {
+        stdx::lock_guard<Latch> lg(_mutex);
+        auto it = _keys.find(key);
+        invariant(it != _keys.end());
+        invariant(it->second.current == load);
+        it->second.current = std::move(it->second.next);
+        if (!it->second.current) {
+            _keys.erase(it);
+        }
+    }
+
+    if (swResult.isOK()) {
+        load->promise.emplaceValue(swResult.getValue());
+    } else {
+        load->promise.setError(swResult.getStatus());
+    }
+
+    return uassertStatusOK(std::move(swResult));
+}
+
+int ChangedChunksCoalescer::getNumCallersOfNextLoadForTest(StringData key) {
+    stdx::lock_guard<Latch> lg(_mutex);
+    auto it = _keys.find(key);
+    return (it != _keys.end() && it->second.next) ? it->second.next->numCallers : 0;
+}
+
+}  // namespace mongo
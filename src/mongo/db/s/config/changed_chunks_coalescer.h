@@ -0,0 +1,104 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/future.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Coalesces concurrent loads of the same routing table diff on the config server. After a chunk
+ * migration commits, every router and shard which talks to the migrated collection refreshes its
+ * routing table from the same collection version at about the same time, and without coalescing
+ * each of them performs the same config.collections and config.chunks reads.
+ *
+ * Loads are identified by an opaque key. A caller either starts a load for its key or joins a load
+ * which has not started yet, so the data returned to a caller is never older than its request.
+ * Callers which arrive while a load for their key is running join the next load, which starts as
+ * soon as the running one completes. This bounds the number of concurrent reads per key to one
+ * and means that a burst of requests results in at most two reads.
+ */
+class ChangedChunksCoalescer {
+    ChangedChunksCoalescer(const ChangedChunksCoalescer&) = delete;
+    ChangedChunksCoalescer& operator=(const ChangedChunksCoalescer&) = delete;
+
+public:
+    using LoadFn = std::function<BSONObj(OperationContext*)>;
+
+    ChangedChunksCoalescer() = default;
+
+    static ChangedChunksCoalescer& get(ServiceContext* serviceContext);
+    static ChangedChunksCoalescer& get(OperationContext* opCtx);
+
+    /**
+     * Returns the result of a call to 'loadFn' for 'key' which started after this call was made,
+     * either by running it on 'opCtx' or by sharing the result of a concurrent caller. If the
+     * shared load fails, the load is retried on 'opCtx', since its failure could have been caused
+     * by the operation which performed it, for example because that operation was interrupted.
+     *
+     * The BSONObj returned by 'loadFn' must be owned.
+     */
+    BSONObj load(OperationContext* opCtx, StringData key, const LoadFn& loadFn);
+
+    /**
+     * Returns the number of callers waiting for the next load for 'key' to start, or zero if there
+     * is none.
+     */
+    int getNumCallersOfNextLoadForTest(StringData key);
+
+private:
+    struct Load {
+        SharedPromise<BSONObj> promise;
+        int numCallers{1};
+    };
+
+    struct KeyState {
+        // The load which is running, or about to run as soon as its leader is woken up.
+        std::shared_ptr<Load> current;
+
+        // The load which new callers join. It starts when 'current' completes.
+        std::shared_ptr<Load> next;
+    };
+
+    Mutex _mutex = MONGO_MAKE_LATCH("ChangedChunksCoalescer::_mutex");
+    StringMap<KeyState> _keys;
+};
+
+}  // namespace mongo
@@ -0,0 +1,172 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/client.h"
+#include "mongo/db/s/config/changed_chunks_coalescer.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+class ChangedChunksCoalescerTest : public ServiceContextTest {
+protected:
+    /**
+     * Runs 'loadFn' through the coalescer on a new thread with its own client and stores the
+     * result in 'result'.
+     */
+    stdx::thread launchLoad(std::function<BSONObj(OperationContext*)> loadFn,
+                            StatusWith<BSONObj>* result) {
+        return stdx::thread([this, loadFn = std::move(loadFn), result] {
+            ThreadClient tc(getServiceContext());
+            auto opCtx = tc->makeOperationContext();
+            try {
+                *result = _coalescer.load(opCtx.get(), kKey, loadFn);
+            } catch (const DBException& ex) {
+                *result = ex.toStatus();
+            }
+        });
+    }
+
+    void waitForCallersOfNextLoad(int numCallers) {
+        while (_coalescer.getNumCallersOfNextLoadForTest(kKey) != numCallers) {
+            sleepmillis(1);
+        }
+    }
+
+    static constexpr StringData kKey = "TestDB.TestColl|1|0||000000000000000000000000"_sd;
+
+    ChangedChunksCoalescer _coalescer;
+};
+
+TEST_F(ChangedChunksCoalescerTest, SequentialLoadsAreNotShared) {
+    auto opCtx = makeOperationContext();
+
+    int numLoads = 0;
+    auto loadFn = [&](OperationContext*) { return BSON("load" << ++numLoads); };
+
+    ASSERT_BSONOBJ_EQ(BSON("load" << 1), _coalescer.load(opCtx.get(), kKey, loadFn));
+    ASSERT_BSONOBJ_EQ(BSON("load" << 2), _coalescer.load(opCtx.get(), kKey, loadFn));
+    ASSERT_EQ(0, _coalescer.getNumCallersOfNextLoadForTest(kKey));
+}
+
+TEST_F(ChangedChunksCoalescerTest, CallersArrivingDuringALoadShareTheNextLoad) {
+    AtomicWord<int> numLoads{0};
+    auto firstLoadStarted = makePromiseFuture<void>();
+    auto releaseFirstLoad = makePromiseFuture<void>();
+
+    StatusWith<BSONObj> firstResult{ErrorCodes::InternalError, "not run"};
+    auto firstThread = launchLoad(
+        [&](OperationContext*) {
+            const auto loadNumber = numLoads.addAndFetch(1);
+            firstLoadStarted.promise.emplaceValue();
+            releaseFirstLoad.future.get();
+            return BSON("load" << loadNumber);
+        },
+        &firstResult);
+    firstLoadStarted.future.get();
+
+    auto loadFn = [&](OperationContext*) { return BSON("load" << numLoads.addAndFetch(1)); };
+
+    StatusWith<BSONObj> secondResult{ErrorCodes::InternalError, "not run"};
+    auto secondThread = launchLoad(loadFn, &secondResult);
+    waitForCallersOfNextLoad(1);
+
+    StatusWith<BSONObj> thirdResult{ErrorCodes::InternalError, "not run"};
+    auto thirdThread = launchLoad(loadFn, &thirdResult);
+    waitForCallersOfNextLoad(2);
+
+    releaseFirstLoad.promise.emplaceValue();
+    firstThread.join();
+    secondThread.join();
+    thirdThread.join();
+
+    ASSERT_EQ(2, numLoads.load());
+    ASSERT_BSONOBJ_EQ(BSON("load" << 1), uassertStatusOK(firstResult));
+    ASSERT_BSONOBJ_EQ(BSON("load" << 2), uassertStatusOK(secondResult));
+    ASSERT_BSONOBJ_EQ(BSON("load" << 2), uassertStatusOK(thirdResult));
+    ASSERT_EQ(0, _coalescer.getNumCallersOfNextLoadForTest(kKey));
+}
+
+TEST_F(ChangedChunksCoalescerTest, CallerRetriesLoadWhichFailedForAnotherCaller) {
+    AtomicWord<int> numLoads{0};
+    auto firstLoadStarted = makePromiseFuture<void>();
+    auto releaseFirstLoad = makePromiseFuture<void>();
+
+    StatusWith<BSONObj> firstResult{ErrorCodes::InternalError, "not run"};
+    auto firstThread = launchLoad(
+        [&](OperationContext*) {
+            numLoads.addAndFetch(1);
+            firstLoadStarted.promise.emplaceValue();
+            releaseFirstLoad.future.get();
+            return BSON("load"
+                        << "first");
+        },
+        &firstResult);
+    firstLoadStarted.future.get();
+
+    StatusWith<BSONObj> secondResult{ErrorCodes::InternalError, "not run"};
+    auto secondThread = launchLoad(
+        [&](OperationContext*) -> BSONObj {
+            numLoads.addAndFetch(1);
+            uasserted(ErrorCodes::Interrupted, "Interrupted the leader of the next load");
+        },
+        &secondResult);
+    waitForCallersOfNextLoad(1);
+
+    StatusWith<BSONObj> thirdResult{ErrorCodes::InternalError, "not run"};
+    auto thirdThread = launchLoad(
+        [&](OperationContext*) {
+            numLoads.addAndFetch(1);
+            return BSON("load"
+                        << "third");
+        },
+        &thirdResult);
+    waitForCallersOfNextLoad(2);
+
+    releaseFirstLoad.promise.emplaceValue();
+    firstThread.join();
+    secondThread.join();
+    thirdThread.join();
+
+    ASSERT_EQ(3, numLoads.load());
+    ASSERT_OK(firstResult.getStatus());
+    ASSERT_EQ(ErrorCodes::Interrupted, secondResult.getStatus());
+    ASSERT_BSONOBJ_EQ(BSON("load"
+                           << "third"),
+                      uassertStatusOK(thirdResult));
+}
+
+}  // namespace
+}  // namespace mongo
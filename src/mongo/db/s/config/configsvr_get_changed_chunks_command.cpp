@@ -0,0 +1,160 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kSharding
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/auth/action_type.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/auth/privilege.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/s/config/changed_chunks_coalescer.h"
+#include "mongo/s/config_server_catalog_cache_loader.h"
+#include "mongo/s/request_types/get_changed_chunks_gen.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Internal sharding command run on config servers by the catalog cache loader of routers and
+ * shards to fetch the chunks of a collection which changed since their cached collection version.
+ *
+ * Format:
+ * {
+ *   _configsvrGetChangedChunks: <string namespace>,
+ *   sinceVersion: <ChunkVersion>,
+ *   readConcern: <BSONObj>
+ * }
+ */
+class ConfigSvrGetChangedChunksCommand : public BasicCommand {
+public:
+    ConfigSvrGetChangedChunksCommand()
+        : BasicCommand(ConfigsvrGetChangedChunks::kCommandName) {}
+
+    std::string help() const override {
+        return "Internal command, which is exported by the sharding config server. Do not call "
+               "directly. Returns the chunks of a collection which changed since a given version.";
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kAlways;
+    }
+
+    bool adminOnly() const override {
+        return true;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    ReadConcernSupportResult supportsReadConcern(const BSONObj& cmdObj,
+                                                 repl::ReadConcernLevel level) const override {
+        return ReadConcernSupportResult::allSupportedAndDefaultPermitted();
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) const override {
+        if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
+                ResourcePattern::forClusterResource(), ActionType::internal)) {
+            return Status(ErrorCodes::Unauthorized, "Unauthorized");
+        }
+        return Status::OK();
+    }
+
+    std::string parseNs(const std::string& dbname, const BSONObj& cmdObj) const override {
+        return CommandHelpers::parseNsFullyQualified(cmdObj);
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbName,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        uassert(ErrorCodes::IllegalOperation,
+                str::stream() << ConfigsvrGetChangedChunks::kCommandName
+                              << " can only be run on config servers",
+                serverGlobalParams.clusterRole == ClusterRole::ConfigServer);
+
+        const auto request = ConfigsvrGetChangedChunks::parse(
+            IDLParserErrorContext(ConfigsvrGetChangedChunks::kCommandName), cmdObj);
+        const auto& nss = request.getCommandParameter();
+        const auto& sinceVersion = request.getSinceVersion();
+
+        // The reads are performed with majority read concern after the wait for the requested
+        // 'afterOpTime', so a load which starts after this point reflects everything the caller
+        // has observed.
+        const auto response = ChangedChunksCoalescer::get(opCtx).load(
+            opCtx,
+            str::stream() << nss.ns() << '|' << sinceVersion.toString(),
+            [&](OperationContext* loadOpCtx) {
+                return loadChangedChunks(loadOpCtx, nss, sinceVersion);
+            });
+
+        result.appendElements(response);
+        return true;
+    }
+
+private:
+    static BSONObj loadChangedChunks(OperationContext* opCtx,
+                                     const NamespaceString& nss,
+                                     const ChunkVersion& sinceVersion) {
+        auto collAndChunks = ConfigServerCatalogCacheLoader::getChangedChunksFromConfigCatalog(
+            opCtx, nss, sinceVersion);
+
+        // Full reloads of collections with very many chunks do not fit in a single reply. The
+        // caller reads them from config.chunks with a cursor instead.
+        std::vector<BSONObj> chunks;
+        chunks.reserve(collAndChunks.changedChunks.size());
+        int totalSize = 0;
+        for (const auto& chunk : collAndChunks.changedChunks) {
+            chunks.push_back(chunk.toConfigBSON());
+            totalSize += chunks.back().objsize();
+            uassert(ErrorCodes::BSONObjectTooLarge,
+                    str::stream() << "Changed chunks of " << nss.ns() << " since version "
+                                  << sinceVersion.toString() << " do not fit in a single reply",
+                    totalSize <= BSONObjMaxUserSize / 2);
+        }
+
+        ConfigsvrGetChangedChunksResponse response(collAndChunks.epoch,
+                                                   collAndChunks.shardKeyPattern,
+                                                   collAndChunks.defaultCollation,
+                                                   collAndChunks.shardKeyIsUnique,
+                                                   std::move(chunks));
+        response.setUuid(collAndChunks.uuid);
+        return response.toBSON();
+    }
+
+} configsvrGetChangedChunksCmd;
+
+}  // namespace
+}  // namespace mongo
@@ -35,6 +35,7 @@
 namespace mongo {
 
 class BSONObj;
+struct InsertStatement;
 class MigrationSessionId;
 class OperationContext;
 class Status;
@@ -137,7 +138,7 @@ public:
      * NOTE: Must be called with at least IX lock held on the collection.
      */
     virtual void onInsertOp(OperationContext* opCtx,
-                            const BSONObj& insertedDoc,
+                            const InsertStatement& insertStatement,
                             const repl::OpTime& opTime) = 0;
 
     /**
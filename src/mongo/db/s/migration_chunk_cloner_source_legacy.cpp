@@ -33,6 +33,9 @@
 
 #include "mongo/db/s/migration_chunk_cloner_source_legacy.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "mongo/base/status.h"
 #include "mongo/client/read_preference.h"
 #include "mongo/db/catalog/index_catalog.h"
@@ -40,10 +43,13 @@
 #include "mongo/db/dbhelpers.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/repl/replication_process.h"
 #include "mongo/db/s/collection_sharding_runtime.h"
 #include "mongo/db/s/migration_source_manager.h"
+#include "mongo/db/s/shard_key_util.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/start_chunk_clone_request.h"
 #include "mongo/db/service_context.h"
@@ -72,12 +78,22 @@ const Hours kMaxWaitToCommitCloneForJumboChunk(6);
 
 MONGO_FAIL_POINT_DEFINE(failTooMuchMemoryUsed);
 
+bool isShardKeyInRange(const BSONObj& shardKey, const BSONObj& min, const BSONObj& max) {
+    return shardKey.woCompare(min) >= 0 && shardKey.woCompare(max) < 0;
+}
+
 bool isInRange(const BSONObj& obj,
                const BSONObj& min,
                const BSONObj& max,
                const ShardKeyPattern& shardKeyPattern) {
-    BSONObj k = shardKeyPattern.extractShardKeyFromDoc(obj);
-    return k.woCompare(min) >= 0 && k.woCompare(max) < 0;
+    return isShardKeyInRange(shardKeyPattern.extractShardKeyFromDoc(obj), min, max);
+}
+
+/**
+ * Returns the number of bytes accounted to an _id in the transfer mods queue.
+ */
+uint64_t transferModsEntrySize(const BSONObj& idObj) {
+    return idObj.firstElement().size() + 5;
 }
 
 BSONObj createRequestWithSessionId(StringData commandName,
@@ -470,10 +486,11 @@ bool MigrationChunkClonerSourceLegacy::isDocumentInMigratingChunk(const BSONObj&
 }
 
 void MigrationChunkClonerSourceLegacy::onInsertOp(OperationContext* opCtx,
-                                                  const BSONObj& insertedDoc,
+                                                  const InsertStatement& insertStatement,
                                                   const repl::OpTime& opTime) {
     dassert(opCtx->lockState()->isCollectionLockedForMode(_args.getNss(), MODE_IX));
 
+    const auto& insertedDoc = insertStatement.doc;
     BSONElement idElement = insertedDoc["_id"];
     if (idElement.eoo()) {
         LOGV2_WARNING(21995,
@@ -483,7 +500,10 @@ void MigrationChunkClonerSourceLegacy::onInsertOp(OperationContext* opCtx,
         return;
     }
 
-    if (!isInRange(insertedDoc, _args.getMinKey(), _args.getMaxKey(), _shardKeyPattern)) {
+    if (!isShardKeyInRange(
+            shardkeyutil::extractShardKeyFromInsertStatement(_shardKeyPattern, insertStatement),
+            _args.getMinKey(),
+            _args.getMaxKey())) {
         return;
     }
 
@@ -587,15 +607,21 @@ void MigrationChunkClonerSourceLegacy::_addToTransferModsQueue(
     switch (op) {
         case 'd': {
             stdx::lock_guard<Latch> sl(_mutex);
-            _deleted.push_back(idObj);
-            _memoryUsed += idObj.firstElement().size() + 5;
+            // A pending reload of the deleted document would find nothing to send.
+            if (_reload.erase(idObj)) {
+                _memoryUsed -= transferModsEntrySize(idObj);
+            }
+            if (_deleted.insert(idObj).second) {
+                _memoryUsed += transferModsEntrySize(idObj);
+            }
         } break;
 
         case 'i':
         case 'u': {
             stdx::lock_guard<Latch> sl(_mutex);
-            _reload.push_back(idObj);
-            _memoryUsed += idObj.firstElement().size() + 5;
+            if (_reload.insert(idObj).second) {
+                _memoryUsed += transferModsEntrySize(idObj);
+            }
         } break;
 
         default:
@@ -716,22 +742,39 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
                            internalQueryExecYieldIterations.load(),
                            Milliseconds(internalQueryExecYieldPeriodMS.load()));
 
-    stdx::unique_lock<Latch> lk(_mutex);
-    auto iter = _cloneLocs.begin();
+    // Claim the record ids for this batch up front, so that concurrent _migrateClone requests from
+    // the recipient read disjoint sets of documents. Whatever does not make it into the batch is
+    // handed back for a later request.
+    std::vector<RecordId> claimedLocs;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        const auto maxToClaim = std::max<uint64_t>(
+            1, BSONObjMaxUserSize / std::max<uint64_t>(1, _averageObjectSizeForCloneLocs));
+        auto claimEnd = _cloneLocs.begin();
+        for (uint64_t n = 0; claimEnd != _cloneLocs.end() && n < maxToClaim; ++n) {
+            ++claimEnd;
+        }
+        claimedLocs.assign(_cloneLocs.begin(), claimEnd);
+        _cloneLocs.erase(_cloneLocs.begin(), claimEnd);
+    }
+
+    auto iter = claimedLocs.begin();
+    auto returnUnclonedLocs = makeGuard([&] {
+        if (iter != claimedLocs.end()) {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _cloneLocs.insert(iter, claimedLocs.end());
+        }
+    });
 
-    for (; iter != _cloneLocs.end(); ++iter) {
+    for (; iter != claimedLocs.end(); ++iter) {
         // We must always make progress in this method by at least one document because empty
         // return indicates there is no more initial clone data.
         if (arrBuilder->arrSize() && tracker.intervalHasElapsed()) {
             break;
         }
 
-        auto nextRecordId = *iter;
-
-        lk.unlock();
-
         Snapshotted<BSONObj> doc;
-        if (collection->findDoc(opCtx, nextRecordId, &doc)) {
+        if (collection->findDoc(opCtx, *iter, &doc)) {
             // Use the builder size instead of accumulating the document sizes directly so
             // that we take into consideration the overhead of BSONArray indices.
             if (arrBuilder->arrSize() &&
@@ -743,11 +786,7 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
             arrBuilder->append(doc.value());
             ShardingStatistics::get(opCtx).countDocsClonedOnDonor.addAndFetch(1);
         }
-
-        lk.lock();
     }
-
-    _cloneLocs.erase(_cloneLocs.begin(), iter);
 }
 
 uint64_t MigrationChunkClonerSourceLegacy::getCloneBatchBufferAllocationSize() {
@@ -779,13 +818,18 @@ Status MigrationChunkClonerSourceLegacy::nextCloneBatch(OperationContext* opCtx,
     return Status::OK();
 }
 
+bool MigrationChunkClonerSourceLegacy::supportsConcurrentCloneBatches() {
+    stdx::lock_guard<Latch> sl(_mutex);
+    return !(_jumboChunkCloneState && _forceJumbo);
+}
+
 Status MigrationChunkClonerSourceLegacy::nextModsBatch(OperationContext* opCtx,
                                                        Database* db,
                                                        BSONObjBuilder* builder) {
     dassert(opCtx->lockState()->isCollectionLockedForMode(_args.getNss(), MODE_IS));
 
-    std::list<BSONObj> deleteList;
-    std::list<BSONObj> updateList;
+    SimpleBSONObjSet deleteList;
+    SimpleBSONObjSet updateList;
 
     {
         // All clone data must have been drained before starting to fetch the incremental changes.
@@ -798,8 +842,16 @@ Status MigrationChunkClonerSourceLegacy::nextModsBatch(OperationContext* opCtx,
         // the same doc, then there's no problem since we consume the delete buffer first. If the
         // delete is causally after, we will not be able to see the document when we attempt to
         // fetch it, so it's also ok.
-        deleteList.splice(deleteList.cbegin(), _deleted);
-        updateList.splice(updateList.cbegin(), _reload);
+        deleteList.swap(_deleted);
+        updateList.swap(_reload);
+    }
+
+    uint64_t snapshotMemoryUsed = 0;
+    for (const auto& idObj : deleteList) {
+        snapshotMemoryUsed += transferModsEntrySize(idObj);
+    }
+    for (const auto& idObj : updateList) {
+        snapshotMemoryUsed += transferModsEntrySize(idObj);
     }
 
     auto totalDocSize = _xferDeletes(builder, &deleteList, 0);
@@ -807,10 +859,21 @@ Status MigrationChunkClonerSourceLegacy::nextModsBatch(OperationContext* opCtx,
 
     builder->append("size", totalDocSize);
 
-    // Put back remaining ids we didn't consume
+    // Put back remaining ids we didn't consume, merging them with the ones written since the
+    // snapshot was taken
     stdx::unique_lock<Latch> lk(_mutex);
-    _deleted.splice(_deleted.cbegin(), deleteList);
-    _reload.splice(_reload.cbegin(), updateList);
+    uint64_t remainingMemoryUsed = 0;
+    for (const auto& idObj : deleteList) {
+        if (_deleted.insert(idObj).second) {
+            remainingMemoryUsed += transferModsEntrySize(idObj);
+        }
+    }
+    for (const auto& idObj : updateList) {
+        if (_reload.insert(idObj).second) {
+            remainingMemoryUsed += transferModsEntrySize(idObj);
+        }
+    }
+    _memoryUsed -= snapshotMemoryUsed - remainingMemoryUsed;
 
     return Status::OK();
 }
@@ -823,6 +886,7 @@ void MigrationChunkClonerSourceLegacy::_cleanup(OperationContext* opCtx) {
 
     _reload.clear();
     _deleted.clear();
+    _memoryUsed = 0;
 }
 
 StatusWith<BSONObj> MigrationChunkClonerSourceLegacy::_callRecipient(const BSONObj& cmdObj) {
@@ -978,7 +1042,7 @@ Status MigrationChunkClonerSourceLegacy::_storeCurrentLocs(OperationContext* opC
 }
 
 long long MigrationChunkClonerSourceLegacy::_xferDeletes(BSONObjBuilder* builder,
-                                                         std::list<BSONObj>* removeList,
+                                                         SimpleBSONObjSet* removeList,
                                                          long long initialSize) {
     const long long maxSize = 1024 * 1024;
 
@@ -1005,7 +1069,7 @@ long long MigrationChunkClonerSourceLegacy::_xferDeletes(BSONObjBuilder* builder
 long long MigrationChunkClonerSourceLegacy::_xferUpdates(OperationContext* opCtx,
                                                          Database* db,
                                                          BSONObjBuilder* builder,
-                                                         std::list<BSONObj>* updateList,
+                                                         SimpleBSONObjSet* updateList,
                                                          long long initialSize) {
     const long long maxSize = 1024 * 1024;
 
@@ -1114,7 +1178,8 @@ Status MigrationChunkClonerSourceLegacy::_checkRecipientCloningStatus(OperationC
         }
 
         if (_args.getForceJumbo() != MoveChunkRequest::ForceJumbo::kForceManual &&
-            (_memoryUsed > 500 * 1024 * 1024 ||
+            (_memoryUsed >
+                 static_cast<uint64_t>(migrateTransferModsMaxMemoryMB.load()) * 1024 * 1024 ||
              (_jumboChunkCloneState && MONGO_unlikely(failTooMuchMemoryUsed.shouldFail())))) {
             // This is too much memory for us to use so we're going to abort the migration
             return {ErrorCodes::ExceededMemoryLimit,
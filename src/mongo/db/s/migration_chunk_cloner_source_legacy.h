@@ -34,6 +34,7 @@
 #include <set>
 
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/client/connection_string.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/internal_plans.h"
@@ -108,7 +109,7 @@ public:
     bool isDocumentInMigratingChunk(const BSONObj& doc) override;
 
     void onInsertOp(OperationContext* opCtx,
-                    const BSONObj& insertedDoc,
+                    const InsertStatement& insertStatement,
                     const repl::OpTime& opTime) override;
 
     void onUpdateOp(OperationContext* opCtx,
@@ -148,8 +149,9 @@ public:
 
     /**
      * Called by the recipient shard. Populates the passed BSONArrayBuilder with a set of documents,
-     * which are part of the initial clone sequence. Assumes that there is only one active caller
-     * to this method at a time (otherwise, it can cause corruption/crash).
+     * which are part of the initial clone sequence. Concurrent callers receive disjoint sets of
+     * documents, unless supportsConcurrentCloneBatches() is false, in which case there must be
+     * only one active caller to this method at a time (otherwise, it can cause corruption/crash).
      *
      * Returns OK status on success. If there were documents returned in the result argument, this
      * method should be called more times until the result is empty. If it returns failure, it is
@@ -165,6 +167,12 @@ public:
                           Collection* collection,
                           BSONArrayBuilder* arrBuilder);
 
+    /**
+     * Returns whether nextCloneBatch may be called concurrently. This is not the case once a jumbo
+     * chunk is being cloned through a single index scan.
+     */
+    bool supportsConcurrentCloneBatches();
+
     /**
      * Called by the recipient shard. Transfers the accummulated local mods from source to
      * destination. Must not be called before all cloned objects have been fetched through calls to
@@ -307,7 +315,7 @@ private:
      * Returns the total size of the documents that were appended + initialSize.
      */
     long long _xferDeletes(BSONObjBuilder* builder,
-                           std::list<BSONObj>* removeList,
+                           SimpleBSONObjSet* removeList,
                            long long initialSize);
 
     /**
@@ -318,7 +326,7 @@ private:
     long long _xferUpdates(OperationContext* opCtx,
                            Database* db,
                            BSONObjBuilder* builder,
-                           std::list<BSONObj>* updateList,
+                           SimpleBSONObjSet* updateList,
                            long long initialSize);
 
     /**
@@ -367,14 +375,17 @@ private:
     // Indicates whether new requests to track an operation are accepted.
     bool _acceptingNewOperationTrackRequests{true};
 
-    // List of _id of documents that were modified that must be re-cloned (xfer mods)
-    std::list<BSONObj> _reload;
+    // Set of _id of documents that were modified that must be re-cloned (xfer mods). Each _id is
+    // kept once, however many times the document is written, since the current version of the
+    // document is read when it is sent.
+    SimpleBSONObjSet _reload;
 
-    // List of _id of documents that were deleted during clone that should be deleted later (xfer
+    // Set of _id of documents that were deleted during clone that should be deleted later (xfer
     // mods)
-    std::list<BSONObj> _deleted;
+    SimpleBSONObjSet _deleted;
 
-    // Total bytes in _reload + _deleted (xfer mods)
+    // Total bytes in _reload + _deleted, including the entries of an in-progress nextModsBatch
+    // (xfer mods)
     uint64_t _memoryUsed{0};
 
     // False if the move chunk request specified ForceJumbo::kDoNotForce, true otherwise.
@@ -162,6 +162,7 @@ public:
             uassertStatusOK(MigrationSessionId::extractFromBSON(cmdObj)));
 
         boost::optional<BSONArrayBuilder> arrBuilder;
+        bool concurrentClone = false;
 
         // Try to maximize on the size of the buffer, which we are returning in order to have less
         // round-trips
@@ -172,6 +173,7 @@ public:
 
             if (!arrBuilder) {
                 arrBuilder.emplace(autoCloner.getCloner()->getCloneBatchBufferAllocationSize());
+                concurrentClone = autoCloner.getCloner()->supportsConcurrentCloneBatches();
             }
 
             arrSizeAtPrevIteration = arrBuilder->arrSize();
@@ -183,6 +185,11 @@ public:
         invariant(arrBuilder);
         result.appendArray("objects", arrBuilder->arr());
 
+        // Tells the recipient that it may issue further _migrateClone requests concurrently.
+        if (concurrentClone) {
+            result.append("concurrentClone", true);
+        }
+
         return true;
     }
 
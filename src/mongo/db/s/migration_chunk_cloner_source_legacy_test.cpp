@@ -34,7 +34,9 @@
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/logical_session_id_helpers.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/repl/oplog.h"
 #include "mongo/db/s/migration_chunk_cloner_source_legacy.h"
+#include "mongo/db/s/shard_key_util.h"
 #include "mongo/s/catalog/sharding_catalog_client_mock.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/client/shard_registry.h"
@@ -264,10 +266,10 @@ TEST_F(MigrationChunkClonerSourceLegacyTest, CorrectDocumentsFetched) {
 
         WriteUnitOfWork wuow(operationContext());
 
-        cloner.onInsertOp(operationContext(), createCollectionDocument(90), {});
-        cloner.onInsertOp(operationContext(), createCollectionDocument(150), {});
-        cloner.onInsertOp(operationContext(), createCollectionDocument(151), {});
-        cloner.onInsertOp(operationContext(), createCollectionDocument(210), {});
+        cloner.onInsertOp(operationContext(), InsertStatement(createCollectionDocument(90)), {});
+        cloner.onInsertOp(operationContext(), InsertStatement(createCollectionDocument(150)), {});
+        cloner.onInsertOp(operationContext(), InsertStatement(createCollectionDocument(151)), {});
+        cloner.onInsertOp(operationContext(), InsertStatement(createCollectionDocument(210)), {});
 
         cloner.onDeleteOp(operationContext(), createCollectionDocument(80), {}, {});
         cloner.onDeleteOp(operationContext(), createCollectionDocument(199), {}, {});
@@ -312,6 +314,112 @@ TEST_F(MigrationChunkClonerSourceLegacyTest, CorrectDocumentsFetched) {
     futureCommit.default_timed_get();
 }
 
+TEST_F(MigrationChunkClonerSourceLegacyTest, TransferModsAreDeduplicatedById) {
+    const std::vector<BSONObj> contents = {createCollectionDocument(100)};
+
+    createShardedCollection(contents);
+
+    MigrationChunkClonerSourceLegacy cloner(
+        createMoveChunkRequest(ChunkRange(BSON("X" << 100), BSON("X" << 200))),
+        kShardKeyPattern,
+        kDonorConnStr,
+        kRecipientConnStr.getServers()[0]);
+
+    {
+        auto futureStartClone = launchAsync([&]() {
+            onCommand([&](const RemoteCommandRequest& request) { return BSON("ok" << true); });
+        });
+
+        ASSERT_OK(cloner.startClone(operationContext(), UUID::gen(), _lsid, _txnNumber));
+        futureStartClone.default_timed_get();
+    }
+
+    {
+        AutoGetCollection autoColl(operationContext(), kNss, MODE_IS);
+
+        BSONArrayBuilder arrBuilder;
+        ASSERT_OK(cloner.nextCloneBatch(operationContext(), autoColl.getCollection(), &arrBuilder));
+        ASSERT_EQ(1, arrBuilder.arrSize());
+    }
+
+    insertDocsInShardedCollection({createCollectionDocument(150)});
+
+    {
+        AutoGetCollection autoColl(operationContext(), kNss, MODE_IX);
+
+        WriteUnitOfWork wuow(operationContext());
+
+        // Repeated writes to the same document are sent once.
+        cloner.onInsertOp(operationContext(), InsertStatement(createCollectionDocument(150)), {});
+        for (int i = 0; i < 3; ++i) {
+            cloner.onUpdateOp(
+                operationContext(), boost::none, createCollectionDocument(150), {}, {});
+            cloner.onUpdateOp(
+                operationContext(), boost::none, createCollectionDocument(100), {}, {});
+        }
+
+        // A document which is deleted after being written is only sent as a delete.
+        cloner.onInsertOp(operationContext(), InsertStatement(createCollectionDocument(160)), {});
+        cloner.onDeleteOp(operationContext(), createCollectionDocument(160), {}, {});
+        cloner.onDeleteOp(operationContext(), createCollectionDocument(160), {}, {});
+
+        wuow.commit();
+    }
+
+    {
+        AutoGetCollection autoColl(operationContext(), kNss, MODE_IS);
+
+        {
+            BSONObjBuilder modsBuilder;
+            ASSERT_OK(cloner.nextModsBatch(operationContext(), autoColl.getDb(), &modsBuilder));
+
+            const auto modsObj = modsBuilder.obj();
+            ASSERT_EQ(2U, modsObj["reload"].Array().size());
+            ASSERT_BSONOBJ_EQ(createCollectionDocument(100), modsObj["reload"].Array()[0].Obj());
+            ASSERT_BSONOBJ_EQ(createCollectionDocument(150), modsObj["reload"].Array()[1].Obj());
+
+            ASSERT_EQ(1U, modsObj["deleted"].Array().size());
+            ASSERT_BSONOBJ_EQ(BSON("_id" << 160), modsObj["deleted"].Array()[0].Obj());
+        }
+
+        {
+            BSONObjBuilder modsBuilder;
+            ASSERT_OK(cloner.nextModsBatch(operationContext(), autoColl.getDb(), &modsBuilder));
+
+            const auto modsObj = modsBuilder.obj();
+            ASSERT_FALSE(modsObj.hasField("reload"));
+            ASSERT_FALSE(modsObj.hasField("deleted"));
+        }
+    }
+
+    auto futureCommit = launchAsync([&]() {
+        onCommand([&](const RemoteCommandRequest& request) { return BSON("ok" << true); });
+    });
+
+    ASSERT_OK(cloner.commitClone(operationContext()));
+    futureCommit.default_timed_get();
+}
+
+TEST(MigrationChunkClonerSourceLegacyShardKeyTest, ShardKeyIsCachedOnInsertStatement) {
+    const ShardKeyPattern shardKeyPattern(BSON("X"
+                                               << "hashed"));
+    const InsertStatement stmt(BSON("_id" << 1 << "X" << 150));
+
+    const auto& shardKey =
+        shardkeyutil::extractShardKeyFromInsertStatement(shardKeyPattern, stmt);
+    ASSERT_BSONOBJ_EQ(shardKeyPattern.extractShardKeyFromDoc(stmt.doc), shardKey);
+
+    // Subsequent lookups with the same key pattern are served from the statement.
+    stmt.shardKey = BSON("X" << 1);
+    ASSERT_BSONOBJ_EQ(BSON("X" << 1),
+                      shardkeyutil::extractShardKeyFromInsertStatement(shardKeyPattern, stmt));
+
+    // A different key pattern causes the shard key to be extracted again.
+    ASSERT_BSONOBJ_EQ(
+        BSON("X" << 150),
+        shardkeyutil::extractShardKeyFromInsertStatement(ShardKeyPattern(kShardKeyPattern), stmt));
+}
+
 TEST_F(MigrationChunkClonerSourceLegacyTest, CollectionNotFound) {
     MigrationChunkClonerSourceLegacy cloner(
         createMoveChunkRequest(ChunkRange(BSON("X" << 100), BSON("X" << 200))),
@@ -33,6 +33,7 @@
 
 #include "mongo/db/s/migration_destination_manager.h"
 
+#include <algorithm>
 #include <list>
 #include <vector>
 
@@ -407,12 +408,14 @@ Status MigrationDestinationManager::start(OperationContext* opCtx,
 repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
     OperationContext* opCtx,
     std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-    std::function<BSONObj(OperationContext*)> fetchBatchFn) {
+    std::function<BSONObj(OperationContext*)> fetchBatchFn,
+    int maxConcurrentFetches) {
+    invariant(maxConcurrentFetches >= 1);
 
-    SingleProducerSingleConsumerQueue<BSONObj>::Options options;
-    options.maxQueueDepth = 1;
+    MultiProducerSingleConsumerQueue<BSONObj>::Options options;
+    options.maxQueueDepth = maxConcurrentFetches;
 
-    SingleProducerSingleConsumerQueue<BSONObj> batches(options);
+    MultiProducerSingleConsumerQueue<BSONObj> batches(options);
     repl::OpTime lastOpApplied;
 
     stdx::thread inserterThread{[&] {
@@ -442,24 +445,104 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
         }
     }};
 
+    // Queues batches from the donor until it returns an empty one. With several fetchers, one of
+    // them receiving an empty batch only means that the others hold the remaining documents, so
+    // the empty batch which stops the inserter is queued once all of them have finished.
+    auto fetchUntilExhausted = [&](OperationContext* fetcherOpCtx, BSONObj res) {
+        while (!res["objects"].Obj().isEmpty()) {
+            batches.push(res.getOwned(), fetcherOpCtx);
+            res = fetchBatchFn(fetcherOpCtx);
+        }
+    };
+
+    Mutex fetchersMutex = MONGO_MAKE_LATCH("cloneDocumentsFromDonor::fetchersMutex");
+    std::vector<OperationContext*> fetcherOpCtxs;
+    bool fetchersInterrupted = false;
+    Status fetcherStatus = Status::OK();
+    std::vector<stdx::thread> fetcherThreads;
+
+    auto runFetcher = [&] {
+        Client::initKillableThread("chunkFetcher", opCtx->getServiceContext());
+
+        auto fetcherOpCtx = Client::getCurrent()->makeOperationContext();
+        {
+            stdx::lock_guard<Latch> lk(fetchersMutex);
+            if (fetchersInterrupted) {
+                return;
+            }
+            fetcherOpCtxs.push_back(fetcherOpCtx.get());
+        }
+        auto unregisterGuard = makeGuard([&] {
+            stdx::lock_guard<Latch> lk(fetchersMutex);
+            fetcherOpCtxs.erase(
+                std::find(fetcherOpCtxs.begin(), fetcherOpCtxs.end(), fetcherOpCtx.get()));
+        });
+
+        try {
+            fetchUntilExhausted(fetcherOpCtx.get(), fetchBatchFn(fetcherOpCtx.get()));
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+            // The inserter failed and has already interrupted the main thread.
+        } catch (const DBException& ex) {
+            stdx::lock_guard<Latch> lk(fetchersMutex);
+            if (fetchersInterrupted || !fetcherStatus.isOK()) {
+                return;
+            }
+            fetcherStatus = ex.toStatus();
+
+            stdx::lock_guard<Client> clientLock(*opCtx->getClient());
+            opCtx->getServiceContext()->killOperation(
+                clientLock, opCtx, ErrorCodes::Error(5212014));
+            LOGV2(5212015,
+                  "Concurrent clone batch fetch failed: {error}",
+                  "error"_attr = redact(fetcherStatus));
+        }
+    };
+
+    auto joinFetchers = [&](bool interrupt) {
+        if (interrupt) {
+            stdx::lock_guard<Latch> lk(fetchersMutex);
+            fetchersInterrupted = true;
+            for (auto fetcherOpCtx : fetcherOpCtxs) {
+                stdx::lock_guard<Client> clientLock(*fetcherOpCtx->getClient());
+                fetcherOpCtx->getServiceContext()->killOperation(
+                    clientLock, fetcherOpCtx, ErrorCodes::Interrupted);
+            }
+        }
+        for (auto& fetcherThread : fetcherThreads) {
+            fetcherThread.join();
+        }
+        fetcherThreads.clear();
+    };
 
     {
         auto inserterThreadJoinGuard = makeGuard([&] {
             batches.closeProducerEnd();
             inserterThread.join();
         });
+        auto fetcherThreadsJoinGuard = makeGuard([&] { joinFetchers(true); });
 
-        while (true) {
+        try {
             auto res = fetchBatchFn(opCtx);
-            try {
-                batches.push(res.getOwned(), opCtx);
-                auto arr = res["objects"].Obj();
-                if (arr.isEmpty()) {
-                    break;
+            if (maxConcurrentFetches > 1 && res["concurrentClone"].trueValue() &&
+                !res["objects"].Obj().isEmpty()) {
+                for (int i = 1; i < maxConcurrentFetches; ++i) {
+                    fetcherThreads.emplace_back(runFetcher);
                 }
-            } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
-                break;
             }
+
+            fetchUntilExhausted(opCtx, std::move(res));
+
+            joinFetchers(false);
+            uassertStatusOK(fetcherStatus);
+
+            batches.push(BSON("objects" << BSONObj()), opCtx);
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+            // The inserter failed; the interruption check below reports it.
+        } catch (const DBException&) {
+            // Surface the fetcher's error rather than the interruption it caused on this thread.
+            joinFetchers(true);
+            uassertStatusOK(fetcherStatus);
+            throw;
         }
     }  // This scope ensures that the guard is destroyed
 
@@ -1027,7 +1110,8 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
 
         // If running on a replicated system, we'll need to flush the docs we cloned to the
         // secondaries
-        lastOpApplied = cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn);
+        lastOpApplied = cloneDocumentsFromDonor(
+            opCtx, insertBatchFn, fetchBatchFn, migrateCloneConcurrency.load());
 
         timing.done(3);
         migrateThreadHangAtStep3.pauseWhileSet();
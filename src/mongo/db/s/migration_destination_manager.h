@@ -115,11 +115,16 @@ public:
 
     /**
      * Clones documents from a donor shard.
+     *
+     * If the donor's first batch reports that it serves disjoint documents to concurrent
+     * _migrateClone requests, up to 'maxConcurrentFetches' threads call 'fetchBatchFn' at once,
+     * each with its own operation context, until every one of them has received an empty batch.
      */
     static repl::OpTime cloneDocumentsFromDonor(
         OperationContext* opCtx,
         std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-        std::function<BSONObj(OperationContext*)> fetchBatchFn);
+        std::function<BSONObj(OperationContext*)> fetchBatchFn,
+        int maxConcurrentFetches = 1);
 
     /**
      * Idempotent method, which causes the current ongoing migration to abort only if it has the
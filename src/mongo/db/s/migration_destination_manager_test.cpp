@@ -29,6 +29,9 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+#include <set>
+
 #include "mongo/db/s/migration_destination_manager.h"
 #include "mongo/s/shard_server_test_fixture.h"
 #include "mongo/unittest/unittest.h"
@@ -157,5 +160,113 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsCatchesInsertErrors) {
     ASSERT_EQ(operationContext()->getKillStatus(), 51008);
 }
 
+/**
+ * Serves 'numDocs' documents in batches of 'batchSize', as a donor would to _migrateClone requests,
+ * and records the operation contexts of the requests it receives.
+ */
+class FakeCloneDonor {
+public:
+    FakeCloneDonor(int numDocs, int batchSize, bool concurrentClone)
+        : _numDocs(numDocs), _batchSize(batchSize), _concurrentClone(concurrentClone) {}
+
+    BSONObj fetchBatch(OperationContext* opCtx) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _requesters.insert(opCtx);
+
+        BSONArrayBuilder arrayBuilder;
+        for (int i = 0; i < _batchSize && _nextDoc < _numDocs; ++i) {
+            arrayBuilder.append(BSON("_id" << _nextDoc++));
+        }
+
+        BSONObjBuilder fetchBatchResultBuilder;
+        fetchBatchResultBuilder.append("objects", arrayBuilder.arr());
+        if (_concurrentClone) {
+            fetchBatchResultBuilder.append("concurrentClone", true);
+        }
+        return fetchBatchResultBuilder.obj();
+    }
+
+    size_t numRequesters() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        return _requesters.size();
+    }
+
+private:
+    const int _numDocs;
+    const int _batchSize;
+    const bool _concurrentClone;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("FakeCloneDonor::_mutex");
+    int _nextDoc{0};
+    std::set<OperationContext*> _requesters;
+};
+
+// Tests that every document is inserted exactly once when several fetchers share the donor.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFetchesConcurrentlyFromDonor) {
+    const int kNumDocs = 1000;
+    FakeCloneDonor donor(kNumDocs, 7, true);
+
+    std::vector<int> resultIds;
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        for (auto&& docToClone : docs) {
+            resultIds.push_back(docToClone.Obj()["_id"].numberInt());
+        }
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(),
+        insertBatchFn,
+        [&](OperationContext* opCtx) { return donor.fetchBatch(opCtx); },
+        4);
+
+    ASSERT_EQ(4U, donor.numRequesters());
+
+    std::sort(resultIds.begin(), resultIds.end());
+    ASSERT_EQ(static_cast<size_t>(kNumDocs), resultIds.size());
+    for (int i = 0; i < kNumDocs; ++i) {
+        ASSERT_EQ(i, resultIds[i]);
+    }
+}
+
+// Tests that a donor which does not report support for concurrent requests is fetched from
+// serially.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFetchesSeriallyFromOlderDonor) {
+    FakeCloneDonor donor(100, 7, false);
+
+    size_t numCloned = 0;
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        numCloned += docs.nFields();
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(),
+        insertBatchFn,
+        [&](OperationContext* opCtx) { return donor.fetchBatch(opCtx); },
+        4);
+
+    ASSERT_EQ(1U, donor.numRequesters());
+    ASSERT_EQ(100U, numCloned);
+}
+
+// Tests that an exception in a concurrent fetcher is rethrown on the main thread.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsThrowsConcurrentFetchErrors) {
+    FakeCloneDonor donor(1000, 7, true);
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        if (opCtx != operationContext()) {
+            uasserted(ErrorCodes::NetworkTimeout, "network error");
+        }
+        return donor.fetchBatch(opCtx);
+    };
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {};
+
+    ASSERT_THROWS_CODE_AND_WHAT(MigrationDestinationManager::cloneDocumentsFromDonor(
+                                    operationContext(), insertBatchFn, fetchBatchFn, 4),
+                                DBException,
+                                ErrorCodes::NetworkTimeout,
+                                "network error");
+}
+
 }  // namespace
 }  // namespace mongo
@@ -35,6 +35,7 @@
 #include "mongo/db/s/collection_sharding_runtime.h"
 #include "mongo/db/s/migration_chunk_cloner_source_legacy.h"
 #include "mongo/db/s/migration_source_manager.h"
+#include "mongo/db/s/shard_key_util.h"
 
 namespace mongo {
 namespace {
@@ -48,10 +49,14 @@ const auto getIsMigrating = OperationContext::declareDecoration<bool>();
  * to a shard which no longer owns the chunk being written to. In such cases, throw a
  * MigrationConflict exception to indicate that the transaction needs to be rolled-back and
  * restarted.
+ *
+ * The shard key is obtained by invoking 'extractShardKey' with the collection's shard key pattern,
+ * which allows callers to reuse a shard key that has already been extracted for the document.
  */
+template <typename ShardKeyExtractor>
 void assertIntersectingChunkHasNotMoved(OperationContext* opCtx,
                                         CollectionShardingRuntime* csr,
-                                        const BSONObj& doc) {
+                                        ShardKeyExtractor&& extractShardKey) {
     if (!repl::ReadConcernArgs::get(opCtx).getArgsAtClusterTime())
         return;
 
@@ -59,7 +64,8 @@ void assertIntersectingChunkHasNotMoved(OperationContext* opCtx,
     if (!collectionFilter.isSharded())
         return;
 
-    auto shardKey = collectionFilter.extractShardKeyFromDoc(doc);
+    const BSONObj& shardKey =
+        extractShardKey(collectionFilter->getChunkManager()->getShardKeyPattern());
 
     // We can assume the simple collation because shard keys do not support non-simple collations.
     auto chunk = collectionFilter.findIntersectingChunkWithSimpleCollation(shardKey);
@@ -69,6 +75,14 @@ void assertIntersectingChunkHasNotMoved(OperationContext* opCtx,
     chunk.throwIfMoved();
 }
 
+void assertIntersectingChunkHasNotMoved(OperationContext* opCtx,
+                                        CollectionShardingRuntime* csr,
+                                        const BSONObj& doc) {
+    assertIntersectingChunkHasNotMoved(opCtx, csr, [&](const ShardKeyPattern& shardKeyPattern) {
+        return shardKeyPattern.extractShardKeyFromDoc(doc);
+    });
+}
+
 bool isMigratingWithCSRLock(CollectionShardingRuntime* csr,
                             CollectionShardingRuntime::CSRLock& csrLock,
                             BSONObj const& docToDelete) {
@@ -94,7 +108,7 @@ void OpObserverShardingImpl::shardObserveAboutToDelete(OperationContext* opCtx,
 
 void OpObserverShardingImpl::shardObserveInsertOp(OperationContext* opCtx,
                                                   const NamespaceString nss,
-                                                  const BSONObj& insertedDoc,
+                                                  const InsertStatement& insertStatement,
                                                   const repl::OpTime& opTime,
                                                   const bool fromMigrate,
                                                   const bool inMultiDocumentTransaction) {
@@ -109,14 +123,18 @@ void OpObserverShardingImpl::shardObserveInsertOp(OperationContext* opCtx,
     csr->checkShardVersionOrThrow(opCtx);
 
     if (inMultiDocumentTransaction) {
-        assertIntersectingChunkHasNotMoved(opCtx, csr, insertedDoc);
+        assertIntersectingChunkHasNotMoved(
+            opCtx, csr, [&](const ShardKeyPattern& shardKeyPattern) -> const BSONObj& {
+                return shardkeyutil::extractShardKeyFromInsertStatement(shardKeyPattern,
+                                                                        insertStatement);
+            });
         return;
     }
 
     auto csrLock = CollectionShardingRuntime::CSRLock::lockShared(opCtx, csr);
     auto msm = MigrationSourceManager::get(csr, csrLock);
     if (msm) {
-        msm->getCloner()->onInsertOp(opCtx, insertedDoc, opTime);
+        msm->getCloner()->onInsertOp(opCtx, insertStatement, opTime);
     }
 }
 
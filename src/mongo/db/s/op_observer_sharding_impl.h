@@ -48,7 +48,7 @@ protected:
                                    BSONObj const& docToDelete) override;
     void shardObserveInsertOp(OperationContext* opCtx,
                               const NamespaceString nss,
-                              const BSONObj& insertedDoc,
+                              const InsertStatement& insertStatement,
                               const repl::OpTime& opTime,
                               const bool fromMigrate,
                               const bool inMultiDocumentTransaction) override;
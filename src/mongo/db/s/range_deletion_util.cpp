@@ -51,9 +51,11 @@
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/migration_util.h"
 #include "mongo/db/s/persistent_task_store.h"
 #include "mongo/db/s/range_deletion_task_gen.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/wait_for_majority_service.h"
 #include "mongo/db/service_context.h"
@@ -231,6 +233,25 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
 }
 
 
+/**
+ * Returns how far the majority commit point lags behind the last write applied on this node, or
+ * zero if it does not lag or this node is not part of a replica set.
+ */
+Milliseconds getMajorityReplicationLag(OperationContext* opCtx) {
+    auto const replCoord = repl::ReplicationCoordinator::get(opCtx);
+    if (!replCoord->isReplEnabled()) {
+        return Milliseconds(0);
+    }
+
+    const auto lastApplied = replCoord->getMyLastAppliedOpTimeAndWallTime();
+    const auto lastCommitted = replCoord->getLastCommittedOpTimeAndWallTime();
+    if (lastCommitted.opTime >= lastApplied.opTime) {
+        return Milliseconds(0);
+    }
+
+    return std::max(Milliseconds(0), lastApplied.wallTime - lastCommitted.wallTime);
+}
+
 template <typename Callable>
 auto withTemporaryOperationContext(Callable&& callable) {
     ThreadClient tc(migrationutil::kRangeDeletionThreadName, getGlobalServiceContext());
@@ -246,6 +267,10 @@ auto withTemporaryOperationContext(Callable&& callable) {
 /**
  * Delete the range in a sequence of batches until there are no more documents to
  * delete or deletion returns an error.
+ *
+ * If the majority commit point falls more than rangeDeleterMaxReplicationLagMS behind after a
+ * batch, the next batch waits for that batch to be majority committed, so that the deletions
+ * cannot outrun the secondaries.
  */
 ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskExecutor>& executor,
                                           const NamespaceString& nss,
@@ -277,7 +302,27 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                          "collectionUuid"_attr = collectionUuid,
                          "range"_attr = range.toString());
 
-                   return numDeleted;
+                   const auto maxReplicationLag =
+                       Milliseconds(rangeDeleterMaxReplicationLagMS.load());
+                   const auto replicationLag = getMajorityReplicationLag(opCtx);
+                   if (numDeleted == 0 || maxReplicationLag == Milliseconds(0) ||
+                       replicationLag <= maxReplicationLag) {
+                       return ExecutorFuture<int>(executor, numDeleted);
+                   }
+
+                   LOGV2_DEBUG(5212016,
+                               1,
+                               "Waiting for majority replication of range deletions in namespace "
+                               "{nss_ns} lagging by {replicationLag}",
+                               "nss_ns"_attr = nss.ns(),
+                               "replicationLag"_attr = replicationLag);
+
+                   auto& replClientInfo = repl::ReplClientInfo::forClient(opCtx->getClient());
+                   replClientInfo.setLastOpToSystemLastOpTime(opCtx);
+                   return WaitForMajorityService::get(opCtx->getServiceContext())
+                       .waitUntilMajority(replClientInfo.getLastOp())
+                       .thenRunOn(executor)
+                       .then([numDeleted] { return numDeleted; });
                });
            })
         .until([](StatusWith<int> swNumDeleted) {
@@ -180,6 +180,51 @@ TEST_F(RangeDeleterTest,
     ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
 }
 
+TEST_F(RangeDeleterTest,
+       RemoveDocumentsInRangeWaitsForMajorityBetweenBatchesWhenReplicationLags) {
+    const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
+    const auto numDocsToInsert = 3;
+    const auto numDocsToRemovePerBatch = 1;
+    auto queriesComplete = SemiFuture<void>::makeReady();
+
+    DBDirectClient dbclient(operationContext());
+    for (auto i = 0; i < numDocsToInsert; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+
+    // The mock never advances its majority commit point, so any applied write makes it lag.
+    auto replCoord = checked_cast<repl::ReplicationCoordinatorMock*>(
+        repl::ReplicationCoordinator::get(getServiceContext()));
+    replCoord->setMyLastAppliedOpTimeAndWallTime(
+        {repl::OpTime(Timestamp(100, 1), 1), Date_t::now()});
+
+    AtomicWord<int> numAwaitReplicationCalls{0};
+    replCoord->setAwaitReplicationReturnValueFunction(
+        [&](OperationContext* opCtx, const repl::OpTime& opTime) {
+            numAwaitReplicationCalls.addAndFetch(1);
+            return repl::ReplicationCoordinator::StatusAndDuration(Status::OK(), Milliseconds(0));
+        });
+
+    const auto originalMaxReplicationLag = rangeDeleterMaxReplicationLagMS.load();
+    rangeDeleterMaxReplicationLagMS.store(1);
+    ON_BLOCK_EXIT([&] { rangeDeleterMaxReplicationLagMS.store(originalMaxReplicationLag); });
+
+    auto cleanupComplete =
+        removeDocumentsInRange(executor(),
+                               std::move(queriesComplete),
+                               kNss,
+                               uuid(),
+                               kShardKeyPattern,
+                               range,
+                               numDocsToRemovePerBatch,
+                               Seconds(0) /* delayForActiveQueriesOnSecondariesToComplete*/,
+                               Milliseconds(0) /* delayBetweenBatches */);
+
+    cleanupComplete.get();
+    ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
+    ASSERT_GTE(numAwaitReplicationCalls.load(), 1);
+}
+
 TEST_F(RangeDeleterTest, RemoveDocumentsInRangeInsertsDocumentToNotifySecondariesOfRangeDeletion) {
     const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
     const int numDocsToRemovePerBatch = 10;
@@ -38,6 +38,7 @@
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/op_observer.h"
+#include "mongo/db/repl/image_collection_entry_gen.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/replication_process.h"
 #include "mongo/db/session.h"
@@ -54,12 +55,77 @@ namespace {
 
 PseudoRandom hashGenerator(SecureRandom().nextInt64());
 
+/**
+ * The destination shard expects the image of a findAndModify as a no-op oplog entry immediately
+ * preceding the write. For a write whose image lives in config.image_collection, this forges that
+ * no-op entry and rewrites 'writeOplog' to link to it instead of carrying needsRetryImage. The
+ * forged opTime only needs to precede the write's since the destination assigns new ones.
+ */
+boost::optional<repl::OplogEntry> forgeNoopImageOplog(OperationContext* opCtx,
+                                                      repl::OplogEntry* writeOplog) {
+    const auto imageKind = writeOplog->getNeedsRetryImage();
+    if (!imageKind || !writeOplog->getSessionId() || !writeOplog->getTxnNumber()) {
+        return boost::none;
+    }
+
+    DBDirectClient client(opCtx);
+    const auto lsid = writeOplog->getSessionId()->toBSON();
+    auto imageDoc = client.findOne(NamespaceString::kConfigImagesNamespace.ns(),
+                                   BSON(repl::ImageEntry::k_idFieldName << lsid));
+    if (imageDoc.isEmpty()) {
+        return boost::none;
+    }
+
+    auto image = repl::ImageEntry::parse(IDLParserErrorContext("forgeNoopImageOplog"), imageDoc);
+    if (image.getTxnNum() != *writeOplog->getTxnNumber() ||
+        image.getTs() != writeOplog->getTimestamp()) {
+        return boost::none;
+    }
+
+    const auto& writeTs = writeOplog->getTimestamp();
+    const repl::OpTime imageOpTime(Timestamp(writeTs.getSecs(), writeTs.getInc() - 1),
+                                   writeOplog->getOpTime().getTerm());
+
+    BSONObjBuilder writeBuilder;
+    for (const auto& elem : writeOplog->toBSON()) {
+        if (elem.fieldNameStringData() != repl::OplogEntry::kNeedsRetryImageFieldName) {
+            writeBuilder.append(elem);
+        }
+    }
+    imageOpTime.append(&writeBuilder,
+                       *imageKind == repl::RetryImageEnum::kPreImage
+                           ? repl::OplogEntry::kPreImageOpTimeFieldName.toString()
+                           : repl::OplogEntry::kPostImageOpTimeFieldName.toString());
+    *writeOplog = uassertStatusOK(repl::OplogEntry::parse(writeBuilder.obj()));
+
+    return repl::OplogEntry(imageOpTime,                            // optime
+                            hashGenerator.nextInt64(),              // hash
+                            repl::OpTypeEnum::kNoop,                // op type
+                            writeOplog->getNss(),                   // namespace
+                            writeOplog->getUuid(),                  // uuid
+                            boost::none,                            // fromMigrate
+                            repl::OplogEntry::kOplogVersion,        // version
+                            image.getImage(),                       // o
+                            boost::none,                            // o2
+                            writeOplog->getOperationSessionInfo(),  // session info
+                            boost::none,                            // upsert
+                            writeOplog->getWallClockTime(),         // wall clock time
+                            writeOplog->getStatementId(),           // statement id
+                            boost::none,   // optime of previous write within same transaction
+                            boost::none,   // pre-image optime
+                            boost::none);  // post-image optime
+}
+
 boost::optional<repl::OplogEntry> fetchPrePostImageOplog(OperationContext* opCtx,
-                                                         const repl::OplogEntry& oplog) {
-    auto opTimeToFetch = oplog.getPreImageOpTime();
+                                                         repl::OplogEntry* oplog) {
+    if (auto forgedImageOplog = forgeNoopImageOplog(opCtx, oplog)) {
+        return forgedImageOplog;
+    }
+
+    auto opTimeToFetch = oplog->getPreImageOpTime();
 
     if (!opTimeToFetch) {
-        opTimeToFetch = oplog.getPostImageOpTime();
+        opTimeToFetch = oplog->getPostImageOpTime();
     }
 
     if (!opTimeToFetch) {
@@ -275,7 +341,7 @@ bool SessionCatalogMigrationSource::_handleWriteHistory(WithLock, OperationConte
                 }
             }
 
-            auto doc = fetchPrePostImageOplog(opCtx, *nextOplog);
+            auto doc = fetchPrePostImageOplog(opCtx, nextOplog.get_ptr());
             if (doc) {
                 _lastFetchedOplogBuffer.push_back(*nextOplog);
                 _lastFetchedOplog = *doc;
@@ -326,7 +392,7 @@ bool SessionCatalogMigrationSource::_fetchNextOplogFromSessionCatalog(OperationC
 }
 
 bool SessionCatalogMigrationSource::_hasNewWrites(WithLock) {
-    return _lastFetchedNewWriteOplog || !_newWriteOpTimeList.empty();
+    return _lastFetchedNewWriteOplog || _pendingNewWriteOplog || !_newWriteOpTimeList.empty();
 }
 
 bool SessionCatalogMigrationSource::_fetchNextNewWriteOplog(OperationContext* opCtx) {
@@ -336,6 +402,12 @@ bool SessionCatalogMigrationSource::_fetchNextNewWriteOplog(OperationContext* op
     {
         stdx::lock_guard<Latch> lk(_newOplogMutex);
 
+        if (_pendingNewWriteOplog) {
+            _lastFetchedNewWriteOplog = std::move(_pendingNewWriteOplog);
+            _pendingNewWriteOplog.reset();
+            return true;
+        }
+
         if (_newWriteOpTimeList.empty()) {
             _lastFetchedNewWriteOplog.reset();
             return false;
@@ -368,9 +440,18 @@ bool SessionCatalogMigrationSource::_fetchNextNewWriteOplog(OperationContext* op
                                    opCtx->getServiceContext()->getFastClockSource()->now());
     }
 
+    // A write whose image lives in config.image_collection is sent as the forged no-op image
+    // entry followed by the write itself.
+    auto imageOplogEntry = forgeNoopImageOplog(opCtx, &newWriteOplogEntry);
+
     {
         stdx::lock_guard<Latch> lk(_newOplogMutex);
-        _lastFetchedNewWriteOplog = newWriteOplogEntry;
+        if (imageOplogEntry) {
+            _lastFetchedNewWriteOplog = std::move(imageOplogEntry);
+            _pendingNewWriteOplog = newWriteOplogEntry;
+        } else {
+            _lastFetchedNewWriteOplog = newWriteOplogEntry;
+        }
         _newWriteOpTimeList.pop_front();
     }
 
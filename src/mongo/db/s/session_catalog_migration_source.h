@@ -248,7 +248,8 @@ private:
     // Used to store the last fetched oplog. This enables calling get multiple times.
     boost::optional<repl::OplogEntry> _lastFetchedOplog;
 
-    // Protects _newWriteTsList, _lastFetchedNewWriteOplog, _state, _newOplogNotification
+    // Protects _newWriteTsList, _lastFetchedNewWriteOplog, _pendingNewWriteOplog, _state,
+    // _newOplogNotification
     Mutex _newOplogMutex = MONGO_MAKE_LATCH("SessionCatalogMigrationSource::_newOplogMutex");
 
 
@@ -258,6 +259,10 @@ private:
     // Used to store the last fetched oplog from _newWriteTsList.
     boost::optional<repl::OplogEntry> _lastFetchedNewWriteOplog;
 
+    // Holds a write whose forged no-op image entry is in _lastFetchedNewWriteOplog, so it is
+    // returned by the next fetch.
+    boost::optional<repl::OplogEntry> _pendingNewWriteOplog;
+
     // Stores the current state.
     State _state{State::kActive};
 
@@ -33,12 +33,24 @@
 #include "mongo/db/hasher.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
+#include "mongo/db/repl/oplog.h"
 #include "mongo/db/s/shard_key_util.h"
 #include "mongo/s/cluster_commands_helpers.h"
 
 namespace mongo {
 namespace shardkeyutil {
 
+const BSONObj& extractShardKeyFromInsertStatement(const ShardKeyPattern& shardKeyPattern,
+                                                  const InsertStatement& insertStatement) {
+    const auto& keyPattern = shardKeyPattern.toBSON();
+    if (insertStatement.shardKey.isEmpty() ||
+        !insertStatement.shardKeyPattern.binaryEqual(keyPattern)) {
+        insertStatement.shardKey = shardKeyPattern.extractShardKeyFromDoc(insertStatement.doc);
+        insertStatement.shardKeyPattern = keyPattern;
+    }
+    return insertStatement.shardKey;
+}
+
 BSONObj makeCreateIndexesCmd(const NamespaceString& nss,
                              const BSONObj& keys,
                              const BSONObj& collation,
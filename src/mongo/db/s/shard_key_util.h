@@ -33,8 +33,19 @@
 #include "mongo/s/shard_util.h"
 
 namespace mongo {
+
+struct InsertStatement;
+
 namespace shardkeyutil {
 
+/**
+ * Returns the shard key of the document being inserted by 'insertStatement' under
+ * 'shardKeyPattern'. The key is extracted from the document the first time it is requested and
+ * cached on the statement, so later observers of the same insert do not extract and hash it again.
+ */
+const BSONObj& extractShardKeyFromInsertStatement(const ShardKeyPattern& shardKeyPattern,
+                                                  const InsertStatement& insertStatement);
+
 /**
  * Constructs the BSON specification document for the create indexes command using the given
  * namespace, index key and options.
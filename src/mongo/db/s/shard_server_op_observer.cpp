@@ -45,6 +45,7 @@
 #include "mongo/db/s/range_deletion_task_gen.h"
 #include "mongo/db/s/shard_filtering_metadata_refresh.h"
 #include "mongo/db/s/shard_identity_rollback_notifier.h"
+#include "mongo/db/s/shard_key_util.h"
 #include "mongo/db/s/sharding_initialization_mongod.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/type_shard_identity.h"
@@ -150,19 +151,16 @@ void onConfigDeleteInvalidateCachedCollectionMetadataAndNotify(OperationContext*
 }
 
 /**
- * If the collection is sharded, finds the chunk that contains the specified document and increments
- * the size tracked for that chunk by the specified amount of data written, in bytes. Returns the
- * number of total bytes on that chunk after the data is written.
+ * If the collection is sharded, finds the chunk that contains the specified shard key and
+ * increments the size tracked for that chunk by the specified amount of data written, in bytes.
+ * Returns the number of total bytes on that chunk after the data is written.
  */
 void incrementChunkOnInsertOrUpdate(OperationContext* opCtx,
                                     const NamespaceString& nss,
                                     const ChunkManager& chunkManager,
-                                    const BSONObj& document,
+                                    const BSONObj& shardKey,
                                     long dataWritten,
                                     bool fromMigrate) {
-    const auto& shardKeyPattern = chunkManager.getShardKeyPattern();
-    BSONObj shardKey = shardKeyPattern.extractShardKeyFromDoc(document);
-
     // Use the shard key to locate the chunk into which the document was updated, and increment the
     // number of bytes tracked for the chunk.
     //
@@ -259,10 +257,12 @@ void ShardServerOpObserver::onInserts(OperationContext* opCtx,
         }
 
         if (metadata->isSharded()) {
+            const auto& chunkManager = *metadata->getChunkManager();
             incrementChunkOnInsertOrUpdate(opCtx,
                                            nss,
-                                           *metadata->getChunkManager(),
-                                           insertedDoc,
+                                           chunkManager,
+                                           shardkeyutil::extractShardKeyFromInsertStatement(
+                                               chunkManager.getShardKeyPattern(), *it),
                                            insertedDoc.objsize(),
                                            fromMigrate);
         }
@@ -383,10 +383,12 @@ void ShardServerOpObserver::onUpdate(OperationContext* opCtx, const OplogUpdateE
     }
 
     if (metadata->isSharded()) {
+        const auto& chunkManager = *metadata->getChunkManager();
         incrementChunkOnInsertOrUpdate(opCtx,
                                        args.nss,
-                                       *metadata->getChunkManager(),
-                                       args.updateArgs.updatedDoc,
+                                       chunkManager,
+                                       chunkManager.getShardKeyPattern().extractShardKeyFromDoc(
+                                           args.updateArgs.updatedDoc),
                                        args.updateArgs.updatedDoc.objsize(),
                                        args.updateArgs.fromMigrate);
     }
@@ -34,6 +34,7 @@
 #include "mongo/db/s/active_migrations_registry.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/sharding_statistics.h"
+#include "mongo/s/async_requests_sender.h"
 #include "mongo/s/balancer_configuration.h"
 #include "mongo/s/catalog_cache.h"
 #include "mongo/s/client/shard_registry.h"
@@ -111,6 +112,11 @@ public:
         BSONObjBuilder result;
         ShardingStatistics::get(opCtx).report(&result);
         catalogCache->report(&result);
+
+        BSONObjBuilder asyncRequestsSenderBuilder(result.subobjStart("asyncRequestsSender"));
+        AsyncRequestsSender::reportStats(&asyncRequestsSenderBuilder);
+        asyncRequestsSenderBuilder.doneFast();
+
         return result.obj();
     }
 
@@ -35,6 +35,7 @@
 
 #include "mongo/db/logical_clock.h"
 #include "mongo/db/s/transaction_coordinator_metrics_observer.h"
+#include "mongo/db/s/transaction_coordinator_params_gen.h"
 #include "mongo/db/s/wait_for_majority_service.h"
 #include "mongo/db/server_options.h"
 #include "mongo/logv2/log.h"
@@ -236,6 +237,17 @@ TransactionCoordinator::TransactionCoordinator(OperationContext* operationContex
 
                 if (_decisionDurable)
                     return Future<repl::OpTime>::makeReady(repl::OpTime());
+
+                // An abort decision which any recovered coordinator would reach again by sending
+                // prepare to the same participants does not need to be made durable.
+                if (_canPresumeAbort()) {
+                    LOGV2_DEBUG(5212048,
+                                3,
+                                "{txnId} Not persisting abort decision {abortStatus}",
+                                "txnId"_attr = txn::txnIdToString(_lsid, _txnNumber),
+                                "abortStatus"_attr = redact(*_decision->getAbortStatus()));
+                    return Future<repl::OpTime>::makeReady(repl::OpTime());
+                }
             }
 
             return txn::persistDecision(*_scheduler, _lsid, _txnNumber, *_participants, *_decision);
@@ -369,6 +381,21 @@ void TransactionCoordinator::cancelIfCommitNotYetStarted() {
                                     "Transaction exceeded deadline or newer transaction started"});
 }
 
+bool TransactionCoordinator::_canPresumeAbort() const {
+    if (!transactionCoordinatorPresumeAbort.load())
+        return false;
+
+    // Only an abort vote from a participant which no longer has the transaction is certain to be
+    // given again, since a transaction number is never reused once commit has been requested.
+    invariant(_decision);
+    if (_decision->getDecision() != CommitDecision::kAbort)
+        return false;
+
+    const auto abortCode = _decision->getAbortStatus()->code();
+    return abortCode == ErrorCodes::NoSuchTransaction ||
+        abortCode == ErrorCodes::TransactionTooOld;
+}
+
 bool TransactionCoordinator::_reserveKickOffCommitPromise() {
     stdx::lock_guard<Latch> lg(_mutex);
     if (_kickOffCommitPromiseSet)
@@ -135,6 +135,12 @@ private:
 
     bool _reserveKickOffCommitPromise();
 
+    /**
+     * Returns true if '_decision' is an abort which need not be persisted, because a coordinator
+     * recovered without it would reach the same decision. See transactionCoordinatorPresumeAbort.
+     */
+    bool _canPresumeAbort() const;
+
     /**
      * Helper for handling errors that occur during either phase of commit coordination.
      */
@@ -79,6 +79,7 @@
 #include "mongo/db/session_catalog_mongod.h"
 #include "mongo/db/snapshot_window_util.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/db/stats/operation_stack_sampler.h"
 #include "mongo/db/stats/server_read_concern_metrics.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/db/transaction_participant.h"
@@ -1119,6 +1120,7 @@ void execCommandDatabase(OperationContext* opCtx,
         behaviors.setPrepareConflictBehaviorForReadConcern(opCtx, invocation.get());
 
         try {
+            OperationStackSampler::ActiveOperation sampledOperation(command->getName());
             if (!runCommandImpl(opCtx,
                                 invocation.get(),
                                 request,
@@ -1148,7 +1150,15 @@ void execCommandDatabase(OperationContext* opCtx,
             // history window that the storage engine maintains in order to increase the likelihood
             // of successful future PIT atClusterTime requests.
             SnapshotWindowUtil::incrementSnapshotTooOldErrorCount();
-            SnapshotWindowUtil::increaseTargetSnapshotWindowSize(opCtx);
+            boost::optional<Seconds> failedSnapshotAge;
+            if (auto atClusterTime = repl::ReadConcernArgs::get(opCtx).getArgsAtClusterTime()) {
+                auto now = LogicalClock::get(opCtx)->getClusterTime().asTimestamp();
+                if (now > atClusterTime->asTimestamp()) {
+                    failedSnapshotAge =
+                        Seconds(now.getSecs() - atClusterTime->asTimestamp().getSecs());
+                }
+            }
+            SnapshotWindowUtil::increaseTargetSnapshotWindowSize(opCtx, failedSnapshotAge);
         } else {
             behaviors.handleException(e, opCtx);
         }
@@ -68,8 +68,9 @@ private:
     // A pointer back to the currently running operation on this Session, or nullptr if there
     // is no operation currently running for the Session.
     //
-    // This field is only safe to read or write while holding the SessionCatalog::_mutex. In
-    // practice, it is only used inside of the SessionCatalog itself.
+    // This field is only safe to read or write while holding the mutex of the SessionCatalog
+    // partition which owns this session. In practice, it is only used inside of the SessionCatalog
+    // itself.
     OperationContext* _checkoutOpCtx{nullptr};
 
     // Keeps the last time this session was checked-out
@@ -125,23 +125,13 @@ const auto kSortById = BSON(SessionTxnRecord::kSessionIdFieldName << 1);
 const auto kLastWriteDateFieldName = SessionTxnRecord::kLastWriteDateFieldName;
 
 /**
- * Removes the specified set of session ids from the persistent sessions collection and returns the
- * number of sessions actually removed.
+ * Deletes the documents keyed by the given session ids from 'nss' and returns the number of
+ * documents actually removed.
  */
-int removeSessionsTransactionRecords(OperationContext* opCtx,
-                                     SessionsCollection& sessionsCollection,
-                                     const LogicalSessionIdSet& sessionIdsToRemove) {
-    if (sessionIdsToRemove.empty())
-        return 0;
-
-    // From the passed-in sessions, find the ones which are actually expired/removed
-    auto expiredSessionIds = sessionsCollection.findRemovedSessions(opCtx, sessionIdsToRemove);
-
-    if (expiredSessionIds.empty())
-        return 0;
-
-    // Remove the session ids from the on-disk catalog
-    write_ops::Delete deleteOp(NamespaceString::kSessionTransactionsTableNamespace);
+int removeSessionsFromCollection(OperationContext* opCtx,
+                                 const NamespaceString& nss,
+                                 const LogicalSessionIdSet& expiredSessionIds) {
+    write_ops::Delete deleteOp(nss);
     deleteOp.setWriteCommandBase([] {
         write_ops::WriteCommandBase base;
         base.setOrdered(false);
@@ -159,9 +149,7 @@ int removeSessionsTransactionRecords(OperationContext* opCtx,
     BSONObj result;
 
     DBDirectClient client(opCtx);
-    client.runCommand(NamespaceString::kSessionTransactionsTableNamespace.db().toString(),
-                      deleteOp.toBSON({}),
-                      result);
+    client.runCommand(nss.db().toString(), deleteOp.toBSON({}), result);
 
     BatchedCommandResponse response;
     std::string errmsg;
@@ -173,20 +161,40 @@ int removeSessionsTransactionRecords(OperationContext* opCtx,
     return response.getN();
 }
 
-void createTransactionTable(OperationContext* opCtx) {
+/**
+ * Removes the specified set of session ids from the persistent sessions collection and returns the
+ * number of sessions actually removed. The retryable findAndModify images of those sessions are
+ * removed along with them.
+ */
+int removeSessionsTransactionRecords(OperationContext* opCtx,
+                                     SessionsCollection& sessionsCollection,
+                                     const LogicalSessionIdSet& sessionIdsToRemove) {
+    if (sessionIdsToRemove.empty())
+        return 0;
+
+    // From the passed-in sessions, find the ones which are actually expired/removed
+    auto expiredSessionIds = sessionsCollection.findRemovedSessions(opCtx, sessionIdsToRemove);
+
+    if (expiredSessionIds.empty())
+        return 0;
+
+    // Remove the session ids from the on-disk catalog
+    const auto numReaped = removeSessionsFromCollection(
+        opCtx, NamespaceString::kSessionTransactionsTableNamespace, expiredSessionIds);
+    removeSessionsFromCollection(opCtx, NamespaceString::kConfigImagesNamespace, expiredSessionIds);
+    return numReaped;
+}
+
+void createConfigCollection(OperationContext* opCtx, const NamespaceString& nss) {
     auto serviceCtx = opCtx->getServiceContext();
     CollectionOptions options;
-    auto status =
-        repl::StorageInterface::get(serviceCtx)
-            ->createCollection(opCtx, NamespaceString::kSessionTransactionsTableNamespace, options);
+    auto status = repl::StorageInterface::get(serviceCtx)->createCollection(opCtx, nss, options);
     if (status == ErrorCodes::NamespaceExists) {
         return;
     }
 
     uassertStatusOKWithContext(
-        status,
-        str::stream() << "Failed to create the "
-                      << NamespaceString::kSessionTransactionsTableNamespace.ns() << " collection");
+        status, str::stream() << "Failed to create the " << nss.ns() << " collection");
 }
 
 void abortInProgressTransactions(OperationContext* opCtx) {
@@ -265,7 +273,8 @@ void MongoDSessionCatalog::onStepUp(OperationContext* opCtx) {
 
     abortInProgressTransactions(opCtx);
 
-    createTransactionTable(opCtx);
+    createConfigCollection(opCtx, NamespaceString::kSessionTransactionsTableNamespace);
+    createConfigCollection(opCtx, NamespaceString::kConfigImagesNamespace);
 }
 
 boost::optional<UUID> MongoDSessionCatalog::getTransactionTableUUID(OperationContext* opCtx) {
@@ -225,6 +225,35 @@ TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessions) {
     lsidsFound.clear();
 }
 
+TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessionsVisitsSessionsOfAllPartitions) {
+    // Enough sessions for every partition of the catalog to hold some of them.
+    LogicalSessionIdSet lsids;
+    for (int i = 0; i < 200; ++i) {
+        const auto lsid = makeLogicalSessionIdForTest();
+        lsids.insert(lsid);
+        stdx::async(stdx::launch::async,
+                    [this, lsid] {
+                        ThreadClient tc(getServiceContext());
+                        auto opCtx = makeOperationContext();
+                        opCtx->setLogicalSessionId(lsid);
+                        OperationContextSession ocs(opCtx.get());
+                    })
+            .get();
+    }
+    ASSERT_EQ(lsids.size(), catalog()->size());
+
+    SessionKiller::Matcher matcherAllSessions(
+        KillAllSessionsByPatternSet{makeKillAllSessionsByPattern(_opCtx)});
+
+    LogicalSessionIdSet lsidsFound;
+    catalog()->scanSessions(matcherAllSessions, [&](ObservableSession& session) {
+        ASSERT(lsidsFound.insert(session.getSessionId()).second);
+        session.markForReap();
+    });
+    ASSERT(lsids == lsidsFound);
+    ASSERT_EQ(0U, catalog()->size());
+}
+
 TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessionsMarkForReap) {
     // Create three sessions in the catalog.
     const std::vector<LogicalSessionId> lsids{makeLogicalSessionIdForTest(),
@@ -87,7 +87,8 @@ void _decreaseTargetSnapshotWindowSize(WithLock lock, OperationContext* opCtx) {
 
 }  // namespace
 
-void increaseTargetSnapshotWindowSize(OperationContext* opCtx) {
+void increaseTargetSnapshotWindowSize(OperationContext* opCtx,
+                                      boost::optional<Seconds> failedSnapshotAge) {
     if (MONGO_unlikely(preventDynamicSnapshotHistoryWindowTargetAdjustments.shouldFail())) {
         return;
     }
@@ -142,11 +143,18 @@ void increaseTargetSnapshotWindowSize(OperationContext* opCtx) {
         return;
     }
 
-    int increasedSnapshotWindow = snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.load() +
-        snapshotWindowParams.snapshotWindowAdditiveIncreaseSeconds.load();
-    snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.store(
-        std::min(increasedSnapshotWindow,
-                 snapshotWindowParams.maxTargetSnapshotHistoryWindowInSeconds.load()));
+    const auto additiveIncrease = snapshotWindowParams.snapshotWindowAdditiveIncreaseSeconds.load();
+    long long increasedSnapshotWindow =
+        snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.load() + additiveIncrease;
+    if (failedSnapshotAge) {
+        // Size the window from the age of the snapshot the workload actually asked for, so that a
+        // long-running snapshot reader needs one increase rather than one per additive step.
+        increasedSnapshotWindow = std::max(
+            increasedSnapshotWindow, durationCount<Seconds>(*failedSnapshotAge) + additiveIncrease);
+    }
+    snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.store(static_cast<int>(
+        std::min<long long>(increasedSnapshotWindow,
+                            snapshotWindowParams.maxTargetSnapshotHistoryWindowInSeconds.load())));
 
     _snapshotWindowLastIncreasedAt = Date_t::now();
 }
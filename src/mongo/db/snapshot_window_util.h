@@ -29,6 +29,10 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
+#include "mongo/util/duration.h"
+
 namespace mongo {
 
 class OperationContext;
@@ -48,7 +52,10 @@ namespace SnapshotWindowUtil {
  * actions taken next time oldest_timestamp is updated, usually when the stable timestamp is
  * advanced.
  *
- * Implements an additive increase algorithm.
+ * Implements an additive increase algorithm. If the caller knows how far behind the present the
+ * snapshot which could not be found was, passed as 'failedSnapshotAge', the window is instead
+ * grown in a single step to cover a snapshot of that age, plus the usual additive increase as a
+ * margin, rather than by one additive step per rate-limited call.
  *
  * Calling many times all at once has the same effect as calling once. The last update time is
  * tracked and attempts to increase the window are limited to once in
@@ -57,7 +64,8 @@ namespace SnapshotWindowUtil {
  * snapshot window size setting to have an effect. The target size can also never exceed
  * maxTargetSnapshotHistoryWindowInSeconds.
  */
-void increaseTargetSnapshotWindowSize(OperationContext* opCtx);
+void increaseTargetSnapshotWindowSize(OperationContext* opCtx,
+                                      boost::optional<Seconds> failedSnapshotAge = boost::none);
 
 /**
  * Attempts to decrease (if not already zero) the setting that affects the size of the window of
@@ -162,6 +162,33 @@ TEST_F(SnapshotWindowTest, DecreaseAndIncreaseSnapshotWindow) {
     ASSERT_EQ(snapshotWindowSecondsFive, maxTargetSnapshotWindowSeconds);
 }
 
+TEST_F(SnapshotWindowTest, IncreaseSnapshotWindowToCoverFailedSnapshotAge) {
+    auto engine = getServiceContext()->getStorageEngine();
+    invariant(engine);
+    engine->setCachePressureForTest(snapshotWindowParams.cachePressureThreshold.load() - 5);
+
+    snapshotWindowParams.maxTargetSnapshotHistoryWindowInSeconds.store(100);
+    snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.store(5);
+    snapshotWindowParams.minMillisBetweenSnapshotWindowInc.store(100);
+    snapshotWindowParams.snapshotWindowAdditiveIncreaseSeconds.store(2);
+    auto minTimeBetweenInc = snapshotWindowParams.minMillisBetweenSnapshotWindowInc.load();
+
+    // A snapshot 30 seconds old grows the window in one step, with the additive increase as margin.
+    sleepmillis(2 * minTimeBetweenInc);
+    increaseTargetSnapshotWindowSize(_opCtx.get(), Seconds(30));
+    ASSERT_EQ(32, snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.load());
+
+    // A snapshot already covered by the window falls back to the additive increase.
+    sleepmillis(2 * minTimeBetweenInc);
+    increaseTargetSnapshotWindowSize(_opCtx.get(), Seconds(10));
+    ASSERT_EQ(34, snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.load());
+
+    // The window never exceeds the maximum, however old the snapshot.
+    sleepmillis(2 * minTimeBetweenInc);
+    increaseTargetSnapshotWindowSize(_opCtx.get(), Seconds(1000));
+    ASSERT_EQ(100, snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.load());
+}
+
 TEST_F(SnapshotWindowTest, IncrementSnapshotTooOldErrorCount) {
     auto beforeCount = snapshotWindowParams.snapshotTooOldErrorCount.load();
     incrementSnapshotTooOldErrorCount();
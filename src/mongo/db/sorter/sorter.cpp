@@ -49,13 +49,16 @@
 #include "mongo/db/sorter/sorter.h"
 
 #include <boost/filesystem/operations.hpp>
+#include <cstring>
 #include <snappy.h>
 #include <vector>
+#include <zstd.h>
 
 #include "mongo/base/string_data.h"
 #include "mongo/config.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/sorter/sorter_server_parameters_gen.h"
 #include "mongo/db/storage/encryption_hooks.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/platform/atomic_word.h"
@@ -63,6 +66,7 @@
 #include "mongo/s/is_mongos.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/destructor_guard.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 #include "mongo/util/unowned_ptr.h"
 
@@ -80,6 +84,17 @@ uint32_t addDataToChecksum(const void* startOfData, size_t sizeOfData, uint32_t
     return newChecksum;
 }
 
+/**
+ * Every block that SortedFileWriter spills is preceded by this header. 'checksum' covers the
+ * 'size' bytes of the block exactly as they are stored, that is after compression and encryption,
+ * so that corruption is detected before the block is decrypted or decompressed.
+ */
+struct SortedFileBlockHeader {
+    int32_t size;
+    uint8_t compressor;  // A SorterSpillCompressor.
+    uint32_t checksum;
+};
+
 }  // namespace
 
 namespace sorter {
@@ -262,18 +277,29 @@ private:
      * read, then _done is set to true and the function returns immediately.
      */
     void fillBufferFromDisk() {
-        int32_t rawSize;
-        read(&rawSize, sizeof(rawSize));
+        SortedFileBlockHeader header;
+        read(&header.size, sizeof(header.size));
         if (_done)
             return;
+        read(&header.compressor, sizeof(header.compressor));
+        read(&header.checksum, sizeof(header.checksum));
+        uassert(16816, "file too short?", !_done);
+        uassert(5212001,
+                str::stream() << "invalid block header in file \"" << _fileName << "\"",
+                header.size > 0 &&
+                    header.compressor <= static_cast<uint8_t>(SorterSpillCompressor::kZstd));
 
-        // negative size means compressed
-        const bool compressed = rawSize < 0;
-        int32_t blockSize = std::abs(rawSize);
+        const auto compressor = static_cast<SorterSpillCompressor>(header.compressor);
+        int32_t blockSize = header.size;
 
         _buffer.reset(new char[blockSize]);
         read(_buffer.get(), blockSize);
         uassert(16816, "file too short?", !_done);
+        uassert(ErrorCodes::ChecksumMismatch,
+                str::stream() << "Data read from disk in file \"" << _fileName
+                              << "\" does not match what was written to disk. Possible corruption "
+                                 "of data.",
+                addDataToChecksum(_buffer.get(), blockSize, 0) == header.checksum);
 
         auto encryptionHooks = EncryptionHooks::get(getGlobalServiceContext());
         if (encryptionHooks->enabled()) {
@@ -292,11 +318,30 @@ private:
             _buffer.swap(out);
         }
 
-        if (!compressed) {
+        if (compressor == SorterSpillCompressor::kNone) {
             _bufferReader.reset(new BufReader(_buffer.get(), blockSize));
             return;
         }
 
+        if (compressor == SorterSpillCompressor::kZstd) {
+            const auto uncompressedSize = ZSTD_getFrameContentSize(_buffer.get(), blockSize);
+            uassert(5212002,
+                    "couldn't get uncompressed length",
+                    uncompressedSize != ZSTD_CONTENTSIZE_UNKNOWN &&
+                        uncompressedSize != ZSTD_CONTENTSIZE_ERROR);
+
+            std::unique_ptr<char[]> decompressionBuffer(new char[uncompressedSize]);
+            const size_t ret = ZSTD_decompress(
+                decompressionBuffer.get(), uncompressedSize, _buffer.get(), blockSize);
+            uassert(5212003,
+                    str::stream() << "decompression failed: " << ZSTD_getErrorName(ret),
+                    !ZSTD_isError(ret) && ret == uncompressedSize);
+
+            _buffer.swap(decompressionBuffer);
+            _bufferReader.reset(new BufReader(_buffer.get(), uncompressedSize));
+            return;
+        }
+
         dassert(snappy::IsValidCompressedBuffer(_buffer.get(), blockSize));
 
         size_t uncompressedSize;
@@ -317,24 +362,62 @@ private:
     /**
      * Attempts to read data from disk. Sets _done to true when file offset reaches _fileEndOffset.
      *
+     * Reads are served from a read-ahead buffer of 'sorterFileReadAheadBytes', so that the several
+     * small header reads and the block read for each block usually cost a single large read from
+     * the file. Reads larger than the read-ahead buffer go straight to the file.
+     *
      * Masserts on any file errors
      */
     void read(void* out, size_t size) {
         invariant(_file.is_open());
 
+        if (_readAheadPos == _readAheadEnd) {
+            const std::streampos offset = fileOffset();
+            if (offset >= _fileEndOffset) {
+                invariant(offset == _fileEndOffset);
+                _done = true;
+                return;
+            }
+        }
+
+        char* dest = static_cast<char*>(out);
+        const size_t fromBuffer = std::min(size, _readAheadEnd - _readAheadPos);
+        memcpy(dest, _readAheadBuffer.get() + _readAheadPos, fromBuffer);
+        _readAheadPos += fromBuffer;
+        dest += fromBuffer;
+        size -= fromBuffer;
+        if (size == 0) {
+            return;
+        }
+
+        const size_t remainingInRange = _fileEndOffset - fileOffset();
+        if (size >= _readAheadCapacity || remainingInRange <= size) {
+            readFromFile(dest, size);
+            return;
+        }
+
+        // Refill the read-ahead buffer, never reading beyond the end of our range of the file.
+        if (!_readAheadBuffer) {
+            _readAheadBuffer.reset(new char[_readAheadCapacity]);
+        }
+        const size_t toRead = std::min(_readAheadCapacity, remainingInRange);
+        readFromFile(_readAheadBuffer.get(), toRead);
+        memcpy(dest, _readAheadBuffer.get(), size);
+        _readAheadPos = size;
+        _readAheadEnd = toRead;
+    }
+
+    std::streampos fileOffset() {
         const std::streampos offset = _file.tellg();
         uassert(51049,
                 str::stream() << "error reading file \"" << _fileName
                               << "\": " << myErrnoWithDescription(),
                 offset >= 0);
+        return offset;
+    }
 
-        if (offset >= _fileEndOffset) {
-            invariant(offset == _fileEndOffset);
-            _done = true;
-            return;
-        }
-
-        _file.read(reinterpret_cast<char*>(out), size);
+    void readFromFile(char* out, size_t size) {
+        _file.read(out, size);
         uassert(16817,
                 str::stream() << "error reading file \"" << _fileName
                               << "\": " << myErrnoWithDescription(),
@@ -347,6 +430,14 @@ private:
 
     std::unique_ptr<char[]> _buffer;
     std::unique_ptr<BufReader> _bufferReader;
+
+    // Raw file contents which have been read from disk but not yet consumed by read(). Allocated
+    // on first use.
+    const size_t _readAheadCapacity = gSorterFileReadAheadBytes.load();
+    std::unique_ptr<char[]> _readAheadBuffer;
+    size_t _readAheadPos = 0;
+    size_t _readAheadEnd = 0;
+
     std::string _fileName;            // File containing the sorted data range.
     std::streampos _fileStartOffset;  // File offset at which the sorted data range starts.
     std::streampos _fileEndOffset;    // File offset at which the sorted data range ends.
@@ -367,6 +458,10 @@ private:
  * Merge-sorts results from 0 or more FileIterators, all of which should be iterating over sorted
  * ranges within the same file. This class is given the data source file name upon construction and
  * is responsible for deleting the data source file upon destruction.
+ *
+ * The merge is driven by a loser tree (tournament tree): each internal node remembers the stream
+ * that lost the match played there, so replacing the winner costs one comparison per level of the
+ * tree instead of the two per level a binary heap needs to sift down.
  */
 template <typename Key, typename Value, typename Comparator>
 class MergeIterator : public SortIteratorInterface<Key, Value> {
@@ -381,33 +476,31 @@ public:
         : _opts(opts),
           _remaining(opts.limit ? opts.limit : std::numeric_limits<unsigned long long>::max()),
           _first(true),
-          _greater(comp),
+          _less(comp),
           _itersSourceFileName(itersSourceFileName) {
         for (size_t i = 0; i < iters.size(); i++) {
             iters[i]->openSource();
             if (iters[i]->more()) {
-                _heap.push_back(std::make_shared<Stream>(i, iters[i]->next(), iters[i]));
+                _streams.push_back(std::make_shared<Stream>(i, iters[i]->next(), iters[i]));
             } else {
                 iters[i]->closeSource();
             }
         }
 
-        if (_heap.empty()) {
+        if (_streams.empty()) {
             _remaining = 0;
             return;
         }
 
-        std::make_heap(_heap.begin(), _heap.end(), _greater);
-        std::pop_heap(_heap.begin(), _heap.end(), _greater);
-        _current = _heap.back();
-        _heap.pop_back();
+        _numLiveStreams = _streams.size();
+        _tree.resize(_streams.size());
+        _tree[0] = _buildTree(1);
     }
 
     ~MergeIterator() {
         // Clear the remaining Stream objects first, to close the file handles before deleting the
         // file. Some systems will error closing the file if any file handles are still open.
-        _current.reset();
-        _heap.clear();
+        _streams.clear();
         DESTRUCTOR_GUARD(boost::filesystem::remove(_itersSourceFileName));
     }
 
@@ -415,7 +508,7 @@ public:
     void closeSource() {}
 
     bool more() {
-        if (_remaining > 0 && (_first || !_heap.empty() || _current->more()))
+        if (_remaining > 0 && (_first || _numLiveStreams > 1 || _streams[_tree[0]]->more()))
             return true;
 
         _remaining = 0;
@@ -429,21 +522,20 @@ public:
 
         if (_first) {
             _first = false;
-            return _current->current();
+            return _streams[_tree[0]]->current();
         }
 
-        if (!_current->advance()) {
-            verify(!_heap.empty());
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            _current = _heap.back();
-            _heap.pop_back();
-        } else if (!_heap.empty() && _greater(_current, _heap.front())) {
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            std::swap(_current, _heap.back());
-            std::push_heap(_heap.begin(), _heap.end(), _greater);
+        size_t winner = _tree[0];
+        if (!_streams[winner]->advance()) {
+            // Release the exhausted stream now so its file handle is closed as early as possible.
+            // An empty slot loses every match it plays from here on.
+            _streams[winner].reset();
+            _numLiveStreams--;
         }
+        _replay(winner);
 
-        return _current->current();
+        verify(_streams[_tree[0]]);
+        return _streams[_tree[0]]->current();
     }
 
 
@@ -485,33 +577,132 @@ private:
         std::shared_ptr<Input> _rest;
     };
 
-    class STLComparator {  // uses greater rather than less-than to maintain a MinHeap
+    class STLComparator {
     public:
         explicit STLComparator(const Comparator& comp) : _comp(comp) {}
         bool operator()(unowned_ptr<const Stream> lhs, unowned_ptr<const Stream> rhs) const {
+            // exhausted streams sort after everything else
+            if (!rhs)
+                return bool(lhs);
+            if (!lhs)
+                return false;
+
             // first compare data
             dassertCompIsSane(_comp, lhs->current(), rhs->current());
             int ret = _comp(lhs->current(), rhs->current());
             if (ret)
-                return ret > 0;
+                return ret < 0;
 
             // then compare fileNums to ensure stability
-            return lhs->fileNum > rhs->fileNum;
+            return lhs->fileNum < rhs->fileNum;
         }
 
     private:
         const Comparator _comp;
     };
 
+    /**
+     * The tree is stored implicitly: with N streams, internal nodes are 1..N-1 (children of node i
+     * are 2i and 2i+1) and leaf N+j stands for _streams[j]. _tree[i] holds the loser of the match
+     * at internal node i and _tree[0] holds the overall winner.
+     *
+     * Plays every match in the subtree rooted at 'node' and returns the index of its winner.
+     */
+    size_t _buildTree(size_t node) {
+        const size_t numStreams = _streams.size();
+        if (node >= numStreams)
+            return node - numStreams;
+
+        size_t left = _buildTree(2 * node);
+        size_t right = _buildTree(2 * node + 1);
+        if (_less(_streams[right], _streams[left])) {
+            _tree[node] = left;
+            return right;
+        }
+        _tree[node] = right;
+        return left;
+    }
+
+    /**
+     * Replays the matches on the path from the leaf of stream 'index' up to the root after that
+     * stream's current element changed.
+     */
+    void _replay(size_t index) {
+        size_t winner = index;
+        for (size_t node = (index + _streams.size()) / 2; node > 0; node /= 2) {
+            if (_less(_streams[_tree[node]], _streams[winner]))
+                std::swap(_tree[node], winner);
+        }
+        _tree[0] = winner;
+    }
+
     SortOptions _opts;
     unsigned long long _remaining;
     bool _first;
-    std::shared_ptr<Stream> _current;
-    std::vector<std::shared_ptr<Stream>> _heap;  // MinHeap
-    STLComparator _greater;                      // named so calls make sense
+    std::vector<std::shared_ptr<Stream>> _streams;  // null once exhausted
+    std::vector<size_t> _tree;                      // loser tree over indexes into _streams
+    size_t _numLiveStreams = 0;
+    STLComparator _less;
     std::string _itersSourceFileName;
 };
 
+/**
+ * Merges the sorted runs in 'iters' in groups of at most sorterMaxMergeFanIn runs, one level at a
+ * time, until they can all be merged at once without exceeding the fan-in bound. Each level is
+ * written to a new spill file, after which the file holding the previous level is removed and
+ * 'fileName' and 'nextFileOffset' are updated to describe the new one. If 'opts' has a limit, each
+ * merged run keeps only that many elements.
+ */
+template <typename Key, typename Value, typename Comparator>
+void mergeSpillsToFanIn(const SortOptions& opts,
+                        const Comparator& comp,
+                        const typename SortedFileWriter<Key, Value>::Settings& settings,
+                        std::string* fileName,
+                        std::streampos* nextFileOffset,
+                        std::vector<std::shared_ptr<SortIteratorInterface<Key, Value>>>* iters) {
+    typedef SortIteratorInterface<Key, Value> Iterator;
+
+    const size_t maxFanIn = std::max(2, gSorterMaxMergeFanIn.load());
+    while (iters->size() > maxFanIn) {
+        const std::string mergedFileName = opts.tempDir + "/" + nextFileName();
+        auto removeMergedFile =
+            makeGuard([&] { DESTRUCTOR_GUARD(boost::filesystem::remove(mergedFileName)); });
+
+        // Spread the runs evenly over the fewest groups that respect the fan-in bound, keeping
+        // them in spill order so that the final merge stays stable.
+        const size_t numRuns = iters->size();
+        const size_t numGroups = (numRuns + maxFanIn - 1) / maxFanIn;
+        std::streampos mergedFileOffset = 0;
+        std::vector<std::shared_ptr<Iterator>> mergedIters;
+        for (size_t group = 0; group < numGroups; group++) {
+            std::vector<std::shared_ptr<Iterator>> groupIters(
+                iters->begin() + numRuns * group / numGroups,
+                iters->begin() + numRuns * (group + 1) / numGroups);
+
+            SortedFileWriter<Key, Value> writer(opts, mergedFileName, mergedFileOffset, settings);
+            {
+                // The runs being merged live in 'fileName', which is removed below once the whole
+                // level has been merged, so this MergeIterator is not given a file to delete.
+                MergeIterator<Key, Value, Comparator> groupMerge(groupIters, "", opts, comp);
+                while (groupMerge.more()) {
+                    auto next = groupMerge.next();
+                    writer.addAlreadySorted(next.first, next.second);
+                }
+            }
+            mergedIters.push_back(std::shared_ptr<Iterator>(writer.done()));
+            mergedFileOffset = writer.getFileEndOffset();
+        }
+
+        iters->clear();
+        DESTRUCTOR_GUARD(boost::filesystem::remove(*fileName));
+        removeMergedFile.dismiss();
+
+        *fileName = mergedFileName;
+        *nextFileOffset = mergedFileOffset;
+        *iters = std::move(mergedIters);
+    }
+}
+
 template <typename Key, typename Value, typename Comparator>
 class NoLimitSorter : public Sorter<Key, Value> {
 public:
@@ -560,6 +751,8 @@ public:
         }
 
         spill();
+        mergeSpillsToFanIn<Key, Value, Comparator>(
+            _opts, _comp, _settings, &_fileName, &_nextSortedFileWriterOffset, &_iters);
         Iterator* mergeIt = Iterator::merge(_iters, _fileName, _opts, _comp);
         _done = true;
         return mergeIt;
@@ -766,6 +959,8 @@ public:
         }
 
         spill();
+        mergeSpillsToFanIn<Key, Value, Comparator>(
+            _opts, _comp, _settings, &_fileName, &_nextSortedFileWriterOffset, &_iters);
         Iterator* iterator = Iterator::merge(_iters, _fileName, _opts, _comp);
         _done = true;
         return iterator;
@@ -943,7 +1138,8 @@ SortedFileWriter<Key, Value>::SortedFileWriter(const SortOptions& opts,
                                                const std::string& fileName,
                                                const std::streampos fileStartOffset,
                                                const Settings& settings)
-    : _settings(settings) {
+    : _settings(settings),
+      _compressor(uassertStatusOK(parseSorterSpillCompressor(gSorterSpillCompressor))) {
 
     // This should be checked by consumers, but if we get here don't allow writes.
     uassert(
@@ -1002,10 +1198,27 @@ void SortedFileWriter<Key, Value>::spill() {
         return;
 
     std::string compressed;
-    snappy::Compress(outBuffer, size, &compressed);
+    switch (_compressor) {
+        case SorterSpillCompressor::kNone:
+            break;
+        case SorterSpillCompressor::kSnappy:
+            snappy::Compress(outBuffer, size, &compressed);
+            break;
+        case SorterSpillCompressor::kZstd: {
+            compressed.resize(ZSTD_compressBound(size));
+            const size_t ret = ZSTD_compress(
+                &compressed[0], compressed.size(), outBuffer, size, ZSTD_CLEVEL_DEFAULT);
+            uassert(5212004,
+                    str::stream() << "Failed to compress data: " << ZSTD_getErrorName(ret),
+                    !ZSTD_isError(ret));
+            compressed.resize(ret);
+            break;
+        }
+    }
     verify(compressed.size() <= size_t(std::numeric_limits<int32_t>::max()));
 
-    const bool shouldCompress = compressed.size() < size_t(_buffer.len() / 10 * 9);
+    const bool shouldCompress = _compressor != SorterSpillCompressor::kNone &&
+        compressed.size() < size_t(_buffer.len() / 10 * 9);
     if (shouldCompress) {
         size = compressed.size();
         outBuffer = const_cast<char*>(compressed.data());
@@ -1029,11 +1242,16 @@ void SortedFileWriter<Key, Value>::spill() {
         size = resultLen;
     }
 
-    // negative size means compressed
-    size = shouldCompress ? -size : size;
+    SortedFileBlockHeader header;
+    header.size = size;
+    header.compressor = static_cast<uint8_t>(shouldCompress ? _compressor
+                                                            : SorterSpillCompressor::kNone);
+    header.checksum = addDataToChecksum(outBuffer, size, 0);
     try {
-        _file.write(reinterpret_cast<const char*>(&size), sizeof(size));
-        _file.write(outBuffer, std::abs(size));
+        _file.write(reinterpret_cast<const char*>(&header.size), sizeof(header.size));
+        _file.write(reinterpret_cast<const char*>(&header.compressor), sizeof(header.compressor));
+        _file.write(reinterpret_cast<const char*>(&header.checksum), sizeof(header.checksum));
+        _file.write(outBuffer, size);
     } catch (const std::exception&) {
         msgasserted(16821,
                     str::stream() << "error writing to file \"" << _fileName
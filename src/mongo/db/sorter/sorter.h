@@ -39,6 +39,7 @@
 #include <vector>
 
 #include "mongo/bson/util/builder.h"
+#include "mongo/db/sorter/sorter_spill_compressor.h"
 #include "mongo/util/bufreader.h"
 
 /**
@@ -285,6 +286,9 @@ private:
     std::ofstream _file;
     BufBuilder _buffer;
 
+    // Compressor applied to each block spilled, from the 'sorterSpillCompressor' parameter.
+    const SorterSpillCompressor _compressor;
+
     // Keeps track of the hash of all data objects spilled to disk. Passed to the FileIterator
     // to ensure data has not been corrupted after reading from disk.
     uint32_t _checksum = 0;
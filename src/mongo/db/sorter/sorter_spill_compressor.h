@@ -0,0 +1,70 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+/**
+ * Block compressors for the files written by SortedFileWriter. The numeric values are written to
+ * disk in each block header, so they must not change.
+ */
+enum class SorterSpillCompressor : uint8_t {
+    kNone = 0,
+    kSnappy = 1,
+    kZstd = 2,
+};
+
+inline StatusWith<SorterSpillCompressor> parseSorterSpillCompressor(StringData name) {
+    if (name == "none"_sd) {
+        return SorterSpillCompressor::kNone;
+    }
+    if (name == "snappy"_sd) {
+        return SorterSpillCompressor::kSnappy;
+    }
+    if (name == "zstd"_sd) {
+        return SorterSpillCompressor::kZstd;
+    }
+    return {ErrorCodes::BadValue,
+            str::stream() << "Unknown sorter spill compressor '" << name
+                          << "', expected one of 'none', 'snappy' or 'zstd'"};
+}
+
+inline Status validateSorterSpillCompressor(const std::string& name) {
+    return parseSorterSpillCompressor(name).getStatus();
+}
+
+}  // namespace mongo
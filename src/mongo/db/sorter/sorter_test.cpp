@@ -40,10 +40,12 @@
 #include "mongo/base/static_assert.h"
 #include "mongo/config.h"
 #include "mongo/db/service_context_test_fixture.h"
+#include "mongo/db/sorter/sorter_server_parameters_gen.h"
 #include "mongo/platform/random.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 #include "mongo/logv2/log.h"
@@ -314,6 +316,67 @@ public:
     }
 };
 
+class SpillCompressorAndReadAheadTests : public ScopedGlobalServiceContextForTest {
+public:
+    void run() {
+        const std::string oldCompressor = gSorterSpillCompressor;
+        const int oldReadAheadBytes = gSorterFileReadAheadBytes.load();
+        ON_BLOCK_EXIT([&] {
+            gSorterSpillCompressor = oldCompressor;
+            gSorterFileReadAheadBytes.store(oldReadAheadBytes);
+        });
+
+        unittest::TempDir tempDir("sortedFileWriterCompressorTests");
+        const SortOptions opts = SortOptions().TempDir(tempDir.path());
+        const int numItems = 200 * 1000;
+
+        for (auto&& compressor : {"none", "snappy", "zstd"}) {
+            // Read-ahead buffers smaller than, close to and larger than a block.
+            for (int readAheadBytes : {0, 100, 64 * 1024, 1024 * 1024}) {
+                gSorterSpillCompressor = compressor;
+                gSorterFileReadAheadBytes.store(readAheadBytes);
+
+                std::string fileName = opts.tempDir + "/" + nextFileName();
+                SortedFileWriter<IntWrapper, IntWrapper> sorter(opts, fileName, 0);
+                for (int i = 0; i < numItems; i++)
+                    sorter.addAlreadySorted(i, -i);
+
+                ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter.done()),
+                                            make_shared<IntIterator>(0, numItems));
+
+                ASSERT_TRUE(boost::filesystem::remove(fileName));
+            }
+        }
+
+        {  // corrupted block
+            gSorterSpillCompressor = "none";
+            std::string fileName = opts.tempDir + "/" + nextFileName();
+            SortedFileWriter<IntWrapper, IntWrapper> sorter(opts, fileName, 0);
+            for (int i = 0; i < 10; i++)
+                sorter.addAlreadySorted(i, -i);
+            std::shared_ptr<IWIterator> iter(sorter.done());
+
+            // Flip a bit in the last byte of the only block.
+            {
+                std::fstream file(fileName, std::ios::in | std::ios::out | std::ios::binary);
+                file.seekg(-1, std::ios::end);
+                char last = file.get();
+                file.seekp(-1, std::ios::end);
+                file.put(last ^ 1);
+            }
+
+            iter->openSource();
+            ASSERT_THROWS_CODE(iter->more(), AssertionException, ErrorCodes::ChecksumMismatch);
+            iter->closeSource();
+            iter.reset();
+
+            ASSERT_TRUE(boost::filesystem::remove(fileName));
+        }
+
+        ASSERT(boost::filesystem::is_empty(tempDir.path()));
+    }
+};
+
 
 class MergeIteratorTests {
 public:
@@ -368,6 +431,19 @@ public:
                 mergeIterators(iterators, ASC, SortOptions().Limit(10)),
                 make_shared<LimitIterator>(10, make_shared<IntIterator>(0, 20, 1)));
         }
+        {  // test a number of sources that is not a power of two, exhausted at different times
+            std::shared_ptr<IWIterator> iterators[] = {
+                make_shared<IntIterator>(0, 1000, 5),  // 0, 5, ... 995
+                make_shared<IntIterator>(1, 1000, 5),  // 1, 6, ... 996
+                make_shared<IntIterator>(2, 1000, 5),  // 2, 7, ... 997
+                make_shared<IntIterator>(3, 1000, 5),  // 3, 8, ... 998
+                make_shared<IntIterator>(4, 1000, 5),  // 4, 9, ... 999
+                make_shared<IntIterator>(1000, 1010),  // 1000, 1001, ... 1009
+                make_shared<EmptyIterator>()};
+
+            ASSERT_ITERATORS_EQUIVALENT(mergeIterators(iterators, ASC),
+                                        make_shared<IntIterator>(0, 1010));
+        }
     }
 };
 
@@ -581,6 +657,20 @@ class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     }
     enum { MEM_LIMIT = 32 * 1024 };
 };
+
+// Runs the Parent test with a merge fan-in small enough that the spilled runs go through several
+// levels of intermediate merges before the final one.
+template <typename Parent>
+class SmallMergeFanIn : public Parent {
+public:
+    void run() {
+        const int oldMaxMergeFanIn = gSorterMaxMergeFanIn.load();
+        ON_BLOCK_EXIT([&] { gSorterMaxMergeFanIn.store(oldMaxMergeFanIn); });
+        gSorterMaxMergeFanIn.store(3);
+
+        Parent::run();
+    }
+};
 }  // namespace SorterTests
 
 class SorterSuite : public mongo::unittest::OldStyleSuiteSpecification {
@@ -593,6 +683,7 @@ public:
     void setupTests() override {
         add<InMemIterTests>();
         add<SortedFileWriterAndFileIteratorTests>();
+        add<SpillCompressorAndReadAheadTests>();
         add<MergeIteratorTests>();
         add<SorterTests::Basic>();
         add<SorterTests::Limit>();
@@ -605,6 +696,9 @@ public:
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/true>>();    // fits in mem
         add<SorterTests::LotsOfDataWithLimit<5000, /*random=*/false>>();  // spills
         add<SorterTests::LotsOfDataWithLimit<5000, /*random=*/true>>();   // spills
+        add<SorterTests::SmallMergeFanIn<SorterTests::LotsOfDataLittleMemory</*random=*/true>>>();
+        add<SorterTests::SmallMergeFanIn<
+            SorterTests::LotsOfDataWithLimit<5000, /*random=*/true>>>();
         add<SorterTests::LimitExtreme<kMaxAsU64<uint32_t>>>();
         add<SorterTests::LimitExtreme<kMaxAsU64<uint32_t> - 1>>();
         add<SorterTests::LimitExtreme<kMaxAsU64<uint32_t> + 1>>();
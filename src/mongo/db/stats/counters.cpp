@@ -67,27 +67,27 @@ void OpCounters::gotOp(int op, bool isCommand) {
     }
 }
 
-void OpCounters::_checkWrap(CacheAligned<AtomicWord<long long>> OpCounters::*counter, int n) {
+void OpCounters::_checkWrap(ShardedCounter OpCounters::*counter, int n) {
     static constexpr auto maxCount = 1LL << 60;
-    auto oldValue = (this->*counter).fetchAndAddRelaxed(n);
+    auto oldValue = (this->*counter).add(n);
     if (oldValue > maxCount) {
-        _insert.store(0);
-        _query.store(0);
-        _update.store(0);
-        _delete.store(0);
-        _getmore.store(0);
-        _command.store(0);
+        _insert.reset();
+        _query.reset();
+        _update.reset();
+        _delete.reset();
+        _getmore.reset();
+        _command.reset();
     }
 }
 
 BSONObj OpCounters::getObj() const {
     BSONObjBuilder b;
-    b.append("insert", _insert.loadRelaxed());
-    b.append("query", _query.loadRelaxed());
-    b.append("update", _update.loadRelaxed());
-    b.append("delete", _delete.loadRelaxed());
-    b.append("getmore", _getmore.loadRelaxed());
-    b.append("command", _command.loadRelaxed());
+    b.append("insert", _insert.get());
+    b.append("query", _query.get());
+    b.append("update", _update.get());
+    b.append("delete", _delete.get());
+    b.append("getmore", _getmore.get());
+    b.append("command", _command.get());
     return b.obj();
 }
 
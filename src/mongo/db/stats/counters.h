@@ -38,6 +38,7 @@
 #include "mongo/rpc/message.h"
 #include "mongo/util/concurrency/spin_lock.h"
 #include "mongo/util/processinfo.h"
+#include "mongo/util/sharded_counter.h"
 #include "mongo/util/string_map.h"
 #include "mongo/util/with_alignment.h"
 
@@ -45,7 +46,8 @@ namespace mongo {
 
 /**
  * for storing operation counters
- * note: not thread safe.  ok with that for speed
+ * Each counter is sharded per CPU, so that counting an operation does not touch a cache line
+ * shared with other cores; reads sum the shards.
  */
 class OpCounters {
 public:
@@ -78,35 +80,35 @@ public:
     BSONObj getObj() const;
 
     // thse are used by snmp, and other things, do not remove
-    const AtomicWord<long long>* getInsert() const {
-        return &_insert;
+    long long getInsert() const {
+        return _insert.get();
     }
-    const AtomicWord<long long>* getQuery() const {
-        return &_query;
+    long long getQuery() const {
+        return _query.get();
     }
-    const AtomicWord<long long>* getUpdate() const {
-        return &_update;
+    long long getUpdate() const {
+        return _update.get();
     }
-    const AtomicWord<long long>* getDelete() const {
-        return &_delete;
+    long long getDelete() const {
+        return _delete.get();
     }
-    const AtomicWord<long long>* getGetMore() const {
-        return &_getmore;
+    long long getGetMore() const {
+        return _getmore.get();
     }
-    const AtomicWord<long long>* getCommand() const {
-        return &_command;
+    long long getCommand() const {
+        return _command.get();
     }
 
 private:
-    // Increment member `counter` by `n`, resetting all counters if it was > 2^60.
-    void _checkWrap(CacheAligned<AtomicWord<long long>> OpCounters::*counter, int n);
-
-    CacheAligned<AtomicWord<long long>> _insert;
-    CacheAligned<AtomicWord<long long>> _query;
-    CacheAligned<AtomicWord<long long>> _update;
-    CacheAligned<AtomicWord<long long>> _delete;
-    CacheAligned<AtomicWord<long long>> _getmore;
-    CacheAligned<AtomicWord<long long>> _command;
+    // Increment member `counter` by `n`, resetting all counters if its shard was > 2^60.
+    void _checkWrap(ShardedCounter OpCounters::*counter, int n);
+
+    ShardedCounter _insert;
+    ShardedCounter _query;
+    ShardedCounter _update;
+    ShardedCounter _delete;
+    ShardedCounter _getmore;
+    ShardedCounter _command;
 };
 
 extern OpCounters globalOpCounters;
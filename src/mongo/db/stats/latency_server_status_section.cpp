@@ -50,11 +50,15 @@ public:
     BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElem) const override {
         BSONObjBuilder latencyBuilder;
         bool includeHistograms = false;
+        std::vector<double> percentiles;
         if (configElem.type() == BSONType::Object) {
             includeHistograms = configElem.Obj()["histograms"].trueValue();
+            if (auto percentilesElem = configElem.Obj()["percentiles"]) {
+                percentiles = OperationLatencyHistogram::parsePercentiles(percentilesElem);
+            }
         }
         Top::get(opCtx->getServiceContext())
-            .appendGlobalLatencyStats(includeHistograms, &latencyBuilder);
+            .appendGlobalLatencyStats(includeHistograms, percentiles, &latencyBuilder);
         return latencyBuilder.obj();
     }
 } globalHistogramServerStatusSection;
@@ -33,6 +33,8 @@
 
 #include "mongo/db/client.h"
 #include "mongo/db/commands/server_status.h"
+#include "mongo/db/concurrency/lock_manager.h"
+#include "mongo/db/concurrency/lock_state.h"
 #include "mongo/db/concurrency/lock_stats.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
@@ -121,6 +123,7 @@ public:
         reportGlobalLockingStats(&stats);
 
         stats.report(&ret);
+        getGlobalLockManager()->appendPartitionStats(&ret);
 
         return ret.obj();
     }
@@ -32,10 +32,12 @@
 #include "mongo/db/stats/operation_latency_histogram.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/platform/bits.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 
@@ -92,34 +94,111 @@ const std::array<uint64_t, OperationLatencyHistogram::kMaxBuckets>
                                                549755813888,
                                                1099511627776};
 
+std::vector<double> OperationLatencyHistogram::parsePercentiles(const BSONElement& elem) {
+    uassert(5212028,
+            str::stream() << "percentiles option to latency statistics must be an array, got "
+                          << elem,
+            elem.type() == BSONType::Array);
+    std::vector<double> percentiles;
+    for (auto&& percentile : elem.Obj()) {
+        uassert(5212029,
+                str::stream() << "percentiles must be numbers greater than 0 and at most 100, got "
+                              << percentile,
+                percentile.isNumber() && percentile.numberDouble() > 0 &&
+                    percentile.numberDouble() <= 100);
+        percentiles.push_back(percentile.numberDouble());
+    }
+    return percentiles;
+}
+
 void OperationLatencyHistogram::_append(const HistogramData& data,
                                         const char* key,
                                         bool includeHistograms,
+                                        const std::vector<double>& percentiles,
                                         BSONObjBuilder* builder) const {
 
     BSONObjBuilder histogramBuilder(builder->subobjStart(key));
     if (includeHistograms) {
+        // Every fine bucket lies within a single reported bucket, so the reported counts are
+        // sums of consecutive fine buckets.
+        std::array<uint64_t, kMaxBuckets> buckets{};
+        for (int i = 0; i < kNumFineBuckets; i++) {
+            buckets[_getBucket(_getFineBucketLowerBound(i))] += data.buckets[i];
+        }
+
         BSONArrayBuilder arrayBuilder(histogramBuilder.subarrayStart("histogram"));
         for (int i = 0; i < kMaxBuckets; i++) {
-            if (data.buckets[i] == 0)
+            if (buckets[i] == 0)
                 continue;
             BSONObjBuilder entryBuilder(arrayBuilder.subobjStart());
             entryBuilder.append("micros", static_cast<long long>(kLowerBounds[i]));
-            entryBuilder.append("count", static_cast<long long>(data.buckets[i]));
+            entryBuilder.append("count", static_cast<long long>(buckets[i]));
             entryBuilder.doneFast();
         }
         arrayBuilder.doneFast();
     }
     histogramBuilder.append("latency", static_cast<long long>(data.sum));
     histogramBuilder.append("ops", static_cast<long long>(data.entryCount));
+    if (!percentiles.empty()) {
+        BSONArrayBuilder arrayBuilder(histogramBuilder.subarrayStart("percentiles"));
+        if (data.entryCount > 0) {
+            for (auto percentile : percentiles) {
+                BSONObjBuilder entryBuilder(arrayBuilder.subobjStart());
+                entryBuilder.append("percentile", percentile);
+                entryBuilder.append("micros",
+                                    static_cast<long long>(_getPercentile(data, percentile)));
+                entryBuilder.doneFast();
+            }
+        }
+        arrayBuilder.doneFast();
+    }
     histogramBuilder.doneFast();
 }
 
-void OperationLatencyHistogram::append(bool includeHistograms, BSONObjBuilder* builder) const {
-    _append(_reads, "reads", includeHistograms, builder);
-    _append(_writes, "writes", includeHistograms, builder);
-    _append(_commands, "commands", includeHistograms, builder);
-    _append(_transactions, "transactions", includeHistograms, builder);
+void OperationLatencyHistogram::append(bool includeHistograms,
+                                       const std::vector<double>& percentiles,
+                                       BSONObjBuilder* builder) const {
+    _append(_reads, "reads", includeHistograms, percentiles, builder);
+    _append(_writes, "writes", includeHistograms, percentiles, builder);
+    _append(_commands, "commands", includeHistograms, percentiles, builder);
+    _append(_transactions, "transactions", includeHistograms, percentiles, builder);
+}
+
+// Latencies below kSubBuckets have a bucket each. Above that, the bucket is picked by the position
+// of the highest set bit and the kSubBucketBits bits below it.
+int OperationLatencyHistogram::_getFineBucket(uint64_t value) {
+    if (value < static_cast<uint64_t>(kSubBuckets)) {
+        return static_cast<int>(value);
+    }
+
+    int log2 = 63 - countLeadingZeros64(value);
+    if (log2 > kMaxLog2) {
+        return kNumFineBuckets - 1;
+    }
+    int subBucket = static_cast<int>(value >> (log2 - kSubBucketBits)) & (kSubBuckets - 1);
+    return kSubBuckets * (log2 - kSubBucketBits + 1) + subBucket;
+}
+
+uint64_t OperationLatencyHistogram::_getFineBucketLowerBound(int fineBucket) {
+    if (fineBucket < kSubBuckets) {
+        return fineBucket;
+    }
+    int log2 = fineBucket / kSubBuckets + kSubBucketBits - 1;
+    uint64_t subBucket = fineBucket % kSubBuckets;
+    return (kSubBuckets + subBucket) << (log2 - kSubBucketBits);
+}
+
+uint64_t OperationLatencyHistogram::_getPercentile(const HistogramData& data, double percentile) {
+    const auto rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(percentile / 100 * data.entryCount)));
+    uint64_t seen = 0;
+    for (int i = 0; i < kNumFineBuckets - 1; i++) {
+        seen += data.buckets[i];
+        if (seen >= rank) {
+            return _getFineBucketLowerBound(i + 1) - 1;
+        }
+    }
+    return _getFineBucketLowerBound(kNumFineBuckets - 1);
 }
 
 // Computes the log base 2 of value, and checks for cases of split buckets.
@@ -155,8 +234,23 @@ void OperationLatencyHistogram::_incrementData(uint64_t latency, int bucket, His
     data->sum += latency;
 }
 
+void OperationLatencyHistogram::_mergeData(const HistogramData& other, HistogramData* data) {
+    for (int i = 0; i < kNumFineBuckets; ++i) {
+        data->buckets[i] += other.buckets[i];
+    }
+    data->entryCount += other.entryCount;
+    data->sum += other.sum;
+}
+
+void OperationLatencyHistogram::merge(const OperationLatencyHistogram& other) {
+    _mergeData(other._reads, &_reads);
+    _mergeData(other._writes, &_writes);
+    _mergeData(other._commands, &_commands);
+    _mergeData(other._transactions, &_transactions);
+}
+
 void OperationLatencyHistogram::increment(uint64_t latency, Command::ReadWriteType type) {
-    int bucket = _getBucket(latency);
+    int bucket = _getFineBucket(latency);
     switch (type) {
         case Command::ReadWriteType::kRead:
             _incrementData(latency, bucket, &_reads);
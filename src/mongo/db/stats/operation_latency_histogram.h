@@ -29,6 +29,7 @@
 #pragma once
 
 #include <array>
+#include <vector>
 
 #include "mongo/db/commands.h"
 
@@ -40,6 +41,10 @@ class BSONObjBuilder;
  * Stores statistics for latencies of read, write, command, and multi-document transaction
  * operations.
  *
+ * Latencies are counted in HDR-style log-linear buckets: each power of two is split into
+ * kSubBuckets linear sub-buckets, so a percentile is reported within 1 / kSubBuckets of its
+ * value. The coarser reported histogram is derived from these buckets.
+ *
  * Note: This class is not thread-safe.
  */
 class OperationLatencyHistogram {
@@ -49,19 +54,43 @@ public:
     // Inclusive lower bounds of the histogram buckets.
     static const std::array<uint64_t, kMaxBuckets> kLowerBounds;
 
+    static const int kSubBucketBits = 2;
+    static const int kSubBuckets = 1 << kSubBucketBits;
+
+    // Latencies of 2^41 micros and more share the last bucket.
+    static const int kMaxLog2 = 40;
+    static const int kNumFineBuckets = kSubBuckets * kMaxLog2;
+
+    /**
+     * Parses the 'percentiles' option of latency statistics: an array of numbers in (0, 100].
+     * Throws if 'elem' is not such an array.
+     */
+    static std::vector<double> parsePercentiles(const BSONElement& elem);
+
     /**
      * Increments the bucket of the histogram based on the operation type.
      */
     void increment(uint64_t latency, Command::ReadWriteType type);
 
     /**
-     * Appends the four histograms with latency totals and operation counts.
+     * Adds the counts of 'other' to this histogram.
      */
-    void append(bool includeHistograms, BSONObjBuilder* builder) const;
+    void merge(const OperationLatencyHistogram& other);
+
+    /**
+     * Appends the four histograms with latency totals and operation counts, and the latency at
+     * each of 'percentiles'.
+     */
+    void append(bool includeHistograms,
+                const std::vector<double>& percentiles,
+                BSONObjBuilder* builder) const;
+    void append(bool includeHistograms, BSONObjBuilder* builder) const {
+        append(includeHistograms, {}, builder);
+    }
 
 private:
     struct HistogramData {
-        std::array<uint64_t, kMaxBuckets> buckets{};
+        std::array<uint64_t, kNumFineBuckets> buckets{};
         uint64_t entryCount = 0;
         uint64_t sum = 0;
     };
@@ -70,13 +99,26 @@ private:
 
     static uint64_t _getBucketMicros(int bucket);
 
+    static int _getFineBucket(uint64_t latency);
+
+    static uint64_t _getFineBucketLowerBound(int fineBucket);
+
+    /**
+     * Returns the latency below which 'percentile' percent of the operations in 'data' fall, as
+     * the highest latency counted in the same fine bucket.
+     */
+    static uint64_t _getPercentile(const HistogramData& data, double percentile);
+
     void _append(const HistogramData& data,
                  const char* key,
                  bool includeHistograms,
+                 const std::vector<double>& percentiles,
                  BSONObjBuilder* builder) const;
 
     void _incrementData(uint64_t latency, int bucket, HistogramData* data);
 
+    static void _mergeData(const HistogramData& other, HistogramData* data);
+
     HistogramData _reads, _writes, _commands, _transactions;
 };
 }  // namespace mongo
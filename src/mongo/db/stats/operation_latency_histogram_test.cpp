@@ -92,4 +92,65 @@ TEST(OperationLatencyHistogram, CheckBucketCountsAndTotalLatency) {
         ASSERT_EQUALS(bucket["count"].Long(), (i < kMaxBuckets - 1) ? 3 : 2);
     }
 }
+
+TEST(OperationLatencyHistogram, MergeAddsCounts) {
+    OperationLatencyHistogram hist, other;
+    hist.increment(10, Command::ReadWriteType::kRead);
+    other.increment(20, Command::ReadWriteType::kRead);
+    other.increment(5000, Command::ReadWriteType::kWrite);
+    hist.merge(other);
+
+    BSONObjBuilder outBuilder;
+    hist.append(false, &outBuilder);
+    BSONObj out = outBuilder.done();
+    ASSERT_EQUALS(out["reads"]["ops"].Long(), 2);
+    ASSERT_EQUALS(out["reads"]["latency"].Long(), 30);
+    ASSERT_EQUALS(out["writes"]["ops"].Long(), 1);
+    ASSERT_EQUALS(out["writes"]["latency"].Long(), 5000);
+    ASSERT_EQUALS(out["commands"]["ops"].Long(), 0);
+}
+
+TEST(OperationLatencyHistogram, Percentiles) {
+    OperationLatencyHistogram hist;
+    for (uint64_t latency = 1; latency <= 1000; latency++) {
+        hist.increment(latency, Command::ReadWriteType::kRead);
+    }
+    hist.increment(1000000, Command::ReadWriteType::kRead);
+
+    BSONObjBuilder outBuilder;
+    hist.append(false, {1, 50, 99, 100}, &outBuilder);
+    BSONObj out = outBuilder.done();
+    ASSERT_FALSE(out["reads"].Obj().hasField("histogram"));
+    std::vector<BSONElement> percentiles = out["reads"]["percentiles"].Array();
+    ASSERT_EQUALS(percentiles.size(), 4U);
+
+    // Each reported value is within a quarter of the exact one, and never below it.
+    std::vector<std::pair<double, long long>> expected = {
+        {1, 11}, {50, 501}, {99, 991}, {100, 1000000}};
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_EQUALS(percentiles[i]["percentile"].Double(), expected[i].first);
+        auto micros = percentiles[i]["micros"].Long();
+        ASSERT_GTE(micros, expected[i].second);
+        ASSERT_LTE(micros, expected[i].second + expected[i].second / 4);
+    }
+
+    // Types without operations report no percentiles.
+    ASSERT_EQUALS(out["writes"]["percentiles"].Array().size(), 0U);
+}
+
+TEST(OperationLatencyHistogram, ParsePercentiles) {
+    auto percentiles =
+        OperationLatencyHistogram::parsePercentiles(BSON("p" << BSON_ARRAY(50 << 99.9))["p"]);
+    ASSERT_EQUALS(percentiles.size(), 2U);
+    ASSERT_EQUALS(percentiles[0], 50);
+    ASSERT_EQUALS(percentiles[1], 99.9);
+
+    ASSERT_THROWS_CODE(OperationLatencyHistogram::parsePercentiles(BSON("p" << 50)["p"]),
+                       AssertionException,
+                       5212028);
+    ASSERT_THROWS_CODE(
+        OperationLatencyHistogram::parsePercentiles(BSON("p" << BSON_ARRAY(101))["p"]),
+        AssertionException,
+        5212029);
+}
 }  // namespace mongo
@@ -0,0 +1,385 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/operation_stack_sampler.h"
+
+#include <array>
+
+#include "mongo/db/client.h"
+#include "mongo/db/commands/server_status.h"
+#include "mongo/db/stats/operation_stack_sampler_gen.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/stacktrace.h"
+
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+#include <signal.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace mongo {
+namespace {
+
+const auto getOperationStackSampler = ServiceContext::declareDecoration<OperationStackSampler>();
+
+// How long a sampling round waits for the signalled threads to capture their stacks.
+const Milliseconds kCaptureTimeout{10};
+
+// Frames beyond this depth, typically the outermost ones, are not sampled.
+const std::size_t kMaxFrames = 64;
+
+// The sampler moves a slot from kIdle to kRequested before signalling its thread. The thread's
+// handler moves it to kCapturing while writing the sample and then to kCaptured. The sampler
+// consumes the sample and moves the slot back to kIdle, or, when the thread doesn't respond in
+// time, takes the request back by moving it from kRequested to kIdle.
+enum SlotState : int { kIdle, kRequested, kCapturing, kCaptured };
+
+/**
+ * The sampling state of one thread. Fields other than the atomics are written by the thread's
+ * signal handler while the slot is kCapturing and read by the sampler once it is kCaptured.
+ */
+struct ThreadSlot {
+    long tid = 0;
+
+    // The command of the thread's active operation, or null while it has none.
+    AtomicWord<const std::string*> command{nullptr};
+    AtomicWord<bool> hasQueryHash{false};
+    AtomicWord<std::uint32_t> queryHash{0};
+
+    AtomicWord<int> state{kIdle};
+    std::array<void*, kMaxFrames> frames;
+    std::size_t numFrames = 0;
+    const std::string* sampledCommand = nullptr;
+    boost::optional<std::uint32_t> sampledQueryHash;
+};
+
+/**
+ * The slots of every thread that has run an operation. A thread's slot is registered on its first
+ * operation and deregistered when the thread exits.
+ */
+class SlotRegistry {
+public:
+    void add(std::shared_ptr<ThreadSlot> slot) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _slots.push_back(std::move(slot));
+    }
+
+    void remove(const ThreadSlot* slot) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _slots.erase(std::remove_if(_slots.begin(),
+                                    _slots.end(),
+                                    [&](const auto& other) { return other.get() == slot; }),
+                     _slots.end());
+    }
+
+    std::vector<std::shared_ptr<ThreadSlot>> getActive() const {
+        stdx::lock_guard<Latch> lk(_mutex);
+        std::vector<std::shared_ptr<ThreadSlot>> active;
+        for (auto&& slot : _slots) {
+            if (slot->command.load()) {
+                active.push_back(slot);
+            }
+        }
+        return active;
+    }
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("OperationStackSampler::SlotRegistry::_mutex");
+    std::vector<std::shared_ptr<ThreadSlot>> _slots;
+};
+
+SlotRegistry slotRegistry;
+
+// The calling thread's slot, if it has one. Read by the signal handler, which must not construct
+// the slot.
+thread_local ThreadSlot* threadSlot = nullptr;
+
+/**
+ * Owns the calling thread's slot, registering it on first use.
+ */
+struct ThreadSlotHolder {
+    ~ThreadSlotHolder() {
+        threadSlot = nullptr;
+        if (slot) {
+            slotRegistry.remove(slot.get());
+        }
+    }
+
+    ThreadSlot* get() {
+        if (!slot) {
+            slot = std::make_shared<ThreadSlot>();
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+            slot->tid = syscall(SYS_gettid);
+#endif
+            slotRegistry.add(slot);
+        }
+        return slot.get();
+    }
+
+    std::shared_ptr<ThreadSlot> slot;
+};
+
+thread_local ThreadSlotHolder threadSlotHolder;
+
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+
+const int kSampleSignal = SIGPROF;
+
+void sampleSignalHandler(int, siginfo_t* info, void*) {
+    // Ignore SIGPROF that the sampler didn't send.
+    if (info->si_code != SI_TKILL || info->si_pid != getpid()) {
+        return;
+    }
+
+    auto slot = threadSlot;
+    int expected = kRequested;
+    if (!slot || !slot->state.compareAndSwap(&expected, kCapturing)) {
+        return;
+    }
+
+    const int savedErrno = errno;
+    slot->numFrames = rawBacktrace(slot->frames.data(), slot->frames.size());
+    slot->sampledCommand = slot->command.load();
+    slot->sampledQueryHash = boost::none;
+    if (slot->hasQueryHash.load()) {
+        slot->sampledQueryHash = slot->queryHash.load();
+    }
+    slot->state.store(kCaptured);
+    errno = savedErrno;
+}
+
+bool installSampleSignalHandler() {
+    struct sigaction action = {};
+    action.sa_sigaction = &sampleSignalHandler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(kSampleSignal, &action, nullptr) != 0) {
+        LOGV2_WARNING(5212031,
+                      "Failed to install the operation stack sampling signal handler",
+                      "error"_attr = errnoWithDescription());
+        return false;
+    }
+    return true;
+}
+
+#endif  // defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+
+}  // namespace
+
+OperationStackSampler::ActiveOperation::ActiveOperation(const std::string& commandName) {
+    auto slot = threadSlotHolder.get();
+    threadSlot = slot;
+    _previousCommand = slot->command.load();
+    if (slot->hasQueryHash.load()) {
+        _previousQueryHash = slot->queryHash.load();
+    }
+    slot->hasQueryHash.store(false);
+    slot->command.store(&commandName);
+}
+
+OperationStackSampler::ActiveOperation::~ActiveOperation() {
+    // Restore the tags of the operation that a nested operation ran within.
+    if (_previousQueryHash) {
+        threadSlot->queryHash.store(*_previousQueryHash);
+    }
+    threadSlot->hasQueryHash.store(_previousQueryHash.has_value());
+    threadSlot->command.store(_previousCommand);
+}
+
+OperationStackSampler* OperationStackSampler::get(ServiceContext* service) {
+    return &getOperationStackSampler(service);
+}
+
+void OperationStackSampler::setQueryHash(std::uint32_t queryHash) {
+    if (auto slot = threadSlot; slot && slot->command.load()) {
+        slot->queryHash.store(queryHash);
+        slot->hasQueryHash.store(true);
+    }
+}
+
+void OperationStackSampler::start(ServiceContext* service) {
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+    // While sampling is off, the job still runs once a second to notice that it was turned on.
+    const auto interval = gOperationStackSamplingIntervalMillis.load();
+    PeriodicRunner::PeriodicJob job("OperationStackSampler",
+                                    [this](Client*) {
+                                        if (gOperationStackSamplingIntervalMillis.load() > 0) {
+                                            takeSamples();
+                                        }
+                                    },
+                                    interval > 0 ? Milliseconds(interval) : Milliseconds(1000));
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    invariant(!_anchor);
+    _anchor = std::make_shared<PeriodicJobAnchor>(
+        service->getPeriodicRunner()->makeJob(std::move(job)));
+    _anchor->start();
+#endif
+}
+
+void OperationStackSampler::setInterval(Milliseconds interval) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_anchor) {
+        _anchor->setPeriod(interval > Milliseconds(0) ? interval : Milliseconds(1000));
+    }
+}
+
+void OperationStackSampler::takeSamples() {
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+    static const bool handlerInstalled = installSampleSignalHandler();
+    if (!handlerInstalled) {
+        return;
+    }
+
+    auto slots = slotRegistry.getActive();
+    if (slots.empty()) {
+        return;
+    }
+
+    const pid_t pid = getpid();
+    std::vector<ThreadSlot*> requested;
+    for (auto&& slot : slots) {
+        slot->state.store(kRequested);
+        if (syscall(SYS_tgkill, pid, slot->tid, kSampleSignal) == 0) {
+            requested.push_back(slot.get());
+        } else {
+            slot->state.store(kIdle);
+        }
+    }
+
+    std::vector<ThreadSlot*> captured;
+    const auto deadline = Date_t::now() + kCaptureTimeout;
+    long long numMissed = 0;
+    while (!requested.empty()) {
+        auto it = std::partition(requested.begin(), requested.end(), [](ThreadSlot* slot) {
+            return slot->state.load() != kCaptured;
+        });
+        captured.insert(captured.end(), it, requested.end());
+        requested.erase(it, requested.end());
+        if (requested.empty()) {
+            break;
+        }
+
+        if (Date_t::now() >= deadline) {
+            // Take back the requests that weren't picked up. A handler that already started
+            // capturing finishes promptly and is accounted for on the next pass.
+            auto capturing = std::partition(requested.begin(), requested.end(), [](auto slot) {
+                int expected = kRequested;
+                return slot->state.compareAndSwap(&expected, kIdle);
+            });
+            numMissed += capturing - requested.begin();
+            requested.erase(requested.begin(), capturing);
+        }
+        sleepmicros(100);
+    }
+
+    const auto maxStacks = static_cast<std::size_t>(gOperationStackSamplingMaxStacks.load());
+    stdx::lock_guard<Latch> lk(_mutex);
+    _numMissed += numMissed;
+    for (auto slot : captured) {
+        if (slot->sampledCommand) {
+            Key key{*slot->sampledCommand,
+                    slot->sampledQueryHash,
+                    std::vector<void*>(slot->frames.begin(),
+                                       slot->frames.begin() + slot->numFrames)};
+            auto it = _stacks.find(key);
+            if (it != _stacks.end()) {
+                ++it->second;
+                ++_numSamples;
+            } else if (_stacks.size() < maxStacks) {
+                _stacks.emplace(std::move(key), 1);
+                ++_numSamples;
+            } else {
+                ++_numDropped;
+            }
+        }
+        slot->state.store(kIdle);
+    }
+#endif
+}
+
+std::vector<OperationStackSampler::StackSamples> OperationStackSampler::getSamples() const {
+    std::vector<StackSamples> samples;
+    stdx::lock_guard<Latch> lk(_mutex);
+    samples.reserve(_stacks.size());
+    for (auto&& [key, count] : _stacks) {
+        samples.push_back({std::get<0>(key), std::get<1>(key), std::get<2>(key), count});
+    }
+    return samples;
+}
+
+void OperationStackSampler::reset() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _stacks.clear();
+    _numSamples = 0;
+    _numMissed = 0;
+    _numDropped = 0;
+}
+
+void OperationStackSampler::appendStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    builder->append("samples", _numSamples);
+    builder->append("missedSamples", _numMissed);
+    builder->append("droppedSamples", _numDropped);
+    builder->append("stacks", static_cast<long long>(_stacks.size()));
+}
+
+namespace {
+
+class OperationStackSamplingServerStatusSection final : public ServerStatusSection {
+public:
+    OperationStackSamplingServerStatusSection() : ServerStatusSection("operationStackSampling") {}
+
+    bool includeByDefault() const override {
+        return gOperationStackSamplingIntervalMillis.load() > 0;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElem) const override {
+        BSONObjBuilder builder;
+        OperationStackSampler::get(opCtx->getServiceContext())->appendStats(&builder);
+        return builder.obj();
+    }
+} operationStackSamplingServerStatusSection;
+
+}  // namespace
+
+Status onUpdateOperationStackSamplingInterval(const int& newValue) {
+    if (hasGlobalServiceContext()) {
+        OperationStackSampler::get(getGlobalServiceContext())->setInterval(Milliseconds(newValue));
+    }
+    return Status::OK();
+}
+
+}  // namespace mongo
@@ -0,0 +1,144 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "mongo/base/status.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/periodic_runner.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+/**
+ * Continuously samples the stacks of threads that are running operations and aggregates the
+ * samples in memory by command, query shape hash and stack. The aggregate is served by the
+ * $operationStackSamples aggregation stage.
+ *
+ * Every operationStackSamplingIntervalMillis, the sampler sends SIGPROF to each thread with an
+ * active operation. The thread's handler captures a raw backtrace into a per-thread slot, and the
+ * sampler aggregates it; symbolizing is left to the reader of the samples. The threads are sampled
+ * whether or not they are on a CPU, so the samples also show where operations wait.
+ *
+ * Capturing a backtrace from a signal handler requires an async-signal-safe unwinder, so samples
+ * are only taken where MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS is defined.
+ */
+class OperationStackSampler {
+public:
+    /**
+     * Marks the calling thread as running an operation for the command named `commandName`, which
+     * must outlive this object, while this object is in scope.
+     */
+    class ActiveOperation {
+        ActiveOperation(const ActiveOperation&) = delete;
+        ActiveOperation& operator=(const ActiveOperation&) = delete;
+
+    public:
+        explicit ActiveOperation(const std::string& commandName);
+        ~ActiveOperation();
+
+    private:
+        const std::string* _previousCommand;
+        boost::optional<std::uint32_t> _previousQueryHash;
+    };
+
+    /**
+     * The number of samples of one stack taken while running one command and query shape.
+     */
+    struct StackSamples {
+        std::string command;
+        boost::optional<std::uint32_t> queryHash;
+        std::vector<void*> frames;
+        long long count;
+    };
+
+    static OperationStackSampler* get(ServiceContext* service);
+
+    /**
+     * Tags the samples of the calling thread's active operation with `queryHash`. Does nothing if
+     * the thread has no active operation.
+     */
+    static void setQueryHash(std::uint32_t queryHash);
+
+    /**
+     * Starts the job that takes samples. Called once, at startup.
+     */
+    void start(ServiceContext* service);
+
+    /**
+     * Applies a new operationStackSamplingIntervalMillis to the sampling job.
+     */
+    void setInterval(Milliseconds interval);
+
+    /**
+     * Signals every thread with an active operation and aggregates the samples they capture.
+     */
+    void takeSamples();
+
+    /**
+     * Returns the aggregated samples.
+     */
+    std::vector<StackSamples> getSamples() const;
+
+    /**
+     * Discards the aggregated samples.
+     */
+    void reset();
+
+    /**
+     * Appends counts of samples taken, missed and dropped, and of distinct stacks.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    using Key = std::tuple<std::string, boost::optional<std::uint32_t>, std::vector<void*>>;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("OperationStackSampler::_mutex");
+    std::map<Key, long long> _stacks;
+    // Samples aggregated; threads that didn't respond to the signal in time; and samples of new
+    // stacks discarded after reaching operationStackSamplingMaxStacks.
+    long long _numSamples = 0;
+    long long _numMissed = 0;
+    long long _numDropped = 0;
+
+    std::shared_ptr<PeriodicJobAnchor> _anchor;
+};
+
+Status onUpdateOperationStackSamplingInterval(const int& newValue);
+
+}  // namespace mongo
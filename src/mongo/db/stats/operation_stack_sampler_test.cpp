@@ -0,0 +1,120 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/operation_stack_sampler.h"
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+TEST(OperationStackSamplerTest, NoSamplesWithoutActiveOperations) {
+    OperationStackSampler sampler;
+    sampler.takeSamples();
+    ASSERT(sampler.getSamples().empty());
+}
+
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+TEST(OperationStackSamplerTest, SamplesAreTaggedWithCommandAndQueryHash) {
+    const std::string commandName = "find";
+    AtomicWord<bool> running{false};
+    AtomicWord<bool> done{false};
+    stdx::thread worker([&] {
+        OperationStackSampler::ActiveOperation activeOperation(commandName);
+        OperationStackSampler::setQueryHash(0x1234);
+        running.store(true);
+        while (!done.load()) {
+        }
+    });
+    while (!running.load()) {
+        sleepmillis(1);
+    }
+
+    OperationStackSampler sampler;
+    for (int i = 0; i < 100 && sampler.getSamples().empty(); ++i) {
+        sampler.takeSamples();
+    }
+    done.store(true);
+    worker.join();
+
+    auto samples = sampler.getSamples();
+    ASSERT(!samples.empty());
+    for (auto&& sample : samples) {
+        ASSERT_EQ(commandName, sample.command);
+        ASSERT_EQ(0x1234u, *sample.queryHash);
+        ASSERT(!sample.frames.empty());
+        ASSERT_GT(sample.count, 0);
+    }
+
+    // The operation has ended, so the next round takes no samples.
+    sampler.reset();
+    sampler.takeSamples();
+    ASSERT(sampler.getSamples().empty());
+}
+
+TEST(OperationStackSamplerTest, NestedOperationRestoresOuterCommand) {
+    const std::string outerName = "aggregate";
+    const std::string innerName = "find";
+    AtomicWord<int> phase{0};
+    stdx::thread worker([&] {
+        OperationStackSampler::ActiveOperation outer(outerName);
+        {
+            OperationStackSampler::ActiveOperation inner(innerName);
+        }
+        phase.store(1);
+        while (phase.load() != 2) {
+        }
+    });
+    while (phase.load() != 1) {
+        sleepmillis(1);
+    }
+
+    OperationStackSampler sampler;
+    for (int i = 0; i < 100 && sampler.getSamples().empty(); ++i) {
+        sampler.takeSamples();
+    }
+    phase.store(2);
+    worker.join();
+
+    auto samples = sampler.getSamples();
+    ASSERT(!samples.empty());
+    for (auto&& sample : samples) {
+        ASSERT_EQ(outerName, sample.command);
+        ASSERT(!sample.queryHash);
+    }
+}
+#endif
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,160 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_stats.h"
+
+#include <algorithm>
+
+#include "mongo/db/client.h"
+#include "mongo/db/commands/server_status.h"
+#include "mongo/db/stats/query_shape_stats_gen.h"
+
+namespace mongo {
+namespace {
+
+const auto getQueryShapeStats = ServiceContext::declareDecoration<QueryShapeStats>();
+
+int latencyBucket(long long micros) {
+    int bucket = 0;
+    while (micros >= 2 && bucket < QueryShapeStats::kNumLatencyBuckets - 1) {
+        micros >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+}  // namespace
+
+long long QueryShapeStats::Entry::latencyPercentileMicros(double percentile) const {
+    if (execCount == 0) {
+        return 0;
+    }
+    const auto rank = static_cast<long long>(percentile * execCount);
+    long long seen = 0;
+    for (int bucket = 0; bucket < kNumLatencyBuckets; ++bucket) {
+        seen += latencyBuckets[bucket];
+        if (seen > rank) {
+            return std::min(maxExecMicros, (2LL << bucket) - 1);
+        }
+    }
+    return maxExecMicros;
+}
+
+QueryShapeStats* QueryShapeStats::get(ServiceContext* service) {
+    return &getQueryShapeStats(service);
+}
+
+bool QueryShapeStats::shouldRecord(Client* client) {
+    if (gQueryShapeStatsMaxEntries.load() == 0) {
+        return false;
+    }
+    const double sampleRate = gQueryShapeStatsSampleRate.load();
+    return sampleRate >= 1.0 || client->getPrng().nextCanonicalDouble() < sampleRate;
+}
+
+void QueryShapeStats::record(StringData ns,
+                             std::uint32_t queryHash,
+                             const Execution& execution,
+                             Date_t now) {
+    auto& partition = _partitions[queryHash % kNumPartitions];
+    stdx::lock_guard<Latch> lk(partition.mutex);
+
+    Key key{ns.toString(), queryHash};
+    auto it = partition.entries.find(key);
+    if (it == partition.entries.end()) {
+        if (_numEntries.load() >= gQueryShapeStatsMaxEntries.load()) {
+            _numDropped.fetchAndAdd(1);
+            return;
+        }
+        _numEntries.fetchAndAdd(1);
+        it = partition.entries.emplace(std::move(key), Entry{}).first;
+        it->second.ns = it->first.first;
+        it->second.queryHash = queryHash;
+        it->second.firstSeen = now;
+    }
+
+    auto& entry = it->second;
+    ++entry.execCount;
+    entry.totalExecMicros += execution.execMicros;
+    entry.maxExecMicros = std::max(entry.maxExecMicros, execution.execMicros);
+    ++entry.latencyBuckets[latencyBucket(execution.execMicros)];
+    entry.docsExamined += execution.docsExamined;
+    entry.keysExamined += execution.keysExamined;
+    entry.nreturned += execution.nreturned;
+    entry.bytesReturned += execution.bytesReturned;
+    entry.lastSeen = now;
+}
+
+std::vector<QueryShapeStats::Entry> QueryShapeStats::getEntries() const {
+    std::vector<Entry> entries;
+    entries.reserve(_numEntries.load());
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (auto&& [key, entry] : partition.entries) {
+            entries.push_back(entry);
+        }
+    }
+    return entries;
+}
+
+void QueryShapeStats::reset() {
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        _numEntries.subtractAndFetch(partition.entries.size());
+        partition.entries.clear();
+    }
+    _numDropped.store(0);
+}
+
+void QueryShapeStats::appendStats(BSONObjBuilder* builder) const {
+    builder->append("shapes", _numEntries.load());
+    builder->append("droppedExecutions", _numDropped.load());
+}
+
+namespace {
+
+class QueryShapeStatsServerStatusSection final : public ServerStatusSection {
+public:
+    QueryShapeStatsServerStatusSection() : ServerStatusSection("queryShapeStats") {}
+
+    bool includeByDefault() const override {
+        return gQueryShapeStatsMaxEntries.load() > 0;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElem) const override {
+        BSONObjBuilder builder;
+        QueryShapeStats::get(opCtx->getServiceContext())->appendStats(&builder);
+        return builder.obj();
+    }
+} queryShapeStatsServerStatusSection;
+
+}  // namespace
+}  // namespace mongo
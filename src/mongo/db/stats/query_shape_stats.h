@@ -0,0 +1,141 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+/**
+ * Aggregates, in memory, the executions of each query shape on each namespace: how often the shape
+ * ran, how long it took and how much it examined and returned. The aggregate is served by the
+ * $queryStats aggregation stage.
+ *
+ * A shape is identified by the queryHash of its canonical query. The table is bounded by
+ * queryShapeStatsMaxEntries and split into partitions, each with its own mutex, so concurrent
+ * operations on different shapes rarely contend.
+ */
+class QueryShapeStats {
+public:
+    // Latencies are counted in power-of-two buckets of microseconds: bucket 0 holds executions
+    // under 2 micros and bucket i those in [2^i, 2^(i+1)).
+    static constexpr int kNumLatencyBuckets = 32;
+
+    /**
+     * Describes one completed execution of a query shape.
+     */
+    struct Execution {
+        long long execMicros = 0;
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nreturned = 0;
+        long long bytesReturned = 0;
+    };
+
+    /**
+     * The aggregated executions of one query shape on one namespace.
+     */
+    struct Entry {
+        std::string ns;
+        std::uint32_t queryHash = 0;
+        long long execCount = 0;
+        long long totalExecMicros = 0;
+        long long maxExecMicros = 0;
+        std::array<long long, kNumLatencyBuckets> latencyBuckets{};
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nreturned = 0;
+        long long bytesReturned = 0;
+        Date_t firstSeen;
+        Date_t lastSeen;
+
+        /**
+         * Returns an upper bound on the latency of the fraction `percentile` of the executions, at
+         * the resolution of the latency buckets.
+         */
+        long long latencyPercentileMicros(double percentile) const;
+    };
+
+    static QueryShapeStats* get(ServiceContext* service);
+
+    /**
+     * Returns whether the next completed operation with a query shape, run by `client`, should be
+     * recorded, according to queryShapeStatsMaxEntries and queryShapeStatsSampleRate.
+     */
+    static bool shouldRecord(Client* client);
+
+    /**
+     * Adds one execution of the shape `queryHash` on `ns`, completed at `now`.
+     */
+    void record(StringData ns, std::uint32_t queryHash, const Execution& execution, Date_t now);
+
+    /**
+     * Returns the aggregated executions of every tracked shape.
+     */
+    std::vector<Entry> getEntries() const;
+
+    /**
+     * Discards every tracked shape.
+     */
+    void reset();
+
+    /**
+     * Appends the number of tracked shapes and of executions dropped for want of space.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    static constexpr size_t kNumPartitions = 16;
+
+    using Key = std::pair<std::string, std::uint32_t>;
+
+    struct Partition {
+        mutable Mutex mutex = MONGO_MAKE_LATCH("QueryShapeStats::Partition::mutex");
+        std::map<Key, Entry> entries;
+    };
+
+    std::array<Partition, kNumPartitions> _partitions;
+    AtomicWord<long long> _numEntries{0};
+    AtomicWord<long long> _numDropped{0};
+};
+
+}  // namespace mongo
@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_stats.h"
+
+#include <algorithm>
+
+#include "mongo/db/stats/query_shape_stats_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+QueryShapeStats::Execution makeExecution(long long execMicros) {
+    QueryShapeStats::Execution execution;
+    execution.execMicros = execMicros;
+    execution.docsExamined = 10;
+    execution.keysExamined = 5;
+    execution.nreturned = 2;
+    execution.bytesReturned = 100;
+    return execution;
+}
+
+TEST(QueryShapeStatsTest, AggregatesExecutionsByNamespaceAndShape) {
+    QueryShapeStats stats;
+    const auto start = Date_t::fromMillisSinceEpoch(1000);
+    stats.record("test.a", 1, makeExecution(10), start);
+    stats.record("test.a", 1, makeExecution(30), start + Seconds(1));
+    stats.record("test.b", 1, makeExecution(5), start);
+    stats.record("test.a", 2, makeExecution(5), start);
+
+    auto entries = stats.getEntries();
+    ASSERT_EQ(3U, entries.size());
+    auto it = std::find_if(entries.begin(), entries.end(), [](const auto& entry) {
+        return entry.ns == "test.a" && entry.queryHash == 1;
+    });
+    ASSERT(it != entries.end());
+    ASSERT_EQ(2, it->execCount);
+    ASSERT_EQ(40, it->totalExecMicros);
+    ASSERT_EQ(30, it->maxExecMicros);
+    ASSERT_EQ(20, it->docsExamined);
+    ASSERT_EQ(10, it->keysExamined);
+    ASSERT_EQ(4, it->nreturned);
+    ASSERT_EQ(200, it->bytesReturned);
+    ASSERT_EQ(start, it->firstSeen);
+    ASSERT_EQ(start + Seconds(1), it->lastSeen);
+
+    stats.reset();
+    ASSERT(stats.getEntries().empty());
+}
+
+TEST(QueryShapeStatsTest, LatencyPercentilesAreBoundedByBuckets) {
+    QueryShapeStats stats;
+    for (int i = 0; i < 99; ++i) {
+        stats.record("test.a", 1, makeExecution(100), Date_t::now());
+    }
+    stats.record("test.a", 1, makeExecution(100000), Date_t::now());
+
+    auto entries = stats.getEntries();
+    ASSERT_EQ(1U, entries.size());
+    // 100 micros falls in the [64, 128) bucket.
+    ASSERT_EQ(127, entries[0].latencyPercentileMicros(0.5));
+    ASSERT_EQ(127, entries[0].latencyPercentileMicros(0.95));
+    ASSERT_EQ(100000, entries[0].latencyPercentileMicros(0.999));
+}
+
+TEST(QueryShapeStatsTest, NewShapesBeyondTheLimitAreDropped) {
+    const auto originalMaxEntries = gQueryShapeStatsMaxEntries.load();
+    gQueryShapeStatsMaxEntries.store(2);
+    ON_BLOCK_EXIT([&] { gQueryShapeStatsMaxEntries.store(originalMaxEntries); });
+
+    QueryShapeStats stats;
+    for (std::uint32_t queryHash = 0; queryHash < 4; ++queryHash) {
+        stats.record("test.a", queryHash, makeExecution(1), Date_t::now());
+    }
+    // Shapes already tracked keep being updated.
+    stats.record("test.a", 0, makeExecution(1), Date_t::now());
+
+    ASSERT_EQ(2U, stats.getEntries().size());
+    BSONObjBuilder builder;
+    stats.appendStats(&builder);
+    ASSERT_BSONOBJ_EQ(BSON("shapes" << 2LL << "droppedExecutions" << 2LL), builder.obj());
+}
+
+}  // namespace
+}  // namespace mongo
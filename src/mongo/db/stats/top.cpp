@@ -35,6 +35,7 @@
 
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/util/sharded_counter.h"
 
 namespace mongo {
 
@@ -66,6 +67,19 @@ Top::CollectionData::CollectionData(const CollectionData& older, const Collectio
       remove(older.remove, newer.remove),
       commands(older.commands, newer.commands) {}
 
+void Top::CollectionData::merge(const CollectionData& other) {
+    total.merge(other.total);
+    readLock.merge(other.readLock);
+    writeLock.merge(other.writeLock);
+    queries.merge(other.queries);
+    getmore.merge(other.getmore);
+    insert.merge(other.insert);
+    update.merge(other.update);
+    remove.merge(other.remove);
+    commands.merge(other.commands);
+    opLatencyHistogram.merge(other.opLatencyHistogram);
+}
+
 // static
 Top& Top::get(ServiceContext* service) {
     return getTop(service);
@@ -82,12 +96,28 @@ void Top::record(OperationContext* opCtx,
         return;
 
     auto hashedNs = UsageMap::hasher().hashed_key(ns);
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    auto& shard = _currentShard();
+    stdx::lock_guard<SimpleMutex> lk(shard.lock);
 
-    CollectionData& coll = _usage[hashedNs];
+    CollectionData& coll = shard.usage[hashedNs];
     _record(opCtx, coll, logicalOp, lockType, micros, readWriteType);
 }
 
+Top::Shard& Top::_currentShard() {
+    return _shards[currentCpuShard(kNumShards)];
+}
+
+Top::UsageMap Top::_mergedUsage() const {
+    UsageMap merged;
+    for (const auto& shard : _shards) {
+        stdx::lock_guard<SimpleMutex> lk(shard.lock);
+        for (const auto& entry : shard.usage) {
+            merged[entry.first].merge(entry.second);
+        }
+    }
+    return merged;
+}
+
 void Top::_record(OperationContext* opCtx,
                   CollectionData& c,
                   LogicalOp logicalOp,
@@ -134,18 +164,18 @@ void Top::_record(OperationContext* opCtx,
 }
 
 void Top::collectionDropped(const NamespaceString& nss) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _usage.erase(nss.ns());
+    for (auto& shard : _shards) {
+        stdx::lock_guard<SimpleMutex> lk(shard.lock);
+        shard.usage.erase(nss.ns());
+    }
 }
 
 void Top::cloneMap(Top::UsageMap& out) const {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    out = _usage;
+    out = _mergedUsage();
 }
 
 void Top::append(BSONObjBuilder& b) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _appendToUsageMap(b, _usage);
+    _appendToUsageMap(b, _mergedUsage());
 }
 
 void Top::_appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const {
@@ -188,11 +218,19 @@ void Top::_appendStatsEntry(BSONObjBuilder& b, const char* statsName, const Usag
 
 void Top::appendLatencyStats(const NamespaceString& nss,
                              bool includeHistograms,
+                             const std::vector<double>& percentiles,
                              BSONObjBuilder* builder) {
     auto hashedNs = UsageMap::hasher().hashed_key(nss.ns());
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    OperationLatencyHistogram histogram;
+    for (auto& shard : _shards) {
+        stdx::lock_guard<SimpleMutex> lk(shard.lock);
+        auto it = shard.usage.find(hashedNs);
+        if (it != shard.usage.end()) {
+            histogram.merge(it->second.opLatencyHistogram);
+        }
+    }
     BSONObjBuilder latencyStatsBuilder;
-    _usage[hashedNs].opLatencyHistogram.append(includeHistograms, &latencyStatsBuilder);
+    histogram.append(includeHistograms, percentiles, &latencyStatsBuilder);
     builder->append("ns", nss.ns());
     builder->append("latencyStats", latencyStatsBuilder.obj());
 }
@@ -200,18 +238,26 @@ void Top::appendLatencyStats(const NamespaceString& nss,
 void Top::incrementGlobalLatencyStats(OperationContext* opCtx,
                                       uint64_t latency,
                                       Command::ReadWriteType readWriteType) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _incrementHistogram(opCtx, latency, &_globalHistogramStats, readWriteType);
+    auto& shard = _currentShard();
+    stdx::lock_guard<SimpleMutex> guard(shard.lock);
+    _incrementHistogram(opCtx, latency, &shard.globalHistogramStats, readWriteType);
 }
 
-void Top::appendGlobalLatencyStats(bool includeHistograms, BSONObjBuilder* builder) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.append(includeHistograms, builder);
+void Top::appendGlobalLatencyStats(bool includeHistograms,
+                                   const std::vector<double>& percentiles,
+                                   BSONObjBuilder* builder) {
+    OperationLatencyHistogram histogram;
+    for (auto& shard : _shards) {
+        stdx::lock_guard<SimpleMutex> guard(shard.lock);
+        histogram.merge(shard.globalHistogramStats);
+    }
+    histogram.append(includeHistograms, percentiles, builder);
 }
 
 void Top::incrementGlobalTransactionLatencyStats(uint64_t latency) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.increment(latency, Command::ReadWriteType::kTransaction);
+    auto& shard = _currentShard();
+    stdx::lock_guard<SimpleMutex> guard(shard.lock);
+    shard.globalHistogramStats.increment(latency, Command::ReadWriteType::kTransaction);
 }
 
 void Top::_incrementHistogram(OperationContext* opCtx,
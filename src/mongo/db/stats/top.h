@@ -33,6 +33,7 @@
  * DB usage monitor.
  */
 
+#include <array>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
 #include "mongo/db/commands.h"
@@ -40,6 +41,7 @@
 #include "mongo/db/stats/operation_latency_histogram.h"
 #include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/string_map.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -47,6 +49,9 @@ class ServiceContext;
 
 /**
  * tracks usage by collection
+ *
+ * Operations are recorded in the shard of the CPU they are recorded on, so that recording one
+ * takes a mutex and touches cache lines that other cores rarely use. Readers merge the shards.
  */
 class Top {
 public:
@@ -64,6 +69,11 @@ public:
             count++;
             time += micros;
         }
+
+        void merge(const UsageData& other) {
+            count += other.count;
+            time += other.time;
+        }
     };
 
     struct CollectionData {
@@ -73,6 +83,11 @@ public:
         CollectionData() {}
         CollectionData(const CollectionData& older, const CollectionData& newer);
 
+        /**
+         * Adds the usage recorded in 'other'.
+         */
+        void merge(const CollectionData& other);
+
         UsageData total;
 
         UsageData readLock;
@@ -111,10 +126,12 @@ public:
     void collectionDropped(const NamespaceString& nss);
 
     /**
-     * Appends the collection-level latency statistics
+     * Appends the collection-level latency statistics, including the latency at each of
+     * 'percentiles'.
      */
     void appendLatencyStats(const NamespaceString& nss,
                             bool includeHistograms,
+                            const std::vector<double>& percentiles,
                             BSONObjBuilder* builder);
 
     /**
@@ -130,9 +147,11 @@ public:
     void incrementGlobalTransactionLatencyStats(uint64_t latency);
 
     /**
-     * Appends the global latency statistics.
+     * Appends the global latency statistics, including the latency at each of 'percentiles'.
      */
-    void appendGlobalLatencyStats(bool includeHistograms, BSONObjBuilder* builder);
+    void appendGlobalLatencyStats(bool includeHistograms,
+                                  const std::vector<double>& percentiles,
+                                  BSONObjBuilder* builder);
 
 private:
     void _appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const;
@@ -151,9 +170,24 @@ private:
                              OperationLatencyHistogram* histogram,
                              Command::ReadWriteType readWriteType);
 
-    mutable SimpleMutex _lock;
-    OperationLatencyHistogram _globalHistogramStats;
-    UsageMap _usage;
+    struct Shard {
+        mutable SimpleMutex lock;
+        OperationLatencyHistogram globalHistogramStats;
+        UsageMap usage;
+    };
+
+    // The usage maps hold an entry per namespace used on each shard, so more shards cost memory
+    // for every collection in use.
+    static constexpr size_t kNumShards = 8;
+
+    Shard& _currentShard();
+
+    /**
+     * Returns the usage of all shards, merged by namespace.
+     */
+    UsageMap _mergedUsage() const;
+
+    std::array<CacheAligned<Shard>, kNumShards> _shards;
 };
 
 }  // namespace mongo
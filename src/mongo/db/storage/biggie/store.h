@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <boost/optional.hpp>
 #include <cstring>
@@ -191,25 +192,20 @@ public:
 
                 // Check the children right of the node that the iterator was at already. This way,
                 // there will be no backtracking in the traversal.
-                for (auto iter = oldKey + 1 + node->_children.begin();
-                     iter != node->_children.end();
-                     ++iter) {
-
-                    // If the node has a child, then the sub-tree must have a node with data that
-                    // has not yet been visited.
-                    if (*iter != nullptr) {
-
-                        // If the current node has data, return it and exit. If not, continue
-                        // following the nodes to find the next one with data. It is necessary to go
-                        // to the left-most node in this sub-tree.
-                        if ((*iter)->_data) {
-                            _current = iter->get();
-                            return;
-                        }
-                        _current = iter->get();
+                int nextKey = node->_children.nextKey(oldKey + 1);
+
+                // If the node has a child, then the sub-tree must have a node with data that has
+                // not yet been visited.
+                if (nextKey != -1) {
+
+                    // If the current node has data, return it and exit. If not, continue following
+                    // the nodes to find the next one with data. It is necessary to go to the
+                    // left-most node in this sub-tree.
+                    _current = node->_children[nextKey].get();
+                    if (!_current->_data) {
                         _traverseLeftSubtree();
-                        return;
                     }
+                    return;
                 }
             }
             return;
@@ -220,12 +216,7 @@ public:
             // '_current' is root. However, it cannot return the root, and hence at least 1
             // iteration of the while loop is required.
             do {
-                for (auto child : _current->_children) {
-                    if (child != nullptr) {
-                        _current = child.get();
-                        break;
-                    }
-                }
+                _current = _current->_children[_current->_children.nextKey(0)].get();
             } while (!_current->_data);
         }
 
@@ -399,14 +390,13 @@ public:
 
                 // After moving up in the tree, continue searching for neighboring nodes to see if
                 // they have data, moving from right to left.
-                for (int i = oldKey - 1; i >= 0; i--) {
-                    if (node->_children[i] != nullptr) {
-                        // If there is a sub-tree found, it must have data, therefore it's necessary
-                        // to traverse to the right most node.
-                        _current = node->_children[i].get();
-                        _traverseRightSubtree();
-                        return;
-                    }
+                int prevKey = node->_children.prevKey(oldKey - 1);
+                if (prevKey != -1) {
+                    // If there is a sub-tree found, it must have data, therefore it's necessary to
+                    // traverse to the right most node.
+                    _current = node->_children[prevKey].get();
+                    _traverseRightSubtree();
+                    return;
                 }
 
                 // If there were no sub-trees that contained data, and the 'current' node has data,
@@ -421,15 +411,9 @@ public:
         void _traverseRightSubtree() {
             // This function traverses the given tree to the right most leaf of the subtree where
             // 'current' is the root.
-            do {
-                for (auto iter = _current->_children.rbegin(); iter != _current->_children.rend();
-                     ++iter) {
-                    if (*iter != nullptr) {
-                        _current = iter->get();
-                        break;
-                    }
-                }
-            } while (!_current->isLeaf());
+            while (!_current->isLeaf()) {
+                _current = _current->_children[_current->_children.prevKey(UINT8_MAX)].get();
+            }
         }
 
         void updateTreeView(bool stopIfMultipleCursors = false) {
@@ -610,7 +594,7 @@ public:
 
             uint8_t childFirstChar = child->_trieKey.front();
             if (!isUniquelyOwned) {
-                parent->_children[childFirstChar] = std::make_shared<Node>(*child);
+                parent->_children.set(childFirstChar, std::make_shared<Node>(*child));
                 child = parent->_children[childFirstChar].get();
             }
 
@@ -618,7 +602,7 @@ public:
         }
 
         // Handle the deleted node, as it is a leaf.
-        parent->_children[deleted->_trieKey.front()] = nullptr;
+        parent->_children.set(deleted->_trieKey.front(), nullptr);
 
         // 'parent' may only have one child, in which case we need to evaluate whether or not
         // this node is redundant.
@@ -734,18 +718,15 @@ public:
             std::tie(node, idx) = context.back();
             context.pop_back();
 
-            for (auto iter = idx + node->_children.begin(); iter != node->_children.end(); ++iter) {
-                if (!(*iter))
-                    continue;
-
+            int nextKey = node->_children.nextKey(idx);
+            if (nextKey != -1) {
                 // There exists a node with a key larger than the one given.
-                node = iter->get();
+                node = node->_children[nextKey].get();
                 if (node->_data)
                     return const_iterator(_root, node);
 
                 // Need to search this node's children for the next largest node.
                 context.push_back(std::make_pair(node, 0));
-                break;
             }
 
             if (node->_trieKey.empty() && context.empty()) {
@@ -782,6 +763,317 @@ public:
         return _walkTree(_root.get(), 0);
     }
 
+private:
+    /**
+     * The children of a Node, keyed by the byte of the key that follows the Node's trie key.
+     *
+     * In the style of an adaptive radix tree, the layout depends on the number of children: up to
+     * 4 or 16 children are kept in sorted arrays of keys and slots, up to 48 are reached through a
+     * 256 byte index into the slots, and beyond that there is one slot per possible byte. The
+     * layout grows as children are added and shrinks as they are removed, and a Node without
+     * children allocates nothing, so that the leaves and sparse inner nodes which make up most of a
+     * tree stay small.
+     */
+    class Children {
+    public:
+        Children() = default;
+
+        Children(const Children& other) : _kind(other._kind), _count(other._count) {
+            if (!other._slots)
+                return;
+
+            size_t indexSize = _indexSize(_kind);
+            if (indexSize) {
+                _index = std::make_unique<uint8_t[]>(indexSize);
+                std::copy(other._index.get(), other._index.get() + indexSize, _index.get());
+            }
+            size_t capacity = _capacity(_kind);
+            _slots = std::make_unique<std::shared_ptr<Node>[]>(capacity);
+            std::copy(other._slots.get(), other._slots.get() + capacity, _slots.get());
+        }
+
+        Children(Children&& other) noexcept
+            : _kind(other._kind),
+              _count(other._count),
+              _index(std::move(other._index)),
+              _slots(std::move(other._slots)) {
+            other._kind = Kind::kNode4;
+            other._count = 0;
+        }
+
+        Children& operator=(Children other) noexcept {
+            std::swap(_kind, other._kind);
+            std::swap(_count, other._count);
+            std::swap(_index, other._index);
+            std::swap(_slots, other._slots);
+            return *this;
+        }
+
+        /**
+         * Returns the child at 'key', or a null pointer if there is none.
+         */
+        const std::shared_ptr<Node>& operator[](uint8_t key) const {
+            static const std::shared_ptr<Node> kNoChild;
+            std::shared_ptr<Node>* slot = _find(key);
+            return slot ? *slot : kNoChild;
+        }
+
+        /**
+         * Sets the child at 'key' to 'child', removing it if 'child' is null.
+         */
+        void set(uint8_t key, std::shared_ptr<Node> child) {
+            if (!child) {
+                _erase(key);
+                return;
+            }
+
+            if (std::shared_ptr<Node>* slot = _find(key)) {
+                *slot = std::move(child);
+                return;
+            }
+
+            if (!_slots) {
+                _allocate(Kind::kNode4);
+            } else if (_count == _capacity(_kind)) {
+                _convert(static_cast<Kind>(static_cast<uint8_t>(_kind) + 1));
+            }
+            _insert(key, std::move(child));
+        }
+
+        /**
+         * Returns the smallest key at or after 'from' that has a child, or -1 if there is none.
+         */
+        int nextKey(int from) const {
+            if (_count == 0)
+                return -1;
+
+            switch (_kind) {
+                case Kind::kNode4:
+                case Kind::kNode16:
+                    for (size_t i = 0; i < _count; ++i) {
+                        if (_index[i] >= from)
+                            return _index[i];
+                    }
+                    return -1;
+                case Kind::kNode48:
+                    for (int key = from; key <= UINT8_MAX; ++key) {
+                        if (_index[key])
+                            return key;
+                    }
+                    return -1;
+                case Kind::kNode256:
+                    for (int key = from; key <= UINT8_MAX; ++key) {
+                        if (_slots[key])
+                            return key;
+                    }
+                    return -1;
+            }
+            MONGO_UNREACHABLE;
+        }
+
+        /**
+         * Returns the largest key at or before 'from' that has a child, or -1 if there is none.
+         */
+        int prevKey(int from) const {
+            if (_count == 0)
+                return -1;
+
+            switch (_kind) {
+                case Kind::kNode4:
+                case Kind::kNode16:
+                    for (size_t i = _count; i-- > 0;) {
+                        if (_index[i] <= from)
+                            return _index[i];
+                    }
+                    return -1;
+                case Kind::kNode48:
+                    for (int key = std::min(from, int{UINT8_MAX}); key >= 0; --key) {
+                        if (_index[key])
+                            return key;
+                    }
+                    return -1;
+                case Kind::kNode256:
+                    for (int key = std::min(from, int{UINT8_MAX}); key >= 0; --key) {
+                        if (_slots[key])
+                            return key;
+                    }
+                    return -1;
+            }
+            MONGO_UNREACHABLE;
+        }
+
+        size_t size() const {
+            return _count;
+        }
+
+        bool empty() const {
+            return _count == 0;
+        }
+
+    private:
+        enum class Kind : uint8_t { kNode4, kNode16, kNode48, kNode256 };
+
+        // Once a layout has shrunk to this many children, it is replaced by the next smaller one.
+        // They are below the capacity of the smaller layout so that a node whose number of
+        // children hovers around a boundary does not convert back and forth.
+        static constexpr size_t kShrinkNode16 = 3;
+        static constexpr size_t kShrinkNode48 = 12;
+        static constexpr size_t kShrinkNode256 = 36;
+
+        static size_t _capacity(Kind kind) {
+            switch (kind) {
+                case Kind::kNode4:
+                    return 4;
+                case Kind::kNode16:
+                    return 16;
+                case Kind::kNode48:
+                    return 48;
+                case Kind::kNode256:
+                    return 256;
+            }
+            MONGO_UNREACHABLE;
+        }
+
+        static size_t _indexSize(Kind kind) {
+            switch (kind) {
+                case Kind::kNode4:
+                case Kind::kNode16:
+                    return _capacity(kind);
+                case Kind::kNode48:
+                    return 256;
+                case Kind::kNode256:
+                    return 0;
+            }
+            MONGO_UNREACHABLE;
+        }
+
+        void _allocate(Kind kind) {
+            _kind = kind;
+            _count = 0;
+            size_t indexSize = _indexSize(kind);
+            _index = indexSize ? std::make_unique<uint8_t[]>(indexSize) : nullptr;
+            _slots = std::make_unique<std::shared_ptr<Node>[]>(_capacity(kind));
+        }
+
+        /**
+         * Moves all children into a newly allocated layout of 'kind'.
+         */
+        void _convert(Kind kind) {
+            Children converted;
+            converted._allocate(kind);
+            for (int key = nextKey(0); key != -1; key = nextKey(key + 1)) {
+                converted._insert(key, std::move(*_find(key)));
+            }
+            *this = std::move(converted);
+        }
+
+        std::shared_ptr<Node>* _find(uint8_t key) const {
+            if (_count == 0)
+                return nullptr;
+
+            switch (_kind) {
+                case Kind::kNode4:
+                case Kind::kNode16:
+                    for (size_t i = 0; i < _count && _index[i] <= key; ++i) {
+                        if (_index[i] == key)
+                            return &_slots[i];
+                    }
+                    return nullptr;
+                case Kind::kNode48:
+                    return _index[key] ? &_slots[_index[key] - 1] : nullptr;
+                case Kind::kNode256:
+                    return _slots[key] ? &_slots[key] : nullptr;
+            }
+            MONGO_UNREACHABLE;
+        }
+
+        /**
+         * Adds a child at 'key', which must not have one yet. There must be room for it.
+         */
+        void _insert(uint8_t key, std::shared_ptr<Node> child) {
+            switch (_kind) {
+                case Kind::kNode4:
+                case Kind::kNode16: {
+                    size_t pos = _count;
+                    for (; pos > 0 && _index[pos - 1] > key; --pos) {
+                        _index[pos] = _index[pos - 1];
+                        _slots[pos] = std::move(_slots[pos - 1]);
+                    }
+                    _index[pos] = key;
+                    _slots[pos] = std::move(child);
+                    break;
+                }
+                case Kind::kNode48:
+                    _index[key] = _count + 1;
+                    _slots[_count] = std::move(child);
+                    break;
+                case Kind::kNode256:
+                    _slots[key] = std::move(child);
+                    break;
+            }
+            ++_count;
+        }
+
+        void _erase(uint8_t key) {
+            if (!_find(key))
+                return;
+
+            switch (_kind) {
+                case Kind::kNode4:
+                case Kind::kNode16: {
+                    size_t pos = 0;
+                    while (_index[pos] != key)
+                        ++pos;
+                    for (; pos + 1 < _count; ++pos) {
+                        _index[pos] = _index[pos + 1];
+                        _slots[pos] = std::move(_slots[pos + 1]);
+                    }
+                    _slots[_count - 1].reset();
+                    break;
+                }
+                case Kind::kNode48: {
+                    // Keep the slots dense by moving the last one into the hole.
+                    uint8_t slot = _index[key] - 1;
+                    uint8_t last = _count - 1;
+                    if (slot != last) {
+                        _slots[slot] = std::move(_slots[last]);
+                        for (size_t i = 0; i < _indexSize(_kind); ++i) {
+                            if (_index[i] == last + 1) {
+                                _index[i] = slot + 1;
+                                break;
+                            }
+                        }
+                    }
+                    _slots[last].reset();
+                    _index[key] = 0;
+                    break;
+                }
+                case Kind::kNode256:
+                    _slots[key].reset();
+                    break;
+            }
+            --_count;
+
+            if (_count == 0) {
+                *this = Children();
+            } else if (_kind == Kind::kNode256 && _count <= kShrinkNode256) {
+                _convert(Kind::kNode48);
+            } else if (_kind == Kind::kNode48 && _count <= kShrinkNode48) {
+                _convert(Kind::kNode16);
+            } else if (_kind == Kind::kNode16 && _count <= kShrinkNode16) {
+                _convert(Kind::kNode4);
+            }
+        }
+
+        Kind _kind = Kind::kNode4;
+        uint16_t _count = 0;
+
+        // For the sorted layouts, the key of each slot. For kNode48, one entry per key holding the
+        // position of its slot plus one, or zero if the key has no child. Unused for kNode256.
+        std::unique_ptr<uint8_t[]> _index;
+        std::unique_ptr<std::shared_ptr<Node>[]> _slots;
+    };
+
 private:
     class Node {
         friend class RadixStore;
@@ -822,18 +1114,14 @@ private:
         }
 
         bool isLeaf() const {
-            for (auto child : _children) {
-                if (child != nullptr)
-                    return false;
-            }
-            return true;
+            return _children.empty();
         }
 
     protected:
         unsigned int _depth = 0;
         std::vector<uint8_t> _trieKey;
         boost::optional<value_type> _data;
-        std::array<std::shared_ptr<Node>, 256> _children;
+        Children _children;
     };
 
     /**
@@ -910,10 +1198,9 @@ private:
         }
         ret.push_back('\n');
 
-        for (auto child : node->_children) {
-            if (child != nullptr) {
-                ret.append(_walkTree(child.get(), depth + 1));
-            }
+        for (int key = node->_children.nextKey(0); key != -1;
+             key = node->_children.nextKey(key + 1)) {
+            ret.append(_walkTree(node->_children[key].get(), depth + 1));
         }
         return ret;
     }
@@ -1012,7 +1299,7 @@ private:
             if (node.use_count() - 1 > 1) {
                 // Copy node on a modifying operation when it isn't owned uniquely.
                 node = std::make_shared<Node>(*node);
-                prev->_children[childFirstChar] = node;
+                prev->_children.set(childFirstChar, node);
             }
 
             // 'node' is uniquely owned at this point, so we are free to modify it.
@@ -1045,7 +1332,7 @@ private:
 
                 // Change the current node's trieKey and make a child of the new node.
                 newKey = _makeKey(node->_trieKey, mismatchIdx, node->_trieKey.size() - mismatchIdx);
-                newNode->_children[newKey.front()] = node;
+                newNode->_children.set(newKey.front(), node);
 
                 node->_trieKey = newKey;
                 node->_depth = newNode->_depth + newNode->_trieKey.size();
@@ -1125,7 +1412,7 @@ private:
         if (value) {
             newNode->_data.emplace(value->first, value->second);
         }
-        node->_children[key.front()] = newNode;
+        node->_children.set(key.front(), newNode);
         return newNode.get();
     }
 
@@ -1181,16 +1468,10 @@ private:
         }
 
         // Determine if this node has only one child.
-        std::shared_ptr<Node> onlyChild = nullptr;
-
-        for (size_t i = 0; i < node->_children.size(); ++i) {
-            if (node->_children[i] != nullptr) {
-                if (onlyChild != nullptr) {
-                    return;
-                }
-                onlyChild = node->_children[i];
-            }
+        if (node->_children.size() != 1) {
+            return;
         }
+        std::shared_ptr<Node> onlyChild = node->_children[node->_children.nextKey(0)];
 
         // Append the child's key onto the parent.
         for (char item : onlyChild->_trieKey) {
@@ -1240,7 +1521,7 @@ private:
 
             if (prev->_children[node->_trieKey.front()].use_count() > 1) {
                 std::shared_ptr<Node> nodeCopy = std::make_shared<Node>(*node);
-                prev->_children[nodeCopy->_trieKey.front()] = nodeCopy;
+                prev->_children.set(nodeCopy->_trieKey.front(), nodeCopy);
                 context[idx] = nodeCopy.get();
                 prev = nodeCopy.get();
             } else {
@@ -1379,7 +1660,7 @@ private:
                     // modifications that go on in _makeBranchUnique.
                     _rebuildContext(context, trieKeyIndex);
 
-                    current->_children[key] = other->_children[key];
+                    current->_children.set(key, other->_children[key]);
                 } else if (!otherNode || (baseNode && baseNode != otherNode)) {
                     // Either the master tree and working tree remove the same branch, or the master
                     // tree updated the branch while the working tree removed the branch, resulting
@@ -1392,12 +1673,12 @@ private:
 
                     current = _makeBranchUnique(context);
                     _rebuildContext(context, trieKeyIndex);
-                    current->_children[key] = nullptr;
+                    current->_children.set(key, nullptr);
                 } else if (baseNode && otherNode && baseNode == node) {
                     // If base and current point to the same node, then master changed.
                     current = _makeBranchUnique(context);
                     _rebuildContext(context, trieKeyIndex);
-                    current->_children[key] = other->_children[key];
+                    current->_children.set(key, other->_children[key]);
                 }
             } else if (baseNode && otherNode && baseNode != otherNode) {
                 // If all three are unique and leaf nodes, then it is a merge conflict.
@@ -1440,12 +1721,7 @@ private:
             if (node->_children.empty())
                 return nullptr;
 
-            for (auto child : node->_children) {
-                if (child != nullptr) {
-                    node = child.get();
-                    break;
-                }
-            }
+            node = node->_children[node->_children.nextKey(0)].get();
         }
         return node;
     }
@@ -0,0 +1,124 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+#include "mongo/db/storage/biggie/store.h"
+
+namespace mongo {
+namespace biggie {
+namespace {
+
+using value_type = StringStore::value_type;
+
+// Generates 'count' keys from a pseudo-random permutation so that inner nodes see a mix of fan-out.
+std::vector<std::string> generateKeys(int64_t count) {
+    std::vector<std::string> keys;
+    keys.reserve(count);
+    for (int64_t i = 0; i < count; ++i) {
+        keys.push_back("key" + std::to_string((i * 7919) % 1000003));
+    }
+    return keys;
+}
+
+StringStore makeStore(const std::vector<std::string>& keys) {
+    StringStore store;
+    for (const auto& key : keys) {
+        store.insert(value_type(key, "value"));
+    }
+    return store;
+}
+
+void BM_RadixStoreInsert(benchmark::State& state) {
+    const auto keys = generateKeys(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(makeStore(keys));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_RadixStoreFind(benchmark::State& state) {
+    const auto keys = generateKeys(state.range(0));
+    StringStore store = makeStore(keys);
+    for (auto _ : state) {
+        for (const auto& key : keys) {
+            benchmark::DoNotOptimize(store.find(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_RadixStoreLowerBound(benchmark::State& state) {
+    const auto keys = generateKeys(state.range(0));
+    StringStore store = makeStore(keys);
+    for (auto _ : state) {
+        for (const auto& key : keys) {
+            benchmark::DoNotOptimize(store.lower_bound(key + "0"));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_RadixStoreIterate(benchmark::State& state) {
+    StringStore store = makeStore(generateKeys(state.range(0)));
+    for (auto _ : state) {
+        for (const auto& item : store) {
+            benchmark::DoNotOptimize(item);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_RadixStoreCopyOnWrite(benchmark::State& state) {
+    // Each iteration takes a snapshot of the tree and modifies it, which copies every node on the
+    // path to the modified key.
+    const auto keys = generateKeys(state.range(0));
+    StringStore store = makeStore(keys);
+    size_t i = 0;
+    for (auto _ : state) {
+        StringStore snapshot = store;
+        store.update(value_type(keys[i++ % keys.size()], "updated"));
+        benchmark::DoNotOptimize(snapshot);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_RadixStoreInsert)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_RadixStoreFind)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_RadixStoreLowerBound)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_RadixStoreIterate)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_RadixStoreCopyOnWrite)->Arg(1000)->Arg(100000);
+
+}  // namespace
+}  // namespace biggie
+}  // namespace mongo
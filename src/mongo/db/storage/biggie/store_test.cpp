@@ -2492,5 +2492,51 @@ TEST_F(RadixStoreTest, LowerBoundEndpoint) {
     ASSERT_TRUE(it == thisStore.end());
 }
 
+TEST_F(RadixStoreTest, GrowAndShrinkNodeChildren) {
+    // Give the node for "a" every possible number of children, which crosses each boundary between
+    // the layouts used for a node's children, first while inserting and then while erasing.
+    auto keyFor = [](int i) { return std::string("a") + static_cast<char>(i); };
+    for (int i = 0; i < 256; ++i) {
+        // Insert in an order which is not sorted to exercise the sorted layouts.
+        int c = (i * 7) % 256;
+        thisStore.insert(value_type(keyFor(c), std::to_string(c)));
+        ASSERT_EQ(thisStore.size(), StringStore::size_type(i + 1));
+        checkValid(thisStore);
+        if (i % 16 == 0) {
+            otherStore = thisStore;
+        }
+    }
+
+    int expected = 0;
+    for (auto& item : thisStore) {
+        ASSERT_EQ(item.first, keyFor(expected));
+        ASSERT_EQ(item.second, std::to_string(expected));
+        ++expected;
+    }
+    ASSERT_EQ(expected, 256);
+
+    for (auto it = thisStore.rbegin(); it != thisStore.rend(); ++it) {
+        --expected;
+        ASSERT_EQ(it->first, keyFor(expected));
+    }
+
+    for (int i = 0; i < 256; ++i) {
+        int c = (i * 13) % 256;
+        ASSERT_TRUE(thisStore.erase(keyFor(c)));
+        ASSERT_TRUE(thisStore.find(keyFor(c)) == thisStore.end());
+        ASSERT_EQ(thisStore.size(), StringStore::size_type(255 - i));
+        checkValid(thisStore);
+
+        auto it = thisStore.lower_bound(keyFor(c));
+        if (it != thisStore.end()) {
+            ASSERT_GT(it->first, keyFor(c));
+        }
+    }
+
+    // The snapshot taken by copying the tree is unaffected by the modifications.
+    ASSERT_EQ(otherStore.size(), StringStore::size_type(241));
+    checkValid(otherStore);
+}
+
 }  // namespace biggie
 }  // namespace mongo
@@ -55,6 +55,9 @@ MONGO_FAIL_POINT_DEFINE(flowControlTicketOverride);
 namespace {
 const auto getFlowControl = ServiceContext::declareDecoration<std::unique_ptr<FlowControl>>();
 
+// With the apply rate model, the tickets of each period are released in this many slices.
+const int kModelTicketSlices = 10;
+
 int multiplyWithOverflowCheck(double term1, double term2, int maxValue) {
     if (term1 == 0.0 || term2 == 0.0) {
         // Early return to avoid any divide by zero errors.
@@ -143,7 +146,10 @@ FlowControl::FlowControl(ServiceContext* service, repl::ReplicationCoordinator*
     _jobAnchor = service->getPeriodicRunner()->makeJob(
         {"FlowControlRefresher",
          [this](Client* client) {
-             FlowControlTicketholder::get(client->getServiceContext())->refreshTo(getNumTickets());
+             const int numTickets = getNumTickets();
+             FlowControlTicketholder::get(client->getServiceContext())
+                 ->refreshTo(numTickets,
+                             gFlowControlUseApplyRateModel.load() ? kModelTicketSlices : 1);
          },
          Seconds(1)});
     _jobAnchor.start();
@@ -211,6 +217,24 @@ BSONObj FlowControl::generateSection(OperationContext* opCtx,
     bob.append("isLaggedCount", _isLaggedCount.load());
     bob.append("isLaggedTimeMicros", _isLaggedTimeMicros.load());
 
+    if (gFlowControlUseApplyRateModel.load()) {
+        stdx::lock_guard<Latch> lk(_modelMutex);
+        BSONObjBuilder model(bob.subobjStart("applyRateModel"));
+        model.append("primaryWriteRate", _primaryWriteRate);
+        model.append("sustainerApplyRate", _sustainerApplyRate);
+        model.append("targetWriteRate", _targetWriteRate);
+        // How fast the commit point lag changes while writes and applies continue at the measured
+        // rates. A positive value means the lag is growing.
+        if (_primaryWriteRate > 0.0 && _sustainerApplyRate >= 0.0) {
+            model.append("predictedLagChangeMillisPerSecond",
+                         1000.0 * (1.0 - _sustainerApplyRate / _primaryWriteRate));
+        }
+        BSONObjBuilder members(model.subobjStart("memberApplyRates"));
+        for (auto&& [memberId, rate] : _memberApplyRates) {
+            members.append(memberId.toString(), rate);
+        }
+    }
+
     return bob.obj();
 }
 
@@ -308,9 +332,112 @@ int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>&
                 "reduce"_attr = reduce,
                 "sustainerAppliedPenalty"_attr = sustainerAppliedPenalty);
 
+    if (gFlowControlUseApplyRateModel.load()) {
+        double sustainerRate;
+        {
+            stdx::lock_guard<Latch> lk(_modelMutex);
+            sustainerRate = _sustainerApplyRate;
+        }
+        if (sustainerRate >= 0.0) {
+            return _calculateModelTickets(sustainerRate, locksPerOp, lagMillis, thresholdLagMillis);
+        }
+    }
+
     return multiplyWithOverflowCheck(locksPerOp, sustainerAppliedPenalty, _kMaxTickets);
 }
 
+double FlowControl::_updateApplyRates(const std::vector<repl::MemberData>& prevMemberData,
+                                      const std::vector<repl::MemberData>& currMemberData,
+                                      std::uint64_t opsWritten,
+                                      double periodSeconds) {
+    invariant(periodSeconds > 0.0);
+
+    // Count the operations each member applied over the period before taking `_modelMutex`, as
+    // counting takes `_sampledOpsMutex`. A count of -1 means there is no measurement this period.
+    std::vector<std::pair<repl::MemberId, std::int64_t>> appliedCounts;
+    for (auto&& curr : currMemberData) {
+        auto prev = std::find_if(
+            prevMemberData.begin(), prevMemberData.end(), [&](const repl::MemberData& member) {
+                return member.getMemberId() == curr.getMemberId();
+            });
+        std::int64_t applied = -1;
+        if (prev != prevMemberData.end()) {
+            const auto prevTs = prev->getLastAppliedOpTime().getTimestamp();
+            const auto currTs = curr.getLastAppliedOpTime().getTimestamp();
+            if (prevTs == currTs) {
+                applied = 0;
+            } else if (prevTs < currTs) {
+                applied = _approximateOpsBetween(prevTs, currTs);
+            }
+        }
+        appliedCounts.emplace_back(curr.getMemberId(), applied);
+    }
+
+    const double smoothingFactor = gFlowControlRateSmoothingFactor.load();
+    auto smooth = [&](double rate, double observed) {
+        return rate < 0.0 ? observed : rate + smoothingFactor * (observed - rate);
+    };
+
+    stdx::lock_guard<Latch> lk(_modelMutex);
+    std::map<repl::MemberId, double> memberApplyRates;
+    std::vector<double> rates;
+    for (auto&& [memberId, applied] : appliedCounts) {
+        auto it = _memberApplyRates.find(memberId);
+        double rate = it == _memberApplyRates.end() ? -1.0 : it->second;
+        if (applied >= 0) {
+            rate = smooth(rate, applied / periodSeconds);
+        }
+        if (rate >= 0.0) {
+            memberApplyRates[memberId] = rate;
+            rates.push_back(rate);
+        }
+    }
+    // Members that left the set are dropped here.
+    _memberApplyRates = std::move(memberApplyRates);
+    _primaryWriteRate = smooth(_primaryWriteRate, opsWritten / periodSeconds);
+
+    if (rates.empty() || rates.size() < currMemberData.size()) {
+        _sustainerApplyRate = -1.0;
+        return _sustainerApplyRate;
+    }
+
+    // Like the sustainer's applied optime, this is the rate that a majority of members meets.
+    std::sort(rates.begin(), rates.end());
+    _sustainerApplyRate = rates[rates.size() / 2];
+    return _sustainerApplyRate;
+}
+
+int FlowControl::_calculateModelTickets(double sustainerRate,
+                                        double locksPerOp,
+                                        std::uint64_t lagMillis,
+                                        std::uint64_t thresholdLagMillis) {
+    // While the primary writes at W operations per second and a majority applies at S, the commit
+    // point lag grows by (1 - S / W) seconds per second. Pick the W that moves the lag to the
+    // threshold over the catch up window: W = S / (1 - lagChange).
+    const double lagChange = (static_cast<double>(thresholdLagMillis) - lagMillis) /
+        (1000.0 * gFlowControlLagCatchUpSeconds.load());
+
+    int ret = _kMaxTickets;
+    double targetWriteRate = -1.0;
+    if (lagChange < 1.0) {
+        targetWriteRate = sustainerRate / (1.0 - lagChange);
+        ret = multiplyWithOverflowCheck(locksPerOp, targetWriteRate, _kMaxTickets);
+    }
+
+    LOGV2_DEBUG(5212030,
+                logSeverityV1toV2(DEBUG_LOG_LEVEL).toInt(),
+                "Flow control apply rate model",
+                "sustainerRate"_attr = sustainerRate,
+                "lagMillis"_attr = lagMillis,
+                "thresholdLagMillis"_attr = thresholdLagMillis,
+                "targetWriteRate"_attr = targetWriteRate,
+                "tickets"_attr = ret);
+
+    stdx::lock_guard<Latch> lk(_modelMutex);
+    _targetWriteRate = targetWriteRate;
+    return ret;
+}
+
 int FlowControl::getNumTickets() {
     // Flow Control is only enabled on nodes that can accept writes.
     const bool canAcceptWrites = _replCoord->canAcceptNonLocalWrites();
@@ -324,6 +451,25 @@ int FlowControl::getNumTickets() {
 
     // It's important to update the topology on each iteration.
     _updateTopologyData();
+
+    double sustainerRate = -1.0;
+    if (gFlowControlUseApplyRateModel.load()) {
+        const auto now = Date_t::now();
+        std::uint64_t numOps;
+        {
+            stdx::lock_guard<Latch> lk(_sampledOpsMutex);
+            numOps = _numOpsSinceStartup;
+        }
+        if (_lastRateUpdate != Date_t() && now > _lastRateUpdate) {
+            sustainerRate =
+                _updateApplyRates(_prevMemberData,
+                                  _currMemberData,
+                                  numOps - _lastRateUpdateOps,
+                                  durationCount<Milliseconds>(now - _lastRateUpdate) / 1000.0);
+        }
+        _lastRateUpdate = now;
+        _lastRateUpdateOps = numOps;
+    }
     const repl::OpTimeAndWallTime myLastApplied = _replCoord->getMyLastAppliedOpTimeAndWallTime();
     const repl::OpTimeAndWallTime lastCommitted = _replCoord->getLastCommittedOpTimeAndWallTime();
     const double locksPerOp = _getLocksPerOp();
@@ -361,6 +507,16 @@ int FlowControl::getNumTickets() {
                                             gFlowControlTicketAdderConstant.load(),
                                         gFlowControlTicketMultiplierConstant.load(),
                                         _kMaxTickets);
+        // Approaching the threshold, don't ramp up past the rate the model allows, which still
+        // exceeds the rate a majority applies at. This avoids overshooting into a lagged state. A
+        // lag past the threshold here comes from an idle system and is not throttled.
+        const auto lagMillis = getLagMillis(myLastApplied.wallTime, lastCommitted.wallTime);
+        if (sustainerRate >= 0.0 && lagMillis >= thresholdLagMillis / 2 &&
+            lagMillis < thresholdLagMillis) {
+            ret = std::min(
+                ret,
+                _calculateModelTickets(sustainerRate, locksPerOp, lagMillis, thresholdLagMillis));
+        }
         _lastTimeSustainerAdvanced = Date_t::now();
         if (_isLagged.load()) {
             _isLagged.store(false);
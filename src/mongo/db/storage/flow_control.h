@@ -30,6 +30,7 @@
 #pragma once
 
 #include <deque>
+#include <map>
 
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/operation_context.h"
@@ -104,6 +105,27 @@ public:
                                    std::uint64_t thresholdLagMillis);
     void _trimSamples(const Timestamp trimSamplesTo);
 
+    /**
+     * Folds the operations each member applied between `prevMemberData` and `currMemberData`, and
+     * the `opsWritten` by this node, into their smoothed per-second rates for a period of
+     * `periodSeconds`. Returns the smoothed rate that a majority of members is applying at, or -1.0
+     * if some member does not have a rate yet.
+     */
+    double _updateApplyRates(const std::vector<repl::MemberData>& prevMemberData,
+                             const std::vector<repl::MemberData>& currMemberData,
+                             std::uint64_t opsWritten,
+                             double periodSeconds);
+
+    /**
+     * Returns the tickets for the next period that bring the commit point lag from `lagMillis` to
+     * `thresholdLagMillis` over `flowControlLagCatchUpSeconds`, given that a majority of members
+     * applies `sustainerRate` operations per second.
+     */
+    int _calculateModelTickets(double sustainerRate,
+                               double locksPerOp,
+                               std::uint64_t lagMillis,
+                               std::uint64_t thresholdLagMillis);
+
     // Sample of (timestamp, ops, lock acquisitions) where ops and lock acquisitions are
     // observations of the corresponding counter at (roughly) <timestamp>.
     typedef std::tuple<std::uint64_t, std::uint64_t, std::int64_t> Sample;
@@ -142,6 +164,16 @@ private:
     // This value is used for calculating server status metrics.
     std::uint64_t _startWaitTime = 0;
 
+    // State of the apply rate model, in operations per second. A rate of -1.0 is not yet measured.
+    mutable Mutex _modelMutex = MONGO_MAKE_LATCH("FlowControl::_modelMutex");
+    std::map<repl::MemberId, double> _memberApplyRates;
+    double _primaryWriteRate = -1.0;
+    double _sustainerApplyRate = -1.0;
+    double _targetWriteRate = -1.0;
+
+    Date_t _lastRateUpdate;
+    std::uint64_t _lastRateUpdateOps = 0;
+
     PeriodicJobAnchor _jobAnchor;
 };
 
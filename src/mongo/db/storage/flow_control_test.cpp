@@ -245,4 +245,89 @@ TEST_F(FlowControlTest, CalculatingTickets) {
                                                       currLag,
                                                       thresholdLag));
 }
+
+TEST_F(FlowControlTest, ApplyRateModel) {
+    gFlowControlRateSmoothingFactor.store(0.5);
+    gFlowControlLagCatchUpSeconds.store(10);
+
+    auto constructMemberData = [](int memberId, Timestamp ts) -> repl::MemberData {
+        repl::MemberData ret;
+        ret.setMemberId(repl::MemberId(memberId));
+        ret.setLastAppliedOpTimeAndWallTime({{ts, 1}, Date_t()}, Date_t());
+        return ret;
+    };
+
+    // Construct samples where Timestamp X maps to operation number X.
+    for (int ts = 1; ts <= 5000; ++ts) {
+        flowControl->sample(Timestamp(ts), 1);
+    }
+
+    // Over a two second period the members apply 2000, 1000 and 600 operations while this node
+    // writes 2000. A majority applies at least 500 operations per second.
+    std::vector<repl::MemberData> prevMemberData{constructMemberData(0, Timestamp(1000)),
+                                                 constructMemberData(1, Timestamp(1000)),
+                                                 constructMemberData(2, Timestamp(1000))};
+    std::vector<repl::MemberData> currMemberData{constructMemberData(0, Timestamp(3000)),
+                                                 constructMemberData(1, Timestamp(2000)),
+                                                 constructMemberData(2, Timestamp(1600))};
+    ASSERT_EQ(500.0,
+              flowControl->_updateApplyRates(prevMemberData, currMemberData, 2000, 2.0));
+
+    // The next period, member 1 stalls. Its rate is smoothed with the previous one.
+    prevMemberData = currMemberData;
+    currMemberData = {constructMemberData(0, Timestamp(5000)),
+                      constructMemberData(1, Timestamp(2000)),
+                      constructMemberData(2, Timestamp(2600))};
+    ASSERT_EQ(400.0,
+              flowControl->_updateApplyRates(prevMemberData, currMemberData, 2000, 2.0));
+
+    // A member without a measurement leaves the model without a rate.
+    prevMemberData = currMemberData;
+    currMemberData.push_back(constructMemberData(3, Timestamp(2000)));
+    ASSERT_EQ(-1.0,
+              flowControl->_updateApplyRates(prevMemberData, currMemberData, 2000, 2.0));
+
+    // At the threshold, write at the majority's rate. One catch up window past the threshold,
+    // write at half of it, and close enough below, without limit.
+    const double locksPerOp = 2.0;
+    ASSERT_EQ(800, flowControl->_calculateModelTickets(400.0, locksPerOp, 5000, 5000));
+    ASSERT_EQ(400, flowControl->_calculateModelTickets(400.0, locksPerOp, 15000, 5000));
+    ASSERT_EQ(1000 * 1000 * 1000,
+              flowControl->_calculateModelTickets(400.0, locksPerOp, 0, 10000));
+
+    gFlowControlUseApplyRateModel.store(true);
+    ON_BLOCK_EXIT([] { gFlowControlUseApplyRateModel.store(false); });
+    BSONElement noopVar;
+    auto section = flowControl->generateSection(opCtx.get(), noopVar);
+    ASSERT_EQ(1000.0, section["applyRateModel"]["primaryWriteRate"].Double());
+    ASSERT_EQ(-1.0, section["applyRateModel"]["sustainerApplyRate"].Double());
+    ASSERT_EQ(-1.0, section["applyRateModel"]["targetWriteRate"].Double());
+    ASSERT_EQ(500.0, section["applyRateModel"]["memberApplyRates"]["0"].Double());
+    ASSERT_EQ(125.0, section["applyRateModel"]["memberApplyRates"]["1"].Double());
+}
+
+TEST_F(FlowControlTest, TicketsReleasedInSlices) {
+    auto ticketholder = FlowControlTicketholder::get(opCtx.get());
+    ticketholder->refreshTo(100, 10, Milliseconds(100));
+
+    // The first slice is available immediately.
+    FlowControlTicketholder::CurOp stats;
+    for (int i = 0; i < 10; ++i) {
+        ticketholder->getTicket(opCtx.get(), &stats);
+    }
+    ASSERT_EQ(10, stats.ticketsAcquired);
+    ASSERT_EQ(0, stats.acquireWaitCount);
+
+    // The next one waits for the second slice to be released.
+    ticketholder->getTicket(opCtx.get(), &stats);
+    ASSERT_EQ(11, stats.ticketsAcquired);
+    ASSERT_EQ(1, stats.acquireWaitCount);
+
+    // Without slices, every ticket is available immediately.
+    ticketholder->refreshTo(100);
+    for (int i = 0; i < 100; ++i) {
+        ticketholder->getTicket(opCtx.get(), &stats);
+    }
+    ASSERT_EQ(1, stats.acquireWaitCount);
+}
 }  // namespace mongo
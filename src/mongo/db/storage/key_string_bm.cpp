@@ -207,12 +207,39 @@ void BM_KeyStringStackBuilderCopy(benchmark::State& state, BsonValueType bsonTyp
     state.SetItemsProcessed(state.iterations() * kSampleSize);
 }
 
+void BM_KeyStringValueCompare(benchmark::State& state, BsonValueType bsonType) {
+    // The KeyString version does not matter for this test.
+    const auto version = KeyString::Version::V1;
+    const BsonsAndKeyStrings bsonsAndKeyStrings = generateBsonsAndKeyStrings(bsonType, version);
+
+    std::vector<KeyString::Value> values;
+    for (size_t i = 0; i < kSampleSize; i++) {
+        KeyString::HeapBuilder builder(version, bsonsAndKeyStrings.bsons[i], ALL_ASCENDING);
+        values.emplace_back(builder.release());
+    }
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        for (size_t i = 1; i < kSampleSize; i++) {
+            benchmark::DoNotOptimize(values[i - 1].compare(values[i]));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * bsonsAndKeyStrings.keystringSize);
+    state.SetItemsProcessed(state.iterations() * (kSampleSize - 1));
+}
+
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Int, INT);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Double, DOUBLE);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Decimal, DECIMAL);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, String, STRING);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Array, ARRAY);
 
+BENCHMARK_CAPTURE(BM_KeyStringValueCompare, Int, INT);
+BENCHMARK_CAPTURE(BM_KeyStringValueCompare, Double, DOUBLE);
+BENCHMARK_CAPTURE(BM_KeyStringValueCompare, Decimal, DECIMAL);
+BENCHMARK_CAPTURE(BM_KeyStringValueCompare, String, STRING);
+BENCHMARK_CAPTURE(BM_KeyStringValueCompare, Array, ARRAY);
+
 BENCHMARK_CAPTURE(BM_KeyStringHeapBuilderRelease, Int, INT);
 BENCHMARK_CAPTURE(BM_KeyStringHeapBuilderRelease, Double, DOUBLE);
 BENCHMARK_CAPTURE(BM_KeyStringHeapBuilderRelease, Decimal, DECIMAL);
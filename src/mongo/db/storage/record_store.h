@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <vector>
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/mutable/damage_vector.h"
@@ -171,6 +172,27 @@ public:
      */
     virtual boost::optional<Record> seekExact(const RecordId& id) = 0;
 
+    /**
+     * Seeks to the Record for each of the provided ids, returning the results in the same order as
+     * 'ids', with boost::none for ids that have no Record. The data of the returned Records is
+     * owned and remains valid across further use of the cursor.
+     *
+     * Implementations may perform the lookups in whatever order is cheapest for them. The
+     * resulting position of the cursor is unspecified; callers must seek before calling next().
+     */
+    virtual std::vector<boost::optional<Record>> seekExactBatch(const std::vector<RecordId>& ids) {
+        std::vector<boost::optional<Record>> records;
+        records.reserve(ids.size());
+        for (auto&& id : ids) {
+            auto record = seekExact(id);
+            if (record) {
+                record->data.makeOwned();
+            }
+            records.push_back(std::move(record));
+        }
+        return records;
+    }
+
     /**
      * Prepares for state changes in underlying data without necessarily saving the current
      * state.
@@ -186,6 +208,30 @@ public:
     }
 };
 
+/**
+ * Appends records to an empty RecordStore outside of any storage transaction, for callers that fill
+ * a newly created collection before it can be observed by anyone else.
+ *
+ * Appended records are assigned increasing RecordIds and are not rolled back if the enclosing
+ * WriteUnitOfWork aborts. The records may not be visible to readers until finish() has been
+ * called.
+ */
+class RecordStoreBulkLoader {
+public:
+    virtual ~RecordStoreBulkLoader() = default;
+
+    /**
+     * Copies the record data into the RecordStore and returns the id of the new record.
+     */
+    virtual StatusWith<RecordId> append(const char* data, int len) = 0;
+
+    /**
+     * Makes all appended records visible and accounts for them in the RecordStore's size
+     * information. No further records may be appended afterwards.
+     */
+    virtual Status finish() = 0;
+};
+
 /**
  * An abstraction used for storing documents in a collection or entries in an index.
  *
@@ -328,6 +374,16 @@ public:
         return inOutRecords.front().id;
     }
 
+    /**
+     * Returns a loader that appends records to this RecordStore without going through a storage
+     * transaction, or nullptr if the RecordStore does not support it in its current state. The
+     * RecordStore must be empty and the caller must hold an exclusive lock on the collection until
+     * the loader has been finished or destroyed.
+     */
+    virtual std::unique_ptr<RecordStoreBulkLoader> makeBulkLoader(OperationContext* opCtx) {
+        return nullptr;
+    }
+
     /**
      * Updates the record with id 'recordId', replacing its contents with those described by
      * 'data' and 'len'.
@@ -371,6 +427,16 @@ public:
     virtual std::unique_ptr<SeekableRecordCursor> getCursor(OperationContext* opCtx,
                                                             bool forward = true) const = 0;
 
+    /**
+     * Returns a new cursor like getCursor(), for a caller which intends to read through the record
+     * store sequentially from where the cursor starts, such as a collection scan. Storage engines
+     * may take the hint to read ahead of the cursor.
+     */
+    virtual std::unique_ptr<SeekableRecordCursor> getSequentialCursor(OperationContext* opCtx,
+                                                                      bool forward = true) const {
+        return getCursor(opCtx, forward);
+    }
+
     /**
      * Constructs a cursor over a record store that returns documents in a randomized order, and
      * allows storage engines to provide a more efficient way of random sampling of a record store
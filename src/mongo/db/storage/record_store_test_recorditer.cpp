@@ -483,5 +483,61 @@ TEST(RecordStoreTestHarness, SeekExactForMissingRecordReturnsNone) {
     ASSERT_FALSE(recordStore->findRecord(opCtx.get(), recordIds[1], &outputData));
 }
 
+// seekExactBatch() returns the requested records in the caller's order, whatever the order of
+// their record ids, with boost::none for records which do not exist.
+TEST(RecordStoreTestHarness, SeekExactBatchReturnsRecordsInRequestedOrder) {
+    const auto harnessHelper{newRecordStoreHarnessHelper()};
+    auto recordStore = harnessHelper->newNonCappedRecordStore();
+    ServiceContext::UniqueOperationContext opCtx{harnessHelper->newOperationContext()};
+
+    const int nToInsert = 20;
+    RecordId recordIds[nToInsert];
+    std::string datas[nToInsert];
+    for (int i = 0; i < nToInsert; ++i) {
+        StringBuilder sb;
+        sb << "record " << i;
+        datas[i] = sb.str();
+
+        WriteUnitOfWork uow{opCtx.get()};
+        auto res = recordStore->insertRecord(
+            opCtx.get(), datas[i].c_str(), datas[i].size() + 1, Timestamp{});
+        ASSERT_OK(res.getStatus());
+        recordIds[i] = res.getValue();
+        uow.commit();
+    }
+
+    {
+        WriteUnitOfWork uow{opCtx.get()};
+        recordStore->deleteRecord(opCtx.get(), recordIds[5]);
+        uow.commit();
+    }
+
+    const std::vector<int> requested = {12, 3, 5, 3, 19, 0, 13};
+    std::vector<RecordId> ids;
+    for (int i : requested) {
+        ids.push_back(recordIds[i]);
+    }
+
+    for (bool direction : {true, false}) {
+        auto cursor = recordStore->getCursor(opCtx.get(), direction);
+        auto records = cursor->seekExactBatch(ids);
+        ASSERT_EQ(requested.size(), records.size());
+        for (size_t i = 0; i < requested.size(); ++i) {
+            if (requested[i] == 5) {
+                ASSERT(!records[i]);
+                continue;
+            }
+            ASSERT(records[i]);
+            ASSERT_EQ(recordIds[requested[i]], records[i]->id);
+            ASSERT_EQ(datas[requested[i]], records[i]->data.data());
+        }
+
+        // The cursor can still be used to seek once the batch is done.
+        auto record = cursor->seekExact(recordIds[7]);
+        ASSERT(record);
+        ASSERT_EQ(datas[7], record->data.data());
+    }
+}
+
 }  // namespace
 }  // namespace mongo
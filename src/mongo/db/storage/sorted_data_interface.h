@@ -134,6 +134,14 @@ public:
                               long long* numKeysOut,
                               ValidateResults* fullResults) const = 0;
 
+    /**
+     * Returns statistics about the in-memory filter this index uses to skip duplicate key checks,
+     * or an empty object if it does not use one.
+     */
+    virtual BSONObj getDuplicateKeyFilterStats() const {
+        return BSONObj();
+    }
+
     virtual bool appendCustomStats(OperationContext* opCtx,
                                    BSONObjBuilder* output,
                                    double scale) const = 0;
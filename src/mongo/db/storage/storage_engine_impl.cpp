@@ -269,7 +269,7 @@ void StorageEngineImpl::_initCollection(OperationContext* opCtx,
         invariant(rs);
     }
 
-    auto uuid = _catalog->getCollectionOptions(opCtx, catalogId).uuid.get();
+    auto uuid = *md.options.uuid;
 
     auto collectionFactory = Collection::Factory::get(getGlobalServiceContext());
     auto collection = collectionFactory->make(opCtx, nss, catalogId, uuid, std::move(rs));
@@ -42,11 +42,12 @@ namespace mongo {
 WiredTigerCursor::WiredTigerCursor(const std::string& uri,
                                    uint64_t tableID,
                                    bool allowOverwrite,
-                                   OperationContext* opCtx) {
+                                   OperationContext* opCtx,
+                                   bool readOnce) {
     _tableID = tableID;
     _ru = WiredTigerRecoveryUnit::get(opCtx);
     _session = _ru->getSession();
-    _readOnce = _ru->getReadOnce();
+    _readOnce = readOnce || _ru->getReadOnce();
     _isCheckpoint =
         (_ru->getTimestampReadSource() == WiredTigerRecoveryUnit::ReadSource::kCheckpoint);
 
@@ -89,7 +90,7 @@ WiredTigerCursor::WiredTigerCursor(const std::string& uri,
 }
 
 WiredTigerCursor::~WiredTigerCursor() {
-    dassert(_ru->getReadOnce() == _readOnce);
+    dassert(_readOnce || !_ru->getReadOnce());
     dassert(_isCheckpoint ==
             (_ru->getTimestampReadSource() == WiredTigerRecoveryUnit::ReadSource::kCheckpoint));
 
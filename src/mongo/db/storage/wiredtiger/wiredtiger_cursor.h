@@ -47,11 +47,14 @@ public:
      * If 'allowOverwrite' is true, insert operations will not return an error if the record
      * already exists, and update/remove operations will not return error if the record does not
      * exist.
+     *
+     * The cursor is read-once if the recovery unit is, or if 'readOnce' is true.
      */
     WiredTigerCursor(const std::string& uri,
                      uint64_t tableID,
                      bool allowOverwrite,
-                     OperationContext* opCtx);
+                     OperationContext* opCtx,
+                     bool readOnce = false);
 
     ~WiredTigerCursor();
 
@@ -37,6 +37,7 @@
 #include <set>
 
 #include "mongo/base/checked_cast.h"
+#include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/index_catalog_entry.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/global_settings.h"
@@ -48,6 +49,7 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -55,6 +57,7 @@
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/hex.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 #define TRACING_ENABLED 0
@@ -662,7 +665,7 @@ private:
  */
 class WiredTigerIndex::UniqueBulkBuilder : public BulkBuilder {
 public:
-    UniqueBulkBuilder(WiredTigerIndex* idx,
+    UniqueBulkBuilder(WiredTigerIndexUnique* idx,
                       OperationContext* opCtx,
                       bool dupsAllowed,
                       KVPrefix prefix)
@@ -708,6 +711,10 @@ private:
             }
         }
 
+        _idx->addToKeyFilter(
+            newKeyString.getBuffer(),
+            KeyString::sizeWithoutRecordIdAtEnd(newKeyString.getBuffer(), newKeyString.getSize()));
+
         // Can't use WiredTigerCursor since we aren't using the cache.
         WiredTigerItem keyItem(newKeyString.getBuffer(), newKeyString.getSize());
         setKey(_cursor, keyItem.Get());
@@ -785,7 +792,7 @@ private:
         _records.clear();
     }
 
-    WiredTigerIndex* _idx;
+    WiredTigerIndexUnique* _idx;
     const bool _dupsAllowed;
     KeyString::Builder _previousKeyString;
     std::vector<std::pair<RecordId, KeyString::TypeBits>> _records;
@@ -1348,7 +1355,117 @@ WiredTigerIndexUnique::WiredTigerIndexUnique(OperationContext* ctx,
                                              const IndexDescriptor* desc,
                                              KVPrefix prefix,
                                              bool isReadOnly)
-    : WiredTigerIndex(ctx, uri, desc, prefix, isReadOnly), _partial(desc->isPartial()) {}
+    : WiredTigerIndex(ctx, uri, desc, prefix, isReadOnly), _partial(desc->isPartial()) {
+    if (!isReadOnly) {
+        _initKeyFilter(ctx, desc);
+    }
+}
+
+void WiredTigerIndexUnique::_initKeyFilter(OperationContext* opCtx, const IndexDescriptor* desc) {
+    const int bitsPerKey = gWiredTigerUniqueIndexKeyFilterBitsPerKey;
+    if (bitsPerKey == 0 || isIdIndex() || _prefix.isPrefixed() || !isTimestampSafeUniqueIdx()) {
+        return;
+    }
+
+    // Leave room for the index to double in size before the filter fills up.
+    const long long kMinCapacity = 1024;
+    long long capacity = kMinCapacity;
+    if (auto collection = desc->getCollection()) {
+        capacity = std::max(capacity, 2 * static_cast<long long>(collection->numRecords(opCtx)));
+    }
+
+    // A multikey index can have more keys than its collection has documents, in which case the
+    // filter is sized again from the number of keys found.
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        const long long maxSizeBytes =
+            static_cast<long long>(gWiredTigerUniqueIndexKeyFilterMaxSizeMB) * 1024 * 1024;
+        if (capacity / 8 * bitsPerKey > maxSizeBytes) {
+            LOGV2(5212026,
+                  "Not creating a duplicate key filter for index: it would be too large",
+                  "index"_attr = _indexName,
+                  "namespace"_attr = _collectionNamespace,
+                  "capacity"_attr = capacity);
+            return;
+        }
+
+        auto filter = std::make_unique<BlockedBloomFilter>(capacity, bitsPerKey);
+
+        // Scan the index on a session of its own. No other thread can insert into the index until
+        // this object is constructed, so every entry added later will go through
+        // addToKeyFilter().
+        auto session = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->getSession();
+        WT_CURSOR* c = session->getNewCursor(_uri, "read_once=true");
+        ON_BLOCK_EXIT([&] { session->closeCursor(c); });
+
+        const KeyString::TypeBits typeBits(getKeyStringVersion());
+        long long numKeys = 0;
+        int ret;
+        while ((ret = c->next(c)) == 0) {
+            WT_ITEM item;
+            getKey(c, &item);
+            const char* data = static_cast<const char*>(item.data);
+
+            // Keys in the timestamp unsafe format left by an upgrade hold only the index key, while
+            // the others also hold the RecordId.
+            size_t prefixKeySize = KeyString::getKeySize(data, item.size, _ordering, typeBits);
+            if (prefixKeySize != item.size) {
+                prefixKeySize = KeyString::sizeWithoutRecordIdAtEnd(data, item.size);
+            }
+            filter->insert(StringData(data, prefixKeySize));
+            ++numKeys;
+        }
+        if (ret != WT_NOTFOUND) {
+            LOGV2_WARNING(5212027,
+                          "Not creating a duplicate key filter for index: failed to scan it",
+                          "index"_attr = _indexName,
+                          "namespace"_attr = _collectionNamespace,
+                          "error"_attr = wtRCToStatus(ret));
+            return;
+        }
+
+        if (numKeys <= capacity / 2 || attempt > 0) {
+            _keyFilter = std::move(filter);
+            _keyFilterKeys.store(numKeys);
+            return;
+        }
+        capacity = 2 * numKeys;
+    }
+}
+
+void WiredTigerIndexUnique::addToKeyFilter(const char* prefixKey, size_t size) {
+    if (_keyFilter) {
+        _keyFilter->insert(StringData(prefixKey, size));
+        _keyFilterKeys.fetchAndAdd(1);
+    }
+}
+
+bool WiredTigerIndexUnique::_isKeyFilterUsable() const {
+    return _keyFilter &&
+        static_cast<uint64_t>(_keyFilterKeys.load()) <= _keyFilter->getCapacity();
+}
+
+bool WiredTigerIndexUnique::_keyFilterMayContain(const char* prefixKey, size_t size) const {
+    _keyFilterChecks.fetchAndAdd(1);
+    if (!_keyFilter->mayContain(StringData(prefixKey, size))) {
+        _keyFilterNegatives.fetchAndAdd(1);
+        return false;
+    }
+    return true;
+}
+
+BSONObj WiredTigerIndexUnique::getDuplicateKeyFilterStats() const {
+    if (!_keyFilter) {
+        return BSONObj();
+    }
+    BSONObjBuilder builder;
+    builder.append("sizeBytes", static_cast<long long>(_keyFilter->getSizeBytes()));
+    builder.append("capacity", static_cast<long long>(_keyFilter->getCapacity()));
+    builder.append("keys", _keyFilterKeys.load());
+    builder.append("checks", _keyFilterChecks.load());
+    builder.append("negatives", _keyFilterNegatives.load());
+    builder.append("falsePositives", _keyFilterFalsePositives.load());
+    return builder.obj();
+}
 
 std::unique_ptr<SortedDataInterface::Cursor> WiredTigerIndexUnique::newCursor(
     OperationContext* opCtx, bool forward) const {
@@ -1575,14 +1692,26 @@ Status WiredTigerIndexUnique::_insertTimestampSafe(OperationContext* opCtx,
         ret = WT_OP_CHECK(c->remove(c));
         invariantWTOK(ret);
 
-        // Second phase looks up for existence of key to avoid insertion of duplicate key
-        if (_keyExists(opCtx, c, keyString.getBuffer(), sizeWithoutRecordId)) {
-            auto key = KeyString::toBson(
-                keyString.getBuffer(), sizeWithoutRecordId, _ordering, keyString.getTypeBits());
-            return buildDupKeyErrorStatus(key, _collectionNamespace, _indexName, _keyPattern);
+        // Second phase looks up for existence of key to avoid insertion of duplicate key. The
+        // search is skipped when the key filter knows that the key is not in the index.
+        const bool useKeyFilter = _isKeyFilterUsable();
+        if (!useKeyFilter || _keyFilterMayContain(keyString.getBuffer(), sizeWithoutRecordId)) {
+            if (_keyExists(opCtx, c, keyString.getBuffer(), sizeWithoutRecordId)) {
+                auto key = KeyString::toBson(keyString.getBuffer(),
+                                             sizeWithoutRecordId,
+                                             _ordering,
+                                             keyString.getTypeBits());
+                return buildDupKeyErrorStatus(key, _collectionNamespace, _indexName, _keyPattern);
+            }
+            if (useKeyFilter) {
+                _keyFilterFalsePositives.fetchAndAdd(1);
+            }
         }
     }
 
+    addToKeyFilter(keyString.getBuffer(),
+                   KeyString::sizeWithoutRecordIdAtEnd(keyString.getBuffer(), keyString.getSize()));
+
     // Now create the table key/value, the actual data record.
     WiredTigerItem keyItem(keyString.getBuffer(), keyString.getSize());
 
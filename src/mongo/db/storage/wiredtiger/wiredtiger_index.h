@@ -38,6 +38,8 @@
 #include "mongo/db/storage/sorted_data_interface.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/blocked_bloom_filter.h"
 
 namespace mongo {
 
@@ -208,6 +210,14 @@ public:
 
     bool isDup(OperationContext* opCtx, WT_CURSOR* c, const KeyString::Value& keyString) override;
 
+    BSONObj getDuplicateKeyFilterStats() const override;
+
+    /**
+     * Records that an entry with the given prefix key, the index key without its RecordId, may now
+     * be in the index. Must be called before the entry is inserted.
+     */
+    void addToKeyFilter(const char* prefixKey, size_t size);
+
     Status _insert(OperationContext* opCtx,
                    WT_CURSOR* c,
                    const KeyString::Value& keyString,
@@ -244,7 +254,38 @@ private:
      */
     bool _keyExists(OperationContext* opCtx, WT_CURSOR* c, const char* buffer, size_t size);
 
+    /**
+     * Returns true if '_keyFilter' exists and has not been filled past its capacity.
+     */
+    bool _isKeyFilterUsable() const;
+
+    /**
+     * Returns false if no entry with the given prefix key can be in the index. Must only be called
+     * when _isKeyFilterUsable() is true.
+     */
+    bool _keyFilterMayContain(const char* prefixKey, size_t size) const;
+
+    /**
+     * Creates '_keyFilter' and adds the prefix key of every entry already in the index to it.
+     * Leaves '_keyFilter' null if the index is not eligible or the filter would be too large.
+     */
+    void _initKeyFilter(OperationContext* opCtx, const IndexDescriptor* desc);
+
     bool _partial;
+
+    // Only set for timestamp safe unique indexes when wiredTigerUniqueIndexKeyFilterBitsPerKey is
+    // non-zero. Holds the prefix key of every entry that may be in the index, so that inserts of
+    // keys it has never seen can skip the search for a duplicate. Keys are never removed from it,
+    // so entries that were deleted or whose transaction aborted only cause false positives.
+    std::unique_ptr<BlockedBloomFilter> _keyFilter;
+
+    // The number of keys added to '_keyFilter'. Once this exceeds its capacity, the filter is no
+    // longer consulted.
+    AtomicWord<long long> _keyFilterKeys{0};
+
+    mutable AtomicWord<long long> _keyFilterChecks{0};
+    mutable AtomicWord<long long> _keyFilterNegatives{0};
+    mutable AtomicWord<long long> _keyFilterFalsePositives{0};
 };
 
 class WiredTigerIndexStandard : public WiredTigerIndex {
@@ -79,6 +79,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_index.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
@@ -111,6 +112,10 @@ MONGO_FAIL_POINT_DEFINE(WTSetOldestTSToStableTS);
 
 MONGO_FAIL_POINT_DEFINE(pauseCheckpointThread);
 
+// Counts the checkpoints taken before checkpointDelaySecs elapsed because the amount of dirty data
+// reached wiredTigerCheckpointDirtyTriggerMB.
+AtomicWord<long long> checkpointsTriggeredByDirtyData;
+
 }  // namespace
 
 bool WiredTigerFileVersion::shouldDowngrade(bool readOnly,
@@ -453,13 +458,7 @@ public:
         while (!_shuttingDown.load()) {
             auto opCtx = tc->makeOperationContext();
 
-            {
-                stdx::unique_lock<Latch> lock(_mutex);
-                MONGO_IDLE_THREAD_BLOCK;
-                _condvar.wait_for(lock,
-                                  stdx::chrono::seconds(static_cast<std::int64_t>(
-                                      wiredTigerGlobalOptions.checkpointDelaySecs)));
-            }
+            _waitForNextCheckpoint();
 
             pauseCheckpointThread.pauseWhileSet();
 
@@ -594,6 +593,11 @@ public:
         return _oplogNeededForCrashRecovery.load();
     }
 
+    static void appendStats(BSONObjBuilder* builder) {
+        BSONObjBuilder bob(builder->subobjStart("checkpointScheduler"));
+        bob.append("triggeredByDirtyData", checkpointsTriggeredByDirtyData.load());
+    }
+
     /*
      * Atomically assign _oplogNeededForCrashRecovery to a variable.
      * _oplogNeededForCrashRecovery will not change during assignment.
@@ -615,6 +619,53 @@ public:
     }
 
 private:
+    /**
+     * Waits for checkpointDelaySecs, or until woken early. If wiredTigerCheckpointDirtyTriggerMB
+     * is set, also checks once a second how much data in the cache is dirty, and returns as soon
+     * as that reaches the trigger. Checkpointing as dirty data builds up, rather than only on the
+     * timer, spreads the checkpoint writes of a write-heavy workload into smaller, more frequent
+     * checkpoints instead of a burst every checkpointDelaySecs.
+     */
+    void _waitForNextCheckpoint() {
+        const Date_t deadline = Date_t::now() +
+            Seconds(static_cast<std::int64_t>(wiredTigerGlobalOptions.checkpointDelaySecs));
+
+        while (!_shuttingDown.load()) {
+            const std::int64_t dirtyTriggerBytes =
+                gWiredTigerCheckpointDirtyTriggerMB.load() * 1024LL * 1024;
+            const Milliseconds remaining = deadline - Date_t::now();
+            const Milliseconds timeout =
+                dirtyTriggerBytes > 0 ? std::min(remaining, Milliseconds(1000)) : remaining;
+
+            {
+                stdx::unique_lock<Latch> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+                if (_condvar.wait_for(lock, timeout.toSystemDuration()) ==
+                    stdx::cv_status::no_timeout) {
+                    return;
+                }
+            }
+
+            if (Date_t::now() >= deadline) {
+                return;
+            }
+
+            if (dirtyTriggerBytes > 0 && _getDirtyBytes() >= dirtyTriggerBytes) {
+                checkpointsTriggeredByDirtyData.addAndFetch(1);
+                return;
+            }
+        }
+    }
+
+    std::int64_t _getDirtyBytes() {
+        UniqueWiredTigerSession session = _sessionCache->getSession();
+        auto dirtyBytes = WiredTigerUtil::getStatisticsValue(session->getSession(),
+                                                             "statistics:",
+                                                             "statistics=(fast)",
+                                                             WT_STAT_CONN_CACHE_BYTES_DIRTY);
+        return dirtyBytes.isOK() ? dirtyBytes.getValue() : 0;
+    }
+
     WiredTigerKVEngine* _wiredTigerKVEngine;
     WiredTigerSessionCache* _sessionCache;
 
@@ -906,6 +957,10 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     _sessionSweeper = std::make_unique<WiredTigerSessionSweeper>(_sessionCache.get());
     _sessionSweeper->go();
 
+    _readAhead =
+        std::make_unique<WiredTigerReadAhead>(_sessionCache.get(), gWiredTigerReadAheadThreads);
+    _readAhead->startup();
+
     // Until the Replication layer installs a real callback, prevent truncating the oplog.
     setOldestActiveTransactionTimestampCallback(
         [](Timestamp) { return StatusWith(boost::make_optional(Timestamp::min())); });
@@ -979,6 +1034,7 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openWriteTransaction.used());
         bbb.append("available", openWriteTransaction.available());
         bbb.append("totalTickets", openWriteTransaction.outof());
+        openWriteTransaction.appendStats(&bbb);
         bbb.done();
     }
     {
@@ -986,9 +1042,12 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openReadTransaction.used());
         bbb.append("available", openReadTransaction.available());
         bbb.append("totalTickets", openReadTransaction.outof());
+        openReadTransaction.appendStats(&bbb);
         bbb.done();
     }
     bb.done();
+
+    WiredTigerCheckpointThread::appendStats(&b);
 }
 
 void WiredTigerKVEngine::_openWiredTiger(const std::string& path, const std::string& wtOpenConfig) {
@@ -1067,6 +1126,10 @@ void WiredTigerKVEngine::cleanShutdown() {
     }
 
     // these must be the last things we do before _conn->close();
+    if (_readAhead) {
+        LOGV2(5212009, "Shutting down read-ahead threads");
+        _readAhead->shutdown();
+    }
     if (_sessionSweeper) {
         LOGV2(22318, "Shutting down session sweeper thread");
         _sessionSweeper->shutdown();
@@ -52,6 +52,7 @@ namespace mongo {
 
 class ClockSource;
 class JournalListener;
+class WiredTigerReadAhead;
 class WiredTigerRecordStore;
 class WiredTigerSessionCache;
 class WiredTigerSizeStorer;
@@ -306,6 +307,13 @@ public:
         return _oplogManager.get();
     }
 
+    /**
+     * Returns the pool which reads ahead of sequential scans of this engine's tables.
+     */
+    WiredTigerReadAhead* getReadAhead() const {
+        return _readAhead.get();
+    }
+
     static void appendGlobalStats(BSONObjBuilder& b);
 
     Timestamp getStableTimestamp() const override;
@@ -461,6 +469,7 @@ private:
     const bool _keepDataHistory = true;
 
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
+    std::unique_ptr<WiredTigerReadAhead> _readAhead;  // Depends on _sessionCache
     std::unique_ptr<WiredTigerJournalFlusher> _journalFlusher;  // Depends on _sizeStorer
     std::unique_ptr<WiredTigerCheckpointThread> _checkpointThread;
 
@@ -48,6 +48,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/logger/logger.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
@@ -247,6 +248,25 @@ TEST_F(WiredTigerKVEngineRepairTest, UnrecoverableOrphanedDataFilesAreRebuilt) {
 #endif
 }
 
+TEST_F(WiredTigerKVEngineTest, ConcurrentWaitUntilDurableCallsAreGrouped) {
+    // Callers that arrive while a flush is in progress share the one that follows it, and every
+    // caller must return once a flush that started after its arrival has completed.
+    const int kThreads = 8;
+    const int kIterations = 20;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&] {
+            auto opCtxPtr = makeOperationContext();
+            for (int j = 0; j < kIterations; ++j) {
+                ASSERT_TRUE(opCtxPtr->recoveryUnit()->waitUntilDurable(opCtxPtr.get()));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
 TEST_F(WiredTigerKVEngineTest, TestOplogTruncation) {
     auto opCtxPtr = makeOperationContext();
     // The initial data timestamp has to be set to take stable checkpoints. The first stable
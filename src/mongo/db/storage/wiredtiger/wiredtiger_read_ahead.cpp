@@ -0,0 +1,174 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
+
+#include <wiredtiger.h>
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Returns the number of bytes read into the cache by operations on 'session' so far, or boost::none
+ * if the session's statistics are not available.
+ */
+boost::optional<long long> getBytesRead(WT_SESSION* session) {
+    WT_CURSOR* c = nullptr;
+    if (session->open_cursor(session, "statistics:session", nullptr, "statistics=(fast)", &c)) {
+        return boost::none;
+    }
+    ON_BLOCK_EXIT([&] { c->close(c); });
+
+    c->set_key(c, WT_STAT_SESSION_BYTES_READ);
+    if (c->search(c)) {
+        return boost::none;
+    }
+
+    const char* desc;
+    uint64_t value;
+    if (c->get_value(c, &desc, nullptr, &value)) {
+        return boost::none;
+    }
+    return WiredTigerUtil::castStatisticsValue<long long>(value);
+}
+
+}  // namespace
+
+WiredTigerReadAhead::WiredTigerReadAhead(WiredTigerSessionCache* sessionCache, size_t maxThreads)
+    : _sessionCache(sessionCache), _maxQueued(2 * maxThreads), _pool([&] {
+          ThreadPool::Options options;
+          options.poolName = "WiredTigerReadAhead";
+          options.threadNamePrefix = "WTReadAhead-";
+          options.minThreads = 0;
+          options.maxThreads = maxThreads;
+          return options;
+      }()) {}
+
+void WiredTigerReadAhead::startup() {
+    _pool.startup();
+}
+
+void WiredTigerReadAhead::shutdown() {
+    _pool.shutdown();
+    _pool.join();
+}
+
+void WiredTigerReadAhead::request(const std::string& uri,
+                                  const RecordId& start,
+                                  bool forward,
+                                  int numRecords,
+                                  const std::shared_ptr<AtomicWord<bool>>& inFlight) {
+    _requested.fetchAndAdd(1);
+    if (inFlight->swap(true)) {
+        _dropped.fetchAndAdd(1);
+        return;
+    }
+    if (static_cast<size_t>(_numQueued.fetchAndAdd(1)) >= _maxQueued) {
+        _numQueued.fetchAndSubtract(1);
+        inFlight->store(false);
+        _dropped.fetchAndAdd(1);
+        return;
+    }
+
+    _pool.schedule([this, uri, start, forward, numRecords, inFlight](Status status) {
+        ON_BLOCK_EXIT([&] {
+            _numQueued.fetchAndSubtract(1);
+            inFlight->store(false);
+        });
+        if (!status.isOK()) {
+            // The pool is shutting down.
+            _dropped.fetchAndAdd(1);
+            return;
+        }
+        _walk(uri, start, forward, numRecords);
+    });
+}
+
+void WiredTigerReadAhead::_walk(const std::string& uri,
+                                const RecordId& start,
+                                bool forward,
+                                int numRecords) {
+    auto session = _sessionCache->getSession();
+    WT_SESSION* s = session->getSession();
+
+    WT_CURSOR* c = nullptr;
+    if (int ret = s->open_cursor(s, uri.c_str(), nullptr, nullptr, &c)) {
+        // The table may have been dropped since the request was made.
+        LOGV2_DEBUG(5212008,
+                    2,
+                    "Could not open cursor for read-ahead on {uri}: {error}",
+                    "uri"_attr = uri,
+                    "error"_attr = wiredtiger_strerror(ret));
+        return;
+    }
+    ON_BLOCK_EXIT([&] { c->close(c); });
+
+    auto bytesReadBefore = getBytesRead(s);
+
+    // Any error, including running into a prepared update, simply ends the walk early.
+    c->set_key(c, start.repr());
+    int exact;
+    int ret = c->search_near(c, &exact);
+    for (int i = 0; ret == 0 && i < numRecords; ++i) {
+        ret = forward ? c->next(c) : c->prev(c);
+    }
+    c->reset(c);
+
+    auto bytesReadAfter = getBytesRead(s);
+    if (!bytesReadBefore || !bytesReadAfter) {
+        return;
+    }
+    const long long bytesRead = *bytesReadAfter - *bytesReadBefore;
+    if (bytesRead > 0) {
+        _readIntoCache.fetchAndAdd(1);
+        _bytesRead.fetchAndAdd(bytesRead);
+    } else {
+        _alreadyCached.fetchAndAdd(1);
+    }
+}
+
+void WiredTigerReadAhead::appendStats(BSONObjBuilder* builder) const {
+    BSONObjBuilder bob(builder->subobjStart("readAhead"));
+    bob.append("requested", _requested.load());
+    bob.append("dropped", _dropped.load());
+    bob.append("alreadyCached", _alreadyCached.load());
+    bob.append("readIntoCache", _readIntoCache.load());
+    bob.append("bytesRead", _bytesRead.load());
+}
+
+}  // namespace mongo
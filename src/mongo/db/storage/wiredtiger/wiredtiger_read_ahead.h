@@ -0,0 +1,99 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/record_id.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+
+class WiredTigerSessionCache;
+
+/**
+ * Reads ahead of sequential scans over WiredTiger tables on a small pool of background threads.
+ *
+ * A read-ahead request walks a window of records of a table, starting from a given key, on a
+ * session of its own. This pulls the pages holding those records into the WiredTiger cache while
+ * the scan which asked for it is still busy with the records before them, so that the scan does
+ * not stall on reading those pages itself.
+ */
+class WiredTigerReadAhead {
+    WiredTigerReadAhead(const WiredTigerReadAhead&) = delete;
+    WiredTigerReadAhead& operator=(const WiredTigerReadAhead&) = delete;
+
+public:
+    WiredTigerReadAhead(WiredTigerSessionCache* sessionCache, size_t maxThreads);
+
+    void startup();
+
+    /**
+     * Waits for the requests in progress to finish and drops those not yet started. Must be
+     * called before the session cache is shut down.
+     */
+    void shutdown();
+
+    /**
+     * Schedules a walk over the 'numRecords' records of the table 'uri' which follow 'start', in
+     * the direction given by 'forward'. 'inFlight' belongs to the scan making the request; it is
+     * set while the request is outstanding, and a scan's request is dropped if the previous one
+     * has not finished yet. Requests are also dropped when the pool is too far behind.
+     */
+    void request(const std::string& uri,
+                 const RecordId& start,
+                 bool forward,
+                 int numRecords,
+                 const std::shared_ptr<AtomicWord<bool>>& inFlight);
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    void _walk(const std::string& uri, const RecordId& start, bool forward, int numRecords);
+
+    WiredTigerSessionCache* const _sessionCache;
+    const size_t _maxQueued;
+    ThreadPool _pool;
+
+    AtomicWord<long long> _numQueued{0};
+
+    AtomicWord<long long> _requested{0};
+    AtomicWord<long long> _dropped{0};
+    // Requests which found all of their pages already in the cache ...
+    AtomicWord<long long> _alreadyCached{0};
+    // ... and those which had to read some of them.
+    AtomicWord<long long> _readIntoCache{0};
+    AtomicWord<long long> _bytesRead{0};
+};
+
+}  // namespace mongo
@@ -37,7 +37,9 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
 
 #include "mongo/base/checked_cast.h"
 #include "mongo/base/static_assert.h"
@@ -57,6 +59,8 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
@@ -65,6 +69,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/destructor_guard.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
@@ -155,6 +160,7 @@ public:
 
         stdx::lock_guard<Latch> lk(_oplogStones->_mutex);
         _oplogStones->_stones.clear();
+        _oplogStones->_stonesChanged = true;
     }
 
     void rollback() final {}
@@ -186,6 +192,7 @@ WiredTigerRecordStore::OplogStones::OplogStones(OperationContext* opCtx, WiredTi
     invariant(_minBytesPerStone > 0);
 
     _calculateStones(opCtx, numStonesToKeep);
+    _stonesChanged = !_stones.empty();
     _pokeReclaimThreadIfNeeded();  // Reclaim stones if over the limit.
 }
 
@@ -209,6 +216,10 @@ void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
         {
             MONGO_IDLE_THREAD_BLOCK;
             stdx::lock_guard<Latch> lk(_mutex);
+            if (_needsPersist_inlock()) {
+                // The stones changed and are persisted by the caller, see reclaimOplog().
+                break;
+            }
             if (hasExcessStones_inlock()) {
                 // There are now excess oplog stones. However, there it may be necessary to keep
                 // additional oplog.
@@ -230,11 +241,19 @@ void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
 }
 
 bool WiredTigerRecordStore::OplogStones::hasExcessStones_inlock() const {
+    if (_stones.empty()) {
+        return false;
+    }
+
     int64_t totalBytes = 0;
     for (auto&& stone : _stones) {
         totalBytes += stone.bytes;
     }
+    return _hasExcessStones_inlock(_stones.front(), totalBytes);
+}
 
+bool WiredTigerRecordStore::OplogStones::_hasExcessStones_inlock(const Stone& oldest,
+                                                                 int64_t totalBytes) const {
     // check that oplog stones is at capacity
     if (totalBytes <= _rs->cappedMaxSize()) {
         return false;
@@ -250,26 +269,70 @@ bool WiredTigerRecordStore::OplogStones::hasExcessStones_inlock() const {
 
     auto rc = repl::ReplicationCoordinator::get(getGlobalServiceContext());
     double lastAppliedTs = rc->getMyLastAppliedOpTime().getTimestamp().getSecs();
-    double lastStoneTs = Timestamp(_stones.front().lastRecord.repr()).getSecs();
+    double lastStoneTs = Timestamp(oldest.lastRecord.repr()).getSecs();
 
     double currRetentionHours = (lastAppliedTs - lastStoneTs) / kNumSecsInHour;
     return currRetentionHours >= minRetentionHours;
 }
 
-boost::optional<WiredTigerRecordStore::OplogStones::Stone>
-WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
+std::vector<WiredTigerRecordStore::OplogStones::Stone>
+WiredTigerRecordStore::OplogStones::peekOldestStonesIfNeeded(Timestamp mayTruncateUpTo) const {
     stdx::lock_guard<Latch> lk(_mutex);
 
-    if (!hasExcessStones_inlock()) {
-        return {};
+    int64_t totalBytes = 0;
+    for (auto&& stone : _stones) {
+        totalBytes += stone.bytes;
     }
 
-    return _stones.front();
+    std::vector<Stone> stones;
+    for (auto&& stone : _stones) {
+        if (!_hasExcessStones_inlock(stone, totalBytes)) {
+            break;
+        }
+
+        invariant(stone.lastRecord.isValid());
+        if (static_cast<std::uint64_t>(stone.lastRecord.repr()) >= mayTruncateUpTo.asULL()) {
+            // Do not truncate oplogs needed for replication recovery.
+            break;
+        }
+
+        stones.push_back(stone);
+        totalBytes -= stone.bytes;
+    }
+    return stones;
 }
 
-void WiredTigerRecordStore::OplogStones::popOldestStone() {
+void WiredTigerRecordStore::OplogStones::popOldestStones(size_t numStones) {
     stdx::lock_guard<Latch> lk(_mutex);
-    _stones.pop_front();
+    invariant(numStones <= _stones.size());
+    _stones.erase(_stones.begin(), _stones.begin() + numStones);
+    _stonesChanged = true;
+}
+
+void WiredTigerRecordStore::OplogStones::persistIfNeeded() {
+    BSONObjBuilder builder;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (!_needsPersist_inlock()) {
+            return;
+        }
+        _stonesChanged = false;
+
+        BSONArrayBuilder stonesBuilder(builder.subarrayStart("stones"));
+        for (auto&& stone : _stones) {
+            stonesBuilder.append(BSON("records" << stone.records << "bytes" << stone.bytes
+                                                << "lastRecord" << stone.lastRecord.repr()));
+        }
+    }
+    _rs->_sizeStorer->storeMetadata(_persistedStonesKey(), builder.obj());
+}
+
+bool WiredTigerRecordStore::OplogStones::_needsPersist_inlock() const {
+    return _stonesChanged && _rs->_sizeStorer;
+}
+
+std::string WiredTigerRecordStore::OplogStones::_persistedStonesKey() const {
+    return "oplogStones:" + _rs->getURI();
 }
 
 void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(RecordId lastRecord) {
@@ -298,6 +361,7 @@ void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(RecordId lastRec
                 "stones_size"_attr = _stones.size());
     OplogStones::Stone stone = {_currentRecords.swap(0), _currentBytes.swap(0), lastRecord};
     _stones.push_back(stone);
+    _stonesChanged = true;
 
     _pokeReclaimThreadIfNeeded();
 }
@@ -337,6 +401,7 @@ void WiredTigerRecordStore::OplogStones::updateStonesAfterCappedTruncateAfter(
     // Remove the stones corresponding to the records that were deleted.
     int64_t offset = _stones.size() - numStonesToRemove;
     _stones.erase(_stones.begin() + offset, _stones.end());
+    _stonesChanged = _stonesChanged || numStonesToRemove > 0;
 
     // Account for any remaining records from a partially truncated stone in the stone currently
     // being filled.
@@ -381,6 +446,10 @@ void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* opCt
         return;
     }
 
+    if (_calculateStonesFromPersisted(opCtx)) {
+        return;
+    }
+
     // Only use sampling to estimate where to place the oplog stones if the number of samples drawn
     // is less than 5% of the collection.
     const uint64_t kMinSampleRatioForRandCursor = 20;
@@ -403,6 +472,93 @@ void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* opCt
     _calculateStonesBySampling(opCtx, int64_t(estRecordsPerStone), int64_t(estBytesPerStone));
 }
 
+bool WiredTigerRecordStore::OplogStones::_calculateStonesFromPersisted(OperationContext* opCtx) {
+    if (!_rs->_sizeStorer) {
+        return false;
+    }
+
+    BSONObj persisted = _rs->_sizeStorer->loadMetadata(_persistedStonesKey());
+    if (persisted.isEmpty() || persisted["stones"].type() != Array) {
+        return false;
+    }
+
+    RecordId earliest;
+    RecordId latest;
+    {
+        auto record = _rs->getCursor(opCtx, /*forward=*/true)->next();
+        if (!record) {
+            return false;
+        }
+        earliest = record->id;
+    }
+    {
+        auto record = _rs->getCursor(opCtx, /*forward=*/false)->next();
+        if (!record) {
+            return false;
+        }
+        latest = record->id;
+    }
+
+    // Skip stones that were truncated after they were persisted, and stop at the first stone that
+    // ends past the end of the oplog, as its records were lost by an unclean shutdown.
+    std::deque<Stone> stones;
+    int64_t stonesBytes = 0;
+    for (auto&& elem : persisted["stones"].Obj()) {
+        if (elem.type() != Object) {
+            return false;
+        }
+        BSONObj obj = elem.Obj();
+        Stone stone = {obj["records"].safeNumberLong(),
+                       obj["bytes"].safeNumberLong(),
+                       RecordId(obj["lastRecord"].safeNumberLong())};
+        if (stone.lastRecord < earliest) {
+            continue;
+        }
+        if (stone.lastRecord > latest) {
+            break;
+        }
+        if (!stones.empty() && stone.lastRecord <= stones.back().lastRecord) {
+            return false;
+        }
+        stones.push_back(stone);
+        stonesBytes += stone.bytes;
+    }
+
+    if (stones.empty()) {
+        return false;
+    }
+
+    // Scanning the oplog written after the last persisted stone must remain cheap compared to
+    // sampling, otherwise the persisted stones are too far behind to be worth reusing.
+    int64_t tailBytes = _rs->dataSize(opCtx) - stonesBytes;
+    if (tailBytes > kMaxStonesToScanAfterPersisted * _minBytesPerStone) {
+        return false;
+    }
+
+    auto cursor = _rs->getCursor(opCtx, true);
+    if (!cursor->seekExact(stones.back().lastRecord)) {
+        return false;
+    }
+
+    _processBySampling.store(false);
+    LOGV2(5212012,
+          "Resuming oplog truncation markers from the persisted markers, scanning the oplog "
+          "after the newest one",
+          "numMarkers"_attr = stones.size(),
+          "newestMarker"_attr = Timestamp(stones.back().lastRecord.repr()).toStringPretty());
+
+    _stones = std::move(stones);
+    while (auto record = cursor->next()) {
+        _currentRecords.addAndFetch(1);
+        int64_t newCurrentBytes = _currentBytes.addAndFetch(record->data.size());
+        if (newCurrentBytes >= _minBytesPerStone) {
+            OplogStones::Stone stone = {_currentRecords.swap(0), _currentBytes.swap(0), record->id};
+            _stones.push_back(stone);
+        }
+    }
+    return true;
+}
+
 void WiredTigerRecordStore::OplogStones::_calculateStonesByScanning(OperationContext* opCtx) {
     _processBySampling.store(false);  // process by scanning
     LOGV2(22384, "Scanning the oplog to determine where to place markers for truncation");
@@ -544,7 +700,7 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesBySampling(OperationCon
 }
 
 void WiredTigerRecordStore::OplogStones::_pokeReclaimThreadIfNeeded() {
-    if (hasExcessStones_inlock()) {
+    if (hasExcessStones_inlock() || _needsPersist_inlock()) {
         _oplogReclaimCv.notify_one();
     }
 }
@@ -1043,6 +1199,16 @@ int64_t WiredTigerRecordStore::_cappedDeleteAsNeeded(OperationContext* opCtx,
     if (!cappedAndNeedDelete())
         return 0;
 
+    // Size-capped collections may overshoot by a batch before deleting, so that the side
+    // transaction a capped delete runs in is paid for once per batch rather than once per insert.
+    // Max docs has to be exact.
+    if (_cappedMaxDocs == -1) {
+        const auto batchBytes =
+            std::min<int64_t>(gWiredTigerCappedDeleteBatchBytes.load(), _cappedMaxSizeSlack);
+        if ((_sizeInfo->dataSize.load() - _cappedMaxSize) < batchBytes)
+            return 0;
+    }
+
     // ensure only one thread at a time can do deletes, otherwise they'll conflict.
     stdx::unique_lock<stdx::timed_mutex> lock(_cappedDeleterMutex, stdx::defer_lock);
 
@@ -1292,13 +1458,24 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx) {
 }
 
 void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayTruncateUpTo) {
-    Timer timer;
-    while (auto stone = _oplogStones->peekOldestStoneIfNeeded()) {
-        invariant(stone->lastRecord.isValid());
+    ON_BLOCK_EXIT([&] { _oplogStones->persistIfNeeded(); });
 
-        if (static_cast<std::uint64_t>(stone->lastRecord.repr()) >= mayTruncateUpTo.asULL()) {
-            // Do not truncate oplogs needed for replication recovery.
-            return;
+    auto stones = _oplogStones->peekOldestStonesIfNeeded(mayTruncateUpTo);
+    if (stones.empty()) {
+        return;
+    }
+
+    Timer timer;
+    while (!stones.empty()) {
+        // All of the excess stones are removed with a single range truncation. Concurrent readers
+        // aren't blocked, they continue to see the truncated records until their snapshot is
+        // refreshed.
+        const auto& lastStone = stones.back();
+        int64_t records = 0;
+        int64_t bytes = 0;
+        for (auto&& stone : stones) {
+            records += stone.records;
+            bytes += stone.bytes;
         }
 
         LOGV2_DEBUG(
@@ -1307,9 +1484,10 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
             "Truncating the oplog between {oplogStones_firstRecord} and {stone_lastRecord} to "
             "remove approximately {stone_records} records totaling to {stone_bytes} bytes",
             "oplogStones_firstRecord"_attr = _oplogStones->firstRecord,
-            "stone_lastRecord"_attr = stone->lastRecord,
-            "stone_records"_attr = stone->records,
-            "stone_bytes"_attr = stone->bytes);
+            "stone_lastRecord"_attr = lastStone.lastRecord,
+            "stone_records"_attr = records,
+            "stone_bytes"_attr = bytes,
+            "numStones"_attr = stones.size());
 
         WiredTigerRecoveryUnit* ru = WiredTigerRecoveryUnit::get(opCtx);
         WT_SESSION* session = ru->getSession()->getSession();
@@ -1324,32 +1502,34 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
             int ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return cursor->next(cursor); });
             invariantWTOK(ret);
             RecordId firstRecord = getKey(cursor);
-            if (firstRecord < _oplogStones->firstRecord || firstRecord > stone->lastRecord) {
+            if (firstRecord < _oplogStones->firstRecord || firstRecord > lastStone.lastRecord) {
                 LOGV2_WARNING(22407,
                               "First oplog record {firstRecord} is not in truncation range "
                               "({oplogStones_firstRecord}, {stone_lastRecord})",
                               "firstRecord"_attr = firstRecord,
                               "oplogStones_firstRecord"_attr = _oplogStones->firstRecord,
-                              "stone_lastRecord"_attr = stone->lastRecord);
+                              "stone_lastRecord"_attr = lastStone.lastRecord);
             }
 
-            setKey(cursor, stone->lastRecord);
+            setKey(cursor, lastStone.lastRecord);
             invariantWTOK(session->truncate(session, nullptr, nullptr, cursor, nullptr));
-            _changeNumRecords(opCtx, -stone->records);
-            _increaseDataSize(opCtx, -stone->bytes);
+            _changeNumRecords(opCtx, -records);
+            _increaseDataSize(opCtx, -bytes);
 
             wuow.commit();
 
-            // Remove the stone after a successful truncation.
-            _oplogStones->popOldestStone();
+            // Remove the stones after a successful truncation.
+            _oplogStones->popOldestStones(stones.size());
 
             // Stash the truncate point for next time to cleanly skip over tombstones, etc.
-            _oplogStones->firstRecord = stone->lastRecord;
-            _cappedFirstRecord = stone->lastRecord;
+            _oplogStones->firstRecord = lastStone.lastRecord;
+            _cappedFirstRecord = lastStone.lastRecord;
         } catch (const WriteConflictException&) {
             LOGV2_DEBUG(
                 22400, 1, "Caught WriteConflictException while truncating oplog entries, retrying");
         }
+
+        stones = _oplogStones->peekOldestStonesIfNeeded(mayTruncateUpTo);
     }
 
     LOGV2_DEBUG(22401,
@@ -1451,6 +1631,94 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
     return Status::OK();
 }
 
+/**
+ * Appends records to an empty, unprefixed record store through a WiredTiger bulk cursor.
+ *
+ * The bulk cursor lives in its own session so that it does not interfere with the transaction of
+ * the caller, and its writes are not part of any transaction.
+ */
+class WiredTigerRecordStore::BulkLoader final : public RecordStoreBulkLoader {
+public:
+    BulkLoader(WiredTigerRecordStore* rs,
+               OperationContext* opCtx,
+               UniqueWiredTigerSession session,
+               WT_CURSOR* cursor)
+        : _rs(rs), _opCtx(opCtx), _session(std::move(session)), _cursor(cursor) {}
+
+    ~BulkLoader() {
+        DESTRUCTOR_GUARD({ finish().ignore(); });
+    }
+
+    StatusWith<RecordId> append(const char* data, int len) final {
+        invariant(_cursor);
+        RecordId id = _rs->_nextId(_opCtx);
+        _rs->setKey(_cursor, id);
+        WiredTigerItem value(data, len);
+        _cursor->set_value(_cursor, value.Get());
+        int ret = WT_OP_CHECK(_cursor->insert(_cursor));
+        if (ret)
+            return wtRCToStatus(ret, "WiredTigerRecordStore::BulkLoader::append");
+        ++_numRecords;
+        _dataSize += len;
+        return id;
+    }
+
+    Status finish() final {
+        if (!_cursor) {
+            return Status::OK();
+        }
+
+        int ret = _cursor->close(_cursor);
+        _cursor = nullptr;
+
+        // The appended records cannot be rolled back, so neither can their size adjustments.
+        _rs->_changeNumRecords(nullptr, _numRecords);
+        _rs->_increaseDataSize(nullptr, _dataSize);
+        return wtRCToStatus(ret, "WiredTigerRecordStore::BulkLoader::finish");
+    }
+
+private:
+    WiredTigerRecordStore* const _rs;
+    OperationContext* const _opCtx;
+    UniqueWiredTigerSession const _session;
+    WT_CURSOR* _cursor;
+    int64_t _numRecords = 0;
+    int64_t _dataSize = 0;
+};
+
+std::unique_ptr<RecordStoreBulkLoader> WiredTigerRecordStore::makeBulkLoader(
+    OperationContext* opCtx) {
+    if (_isCapped || _isOplog || numRecords(opCtx) != 0) {
+        return nullptr;
+    }
+
+    // Seed the RecordId counter before closing our cursors, since doing so opens one.
+    _initNextIdIfNeeded(opCtx);
+
+    // Open cursors can cause bulk open_cursor to fail with EBUSY.
+    WiredTigerRecoveryUnit* ru = _getRecoveryUnit(opCtx);
+    ru->getSession()->closeAllCursors(_uri);
+
+    // Use a different session to ensure we don't hijack an existing transaction. Fail quickly
+    // rather than waiting for a checkpoint to complete, and let the caller fall back to regular
+    // inserts.
+    auto session = ru->getSessionCache()->getSession();
+    WT_SESSION* wtSession = session->getSession();
+    WT_CURSOR* cursor;
+    int ret = wtSession->open_cursor(
+        wtSession, _uri.c_str(), nullptr, "bulk,checkpoint_wait=false", &cursor);
+    if (ret) {
+        LOGV2_DEBUG(5212010,
+                    1,
+                    "Failed to open WiredTiger bulk cursor for record store",
+                    "uri"_attr = _uri,
+                    "error"_attr = wiredtiger_strerror(ret));
+        return nullptr;
+    }
+
+    return std::make_unique<BulkLoader>(this, opCtx, std::move(session), cursor);
+}
+
 bool WiredTigerRecordStore::isOpHidden_forTest(const RecordId& id) const {
     invariant(id.repr() > 0);
     invariant(_kvEngine->getOplogManager()->isRunning());
@@ -1873,7 +2141,8 @@ void WiredTigerRecordStore::_changeNumRecords(OperationContext* opCtx, int64_t d
         return;
     }
 
-    opCtx->recoveryUnit()->registerChange(std::make_unique<NumRecordsChange>(this, diff));
+    if (opCtx)
+        opCtx->recoveryUnit()->registerChange(std::make_unique<NumRecordsChange>(this, diff));
     if (_sizeInfo->numRecords.fetchAndAdd(diff) < 0)
         _sizeInfo->numRecords.store(std::max(diff, int64_t(0)));
 }
@@ -2086,10 +2355,37 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     WT_ITEM value;
     invariantWTOK(c->get_value(c, &value));
 
+    if (_readAhead && ++_recordsSinceReadAhead >= _readAheadWindow) {
+        // Reading two windows ahead keeps the pages for the window after this one coming in while
+        // we work through the current one.
+        _recordsSinceReadAhead = 0;
+        _readAhead->request(_rs.getURI(), id, _forward, 2 * _readAheadWindow, _readAheadInFlight);
+    }
+
     _lastReturnedId = id;
     return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
 }
 
+void WiredTigerRecordStoreCursorBase::enableReadAhead(int window) {
+    invariant(window > 0);
+    if (_rs._isOplog || !_rs._kvEngine || !_rs._kvEngine->getReadAhead()) {
+        return;
+    }
+    _readAhead = _rs._kvEngine->getReadAhead();
+    _readAheadWindow = window;
+    // Make the first call to next() ask for the first window.
+    _recordsSinceReadAhead = window - 1;
+    _readAheadInFlight = std::make_shared<AtomicWord<bool>>(false);
+}
+
+void WiredTigerRecordStoreCursorBase::enableReadOnce() {
+    invariant(_lastReturnedId.isNull());
+    _readOnce = true;
+    if (_cursor) {
+        _cursor.emplace(_rs.getURI(), _rs.tableId(), true, _opCtx, _readOnce);
+    }
+}
+
 boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordId& id) {
     invariant(_hasRestored);
     if (_oplogVisibleTs && id.repr() > *_oplogVisibleTs) {
@@ -2117,6 +2413,75 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordI
     return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
 }
 
+std::vector<boost::optional<Record>> WiredTigerRecordStoreCursorBase::seekExactBatch(
+    const std::vector<RecordId>& ids) {
+    invariant(_hasRestored);
+
+    // Visit the ids in key order, so that each lookup starts from where the last one left off.
+    std::vector<size_t> order(ids.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        return ids[lhs] < ids[rhs];
+    });
+
+    // Nearby records are reached by stepping the cursor forward at most this many times, rather
+    // than with a search from the root of the tree.
+    const int kMaxForwardSteps = 4;
+
+    WT_CURSOR* c = _cursor->get();
+    std::vector<boost::optional<Record>> records(ids.size());
+    // The record the WT cursor is positioned on, if any.
+    RecordId positionedOn;
+    auto updatePosition = [&](int ret) {
+        if (ret == WT_NOTFOUND) {
+            positionedOn = RecordId();
+            return;
+        }
+        invariantWTOK(ret);
+        RecordId key;
+        if (hasWrongPrefix(c, &key)) {
+            positionedOn = RecordId();
+            return;
+        }
+        positionedOn = key.isValid() ? key : getKey(c);
+    };
+
+    for (auto&& ix : order) {
+        const RecordId& id = ids[ix];
+        if (_oplogVisibleTs && id.repr() > *_oplogVisibleTs) {
+            // The remaining ids are all larger, so none of them are visible either.
+            break;
+        }
+
+        for (int step = 0; positionedOn.isValid() && positionedOn < id && step < kMaxForwardSteps;
+             ++step) {
+            updatePosition(wiredTigerPrepareConflictRetry(_opCtx, [&] { return c->next(c); }));
+        }
+
+        if (!positionedOn.isValid() || positionedOn < id) {
+            setKey(c, id);
+            int exact;
+            updatePosition(
+                wiredTigerPrepareConflictRetry(_opCtx, [&] { return c->search_near(c, &exact); }));
+        }
+
+        if (positionedOn == id) {
+            WT_ITEM value;
+            invariantWTOK(c->get_value(c, &value));
+            records[ix] = Record{
+                id,
+                RecordData(static_cast<const char*>(value.data), static_cast<int>(value.size))
+                    .getOwned()};
+        }
+    }
+
+    // Leave the cursor as if it had run off the end, since its position no longer corresponds to
+    // '_lastReturnedId'.
+    _skipNextAdvance = false;
+    _eof = true;
+    return records;
+}
+
 
 void WiredTigerRecordStoreCursorBase::save() {
     try {
@@ -2143,7 +2508,7 @@ bool WiredTigerRecordStoreCursorBase::restore() {
     }
 
     if (!_cursor)
-        _cursor.emplace(_rs.getURI(), _rs.tableId(), true, _opCtx);
+        _cursor.emplace(_rs.getURI(), _rs.tableId(), true, _opCtx, _readOnce);
 
     // This will ensure an active session exists, so any restored cursors will bind to it
     invariant(WiredTigerRecoveryUnit::get(_opCtx)->getSession() == _cursor->getSession());
@@ -2242,6 +2607,27 @@ std::unique_ptr<SeekableRecordCursor> StandardWiredTigerRecordStore::getCursor(
     return std::make_unique<WiredTigerRecordStoreStandardCursor>(opCtx, *this, forward);
 }
 
+std::unique_ptr<SeekableRecordCursor> StandardWiredTigerRecordStore::getSequentialCursor(
+    OperationContext* opCtx, bool forward) const {
+    auto cursor = getCursor(opCtx, forward);
+    auto wtCursor = checked_cast<WiredTigerRecordStoreCursorBase*>(cursor.get());
+
+    // A scan through a collection this large would push the working set out of the cache, so let
+    // WiredTiger evict what it reads first. Reading ahead of such a scan would defeat that.
+    const long long readOnceMinBytes =
+        static_cast<long long>(gWiredTigerReadOnceCollectionScanMinSizeMB.load()) * 1024 * 1024;
+    if (!_isOplog && readOnceMinBytes > 0 && dataSize(opCtx) >= readOnceMinBytes) {
+        wtCursor->enableReadOnce();
+        return cursor;
+    }
+
+    const int window = gWiredTigerReadAheadRecords.load();
+    if (window > 0) {
+        wtCursor->enableReadAhead(window);
+    }
+    return cursor;
+}
+
 std::unique_ptr<RecordCursor> StandardWiredTigerRecordStore::getRandomCursorWithOptions(
     OperationContext* opCtx, StringData extraConfig) const {
     return std::make_unique<RandomCursor>(opCtx, *this, extraConfig);
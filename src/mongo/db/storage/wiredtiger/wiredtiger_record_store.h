@@ -65,6 +65,7 @@
 namespace mongo {
 
 class RecoveryUnit;
+class WiredTigerReadAhead;
 class WiredTigerSessionCache;
 class WiredTigerSizeStorer;
 
@@ -149,6 +150,8 @@ public:
                                  std::vector<Record>* records,
                                  const std::vector<Timestamp>& timestamps);
 
+    std::unique_ptr<RecordStoreBulkLoader> makeBulkLoader(OperationContext* opCtx) override;
+
     virtual Status updateRecord(OperationContext* opCtx,
                                 const RecordId& recordId,
                                 const char* data,
@@ -280,6 +283,7 @@ protected:
 
 private:
     class RandomCursor;
+    class BulkLoader;
 
     class NumRecordsChange;
     class DataSizeChange;
@@ -400,6 +404,9 @@ public:
     virtual std::unique_ptr<SeekableRecordCursor> getCursor(OperationContext* opCtx,
                                                             bool forward) const override;
 
+    std::unique_ptr<SeekableRecordCursor> getSequentialCursor(OperationContext* opCtx,
+                                                              bool forward) const override;
+
     virtual std::unique_ptr<RecordCursor> getRandomCursorWithOptions(
         OperationContext* opCtx, StringData extraConfig) const override;
 
@@ -426,6 +433,11 @@ public:
         return _prefix;
     }
 
+    std::unique_ptr<RecordStoreBulkLoader> makeBulkLoader(OperationContext* opCtx) override {
+        // Prefixed record stores share their table with other collections.
+        return nullptr;
+    }
+
 protected:
     virtual RecordId getKey(WT_CURSOR* cursor) const;
 
@@ -445,6 +457,8 @@ public:
 
     boost::optional<Record> seekExact(const RecordId& id);
 
+    std::vector<boost::optional<Record>> seekExactBatch(const std::vector<RecordId>& ids) override;
+
     void save();
 
     void saveUnpositioned();
@@ -455,6 +469,20 @@ public:
 
     void reattachToOperationContext(OperationContext* opCtx);
 
+    /**
+     * Makes the cursor ask the engine's WiredTigerReadAhead to read 'window' records ahead of it
+     * each time it has returned that many records from next(). Only suitable for cursors over
+     * tables keyed by RecordId alone. Does nothing for the oplog.
+     */
+    void enableReadAhead(int window);
+
+    /**
+     * Makes the cursor read-once, so that WiredTiger evicts the pages it reads in preference to
+     * others instead of letting them displace the working set. Must be called before the cursor is
+     * positioned.
+     */
+    void enableReadOnce();
+
 protected:
     virtual RecordId getKey(WT_CURSOR* cursor) const = 0;
 
@@ -486,6 +514,15 @@ protected:
 private:
     bool isVisible(const RecordId& id);
 
+    // Set by enableReadOnce().
+    bool _readOnce = false;
+
+    // Set by enableReadAhead().
+    WiredTigerReadAhead* _readAhead = nullptr;
+    int _readAheadWindow = 0;
+    int _recordsSinceReadAhead = 0;
+    std::shared_ptr<AtomicWord<bool>> _readAheadInFlight;
+
     /**
      * This value is used for visibility calculations on what oplog entries can be returned to a
      * client. This value *must* be initialized/updated *before* a WiredTiger snapshot is
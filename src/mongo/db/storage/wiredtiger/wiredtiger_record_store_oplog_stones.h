@@ -30,6 +30,8 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <string>
+#include <vector>
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/platform/atomic_word.h"
@@ -69,9 +71,20 @@ public:
         }
     }
 
-    boost::optional<OplogStones::Stone> peekOldestStoneIfNeeded() const;
+    /**
+     * Returns the oldest stones that can be truncated because the oplog exceeds its maximum size,
+     * limited to those ending before 'mayTruncateUpTo'. The stones are ordered from oldest to
+     * newest so that a single range truncation can remove all of them.
+     */
+    std::vector<OplogStones::Stone> peekOldestStonesIfNeeded(Timestamp mayTruncateUpTo) const;
 
-    void popOldestStone();
+    void popOldestStones(size_t numStones);
+
+    /**
+     * Writes the current stones to the size storer if they changed since they were last written,
+     * so that they can be reused instead of being recomputed on the next startup.
+     */
+    void persistIfNeeded();
 
     void createNewStoneIfNeeded(RecordId lastRecord);
 
@@ -117,7 +130,11 @@ private:
     class InsertChange;
     class TruncateChange;
 
+    bool _hasExcessStones_inlock(const Stone& oldest, int64_t totalBytes) const;
+    bool _needsPersist_inlock() const;
+
     void _calculateStones(OperationContext* opCtx, size_t size);
+    bool _calculateStonesFromPersisted(OperationContext* opCtx);
     void _calculateStonesByScanning(OperationContext* opCtx);
     void _calculateStonesBySampling(OperationContext* opCtx,
                                     int64_t estRecordsPerStone,
@@ -125,8 +142,14 @@ private:
 
     void _pokeReclaimThreadIfNeeded();
 
+    std::string _persistedStonesKey() const;
+
     static const uint64_t kRandomSamplesPerStone = 10;
 
+    // Upper bound on the estimated amount of oplog past the last persisted stone, in stones, for
+    // which scanning it at startup is preferred over sampling the whole oplog.
+    static const int64_t kMaxStonesToScanAfterPersisted = 4;
+
     WiredTigerRecordStore* _rs;
 
     Mutex _oplogReclaimMutex;
@@ -149,6 +172,10 @@ private:
     // Protects against concurrent access to the deque of oplog stones.
     mutable Mutex _mutex = MONGO_MAKE_LATCH("OplogStones::_mutex");
     std::deque<OplogStones::Stone> _stones;  // front = oldest, back = newest.
+
+    // Whether '_stones' changed since they were last written by persistIfNeeded(). Only ever set
+    // when the record store has a size storer to persist the stones to.
+    bool _stonesChanged = false;
 };
 
 }  // namespace mongo
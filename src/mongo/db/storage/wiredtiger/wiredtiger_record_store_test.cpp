@@ -43,6 +43,7 @@
 #include "mongo/db/operation_context_noop.h"
 #include "mongo/db/storage/kv/kv_prefix.h"
 #include "mongo/db/storage/record_store_test_harness.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
@@ -152,6 +153,132 @@ TEST(WiredTigerRecordStoreTest, Isolation1) {
     }
 }
 
+// Reading ahead of a sequential cursor must not change what the cursor returns, in either
+// direction.
+TEST(WiredTigerRecordStoreTest, BulkLoaderAppendsToEmptyRecordStore) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+    std::vector<RecordId> ids;
+    {
+        auto loader = rs->makeBulkLoader(opCtx.get());
+        ASSERT(loader);
+        for (int i = 0; i < 10; i++) {
+            auto data = std::to_string(i);
+            auto res = loader->append(data.c_str(), data.size() + 1);
+            ASSERT_OK(res.getStatus());
+            if (!ids.empty()) {
+                ASSERT_GT(res.getValue(), ids.back());
+            }
+            ids.push_back(res.getValue());
+        }
+        ASSERT_OK(loader->finish());
+    }
+
+    ASSERT_EQ(10, rs->numRecords(opCtx.get()));
+    {
+        auto cursor = rs->getCursor(opCtx.get());
+        for (int i = 0; i < 10; i++) {
+            auto record = cursor->next();
+            ASSERT(record);
+            ASSERT_EQ(ids[i], record->id);
+            ASSERT_EQ(std::to_string(i), record->data.data());
+        }
+        ASSERT_FALSE(cursor->next());
+    }
+
+    // Regular inserts continue after the bulk loaded records.
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        auto res = rs->insertRecord(opCtx.get(), "a", 2, Timestamp());
+        ASSERT_OK(res.getStatus());
+        ASSERT_GT(res.getValue(), ids.back());
+        uow.commit();
+    }
+
+    // Bulk loading is limited to empty record stores.
+    ASSERT_FALSE(rs->makeBulkLoader(opCtx.get()));
+}
+
+TEST(WiredTigerRecordStoreTest, BulkLoaderUnsupportedForCappedRecordStore) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newCappedRecordStore("a.b", 100000, 10000));
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    ASSERT_FALSE(rs->makeBulkLoader(opCtx.get()));
+}
+
+TEST(WiredTigerRecordStoreTest, SequentialCursorWithReadAhead) {
+    const int window = 10;
+    gWiredTigerReadAheadRecords.store(window);
+    ON_BLOCK_EXIT([] { gWiredTigerReadAheadRecords.store(0); });
+
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const int nToInsert = 10 * window + 3;
+    std::vector<RecordId> ids;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        for (int i = 0; i < nToInsert; ++i) {
+            StatusWith<RecordId> res = rs->insertRecord(opCtx.get(), "a", 2, Timestamp());
+            ASSERT_OK(res.getStatus());
+            ids.push_back(res.getValue());
+        }
+        uow.commit();
+    }
+
+    for (bool forward : {true, false}) {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        auto cursor = rs->getSequentialCursor(opCtx.get(), forward);
+        for (int i = 0; i < nToInsert; ++i) {
+            auto record = cursor->next();
+            ASSERT(record);
+            ASSERT_EQ(forward ? ids[i] : ids[nToInsert - 1 - i], record->id);
+        }
+        ASSERT(!cursor->next());
+    }
+}
+
+// A read-once sequential cursor over a large collection must return the same records, across a
+// save and restore, as any other cursor.
+TEST(WiredTigerRecordStoreTest, SequentialCursorReadOnceOverLargeCollection) {
+    gWiredTigerReadOnceCollectionScanMinSizeMB.store(1);
+    ON_BLOCK_EXIT([] { gWiredTigerReadOnceCollectionScanMinSizeMB.store(0); });
+
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const int nToInsert = 20;
+    const std::string data(64 * 1024, 'a');
+    std::vector<RecordId> ids;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        for (int i = 0; i < nToInsert; ++i) {
+            StatusWith<RecordId> res =
+                rs->insertRecord(opCtx.get(), data.c_str(), data.size(), Timestamp());
+            ASSERT_OK(res.getStatus());
+            ids.push_back(res.getValue());
+        }
+        uow.commit();
+    }
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    ASSERT_GTE(rs->dataSize(opCtx.get()), 1024 * 1024);
+    auto cursor = rs->getSequentialCursor(opCtx.get(), true);
+    for (int i = 0; i < nToInsert; ++i) {
+        auto record = cursor->next();
+        ASSERT(record);
+        ASSERT_EQ(ids[i], record->id);
+
+        cursor->save();
+        cursor->restore();
+    }
+    ASSERT(!cursor->next());
+}
+
 TEST(WiredTigerRecordStoreTest, Isolation2) {
     const auto harnessHelper(newRecordStoreHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
@@ -260,6 +387,43 @@ TEST(WiredTigerRecordStoreTest, CappedCursorRollover) {
     ASSERT(!cursor->next());
 }
 
+TEST(WiredTigerRecordStoreTest, CappedDeleteBatchBytes) {
+    // The slack of a 100000 byte capped collection is 10000 bytes, which bounds the batch.
+    const int64_t cappedMaxSize = 100000;
+    const int64_t batchBytes = 5000;
+    gWiredTigerCappedDeleteBatchBytes.store(batchBytes);
+    ON_BLOCK_EXIT([] { gWiredTigerCappedDeleteBatchBytes.store(0); });
+
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newCappedRecordStore("a.b", cappedMaxSize, -1));
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+    const std::string data(100, 'x');
+    bool overshot = false;
+    int64_t lastSize = 0;
+    int deletions = 0;
+    for (int i = 0; i < 5000; ++i) {
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_OK(
+            rs->insertRecord(opCtx.get(), data.c_str(), data.size(), Timestamp()).getStatus());
+        uow.commit();
+
+        const auto size = rs->dataSize(opCtx.get());
+        ASSERT_LTE(size, cappedMaxSize + batchBytes + int64_t(data.size()));
+        overshot = overshot || size > cappedMaxSize + int64_t(data.size());
+        if (size < lastSize) {
+            // A batch deletes back down to the maximum size.
+            ASSERT_LTE(size, cappedMaxSize);
+            ++deletions;
+        }
+        lastSize = size;
+    }
+    ASSERT(overshot);
+    // Without batching, every insert past the maximum size would have deleted.
+    ASSERT_GT(deletions, 0);
+    ASSERT_LT(deletions, 100);
+}
+
 RecordId _oplogOrderInsertOplog(OperationContext* opCtx,
                                 const unique_ptr<RecordStore>& rs,
                                 int inc) {
@@ -45,6 +45,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/future.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -307,19 +308,56 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
         return;
     }
 
-    uint32_t start = _lastSyncTime.load();
-    // Do the remainder in a critical section that ensures only a single thread at a time
-    // will attempt to synchronize.
+    // Group commit: writers which arrive while a flush is in progress are all made durable by the
+    // single flush which follows it. The first of them leads that flush once the current one has
+    // completed, and the others wait on its shared result.
     stdx::unique_lock<Latch> lk(_lastSyncMutex);
-    uint32_t current = _lastSyncTime.loadRelaxed();  // synchronized with writes through mutex
-    if (current != start) {
-        // Someone else synced already since we read lastSyncTime, so we're done!
+    if (_nextFlush) {
+        auto nextFlush = _nextFlush->getFuture();
+        lk.unlock();
+        nextFlush.get();
         return;
     }
-    _lastSyncTime.store(current + 1);
 
-    // Nobody has synched yet, so we have to sync ourselves.
+    if (_currentFlush) {
+        _nextFlush = std::make_shared<SharedPromise<void>>();
+        auto currentFlush = _currentFlush->getFuture();
+        lk.unlock();
+        // The outcome of the current flush does not matter, as it may have started before the
+        // writes this call waits on.
+        currentFlush.getNoThrow().ignore();
+        lk.lock();
+        invariant(!_currentFlush);
+        _currentFlush = std::move(_nextFlush);
+    } else {
+        _currentFlush = std::make_shared<SharedPromise<void>>();
+    }
+    auto flush = _currentFlush;
+    lk.unlock();
+
+    Status status = Status::OK();
+    ON_BLOCK_EXIT([&] {
+        {
+            stdx::lock_guard<Latch> flushLk(_lastSyncMutex);
+            _currentFlush.reset();
+        }
+        if (status.isOK()) {
+            flush->emplaceValue();
+        } else {
+            flush->setError(std::move(status));
+        }
+    });
+
+    try {
+        _flushJournalOrCheckpoint(opCtx, useListener);
+    } catch (...) {
+        status = exceptionToStatus();
+        throw;
+    }
+}
 
+void WiredTigerSessionCache::_flushJournalOrCheckpoint(OperationContext* opCtx,
+                                                       UseJournalListener useListener) {
     // Update a value that tracks the latest write that is safe across startup recovery (in the repl
     // layer) and then report the time of that write as durable after we flush in-memory to disk.
     // Defer locking the mutex so that it can be locked after any collection locks that may be
@@ -330,7 +368,8 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
         token = _journalListener->getToken(opCtx, jlk);
     }
 
-    // Initialize on first use.
+    // Initialize on first use. Only the thread leading a flush gets here, and flushes don't
+    // overlap, so the session is never used concurrently.
     if (!_waitUntilDurableSession) {
         invariantWTOK(
             _conn->open_session(_conn, nullptr, "isolation=snapshot", &_waitUntilDurableSession));
@@ -371,9 +410,11 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 
 
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lock(partition.mutex);
+        for (auto session : partition.sessions) {
+            session->closeAllCursors(uri);
+        }
     }
 }
 
@@ -381,15 +422,21 @@ void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lock(partition.mutex);
+        for (auto session : partition.sessions) {
+            session->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 size_t WiredTigerSessionCache::getIdleSessionsCount() {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    return _sessions.size();
+    size_t count = 0;
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lock(partition.mutex);
+        count += partition.sessions.size();
+    }
+    return count;
 }
 
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
@@ -399,14 +446,14 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     }
 
     auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lock(partition.mutex);
         // Discard all sessions that became idle before the cutoff time
-        for (auto it = _sessions.begin(); it != _sessions.end();) {
+        for (auto it = partition.sessions.begin(); it != partition.sessions.end();) {
             auto session = *it;
             invariant(session->getIdleExpireTime() != Date_t::min());
             if (session->getIdleExpireTime() < cutoffTime) {
-                it = _sessions.erase(it);
+                it = partition.sessions.erase(it);
                 delete (session);
             } else {
                 ++it;
@@ -420,9 +467,17 @@ void WiredTigerSessionCache::closeAll() {
     SessionCache swap;
 
     {
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        // Hold every partition's latch while incrementing the epoch, so that releaseSession()
+        // can't return a session from the old epoch to a partition after it has been emptied.
+        std::vector<stdx::unique_lock<Latch>> locks;
+        for (auto& partition : _partitions) {
+            locks.emplace_back(partition.mutex);
+        }
         _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+        for (auto& partition : _partitions) {
+            swap.insert(swap.end(), partition.sessions.begin(), partition.sessions.end());
+            partition.sessions.clear();
+        }
     }
 
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
@@ -430,6 +485,13 @@ void WiredTigerSessionCache::closeAll() {
     }
 }
 
+size_t WiredTigerSessionCache::_partitionForThisThread() {
+    static AtomicWord<unsigned> nextPartition{0};
+    thread_local const size_t partition =
+        nextPartition.fetchAndAdd(1) % kNumSessionCachePartitions;
+    return partition;
+}
+
 bool WiredTigerSessionCache::isEphemeral() {
     return _engine && _engine->isEphemeral();
 }
@@ -439,13 +501,16 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        if (!_sessions.empty()) {
+    // Start with this thread's own partition, and only look at the others if it is empty.
+    const size_t home = _partitionForThisThread();
+    for (size_t i = 0; i < kNumSessionCachePartitions; ++i) {
+        auto& partition = _partitions[(home + i) % kNumSessionCachePartitions];
+        stdx::lock_guard<Latch> lock(partition.mutex);
+        if (!partition.sessions.empty()) {
             // Get the most recently used session so that if we discard sessions, we're
             // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
+            WiredTigerSession* cachedSession = partition.sessions.back();
+            partition.sessions.pop_back();
             // Reset the idle time
             cachedSession->setIdleExpireTime(Date_t::min());
             return UniqueWiredTigerSession(cachedSession);
@@ -507,10 +572,11 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->setIdleExpireTime(_clockSource->now());
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        auto& partition = _partitions[_partitionForThisThread()];
+        stdx::lock_guard<Latch> lock(partition.mutex);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            partition.sessions.push_back(session);
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
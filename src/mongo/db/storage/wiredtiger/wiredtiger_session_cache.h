@@ -29,7 +29,9 @@
 
 #pragma once
 
+#include <array>
 #include <list>
+#include <memory>
 #include <string>
 
 #include <wiredtiger.h>
@@ -39,6 +41,8 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/future.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -296,9 +300,9 @@ public:
     /**
      * Waits until all commits that happened before this call are made durable.
      *
-     * Specifying Fsync::kJournal will flush only the (oplog) journal to disk. Callers are
-     * serialized by a mutex and will return early if it is discovered that another thread started
-     * and completed a flush while they slept.
+     * Specifying Fsync::kJournal will flush only the (oplog) journal to disk. Concurrent callers
+     * are grouped: all callers that arrive while a flush is in progress share the single flush
+     * started after it completes.
      *
      * Specifying Fsync::kCheckpointStableTimestamp will take a checkpoint up to and including the
      * stable timestamp.
@@ -372,9 +376,18 @@ private:
     AtomicWord<unsigned> _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    Mutex _cacheLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::_cacheLock");
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    // Idle sessions are spread over partitions, each with its own latch, so that checking sessions
+    // out and back in from many threads doesn't contend on a single mutex. A thread returns
+    // sessions to the partition it is assigned to and checks them out from there first, falling
+    // back to the other partitions when it is empty.
+    struct SessionCachePartition {
+        Mutex mutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::SessionCachePartition::mutex");
+        SessionCache sessions;
+    };
+    static constexpr size_t kNumSessionCachePartitions = 16;
+    std::array<CacheAligned<SessionCachePartition>, kNumSessionCachePartitions> _partitions;
 
     // Bumped when all open sessions need to be closed
     AtomicWord<unsigned long long> _epoch;  // atomic so we can check it outside of the lock
@@ -382,9 +395,12 @@ private:
     // Bumped when all open cursors need to be closed
     AtomicWord<unsigned long long> _cursorEpoch;  // atomic so we can check it outside of the lock
 
-    // Counter and critical section mutex for waitUntilDurable
-    AtomicWord<unsigned> _lastSyncTime;
+    // Protects the flushes that waitUntilDurable groups journal commits into. '_currentFlush' is
+    // set while a flush is in progress, and '_nextFlush' while writers that arrived during it wait
+    // for the flush that follows.
     Mutex _lastSyncMutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::_lastSyncMutex");
+    std::shared_ptr<SharedPromise<void>> _currentFlush;
+    std::shared_ptr<SharedPromise<void>> _nextFlush;
 
     // Mutex and cond var for waiting on prepare commit or abort.
     Mutex _prepareCommittedOrAbortedMutex =
@@ -400,6 +416,18 @@ private:
     WT_SESSION* _waitUntilDurableSession = nullptr;  // owned, and never explicitly closed
                                                      // (uses connection close to clean up)
 
+    /**
+     * Returns the idle session partition assigned to the calling thread. Threads are assigned
+     * partitions round-robin the first time they ask.
+     */
+    static size_t _partitionForThisThread();
+
+    /**
+     * Flushes the journal, or takes a checkpoint if journaling is disabled, on behalf of every
+     * caller of waitUntilDurable() grouped into the current flush.
+     */
+    void _flushJournalOrCheckpoint(OperationContext* opCtx, UseJournalListener useListener);
+
     /**
      * Returns a session to the cache for later reuse. If closeAll was called between getting this
      * session and releasing it, the session is directly released. This method is thread safe.
@@ -68,14 +68,21 @@ WiredTigerSizeStorer::~WiredTigerSizeStorer() {
     _cursor->close(_cursor);
 }
 
+WiredTigerSizeStorer::BufferPartition& WiredTigerSizeStorer::_partitionFor(StringData uri) const {
+    // Use the high bits of the hash, the buffers themselves are indexed by the low ones.
+    size_t hash = StringMapHasher{}(uri);
+    return _partitions[(hash >> 32) % kNumBufferPartitions];
+}
+
 void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeInfo) {
     // If the SizeInfo is still dirty, we're done.
     if (sizeInfo->_dirty.load() || _readOnly)
         return;
 
     // Ordering is important: as the entry may be flushed concurrently, set the dirty flag last.
-    stdx::lock_guard<Latch> lk(_bufferMutex);
-    auto& entry = _buffer[uri];
+    auto& partition = _partitionFor(uri);
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    auto& entry = partition.buffer[uri];
     // During rollback it is possible to get a new SizeInfo. In that case clear the dirty flag,
     // so the SizeInfo can be destructed without triggering the dirty check invariant.
     if (entry && entry.get() != sizeInfo.get())
@@ -96,9 +103,10 @@ void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeI
 std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(StringData uri) const {
     {
         // Check if we can satisfy the read from the buffer.
-        stdx::lock_guard<Latch> bufferLock(_bufferMutex);
-        Buffer::const_iterator it = _buffer.find(uri);
-        if (it != _buffer.end())
+        auto& partition = _partitionFor(uri);
+        stdx::lock_guard<Latch> bufferLock(partition.mutex);
+        Buffer::const_iterator it = partition.buffer.find(uri);
+        if (it != partition.buffer.end())
             return it->second;
     }
 
@@ -130,60 +138,136 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
                                       data["dataSize"].safeNumberLong());
 }
 
+void WiredTigerSizeStorer::storeMetadata(StringData key, const BSONObj& data) {
+    if (_readOnly)
+        return;
+
+    stdx::lock_guard<Latch> cursorLock(_cursorMutex);
+    ON_BLOCK_EXIT([&] { _cursor->reset(_cursor); });
+
+    WT_SESSION* session = _session.getSession();
+    WiredTigerBeginTxnBlock txnOpen(session, nullptr);
+
+    LOGV2_DEBUG(5212011,
+                2,
+                "WiredTigerSizeStorer::storeMetadata",
+                "key"_attr = key,
+                "data"_attr = redact(data));
+    WiredTigerItem wtKey(key.rawData(), key.size());
+    WiredTigerItem value(data.objdata(), data.objsize());
+    _cursor->set_key(_cursor, wtKey.Get());
+    _cursor->set_value(_cursor, value.Get());
+    invariantWTOK(_cursor->insert(_cursor));
+
+    txnOpen.done();
+    invariantWTOK(session->commit_transaction(session, nullptr));
+}
+
+BSONObj WiredTigerSizeStorer::loadMetadata(StringData key) const {
+    stdx::lock_guard<Latch> cursorLock(_cursorMutex);
+    ON_BLOCK_EXIT([&] { _cursor->reset(_cursor); });
+
+    _cursor->reset(_cursor);
+
+    WT_ITEM wtKey = {key.rawData(), key.size()};
+    _cursor->set_key(_cursor, &wtKey);
+    int ret = _cursor->search(_cursor);
+    if (ret == WT_NOTFOUND)
+        return BSONObj();
+    invariantWTOK(ret);
+
+    WT_ITEM value;
+    invariantWTOK(_cursor->get_value(_cursor, &value));
+    return BSONObj(reinterpret_cast<const char*>(value.data)).getOwned();
+}
+
 void WiredTigerSizeStorer::flush(bool syncToDisk) {
-    Buffer buffer;
-    {
-        stdx::lock_guard<Latch> bufferLock(_bufferMutex);
-        _buffer.swap(buffer);
+    std::array<Buffer, kNumBufferPartitions> buffers;
+    size_t remaining = 0;
+    for (size_t i = 0; i < kNumBufferPartitions; ++i) {
+        stdx::lock_guard<Latch> bufferLock(_partitions[i].mutex);
+        _partitions[i].buffer.swap(buffers[i]);
+        remaining += buffers[i].size();
     }
 
-    if (buffer.empty())
+    if (remaining == 0)
         return;  // Nothing to do.
 
     Timer t;
-    stdx::lock_guard<Latch> cursorLock(_cursorMutex);
-    {
-        // On failure, place entries back into the map, unless a newer value already exists.
-        ON_BLOCK_EXIT([this, &buffer]() {
-            this->_cursor->reset(this->_cursor);
-            if (!buffer.empty()) {
-                stdx::lock_guard<Latch> bufferLock(this->_bufferMutex);
-                for (auto& it : buffer)
-                    this->_buffer.try_emplace(it.first, it.second);
+    const size_t numEntries = remaining;
+    size_t current = 0;
+    auto it = buffers[current].cbegin();
+
+    // On failure, place the entries not yet written back into their partitions, unless a newer
+    // value already exists.
+    auto guard = makeGuard([&] {
+        for (size_t i = current; i < kNumBufferPartitions; ++i) {
+            auto begin = i == current ? it : buffers[i].cbegin();
+            if (begin == buffers[i].cend())
+                continue;
+            stdx::lock_guard<Latch> bufferLock(_partitions[i].mutex);
+            for (; begin != buffers[i].cend(); ++begin)
+                _partitions[i].buffer.try_emplace(begin->first, begin->second);
+        }
+    });
+
+    for (; current < kNumBufferPartitions; ++current) {
+        it = buffers[current].cbegin();
+        while (it != buffers[current].cend()) {
+            auto batchEnd = it;
+            size_t batchSize = 0;
+            while (batchEnd != buffers[current].cend() && batchSize < kMaxEntriesPerTransaction) {
+                ++batchEnd;
+                ++batchSize;
             }
-        });
-
-        WT_SESSION* session = _session.getSession();
-        WiredTigerBeginTxnBlock txnOpen(session, syncToDisk ? "sync=true" : nullptr);
-
-        for (auto it = buffer.begin(); it != buffer.end(); ++it) {
-
-            // Ordering is important here: when the store method checks if the SizeInfo
-            // is dirty and it returns true, the current values of numRecords and dataSize must
-            // still be written back. So, the required order is to clear the dirty flag first.
-            SizeInfo& sizeInfo = *it->second;
-            sizeInfo._dirty.store(false);
-            BSONObj data = BSON("numRecords" << sizeInfo.numRecords.load() << "dataSize"
-                                             << sizeInfo.dataSize.load());
-
-            auto& uri = it->first;
-            LOGV2_DEBUG(22425,
-                        2,
-                        "WiredTigerSizeStorer::flush {uri} -> {data}",
-                        "uri"_attr = uri,
-                        "data"_attr = redact(data));
-            WiredTigerItem key(uri.c_str(), uri.size());
-            WiredTigerItem value(data.objdata(), data.objsize());
-            _cursor->set_key(_cursor, key.Get());
-            _cursor->set_value(_cursor, value.Get());
-            invariantWTOK(_cursor->insert(_cursor));
+            remaining -= batchSize;
+
+            // Syncing the last transaction to disk also makes all of the previous ones durable.
+            _writeEntries(it, batchEnd, syncToDisk && remaining == 0);
+            it = batchEnd;
         }
-        txnOpen.done();
-        invariantWTOK(session->commit_transaction(session, nullptr));
-        buffer.clear();
     }
+    guard.dismiss();
 
     auto micros = t.micros();
-    LOGV2_DEBUG(22426, 2, "WiredTigerSizeStorer flush took {micros} µs", "micros"_attr = micros);
+    LOGV2_DEBUG(22426,
+                2,
+                "WiredTigerSizeStorer flush took {micros} µs",
+                "micros"_attr = micros,
+                "numEntries"_attr = numEntries);
+}
+
+void WiredTigerSizeStorer::_writeEntries(Buffer::const_iterator begin,
+                                         Buffer::const_iterator end,
+                                         bool syncToDisk) {
+    stdx::lock_guard<Latch> cursorLock(_cursorMutex);
+    ON_BLOCK_EXIT([&] { _cursor->reset(_cursor); });
+
+    WT_SESSION* session = _session.getSession();
+    WiredTigerBeginTxnBlock txnOpen(session, syncToDisk ? "sync=true" : nullptr);
+
+    for (auto it = begin; it != end; ++it) {
+        // Ordering is important here: when the store method checks if the SizeInfo
+        // is dirty and it returns true, the current values of numRecords and dataSize must
+        // still be written back. So, the required order is to clear the dirty flag first.
+        SizeInfo& sizeInfo = *it->second;
+        sizeInfo._dirty.store(false);
+        BSONObj data = BSON("numRecords" << sizeInfo.numRecords.load() << "dataSize"
+                                         << sizeInfo.dataSize.load());
+
+        auto& uri = it->first;
+        LOGV2_DEBUG(22425,
+                    2,
+                    "WiredTigerSizeStorer::flush {uri} -> {data}",
+                    "uri"_attr = uri,
+                    "data"_attr = redact(data));
+        WiredTigerItem key(uri.c_str(), uri.size());
+        WiredTigerItem value(data.objdata(), data.objsize());
+        _cursor->set_key(_cursor, key.Get());
+        _cursor->set_value(_cursor, value.Get());
+        invariantWTOK(_cursor->insert(_cursor));
+    }
+    txnOpen.done();
+    invariantWTOK(session->commit_transaction(session, nullptr));
 }
 }  // namespace mongo
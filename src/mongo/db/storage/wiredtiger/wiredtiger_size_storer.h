@@ -29,15 +29,18 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 
 #include <wiredtiger.h>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/string_map.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -90,21 +93,51 @@ public:
     std::shared_ptr<SizeInfo> load(StringData uri) const;
 
     /**
-     * Writes all changes to the underlying table.
+     * Writes 'data' under 'key' directly to the underlying table, bypassing the buffer. Keys must
+     * not collide with table URIs. Used for small amounts of auxiliary metadata that record
+     * stores want to find again after a restart, with the same durability as size information.
+     */
+    void storeMetadata(StringData key, const BSONObj& data);
+
+    /**
+     * Returns the document most recently stored under 'key' with storeMetadata(), or an empty
+     * document if there is none.
+     */
+    BSONObj loadMetadata(StringData key) const;
+
+    /**
+     * Writes all changes to the underlying table. The changes are written in transactions of at
+     * most kMaxEntriesPerTransaction entries each, so that neither the size of a transaction nor
+     * the time readers wait for the cursor grows with the number of dirty collections.
      */
     void flush(bool syncToDisk);
 
+    static constexpr size_t kMaxEntriesPerTransaction = 1000;
+
 private:
+    using Buffer = StringMap<std::shared_ptr<SizeInfo>>;
+
+    // Dirty entries are spread over partitions by URI, so that marking collections dirty from
+    // many threads doesn't contend on a single mutex. A flush swaps out one partition at a time.
+    struct BufferPartition {
+        Mutex mutex = MONGO_MAKE_LATCH("WiredTigerSizeStorer::BufferPartition::mutex");
+        Buffer buffer;
+    };
+    static constexpr size_t kNumBufferPartitions = 16;
+
+    BufferPartition& _partitionFor(StringData uri) const;
+
+    /**
+     * Writes the entries in the range to the underlying table in a single transaction.
+     */
+    void _writeEntries(Buffer::const_iterator begin, Buffer::const_iterator end, bool syncToDisk);
+
     const WiredTigerSession _session;
     const bool _readOnly;
-    // Guards _cursor. Acquire *before* _bufferMutex.
+    // Guards _cursor. Acquire *before* any partition mutex.
     mutable Mutex _cursorMutex = MONGO_MAKE_LATCH("WiredTigerSessionStorer::_cursorMutex");
     WT_CURSOR* _cursor;  // pointer is const after constructor
 
-    using Buffer = StringMap<std::shared_ptr<SizeInfo>>;
-
-    mutable Mutex _bufferMutex =
-        MONGO_MAKE_LATCH("WiredTigerSessionStorer::_bufferMutex");  // Guards _buffer
-    Buffer _buffer;
+    mutable std::array<CacheAligned<BufferPartition>, kNumBufferPartitions> _partitions;
 };
 }  // namespace mongo
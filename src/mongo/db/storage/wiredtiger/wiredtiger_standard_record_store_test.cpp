@@ -138,6 +138,13 @@ public:
     virtual std::unique_ptr<RecordStore> newCappedRecordStore(const std::string& ns,
                                                               int64_t cappedMaxSize,
                                                               int64_t cappedMaxDocs) {
+        return newCappedRecordStore(ns, cappedMaxSize, cappedMaxDocs, nullptr);
+    }
+
+    std::unique_ptr<RecordStore> newCappedRecordStore(const std::string& ns,
+                                                      int64_t cappedMaxSize,
+                                                      int64_t cappedMaxDocs,
+                                                      WiredTigerSizeStorer* sizeStorer) {
         WiredTigerRecoveryUnit* ru =
             dynamic_cast<WiredTigerRecoveryUnit*>(_engine.newRecoveryUnit());
         OperationContextNoop opCtx(ru);
@@ -169,7 +176,7 @@ public:
         params.cappedMaxSize = cappedMaxSize;
         params.cappedMaxDocs = cappedMaxDocs;
         params.cappedCallback = nullptr;
-        params.sizeStorer = nullptr;
+        params.sizeStorer = sizeStorer;
         params.tracksSizeAdjustments = true;
 
         auto ret = std::make_unique<StandardWiredTigerRecordStore>(&_engine, &opCtx, params);
@@ -300,6 +307,77 @@ TEST(WiredTigerRecordStoreTest, SizeStorer1) {
     rs.reset(nullptr);  // this has to be deleted before ss
 }
 
+TEST(WiredTigerRecordStoreTest, SizeStorerFlushesManyEntries) {
+    unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
+    string storageUri = WiredTigerKVEngine::kTableUriPrefix + "sizeStorer";
+    const bool enableWtLogging = false;
+    const long long numEntries = 2 * WiredTigerSizeStorer::kMaxEntriesPerTransaction + 7;
+
+    {
+        WiredTigerSizeStorer ss(harnessHelper->conn(), storageUri, enableWtLogging);
+        std::vector<std::shared_ptr<WiredTigerSizeStorer::SizeInfo>> infos;
+        for (long long i = 0; i < numEntries; i++) {
+            infos.push_back(std::make_shared<WiredTigerSizeStorer::SizeInfo>(i, 2 * i));
+            ss.store("table:" + std::to_string(i), infos.back());
+        }
+        ss.flush(true);
+    }
+
+    WiredTigerSizeStorer ss(harnessHelper->conn(), storageUri, enableWtLogging);
+    for (long long i = 0; i < numEntries; i++) {
+        auto info = ss.load("table:" + std::to_string(i));
+        ASSERT_EQUALS(i, info->numRecords.load());
+        ASSERT_EQUALS(2 * i, info->dataSize.load());
+    }
+}
+
+// Verify that oplog stones written to the size storer are reused when the oplog is reopened.
+TEST(WiredTigerRecordStoreTest, OplogStonesArePersisted) {
+    unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
+    const bool enableWtLogging = false;
+    WiredTigerSizeStorer ss(harnessHelper->conn(),
+                            WiredTigerKVEngine::kTableUriPrefix + "sizeStorer",
+                            enableWtLogging);
+    const std::string ns = "local.oplog.stones";
+    const int64_t cappedMaxSize = 10 * 1024;
+
+    auto insertOplogEntry = [&](RecordStore* rs, int inc) {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        auto wtrs = checked_cast<WiredTigerRecordStore*>(rs);
+        Timestamp ts(1, inc);
+        BSONObj obj = BSON("ts" << ts << "padding" << std::string(100, 'x'));
+        WriteUnitOfWork wuow(opCtx.get());
+        ASSERT_OK(wtrs->oplogDiskLocRegister(opCtx.get(), ts, false));
+        ASSERT_OK(rs->insertRecord(opCtx.get(), obj.objdata(), obj.objsize(), ts).getStatus());
+        wuow.commit();
+    };
+
+    {
+        auto rs = harnessHelper->newCappedRecordStore(ns, cappedMaxSize, -1, &ss);
+        auto oplogStones = checked_cast<WiredTigerRecordStore*>(rs.get())->oplogStones();
+        oplogStones->setMinBytesPerStone(100);
+        for (int i = 1; i <= 3; i++) {
+            insertOplogEntry(rs.get(), i);
+        }
+        ASSERT_EQ(3U, oplogStones->numStones());
+        oplogStones->persistIfNeeded();
+
+        // A record inserted after the stones were persisted is accounted for by scanning.
+        insertOplogEntry(rs.get(), 4);
+        ASSERT_EQ(4U, oplogStones->numStones());
+    }
+
+    // The minimum stone size derived from the capped size is larger than the records, so any
+    // stones the reopened oplog has must come from the persisted ones.
+    auto rs = harnessHelper->newCappedRecordStore(ns, cappedMaxSize, -1, &ss);
+    auto oplogStones = checked_cast<WiredTigerRecordStore*>(rs.get())->oplogStones();
+    ASSERT_EQ(3U, oplogStones->numStones());
+    ASSERT_EQ(1, oplogStones->currentRecords());
+
+    rs.reset(nullptr);
+    ss.flush(false);
+}
+
 class SizeStorerUpdateTest : public mongo::unittest::Test {
 private:
     virtual void setUp() {
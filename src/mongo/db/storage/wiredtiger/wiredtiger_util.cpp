@@ -580,6 +580,20 @@ bool WiredTigerUtil::useTableLogging(NamespaceString ns, bool replEnabled) {
 }
 
 Status WiredTigerUtil::setTableLogging(OperationContext* opCtx, const std::string& uri, bool on) {
+    // Every collection and index table is checked when it is opened at startup, and nearly all of
+    // them already have the expected setting. Check on the operation's own session first so that
+    // those tables do not pay for closing the cached cursors and opening a dedicated session, which
+    // only an alter needs.
+    auto existingMetadata = getMetadataCreate(opCtx, uri);
+    if (existingMetadata.isOK()) {
+        const auto& metadata = existingMetadata.getValue();
+        const bool loggingOn = metadata.find("log=(enabled=true)") != std::string::npos;
+        const bool loggingOff = metadata.find("log=(enabled=false)") != std::string::npos;
+        if (loggingOn != loggingOff && loggingOn == on) {
+            return Status::OK();
+        }
+    }
+
     // Try to close as much as possible to avoid EBUSY errors.
     WiredTigerRecoveryUnit::get(opCtx)->getSession()->closeAllCursors(uri);
     WiredTigerSessionCache* sessionCache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
@@ -161,6 +161,16 @@ TEST_F(WiredTigerUtilMetadataTest, GetMetadataCreateStringSimple) {
     ASSERT_STRING_CONTAINS(result.getValue(), config);
 }
 
+TEST_F(WiredTigerUtilMetadataTest, SetTableLoggingLeavesMatchingTableUnchanged) {
+    const char* config = "log=(enabled=false)";
+    createSession(config);
+    ASSERT_OK(WiredTigerUtil::setTableLogging(getOperationContext(), getURI(), false));
+    StatusWith<std::string> result =
+        WiredTigerUtil::getMetadataCreate(getOperationContext(), getURI());
+    ASSERT_OK(result.getStatus());
+    ASSERT_STRING_CONTAINS(result.getValue(), config);
+}
+
 TEST_F(WiredTigerUtilMetadataTest, GetConfigurationStringInvalidURI) {
     StatusWith<std::string> result = WiredTigerUtil::getMetadata(getOperationContext(), getURI());
     ASSERT_NOT_OK(result.getStatus());
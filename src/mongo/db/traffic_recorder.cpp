@@ -82,7 +82,9 @@ MONGO_INITIALIZER(ShouldAlwaysRecordTraffic)(InitializerContext*) {
 class TrafficRecorder::Recording {
 public:
     Recording(const StartRecordingTraffic& options)
-        : _path(_getPath(options.getFilename().toString())), _maxLogSize(options.getMaxFileSize()) {
+        : _path(_getPath(options.getFilename().toString())),
+          _maxLogSize(options.getMaxFileSize()),
+          _rolling(options.getRolling()) {
 
         MultiProducerSingleConsumerQueue<TrafficRecordingPacket, CostFunction>::Options
             queueOptions;
@@ -97,6 +99,7 @@ public:
         _trafficStats.setBufferSize(options.getBufferSize());
         _trafficStats.setRecordingFile(_path);
         _trafficStats.setMaxFileSize(_maxLogSize);
+        _trafficStats.setRolling(_rolling);
     }
 
     void run() {
@@ -132,8 +135,23 @@ public:
                         auto size = db.size() + toWrite.size();
                         db.getCursor().write<LittleEndian<uint32_t>>(size);
 
+                        // This thread is the only writer of _written, so it may read it unlocked.
+                        const bool roll =
+                            _rolling && _written > 0 && _written + size >= _maxLogSize;
+                        if (roll) {
+                            // Records never span files, so each file can be read on its own.
+                            out.close();
+                            boost::filesystem::rename(_path, _path + ".previous");
+                            out.open(_path,
+                                     std::ios_base::binary | std::ios_base::trunc |
+                                         std::ios_base::out);
+                        }
+
                         {
                             stdx::lock_guard<Latch> lk(_mutex);
+                            if (roll) {
+                                _written = 0;
+                            }
                             _written += size;
                         }
 
@@ -247,6 +265,7 @@ private:
 
     const std::string _path;
     const size_t _maxLogSize;
+    const bool _rolling;
 
     MultiProducerSingleConsumerQueue<TrafficRecordingPacket, CostFunction>::Pipe _pcqPipe;
     stdx::thread _thread;
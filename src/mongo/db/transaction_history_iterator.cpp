@@ -31,13 +31,11 @@
 
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/db_raii.h"
-#include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
-#include "mongo/db/query/get_executor.h"
-#include "mongo/db/query/query_request.h"
 #include "mongo/db/repl/local_oplog_info.h"
 #include "mongo/db/repl/oplog_entry.h"
+#include "mongo/db/storage/oplog_hack.h"
 #include "mongo/db/transaction_history_iterator.h"
 #include "mongo/logger/redaction.h"
 #include "mongo/util/str.h"
@@ -47,35 +45,12 @@ namespace mongo {
 namespace {
 
 /**
- * Query the oplog for an entry with the given timestamp.
+ * Reads the oplog entry with the given opTime. The oplog is keyed by the timestamp of its entries,
+ * so this is a single seek on the oplog's record store rather than a query.
  */
-BSONObj findOneOplogEntry(OperationContext* opCtx,
-                          const repl::OpTime& opTime,
-                          bool permitYield,
-                          bool prevOpOnly = false) {
-    BSONObj oplogBSON;
+BSONObj findOneOplogEntry(OperationContext* opCtx, const repl::OpTime& opTime) {
     invariant(!opTime.isNull());
 
-    auto qr = std::make_unique<QueryRequest>(NamespaceString::kRsOplogNamespace);
-    qr->setFilter(opTime.asQuery());
-
-    if (prevOpOnly) {
-        qr->setProj(
-            BSON("_id" << 0 << repl::OplogEntry::kPrevWriteOpTimeInTransactionFieldName << 1LL));
-    }
-
-    const boost::intrusive_ptr<ExpressionContext> expCtx;
-
-    auto statusWithCQ = CanonicalQuery::canonicalize(opCtx,
-                                                     std::move(qr),
-                                                     expCtx,
-                                                     ExtensionsCallbackNoop(),
-                                                     MatchExpressionParser::kBanAllSpecialFeatures);
-    invariant(statusWithCQ.isOK(),
-              str::stream() << "Failed to canonicalize oplog lookup"
-                            << causedBy(statusWithCQ.getStatus()));
-    std::unique_ptr<CanonicalQuery> cq = std::move(statusWithCQ.getValue());
-
     ShouldNotConflictWithSecondaryBatchApplicationBlock noPBWMBlock(opCtx->lockState());
     Lock::GlobalLock globalLock(opCtx, MODE_IS);
     const auto localDb = DatabaseHolder::get(opCtx)->getDb(opCtx, "local");
@@ -89,34 +64,36 @@ BSONObj findOneOplogEntry(OperationContext* opCtx,
     auto oplog = repl::LocalOplogInfo::get(opCtx)->getCollection();
     invariant(oplog);
 
-    auto exec = uassertStatusOK(getExecutorFind(opCtx, oplog, std::move(cq), permitYield));
+    Snapshotted<BSONObj> oplogBSON;
+    bool found = oplog->findDoc(
+        opCtx, uassertStatusOK(oploghack::keyForOptime(opTime.getTimestamp())), &oplogBSON);
 
-    auto getNextResult = exec->getNext(&oplogBSON, nullptr);
+    // An entry with the same timestamp but another term was written by a different primary, which
+    // means the entry we are looking for was rolled back.
+    if (found) {
+        auto foundOpTime = repl::OpTime::parseFromOplogEntry(oplogBSON.value());
+        found = foundOpTime.isOK() && foundOpTime.getValue() == opTime;
+    }
     uassert(ErrorCodes::IncompleteTransactionHistory,
             str::stream() << "oplog no longer contains the complete write history of this "
                              "transaction, log with opTime "
                           << opTime.toBSON() << " cannot be found",
-            getNextResult != PlanExecutor::IS_EOF);
-    if (getNextResult != PlanExecutor::ADVANCED) {
-        uassertStatusOKWithContext(WorkingSetCommon::getMemberObjectStatus(oplogBSON),
-                                   "PlanExecutor error in TransactionHistoryIterator");
-    }
+            found);
 
-    return oplogBSON.getOwned();
+    return oplogBSON.value().getOwned();
 }
 
 }  // namespace
 
-TransactionHistoryIterator::TransactionHistoryIterator(repl::OpTime startingOpTime,
-                                                       bool permitYield)
-    : _permitYield(permitYield), _nextOpTime(std::move(startingOpTime)) {}
+TransactionHistoryIterator::TransactionHistoryIterator(repl::OpTime startingOpTime, bool)
+    : _nextOpTime(std::move(startingOpTime)) {}
 
 bool TransactionHistoryIterator::hasNext() const {
     return !_nextOpTime.isNull();
 }
 
 repl::OplogEntry TransactionHistoryIterator::next(OperationContext* opCtx) {
-    BSONObj oplogBSON = findOneOplogEntry(opCtx, _nextOpTime, _permitYield);
+    BSONObj oplogBSON = findOneOplogEntry(opCtx, _nextOpTime);
 
     auto oplogEntry = uassertStatusOK(repl::OplogEntry::parse(oplogBSON));
     const auto& oplogPrevTsOption = oplogEntry.getPrevWriteOpTimeInTransaction();
@@ -138,7 +115,7 @@ repl::OplogEntry TransactionHistoryIterator::nextFatalOnErrors(OperationContext*
 }
 
 repl::OpTime TransactionHistoryIterator::nextOpTime(OperationContext* opCtx) {
-    BSONObj oplogBSON = findOneOplogEntry(opCtx, _nextOpTime, _permitYield, true /* prevOpOnly */);
+    BSONObj oplogBSON = findOneOplogEntry(opCtx, _nextOpTime);
 
     auto prevOpTime = oplogBSON[repl::OplogEntry::kPrevWriteOpTimeInTransactionFieldName];
     uassert(ErrorCodes::FailedToParse,
@@ -66,6 +66,9 @@ class TransactionHistoryIterator : public TransactionHistoryIteratorBase {
 public:
     /**
      * Creates a new iterator starting with an oplog entry with the given start opTime.
+     *
+     * Each entry is read with a direct seek on the oplog, which never yields, so 'permitYield' has
+     * no effect. It is accepted for the OplogInterface callers which still pass it.
      */
     TransactionHistoryIterator(repl::OpTime startingOpTime, bool permitYield = false);
     virtual ~TransactionHistoryIterator() = default;
@@ -80,11 +83,6 @@ public:
     repl::OplogEntry nextFatalOnErrors(OperationContext* opCtx);
 
 private:
-    // Clients can set this to allow PlanExecutors created by this TransactionHistoryIterator to
-    // have a YIELD_AUTO yield policy. It is only safe to set this if next() will never be called
-    // while holding a lock that should not be yielded, such as the PBWM lock.
-    bool _permitYield;
-
     repl::OpTime _nextOpTime;
 };
 
@@ -164,6 +164,20 @@ TEST_F(SessionHistoryIteratorTest, NextShouldAssertIfHistoryIsTruncated) {
         iter.next(opCtx()), AssertionException, ErrorCodes::IncompleteTransactionHistory);
 }
 
+TEST_F(SessionHistoryIteratorTest, NextShouldAssertIfEntryHasSameTimestampButDifferentTerm) {
+    auto entry = makeOplogEntry(
+        repl::OpTime(Timestamp(67, 54801), 2),  // optime
+        BSON("y" << 50),                        // o
+        repl::OpTime(Timestamp(52, 345), 1));   // optime of previous write in transaction
+    insertOplogEntry(entry);
+
+    // The entry at this timestamp was written in another term, so it is not part of the history.
+    TransactionHistoryIterator iter(repl::OpTime(Timestamp(67, 54801), 1));
+    ASSERT_TRUE(iter.hasNext());
+    ASSERT_THROWS_CODE(
+        iter.next(opCtx()), AssertionException, ErrorCodes::IncompleteTransactionHistory);
+}
+
 TEST_F(SessionHistoryIteratorTest, OplogInWriteHistoryChainWithMissingPrevTSShouldAssert) {
     auto entry = makeOplogEntry(repl::OpTime(Timestamp(67, 54801), 2),  // optime
                                 BSON("y" << 50),                        // o
@@ -57,6 +57,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/exit.h"
 
 namespace mongo {
@@ -70,9 +71,22 @@ ServerStatusMetricField<Counter64> ttlPassesDisplay("ttl.passes", &ttlPasses);
 ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocuments",
                                                               &ttlDeletedDocuments);
 
+// Deletion batches run, batches deferred to the next pass by replication lag or cache pressure,
+// and the number of TTL indexes the last pass left with expired documents still to delete.
+Counter64 ttlBatches;
+Counter64 ttlThrottledBatches;
+Counter64 ttlIndexesWithBacklog;
+
+ServerStatusMetricField<Counter64> ttlBatchesDisplay("ttl.batches", &ttlBatches);
+ServerStatusMetricField<Counter64> ttlThrottledBatchesDisplay("ttl.throttledBatches",
+                                                              &ttlThrottledBatches);
+ServerStatusMetricField<Counter64> ttlIndexesWithBacklogDisplay("ttl.indexesWithBacklog",
+                                                                &ttlIndexesWithBacklog);
+
 class TTLMonitor : public BackgroundJob {
 public:
-    TTLMonitor(ServiceContext* serviceContext) : _serviceContext(serviceContext) {}
+    TTLMonitor(ServiceContext* serviceContext)
+        : _serviceContext(serviceContext), _threadPool(_makeThreadPoolOptions()) {}
     virtual ~TTLMonitor() {}
 
     virtual std::string name() const {
@@ -90,6 +104,8 @@ public:
             tc.get()->setSystemOperationKillable(lk);
         }
 
+        _threadPool.startup();
+
         while (!globalInShutdownDeprecated()) {
             {
                 MONGO_IDLE_THREAD_BLOCK;
@@ -180,33 +196,53 @@ private:
             ttlIndexes.push_back(std::make_pair(*nss, spec.getOwned()));
         }
 
+        // Each index is processed on the pool with its own operation context. An interruption
+        // abandons the indexes not yet started, as the serial loop used to.
+        AtomicWord<bool> interrupted{false};
+        AtomicWord<long long> indexesWithBacklog{0};
         for (const auto& it : ttlIndexes) {
-            try {
-                doTTLForIndex(&opCtx, it.first, it.second);
-            } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
-                LOGV2_WARNING(22537,
-                              "TTLMonitor was interrupted, waiting {ttlMonitorSleepSecs_load} "
-                              "seconds before doing another pass",
-                              "ttlMonitorSleepSecs_load"_attr = ttlMonitorSleepSecs.load());
-                return;
-            } catch (const DBException& dbex) {
-                LOGV2_ERROR(22538,
-                            "Error processing ttl index: {it_second} -- {dbex}",
-                            "it_second"_attr = it.second,
-                            "dbex"_attr = dbex.toString());
-                // Continue on to the next index.
-                continue;
-            }
+            _threadPool.schedule([&, it](Status status) {
+                if (!status.isOK() || interrupted.load()) {
+                    return;
+                }
+
+                const auto taskOpCtx = cc().makeOperationContext();
+                try {
+                    if (doTTLForIndex(taskOpCtx.get(), it.first, it.second)) {
+                        indexesWithBacklog.addAndFetch(1);
+                    }
+                } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
+                    if (!interrupted.swap(true)) {
+                        LOGV2_WARNING(22537,
+                                      "TTLMonitor was interrupted, waiting "
+                                      "{ttlMonitorSleepSecs_load} seconds before doing another "
+                                      "pass",
+                                      "ttlMonitorSleepSecs_load"_attr = ttlMonitorSleepSecs.load());
+                    }
+                } catch (const DBException& dbex) {
+                    LOGV2_ERROR(22538,
+                                "Error processing ttl index: {it_second} -- {dbex}",
+                                "it_second"_attr = it.second,
+                                "dbex"_attr = dbex.toString());
+                }
+            });
         }
+        _threadPool.waitForIdle();
+
+        ttlIndexesWithBacklog.decrement(ttlIndexesWithBacklog.get());
+        ttlIndexesWithBacklog.increment(indexesWithBacklog.load());
     }
 
     /**
      * Remove documents from the collection using the specified TTL index after a sufficient amount
-     * of time has passed according to its expiry specification.
+     * of time has passed according to its expiry specification. Deletes in batches of
+     * 'ttlIndexDeleteBatchSize' documents, releasing the collection lock in between, and returns
+     * true if expired documents were left for the next pass because replication is lagging or the
+     * storage engine cache is under pressure.
      */
-    void doTTLForIndex(OperationContext* opCtx, NamespaceString collectionNSS, BSONObj idx) {
+    bool doTTLForIndex(OperationContext* opCtx, NamespaceString collectionNSS, BSONObj idx) {
         if (collectionNSS.isDropPendingNamespace()) {
-            return;
+            return false;
         }
         if (!userAllowedWriteNS(collectionNSS).isOK()) {
             LOGV2_ERROR(
@@ -214,7 +250,7 @@ private:
                 "namespace '{collectionNSS}' doesn't allow deletes, skipping ttl job for: {idx}",
                 "collectionNSS"_attr = collectionNSS,
                 "idx"_attr = idx);
-            return;
+            return false;
         }
 
         const BSONObj key = idx["key"].Obj();
@@ -223,7 +259,7 @@ private:
             LOGV2_ERROR(22540,
                         "key for ttl index can only have 1 field, skipping ttl job for: {idx}",
                         "idx"_attr = idx);
-            return;
+            return false;
         }
 
         LOGV2_DEBUG(22533,
@@ -233,6 +269,57 @@ private:
                     "key"_attr = key,
                     "name"_attr = name);
 
+        const long long batchSize = ttlIndexDeleteBatchSize.load();
+        while (true) {
+            const auto numDeleted = deleteExpiredBatch(opCtx, collectionNSS, idx, batchSize);
+            if (!numDeleted || batchSize == 0 || *numDeleted < batchSize) {
+                return false;
+            }
+
+            opCtx->checkForInterrupt();
+            if (isThrottled(opCtx)) {
+                ttlThrottledBatches.increment();
+                LOGV2_DEBUG(5212032,
+                            1,
+                            "Deferring remaining TTL deletes for {collectionNSS} index {name} to "
+                            "the next pass",
+                            "collectionNSS"_attr = collectionNSS,
+                            "name"_attr = name);
+                return true;
+            }
+        }
+    }
+
+    /**
+     * Returns true if replication lag on this primary exceeds 'ttlMonitorMaxReplicationLagSecs'
+     * or the storage engine cache is under pressure.
+     */
+    bool isThrottled(OperationContext* opCtx) {
+        const auto maxLagSecs = ttlMonitorMaxReplicationLagSecs.load();
+        auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+        if (maxLagSecs > 0 &&
+            replCoord->getReplicationMode() == repl::ReplicationCoordinator::modeReplSet) {
+            const auto lastApplied = replCoord->getMyLastAppliedOpTimeAndWallTime();
+            const auto lastCommitted = replCoord->getLastCommittedOpTimeAndWallTime();
+            if (lastApplied.wallTime - lastCommitted.wallTime > Seconds(maxLagSecs)) {
+                return true;
+            }
+        }
+        return opCtx->getServiceContext()->getStorageEngine()->isCacheUnderPressure(opCtx);
+    }
+
+    /**
+     * Deletes at most 'batchSize' expired documents, or all of them when 'batchSize' is 0, under
+     * a single acquisition of the collection lock. Returns the number deleted, or boost::none if
+     * the index can no longer be used for TTL deletion.
+     */
+    boost::optional<long long> deleteExpiredBatch(OperationContext* opCtx,
+                                                  const NamespaceString& collectionNSS,
+                                                  BSONObj idx,
+                                                  long long batchSize) {
+        const BSONObj key = idx["key"].Obj();
+        const std::string name = idx["name"].str();
+
         AutoGetCollection autoGetCollection(opCtx, collectionNSS, MODE_IX);
         if (MONGO_unlikely(hangTTLMonitorWithLock.shouldFail())) {
             LOGV2(22534, "Hanging due to hangTTLMonitorWithLock fail point");
@@ -243,11 +330,11 @@ private:
         Collection* collection = autoGetCollection.getCollection();
         if (!collection) {
             // Collection was dropped.
-            return;
+            return boost::none;
         }
 
         if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, collectionNSS)) {
-            return;
+            return boost::none;
         }
 
         const IndexDescriptor* desc = collection->getIndexCatalog()->findIndexByName(opCtx, name);
@@ -257,7 +344,7 @@ private:
                         "index not found (index build in progress? index dropped?), skipping ttl "
                         "job for: {idx}",
                         "idx"_attr = idx);
-            return;
+            return boost::none;
         }
 
         // Re-read 'idx' from the descriptor, in case the collection or index definition changed
@@ -268,7 +355,7 @@ private:
             LOGV2_ERROR(22541,
                         "special index can't be used as a ttl index, skipping ttl job for: {idx}",
                         "idx"_attr = idx);
-            return;
+            return boost::none;
         }
 
         BSONElement secondsExpireElt = idx[secondsExpireField];
@@ -280,7 +367,7 @@ private:
                 "secondsExpireField"_attr = secondsExpireField,
                 "typeName_secondsExpireElt_type"_attr = typeName(secondsExpireElt.type()),
                 "idx"_attr = idx);
-            return;
+            return boost::none;
         }
 
         const Date_t kDawnOfTime =
@@ -307,6 +394,7 @@ private:
 
         auto params = std::make_unique<DeleteStageParams>();
         params->isMulti = true;
+        params->limit = batchSize;
         params->canonicalQuery = canonicalQuery.getValue().get();
 
         auto exec =
@@ -326,15 +414,34 @@ private:
                         "ttl query execution for index {idx} failed with status: {result}",
                         "idx"_attr = idx,
                         "result"_attr = redact(result));
-            return;
+            return boost::none;
         }
 
         const long long numDeleted = DeleteStage::getNumDeleted(*exec);
+        ttlBatches.increment();
         ttlDeletedDocuments.increment(numDeleted);
         LOGV2_DEBUG(22536, 1, "deleted: {numDeleted}", "numDeleted"_attr = numDeleted);
+        return numDeleted;
+    }
+
+    static ThreadPool::Options _makeThreadPoolOptions() {
+        ThreadPool::Options options;
+        options.poolName = "TTLMonitor";
+        options.minThreads = 0;
+        options.maxThreads = ttlMonitorMaxConcurrentIndexes;
+        options.onCreateThread = [](const std::string& threadName) {
+            Client::initThread(threadName.c_str());
+            AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+
+            stdx::lock_guard<Client> lk(cc());
+            cc().setSystemOperationKillable(lk);
+        };
+        return options;
     }
 
+
     ServiceContext* _serviceContext;
+    ThreadPool _threadPool;
 };
 
 namespace {
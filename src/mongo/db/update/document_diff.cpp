@@ -0,0 +1,144 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/update/document_diff.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace document_diff {
+namespace {
+
+bool isPathComponent(StringData fieldName) {
+    return !fieldName.empty() && fieldName[0] != '$' && fieldName.find('.') == std::string::npos;
+}
+
+/**
+ * Appends the $set and $unset entries that turn the object 'pre' into 'post', with paths prefixed
+ * by 'prefix'. Returns false, having appended nothing, if the fields of 'post' can't be reached
+ * from 'pre' by such entries.
+ */
+bool diffObjects(const BSONObj& pre,
+                 const BSONObj& post,
+                 const std::string& prefix,
+                 BSONObjBuilder* sets,
+                 BSONObjBuilder* unsets) {
+    StringMap<std::pair<BSONElement, size_t>> preFields;
+    size_t position = 0;
+    for (auto&& elem : pre) {
+        if (!isPathComponent(elem.fieldNameStringData()) ||
+            !preFields.try_emplace(elem.fieldNameStringData(), elem, position++).second) {
+            return false;
+        }
+    }
+
+    BSONObjBuilder levelSets;
+    BSONObjBuilder levelUnsets;
+    StringMap<bool> kept;
+    boost::optional<size_t> lastKeptPosition;
+    boost::optional<StringData> lastAdded;
+    for (auto&& elem : post) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (!isPathComponent(fieldName)) {
+            return false;
+        }
+        const auto path = prefix + fieldName;
+
+        auto preIt = preFields.find(fieldName);
+        if (preIt == preFields.end()) {
+            if (lastAdded && fieldName <= *lastAdded) {
+                return false;
+            }
+            lastAdded = fieldName;
+            levelSets.appendAs(elem, path);
+            continue;
+        }
+
+        const auto& [preElem, prePosition] = preIt->second;
+        if (lastAdded || (lastKeptPosition && prePosition < *lastKeptPosition) ||
+            !kept.try_emplace(fieldName, true).second) {
+            return false;
+        }
+        lastKeptPosition = prePosition;
+
+        if (preElem.binaryEqual(elem)) {
+            continue;
+        }
+        if (preElem.type() == BSONType::Object && elem.type() == BSONType::Object) {
+            BSONObjBuilder subSets;
+            BSONObjBuilder subUnsets;
+            if (diffObjects(preElem.Obj(), elem.Obj(), path + '.', &subSets, &subUnsets)) {
+                levelSets.appendElements(subSets.done());
+                levelUnsets.appendElements(subUnsets.done());
+                continue;
+            }
+        }
+        levelSets.appendAs(elem, path);
+    }
+
+    for (auto&& elem : pre) {
+        if (!kept.count(elem.fieldNameStringData())) {
+            levelUnsets.append(prefix + elem.fieldNameStringData(), 1);
+        }
+    }
+    sets->appendElements(levelSets.done());
+    unsets->appendElements(levelUnsets.done());
+    return true;
+}
+
+}  // namespace
+
+boost::optional<BSONObj> computeModifierDiff(const BSONObj& pre, const BSONObj& post) {
+    BSONObjBuilder sets;
+    BSONObjBuilder unsets;
+    if (!diffObjects(pre, post, "", &sets, &unsets)) {
+        return boost::none;
+    }
+
+    BSONObjBuilder diff;
+    auto setsObj = sets.done();
+    auto unsetsObj = unsets.done();
+    if (!setsObj.isEmpty()) {
+        diff.append("$set", setsObj);
+    }
+    if (!unsetsObj.isEmpty()) {
+        diff.append("$unset", unsetsObj);
+    }
+    auto diffObj = diff.obj();
+    if (diffObj.isEmpty() || diffObj.objsize() >= post.objsize()) {
+        return boost::none;
+    }
+    return diffObj;
+}
+
+}  // namespace document_diff
+}  // namespace mongo
@@ -0,0 +1,54 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+namespace document_diff {
+
+/**
+ * Computes a modifier-style update, {$set: {...}, $unset: {...}}, that the update system turns
+ * 'pre' into 'post' with. Subdocuments present in both are diffed recursively into dotted paths;
+ * any other changed value is set whole.
+ *
+ * A $set creates the fields missing from an object after the existing ones and in lexicographic
+ * order, so the diff only exists where 'post' adds fields after the fields it keeps, in that
+ * order, and keeps fields in their order in 'pre'. Field names that can't be part of a path are
+ * set as part of their parent instead.
+ *
+ * Returns boost::none if there is no such update, or if it is no smaller than 'post'.
+ */
+boost::optional<BSONObj> computeModifierDiff(const BSONObj& pre, const BSONObj& post);
+
+}  // namespace document_diff
+}  // namespace mongo
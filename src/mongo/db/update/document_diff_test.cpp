@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/update/document_diff.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/json.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using document_diff::computeModifierDiff;
+
+const auto kPadding = std::string(100, 'x');
+
+BSONObj withPadding(const char* json) {
+    BSONObjBuilder builder;
+    builder.appendElements(fromjson(json));
+    builder.append("pad", kPadding);
+    return builder.obj();
+}
+
+TEST(DocumentDiffTest, ChangedTopLevelField) {
+    auto diff = computeModifierDiff(withPadding("{_id: 0, a: 1, b: 2}"),
+                                    withPadding("{_id: 0, a: 1, b: 3}"));
+    ASSERT(diff);
+    ASSERT_BSONOBJ_EQ(fromjson("{$set: {b: 3}}"), *diff);
+}
+
+TEST(DocumentDiffTest, RemovedField) {
+    auto diff =
+        computeModifierDiff(withPadding("{_id: 0, a: 1, b: 2}"), withPadding("{_id: 0, b: 2}"));
+    ASSERT(diff);
+    ASSERT_BSONOBJ_EQ(fromjson("{$unset: {a: 1}}"), *diff);
+}
+
+TEST(DocumentDiffTest, NestedChangesUseDottedPaths) {
+    auto pre = withPadding("{_id: 0, a: {b: 1, c: {d: 1, e: 2}}}");
+    auto post = withPadding("{_id: 0, a: {b: 2, c: {d: 1}}}");
+    auto diff = computeModifierDiff(pre, post);
+    ASSERT(diff);
+    ASSERT_BSONOBJ_EQ(fromjson("{$set: {'a.b': 2}, $unset: {'a.c.e': 1}}"), *diff);
+}
+
+TEST(DocumentDiffTest, AddedFieldsAfterKeptFieldsInOrder) {
+    auto pre = fromjson("{_id: 0, a: 1}");
+    BSONObjBuilder postBuilder;
+    postBuilder.appendElements(pre);
+    postBuilder.append("pad", kPadding);
+    postBuilder.append("z", 1);
+    auto diff = computeModifierDiff(pre, postBuilder.obj());
+    ASSERT(diff);
+    ASSERT_BSONOBJ_EQ(BSON("$set" << BSON("pad" << kPadding << "z" << 1)), *diff);
+}
+
+TEST(DocumentDiffTest, AddedFieldsOutOfOrderAreNotDiffed) {
+    auto pre = withPadding("{_id: 0, a: 1}");
+    BSONObjBuilder postBuilder;
+    postBuilder.appendElements(pre);
+    postBuilder.append("z", 1);
+    postBuilder.append("b", 1);
+    ASSERT_FALSE(computeModifierDiff(pre, postBuilder.obj()));
+}
+
+TEST(DocumentDiffTest, AddedFieldBeforeKeptFieldIsNotDiffed) {
+    ASSERT_FALSE(computeModifierDiff(withPadding("{_id: 0, b: 1}"),
+                                     withPadding("{_id: 0, a: 1, b: 1}")));
+}
+
+TEST(DocumentDiffTest, ReorderedFieldsAreNotDiffed) {
+    ASSERT_FALSE(computeModifierDiff(withPadding("{_id: 0, a: 1, b: 2}"),
+                                     withPadding("{_id: 0, b: 2, a: 1}")));
+}
+
+TEST(DocumentDiffTest, ReorderedSubdocumentIsSetWhole) {
+    auto diff = computeModifierDiff(withPadding("{_id: 0, a: {x: 1, y: 2}}"),
+                                    withPadding("{_id: 0, a: {y: 2, x: 1}}"));
+    ASSERT(diff);
+    ASSERT_BSONOBJ_EQ(fromjson("{$set: {a: {y: 2, x: 1}}}"), *diff);
+}
+
+TEST(DocumentDiffTest, ArraysAndTypeChangesAreSetWhole) {
+    auto diff = computeModifierDiff(withPadding("{_id: 0, a: [1, 2], b: 1, c: {d: 1}}"),
+                                    withPadding("{_id: 0, a: [1, 3], b: 1.0, c: 5}"));
+    ASSERT(diff);
+    ASSERT_BSONOBJ_EQ(fromjson("{$set: {a: [1, 3], b: 1.0, c: 5}}"), *diff);
+}
+
+TEST(DocumentDiffTest, FieldNamesThatCannotBePathsAreSetWithParent) {
+    auto pre = withPadding("{_id: 0, a: {'b.c': 1, d: 1}}");
+    auto post = withPadding("{_id: 0, a: {'b.c': 2, d: 1}}");
+    auto diff = computeModifierDiff(pre, post);
+    ASSERT(diff);
+    ASSERT_BSONOBJ_EQ(fromjson("{$set: {a: {'b.c': 2, d: 1}}}"), *diff);
+}
+
+TEST(DocumentDiffTest, DiffNoSmallerThanDocumentIsNotReturned) {
+    ASSERT_FALSE(computeModifierDiff(fromjson("{_id: 0, a: 1}"), fromjson("{_id: 0, a: 2}")));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -36,7 +36,9 @@
 #include "mongo/db/logical_clock.h"
 #include "mongo/db/logical_time.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/update/document_diff.h"
 #include "mongo/db/update/storage_validation.h"
+#include "mongo/db/update/update_parameters_gen.h"
 
 namespace mongo {
 
@@ -141,6 +143,25 @@ UpdateExecutor::ApplyResult ObjectReplaceExecutor::applyReplacementUpdate(
         }
     }
 
+    if (applyParams.logBuilder && gLogReplacementUpdatesAsDiffs.load()) {
+        if (auto diff = document_diff::computeModifierDiff(
+                originalDoc, applyParams.element.getDocument().getObject())) {
+            if (auto sets = (*diff)["$set"]) {
+                for (auto&& elem : sets.Obj()) {
+                    invariant(applyParams.logBuilder->addToSetsWithNewFieldName(
+                        elem.fieldNameStringData(), elem));
+                }
+            }
+            if (auto unsets = (*diff)["$unset"]) {
+                for (auto&& elem : unsets.Obj()) {
+                    invariant(applyParams.logBuilder->addToUnsets(elem.fieldNameStringData()));
+                }
+            }
+            invariant(applyParams.logBuilder->setUpdateSemantics(UpdateSemantics::kUpdateNode));
+            return ApplyResult();
+        }
+    }
+
     if (applyParams.logBuilder) {
         auto replacementObject = applyParams.logBuilder->getDocument().end();
         invariant(applyParams.logBuilder->getReplacementObject(&replacementObject));
@@ -36,7 +36,9 @@
 #include "mongo/db/json.h"
 #include "mongo/db/logical_clock.h"
 #include "mongo/db/update/update_node_test_fixture.h"
+#include "mongo/db/update/update_parameters_gen.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -151,6 +153,34 @@ TEST_F(ObjectReplaceExecutorTest, ComplexDoc) {
     ASSERT_EQUALS(fromjson("{a: 1, b: [0, 1, 2], c: {d: 1}}"), getLogDoc());
 }
 
+TEST_F(ObjectReplaceExecutorTest, LogsDiffWhenEnabledAndSmaller) {
+    gLogReplacementUpdatesAsDiffs.store(true);
+    ON_BLOCK_EXIT([] { gLogReplacementUpdatesAsDiffs.store(false); });
+
+    const std::string padding(100, 'x');
+    auto obj = BSON("_id" << 0 << "a" << 2 << "pad" << padding);
+    ObjectReplaceExecutor node(obj);
+
+    mutablebson::Document doc(BSON("_id" << 0 << "a" << 1 << "b" << 1 << "pad" << padding));
+    auto result = node.applyUpdate(getApplyParams(doc.root()));
+    ASSERT_FALSE(result.noop);
+    ASSERT_EQUALS(obj, doc);
+    ASSERT_EQUALS(fromjson("{$v: 1, $set: {a: 2}, $unset: {b: true}}"), getLogDoc());
+}
+
+TEST_F(ObjectReplaceExecutorTest, LogsReplacementWhenDiffIsNotSmaller) {
+    gLogReplacementUpdatesAsDiffs.store(true);
+    ON_BLOCK_EXIT([] { gLogReplacementUpdatesAsDiffs.store(false); });
+
+    auto obj = fromjson("{_id: 0, a: 2}");
+    ObjectReplaceExecutor node(obj);
+
+    mutablebson::Document doc(fromjson("{_id: 0, a: 1}"));
+    auto result = node.applyUpdate(getApplyParams(doc.root()));
+    ASSERT_FALSE(result.noop);
+    ASSERT_EQUALS(fromjson("{_id: 0, a: 2}"), getLogDoc());
+}
+
 TEST_F(ObjectReplaceExecutorTest, CannotRemoveImmutablePath) {
     auto obj = fromjson("{_id: 0, c: 1}");
     ObjectReplaceExecutor node(obj);
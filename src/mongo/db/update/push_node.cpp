@@ -296,6 +296,36 @@ ModifierNode::ModifyResult PushNode::performPush(mutablebson::Element* element,
                                 << (idElem.ok() ? idElem.toString() : "no id") << "}");
     }
 
+    // Appending to an array while trimming it from the front, as when keeping its most recent
+    // entries, often leaves the array the same size. Build the result from the serialized array
+    // and set it as the new value, so that an array of the same size is overwritten in place
+    // rather than forcing the whole document to be rewritten.
+    if (_slice && _slice.get() < 0 && !_sort && !_position && element->hasValue()) {
+        const auto existing = element->getValueArray();
+        const auto totalCount =
+            static_cast<long long>(existing.nFields() + _valuesToPush.size());
+        auto toSkip = totalCount - safeApproximateAbs(_slice.get());
+        if (toSkip > 0) {
+            BSONArrayBuilder trimmed;
+            for (auto&& value : existing) {
+                if (toSkip > 0) {
+                    --toSkip;
+                } else {
+                    trimmed.append(value);
+                }
+            }
+            for (auto&& value : _valuesToPush) {
+                if (toSkip > 0) {
+                    --toSkip;
+                } else {
+                    trimmed.append(value);
+                }
+            }
+            invariant(element->setValueArray(trimmed.arr()));
+            return ModifyResult::kNormalUpdate;
+        }
+    }
+
     auto result = insertElementsWithPosition(element, _position, _valuesToPush);
 
     if (_sort) {
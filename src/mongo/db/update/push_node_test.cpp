@@ -519,6 +519,47 @@ TEST_F(PushNodeTest, ApplyToArrayWithSlice) {
     ASSERT_EQUALS("{a}", getModifiedPaths());
 }
 
+TEST_F(PushNodeTest, ApplyToArrayWithNegativeSliceOfSameSizeIsInPlace) {
+    auto update = fromjson("{$push: {a: {$each: [4], $slice: -3}}}");
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    PushNode node;
+    ASSERT_OK(node.init(update["$push"]["a"], expCtx));
+
+    mutablebson::Document doc(fromjson("{a: [1, 2, 3]}"));
+    setPathTaken("a");
+    addIndexedPath("a");
+    auto result = node.apply(getApplyParams(doc.root()["a"]), getUpdateNodeApplyParams());
+    ASSERT_FALSE(result.noop);
+    ASSERT_TRUE(result.indexesAffected);
+    ASSERT_EQUALS(fromjson("{a: [2, 3, 4]}"), doc);
+    ASSERT_TRUE(doc.isInPlaceModeEnabled());
+    ASSERT_EQUALS(fromjson("{$set: {a: [2, 3, 4]}}"), getLogDoc());
+    ASSERT_EQUALS("{a}", getModifiedPaths());
+
+    mutablebson::DamageVector damages;
+    const char* source = nullptr;
+    ASSERT_TRUE(doc.getInPlaceUpdates(&damages, &source));
+    ASSERT_FALSE(damages.empty());
+}
+
+TEST_F(PushNodeTest, ApplyToArrayWithNegativeSliceOfDifferentSizeIsNotInPlace) {
+    auto update = fromjson("{$push: {a: {$each: ['abc', 5], $slice: -3}}}");
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    PushNode node;
+    ASSERT_OK(node.init(update["$push"]["a"], expCtx));
+
+    mutablebson::Document doc(fromjson("{a: [1, 2, 3]}"));
+    setPathTaken("a");
+    addIndexedPath("a");
+    auto result = node.apply(getApplyParams(doc.root()["a"]), getUpdateNodeApplyParams());
+    ASSERT_FALSE(result.noop);
+    ASSERT_TRUE(result.indexesAffected);
+    ASSERT_EQUALS(fromjson("{a: [3, 'abc', 5]}"), doc);
+    ASSERT_FALSE(doc.isInPlaceModeEnabled());
+    ASSERT_EQUALS(fromjson("{$set: {a: [3, 'abc', 5]}}"), getLogDoc());
+    ASSERT_EQUALS("{a}", getModifiedPaths());
+}
+
 TEST_F(PushNodeTest, ApplyWithNumericSort) {
     auto update = fromjson("{$push: {a: {$each: [2, -1], $sort: 1}}}");
     boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
@@ -278,7 +278,6 @@ Status UpdateDriver::update(StringData matchedField,
     auto applyResult = _updateExecutor->applyUpdate(applyParams);
     if (applyResult.indexesAffected) {
         _affectIndices = true;
-        doc->disableInPlaceUpdates();
     }
     if (docWasModified) {
         *docWasModified = !applyResult.noop;
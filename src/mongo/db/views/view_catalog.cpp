@@ -100,6 +100,7 @@ Status ViewCatalog::_reload(WithLock,
                 "durable_getName"_attr = _durable->getName());
 
     _viewMap.clear();
+    _resolvedViewCache.clear();
     _valid = false;
     _viewGraphNeedsRefresh = true;
 
@@ -155,6 +156,7 @@ void ViewCatalog::clear() {
     stdx::unique_lock<Latch> lk(_mutex);
 
     _viewMap.clear();
+    _resolvedViewCache.clear();
     _viewGraph.clear();
     _valid = true;
     _viewGraphNeedsRefresh = false;
@@ -231,6 +233,7 @@ Status ViewCatalog::_createOrUpdateView(WithLock lk,
 
     opCtx->recoveryUnit()->onRollback([this, viewName, opCtx, viewRid]() {
         this->_viewMap.erase(viewName.ns());
+        this->_resolvedViewCache.clear();
         this->_viewGraphNeedsRefresh = true;
         CollectionCatalog& catalog = CollectionCatalog::get(opCtx);
         catalog.removeResource(viewRid, viewName.ns());
@@ -460,6 +463,7 @@ Status ViewCatalog::modifyView(OperationContext* opCtx,
 
     opCtx->recoveryUnit()->onRollback([this, viewName, savedDefinition, opCtx]() {
         this->_viewMap[viewName.ns()] = std::make_shared<ViewDefinition>(savedDefinition);
+        this->_resolvedViewCache.clear();
         auto viewRid = ResourceId(RESOURCE_COLLECTION, viewName.ns());
         CollectionCatalog& catalog = CollectionCatalog::get(opCtx);
         catalog.addResource(viewRid, viewName.ns());
@@ -500,6 +504,7 @@ Status ViewCatalog::dropView(OperationContext* opCtx, const NamespaceString& vie
     _durable->remove(opCtx, viewName);
     _viewGraph.remove(savedDefinition.name());
     _viewMap.erase(viewName.ns());
+    _resolvedViewCache.clear();
 
     CollectionCatalog& catalog = CollectionCatalog::get(opCtx);
     auto viewRid = ResourceId(RESOURCE_COLLECTION, viewName.ns());
@@ -508,6 +513,7 @@ Status ViewCatalog::dropView(OperationContext* opCtx, const NamespaceString& vie
     opCtx->recoveryUnit()->onRollback([this, viewName, savedDefinition, opCtx, viewRid]() {
         this->_viewGraphNeedsRefresh = true;
         this->_viewMap[viewName.ns()] = std::make_shared<ViewDefinition>(savedDefinition);
+        this->_resolvedViewCache.clear();
         CollectionCatalog& catalog = CollectionCatalog::get(opCtx);
         catalog.addResource(viewRid, viewName.ns());
     });
@@ -568,6 +574,20 @@ StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
 
     _requireValidCatalog(lock);
 
+    auto cached = _resolvedViewCache.find(nss.ns());
+    if (cached != _resolvedViewCache.end()) {
+        return cached->second;
+    }
+
+    // Only views are cached, so that resolving arbitrary collection names cannot grow the cache
+    // beyond the number of views in the database.
+    auto cacheIfView = [&](ResolvedView resolved, int depth) -> StatusWith<ResolvedView> {
+        if (depth > 0) {
+            _resolvedViewCache.emplace(nss.ns(), resolved);
+        }
+        return std::move(resolved);
+    };
+
     // Keep looping until the resolution completes. If the catalog is invalidated during the
     // resolution, we start over from the beginning.
     while (true) {
@@ -600,10 +620,11 @@ StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
                             str::stream() << "View pipeline exceeds maximum size; maximum size is "
                                           << ViewGraph::kMaxViewPipelineSizeBytes};
                 }
-                return StatusWith<ResolvedView>(
+                return cacheIfView(
                     {*resolvedNss,
                      std::move(resolvedPipeline),
-                     collation ? std::move(collation.get()) : CollationSpec::kSimpleSpec});
+                     collation ? std::move(collation.get()) : CollationSpec::kSimpleSpec},
+                    depth);
             }
 
             resolvedNss = &view->viewOn();
@@ -618,8 +639,9 @@ StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
 
             // If the first stage is a $collStats, then we return early with the viewOn namespace.
             if (toPrepend.size() > 0 && !toPrepend[0]["$collStats"].eoo()) {
-                return StatusWith<ResolvedView>(
-                    {*resolvedNss, std::move(resolvedPipeline), std::move(collation.get())});
+                return cacheIfView(
+                    {*resolvedNss, std::move(resolvedPipeline), std::move(collation.get())},
+                    depth + 1);
             }
         }
 
@@ -202,6 +202,10 @@ private:
     Mutex _mutex = MONGO_MAKE_LATCH("ViewCatalog::_mutex");  // Protects all members.
     ViewMap _viewMap;
     ViewMap _viewMapBackup;
+
+    // Fully resolved views by namespace, so that queries on nested views need not walk the view
+    // graph each time. Cleared whenever '_viewMap' changes.
+    StringMap<ResolvedView> _resolvedViewCache;
     std::unique_ptr<DurableViewCatalog> _durable;
     bool _valid;
     ViewGraph _viewGraph;
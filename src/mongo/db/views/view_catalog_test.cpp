@@ -673,6 +673,48 @@ TEST_F(ViewCatalogFixture, ResolveViewCorrectPipeline) {
     }
 }
 
+TEST_F(ViewCatalogFixture, ResolveViewReflectsChangesToUnderlyingViews) {
+    const NamespaceString view1("db.view1");
+    const NamespaceString view2("db.view2");
+    const NamespaceString viewOn("db.coll");
+    const NamespaceString otherViewOn("db.otherColl");
+    BSONArrayBuilder pipeline1;
+    BSONArrayBuilder pipeline2;
+    BSONArrayBuilder modifiedPipeline1;
+
+    pipeline1 << BSON("$match" << BSON("foo" << 1));
+    pipeline2 << BSON("$match" << BSON("foo" << 2));
+    modifiedPipeline1 << BSON("$match" << BSON("bar" << 1));
+
+    ASSERT_OK(createView(operationContext(), view1, viewOn, pipeline1.arr(), emptyCollation));
+    ASSERT_OK(createView(operationContext(), view2, view1, pipeline2.arr(), emptyCollation));
+
+    auto resolve = [&] {
+        Lock::DBLock dbLock(operationContext(), "db", MODE_IS);
+        return uassertStatusOK(getViewCatalog()->resolveView(operationContext(), view2));
+    };
+
+    // Resolve twice so that the second resolution is served from the cache.
+    ASSERT_EQ(resolve().getNamespace(), viewOn);
+    auto resolvedView = resolve();
+    ASSERT_EQ(resolvedView.getNamespace(), viewOn);
+    ASSERT_EQ(resolvedView.getPipeline().size(), 2U);
+    ASSERT_BSONOBJ_EQ(resolvedView.getPipeline()[0], BSON("$match" << BSON("foo" << 1)));
+
+    // Modifying a view that 'view2' depends on must invalidate its resolution.
+    ASSERT_OK(modifyView(operationContext(), view1, otherViewOn, modifiedPipeline1.arr()));
+    resolvedView = resolve();
+    ASSERT_EQ(resolvedView.getNamespace(), otherViewOn);
+    ASSERT_EQ(resolvedView.getPipeline().size(), 2U);
+    ASSERT_BSONOBJ_EQ(resolvedView.getPipeline()[0], BSON("$match" << BSON("bar" << 1)));
+
+    // Once 'view1' is dropped, 'view2' reads directly from the namespace 'view1' used to be.
+    ASSERT_OK(dropView(operationContext(), view1));
+    resolvedView = resolve();
+    ASSERT_EQ(resolvedView.getNamespace(), view1);
+    ASSERT_EQ(resolvedView.getPipeline().size(), 1U);
+}
+
 TEST_F(ViewCatalogFixture, ResolveViewOnCollectionNamespace) {
     const NamespaceString collectionNamespace("db.coll");
 
@@ -280,6 +280,40 @@ public:
     }
 };
 
+/**
+ * Test that documents buffered while the worker can't write are inserted in batches.
+ */
+class DeferredWriterTestBatched : public DeferredWriterTestBase {
+public:
+    void run(void) {
+        int nDocs = 2 * DeferredWriter::kMaxBatchDocuments;
+        ensureEmpty();
+        auto gw = getWriter();
+        auto writer = gw.get();
+        {
+            // Hold the worker off so that the documents pile up.
+            Lock::GlobalWrite lock(_opCtx.get());
+            for (int i = 0; i < nDocs; ++i) {
+                ASSERT(writer->insertDocument(getObj()));
+            }
+        }
+
+        // Spin-wait for one minute or until all the documents have been written.
+        using namespace std::chrono_literals;
+        auto start = stdx::chrono::system_clock::now();
+        while (stdx::chrono::system_clock::now() - start < 1min &&
+               (readCollection().size() < (size_t)nDocs || writer->getBatchesWritten() < 2)) {
+            stdx::this_thread::yield();
+        }
+
+        // The worker takes at most one partial batch before it blocks on the lock, and writes
+        // the rest in full batches.
+        ASSERT_EQ((size_t)nDocs, readCollection().size());
+        ASSERT_GTE(writer->getBatchesWritten(), 2);
+        ASSERT_LTE(writer->getBatchesWritten(), 3);
+    }
+};
+
 /**
  * Test that the DeferredWriter rejects documents over the buffer size.
  * When this happens, check that the logging counter resets after the first
@@ -379,6 +413,7 @@ public:
         add<DeferredWriterTestConcurrent>();
         add<DeferredWriterTestConsistent>();
         add<DeferredWriterTestNoDeadlock>();
+        add<DeferredWriterTestBatched>();
         add<DeferredWriterTestCap>();
         add<DeferredWriterTestAsync>();
     }
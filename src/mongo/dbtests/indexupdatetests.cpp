@@ -34,6 +34,7 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog/multi_index_block.h"
+#include "mongo/db/catalog/multi_index_block_gen.h"
 #include "mongo/db/catalog/uncommitted_collections.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/client.h"
@@ -41,8 +42,10 @@
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/storage_engine_init.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/util/scopeguard.h"
 
 namespace IndexUpdateTests {
 
@@ -222,6 +225,69 @@ public:
     }
 };
 
+/** Keys generated on several threads during the collection scan all reach the indexes. */
+class InsertBuildWithKeyGenerationThreads : public IndexBuildBase {
+public:
+    void run() {
+        const int oldNumThreads = maxIndexBuildKeyGenerationThreads.load();
+        maxIndexBuildKeyGenerationThreads.store(4);
+        ON_BLOCK_EXIT([&] { maxIndexBuildKeyGenerationThreads.store(oldNumThreads); });
+
+        AutoGetOrCreateDb dbRaii(_opCtx, _nss.db(), LockMode::MODE_IX);
+        Lock::CollectionLock collLk(_opCtx, _nss, LockMode::MODE_X);
+        Collection* coll = collection();
+
+        // More documents than fit in a single key generation batch.
+        const int numDocs = 10000;
+        {
+            WriteUnitOfWork wunit(_opCtx);
+            OpDebug* const nullOpDebug = nullptr;
+            for (int i = 0; i < numDocs; ++i) {
+                ASSERT_OK(coll->insertDocument(
+                    _opCtx,
+                    InsertStatement(BSON("_id" << i << "a" << BSON_ARRAY(i << -i - 1) << "b" << i)),
+                    nullOpDebug,
+                    true));
+            }
+            wunit.commit();
+        }
+
+        MultiIndexBlock indexer;
+        const std::vector<BSONObj> specs = {
+            BSON("name"
+                 << "a"
+                 << "key" << BSON("a" << 1) << "v" << static_cast<int>(kIndexVersion)),
+            BSON("name"
+                 << "b"
+                 << "key" << BSON("b" << 1) << "v" << static_cast<int>(kIndexVersion)
+                 << "partialFilterExpression" << BSON("b" << BSON("$gte" << numDocs / 2)))};
+
+        ON_BLOCK_EXIT(
+            [&] { indexer.cleanUpAfterBuild(_opCtx, coll, MultiIndexBlock::kNoopOnCleanUpFn); });
+
+        ASSERT_OK(indexer.init(_opCtx, coll, specs, MultiIndexBlock::kNoopOnInitFn).getStatus());
+        ASSERT_OK(indexer.insertAllDocumentsInCollection(_opCtx, coll));
+        ASSERT_OK(indexer.checkConstraints(_opCtx));
+
+        WriteUnitOfWork wunit(_opCtx);
+        ASSERT_OK(indexer.commit(
+            _opCtx, coll, MultiIndexBlock::kNoopOnCreateEachFn, MultiIndexBlock::kNoopOnCommitFn));
+        wunit.commit();
+
+        auto numKeys = [&](StringData indexName) {
+            auto desc = coll->getIndexCatalog()->findIndexByName(_opCtx, indexName);
+            ASSERT(desc);
+            int64_t numKeys = 0;
+            ValidateResults results;
+            coll->getIndexCatalog()->getEntry(desc)->accessMethod()->validate(
+                _opCtx, &numKeys, &results);
+            return numKeys;
+        };
+        ASSERT_EQ(numKeys("a"), 2 * numDocs);
+        ASSERT_EQ(numKeys("b"), numDocs / 2);
+    }
+};
+
 /** Index creation is killed if mayInterrupt is true. */
 class InsertBuildIndexInterrupt : public IndexBuildBase {
 public:
@@ -672,6 +738,7 @@ public:
         addIf<InsertBuildEnforceUnique<true>>();
         addIf<InsertBuildEnforceUnique<false>>();
 
+        add<InsertBuildWithKeyGenerationThreads>();
         add<InsertBuildIndexInterrupt>();
         add<InsertBuildIdIndexInterrupt>();
         add<SameSpecDifferentOption>();
@@ -1089,6 +1089,33 @@ TEST(FromJsonTest, NumericTypes) {
     });
 }
 
+TEST(FromJsonTest, IntegerTextPicksSmallestFittingType) {
+    checkEquivalenceEach({
+        {"{a: 0, b: -0, c: 007}", B().append("a", 0).append("b", 0).append("c", 7).obj()},
+        {"{a: 2147483648, b: -2147483649}",
+         B().append("a", 2147483648LL).append("b", -2147483649LL).obj()},
+        {"{a: 999999999999999999, b: -999999999999999999}",
+         B().append("a", 999999999999999999LL).append("b", -999999999999999999LL).obj()},
+        // Nineteen or more digits, or any non-digit, still goes through the full parsers.
+        {"{a: 1000000000000000000, b: 10000000000000000000}",
+         B().append("a", 1000000000000000000LL).append("b", 1e19).obj()},
+        {"{a: +5, b: 5., c: 5e1, d: 0x10}",
+         B().append("a", 5).append("b", 5.0).append("c", 50.0).append("d", 16.0).obj()},
+        {"{a: [1,-2 ,  3]}", B().append("a", Arr().append(1).append(-2).append(3).arr()).obj()},
+    });
+    BSONObj o = fromjson("{a: 2147483647, b: 2147483648, c: 1000000000000000000, d: 1.0}");
+    ASSERT_EQ(o["a"].type(), NumberInt);
+    ASSERT_EQ(o["b"].type(), NumberLong);
+    ASSERT_EQ(o["c"].type(), NumberLong);
+    ASSERT_EQ(o["d"].type(), NumberDouble);
+
+    checkRejectionEach({
+        "{a: 12abc}",
+        "{a: -}",
+        "{a: 1",
+    });
+}
+
 TEST(FromJsonTest, EmbeddedDates) {
     const long long kMin = 1257829200000;
     const long long kMax = 1257829200100;
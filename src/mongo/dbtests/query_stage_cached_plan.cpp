@@ -47,6 +47,7 @@
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_cache_selectivity.h"
 #include "mongo/db/query/plan_yield_policy.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_params.h"
@@ -269,6 +270,47 @@ TEST_F(QueryStageCachedPlan, QueryStageCachedPlanHitMaxWorks) {
     ASSERT_EQ(cache->get(*cq).state, PlanCache::CacheEntryState::kPresentInactive);
 }
 
+/**
+ * Test that a replan records the new winner for the selectivity bucket of the replanned query, and
+ * that only queries probing into a recorded bucket are pointed at the recorded plan.
+ */
+TEST_F(QueryStageCachedPlan, ReplanRecordsPlanForSelectivityBucket) {
+    AutoGetCollectionForReadCommand ctx(&_opCtx, nss);
+    Collection* collection = ctx.getCollection();
+    ASSERT(collection);
+
+    // Two documents match {a: {$gte: 8}}, which puts the query in bucket 1.
+    auto cq = canonicalQueryFromFilterObj(opCtx(), nss, fromjson("{a: {$gte: 8}, b: 1}"));
+    forceReplanning(collection, cq.get());
+
+    PlanCache* cache = CollectionQueryInfo::get(collection).getPlanCache();
+    auto entry = assertGet(cache->getEntry(*cq));
+    ASSERT_EQ(entry->selectivityProbeIndex, "a_1");
+    ASSERT_EQ(entry->selectivityPlans.size(), 1U);
+    ASSERT_EQ(entry->selectivityPlans.begin()->first, plan_cache_selectivity::bucketForKeyCount(2));
+
+    QueryPlannerParams plannerParams;
+    fillOutPlannerParams(&_opCtx, collection, cq.get(), &plannerParams);
+
+    // One document matches {a: {$gte: 9}}, which falls in the same bucket.
+    {
+        auto similarCq =
+            canonicalQueryFromFilterObj(opCtx(), nss, fromjson("{a: {$gte: 9}, b: 1}"));
+        CachedSolution cs(cache->computeKey(*similarCq), *entry);
+        ASSERT_TRUE(plan_cache_selectivity::choosePlanForSelectivity(
+            &_opCtx, collection, *similarCq, plannerParams, &cs));
+    }
+
+    // All ten documents match {a: {$gte: 0}}, a bucket nothing was recorded for.
+    {
+        auto broaderCq =
+            canonicalQueryFromFilterObj(opCtx(), nss, fromjson("{a: {$gte: 0}, b: 1}"));
+        CachedSolution cs(cache->computeKey(*broaderCq), *entry);
+        ASSERT_FALSE(plan_cache_selectivity::choosePlanForSelectivity(
+            &_opCtx, collection, *broaderCq, plannerParams, &cs));
+    }
+}
+
 /**
  * Test the way cache entries are added (either "active" or "inactive") to the plan cache.
  */
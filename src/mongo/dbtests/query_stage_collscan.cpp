@@ -46,6 +46,7 @@
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_executor.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/dbtests/dbtests.h"
@@ -425,4 +426,74 @@ TEST_F(QueryStageCollectionScanTest, QueryTestCollscanResumeAfterRecordIdSeekFai
     ASSERT_EQUALS(PlanStage::FAILURE, ps->work(&id));
 }
 
+// Verify that a scan bounded by 'minRecord' and 'maxRecord' returns exactly the records in that
+// half-open range, whether or not the record at the lower bound still exists.
+TEST_F(QueryStageCollectionScanTest, QueryTestCollscanRecordIdRange) {
+    dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+    auto coll = ctx.getCollection();
+
+    // Get the RecordIds that would be returned by an in-order scan.
+    vector<RecordId> recordIds;
+    getRecordIds(coll, CollectionScanParams::FORWARD, &recordIds);
+
+    const int begin = 10;
+    const int end = 30;
+    auto scanRange = [&](int expectedFirst) {
+        CollectionScanParams params;
+        params.direction = CollectionScanParams::FORWARD;
+        params.minRecord = recordIds[begin];
+        params.maxRecord = recordIds[end];
+
+        unique_ptr<WorkingSet> ws = std::make_unique<WorkingSet>();
+        unique_ptr<PlanStage> ps =
+            std::make_unique<CollectionScan>(&_opCtx, coll, params, ws.get(), nullptr);
+        auto statusWithPlanExecutor = PlanExecutor::make(
+            &_opCtx, std::move(ws), std::move(ps), coll, PlanExecutor::NO_YIELD);
+        ASSERT_OK(statusWithPlanExecutor.getStatus());
+        auto exec = std::move(statusWithPlanExecutor.getValue());
+
+        int expected = expectedFirst;
+        PlanExecutor::ExecState state;
+        for (BSONObj obj; PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr));) {
+            ASSERT_EQUALS(expected, obj["foo"].numberInt());
+            ++expected;
+        }
+        ASSERT_EQUALS(PlanExecutor::IS_EOF, state);
+        ASSERT_EQUALS(end, expected);
+    };
+
+    scanRange(begin);
+
+    // Delete the record at the lower bound, so that the scan can no longer seek to it.
+    remove(coll->docFor(&_opCtx, recordIds[begin]).value());
+    scanRange(begin + 1);
+}
+
+// Verify that the scans returned by InternalPlanner::partitionedCollectionScan() cover disjoint,
+// increasing ranges that together contain every record exactly once.
+TEST_F(QueryStageCollectionScanTest, QueryTestPartitionedCollscanReturnsEveryRecordOnce) {
+    AutoGetCollectionForReadCommand ctx(&_opCtx, nss);
+    auto collection = ctx.getCollection();
+
+    vector<RecordId> recordIds;
+    getRecordIds(collection, CollectionScanParams::FORWARD, &recordIds);
+
+    const size_t numPartitions = 4;
+    auto executors = InternalPlanner::partitionedCollectionScan(
+        &_opCtx, collection, PlanExecutor::NO_YIELD, numPartitions);
+    ASSERT_GTE(executors.size(), 1U);
+    ASSERT_LTE(executors.size(), numPartitions);
+
+    vector<RecordId> scanned;
+    for (auto&& exec : executors) {
+        RecordId id;
+        PlanExecutor::ExecState state;
+        for (BSONObj obj; PlanExecutor::ADVANCED == (state = exec->getNext(&obj, &id));) {
+            scanned.push_back(id);
+        }
+        ASSERT_EQUALS(PlanExecutor::IS_EOF, state);
+    }
+    ASSERT(scanned == recordIds);
+}
+
 }  // namespace query_stage_collection_scan
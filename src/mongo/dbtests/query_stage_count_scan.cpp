@@ -207,6 +207,41 @@ public:
     }
 };
 
+//
+// Check that several ranges are counted one after the other, and that a document with keys in
+// more than one of them is only counted once
+//
+class QueryStageCountScanMultipleRanges : public CountBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+
+        // Insert some docs
+        for (int i = 0; i < 10; ++i) {
+            insert(BSON("a" << i));
+        }
+        insert(BSON("a" << BSON_ARRAY(1 << 8)));
+
+        // Add an index
+        addIndex(BSON("a" << 1));
+
+        // Count a in [1, 2], (4, 6) and [8, 8].
+        auto params = makeCountScanParams(&_opCtx, getIndex(ctx.db(), BSON("a" << 1)));
+        params.startKey = BSON("" << 1);
+        params.startKeyInclusive = true;
+        params.endKey = BSON("" << 2);
+        params.endKeyInclusive = true;
+        params.additionalRanges.push_back({BSON("" << 4), false, BSON("" << 6), false});
+        params.additionalRanges.push_back({BSON("" << 8), true, BSON("" << 8), true});
+
+        WorkingSet ws;
+        CountScan count(&_opCtx, params, &ws);
+
+        int numCounted = runCount(&count);
+        ASSERT_EQUALS(5, numCounted);
+    }
+};
+
 //
 // Check that cursor returns no results if all docs are below lower bound
 //
@@ -584,6 +619,7 @@ public:
         add<QueryStageCountScanDups>();
         add<QueryStageCountScanInclusiveBounds>();
         add<QueryStageCountScanExclusiveBounds>();
+        add<QueryStageCountScanMultipleRanges>();
         add<QueryStageCountScanLowerBound>();
         add<QueryStageCountScanNothingInInterval>();
         add<QueryStageCountScanNothingInIntervalFirstMatchTooHigh>();
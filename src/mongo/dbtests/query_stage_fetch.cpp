@@ -226,6 +226,74 @@ public:
     }
 };
 
+//
+// Test that a batch of work fetches every RecordId produced by the child's batch and stops at the
+// child's EOF.
+//
+class FetchStageWorkBatch : public QueryStageFetchBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        Collection* coll =
+            CollectionCatalog::get(&_opCtx).lookupCollectionByNamespace(&_opCtx, nss());
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, nss());
+            wuow.commit();
+        }
+
+        WorkingSet ws;
+
+        for (int i = 0; i < 3; ++i) {
+            insert(BSON("foo" << i));
+        }
+        set<RecordId> recordIds;
+        getRecordIds(&recordIds, coll);
+        ASSERT_EQUALS(size_t(3), recordIds.size());
+
+        // Create a mock stage that returns a RecordId, a NEED_TIME and then the rest of the
+        // RecordIds.
+        auto mockStage = std::make_unique<QueuedDataStage>(&_opCtx, &ws);
+        bool first = true;
+        for (auto&& recordId : recordIds) {
+            WorkingSetID id = ws.allocate();
+            WorkingSetMember* mockMember = ws.get(id);
+            mockMember->recordId = recordId;
+            ws.transitionToRecordIdAndIdx(id);
+            mockStage->pushBack(id);
+            if (first) {
+                mockStage->pushBack(PlanStage::NEED_TIME);
+                first = false;
+            }
+        }
+
+        auto fetchStage =
+            std::make_unique<FetchStage>(&_opCtx, &ws, std::move(mockStage), nullptr, coll);
+
+        std::vector<WorkingSetID> results;
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        PlanStage::StageState state = fetchStage->workBatch(10, &results, &id);
+        ASSERT_EQUALS(PlanStage::IS_EOF, state);
+        ASSERT_EQUALS(size_t(3), results.size());
+
+        set<int> seen;
+        for (auto&& resultId : results) {
+            WorkingSetMember* member = ws.get(resultId);
+            ASSERT_TRUE(member->hasObj());
+            seen.insert(member->doc.value()["foo"].getInt());
+        }
+        ASSERT_EQUALS(size_t(3), seen.size());
+
+        // The stats must match those of the equivalent sequence of calls to work().
+        const CommonStats* stats = fetchStage->getCommonStats();
+        ASSERT_EQUALS(size_t(5), stats->works);
+        ASSERT_EQUALS(size_t(3), stats->advanced);
+        ASSERT_EQUALS(size_t(1), stats->needTime);
+        ASSERT_TRUE(fetchStage->isEOF());
+    }
+};
+
 class All : public OldStyleSuiteSpecification {
 public:
     All() : OldStyleSuiteSpecification("query_stage_fetch") {}
@@ -233,6 +301,7 @@ public:
     void setupTests() {
         add<FetchStageAlreadyFetched>();
         add<FetchStageFilter>();
+        add<FetchStageWorkBatch>();
     }
 };
 
@@ -354,6 +354,31 @@ TEST_F(QueryStageMultiPlanTest, MPSDoesCreatesActiveEntryWhenInactiveEntriesDisa
     ASSERT_EQ(cache->get(*cq).state, PlanCache::CacheEntryState::kPresentActive);
 }
 
+// With pruning enabled, a candidate that is clearly less productive than the leader stops being
+// worked after the first pruning round, but still takes part in the final ranking.
+TEST_F(QueryStageMultiPlanTest, MPSPrunesDominatedPlans) {
+    const int N = 5000;
+    for (int i = 0; i < N; ++i) {
+        insert(BSON("foo" << (i % 10)));
+    }
+
+    addIndex(BSON("foo" << 1));
+
+    const int pruneRoundWorks = 10;
+    internalQueryPlanEvaluationPruneRoundWorks.store(pruneRoundWorks);
+    ON_BLOCK_EXIT([] { internalQueryPlanEvaluationPruneRoundWorks.store(0); });
+
+    AutoGetCollectionForReadCommand ctx(_opCtx.get(), nss);
+    const Collection* coll = ctx.getCollection();
+
+    // The collection scan matches only one document in ten, the index scan nearly every time.
+    auto mps = runMultiPlanner(_opCtx.get(), nss, coll, 7);
+
+    auto collScanStats = mps->getChildren()[1]->getStats();
+    ASSERT_EQ(static_cast<size_t>(pruneRoundWorks), collScanStats->common.works);
+    ASSERT_GT(getBestPlanWorks(mps.get()), static_cast<size_t>(pruneRoundWorks));
+}
+
 // Case in which we select a blocking plan as the winner, and a non-blocking plan
 // is available as a backup.
 TEST_F(QueryStageMultiPlanTest, MPSBackupPlan) {
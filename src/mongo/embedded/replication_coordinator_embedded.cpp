@@ -173,6 +173,10 @@ Seconds ReplicationCoordinatorEmbedded::getSlaveDelaySecs() const {
     UASSERT_NOT_IMPLEMENTED;
 }
 
+boost::optional<OpTime> ReplicationCoordinatorEmbedded::getEarliestAppliedOpTimeWaiter() const {
+    UASSERT_NOT_IMPLEMENTED;
+}
+
 void ReplicationCoordinatorEmbedded::clearSyncSourceBlacklist() {
     UASSERT_NOT_IMPLEMENTED;
 }
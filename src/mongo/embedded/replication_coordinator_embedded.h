@@ -104,6 +104,8 @@ public:
 
     Seconds getSlaveDelaySecs() const override;
 
+    boost::optional<repl::OpTime> getEarliestAppliedOpTimeWaiter() const override;
+
     void clearSyncSourceBlacklist() override;
 
     repl::ReplicationCoordinator::StatusAndDuration awaitReplication(
@@ -47,6 +47,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/update/update_driver.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
 
 #include <algorithm>
 #include <memory>
@@ -215,6 +216,10 @@ struct stitch_support_v1_projection {
 
     bool requiresMatch = false;
     stitch_support_v1_matcher* matcher;
+
+    // The result of the last stitch_support_v1_projection_apply_borrowed() call, which the caller
+    // reads in place until the next call.
+    mongo::BSONObj borrowedResult;
 };
 
 struct stitch_support_v1_update_details {
@@ -261,6 +266,10 @@ struct stitch_support_v1_update {
 
     std::map<mongo::StringData, std::unique_ptr<mongo::ExpressionWithPlaceholder>> parsedFilters;
     mongo::UpdateDriver updateDriver;
+
+    // The result of the last stitch_support_v1_update_apply_borrowed() call, which the caller reads
+    // in place until the next call.
+    mongo::BSONObj borrowedResult;
 };
 
 namespace mongo {
@@ -408,6 +417,10 @@ auto toInterfaceType(char* bson) noexcept {
     return static_cast<uint8_t*>(static_cast<void*>(bson));
 }
 
+auto toInterfaceType(const char* bson) noexcept {
+    return static_cast<const uint8_t*>(static_cast<const void*>(bson));
+}
+
 /**
  * fromInterfaceType changes the compiler's interpretation from 'uint8_t*' which is the BSON
  * interface type of the Stitch library to our internal type 'char*'.
@@ -416,6 +429,71 @@ auto fromInterfaceType(const uint8_t* bson) noexcept {
     return static_cast<const char*>(static_cast<const void*>(bson));
 }
 
+/**
+ * Copies 'obj' into a newly allocated buffer that the caller releases with
+ * stitch_support_v1_bson_free().
+ */
+uint8_t* copyToInterfaceBuffer(const BSONObj& obj, StringData operation) {
+    auto outputSize = static_cast<size_t>(obj.objsize());
+    auto output = new (std::nothrow) char[outputSize];
+
+    uassert(ErrorCodes::ExceededMemoryLimit,
+            str::stream() << "Failed to allocate memory for " << operation,
+            output);
+
+    static_cast<void>(std::copy_n(obj.objdata(), outputSize, output));
+    return toInterfaceType(output);
+}
+
+BSONObj projection_apply(stitch_support_v1_projection* const projection,
+                         const uint8_t* documentBSON) {
+    BSONObj document(fromInterfaceType(documentBSON));
+    return projection->projectionExec->applyTransformation(Document{document}).toBson();
+}
+
+BSONObj update_apply(stitch_support_v1_update* const update,
+                     const uint8_t* documentBSON,
+                     stitch_support_v1_update_details* update_details) {
+    BSONObj document(fromInterfaceType(documentBSON));
+    std::string matchedField;
+
+    if (update->updateDriver.needMatchDetails()) {
+        invariant(update->matcher);
+
+        MatchDetails matchDetails;
+        matchDetails.requestElemMatchKey();
+        bool isMatch = update->matcher->matcher.matches(document, &matchDetails);
+        invariant(isMatch);
+        if (matchDetails.hasElemMatchKey()) {
+            matchedField = matchDetails.elemMatchKey();
+        } else {
+            // Empty 'matchedField' indicates that the matcher did not traverse an array.
+        }
+    }
+
+    mutablebson::Document mutableDoc(document, mutablebson::Document::kInPlaceDisabled);
+
+    FieldRefSet immutablePaths;  // Empty set
+    bool docWasModified = false;
+
+    FieldRefSetWithStorage modifiedPaths;
+
+    uassertStatusOK(update->updateDriver.update(matchedField,
+                                                &mutableDoc,
+                                                false /* validateForStorage */,
+                                                immutablePaths,
+                                                false /* isInsert */,
+                                                nullptr /* logOpRec*/,
+                                                &docWasModified,
+                                                &modifiedPaths));
+
+    if (update_details) {
+        update_details->modifiedPaths = modifiedPaths.serialize();
+    }
+
+    return mutableDoc.getObject();
+}
+
 }  // namespace
 }  // namespace mongo
 
@@ -516,19 +594,18 @@ stitch_support_v1_projection_apply(stitch_support_v1_projection* const projectio
                                    const uint8_t* documentBSON,
                                    stitch_support_v1_status* status) {
     return enterCXX(mongo::getStatusImpl(status), [&]() {
-        mongo::BSONObj document(mongo::fromInterfaceType(documentBSON));
-
-        auto outputObj =
-            projection->projectionExec->applyTransformation(mongo::Document{document}).toBson();
-        auto outputSize = static_cast<size_t>(outputObj.objsize());
-        auto output = new (std::nothrow) char[outputSize];
-
-        uassert(mongo::ErrorCodes::ExceededMemoryLimit,
-                "Failed to allocate memory for projection",
-                output);
+        return mongo::copyToInterfaceBuffer(mongo::projection_apply(projection, documentBSON),
+                                            "projection");
+    });
+}
 
-        static_cast<void>(std::copy_n(outputObj.objdata(), outputSize, output));
-        return mongo::toInterfaceType(output);
+const uint8_t* MONGO_API_CALL
+stitch_support_v1_projection_apply_borrowed(stitch_support_v1_projection* const projection,
+                                            const uint8_t* documentBSON,
+                                            stitch_support_v1_status* status) {
+    return enterCXX(mongo::getStatusImpl(status), [&]() {
+        projection->borrowedResult = mongo::projection_apply(projection, documentBSON);
+        return mongo::toInterfaceType(projection->borrowedResult.objdata());
     });
 }
 
@@ -567,54 +644,19 @@ stitch_support_v1_update_apply(stitch_support_v1_update* const update,
                                stitch_support_v1_update_details* update_details,
                                stitch_support_v1_status* status) {
     return enterCXX(mongo::getStatusImpl(status), [&]() {
-        mongo::BSONObj document(mongo::fromInterfaceType(documentBSON));
-        std::string matchedField;
-
-        if (update->updateDriver.needMatchDetails()) {
-            invariant(update->matcher);
-
-            mongo::MatchDetails matchDetails;
-            matchDetails.requestElemMatchKey();
-            bool isMatch = update->matcher->matcher.matches(document, &matchDetails);
-            invariant(isMatch);
-            if (matchDetails.hasElemMatchKey()) {
-                matchedField = matchDetails.elemMatchKey();
-            } else {
-                // Empty 'matchedField' indicates that the matcher did not traverse an array.
-            }
-        }
-
-        mongo::mutablebson::Document mutableDoc(document,
-                                                mongo::mutablebson::Document::kInPlaceDisabled);
-
-        mongo::FieldRefSet immutablePaths;  // Empty set
-        bool docWasModified = false;
-
-        mongo::FieldRefSetWithStorage modifiedPaths;
-
-        uassertStatusOK(update->updateDriver.update(matchedField,
-                                                    &mutableDoc,
-                                                    false /* validateForStorage */,
-                                                    immutablePaths,
-                                                    false /* isInsert */,
-                                                    nullptr /* logOpRec*/,
-                                                    &docWasModified,
-                                                    &modifiedPaths));
-
-        auto outputObj = mutableDoc.getObject();
-        size_t outputSize = static_cast<size_t>(outputObj.objsize());
-        auto output = new (std::nothrow) char[outputSize];
-
-        uassert(
-            mongo::ErrorCodes::ExceededMemoryLimit, "Failed to allocate memory for update", output);
-
-        static_cast<void>(std::copy_n(outputObj.objdata(), outputSize, output));
-
-        if (update_details) {
-            update_details->modifiedPaths = modifiedPaths.serialize();
-        }
+        return mongo::copyToInterfaceBuffer(
+            mongo::update_apply(update, documentBSON, update_details), "update");
+    });
+}
 
-        return mongo::toInterfaceType(output);
+const uint8_t* MONGO_API_CALL
+stitch_support_v1_update_apply_borrowed(stitch_support_v1_update* const update,
+                                        const uint8_t* documentBSON,
+                                        stitch_support_v1_update_details* update_details,
+                                        stitch_support_v1_status* status) {
+    return enterCXX(mongo::getStatusImpl(status), [&]() {
+        update->borrowedResult = mongo::update_apply(update, documentBSON, update_details);
+        return mongo::toInterfaceType(update->borrowedResult.objdata());
     });
 }
 
@@ -647,15 +689,7 @@ uint8_t* MONGO_API_CALL stitch_support_v1_update_upsert(stitch_support_v1_update
                                                     &docWasModified,
                                                     nullptr /* modifiedPaths */));
 
-        auto outputObj = mutableDoc.getObject();
-        size_t outputSize = static_cast<size_t>(outputObj.objsize());
-        auto output = new (std::nothrow) char[outputSize];
-
-        uassert(
-            mongo::ErrorCodes::ExceededMemoryLimit, "Failed to allocate memory for upsert", output);
-
-        static_cast<void>(std::copy_n(outputObj.objdata(), outputSize, output));
-        return mongo::toInterfaceType(output);
+        return mongo::copyToInterfaceBuffer(mutableDoc.getObject(), "upsert");
     });
 }
 
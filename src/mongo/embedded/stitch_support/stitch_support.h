@@ -397,6 +397,20 @@ stitch_support_v1_projection_apply(stitch_support_v1_projection* const projectio
                                    const uint8_t* documentBSON,
                                    stitch_support_v1_status* status);
 
+/**
+ * Apply a projection to an input document like stitch_support_v1_projection_apply(), but without
+ * copying the result into a caller-owned buffer. Returns a pointer to the resulting BSON on success
+ * or NULL on error. 'status' is populated in the error case.
+ *
+ * The returned buffer is owned by the projection object and remains valid only until the next call
+ * to this function with the same projection or until the projection is destroyed. It must not be
+ * passed to stitch_support_v1_bson_free().
+ */
+STITCH_SUPPORT_API const uint8_t* MONGO_API_CALL
+stitch_support_v1_projection_apply_borrowed(stitch_support_v1_projection* const projection,
+                                            const uint8_t* documentBSON,
+                                            stitch_support_v1_status* status);
+
 /**
  * Returns true iff applying this projection requires a matcher that matches the input document,
  * as is the case when the projection includes the positional ($) operator.
@@ -521,6 +535,21 @@ stitch_support_v1_update_apply(stitch_support_v1_update* const update,
                                stitch_support_v1_update_details* update_details,
                                stitch_support_v1_status* status);
 
+/**
+ * Apply an update to an input document like stitch_support_v1_update_apply(), but without copying
+ * the result into a caller-owned buffer. Returns a pointer to the resulting BSON on success or NULL
+ * on error. 'status' is populated in the error case.
+ *
+ * The returned buffer is owned by the update object and remains valid only until the next call to
+ * this function with the same update or until the update is destroyed. It must not be passed to
+ * stitch_support_v1_bson_free().
+ */
+STITCH_SUPPORT_API const uint8_t* MONGO_API_CALL
+stitch_support_v1_update_apply_borrowed(stitch_support_v1_update* const update,
+                                        const uint8_t* documentBSON,
+                                        stitch_support_v1_update_details* update_details,
+                                        stitch_support_v1_status* status);
+
 /**
  * Return the document that would result from an {upsert: true} update operation that must perform
  * an upsert. There is no "input document," like in stitch_support_v1_apply(), because upserts occur
@@ -462,6 +462,41 @@ TEST_F(StitchSupportTest, CheckProjectionCollatesRespectfully) {
     ASSERT_EQ("{ \"_id\" : 1 }", results[0]);
 }
 
+TEST_F(StitchSupportTest, CheckBorrowedProjectionIsValidUntilTheNextCall) {
+    auto projection = stitch_support_v1_projection_create(
+        lib, toBSONForAPI("{a: 1}").first, nullptr, nullptr, nullptr);
+    ASSERT(projection);
+    ON_BLOCK_EXIT([projection] { stitch_support_v1_projection_destroy(projection); });
+
+    auto result = stitch_support_v1_projection_apply_borrowed(
+        projection, toBSONForAPI("{_id: 1, a: 100, b: 200}").first, nullptr);
+    ASSERT(result);
+    ASSERT_EQ("{ \"_id\" : 1, \"a\" : 100 }", fromBSONForAPI(result));
+
+    result = stitch_support_v1_projection_apply_borrowed(
+        projection, toBSONForAPI("{_id: 2, a: 200, b: 300}").first, nullptr);
+    ASSERT(result);
+    ASSERT_EQ("{ \"_id\" : 2, \"a\" : 200 }", fromBSONForAPI(result));
+}
+
+TEST_F(StitchSupportTest, CheckBorrowedUpdateIsValidUntilTheNextCall) {
+    auto update = stitch_support_v1_update_create(
+        lib, toBSONForAPI("{$inc: {a: 1}}").first, nullptr, nullptr, nullptr, nullptr);
+    ASSERT(update);
+    ON_BLOCK_EXIT([update] { stitch_support_v1_update_destroy(update); });
+
+    auto result = stitch_support_v1_update_apply_borrowed(
+        update, toBSONForAPI("{a: 1}").first, updateDetails, status);
+    ASSERT(result);
+    ASSERT_EQ("{ \"a\" : 2 }", fromBSONForAPI(result));
+    ASSERT_EQ("[a]", getModifiedPaths());
+
+    result = stitch_support_v1_update_apply_borrowed(
+        update, toBSONForAPI("{a: 5, b: 1}").first, nullptr, nullptr);
+    ASSERT(result);
+    ASSERT_EQ("{ \"a\" : 6, \"b\" : 1 }", fromBSONForAPI(result));
+}
+
 TEST_F(StitchSupportTest, TestUpdateSingleElement) {
     ASSERT_EQ("{ \"a\" : 2 }", checkUpdate("{$set: {a: 2}}", "{a: 1}"));
     ASSERT_EQ("[a]", getModifiedPaths());
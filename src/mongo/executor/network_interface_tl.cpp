@@ -36,6 +36,7 @@
 #include "mongo/db/commands/test_commands_enabled.h"
 #include "mongo/db/server_options.h"
 #include "mongo/executor/connection_pool_tl.h"
+#include "mongo/executor/network_interface_tl_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/transport/transport_layer_manager.h"
@@ -90,6 +91,61 @@ private:
     Counters _data;
 };
 
+/**
+ * HostLatencyEstimates keeps a running estimate of the 95th percentile response time of each host
+ * that has served a hedged request, so that hedged requests can try the fastest hosts first.
+ */
+class NetworkInterfaceTL::HostLatencyEstimates {
+public:
+    void record(const HostAndPort& host, Milliseconds latency) {
+        const auto sample = static_cast<double>(durationCount<Milliseconds>(latency));
+
+        stdx::lock_guard lk(_mutex);
+        auto& estimate = _estimates[host];
+        if (estimate.samples++ == 0) {
+            estimate.mean = sample;
+            return;
+        }
+
+        // Exponentially weighted mean and variance, so that the estimate follows a host as it
+        // slows down or recovers.
+        const auto delta = sample - estimate.mean;
+        estimate.mean += kWeight * delta;
+        estimate.variance = (1 - kWeight) * (estimate.variance + kWeight * delta * delta);
+    }
+
+    /**
+     * Stable-sorts 'hosts' by increasing estimated p95 latency. Hosts without samples sort first so
+     * that they get measured.
+     */
+    void sortByLatency(std::vector<HostAndPort>* hosts) const {
+        stdx::lock_guard lk(_mutex);
+        auto p95 = [&](const HostAndPort& host) {
+            auto it = _estimates.find(host);
+            if (it == _estimates.end()) {
+                return 0.0;
+            }
+            return it->second.mean + 1.645 * std::sqrt(it->second.variance);
+        };
+        std::stable_sort(hosts->begin(), hosts->end(), [&](const auto& a, const auto& b) {
+            return p95(a) < p95(b);
+        });
+    }
+
+private:
+    static constexpr double kWeight = 0.1;
+
+    struct Estimate {
+        long long samples = 0;
+        double mean = 0;
+        double variance = 0;
+    };
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0),
+                                            "NetworkInterfaceTL::HostLatencyEstimates::_mutex");
+    stdx::unordered_map<HostAndPort, Estimate> _estimates;
+};
+
 NetworkInterfaceTL::NetworkInterfaceTL(std::string instanceName,
                                        ConnectionPool::Options connPoolOpts,
                                        ServiceContext* svcCtx,
@@ -99,6 +155,7 @@ NetworkInterfaceTL::NetworkInterfaceTL(std::string instanceName,
       _svcCtx(svcCtx),
       _connPoolOpts(std::move(connPoolOpts)),
       _onConnectHook(std::move(onConnectHook)),
+      _hostLatencies(std::make_shared<HostLatencyEstimates>()),
       _metadataHook(std::move(metadataHook)),
       _state(kDefault) {
     if (_svcCtx) {
@@ -405,6 +462,13 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
         request.metadata = newMetadata.obj();
     }
 
+    // Connections to the targets are requested in order and the command is sent on the first one
+    // that is available, so put the hosts that have been responding fastest first.
+    if (request.hedgeOptions && request.target.size() > 1 &&
+        gNetworkInterfaceOrderHedgedTargetsByLatency.load()) {
+        _hostLatencies->sortByLatency(&request.target);
+    }
+
     auto [cmdState, future] = CommandState::make(this, request, cbHandle);
     if (cmdState->requestOnAny.timeout != cmdState->requestOnAny.kNoTimeout) {
         cmdState->deadline = cmdState->stopwatch.start() + cmdState->requestOnAny.timeout;
@@ -568,6 +632,11 @@ void NetworkInterfaceTL::RequestState::resolve(Future<RemoteCommandResponse> fut
     auto anyFuture =
         std::move(future)
             .then([this, anchor = shared_from_this()](RemoteCommandResponse response) {
+                if (cmdState->requestOnAny.hedgeOptions) {
+                    interface()->_hostLatencies->record(
+                        host, response.elapsedMillis.value_or(stopwatch.elapsed()));
+                }
+
                 // The RCRq ran successfully, wrap the result with the host in question
                 return RemoteCommandOnAnyResponse(host, std::move(response));
             })
@@ -581,6 +650,11 @@ void NetworkInterfaceTL::RequestState::resolve(Future<RemoteCommandResponse> fut
                     error = Status(ErrorCodes::HostUnreachable, error.reason());
                 }
 
+                // A host that fails is as bad for the tail as one that is slow.
+                if (cmdState->requestOnAny.hedgeOptions) {
+                    interface()->_hostLatencies->record(host, stopwatch.elapsed());
+                }
+
                 return RemoteCommandOnAnyResponse(host, std::move(error), stopwatch.elapsed());
             });
 
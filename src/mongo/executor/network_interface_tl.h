@@ -295,6 +295,9 @@ private:
     class SynchronizedCounters;
     std::shared_ptr<SynchronizedCounters> _counters;
 
+    class HostLatencyEstimates;
+    std::shared_ptr<HostLatencyEstimates> _hostLatencies;
+
     std::unique_ptr<rpc::EgressMetadataHook> _metadataHook;
 
     // We start in kDefault, transition to kStarted after startup() is complete and enter kStopped
@@ -33,6 +33,10 @@
 
 #include <algorithm>
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #include "mongo/executor/connection_pool_stats.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/executor/task_executor_pool_parameters_gen.h"
@@ -85,6 +89,14 @@ void TaskExecutorPool::addExecutors(std::vector<std::shared_ptr<TaskExecutor>> e
 
 const std::shared_ptr<TaskExecutor>& TaskExecutorPool::getArbitraryExecutor() {
     invariant(!_executors.empty());
+#ifdef __linux__
+    if (taskExecutorPoolCoreAffinity.load()) {
+        auto cpu = sched_getcpu();
+        if (cpu >= 0) {
+            return _executors[static_cast<size_t>(cpu) % _executors.size()];
+        }
+    }
+#endif
     uint64_t idx = (_counter.fetchAndAdd(1) % _executors.size());
     return _executors[idx];
 }
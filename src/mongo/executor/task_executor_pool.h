@@ -88,6 +88,10 @@ public:
      *
      * Use this method if you need a TaskExecutor for performing performance-critical work.
      *
+     * With the taskExecutorPoolCoreAffinity parameter set, the executor is chosen by the CPU the
+     * calling thread is running on, which keeps each executor's connection pool mutex mostly
+     * core-local instead of shared by every thread in the process.
+     *
      * Thread-safe.
      */
     const std::shared_ptr<TaskExecutor>& getArbitraryExecutor();
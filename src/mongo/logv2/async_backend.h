@@ -0,0 +1,274 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/detail/locking_ptr.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/sinks/frontend_requirements.hpp>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "mongo/logv2/attributes.h"
+#include "mongo/logv2/log_severity.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+
+namespace mongo {
+namespace logv2 {
+namespace async_backend_detail {
+// Set on a thread while it writes to a wrapped backend, so that anything it logs meanwhile, such
+// as a stack trace after a crash in the backend, is written directly instead of waiting on itself.
+inline bool& writingOnThisThread() {
+    thread_local bool writing = false;
+    return writing;
+}
+}  // namespace async_backend_detail
+
+/**
+ * Backend that buffers formatted records and has a background thread write them to the wrapped
+ * backend, flushing it once per batch. Loggers only append to one of a few buffers picked by
+ * thread, so they contend neither with each other nor with slow writes.
+ *
+ * Records from one thread keep their order, but records from different threads may be written
+ * out of order. A record of Error severity or worse is written at once, after everything pending,
+ * as is everything pending on flush(), so nothing logged ahead of a fatal error is lost.
+ *
+ * When a thread's buffer is full, the record is dropped and counted (kDrop), or the logging
+ * thread waits for the background thread to empty the buffer (kBlock).
+ */
+template <typename Backend>
+class AsyncBackend
+    : public boost::log::sinks::basic_formatted_sink_backend<
+          char,
+          boost::log::sinks::combine_requirements<boost::log::sinks::concurrent_feeding,
+                                                  boost::log::sinks::flushing>::type> {
+public:
+    enum class OverflowPolicy { kDrop, kBlock };
+
+    // Called from the background thread, with no lock held, with the number of records dropped
+    // since the last call.
+    using DropReporter = std::function<void(uint64_t)>;
+
+    AsyncBackend(boost::shared_ptr<Backend> backend,
+                 size_t bufferSizeBytes,
+                 OverflowPolicy policy,
+                 DropReporter reportDrops = {})
+        : _backend(std::move(backend)),
+          _shardCapacityBytes(std::max<size_t>(bufferSizeBytes / kNumShards, 1)),
+          _policy(policy),
+          _reportDrops(std::move(reportDrops)) {
+        _flusher = stdx::thread([this] { _run(); });
+    }
+
+    ~AsyncBackend() {
+        {
+            stdx::lock_guard<stdx::mutex> lk(_flusherMutex);
+            _shutdown = true;
+        }
+        _flusherCV.notify_one();
+        _flusher.join();
+        flush();
+    }
+
+    /**
+     * Locking accessor to the wrapped backend. Holding it keeps the background thread from
+     * writing.
+     */
+    auto lockedBackend() {
+        return boost::log::aux::locking_ptr(_backend, _writeMutex);
+    }
+
+    /**
+     * Number of records dropped because a buffer was full, since this backend was created.
+     */
+    uint64_t droppedRecords() const {
+        return _totalDropped.load();
+    }
+
+    void consume(boost::log::record_view const& rec, string_type const& formatted_string) {
+        if (async_backend_detail::writingOnThisThread()) {
+            _write(formatted_string);
+            return;
+        }
+
+        auto severity =
+            boost::log::extract<LogSeverity>(attributes::severity(), rec.attribute_values());
+        if (severity && severity.get() >= LogSeverity::Error()) {
+            stdx::lock_guard<stdx::mutex> writeLk(_writeMutex);
+            _drain(writeLk);
+            _write(formatted_string);
+            _flushBackend();
+            return;
+        }
+
+        Shard& shard = _shards[_shardIndex()];
+        stdx::unique_lock<stdx::mutex> lk(shard.mutex);
+        auto fits = [&] {
+            return shard.records.empty() ||
+                shard.bytes + formatted_string.size() <= _shardCapacityBytes;
+        };
+        if (!fits()) {
+            if (_policy == OverflowPolicy::kDrop) {
+                _unreportedDrops.fetchAndAdd(1);
+                _totalDropped.fetchAndAdd(1);
+                return;
+            }
+            _wakeFlusher();
+            shard.drained.wait(lk, fits);
+        }
+        shard.records.push_back(formatted_string);
+        shard.bytes += formatted_string.size();
+        if (shard.bytes * 2 >= _shardCapacityBytes) {
+            _wakeFlusher();
+        }
+    }
+
+    /**
+     * Writes every buffered record to the wrapped backend and flushes it.
+     */
+    void flush() {
+        if (async_backend_detail::writingOnThisThread()) {
+            // This thread failed while writing, and already holds the write lock.
+            _flushBackend();
+            return;
+        }
+        stdx::lock_guard<stdx::mutex> writeLk(_writeMutex);
+        _drain(writeLk);
+        _flushBackend();
+    }
+
+private:
+    static constexpr size_t kNumShards = 16;
+    static constexpr auto kFlushInterval = std::chrono::milliseconds(100);
+    static constexpr auto kDropReportInterval = std::chrono::seconds(1);
+
+    struct Shard {
+        stdx::mutex mutex;  // NOLINT
+        stdx::condition_variable drained;
+        std::vector<std::string> records;
+        size_t bytes = 0;
+    };
+
+    static size_t _shardIndex() {
+        thread_local const size_t index =
+            std::hash<stdx::thread::id>()(stdx::this_thread::get_id()) % kNumShards;
+        return index;
+    }
+
+    void _wakeFlusher() {
+        if (_flushRequested.swap(true)) {
+            return;
+        }
+        // Taking the mutex orders this wakeup after the flusher's check of _flushRequested.
+        { stdx::lock_guard<stdx::mutex> lk(_flusherMutex); }
+        _flusherCV.notify_one();
+    }
+
+    void _write(const string_type& formatted_string) {
+        _backend->consume(boost::log::record_view(), formatted_string);
+    }
+
+    void _flushBackend() {
+        if constexpr (boost::log::sinks::has_requirement<typename Backend::frontend_requirements,
+                                                         boost::log::sinks::flushing>::value) {
+            _backend->flush();
+        }
+    }
+
+    void _drain(const stdx::lock_guard<stdx::mutex>& writeLk) {
+        auto& writing = async_backend_detail::writingOnThisThread();
+        writing = true;
+        for (auto& shard : _shards) {
+            std::vector<std::string> records;
+            {
+                stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+                records.swap(shard.records);
+                shard.bytes = 0;
+            }
+            shard.drained.notify_all();
+            for (auto&& record : records) {
+                _write(record);
+            }
+        }
+        writing = false;
+    }
+
+    void _run() {
+        auto lastDropReport = std::chrono::steady_clock::now() - kDropReportInterval;
+        stdx::unique_lock<stdx::mutex> lk(_flusherMutex);
+        while (!_shutdown) {
+            _flusherCV.wait_for(
+                lk, kFlushInterval, [&] { return _shutdown || _flushRequested.load(); });
+            _flushRequested.store(false);
+            lk.unlock();
+
+            flush();
+
+            auto now = std::chrono::steady_clock::now();
+            if (_reportDrops && now - lastDropReport >= kDropReportInterval) {
+                if (auto dropped = _unreportedDrops.swap(0)) {
+                    _reportDrops(dropped);
+                    lastDropReport = now;
+                }
+            }
+
+            lk.lock();
+        }
+    }
+
+    boost::shared_ptr<Backend> _backend;
+    const size_t _shardCapacityBytes;
+    const OverflowPolicy _policy;
+    const DropReporter _reportDrops;
+
+    // Serializes writes to '_backend'.
+    stdx::mutex _writeMutex;  // NOLINT
+    std::array<Shard, kNumShards> _shards;
+
+    AtomicWord<uint64_t> _unreportedDrops{0};
+    AtomicWord<uint64_t> _totalDropped{0};
+
+    stdx::mutex _flusherMutex;  // NOLINT
+    stdx::condition_variable _flusherCV;
+    AtomicWord<bool> _flushRequested{false};
+    bool _shutdown = false;
+    stdx::thread _flusher;
+};
+
+}  // namespace logv2
+}  // namespace mongo
@@ -225,7 +225,7 @@ inline const BSONArray mapValue(BSONArray const& value) {
 }
 inline CustomAttributeValue mapValue(BSONElement const& val) {
     CustomAttributeValue custom;
-    custom.BSONSerialize = [&val](BSONObjBuilder& builder) { builder.appendElements(val.wrap()); };
+    custom.BSONSerialize = [&val](BSONObjBuilder& builder) { builder.append(val); };
     custom.toString = [&val]() { return val.toString(); };
     return custom;
 }
@@ -33,6 +33,7 @@
 #include <boost/log/attributes/value_extraction.hpp>
 #include <boost/log/expressions/message.hpp>
 #include <boost/log/utility/formatting_ostream.hpp>
+#include <boost/optional.hpp>
 
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
@@ -59,11 +60,12 @@ struct JSONValueExtractor {
         // Try to format as BSON first if available. Prefer BSONAppend if available as we might only
         // want the value and not the whole element.
         if (val.BSONAppend) {
-            BSONObjBuilder builder;
+            _scratch.reset();
+            BSONObjBuilder builder(_scratch);
             val.BSONAppend(builder, name);
             // This is a JSON subobject, no quotes needed
             storeUnquoted(name);
-            BSONElement element = builder.done().getField(name);
+            BSONElement element = builder.done().firstElement();
             BSONObj truncated = element.jsonStringBuffer(JsonStringFormat::ExtendedRelaxedV2_0_0,
                                                          false,
                                                          false,
@@ -74,12 +76,13 @@ struct JSONValueExtractor {
         } else if (val.BSONSerialize) {
             // This is a JSON subobject, no quotes needed
             storeUnquoted(name);
-            BSONObjBuilder builder;
+            _scratch.reset();
+            BSONObjBuilder builder(_scratch);
             val.BSONSerialize(builder);
             BSONObj obj = builder.done();
             BSONObj truncated = obj.jsonStringBuffer(
                 JsonStringFormat::ExtendedRelaxedV2_0_0, 0, false, _buffer, _attributeMaxSize);
-            addTruncationReport(name, truncated, builder.done().objsize());
+            addTruncationReport(name, truncated, obj.objsize());
 
         } else if (val.toBSONArray) {
             // This is a JSON subarray, no quotes needed
@@ -134,11 +137,11 @@ struct JSONValueExtractor {
     }
 
     BSONObj truncated() {
-        return _truncated.done();
+        return _truncated ? _truncated->done() : BSONObj();
     }
 
     BSONObj truncatedSizes() {
-        return _truncatedSizes.done();
+        return _truncatedSizes ? _truncatedSizes->done() : BSONObj();
     }
 
 private:
@@ -162,7 +165,7 @@ private:
             auto truncatedEnd =
                 str::UTF8SafeTruncation(_buffer.begin() + before, _buffer.end(), _attributeMaxSize);
             if (truncatedEnd != _buffer.end()) {
-                BSONObjBuilder truncationInfo = _truncated.subobjStart(name);
+                BSONObjBuilder truncationInfo = truncatedBuilder().subobjStart(name);
                 truncationInfo.append("type"_sd, typeName(BSONType::String));
                 truncationInfo.append("size"_sd, static_cast<int64_t>(_buffer.size() - before));
                 truncationInfo.done();
@@ -177,14 +180,28 @@ private:
 
     void addTruncationReport(StringData name, const BSONObj& truncated, int64_t objsize) {
         if (!truncated.isEmpty()) {
-            _truncated.append(name, truncated);
-            _truncatedSizes.append(name, objsize);
+            truncatedBuilder().append(name, truncated);
+            if (!_truncatedSizes)
+                _truncatedSizes.emplace();
+            _truncatedSizes->append(name, objsize);
         }
     }
 
+    BSONObjBuilder& truncatedBuilder() {
+        if (!_truncated)
+            _truncated.emplace();
+        return *_truncated;
+    }
+
     fmt::memory_buffer& _buffer;
-    BSONObjBuilder _truncated;
-    BSONObjBuilder _truncatedSizes;
+
+    // Custom attributes are serialized into this buffer before being written as JSON, so a record
+    // with several of them allocates once. Nothing is allocated for records without any.
+    BufBuilder _scratch{0};
+
+    // Only created when an attribute is truncated.
+    boost::optional<BSONObjBuilder> _truncated;
+    boost::optional<BSONObjBuilder> _truncatedSizes;
     StringData _separator = ""_sd;
     size_t _attributeMaxSize;
 };
@@ -27,14 +27,18 @@
  *    it in the license file.
  */
 
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kControl
+
 #include "log_domain_global.h"
 
 #include "mongo/config.h"
+#include "mongo/logv2/async_backend.h"
 #include "mongo/logv2/component_settings_filter.h"
 #include "mongo/logv2/composite_backend.h"
 #include "mongo/logv2/console.h"
 #include "mongo/logv2/file_rotate_sink.h"
 #include "mongo/logv2/json_formatter.h"
+#include "mongo/logv2/log.h"
 #include "mongo/logv2/log_source.h"
 #include "mongo/logv2/ramlog_sink.h"
 #include "mongo/logv2/shared_access_fstream.h"
@@ -61,10 +65,13 @@ struct LogDomainGlobal::Impl {
         SyslogBackend;
 #endif
     typedef CompositeBackend<FileRotateSink, RamLogSink, RamLogSink> RotatableFileBackend;
+    typedef AsyncBackend<FileRotateSink> AsyncFileBackend;
+    typedef CompositeBackend<AsyncFileBackend, RamLogSink, RamLogSink> AsyncRotatableFileBackend;
 
     Impl(LogDomainGlobal& parent);
     Status configure(LogDomainGlobal::ConfigurationOptions const& options);
     Status rotate(bool rename, StringData renameSuffix);
+    void flush();
 
     const ConfigurationOptions& config() const;
 
@@ -73,6 +80,8 @@ struct LogDomainGlobal::Impl {
     ConfigurationOptions _config;
     boost::shared_ptr<boost::log::sinks::unlocked_sink<ConsoleBackend>> _consoleSink;
     boost::shared_ptr<boost::log::sinks::unlocked_sink<RotatableFileBackend>> _rotatableFileSink;
+    boost::shared_ptr<boost::log::sinks::unlocked_sink<AsyncRotatableFileBackend>>
+        _asyncRotatableFileSink;
 #ifndef _WIN32
     boost::shared_ptr<boost::log::sinks::unlocked_sink<SyslogBackend>> _syslogSink;
 #endif
@@ -145,32 +154,73 @@ Status LogDomainGlobal::Impl::configure(LogDomainGlobal::ConfigurationOptions co
         boost::log::core::get()->remove_sink(_consoleSink);
     }
 
+    auto removeFileSinks = [this] {
+        if (_rotatableFileSink) {
+            boost::log::core::get()->remove_sink(_rotatableFileSink);
+            _rotatableFileSink.reset();
+        }
+        if (_asyncRotatableFileSink) {
+            boost::log::core::get()->remove_sink(_asyncRotatableFileSink);
+            _asyncRotatableFileSink.reset();
+        }
+    };
+
     if (options.fileEnabled) {
-        auto backend = boost::make_shared<RotatableFileBackend>(
-            boost::make_shared<FileRotateSink>(),
-            boost::make_shared<RamLogSink>(RamLog::get("global")),
-            boost::make_shared<RamLogSink>(RamLog::get("startupWarnings")));
-        Status ret = backend->lockedBackend<0>()->addFile(
+        auto fileSink = boost::make_shared<FileRotateSink>();
+        Status ret = fileSink->addFile(
             options.filePath,
             options.fileOpenMode == ConfigurationOptions::OpenMode::kAppend ? true : false);
         if (!ret.isOK())
             return ret;
-        backend->lockedBackend<0>()->auto_flush(true);
-
-        _rotatableFileSink =
-            boost::make_shared<boost::log::sinks::unlocked_sink<RotatableFileBackend>>(backend);
-        _rotatableFileSink->set_filter(ComponentSettingsFilter(_parent, _settings));
-
-        boost::log::core::get()->add_sink(_rotatableFileSink);
-    } else if (_rotatableFileSink) {
-        boost::log::core::get()->remove_sink(_rotatableFileSink);
-        _rotatableFileSink.reset();
+        removeFileSinks();
+
+        if (options.fileAsyncBufferSizeBytes > 0) {
+            // The background thread flushes the file once per batch of records.
+            auto asyncSink = boost::make_shared<AsyncFileBackend>(
+                std::move(fileSink),
+                options.fileAsyncBufferSizeBytes,
+                options.fileAsyncBlockOnOverflow ? AsyncFileBackend::OverflowPolicy::kBlock
+                                                 : AsyncFileBackend::OverflowPolicy::kDrop,
+                [](uint64_t dropped) {
+                    LOGV2_WARNING(5212040,
+                                  "Dropped log records because the log buffer was full",
+                                  "dropped"_attr = dropped);
+                });
+            auto backend = boost::make_shared<AsyncRotatableFileBackend>(
+                std::move(asyncSink),
+                boost::make_shared<RamLogSink>(RamLog::get("global")),
+                boost::make_shared<RamLogSink>(RamLog::get("startupWarnings")));
+
+            _asyncRotatableFileSink =
+                boost::make_shared<boost::log::sinks::unlocked_sink<AsyncRotatableFileBackend>>(
+                    backend);
+            _asyncRotatableFileSink->set_filter(ComponentSettingsFilter(_parent, _settings));
+
+            boost::log::core::get()->add_sink(_asyncRotatableFileSink);
+        } else {
+            fileSink->auto_flush(true);
+            auto backend = boost::make_shared<RotatableFileBackend>(
+                std::move(fileSink),
+                boost::make_shared<RamLogSink>(RamLog::get("global")),
+                boost::make_shared<RamLogSink>(RamLog::get("startupWarnings")));
+
+            _rotatableFileSink =
+                boost::make_shared<boost::log::sinks::unlocked_sink<RotatableFileBackend>>(
+                    backend);
+            _rotatableFileSink->set_filter(ComponentSettingsFilter(_parent, _settings));
+
+            boost::log::core::get()->add_sink(_rotatableFileSink);
+        }
+    } else {
+        removeFileSinks();
     }
 
     auto setFormatters = [this](auto&& mkFmt) {
         _consoleSink->set_formatter(mkFmt());
         if (_rotatableFileSink)
             _rotatableFileSink->set_formatter(mkFmt());
+        if (_asyncRotatableFileSink)
+            _asyncRotatableFileSink->set_formatter(mkFmt());
 #ifndef _WIN32
         if (_syslogSink)
             _syslogSink->set_formatter(mkFmt());
@@ -211,9 +261,21 @@ Status LogDomainGlobal::Impl::rotate(bool rename, StringData renameSuffix) {
         auto backend = _rotatableFileSink->locked_backend()->lockedBackend<0>();
         return backend->rotate(rename, renameSuffix);
     }
+    if (_asyncRotatableFileSink) {
+        auto backend = _asyncRotatableFileSink->locked_backend()->lockedBackend<0>();
+        // Records logged before the rotation belong in the old file.
+        backend->flush();
+        return backend->lockedBackend()->rotate(rename, renameSuffix);
+    }
     return Status::OK();
 }
 
+void LogDomainGlobal::Impl::flush() {
+    if (_asyncRotatableFileSink) {
+        _asyncRotatableFileSink->flush();
+    }
+}
+
 LogDomainGlobal::LogDomainGlobal() {
     _impl = std::make_unique<Impl>(*this);
 }
@@ -239,6 +301,10 @@ Status LogDomainGlobal::rotate(bool rename, StringData renameSuffix) {
     return _impl->rotate(rename, renameSuffix);
 }
 
+void LogDomainGlobal::flush() {
+    _impl->flush();
+}
+
 LogComponentSettings& LogDomainGlobal::settings() {
     return _impl->_settings;
 }
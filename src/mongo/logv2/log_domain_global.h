@@ -51,6 +51,11 @@ public:
         int syslogFacility{-1};  // invalid facility by default, must be set
         LogFormat format{LogFormat::kDefault};
         const AtomicWord<int32_t>* maxAttributeSizeKB = nullptr;
+        // When non-zero, records for the log file are buffered up to this many bytes and written
+        // by a background thread, dropping records that do not fit unless
+        // 'fileAsyncBlockOnOverflow' is set.
+        size_t fileAsyncBufferSizeBytes{0};
+        bool fileAsyncBlockOnOverflow{false};
 
         void makeDisabled();
     };
@@ -63,6 +68,11 @@ public:
     Status configure(ConfigurationOptions const& options);
     Status rotate(bool rename, StringData renameSuffix);
 
+    /**
+     * Writes out any records buffered for the log file.
+     */
+    void flush();
+
     const ConfigurationOptions& config() const;
 
     LogComponentSettings& settings();
@@ -42,6 +42,7 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/json.h"
 #include "mongo/bson/oid.h"
+#include "mongo/logv2/async_backend.h"
 #include "mongo/logv2/bson_formatter.h"
 #include "mongo/logv2/component_settings_filter.h"
 #include "mongo/logv2/constants.h"
@@ -1284,6 +1285,66 @@ TEST_F(LogTestV2, Threads) {
     ASSERT(linesJson.size() == threads.size() * kNumPerThread);
 }
 
+TEST_F(LogTestV2, AsyncBackend) {
+    using Backend = AsyncBackend<LogCaptureBackend>;
+    std::vector<std::string> lines;
+    auto backend = boost::make_shared<Backend>(
+        boost::make_shared<LogCaptureBackend>(lines), 1024 * 1024, Backend::OverflowPolicy::kBlock);
+    auto sink = boost::make_shared<boost::log::sinks::unlocked_sink<Backend>>(backend);
+    sink->set_filter(ComponentSettingsFilter(LogManager::global().getGlobalDomain(),
+                                             LogManager::global().getGlobalSettings()));
+    sink->set_formatter(PlainFormatter());
+    attach(sink);
+
+    constexpr int kNumThreads = 4;
+    constexpr int kNumPerThread = 1000;
+    std::vector<stdx::thread> threads;
+    for (int t = 0; t < kNumThreads; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < kNumPerThread; ++i)
+                LOGV2(5212041, "async");
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    backend->flush();
+    ASSERT_EQ(lines.size(), kNumThreads * kNumPerThread);
+    ASSERT_EQ(backend->droppedRecords(), 0);
+
+    // An error is written before LOGV2_ERROR returns, after the records buffered ahead of it.
+    LOGV2(5212042, "before error");
+    LOGV2_ERROR(5212043, "error");
+    ASSERT_EQ(lines.size(), kNumThreads * kNumPerThread + 2);
+    ASSERT_EQ(lines[lines.size() - 2], "before error");
+    ASSERT_EQ(lines.back(), "error");
+}
+
+TEST_F(LogTestV2, AsyncBackendDropsWhenFull) {
+    using Backend = AsyncBackend<LogCaptureBackend>;
+    std::vector<std::string> lines;
+    auto backend = boost::make_shared<Backend>(
+        boost::make_shared<LogCaptureBackend>(lines), 1, Backend::OverflowPolicy::kDrop);
+    auto sink = boost::make_shared<boost::log::sinks::unlocked_sink<Backend>>(backend);
+    sink->set_filter(ComponentSettingsFilter(LogManager::global().getGlobalDomain(),
+                                             LogManager::global().getGlobalSettings()));
+    sink->set_formatter(PlainFormatter());
+    attach(sink);
+
+    {
+        // Keep the background thread from emptying the buffer, which holds a single record.
+        auto locked = backend->lockedBackend();
+        for (int i = 0; i < 10; ++i)
+            LOGV2(5212044, "record {i}", "i"_attr = i);
+    }
+
+    backend->flush();
+    ASSERT_EQ(lines.size(), 1);
+    ASSERT_EQ(lines.back(), "record 0");
+    ASSERT_EQ(backend->droppedRecords(), 9);
+}
+
 TEST_F(LogTestV2, Ramlog) {
     RamLog* ramlog = RamLog::get("test_ramlog");
 
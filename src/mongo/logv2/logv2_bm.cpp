@@ -33,7 +33,10 @@
 #include "mongo/logger/console_appender.h"
 #include "mongo/logger/logger.h"
 #include "mongo/logger/message_event_utf8_encoder.h"
+#include "mongo/logv2/async_backend.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/logv2/component_settings_filter.h"
+#include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log.h"
 #include "mongo/logv2/log_domain_global.h"
 #include "mongo/logv2/text_formatter.h"
@@ -45,6 +48,7 @@
 #include <boost/iostreams/stream.hpp>
 #include <boost/log/sinks/sync_frontend.hpp>
 #include <boost/log/sinks/text_ostream_backend.hpp>
+#include <boost/log/sinks/unlocked_frontend.hpp>
 #include <boost/make_shared.hpp>
 #include <iostream>
 
@@ -115,13 +119,14 @@ private:
     bool _shouldInit;
 };
 
-// RAII style helper class for init/deinit new log system
+// RAII style helper class for init/deinit new log system. With 'async', records are written by
+// an AsyncBackend. With 'json', records are formatted as JSON instead of text.
 class ScopedLogV2Bench {
 public:
-    ScopedLogV2Bench(benchmark::State& state) {
+    ScopedLogV2Bench(benchmark::State& state, bool async = false, bool json = false) {
         _shouldInit = state.thread_index == 0;
         if (_shouldInit) {
-            setupAppender();
+            setupAppender(async, json);
         }
     }
 
@@ -132,21 +137,36 @@ public:
     }
 
 private:
-    void setupAppender() {
+    void setupAppender(bool async, bool json) {
         logv2::LogDomainGlobal::ConfigurationOptions config;
         config.makeDisabled();
         invariant(logv2::LogManager::global().getGlobalDomainInternal().configure(config).isOK());
 
         auto backend = boost::make_shared<boost::log::sinks::text_ostream_backend>();
         backend->add_stream(makeNullStream());
-        backend->auto_flush(true);
-
-        _sink = boost::make_shared<
-            boost::log::sinks::synchronous_sink<boost::log::sinks::text_ostream_backend>>(backend);
-        _sink->set_filter(
-            logv2::ComponentSettingsFilter(logv2::LogManager::global().getGlobalDomain(),
-                                           logv2::LogManager::global().getGlobalSettings()));
-        _sink->set_formatter(logv2::TextFormatter());
+
+        auto setupSink = [this, json](auto sink) {
+            sink->set_filter(
+                logv2::ComponentSettingsFilter(logv2::LogManager::global().getGlobalDomain(),
+                                               logv2::LogManager::global().getGlobalSettings()));
+            if (json) {
+                sink->set_formatter(logv2::JSONFormatter());
+            } else {
+                sink->set_formatter(logv2::TextFormatter());
+            }
+            _sink = std::move(sink);
+        };
+        if (async) {
+            using AsyncTextBackend = logv2::AsyncBackend<boost::log::sinks::text_ostream_backend>;
+            setupSink(boost::make_shared<boost::log::sinks::unlocked_sink<AsyncTextBackend>>(
+                boost::make_shared<AsyncTextBackend>(
+                    backend, 1024 * 1024, AsyncTextBackend::OverflowPolicy::kBlock)));
+        } else {
+            backend->auto_flush(true);
+            setupSink(boost::make_shared<
+                      boost::log::sinks::synchronous_sink<boost::log::sinks::text_ostream_backend>>(
+                backend));
+        }
         boost::log::core::get()->add_sink(_sink);
     }
 
@@ -155,8 +175,7 @@ private:
         invariant(logv2::LogManager::global().getGlobalDomainInternal().configure({}).isOK());
     }
 
-    boost::shared_ptr<boost::log::sinks::synchronous_sink<boost::log::sinks::text_ostream_backend>>
-        _sink;
+    boost::shared_ptr<boost::log::sinks::sink> _sink;
     bool _shouldInit;
 };
 
@@ -209,6 +228,13 @@ void BM_EnabledLogV2(benchmark::State& state) {
         LOGV2(20071, "enabled log");
 }
 
+void BM_EnabledLogV2Async(benchmark::State& state) {
+    ScopedLogV2Bench init(state, true);
+
+    for (auto _ : state)
+        LOGV2(5212045, "enabled log");
+}
+
 void BM_EnabledLogExpensiveArg(benchmark::State& state) {
     ScopedLogBench init(state);
 
@@ -224,6 +250,13 @@ void BM_EnabledLogV2ExpensiveArg(benchmark::State& state) {
         LOGV2(20072, "enabled log {}", "str"_attr = createLongString());
 }
 
+void BM_EnabledLogV2AsyncExpensiveArg(benchmark::State& state) {
+    ScopedLogV2Bench init(state, true);
+
+    for (auto _ : state)
+        LOGV2(5212046, "enabled log {}", "str"_attr = createLongString());
+}
+
 void BM_EnabledLogManySmallArg(benchmark::State& state) {
     ScopedLogBench init(state);
 
@@ -253,6 +286,27 @@ void BM_EnabledLogV2ManySmallArg(benchmark::State& state) {
     }
 }
 
+void BM_EnabledLogV2JsonBSONArgs(benchmark::State& state) {
+    ScopedLogV2Bench init(state, false, true);
+
+    // Shaped like the sub-objects of a slow query line.
+    BSONObj command = BSON("find"
+                           << "coll"
+                           << "filter" << BSON("a" << 1 << "b" << BSON("$gt" << 2)) << "$db"
+                           << "test");
+    BSONObj locks = BSON("Global" << BSON("acquireCount" << BSON("r" << 1LL)) << "Database"
+                                  << BSON("acquireCount" << BSON("r" << 1LL)));
+    for (auto _ : state) {
+        LOGV2(5212047,
+              "enabled log",
+              "command"_attr = command,
+              "filter"_attr = command["filter"],
+              "locks"_attr = locks,
+              "nreturned"_attr = 1,
+              "durationMillis"_attr = 150);
+    }
+}
+
 void ThreadCounts(benchmark::internal::Benchmark* b) {
     int tc[] = {1, 2, 4, 8};
     for (int t : tc)
@@ -267,12 +321,16 @@ BENCHMARK(BM_NoopLogV2Arg)->Apply(ThreadCounts);
 
 BENCHMARK(BM_EnabledLog)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2)->Apply(ThreadCounts);
+BENCHMARK(BM_EnabledLogV2Async)->Apply(ThreadCounts);
 
 BENCHMARK(BM_EnabledLogExpensiveArg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2ExpensiveArg)->Apply(ThreadCounts);
+BENCHMARK(BM_EnabledLogV2AsyncExpensiveArg)->Apply(ThreadCounts);
 
 BENCHMARK(BM_EnabledLogManySmallArg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2ManySmallArg)->Apply(ThreadCounts);
 
+BENCHMARK(BM_EnabledLogV2JsonBSONArgs)->Apply(ThreadCounts);
+
 }  // namespace
 }  // namespace mongo
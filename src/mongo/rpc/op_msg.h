@@ -199,7 +199,9 @@ class OpMsgBuilder {
     OpMsgBuilder& operator=(const OpMsgBuilder&) = delete;
 
 public:
-    OpMsgBuilder() {
+    OpMsgBuilder() : _buf(0) {
+        // Messages are usually released soon after being sent, so recycle their buffers.
+        _buf.useSharedBuffer(SharedBuffer::allocatePooled(kInitialBufferSize));
         skipHeaderAndFlags();
     }
 
@@ -290,6 +292,8 @@ private:
 
     void finishDocumentStream(DocSequenceBuilder* docSequenceBuilder);
 
+    static constexpr size_t kInitialBufferSize = 1024;
+
     void skipHeaderAndFlags() {
         _buf.skip(sizeof(MSGHEADER::Layout));  // This is filled in by finish().
         _buf.appendNum(uint32_t(0));           // flags (currently always 0).
@@ -362,6 +366,15 @@ public:
         return _buf->len();
     }
 
+    /**
+     * Grows the underlying buffer so that at least 'bytes' more bytes can be appended to this
+     * sequence without reallocating.
+     */
+    void reserve(int bytes) {
+        _buf->reserveBytes(bytes);
+        _buf->claimReservedBytes(bytes);
+    }
+
 private:
     friend OpMsgBuilder;
 
@@ -33,12 +33,15 @@
 
 #include "mongo/s/async_requests_sender.h"
 
+#include <array>
 #include <fmt/format.h>
+#include <map>
 #include <memory>
 
 #include "mongo/client/remote_command_targeter.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
@@ -57,6 +60,59 @@ namespace {
 // Maximum number of retries for network and replication notMaster errors (per host).
 const int kMaxNumFailedHostRetryAttempts = 3;
 
+class AsyncRequestsSenderStats {
+public:
+    void recordFanout(size_t numRemotes) {
+        if (numRemotes == 0)
+            return;
+        size_t bucket = 0;
+        while (bucket + 1 < kNumFanoutBuckets && numRemotes > (size_t{1} << bucket))
+            ++bucket;
+        _fanout[bucket].addAndFetch(1);
+    }
+
+    void recordResponse(const ShardId& shardId, Microseconds elapsed) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto& stats = _shards[shardId];
+        ++stats.numResponses;
+        stats.totalResponseTimeMicros += durationCount<Microseconds>(elapsed);
+    }
+
+    void report(BSONObjBuilder* builder) {
+        BSONObjBuilder fanoutBuilder(builder->subobjStart("fanout"));
+        for (size_t i = 0; i < kNumFanoutBuckets; ++i) {
+            fanoutBuilder.append(kFanoutBucketNames[i], _fanout[i].load());
+        }
+        fanoutBuilder.doneFast();
+
+        BSONObjBuilder shardsBuilder(builder->subobjStart("shards"));
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (const auto& [shardId, stats] : _shards) {
+            BSONObjBuilder shardBuilder(shardsBuilder.subobjStart(shardId.toString()));
+            shardBuilder.append("numResponses", stats.numResponses);
+            shardBuilder.append("totalResponseTimeMicros", stats.totalResponseTimeMicros);
+        }
+    }
+
+private:
+    // Bucket i counts the senders that targeted up to 2^i shards, and more than the bucket before.
+    static constexpr size_t kNumFanoutBuckets = 7;
+    static constexpr StringData kFanoutBucketNames[kNumFanoutBuckets] = {
+        "1"_sd, "2"_sd, "3-4"_sd, "5-8"_sd, "9-16"_sd, "17-32"_sd, "33+"_sd};
+
+    struct ShardStats {
+        long long numResponses = 0;
+        long long totalResponseTimeMicros = 0;
+    };
+
+    std::array<AtomicWord<long long>, kNumFanoutBuckets> _fanout;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("AsyncRequestsSenderStats::_mutex");
+    std::map<ShardId, ShardStats> _shards;
+};
+
+AsyncRequestsSenderStats asyncRequestsSenderStats;
+
 }  // namespace
 
 AsyncRequestsSender::AsyncRequestsSender(OperationContext* opCtx,
@@ -73,6 +129,7 @@ AsyncRequestsSender::AsyncRequestsSender(OperationContext* opCtx,
       _subBaton(opCtx->getBaton()->makeSubBaton()) {
 
     _remotesLeft = requests.size();
+    asyncRequestsSenderStats.recordFanout(requests.size());
 
     // Initialize command metadata to handle the read preference.
     _metadataObj = readPreference.toContainingBSON();
@@ -125,6 +182,10 @@ void AsyncRequestsSender::stopRetrying() noexcept {
     _stopRetrying = true;
 }
 
+void AsyncRequestsSender::reportStats(BSONObjBuilder* builder) {
+    asyncRequestsSenderStats.report(builder);
+}
+
 bool AsyncRequestsSender::done() noexcept {
     return !_remotesLeft;
 }
@@ -147,6 +208,7 @@ void AsyncRequestsSender::RemoteData::executeRequest() {
         .thenRunOn(*_ars->_subBaton)
         .getAsync([this](StatusWith<RemoteCommandOnAnyCallbackArgs> rcr) {
             _done = true;
+            asyncRequestsSenderStats.recordResponse(_shardId, _timer.elapsed());
             if (rcr.isOK()) {
                 _ars->_responseQueue.push(
                     {std::move(_shardId), rcr.getValue().response, std::move(_shardHostAndPort)});
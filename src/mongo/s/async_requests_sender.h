@@ -45,6 +45,7 @@
 #include "mongo/util/net/hostandport.h"
 #include "mongo/util/producer_consumer_queue.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -162,6 +163,13 @@ public:
      */
     void stopRetrying() noexcept;
 
+    /**
+     * Appends cumulative statistics over every AsyncRequestsSender in this process: how many
+     * shards each one targeted, and per shard, how many responses came back and how long they
+     * took, retries included.
+     */
+    static void reportStats(BSONObjBuilder* builder);
+
 private:
     /**
      * We instantiate one of these per remote host.
@@ -250,6 +258,9 @@ private:
 
         // The number of times we've retried sending the command to this remote.
         int _retryCount = 0;
+
+        // Started when the remote is created, which is when its request is first sent.
+        Timer _timer;
     };
 
     OperationContext* _opCtx;
@@ -78,6 +78,7 @@ const char kMode[] = "mode";
 const char kActiveWindow[] = "activeWindow";
 const char kWaitForDelete[] = "_waitForDelete";
 const char kAttemptToBalanceJumboChunks[] = "attemptToBalanceJumboChunks";
+const char kLoadImbalanceRatio[] = "loadImbalanceRatio";
 
 }  // namespace
 
@@ -182,6 +183,11 @@ bool BalancerConfiguration::attemptToBalanceJumboChunks() const {
     return _balancerSettings.attemptToBalanceJumboChunks();
 }
 
+double BalancerConfiguration::getLoadImbalanceRatio() const {
+    stdx::lock_guard<Latch> lk(_balancerSettingsMutex);
+    return _balancerSettings.getLoadImbalanceRatio();
+}
+
 Status BalancerConfiguration::refreshAndCheck(OperationContext* opCtx) {
     // Balancer configuration
     Status balancerSettingsStatus = _refreshBalancerSettings(opCtx);
@@ -388,6 +394,23 @@ StatusWith<BalancerSettingsType> BalancerSettingsType::fromBSON(const BSONObj& o
         settings._attemptToBalanceJumboChunks = attemptToBalanceJumboChunks;
     }
 
+    {
+        double loadImbalanceRatio;
+        Status status =
+            bsonExtractDoubleFieldWithDefault(obj, kLoadImbalanceRatio, 0, &loadImbalanceRatio);
+        if (!status.isOK())
+            return status;
+
+        if (loadImbalanceRatio != 0 && !(loadImbalanceRatio > 1)) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << kLoadImbalanceRatio
+                                  << " must be either 0 or greater than 1, but found "
+                                  << loadImbalanceRatio};
+        }
+
+        settings._loadImbalanceRatio = loadImbalanceRatio;
+    }
+
     return settings;
 }
 
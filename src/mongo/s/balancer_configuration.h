@@ -116,6 +116,15 @@ public:
         return _attemptToBalanceJumboChunks;
     }
 
+    /**
+     * Returns by how many times the operation rate of the busiest shard must exceed that of the
+     * least busy one for the balancer to move chunks between them even though their chunk counts
+     * are balanced. Zero means that the balancer only balances chunk counts.
+     */
+    double getLoadImbalanceRatio() const {
+        return _loadImbalanceRatio;
+    }
+
 private:
     BalancerSettingsType();
 
@@ -129,6 +138,8 @@ private:
     bool _waitForDelete{false};
 
     bool _attemptToBalanceJumboChunks{false};
+
+    double _loadImbalanceRatio{0};
 };
 
 /**
@@ -253,6 +264,12 @@ public:
      */
     bool attemptToBalanceJumboChunks() const;
 
+    /**
+     * Returns the load imbalance ratio at which the balancer moves chunks off busy shards, or zero
+     * if it only balances chunk counts.
+     */
+    double getLoadImbalanceRatio() const;
+
     /**
      * Returns the max chunk size after which a chunk would be considered jumbo.
      */
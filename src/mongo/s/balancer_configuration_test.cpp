@@ -328,6 +328,21 @@ TEST(BalancerSettingsType, InvalidBalancingWindowFormat) {
                       .getStatus());
 }
 
+TEST(BalancerSettingsType, LoadImbalanceRatio) {
+    ASSERT_EQ(0, assertGet(BalancerSettingsType::fromBSON(BSONObj())).getLoadImbalanceRatio());
+    ASSERT_EQ(1.5,
+              assertGet(BalancerSettingsType::fromBSON(BSON("loadImbalanceRatio" << 1.5)))
+                  .getLoadImbalanceRatio());
+    ASSERT_EQ(2,
+              assertGet(BalancerSettingsType::fromBSON(BSON("loadImbalanceRatio" << 2)))
+                  .getLoadImbalanceRatio());
+
+    ASSERT_NOT_OK(BalancerSettingsType::fromBSON(BSON("loadImbalanceRatio" << 1)).getStatus());
+    ASSERT_NOT_OK(BalancerSettingsType::fromBSON(BSON("loadImbalanceRatio" << -2)).getStatus());
+    ASSERT_NOT_OK(
+        BalancerSettingsType::fromBSON(BSON("loadImbalanceRatio" << "high")).getStatus());
+}
+
 TEST(ChunkSizeSettingsType, NormalValues) {
     ASSERT_EQ(
         1024 * 1024ULL,
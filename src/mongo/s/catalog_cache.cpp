@@ -651,8 +651,10 @@ void CatalogCache::_scheduleCollectionRefresh(WithLock lk,
                                         RoutingTableHistory* routingInfoAfterRefresh) {
         if (isIncremental) {
             _stats.numActiveIncrementalRefreshes.subtractAndFetch(1);
+            _stats.totalIncrementalRefreshTimeMicros.addAndFetch(t.micros());
         } else {
             _stats.numActiveFullRefreshes.subtractAndFetch(1);
+            _stats.totalFullRefreshTimeMicros.addAndFetch(t.micros());
         }
 
         if (!status.isOK()) {
@@ -801,9 +803,11 @@ void CatalogCache::Stats::report(BSONObjBuilder* builder) const {
 
     builder->append("numActiveIncrementalRefreshes", numActiveIncrementalRefreshes.load());
     builder->append("countIncrementalRefreshesStarted", countIncrementalRefreshesStarted.load());
+    builder->append("totalIncrementalRefreshTimeMicros", totalIncrementalRefreshTimeMicros.load());
 
     builder->append("numActiveFullRefreshes", numActiveFullRefreshes.load());
     builder->append("countFullRefreshesStarted", countFullRefreshesStarted.load());
+    builder->append("totalFullRefreshTimeMicros", totalFullRefreshTimeMicros.load());
 
     builder->append("countFailedRefreshes", countFailedRefreshes.load());
 }
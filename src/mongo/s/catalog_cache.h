@@ -459,6 +459,11 @@ private:
         // Cumulative, always-increasing counter of how many full refreshes have been kicked off
         AtomicWord<long long> countFullRefreshesStarted{0};
 
+        // Cumulative, always-increasing counters of how long incremental and full refreshes took
+        // to complete, whether they succeeded or failed
+        AtomicWord<long long> totalIncrementalRefreshTimeMicros{0};
+        AtomicWord<long long> totalFullRefreshTimeMicros{0};
+
         // Cumulative, always-increasing counter of how many full or incremental refreshes failed
         // for whatever reason
         AtomicWord<long long> countFailedRefreshes{0};
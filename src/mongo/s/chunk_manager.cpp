@@ -69,8 +69,204 @@ std::string extractKeyStringInternal(const BSONObj& shardKeyValue, Ordering orde
     return {ks.getBuffer(), ks.getSize()};
 }
 
+void checkChunksAreContiguous(const ChunkInfo& left, const ChunkInfo& right) {
+    const auto& lastMax = left.getMax();
+    const auto& rangeMin = right.getMin();
+
+    if (SimpleBSONObjComparator::kInstance.evaluate(lastMax == rangeMin))
+        return;
+
+    uasserted(ErrorCodes::ConflictingOperationInProgress,
+              str::stream() << (SimpleBSONObjComparator::kInstance.evaluate(lastMax < rangeMin)
+                                    ? "Gap"
+                                    : "Overlap")
+                            << " exists in the routing table between chunks "
+                            << left.getRange().toString() << " and "
+                            << right.getRange().toString());
+}
+
+/**
+ * Checks the continuity of the chunk map around the chunks with the given max key strings, which
+ * is all that can have changed since the previous, fully validated, routing table.
+ */
+void checkContinuityAroundChunks(const ChunkInfoMap& chunkMap,
+                                 const std::vector<std::string>& chunkMaxKeyStrings) {
+    for (const auto& key : chunkMaxKeyStrings) {
+        const auto it = chunkMap.find(key);
+
+        // Replaced by a later chunk of the same batch, whose neighbours get checked instead
+        if (it == chunkMap.end())
+            continue;
+
+        const auto& chunk = *it->second;
+
+        if (it == chunkMap.begin()) {
+            checkAllElementsAreOfType(MinKey, chunk.getMin());
+        } else {
+            checkChunksAreContiguous(*std::prev(it)->second, chunk);
+        }
+
+        const auto next = std::next(it);
+        if (next == chunkMap.end()) {
+            checkAllElementsAreOfType(MaxKey, chunk.getMax());
+        } else {
+            checkChunksAreContiguous(chunk, *next->second);
+        }
+    }
+}
+
 }  // namespace
 
+ChunkInfoMap::const_iterator& ChunkInfoMap::const_iterator::operator++() {
+    if (++_it == (*_buckets)[_bucket]->cend()) {
+        if (++_bucket < _buckets->size()) {
+            _it = (*_buckets)[_bucket]->cbegin();
+        } else {
+            _it = {};
+        }
+    }
+
+    return *this;
+}
+
+ChunkInfoMap::const_iterator& ChunkInfoMap::const_iterator::operator--() {
+    if (_bucket == _buckets->size() || _it == (*_buckets)[_bucket]->cbegin()) {
+        _it = (*_buckets)[--_bucket]->cend();
+    }
+
+    --_it;
+    return *this;
+}
+
+ChunkInfoMap::const_iterator ChunkInfoMap::lower_bound(const std::string& key) const {
+    // The first bucket whose last key is >= key
+    const auto bucketIt = std::lower_bound(
+        _buckets.begin(), _buckets.end(), key, [](const auto& bucket, const std::string& key) {
+            return bucket->crbegin()->first < key;
+        });
+
+    if (bucketIt == _buckets.end())
+        return end();
+
+    return const_iterator(&_buckets, bucketIt - _buckets.begin(), (*bucketIt)->lower_bound(key));
+}
+
+ChunkInfoMap::const_iterator ChunkInfoMap::upper_bound(const std::string& key) const {
+    // The first bucket whose last key is > key
+    const auto bucketIt = std::upper_bound(
+        _buckets.begin(), _buckets.end(), key, [](const std::string& key, const auto& bucket) {
+            return key < bucket->crbegin()->first;
+        });
+
+    if (bucketIt == _buckets.end())
+        return end();
+
+    return const_iterator(&_buckets, bucketIt - _buckets.begin(), (*bucketIt)->upper_bound(key));
+}
+
+ChunkInfoMap::const_iterator ChunkInfoMap::find(const std::string& key) const {
+    const auto it = lower_bound(key);
+    return (it != end() && it->first == key) ? it : end();
+}
+
+const ChunkInfoMap::mapped_type& ChunkInfoMap::at(const std::string& key) const {
+    const auto it = find(key);
+    if (it == end())
+        throw std::out_of_range("ChunkInfoMap::at");
+
+    return it->second;
+}
+
+bool ChunkInfoMap::insert(std::string key, mapped_type value) {
+    size_t i = 0;
+    if (_buckets.empty()) {
+        _buckets.push_back(std::make_shared<Bucket>());
+    } else {
+        // Keys past the end of the last bucket go into the last bucket
+        i = std::min(lower_bound(key)._bucket, _buckets.size() - 1);
+    }
+
+    if (!_mutableBucket(i).emplace(std::move(key), std::move(value)).second)
+        return false;
+
+    ++_size;
+    _splitIfNeeded(i);
+    return true;
+}
+
+void ChunkInfoMap::erase(const_iterator first, const_iterator last) {
+    if (first == last)
+        return;
+
+    invariant(first._buckets == &_buckets && last._buckets == &_buckets);
+
+    // The iterators point into buckets which may be replaced by copies below, so remember their
+    // positions by key
+    const auto firstKey = first->first;
+    const auto lastKey = (last == end()) ? std::string() : last->first;
+
+    auto eraseFromBucket = [&](size_t i, auto&& range) {
+        auto& bucket = _mutableBucket(i);
+        const auto [from, to] = range(bucket);
+        _size -= std::distance(from, to);
+        bucket.erase(from, to);
+
+        if (bucket.empty()) {
+            _buckets.erase(_buckets.begin() + i);
+        }
+    };
+
+    if (first._bucket == last._bucket) {
+        eraseFromBucket(first._bucket, [&](Bucket& bucket) {
+            return std::make_pair(bucket.find(firstKey), bucket.find(lastKey));
+        });
+        return;
+    }
+
+    // Work from the back so that erasing buckets doesn't shift the ones still to be visited
+    if (last != end()) {
+        eraseFromBucket(last._bucket, [&](Bucket& bucket) {
+            return std::make_pair(bucket.begin(), bucket.find(lastKey));
+        });
+    }
+
+    // Buckets strictly between the two are dropped without being copied
+    const auto middleBegin = _buckets.begin() + first._bucket + 1;
+    const auto middleEnd = _buckets.begin() + last._bucket;
+    for (auto it = middleBegin; it != middleEnd; ++it) {
+        _size -= (*it)->size();
+    }
+    _buckets.erase(middleBegin, middleEnd);
+
+    eraseFromBucket(first._bucket, [&](Bucket& bucket) {
+        return std::make_pair(bucket.find(firstKey), bucket.end());
+    });
+}
+
+ChunkInfoMap::Bucket& ChunkInfoMap::_mutableBucket(size_t i) {
+    auto& bucket = _buckets[i];
+
+    // Only this map can hand out new references to its buckets, so a use count of one means no
+    // other map shares it
+    if (bucket.use_count() > 1) {
+        bucket = std::make_shared<Bucket>(*bucket);
+    }
+
+    return *bucket;
+}
+
+void ChunkInfoMap::_splitIfNeeded(size_t i) {
+    auto& bucket = *_buckets[i];
+    if (bucket.size() <= kMaxBucketSize)
+        return;
+
+    const auto mid = std::next(bucket.begin(), bucket.size() / 2);
+    auto upperHalf = std::make_shared<Bucket>(mid, bucket.end());
+    bucket.erase(mid, bucket.end());
+
+    _buckets.insert(_buckets.begin() + i + 1, std::move(upperHalf));
+}
+
 ShardVersionTargetingInfo::ShardVersionTargetingInfo(const OID& epoch)
     : shardVersion(0, 0, epoch) {}
 
@@ -80,7 +276,8 @@ RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
                                          std::unique_ptr<CollatorInterface> defaultCollator,
                                          bool unique,
                                          ChunkInfoMap chunkMap,
-                                         ChunkVersion collectionVersion)
+                                         ChunkVersion collectionVersion,
+                                         boost::optional<ShardVersionMap> shardVersions)
     : _sequenceNumber(nextCMSequenceNumber.addAndFetch(1)),
       _nss(std::move(nss)),
       _uuid(uuid),
@@ -90,7 +287,7 @@ RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
       _unique(unique),
       _chunkMap(std::move(chunkMap)),
       _collectionVersion(collectionVersion),
-      _shardVersions(_constructShardVersionMap()) {}
+      _shardVersions(shardVersions ? std::move(*shardVersions) : _constructShardVersionMap()) {}
 
 void RoutingTableHistory::setShardStale(const ShardId& shardId) {
     auto it = _shardVersions.find(shardId);
@@ -126,6 +323,46 @@ Chunk ChunkManager::findIntersectingChunk(const BSONObj& shardKey, const BSONObj
     return Chunk(*(it->second), _clusterTime);
 }
 
+std::vector<StatusWith<ShardId>> ChunkManager::getShardIdsForShardKeys(
+    const std::vector<BSONObj>& shardKeys) const {
+    const auto& chunkMap = _rt->getChunkMap();
+
+    std::vector<std::pair<std::string, size_t>> sortedKeys;
+    sortedKeys.reserve(shardKeys.size());
+    for (size_t i = 0; i < shardKeys.size(); ++i) {
+        sortedKeys.emplace_back(_rt->_extractKeyString(shardKeys[i]), i);
+    }
+    std::sort(sortedKeys.begin(), sortedKeys.end());
+
+    std::vector<const ChunkInfo*> chunks(shardKeys.size(), nullptr);
+    auto it = chunkMap.end();
+    for (const auto& [keyString, i] : sortedKeys) {
+        // The current chunk's min is <= the previous key, so it also contains this key if the key
+        // is below its max
+        if (it == chunkMap.end() || !(keyString < it->first)) {
+            it = chunkMap.upper_bound(keyString);
+        }
+
+        if (it != chunkMap.end() && it->second->containsKey(shardKeys[i])) {
+            chunks[i] = it->second.get();
+        }
+    }
+
+    std::vector<StatusWith<ShardId>> shardIds;
+    shardIds.reserve(shardKeys.size());
+    for (size_t i = 0; i < shardKeys.size(); ++i) {
+        if (chunks[i]) {
+            shardIds.emplace_back(chunks[i]->getShardIdAt(_clusterTime));
+        } else {
+            shardIds.emplace_back(ErrorCodes::ShardKeyNotFound,
+                                  str::stream() << "Cannot target single shard using key "
+                                                << shardKeys[i] << " for namespace " << getns());
+        }
+    }
+
+    return shardIds;
+}
+
 bool ChunkManager::keyBelongsToShard(const BSONObj& shardKey, const ShardId& shardId) const {
     if (shardKey.isEmpty())
         return false;
@@ -455,22 +692,24 @@ ShardVersionMap RoutingTableHistory::_constructShardVersionMap() const {
         }
 
         auto& maxShardVersion = shardVersionIt->second.shardVersion;
+        auto& numChunks = shardVersionIt->second.numChunks;
 
-        current =
-            std::find_if(current,
-                         _chunkMap.cend(),
-                         [&currentRangeShardId,
-                          &maxShardVersion](const ChunkInfoMap::value_type& chunkMapEntry) {
-                             const auto& currentChunk = chunkMapEntry.second;
+        current = std::find_if(
+            current,
+            _chunkMap.cend(),
+            [&currentRangeShardId, &maxShardVersion, &numChunks](
+                const ChunkInfoMap::value_type& chunkMapEntry) {
+                const auto& currentChunk = chunkMapEntry.second;
 
-                             if (currentChunk->getShardIdAt(boost::none) != currentRangeShardId)
-                                 return true;
+                if (currentChunk->getShardIdAt(boost::none) != currentRangeShardId)
+                    return true;
 
-                             if (currentChunk->getLastmod() > maxShardVersion)
-                                 maxShardVersion = currentChunk->getLastmod();
+                if (currentChunk->getLastmod() > maxShardVersion)
+                    maxShardVersion = currentChunk->getLastmod();
 
-                             return false;
-                         });
+                ++numChunks;
+                return false;
+            });
 
         const auto rangeLast = std::prev(current);
 
@@ -543,6 +782,27 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
     const auto startingCollectionVersion = getVersion();
     auto chunkMap = _chunkMap;
 
+    // Unless the routing table is being built from scratch, the shard versions are derived from
+    // those of this routing table and only the chunks around the changed ones are validated, so the
+    // cost of the update doesn't depend on the total number of chunks.
+    struct ShardChunksSummary {
+        ChunkVersion maxVersion;
+        size_t numChunks;
+        // Whether a chunk at maxVersion was replaced, leaving the max unknown
+        bool maxVersionReplaced;
+    };
+    const bool incremental = !_chunkMap.empty();
+    std::map<ShardId, ShardChunksSummary> shardSummaries;
+    std::vector<std::string> changedChunkMaxKeyStrings;
+    if (incremental) {
+        for (const auto& [shardId, targetingInfo] : _shardVersions) {
+            shardSummaries.emplace(
+                shardId,
+                ShardChunksSummary{targetingInfo.shardVersion, targetingInfo.numChunks, false});
+        }
+        changedChunkMaxKeyStrings.reserve(changedChunks.size());
+    }
+
     ChunkVersion collectionVersion = startingCollectionVersion;
     for (const auto& chunk : changedChunks) {
         const auto& chunkVersion = chunk.getVersion();
@@ -591,11 +851,32 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
             newChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
         }
 
+        if (incremental) {
+            for (auto it = low; it != high; ++it) {
+                auto& summary = shardSummaries.at(it->second->getShardIdAt(boost::none));
+                --summary.numChunks;
+                if (it->second->getLastmod() == summary.maxVersion)
+                    summary.maxVersionReplaced = true;
+            }
+
+            // Chunks come in incrementally sorted order, so the new chunk's version is the max of
+            // its shard
+            auto summaryIt = shardSummaries.find(chunk.getShard());
+            if (summaryIt == shardSummaries.end()) {
+                summaryIt =
+                    shardSummaries.emplace(chunk.getShard(), ShardChunksSummary{{}, 0, false})
+                        .first;
+            }
+            summaryIt->second = {chunkVersion, summaryIt->second.numChunks + 1, false};
+
+            changedChunkMaxKeyStrings.push_back(chunkMaxKeyString);
+        }
+
         // Erase all chunks from the map, which overlap the chunk we got from the persistent store
         chunkMap.erase(low, high);
 
         // Insert only the chunk itself
-        chunkMap.insert(std::make_pair(chunkMaxKeyString, newChunk));
+        chunkMap.insert(chunkMaxKeyString, std::move(newChunk));
     }
 
     // If at least one diff was applied, the metadata is correct, but it might not have changed so
@@ -610,6 +891,30 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
         return shared_from_this();
     }
 
+    boost::optional<ShardVersionMap> shardVersions;
+    if (incremental) {
+        checkContinuityAroundChunks(chunkMap, changedChunkMaxKeyStrings);
+
+        shardVersions.emplace();
+        for (const auto& [shardId, summary] : shardSummaries) {
+            if (summary.numChunks == 0)
+                continue;
+
+            // A shard that lost its highest versioned chunk without getting a newer one. This
+            // doesn't happen with the chunk operations we know of, but if it does, fall back to a
+            // full pass over the chunk map.
+            if (summary.maxVersionReplaced) {
+                shardVersions.reset();
+                break;
+            }
+
+            auto& targetingInfo =
+                shardVersions->emplace(shardId, collectionVersion.epoch()).first->second;
+            targetingInfo.shardVersion = summary.maxVersion;
+            targetingInfo.numChunks = summary.numChunks;
+        }
+    }
+
     return std::shared_ptr<RoutingTableHistory>(
         new RoutingTableHistory(_nss,
                                 _uuid,
@@ -617,7 +922,8 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
                                 CollatorInterface::cloneCollator(getDefaultCollator()),
                                 isUnique(),
                                 std::move(chunkMap),
-                                collectionVersion));
+                                collectionVersion,
+                                std::move(shardVersions)));
 }
 
 }  // namespace mongo
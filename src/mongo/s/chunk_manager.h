@@ -29,7 +29,9 @@
 
 #pragma once
 
+#include <iterator>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -49,8 +51,133 @@ struct QuerySolutionNode;
 class OperationContext;
 class ChunkManager;
 
-// Ordered map from the max for each chunk to an entry describing the chunk
-using ChunkInfoMap = std::map<std::string, std::shared_ptr<ChunkInfo>>;
+/**
+ * Ordered map from the max for each chunk to an entry describing the chunk. It offers the subset of
+ * the std::map interface that routing needs.
+ *
+ * The entries are kept in buckets of at most kMaxBucketSize chunks, which copies of the map share
+ * until one of them modifies the bucket. Copying a map of N chunks therefore costs O(N /
+ * kMaxBucketSize) and each change to it O(kMaxBucketSize), so an incremental refresh of a large
+ * collection doesn't copy the whole routing table and older snapshots of it stay cheap to hold.
+ * The iterators of a map stay valid for as long as the map isn't modified.
+ */
+class ChunkInfoMap {
+    using Bucket = std::map<std::string, std::shared_ptr<ChunkInfo>>;
+    using BucketVector = std::vector<std::shared_ptr<Bucket>>;
+
+public:
+    using key_type = std::string;
+    using mapped_type = std::shared_ptr<ChunkInfo>;
+    using value_type = Bucket::value_type;
+    using size_type = std::size_t;
+
+    static constexpr size_type kMaxBucketSize = 512;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = ChunkInfoMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() = default;
+
+        reference operator*() const {
+            return *_it;
+        }
+        pointer operator->() const {
+            return &*_it;
+        }
+
+        const_iterator& operator++();
+        const_iterator operator++(int) {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+
+        const_iterator& operator--();
+        const_iterator operator--(int) {
+            auto old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return _bucket == other._bucket &&
+                (!_buckets || _bucket == _buckets->size() || _it == other._it);
+        }
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        friend class ChunkInfoMap;
+
+        const_iterator(const BucketVector* buckets, size_t bucket, Bucket::const_iterator it)
+            : _buckets(buckets), _bucket(bucket), _it(it) {}
+
+        const BucketVector* _buckets = nullptr;
+        size_t _bucket = 0;
+        Bucket::const_iterator _it;
+    };
+
+    using iterator = const_iterator;
+
+    const_iterator begin() const {
+        return _buckets.empty() ? end() : const_iterator(&_buckets, 0, _buckets.front()->cbegin());
+    }
+    const_iterator end() const {
+        return const_iterator(&_buckets, _buckets.size(), {});
+    }
+    const_iterator cbegin() const {
+        return begin();
+    }
+    const_iterator cend() const {
+        return end();
+    }
+
+    size_type size() const {
+        return _size;
+    }
+    bool empty() const {
+        return _size == 0;
+    }
+
+    const_iterator lower_bound(const std::string& key) const;
+    const_iterator upper_bound(const std::string& key) const;
+    const_iterator find(const std::string& key) const;
+
+    /**
+     * Like std::map::at, throws std::out_of_range if there is no chunk with the given max.
+     */
+    const mapped_type& at(const std::string& key) const;
+
+    /**
+     * Inserts the chunk unless one with the same max is already present. Returns whether it was
+     * inserted.
+     */
+    bool insert(std::string key, mapped_type value);
+
+    /**
+     * Erases the chunks in [first, last), which must be iterators into this map.
+     */
+    void erase(const_iterator first, const_iterator last);
+
+private:
+    // Returns bucket 'i', first copying it if it is shared with another map.
+    Bucket& _mutableBucket(size_t i);
+
+    // Splits bucket 'i' in two if it has grown beyond kMaxBucketSize entries.
+    void _splitIfNeeded(size_t i);
+
+    // Ordered buckets, none of which is empty. Every key in a bucket sorts before every key of the
+    // following bucket.
+    BucketVector _buckets;
+
+    size_type _size = 0;
+};
 
 struct ShardVersionTargetingInfo {
     // Indicates whether the shard is stale and thus needs a catalog cache refresh. Is false by
@@ -60,6 +187,10 @@ struct ShardVersionTargetingInfo {
     // Max chunk version for the shard.
     ChunkVersion shardVersion;
 
+    // Number of chunks the shard owns, which lets incremental refreshes tell when a shard has been
+    // left without chunks.
+    size_t numChunks = 0;
+
     ShardVersionTargetingInfo(const OID& epoch);
 };
 
@@ -186,10 +317,12 @@ private:
                         std::unique_ptr<CollatorInterface> defaultCollator,
                         bool unique,
                         ChunkInfoMap chunkMap,
-                        ChunkVersion collectionVersion);
+                        ChunkVersion collectionVersion,
+                        boost::optional<ShardVersionMap> shardVersions = boost::none);
 
     /**
-     * Does a single pass over the chunkMap and constructs the ShardVersionMap object.
+     * Does a single pass over the chunkMap and constructs the ShardVersionMap object. Only used if
+     * the shard versions couldn't be derived from those of the previous routing table.
      */
     ShardVersionMap _constructShardVersionMap() const;
 
@@ -366,6 +499,17 @@ public:
         return findIntersectingChunk(shardKey, CollationSpec::kSimpleSpec);
     }
 
+    /**
+     * Bulk form of findIntersectingChunkWithSimpleCollation() for many full shard keys, such as
+     * those of the documents of an insert batch. Returns, in the same order as 'shardKeys', the id
+     * of the shard owning each key or the ShardKeyNotFound error findIntersectingChunk would throw.
+     *
+     * The keys are looked up in sorted order, so keys which fall into the same chunk, as clustered
+     * or monotonically increasing shard keys do, cost a single search of the chunk map.
+     */
+    std::vector<StatusWith<ShardId>> getShardIdsForShardKeys(
+        const std::vector<BSONObj>& shardKeys) const;
+
     /**
      * Finds the shard IDs for a given filter and collation. If collation is empty, we use the
      * collection default collation for targeting.
@@ -37,9 +37,13 @@
 
 #include "mongo/db/client.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/repl/read_concern_args.h"
 #include "mongo/s/catalog/sharding_catalog_client.h"
+#include "mongo/s/client/shard_registry.h"
+#include "mongo/s/config_server_catalog_cache_loader_gen.h"
 #include "mongo/s/database_version_helpers.h"
 #include "mongo/s/grid.h"
+#include "mongo/s/request_types/get_changed_chunks_gen.h"
 #include "mongo/util/fail_point.h"
 
 namespace mongo {
@@ -90,12 +94,73 @@ QueryAndSort createConfigDiffQuery(const NamespaceString& nss, ChunkVersion coll
             BSON(ChunkType::lastmod() << 1)};
 }
 
+/**
+ * Asks the config server for the chunks which changed since the specified version, which lets it
+ * serve concurrent refreshes of the same collection from a single read. Returns boost::none if the
+ * config server does not support this or the changes are too large to be returned in one reply, in
+ * which case they have to be read from config.chunks directly.
+ */
+boost::optional<CollectionAndChangedChunks> getChangedChunksFromConfigServer(
+    OperationContext* opCtx, const NamespaceString& nss, ChunkVersion sinceVersion) {
+    const auto grid = Grid::get(opCtx);
+
+    BSONObjBuilder cmdBuilder;
+    ConfigsvrGetChangedChunks(nss, sinceVersion).serialize({}, &cmdBuilder);
+    repl::ReadConcernArgs(grid->configOpTime(), repl::ReadConcernLevel::kMajorityReadConcern)
+        .appendInfo(&cmdBuilder);
+
+    auto response = uassertStatusOK(
+        grid->shardRegistry()->getConfigShard()->runCommandWithFixedRetryAttempts(
+            opCtx,
+            ReadPreferenceSetting{ReadPreference::Nearest},
+            NamespaceString::kAdminDb.toString(),
+            cmdBuilder.obj(),
+            Shard::RetryPolicy::kIdempotent));
+
+    if (response.commandStatus == ErrorCodes::CommandNotFound ||
+        response.commandStatus == ErrorCodes::BSONObjectTooLarge) {
+        return boost::none;
+    }
+    uassertStatusOK(response.commandStatus);
+
+    const auto parsedResponse = ConfigsvrGetChangedChunksResponse::parse(
+        IDLParserErrorContext("ConfigsvrGetChangedChunksResponse"), response.response);
+
+    std::vector<ChunkType> changedChunks;
+    changedChunks.reserve(parsedResponse.getChunks().size());
+    for (const auto& chunkDoc : parsedResponse.getChunks()) {
+        changedChunks.push_back(uassertStatusOK(ChunkType::fromConfigBSON(chunkDoc)));
+    }
+
+    return CollectionAndChangedChunks(parsedResponse.getUuid(),
+                                      parsedResponse.getEpoch(),
+                                      parsedResponse.getShardKeyPattern().getOwned(),
+                                      parsedResponse.getDefaultCollation().getOwned(),
+                                      parsedResponse.getUnique(),
+                                      std::move(changedChunks));
+}
+
 /**
  * Blocking method, which returns the chunks which changed since the specified version.
  */
 CollectionAndChangedChunks getChangedChunks(OperationContext* opCtx,
                                             const NamespaceString& nss,
                                             ChunkVersion sinceVersion) {
+    if (gCoalesceConfigServerRoutingTableRefreshes.load() &&
+        serverGlobalParams.clusterRole != ClusterRole::ConfigServer) {
+        if (auto collAndChunks = getChangedChunksFromConfigServer(opCtx, nss, sinceVersion)) {
+            return std::move(*collAndChunks);
+        }
+    }
+
+    return ConfigServerCatalogCacheLoader::getChangedChunksFromConfigCatalog(
+        opCtx, nss, sinceVersion);
+}
+
+}  // namespace
+
+CollectionAndChangedChunks ConfigServerCatalogCacheLoader::getChangedChunksFromConfigCatalog(
+    OperationContext* opCtx, const NamespaceString& nss, ChunkVersion sinceVersion) {
     const auto catalogClient = Grid::get(opCtx)->catalogClient();
 
     // Decide whether to do a full or partial load based on the state of the collection
@@ -134,8 +199,6 @@ CollectionAndChangedChunks getChangedChunks(OperationContext* opCtx,
                                       std::move(changedChunks));
 }
 
-}  // namespace
-
 ConfigServerCatalogCacheLoader::ConfigServerCatalogCacheLoader()
     : _threadPool(makeDefaultThreadPoolOptions()) {
     _threadPool.startup();
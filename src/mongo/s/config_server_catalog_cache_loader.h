@@ -59,6 +59,13 @@ public:
         StringData dbName,
         std::function<void(OperationContext*, StatusWith<DatabaseType>)> callbackFn) override;
 
+    /**
+     * Blocking method, which returns the chunks which changed since the specified version by
+     * reading config.collections and config.chunks directly.
+     */
+    static CollectionAndChangedChunks getChangedChunksFromConfigCatalog(
+        OperationContext* opCtx, const NamespaceString& nss, ChunkVersion sinceVersion);
+
 private:
     // Thread pool to be used to perform metadata load
     ThreadPool _threadPool;
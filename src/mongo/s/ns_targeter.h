@@ -103,6 +103,19 @@ public:
     virtual StatusWith<ShardEndpoint> targetInsert(OperationContext* opCtx,
                                                    const BSONObj& doc) const = 0;
 
+    /**
+     * Targets many document inserts at once, which lets implementations share work between the
+     * documents. Returns the result of targeting each document, in the same order as 'docs', or
+     * boost::none for documents which must be targeted with targetInsert() instead (which then
+     * also reports why they could not be targeted).
+     *
+     * The default implementation leaves every document to targetInsert().
+     */
+    virtual std::vector<boost::optional<StatusWith<ShardEndpoint>>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+        return std::vector<boost::optional<StatusWith<ShardEndpoint>>>(docs.size());
+    }
+
     /**
      * Returns a vector of ShardEndpoints for a potentially multi-shard update.
      *
@@ -39,6 +39,8 @@
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/killcursors_request.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
 #include "mongo/util/assert_util.h"
@@ -94,8 +96,8 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       // since that is not supported we treat boost::none (unspecified) to mean 'kNormal'.
       _tailableMode(params.getTailableMode().value_or(TailableModeEnum::kNormal)),
       _params(std::move(params)),
-      _mergeQueue(MergingComparator(
-          _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey())),
+      _mergeQueue(
+          _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey()),
       _promisedMinSortKeys(PromisedMinSortKeyComparator(_params.getSort().value_or(BSONObj()))) {
     if (params.getTxnNumber()) {
         invariant(params.getSessionId());
@@ -324,7 +326,7 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
     return _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock lk) {
     // Tailable non-awaitData cursors cannot have a sort.
     invariant(_tailableMode != TailableModeEnum::kTailable);
 
@@ -338,14 +340,14 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     invariant(!_remotes[smallestRemote].docBuffer.empty());
     invariant(_remotes[smallestRemote].status.isOK());
 
-    ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
-    _remotes[smallestRemote].docBuffer.pop();
+    ClusterQueryResult front = _remotes[smallestRemote].popNext();
 
     // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
     // next result.
     if (!_remotes[smallestRemote].docBuffer.empty()) {
         _mergeQueue.push(smallestRemote);
     }
+    _prefetchNextBatch(lk, smallestRemote);
 
     // For sorted tailable awaitData cursors, update the high water mark to the document's sort key.
     if (_tailableMode == TailableModeEnum::kTailableAndAwaitData) {
@@ -356,15 +358,15 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     return front;
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock lk) {
     size_t remotesAttempted = 0;
     while (remotesAttempted < _remotes.size()) {
         // It is illegal to call this method if there is an error received from any shard.
         invariant(_remotes[_gettingFromRemote].status.isOK());
 
         if (_remotes[_gettingFromRemote].hasNext()) {
-            ClusterQueryResult front = _remotes[_gettingFromRemote].docBuffer.front();
-            _remotes[_gettingFromRemote].docBuffer.pop();
+            ClusterQueryResult front = _remotes[_gettingFromRemote].popNext();
+            _prefetchNextBatch(lk, _gettingFromRemote);
 
             if (_tailableMode == TailableModeEnum::kTailable &&
                 !_remotes[_gettingFromRemote].hasNext()) {
@@ -446,6 +448,21 @@ Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
     return Status::OK();
 }
 
+void AsyncResultsMerger::_prefetchNextBatch(WithLock lk, size_t remoteIndex) {
+    auto& remote = _remotes[remoteIndex];
+    const auto maxBufferedBytes = internalQueryAsyncResultsMergerPrefetchBytes.load();
+
+    // Batches of tailable cursors are passed through to the client as they are, and a getMore may
+    // only be scheduled on behalf of an attached OperationContext.
+    if (maxBufferedBytes == 0 || _tailableMode != TailableModeEnum::kNormal || !_opCtx ||
+        _lifecycleState != kAlive || !remote.status.isOK() || !remote.hasNext() ||
+        remote.exhausted() || remote.cbHandle.isValid() ||
+        remote.bufferedBytes >= maxBufferedBytes) {
+        return;
+    }
+    remote.status = _askForNextBatch(lk, remoteIndex);
+}
+
 Status AsyncResultsMerger::scheduleGetMores() {
     stdx::lock_guard<Latch> lk(_mutex);
     return _scheduleGetMores(lk);
@@ -617,6 +634,7 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
         remote.partialResultsReturned = (remote.status != ErrorCodes::ExchangePassthrough);
         std::queue<ClusterQueryResult> emptyBuffer;
         std::swap(remote.docBuffer, emptyBuffer);
+        remote.bufferedBytes = 0;
         remote.status = Status::OK();
         remote.cursorId = 0;
     }
@@ -664,6 +682,8 @@ void AsyncResultsMerger::_processBatchResults(WithLock lk,
         // Be careful only to do this when '_opCtx' is non-null, since it is illegal to schedule a
         // remote command on a user's behalf without a non-null OperationContext.
         remote.status = _askForNextBatch(lk, remoteIndex);
+    } else {
+        _prefetchNextBatch(lk, remoteIndex);
     }
 }
 
@@ -672,6 +692,10 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                            const CursorResponse& response) {
     auto& remote = _remotes[remoteIndex];
     _updateRemoteMetadata(lk, remoteIndex, response);
+
+    // A prefetched batch may arrive while the remote still has results buffered, in which case the
+    // remote is already on the merge queue.
+    const bool wasBufferEmpty = remote.docBuffer.empty();
     for (const auto& obj : response.getBatch()) {
         // If there's a sort, we're expecting the remote node to have given us back a sort key.
         if (_params.getSort()) {
@@ -693,12 +717,13 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
 
         ClusterQueryResult result(obj);
         remote.docBuffer.push(result);
+        remote.bufferedBytes += obj.objsize();
         ++remote.fetchedCount;
     }
 
     // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
     // queue.
-    if (_params.getSort() && !response.getBatch().empty()) {
+    if (_params.getSort() && wasBufferEmpty && !response.getBatch().empty()) {
         _mergeQueue.push(remoteIndex);
     }
     return true;
@@ -811,17 +836,99 @@ bool AsyncResultsMerger::RemoteCursorData::exhausted() const {
     return cursorId == 0;
 }
 
+ClusterQueryResult AsyncResultsMerger::RemoteCursorData::popNext() {
+    invariant(!docBuffer.empty());
+    ClusterQueryResult front = std::move(docBuffer.front());
+    docBuffer.pop();
+    bufferedBytes -= front.getResult()->objsize();
+    return front;
+}
+
 //
-// AsyncResultsMerger::MergingComparator
+// AsyncResultsMerger::MergeTree
 //
 
-bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
+AsyncResultsMerger::MergeTree::MergeTree(const std::vector<RemoteCursorData>& remotes,
+                                         const BSONObj& sort,
+                                         bool compareWholeSortKey)
+    : _remotes(remotes),
+      _sort(sort),
+      _compareWholeSortKey(compareWholeSortKey),
+      _ordering(size_t(sort.nFields()) <= Ordering::kMaxCompoundIndexKeys
+                    ? boost::make_optional(Ordering::make(sort))
+                    : boost::none) {}
+
+void AsyncResultsMerger::MergeTree::push(size_t remoteIndex) {
+    if (remoteIndex >= _numLeaves) {
+        _grow(remoteIndex + 1);
+    }
+
+    if (_ordering) {
+        const auto& front = _remotes[remoteIndex].docBuffer.front();
+        KeyString::Builder ks(KeyString::Version::V1,
+                              extractSortKey(*front.getResult(), _compareWholeSortKey),
+                              *_ordering);
+        _keys[remoteIndex].assign(ks.getBuffer(), ks.getSize());
+    }
+
+    _nodes[_numLeaves + remoteIndex] = remoteIndex;
+    _replay(remoteIndex);
+}
+
+void AsyncResultsMerger::MergeTree::pop() {
+    const auto remoteIndex = top();
+    _nodes[_numLeaves + remoteIndex] = kNone;
+    _replay(remoteIndex);
+}
+
+bool AsyncResultsMerger::MergeTree::_less(size_t lhs, size_t rhs) const {
+    if (_ordering) {
+        return _keys[lhs] < _keys[rhs];
+    }
+
     const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
     const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
 
     return compareSortKeys(extractSortKey(*leftDoc.getResult(), _compareWholeSortKey),
                            extractSortKey(*rightDoc.getResult(), _compareWholeSortKey),
-                           _sort) > 0;
+                           _sort) < 0;
+}
+
+void AsyncResultsMerger::MergeTree::_replay(size_t remoteIndex) {
+    for (auto node = (_numLeaves + remoteIndex) / 2; node >= 1; node /= 2) {
+        const auto left = _nodes[2 * node];
+        const auto right = _nodes[2 * node + 1];
+
+        if (left == kNone) {
+            _nodes[node] = right;
+        } else if (right == kNone) {
+            _nodes[node] = left;
+        } else {
+            _nodes[node] = _less(right, left) ? right : left;
+        }
+    }
+}
+
+void AsyncResultsMerger::MergeTree::_grow(size_t numRemotes) {
+    size_t numLeaves = 1;
+    while (numLeaves < numRemotes) {
+        numLeaves *= 2;
+    }
+
+    std::vector<size_t> nodes(2 * numLeaves, kNone);
+    for (size_t i = 0; i < _numLeaves; ++i) {
+        nodes[numLeaves + i] = _nodes[_numLeaves + i];
+    }
+
+    _numLeaves = numLeaves;
+    _nodes = std::move(nodes);
+    _keys.resize(numLeaves);
+
+    for (size_t i = 0; i < _numLeaves; ++i) {
+        if (_nodes[_numLeaves + i] != kNone) {
+            _replay(i);
+        }
+    }
 }
 
 bool AsyncResultsMerger::PromisedMinSortKeyComparator::operator()(
@@ -30,11 +30,14 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <limits>
 #include <queue>
+#include <string>
 #include <vector>
 
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/ordering.h"
 #include "mongo/db/cursor_id.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/platform/mutex.h"
@@ -276,6 +279,11 @@ private:
          */
         bool exhausted() const;
 
+        /**
+         * Removes and returns the next buffered result. There must be one.
+         */
+        ClusterQueryResult popNext();
+
         // Used when merging tailable awaitData cursors in sorted order. In order to return any
         // result to the client we have to know that no shard will ever return anything that sorts
         // before it. This object represents a promise from the remote that it will never return a
@@ -305,6 +313,9 @@ private:
         // The buffer of results that have been retrieved but not yet returned to the caller.
         std::queue<ClusterQueryResult> docBuffer;
 
+        // The total size of the results in 'docBuffer'.
+        long long bufferedBytes = 0;
+
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
@@ -317,16 +328,54 @@ private:
         long long fetchedCount = 0;
     };
 
-    class MergingComparator {
+    /**
+     * Tournament tree over the remotes with buffered results, whose top is the remote holding the
+     * next document in sort order. It replaces a binary heap: picking the next remote after a pop
+     * costs one comparison per level of the tree rather than up to two.
+     *
+     * A loser tree would only support replaying the path of the remote that was just popped, but
+     * remotes rejoin the merge whenever a new batch arrives, so this keeps the winner of every
+     * subtree, which lets any remote's path be replayed.
+     *
+     * The sort key of each remote's next document is encoded as a KeyString once, when the remote
+     * enters the tree, so that comparisons are a memcmp of the encoded keys rather than a walk over
+     * the $sortKey BSON.
+     */
+    class MergeTree {
     public:
-        MergingComparator(const std::vector<RemoteCursorData>& remotes,
-                          const BSONObj& sort,
-                          bool compareWholeSortKey)
-            : _remotes(remotes), _sort(sort), _compareWholeSortKey(compareWholeSortKey) {}
+        MergeTree(const std::vector<RemoteCursorData>& remotes,
+                  const BSONObj& sort,
+                  bool compareWholeSortKey);
+
+        bool empty() const {
+            return _nodes.empty() || _nodes[1] == kNone;
+        }
+
+        size_t top() const {
+            return _nodes[1];
+        }
 
-        bool operator()(const size_t& lhs, const size_t& rhs);
+        /**
+         * Enters the remote 'remoteIndex', which must have a buffered result, into the merge.
+         */
+        void push(size_t remoteIndex);
+
+        /**
+         * Removes the top remote from the merge.
+         */
+        void pop();
 
     private:
+        static constexpr size_t kNone = std::numeric_limits<size_t>::max();
+
+        bool _less(size_t lhs, size_t rhs) const;
+
+        // Recomputes the winners on the path from the leaf of 'remoteIndex' to the root.
+        void _replay(size_t remoteIndex);
+
+        // Rebuilds the tree with room for at least 'numRemotes' leaves.
+        void _grow(size_t numRemotes);
+
         const std::vector<RemoteCursorData>& _remotes;
 
         const BSONObj _sort;
@@ -335,6 +384,19 @@ private:
         // We extract the sort key {$sortKey: <value>}. The sort key pattern '_sort' is verified to
         // be {$sortKey: 1}.
         const bool _compareWholeSortKey;
+
+        // Unset if the sort pattern has too many fields to be encoded as a KeyString, in which case
+        // the sort keys are compared as BSON.
+        const boost::optional<Ordering> _ordering;
+
+        // Number of leaves, a power of two. Leaf 'i' is at '_nodes[_numLeaves + i]', and the
+        // children of node 'n' are at '2 * n' and '2 * n + 1'. Each node holds the index of the
+        // winning remote of its subtree, or kNone.
+        size_t _numLeaves = 0;
+        std::vector<size_t> _nodes;
+
+        // The encoded sort key of the next document of every remote in the tree.
+        std::vector<std::string> _keys;
     };
 
     using MinSortKeyRemoteIdPair = std::pair<BSONObj, size_t>;
@@ -369,6 +431,14 @@ private:
      */
     Status _askForNextBatch(WithLock, size_t remoteIndex);
 
+    /**
+     * If prefetching is enabled by 'internalQueryAsyncResultsMergerPrefetchBytes', asks
+     * the given remote for its next batch while it still has results buffered, so that the batch
+     * is likely to have arrived by the time the buffer runs out. Records any failure to schedule
+     * the request in the remote's status.
+     */
+    void _prefetchNextBatch(WithLock, size_t remoteIndex);
+
     /**
      * Checks whether or not the remote cursors are all exhausted.
      */
@@ -469,9 +539,9 @@ private:
     // Data tracking the state of our communication with each of the remote nodes.
     std::vector<RemoteCursorData> _remotes;
 
-    // The top of this priority queue is the index into '_remotes' for the remote host that has the
-    // next document to return, according to the sort order. Used only if there is a sort.
-    std::priority_queue<size_t, std::vector<size_t>, MergingComparator> _mergeQueue;
+    // The top of this tree is the index into '_remotes' for the remote host that has the next
+    // document to return, according to the sort order. Used only if there is a sort.
+    MergeTree _mergeQueue;
 
     // The index into '_remotes' for the remote from which we are currently retrieving results.
     // Used only if there is *not* a sort.
@@ -38,12 +38,14 @@
 #include "mongo/db/pipeline/resume_token.h"
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_request.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/query/results_merger_test_fixture.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -156,6 +158,50 @@ TEST_F(AsyncResultsMergerTest, SingleShardSorted) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, PrefetchesNextBatchWhileResultsAreBuffered) {
+    const auto oldPrefetchBytes = internalQueryAsyncResultsMergerPrefetchBytes.load();
+    internalQueryAsyncResultsMergerPrefetchBytes.store(1024 * 1024);
+    ON_BLOCK_EXIT([&] { internalQueryAsyncResultsMergerPrefetchBytes.store(oldPrefetchBytes); });
+
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0],
+        kTestShardHosts[0],
+        CursorResponse(
+            kTestNss, 5, {fromjson("{$sortKey: {'': 1}}"), fromjson("{$sortKey: {'': 3}}")})));
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[1],
+        kTestShardHosts[1],
+        CursorResponse(
+            kTestNss, 6, {fromjson("{$sortKey: {'': 2}}"), fromjson("{$sortKey: {'': 4}}")})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+    ASSERT_TRUE(arm->ready());
+    ASSERT_FALSE(networkHasReadyRequests());
+
+    // Returning a result from each shard asks that shard for its next batch straight away.
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 1}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(networkHasReadyRequests());
+    scheduleNetworkResponse({kTestNss, CursorId(0), {fromjson("{$sortKey: {'': 5}}")}});
+
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 2}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(networkHasReadyRequests());
+    scheduleNetworkResponse({kTestNss, CursorId(0), {fromjson("{$sortKey: {'': 6}}")}});
+    ASSERT_TRUE(arm->remotesExhausted());
+
+    // The prefetched batches were merged behind the results that were already buffered.
+    for (int sortKey = 3; sortKey <= 6; ++sortKey) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(BSON("$sortKey" << BSON("" << sortKey)),
+                          *unittest::assertGet(arm->nextReady()).getResult());
+    }
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+    ASSERT_FALSE(networkHasReadyRequests());
+}
+
 TEST_F(AsyncResultsMergerTest, MultiShardUnsorted) {
     std::vector<RemoteCursor> cursors;
     cursors.push_back(
@@ -443,6 +489,56 @@ TEST_F(AsyncResultsMergerTest, CompoundSortKey) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, SortKeysOfMixedTypesMergeInBSONOrder) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: 1}}");
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, {})));
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, {})));
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[2], kTestShardHosts[2], CursorResponse(kTestNss, 7, {})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    ASSERT_FALSE(arm->ready());
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    ASSERT_FALSE(arm->ready());
+
+    // Numbers of different types compare by value, and sort between null and strings.
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: [null]}"),
+                                   fromjson("{$sortKey: [1.5]}"),
+                                   fromjson("{$sortKey: ['b']}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch1);
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: [-7]}"),
+                                   fromjson("{$sortKey: [{$numberLong: '2'}]}"),
+                                   fromjson("{$sortKey: ['a']}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch2);
+    std::vector<BSONObj> batch3 = {fromjson("{$sortKey: [{$minKey: 1}]}"),
+                                   fromjson("{$sortKey: [{$numberDecimal: '1.75'}]}"),
+                                   fromjson("{$sortKey: ['ab']}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch3);
+    scheduleNetworkResponses(std::move(responses));
+    executor()->waitForEvent(readyEvent);
+
+    ASSERT_TRUE(arm->remotesExhausted());
+    for (auto&& expected : {"{$sortKey: [{$minKey: 1}]}",
+                            "{$sortKey: [null]}",
+                            "{$sortKey: [-7]}",
+                            "{$sortKey: [1.5]}",
+                            "{$sortKey: [{$numberDecimal: '1.75'}]}",
+                            "{$sortKey: [{$numberLong: '2'}]}",
+                            "{$sortKey: ['a']}",
+                            "{$sortKey: ['ab']}",
+                            "{$sortKey: ['b']}"}) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(fromjson(expected), *unittest::assertGet(arm->nextReady()).getResult());
+    }
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 TEST_F(AsyncResultsMergerTest, SortedButNoSortKey) {
     BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: -1, b: 1}}");
     std::vector<RemoteCursor> cursors;
@@ -32,9 +32,12 @@
 
 #include "mongo/s/query/cluster_aggregation_planner.h"
 
+#include <cmath>
+
 #include "mongo/bson/util/bson_extract.h"
 #include "mongo/client/connpool.h"
 #include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_skip.h"
 #include "mongo/db/pipeline/sharded_agg_helpers.h"
@@ -429,6 +432,114 @@ DispatchShardPipelineResults dispatchExchangeConsumerPipeline(
                                         numConsumers};
 }
 
+/**
+ * Returns the stages an intermediate merge of the results of a group of shards runs after its
+ * $mergeCursors, if the merging pipeline can read the results of such merges in place of those of
+ * the shards, or boost::none if it cannot. That is so when the shards return sorted results, which
+ * an intermediate merge combines into one sorted stream, applying a leading $limit of the merging
+ * pipeline, or when the merging pipeline starts by merging partial $group results, which an
+ * intermediate merge turns into fewer partial results for the same group keys.
+ */
+boost::optional<Pipeline::SourceContainer> getIntermediateMergeStages(
+    const SplitPipeline& splitPipeline) {
+    const auto& mergeSources = splitPipeline.mergePipeline->getSources();
+    if (splitPipeline.shardCursorsSortSpec) {
+        if (!mergeSources.empty() &&
+            dynamic_cast<DocumentSourceLimit*>(mergeSources.front().get())) {
+            return Pipeline::SourceContainer{mergeSources.front()};
+        }
+        return Pipeline::SourceContainer{};
+    }
+
+    if (!mergeSources.empty()) {
+        auto group = dynamic_cast<DocumentSourceGroup*>(mergeSources.front().get());
+        if (group && group->doingMerge()) {
+            return Pipeline::SourceContainer{mergeSources.front()};
+        }
+    }
+    return boost::none;
+}
+
+/**
+ * Splits the shards' cursors into groups of about the square root of their number, and sends each
+ * group with 'intermediateStages' to one of its shards, which merges their results with 'needsMerge'
+ * set so that they can be merged again. Replaces the shards' cursors in 'shardDispatchResults' with
+ * those of the intermediate merges. The merging pipeline, and the sort spec its $mergeCursors
+ * merges by, are left as they are.
+ */
+void dispatchIntermediateMergePipelines(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                        const NamespaceString& executionNss,
+                                        Document serializedCommand,
+                                        const Pipeline::SourceContainer& intermediateStages,
+                                        DispatchShardPipelineResults* shardDispatchResults) {
+    auto opCtx = expCtx->opCtx;
+    auto& shardCursors = shardDispatchResults->remoteCursors;
+    const auto& sortSpec = shardDispatchResults->splitPipeline->shardCursorsSortSpec;
+
+    const size_t numShards = shardCursors.size();
+    const size_t groupSize = std::ceil(std::sqrt(numShards));
+
+    std::vector<std::pair<ShardId, BSONObj>> requests;
+    std::vector<SplitPipeline> intermediatePipelines;
+    // The cursors of shards left alone in the last group are merged directly.
+    std::vector<OwnedRemoteCursor> unmergedCursors;
+    for (size_t begin = 0; begin < numShards; begin += groupSize) {
+        std::vector<OwnedRemoteCursor> group;
+        for (size_t idx = begin; idx < std::min(begin + groupSize, numShards); ++idx) {
+            group.emplace_back(std::move(shardCursors[idx]));
+        }
+        if (group.size() == 1) {
+            unmergedCursors.emplace_back(std::move(group.front()));
+            continue;
+        }
+        ShardId mergingShardId = group.front()->getShardId().toString();
+
+        auto intermediatePipeline = Pipeline::create(intermediateStages, expCtx);
+        sharded_agg_helpers::addMergeCursorsSource(
+            intermediatePipeline.get(),
+            BSONObj(),
+            std::move(group),
+            {},
+            sortSpec,
+            Grid::get(opCtx)->getExecutorPool()->getArbitraryExecutor(),
+            false);
+        intermediatePipelines.emplace_back(std::move(intermediatePipeline), nullptr, boost::none);
+
+        auto intermediateCmdObj = sharded_agg_helpers::createCommandForTargetedShards(
+            expCtx, serializedCommand, intermediatePipelines.back(), boost::none, true);
+        requests.emplace_back(std::move(mergingShardId), std::move(intermediateCmdObj));
+    }
+
+    LOGV2_DEBUG(5212052,
+                1,
+                "Dispatching intermediate merges",
+                "numShards"_attr = numShards,
+                "numIntermediateMerges"_attr = requests.size());
+
+    auto cursors = establishCursors(opCtx,
+                                    Grid::get(opCtx)->getExecutorPool()->getArbitraryExecutor(),
+                                    executionNss,
+                                    ReadPreferenceSetting::get(opCtx),
+                                    requests,
+                                    false /* do not allow partial results */);
+
+    shardCursors.clear();
+    for (auto&& cursor : cursors) {
+        shardCursors.emplace_back(opCtx, std::move(cursor), executionNss);
+    }
+    for (auto&& cursor : unmergedCursors) {
+        shardCursors.emplace_back(std::move(cursor));
+    }
+    shardDispatchResults->numProducers = shardCursors.size();
+
+    // Each intermediate merge now owns the cursors of its group of shards.
+    for (const auto& pipeline : intermediatePipelines) {
+        const auto& mergeCursors =
+            static_cast<DocumentSourceMergeCursors*>(pipeline.shardsPipeline->peekFront());
+        mergeCursors->dismissCursorOwnership();
+    }
+}
+
 ClusterClientCursorGuard convertPipelineToRouterStages(
     std::unique_ptr<Pipeline, PipelineDeleter> pipeline, ClusterClientCursorParams&& cursorParams) {
     auto* opCtx = pipeline->getContext()->opCtx;
@@ -795,6 +906,23 @@ Status dispatchPipelineAndMerge(OperationContext* opCtx,
             expCtx, namespaces.executionNss, serializedCommand, &shardDispatchResults);
     }
 
+    // With enough shards, merge their results in groups before the final merge.
+    const auto minShardsForHierarchicalMerge = internalQueryHierarchicalMergeMinShards.load();
+    if (!shardDispatchResults.exchangeSpec && !hasChangeStream &&
+        expCtx->tailableMode == TailableModeEnum::kNormal && !TransactionRouter::get(opCtx) &&
+        minShardsForHierarchicalMerge > 0 &&
+        shardDispatchResults.remoteCursors.size() >=
+            static_cast<size_t>(std::max(minShardsForHierarchicalMerge, 2))) {
+        if (auto intermediateStages =
+                getIntermediateMergeStages(*shardDispatchResults.splitPipeline)) {
+            dispatchIntermediateMergePipelines(expCtx,
+                                               namespaces.executionNss,
+                                               serializedCommand,
+                                               *intermediateStages,
+                                               &shardDispatchResults);
+        }
+    }
+
     // If we reach here, we have a merge pipeline to dispatch.
     return dispatchMergingPipeline(expCtx,
                                    namespaces,
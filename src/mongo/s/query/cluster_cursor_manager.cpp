@@ -148,20 +148,21 @@ void ClusterCursorManager::PinnedCursor::returnAndKillCursor() {
 }
 
 ClusterCursorManager::ClusterCursorManager(ClockSource* clockSource)
-    : _clockSource(clockSource), _pseudoRandom(SecureRandom().nextInt64()) {
+    : _clockSource(clockSource) {
     invariant(_clockSource);
 }
 
 ClusterCursorManager::~ClusterCursorManager() {
-    invariant(_cursorIdPrefixToNamespaceMap.empty());
-    invariant(_namespaceToContainerMap.empty());
+    for (const auto& partition : _partitions) {
+        invariant(partition.cursorIdPrefixToNamespaceMap.empty());
+        invariant(partition.namespaceToContainerMap.empty());
+    }
 }
 
 void ClusterCursorManager::shutdown(OperationContext* opCtx) {
-    {
-        stdx::lock_guard<Latch> lk(_mutex);
-        _inShutdown = true;
-    }
+    // Registration checks the flag under its partition's mutex, so a cursor registered before the
+    // flag is seen is killed along with the others.
+    _inShutdown.store(true);
     killAllCursors(opCtx);
 }
 
@@ -175,9 +176,13 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
     // Read the clock out of the lock.
     const auto now = _clockSource->now();
 
-    stdx::unique_lock<Latch> lk(_mutex);
+    // Spread newly registered cursors over the partitions in turn, so that cursors on the same
+    // namespace do not all share one mutex.
+    const uint32_t partitionIndex = _nextPartition.fetchAndAdd(1) % kNumPartitions;
+    Partition& partition = _partitions[partitionIndex];
+    stdx::unique_lock<Latch> lk(partition.mutex);
 
-    if (_inShutdown) {
+    if (_inShutdown.load()) {
         lk.unlock();
         cursor->kill(opCtx);
         return Status(ErrorCodes::ShutdownInProgress,
@@ -188,8 +193,8 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
     cursor->setLeftoverMaxTimeMicros(opCtx->getRemainingMaxTimeMicros());
 
     // Find the CursorEntryContainer for this namespace.  If none exists, create one.
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    if (nsToContainerIt == _namespaceToContainerMap.end()) {
+    auto nsToContainerIt = partition.namespaceToContainerMap.find(nss);
+    if (nsToContainerIt == partition.namespaceToContainerMap.end()) {
         uint32_t containerPrefix = 0;
         do {
             // The server has always generated positive values for CursorId (which is a signed
@@ -198,16 +203,20 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
             // undefined behavior on 2's complement systems so we need to generate a new number.
             int32_t randomNumber = 0;
             do {
-                randomNumber = _pseudoRandom.nextInt32();
+                randomNumber = partition.pseudoRandom.nextInt32();
             } while (randomNumber == std::numeric_limits<int32_t>::min());
             containerPrefix = static_cast<uint32_t>(std::abs(randomNumber));
-        } while (_cursorIdPrefixToNamespaceMap.count(containerPrefix) > 0);
-        _cursorIdPrefixToNamespaceMap[containerPrefix] = nss;
+
+            // Align the prefix to this partition, so that _getPartition() can find the cursor.
+            containerPrefix = containerPrefix - containerPrefix % kNumPartitions + partitionIndex;
+        } while (partition.cursorIdPrefixToNamespaceMap.count(containerPrefix) > 0);
+        partition.cursorIdPrefixToNamespaceMap[containerPrefix] = nss;
 
         auto emplaceResult =
-            _namespaceToContainerMap.emplace(nss, CursorEntryContainer(containerPrefix));
+            partition.namespaceToContainerMap.emplace(nss, CursorEntryContainer(containerPrefix));
         invariant(emplaceResult.second);
-        invariant(_namespaceToContainerMap.size() == _cursorIdPrefixToNamespaceMap.size());
+        invariant(partition.namespaceToContainerMap.size() ==
+                  partition.cursorIdPrefixToNamespaceMap.size());
 
         nsToContainerIt = emplaceResult.first;
     } else {
@@ -219,7 +228,7 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
     CursorEntryMap& entryMap = container.entryMap;
     CursorId cursorId = 0;
     do {
-        const uint32_t cursorSuffix = static_cast<uint32_t>(_pseudoRandom.nextInt32());
+        const uint32_t cursorSuffix = static_cast<uint32_t>(partition.pseudoRandom.nextInt32());
         cursorId = createCursorId(container.containerPrefix, cursorSuffix);
     } while (cursorId == 0 || entryMap.count(cursorId) > 0);
 
@@ -238,14 +247,15 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
     OperationContext* opCtx,
     AuthzCheckFn authChecker,
     AuthCheck checkSessionAuth) {
-    stdx::lock_guard<Latch> lk(_mutex);
+    Partition& partition = _getPartition(cursorId);
+    stdx::lock_guard<Latch> lk(partition.mutex);
 
-    if (_inShutdown) {
+    if (_inShutdown.load()) {
         return Status(ErrorCodes::ShutdownInProgress,
                       "Cannot check out cursor as we are in the process of shutting down");
     }
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -298,9 +308,10 @@ void ClusterCursorManager::checkInCursor(std::unique_ptr<ClusterClientCursor> cu
     cursor->detachFromOperationContext();
     cursor->setLastUseDate(now);
 
-    stdx::unique_lock<Latch> lk(_mutex);
+    Partition& partition = _getPartition(cursorId);
+    stdx::unique_lock<Latch> lk(partition.mutex);
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     invariant(entry);
 
     // killPending will be true if killCursor() was called while the cursor was in use.
@@ -316,15 +327,16 @@ void ClusterCursorManager::checkInCursor(std::unique_ptr<ClusterClientCursor> cu
 
     // After detaching the cursor, the entry will be destroyed.
     entry = nullptr;
-    detachAndKillCursor(std::move(lk), opCtx, nss, cursorId);
+    detachAndKillCursor(std::move(lk), partition, opCtx, nss, cursorId);
 }
 
 Status ClusterCursorManager::checkAuthForKillCursors(OperationContext* opCtx,
                                                      const NamespaceString& nss,
                                                      CursorId cursorId,
                                                      AuthzCheckFn authChecker) {
-    stdx::lock_guard<Latch> lk(_mutex);
-    auto entry = _getEntry(lk, nss, cursorId);
+    Partition& partition = _getPartition(cursorId);
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    auto entry = _getEntry(lk, partition, nss, cursorId);
 
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
@@ -351,9 +363,10 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
                                         CursorId cursorId) {
     invariant(opCtx);
 
-    stdx::unique_lock<Latch> lk(_mutex);
+    Partition& partition = _getPartition(cursorId);
+    stdx::unique_lock<Latch> lk(partition.mutex);
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -368,7 +381,7 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
     }
 
     // No one is using the cursor, so we destroy it.
-    detachAndKillCursor(std::move(lk), opCtx, nss, cursorId);
+    detachAndKillCursor(std::move(lk), partition, opCtx, nss, cursorId);
 
     // We no longer hold the lock here.
 
@@ -376,10 +389,11 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
 }
 
 void ClusterCursorManager::detachAndKillCursor(stdx::unique_lock<Latch> lk,
+                                               Partition& partition,
                                                OperationContext* opCtx,
                                                const NamespaceString& nss,
                                                CursorId cursorId) {
-    auto detachedCursorGuard = _detachCursor(lk, opCtx, nss, cursorId);
+    auto detachedCursorGuard = _detachCursor(lk, partition, opCtx, nss, cursorId);
     invariant(detachedCursorGuard.getStatus());
 
     // Deletion of the cursor can happen out of the lock.
@@ -389,8 +403,6 @@ void ClusterCursorManager::detachAndKillCursor(stdx::unique_lock<Latch> lk,
 
 std::size_t ClusterCursorManager::killMortalCursorsInactiveSince(OperationContext* opCtx,
                                                                  Date_t cutoff) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
     auto pred = [cutoff](CursorId cursorId, const CursorEntry& entry) -> bool {
         bool res = entry.getLifetimeType() == CursorLifetime::Mortal &&
             !entry.getOperationUsingCursor() && entry.getLastActive() <= cutoff;
@@ -405,98 +417,99 @@ std::size_t ClusterCursorManager::killMortalCursorsInactiveSince(OperationContex
         return res;
     };
 
-    return killCursorsSatisfying(std::move(lk), opCtx, std::move(pred));
+    return killCursorsSatisfying(opCtx, std::move(pred));
 }
 
 void ClusterCursorManager::killAllCursors(OperationContext* opCtx) {
-    stdx::unique_lock<Latch> lk(_mutex);
     auto pred = [](CursorId, const CursorEntry&) -> bool { return true; };
 
-    killCursorsSatisfying(std::move(lk), opCtx, std::move(pred));
+    killCursorsSatisfying(opCtx, std::move(pred));
 }
 
 std::size_t ClusterCursorManager::killCursorsSatisfying(
-    stdx::unique_lock<Latch> lk,
-    OperationContext* opCtx,
-    std::function<bool(CursorId, const CursorEntry&)> pred) {
+    OperationContext* opCtx, std::function<bool(CursorId, const CursorEntry&)> pred) {
     invariant(opCtx);
-    invariant(lk.owns_lock());
     std::size_t nKilled = 0;
 
-    std::vector<ClusterClientCursorGuard> cursorsToDestroy;
-    auto nsContainerIt = _namespaceToContainerMap.begin();
-    while (nsContainerIt != _namespaceToContainerMap.end()) {
-        auto&& entryMap = nsContainerIt->second.entryMap;
-        auto cursorIdEntryIt = entryMap.begin();
-        while (cursorIdEntryIt != entryMap.end()) {
-            auto cursorId = cursorIdEntryIt->first;
-            auto& entry = cursorIdEntryIt->second;
-
-            if (!pred(cursorId, entry)) {
-                ++cursorIdEntryIt;
-                continue;
-            }
+    for (auto& partition : _partitions) {
+        std::vector<ClusterClientCursorGuard> cursorsToDestroy;
+        stdx::unique_lock<Latch> lk(partition.mutex);
 
-            ++nKilled;
+        auto nsContainerIt = partition.namespaceToContainerMap.begin();
+        while (nsContainerIt != partition.namespaceToContainerMap.end()) {
+            auto&& entryMap = nsContainerIt->second.entryMap;
+            auto cursorIdEntryIt = entryMap.begin();
+            while (cursorIdEntryIt != entryMap.end()) {
+                auto cursorId = cursorIdEntryIt->first;
+                auto& entry = cursorIdEntryIt->second;
 
-            if (entry.getOperationUsingCursor()) {
-                // Mark the OperationContext using the cursor as killed, and move on.
-                killOperationUsingCursor(lk, &entry);
-                ++cursorIdEntryIt;
-                continue;
-            }
+                if (!pred(cursorId, entry)) {
+                    ++cursorIdEntryIt;
+                    continue;
+                }
 
-            cursorsToDestroy.push_back(entry.releaseCursor(opCtx));
+                ++nKilled;
 
-            // Destroy the entry and set the iterator to the next element.
-            entryMap.erase(cursorIdEntryIt++);
-        }
+                if (entry.getOperationUsingCursor()) {
+                    // Mark the OperationContext using the cursor as killed, and move on.
+                    killOperationUsingCursor(lk, &entry);
+                    ++cursorIdEntryIt;
+                    continue;
+                }
 
-        if (entryMap.empty()) {
-            nsContainerIt = eraseContainer(nsContainerIt);
-        } else {
-            ++nsContainerIt;
+                cursorsToDestroy.push_back(entry.releaseCursor(opCtx));
+
+                // Destroy the entry and set the iterator to the next element.
+                entryMap.erase(cursorIdEntryIt++);
+            }
+
+            if (entryMap.empty()) {
+                nsContainerIt = eraseContainer(lk, partition, nsContainerIt);
+            } else {
+                ++nsContainerIt;
+            }
         }
-    }
 
-    // Ensure cursors are killed outside the lock, as killing may require waiting for callbacks to
-    // finish.
-    lk.unlock();
+        // Ensure cursors are killed outside the lock, as killing may require waiting for callbacks
+        // to finish.
+        lk.unlock();
 
-    for (auto&& cursorGuard : cursorsToDestroy) {
-        invariant(cursorGuard);
-        cursorGuard->kill(opCtx);
+        for (auto&& cursorGuard : cursorsToDestroy) {
+            invariant(cursorGuard);
+            cursorGuard->kill(opCtx);
+        }
     }
 
     return nKilled;
 }
 
 ClusterCursorManager::Stats ClusterCursorManager::stats() const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     Stats stats;
 
-    for (auto& nsContainerPair : _namespaceToContainerMap) {
-        for (auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
-            const CursorEntry& entry = cursorIdEntryPair.second;
-
-            if (entry.isKillPending()) {
-                // Killed cursors do not count towards the number of pinned cursors or the number of
-                // open cursors.
-                continue;
-            }
-
-            if (entry.getOperationUsingCursor()) {
-                ++stats.cursorsPinned;
-            }
-
-            switch (entry.getCursorType()) {
-                case CursorType::SingleTarget:
-                    ++stats.cursorsSingleTarget;
-                    break;
-                case CursorType::MultiTarget:
-                    ++stats.cursorsMultiTarget;
-                    break;
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (auto& nsContainerPair : partition.namespaceToContainerMap) {
+            for (auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+                const CursorEntry& entry = cursorIdEntryPair.second;
+
+                if (entry.isKillPending()) {
+                    // Killed cursors do not count towards the number of pinned cursors or the
+                    // number of open cursors.
+                    continue;
+                }
+
+                if (entry.getOperationUsingCursor()) {
+                    ++stats.cursorsPinned;
+                }
+
+                switch (entry.getCursorType()) {
+                    case CursorType::SingleTarget:
+                        ++stats.cursorsSingleTarget;
+                        break;
+                    case CursorType::MultiTarget:
+                        ++stats.cursorsMultiTarget;
+                        break;
+                }
             }
         }
     }
@@ -505,20 +518,21 @@ ClusterCursorManager::Stats ClusterCursorManager::stats() const {
 }
 
 void ClusterCursorManager::appendActiveSessions(LogicalSessionIdSet* lsids) const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
-    for (const auto& nsContainerPair : _namespaceToContainerMap) {
-        for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
-            const CursorEntry& entry = cursorIdEntryPair.second;
-
-            if (entry.isKillPending()) {
-                // Don't include sessions for killed cursors.
-                continue;
-            }
-
-            auto lsid = entry.getLsid();
-            if (lsid) {
-                lsids->insert(*lsid);
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (const auto& nsContainerPair : partition.namespaceToContainerMap) {
+            for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+                const CursorEntry& entry = cursorIdEntryPair.second;
+
+                if (entry.isKillPending()) {
+                    // Don't include sessions for killed cursors.
+                    continue;
+                }
+
+                auto lsid = entry.getLsid();
+                if (lsid) {
+                    lsids->insert(*lsid);
+                }
             }
         }
     }
@@ -546,28 +560,29 @@ std::vector<GenericCursor> ClusterCursorManager::getIdleCursors(
     const OperationContext* opCtx, MongoProcessInterface::CurrentOpUserMode userMode) const {
     std::vector<GenericCursor> cursors;
 
-    stdx::lock_guard<Latch> lk(_mutex);
-
     AuthorizationSession* ctxAuth = AuthorizationSession::get(opCtx->getClient());
 
-    for (const auto& nsContainerPair : _namespaceToContainerMap) {
-        for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
-
-            const CursorEntry& entry = cursorIdEntryPair.second;
-            // If auth is enabled, and userMode is allUsers, check if the current user has
-            // permission to see this cursor.
-            if (ctxAuth->getAuthorizationManager().isAuthEnabled() &&
-                userMode == MongoProcessInterface::CurrentOpUserMode::kExcludeOthers &&
-                !ctxAuth->isCoauthorizedWith(entry.getAuthenticatedUsers())) {
-                continue;
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (const auto& nsContainerPair : partition.namespaceToContainerMap) {
+            for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+
+                const CursorEntry& entry = cursorIdEntryPair.second;
+                // If auth is enabled, and userMode is allUsers, check if the current user has
+                // permission to see this cursor.
+                if (ctxAuth->getAuthorizationManager().isAuthEnabled() &&
+                    userMode == MongoProcessInterface::CurrentOpUserMode::kExcludeOthers &&
+                    !ctxAuth->isCoauthorizedWith(entry.getAuthenticatedUsers())) {
+                    continue;
+                }
+                if (entry.isKillPending() || entry.getOperationUsingCursor()) {
+                    // Don't include sessions for killed or pinned cursors.
+                    continue;
+                }
+
+                cursors.emplace_back(
+                    entry.cursorToGenericCursor(cursorIdEntryPair.first, nsContainerPair.first));
             }
-            if (entry.isKillPending() || entry.getOperationUsingCursor()) {
-                // Don't include sessions for killed or pinned cursors.
-                continue;
-            }
-
-            cursors.emplace_back(
-                entry.cursorToGenericCursor(cursorIdEntryPair.first, nsContainerPair.first));
         }
     }
 
@@ -595,22 +610,24 @@ std::pair<Status, int> ClusterCursorManager::killCursorsWithMatchingSessions(
 
 stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForSession(
     LogicalSessionId lsid) const {
-    stdx::lock_guard<Latch> lk(_mutex);
 
     stdx::unordered_set<CursorId> cursorIds;
 
-    for (auto&& nsContainerPair : _namespaceToContainerMap) {
-        for (auto&& cursorIdEntryPair : nsContainerPair.second.entryMap) {
-            const CursorEntry& entry = cursorIdEntryPair.second;
-
-            if (entry.isKillPending()) {
-                // Don't include sessions for killed cursors.
-                continue;
-            }
-
-            auto cursorLsid = entry.getLsid();
-            if (lsid == cursorLsid) {
-                cursorIds.insert(cursorIdEntryPair.first);
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (auto&& nsContainerPair : partition.namespaceToContainerMap) {
+            for (auto&& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+                const CursorEntry& entry = cursorIdEntryPair.second;
+
+                if (entry.isKillPending()) {
+                    // Don't include sessions for killed cursors.
+                    continue;
+                }
+
+                auto cursorLsid = entry.getLsid();
+                if (lsid == cursorLsid) {
+                    cursorIds.insert(cursorIdEntryPair.first);
+                }
             }
         }
     }
@@ -620,20 +637,32 @@ stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForSession(
 
 boost::optional<NamespaceString> ClusterCursorManager::getNamespaceForCursorId(
     CursorId cursorId) const {
-    stdx::lock_guard<Latch> lk(_mutex);
+    const Partition& partition = _getPartition(cursorId);
+    stdx::lock_guard<Latch> lk(partition.mutex);
 
-    const auto it = _cursorIdPrefixToNamespaceMap.find(extractPrefixFromCursorId(cursorId));
-    if (it == _cursorIdPrefixToNamespaceMap.end()) {
+    const auto it =
+        partition.cursorIdPrefixToNamespaceMap.find(extractPrefixFromCursorId(cursorId));
+    if (it == partition.cursorIdPrefixToNamespaceMap.end()) {
         return boost::none;
     }
     return it->second;
 }
 
-auto ClusterCursorManager::_getEntry(WithLock, NamespaceString const& nss, CursorId cursorId)
-    -> CursorEntry* {
+auto ClusterCursorManager::_getPartition(CursorId cursorId) -> Partition& {
+    return _partitions[extractPrefixFromCursorId(cursorId) % kNumPartitions];
+}
+
+auto ClusterCursorManager::_getPartition(CursorId cursorId) const -> const Partition& {
+    return _partitions[extractPrefixFromCursorId(cursorId) % kNumPartitions];
+}
+
+auto ClusterCursorManager::_getEntry(WithLock,
+                                     Partition& partition,
+                                     NamespaceString const& nss,
+                                     CursorId cursorId) -> CursorEntry* {
 
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    if (nsToContainerIt == _namespaceToContainerMap.end()) {
+    auto nsToContainerIt = partition.namespaceToContainerMap.find(nss);
+    if (nsToContainerIt == partition.namespaceToContainerMap.end()) {
         return nullptr;
     }
     CursorEntryMap& entryMap = nsToContainerIt->second.entryMap;
@@ -645,7 +674,9 @@ auto ClusterCursorManager::_getEntry(WithLock, NamespaceString const& nss, Curso
     return &entryMapIt->second;
 }
 
-auto ClusterCursorManager::eraseContainer(NssToCursorContainerMap::iterator it)
+auto ClusterCursorManager::eraseContainer(WithLock,
+                                          Partition& partition,
+                                          NssToCursorContainerMap::iterator it)
     -> NssToCursorContainerMap::iterator {
     auto&& container = it->second;
     auto&& entryMap = container.entryMap;
@@ -653,19 +684,21 @@ auto ClusterCursorManager::eraseContainer(NssToCursorContainerMap::iterator it)
 
     // This was the last cursor remaining in the given namespace.  Erase all state associated
     // with this namespace.
-    size_t numDeleted = _cursorIdPrefixToNamespaceMap.erase(container.containerPrefix);
+    size_t numDeleted = partition.cursorIdPrefixToNamespaceMap.erase(container.containerPrefix);
     invariant(numDeleted == 1);
-    _namespaceToContainerMap.erase(it++);
-    invariant(_namespaceToContainerMap.size() == _cursorIdPrefixToNamespaceMap.size());
+    partition.namespaceToContainerMap.erase(it++);
+    invariant(partition.namespaceToContainerMap.size() ==
+              partition.cursorIdPrefixToNamespaceMap.size());
     return it;
 }
 
 StatusWith<ClusterClientCursorGuard> ClusterCursorManager::_detachCursor(WithLock lk,
+                                                                         Partition& partition,
                                                                          OperationContext* opCtx,
                                                                          const NamespaceString& nss,
                                                                          CursorId cursorId) {
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -678,13 +711,13 @@ StatusWith<ClusterClientCursorGuard> ClusterCursorManager::_detachCursor(WithLoc
     ClusterClientCursorGuard cursor = entry->releaseCursor(opCtx);
 
     // Destroy the entry.
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    invariant(nsToContainerIt != _namespaceToContainerMap.end());
+    auto nsToContainerIt = partition.namespaceToContainerMap.find(nss);
+    invariant(nsToContainerIt != partition.namespaceToContainerMap.end());
     CursorEntryMap& entryMap = nsToContainerIt->second.entryMap;
     size_t eraseResult = entryMap.erase(cursorId);
     invariant(1 == eraseResult);
     if (entryMap.empty()) {
-        eraseContainer(nsToContainerIt);
+        eraseContainer(lk, partition, nsToContainerIt);
     }
 
     return std::move(cursor);
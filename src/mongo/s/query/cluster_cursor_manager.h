@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -38,6 +39,7 @@
 #include "mongo/db/kill_sessions.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/session_killer.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/query/cluster_client_cursor.h"
@@ -68,7 +70,9 @@ class StatusWith;
  * The manager supports killing of registered cursors, either through the PinnedCursor object or
  * with the kill*() suite of methods.
  *
- * No public methods throw exceptions, and all public methods are thread-safe.
+ * No public methods throw exceptions, and all public methods are thread-safe. The registered
+ * cursors are spread over partitions with a mutex each, so that pinning and unpinning cursors in
+ * different partitions does not contend.
  */
 class ClusterCursorManager {
     ClusterCursorManager(const ClusterCursorManager&) = delete;
@@ -384,9 +388,14 @@ public:
 private:
     class CursorEntry;
     struct CursorEntryContainer;
+    struct Partition;
     using CursorEntryMap = stdx::unordered_map<CursorId, CursorEntry>;
     using NssToCursorContainerMap = stdx::unordered_map<NamespaceString, CursorEntryContainer>;
 
+    // The number of partitions that registered cursors are spread over. A power of two, so that a
+    // positive 32-bit cursor id prefix stays positive when it is aligned to its partition.
+    static constexpr size_t kNumPartitions = 16;
+
     /**
      * Transfers ownership of the given pinned cursor back to the manager, and moves the cursor to
      * the 'idle' state.
@@ -404,9 +413,16 @@ private:
                        CursorState cursorState);
 
     /**
-     * Will detach a cursor, release the lock and then call kill() on it.
+     * Returns the partition which holds the cursor with the given id, if it is registered.
+     */
+    Partition& _getPartition(CursorId cursorId);
+    const Partition& _getPartition(CursorId cursorId) const;
+
+    /**
+     * Will detach a cursor, release the lock on its partition and then call kill() on it.
      */
     void detachAndKillCursor(stdx::unique_lock<Latch> lk,
+                             Partition& partition,
                              OperationContext* opCtx,
                              const NamespaceString& nss,
                              CursorId cursorId);
@@ -417,7 +433,10 @@ private:
      *
      * Not thread-safe.
      */
-    CursorEntry* _getEntry(WithLock, NamespaceString const& nss, CursorId cursorId);
+    CursorEntry* _getEntry(WithLock,
+                           Partition& partition,
+                           NamespaceString const& nss,
+                           CursorId cursorId);
 
     /**
      * De-registers the given cursor, and returns an owned pointer to the underlying
@@ -429,6 +448,7 @@ private:
      * Not thread-safe.
      */
     StatusWith<ClusterClientCursorGuard> _detachCursor(WithLock,
+                                                       Partition& partition,
                                                        OperationContext* opCtx,
                                                        const NamespaceString& nss,
                                                        CursorId cursorId);
@@ -439,12 +459,11 @@ private:
     void killOperationUsingCursor(WithLock, CursorEntry* entry);
 
     /**
-     * Kill the cursors satisfying the given predicate. Assumes that 'lk' is held upon entry.
+     * Kill the cursors satisfying the given predicate, one partition at a time.
      *
      * Returns the number of cursors killed.
      */
-    std::size_t killCursorsSatisfying(stdx::unique_lock<Latch> lk,
-                                      OperationContext* opCtx,
+    std::size_t killCursorsSatisfying(OperationContext* opCtx,
                                       std::function<bool(CursorId, const CursorEntry&)> pred);
 
     /**
@@ -586,41 +605,59 @@ private:
         CursorEntryMap entryMap;
     };
 
+    /**
+     * A share of the registered cursors, with its own mutex. A cursor id's prefix is congruent to
+     * the index of the partition holding it modulo kNumPartitions, so a cursor id is enough to find
+     * its partition. Cursors on one namespace may be spread over several partitions, each of which
+     * gives that namespace its own prefix.
+     */
+    struct Partition {
+        Partition() : pseudoRandom(SecureRandom().nextInt64()) {}
+
+        // Synchronizes access to all state variables below.
+        mutable Mutex mutex = MONGO_MAKE_LATCH("ClusterCursorManager::Partition::mutex");
+
+        // Randomness source.  Used for cursor id generation.
+        PseudoRandom pseudoRandom;
+
+        // Map from cursor id prefix to associated namespace.  Exists only to provide namespace
+        // lookup for (deprecated) getNamespaceForCursorId() method.
+        //
+        // A CursorId is a 64-bit type, made up of a 32-bit prefix and a 32-bit suffix.  When the
+        // first cursor on a given namespace is registered in this partition, it is given a CursorId
+        // with a prefix that is unique to that namespace, and an arbitrary suffix.  Cursors
+        // subsequently registered on that namespace in this partition will all share the same
+        // prefix.
+        //
+        // Entries are added when the first cursor on the given namespace is registered, and
+        // removed when the last cursor on the given namespace is destroyed.
+        stdx::unordered_map<uint32_t, NamespaceString> cursorIdPrefixToNamespaceMap;
+
+        // Map from namespace to the CursorEntryContainer for that namespace.
+        //
+        // Entries are added when the first cursor on the given namespace is registered, and
+        // removed when the last cursor on the given namespace is destroyed.
+        NssToCursorContainerMap namespaceToContainerMap;
+    };
+
     /**
      * Erase the container that 'it' points to and return an iterator to the next one. Assumes 'it'
-     * is an iterator in '_namespaceToContainerMap'.
+     * is an iterator in the 'namespaceToContainerMap' of 'partition'.
      */
-    NssToCursorContainerMap::iterator eraseContainer(NssToCursorContainerMap::iterator it);
+    NssToCursorContainerMap::iterator eraseContainer(WithLock,
+                                                     Partition& partition,
+                                                     NssToCursorContainerMap::iterator it);
 
     // Clock source.  Used when the 'last active' time for a cursor needs to be set/updated.  May be
     // concurrently accessed by multiple threads.
     ClockSource* _clockSource;
 
-    // Synchronizes access to all private state variables below.
-    mutable Mutex _mutex = MONGO_MAKE_LATCH("ClusterCursorManager::_mutex");
-
-    bool _inShutdown{false};
-
-    // Randomness source.  Used for cursor id generation.
-    PseudoRandom _pseudoRandom;
+    AtomicWord<bool> _inShutdown{false};
 
-    // Map from cursor id prefix to associated namespace.  Exists only to provide namespace lookup
-    // for (deprecated) getNamespaceForCursorId() method.
-    //
-    // A CursorId is a 64-bit type, made up of a 32-bit prefix and a 32-bit suffix.  When the first
-    // cursor on a given namespace is registered, it is given a CursorId with a prefix that is
-    // unique to that namespace, and an arbitrary suffix.  Cursors subsequently registered on that
-    // namespace will all share the same prefix.
-    //
-    // Entries are added when the first cursor on the given namespace is registered, and removed
-    // when the last cursor on the given namespace is destroyed.
-    stdx::unordered_map<uint32_t, NamespaceString> _cursorIdPrefixToNamespaceMap;
+    // Used to spread newly registered cursors over the partitions in turn.
+    AtomicWord<unsigned> _nextPartition{0};
 
-    // Map from namespace to the CursorEntryContainer for that namespace.
-    //
-    // Entries are added when the first cursor on the given namespace is registered, and removed
-    // when the last cursor on the given namespace is destroyed.
-    NssToCursorContainerMap _namespaceToContainerMap;
+    std::array<Partition, kNumPartitions> _partitions;
 
     size_t _cursorsTimedOut = 0;
 };
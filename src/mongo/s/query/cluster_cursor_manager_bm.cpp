@@ -0,0 +1,149 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/service_context.h"
+#include "mongo/s/query/cluster_client_cursor_mock.h"
+#include "mongo/s/query/cluster_cursor_manager.h"
+#include "mongo/util/clock_source_mock.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+const int kMaxPerfThreads = 16;  // max number of threads pinning cursors concurrently
+const int kCursorsPerThread = 64;
+
+Status successAuthChecker(UserNameIterator userNames) {
+    return Status::OK();
+}
+
+class ClusterCursorManagerTest : public benchmark::Fixture {
+public:
+    /**
+     * Creates a manager and 'k' Clients with an OperationContext each, and registers
+     * 'kCursorsPerThread' idle cursors for each of them. The cursors of client 'i' are on the
+     * namespace returned by 'nssForThread(i)'.
+     */
+    void setUpCursors(int k, std::function<NamespaceString(int)> nssForThread) {
+        manager = std::make_unique<ClusterCursorManager>(&clockSource);
+        for (int i = 0; i < k; ++i) {
+            auto client = getGlobalServiceContext()->makeClient(str::stream()
+                                                                << "test client for thread " << i);
+            auto opCtx = client->makeOperationContext();
+            const auto nss = nssForThread(i);
+            std::vector<CursorId> ids;
+            for (int j = 0; j < kCursorsPerThread; ++j) {
+                ids.push_back(uassertStatusOK(manager->registerCursor(
+                    opCtx.get(),
+                    std::make_unique<ClusterClientCursorMock>(boost::none, boost::none),
+                    nss,
+                    ClusterCursorManager::CursorType::SingleTarget,
+                    ClusterCursorManager::CursorLifetime::Mortal,
+                    UserNameIterator())));
+            }
+            threads.push_back({std::move(client), std::move(opCtx), nss, std::move(ids)});
+        }
+    }
+
+    void tearDownCursors() {
+        manager->shutdown(threads.front().opCtx.get());
+        threads.clear();
+        manager.reset();
+    }
+
+    /**
+     * Checks out each of the cursors of thread 'threadIndex' in turn and returns it to the manager,
+     * as a getMore does.
+     */
+    void pinAndUnpinCursors(benchmark::State& state) {
+        size_t next = 0;
+        for (auto keepRunning : state) {
+            auto& thread = threads[state.thread_index];
+            auto pinnedCursor =
+                manager->checkOutCursor(thread.nss,
+                                        thread.cursorIds[next++ % thread.cursorIds.size()],
+                                        thread.opCtx.get(),
+                                        successAuthChecker,
+                                        ClusterCursorManager::kNoCheckSession);
+            invariant(pinnedCursor.getStatus());
+            pinnedCursor.getValue().returnCursor(ClusterCursorManager::CursorState::NotExhausted);
+        }
+    }
+
+protected:
+    struct ThreadState {
+        ServiceContext::UniqueClient client;
+        ServiceContext::UniqueOperationContext opCtx;
+        NamespaceString nss;
+        std::vector<CursorId> cursorIds;
+    };
+
+    ClockSourceMock clockSource;
+    std::unique_ptr<ClusterCursorManager> manager;
+    std::vector<ThreadState> threads;
+};
+
+BENCHMARK_DEFINE_F(ClusterCursorManagerTest, BM_PinCursorsOnSameNamespace)
+(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        setUpCursors(state.threads, [](int) { return NamespaceString("test.coll"); });
+    }
+
+    pinAndUnpinCursors(state);
+
+    if (state.thread_index == 0) {
+        tearDownCursors();
+    }
+}
+
+BENCHMARK_DEFINE_F(ClusterCursorManagerTest, BM_PinCursorsOnDistinctNamespaces)
+(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        setUpCursors(state.threads,
+                     [](int i) { return NamespaceString("test", str::stream() << "coll" << i); });
+    }
+
+    pinAndUnpinCursors(state);
+
+    if (state.thread_index == 0) {
+        tearDownCursors();
+    }
+}
+
+BENCHMARK_REGISTER_F(ClusterCursorManagerTest, BM_PinCursorsOnSameNamespace)
+    ->ThreadRange(1, kMaxPerfThreads);
+BENCHMARK_REGISTER_F(ClusterCursorManagerTest, BM_PinCursorsOnDistinctNamespaces)
+    ->ThreadRange(1, kMaxPerfThreads);
+
+}  // namespace
+}  // namespace mongo
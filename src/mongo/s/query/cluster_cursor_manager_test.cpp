@@ -30,6 +30,7 @@
 #include "mongo/platform/basic.h"
 
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "mongo/db/logical_session_cache_noop.h"
@@ -539,6 +540,45 @@ TEST_F(ClusterCursorManagerTest, KillAllCursors) {
     }
 }
 
+// Test that many cursors on one namespace, which are spread over several cursor id prefixes, can
+// each be found, checked out and killed.
+TEST_F(ClusterCursorManagerTest, ManyCursorsOnOneNamespace) {
+    const size_t numCursors = 100;
+    std::vector<CursorId> cursorIds;
+    std::set<uint32_t> prefixes;
+    for (size_t i = 0; i < numCursors; ++i) {
+        cursorIds.push_back(
+            assertGet(getManager()->registerCursor(_opCtx.get(),
+                                                   allocateMockCursor(),
+                                                   nss,
+                                                   ClusterCursorManager::CursorType::SingleTarget,
+                                                   ClusterCursorManager::CursorLifetime::Mortal,
+                                                   UserNameIterator())));
+        prefixes.insert(static_cast<uint64_t>(cursorIds.back()) >> 32);
+    }
+    ASSERT_GT(prefixes.size(), 1U);
+    ASSERT_EQ(numCursors, getManager()->stats().cursorsSingleTarget);
+
+    for (auto cursorId : cursorIds) {
+        ASSERT_EQ(nss, *getManager()->getNamespaceForCursorId(cursorId));
+        auto pinnedCursor =
+            getManager()->checkOutCursor(nss, cursorId, _opCtx.get(), successAuthChecker);
+        ASSERT_OK(pinnedCursor.getStatus());
+        ASSERT_EQ(cursorId, pinnedCursor.getValue().getCursorId());
+        pinnedCursor.getValue().returnCursor(ClusterCursorManager::CursorState::NotExhausted);
+    }
+
+    ASSERT_OK(getManager()->killCursor(_opCtx.get(), nss, cursorIds.front()));
+    ASSERT(isMockCursorKilled(0));
+    ASSERT_EQ(numCursors - 1, getManager()->stats().cursorsSingleTarget);
+
+    getManager()->killAllCursors(_opCtx.get());
+    for (size_t i = 0; i < numCursors; ++i) {
+        ASSERT(isMockCursorKilled(i));
+    }
+    ASSERT_EQ(0U, getManager()->stats().cursorsSingleTarget);
+}
+
 // Test that a new ClusterCursorManager's stats() is initially zero for the cursor counts.
 TEST_F(ClusterCursorManagerTest, StatsInitAsZero) {
     ASSERT_EQ(0U, getManager()->stats().cursorsMultiTarget);
@@ -318,5 +318,121 @@ TEST_F(RoutingTableHistoryTestThreeInitialChunks,
                               expectedBytesInChunksNotSplit);
 }
 
+/**
+ * Makes a routing table with 'numChunks' chunks [MinKey, 0), [0, 10), ..., [.., MaxKey), assigned
+ * alternately to shard0 and shard1. It is large enough to span several buckets of the chunk map.
+ */
+std::shared_ptr<RoutingTableHistory> makeLargeRoutingTable(int numChunks) {
+    const KeyPattern shardKeyPattern(BSON("a" << 1));
+    const OID epoch = OID::gen();
+    ChunkVersion version{1, 0, epoch};
+
+    std::vector<ChunkType> chunks;
+    for (int i = 0; i < numChunks; ++i) {
+        const auto min = (i == 0) ? shardKeyPattern.globalMin() : BSON("a" << (i - 1) * 10);
+        const auto max = (i == numChunks - 1) ? shardKeyPattern.globalMax() : BSON("a" << i * 10);
+        chunks.emplace_back(
+            kNss, ChunkRange{min, max}, version, ShardId(str::stream() << "shard" << i % 2));
+        version.incMinor();
+    }
+
+    return RoutingTableHistory::makeNew(
+        kNss, UUID::gen(), shardKeyPattern, nullptr, false, epoch, chunks);
+}
+
+void assertChunkMapIsContiguous(const std::shared_ptr<RoutingTableHistory>& rt) {
+    boost::optional<BSONObj> lastMax;
+    size_t numChunks = 0;
+    for (const auto& kv : rt->getChunkMap()) {
+        if (lastMax) {
+            ASSERT_BSONOBJ_EQ(*lastMax, kv.second->getMin());
+        }
+        lastMax = kv.second->getMax();
+        ++numChunks;
+    }
+    ASSERT_EQ(numChunks, rt->getChunkMap().size());
+}
+
+TEST(RoutingTableHistoryLargeTest, ChunkMapSpanningManyBucketsIsOrderedAndSearchable) {
+    const int numChunks = 10 * ChunkInfoMap::kMaxBucketSize;
+    auto rt = makeLargeRoutingTable(numChunks);
+
+    ASSERT_EQ(rt->getChunkMap().size(), size_t(numChunks));
+    assertChunkMapIsContiguous(rt);
+
+    for (int i = 0; i < numChunks - 1; ++i) {
+        auto range = rt->overlappingRanges(BSON("a" << i * 10), BSON("a" << i * 10 + 5), false);
+        ASSERT(range.first != rt->getChunkMap().end());
+        ASSERT_EQ(std::distance(range.first, range.second), 1);
+        ASSERT_BSONOBJ_EQ(range.first->second->getMin(), BSON("a" << i * 10));
+    }
+
+    // Walking backwards crosses the same bucket boundaries
+    size_t numVisited = 0;
+    for (auto it = rt->getChunkMap().end(); it != rt->getChunkMap().begin(); --it) {
+        ++numVisited;
+    }
+    ASSERT_EQ(numVisited, size_t(numChunks));
+
+    ASSERT_EQ(rt->getNShardsOwningChunks(), 2);
+    ASSERT_EQ(rt->getVersion(ShardId("shard0")).minorVersion(), unsigned(numChunks - 2));
+    ASSERT_EQ(rt->getVersion(ShardId("shard1")).minorVersion(), unsigned(numChunks - 1));
+}
+
+TEST(RoutingTableHistoryLargeTest, IncrementalUpdatesLeaveOlderTablesUnchanged) {
+    const int numChunks = 4 * ChunkInfoMap::kMaxBucketSize;
+    auto rt = makeLargeRoutingTable(numChunks);
+
+    // Split a chunk in the middle of the key space
+    auto version = rt->getVersion();
+    version.incMajor();
+    const int mid = numChunks / 2;
+    std::vector<ChunkType> split{
+        {kNss, ChunkRange{BSON("a" << mid * 10), BSON("a" << mid * 10 + 5)}, version, {"shard1"}}};
+    version.incMinor();
+    split.emplace_back(kNss,
+                       ChunkRange{BSON("a" << mid * 10 + 5), BSON("a" << (mid + 1) * 10)},
+                       version,
+                       ShardId("shard1"));
+    auto splitRt = rt->makeUpdated(split);
+
+    ASSERT_EQ(rt->getChunkMap().size(), size_t(numChunks));
+    assertChunkMapIsContiguous(rt);
+    ASSERT_EQ(splitRt->getChunkMap().size(), size_t(numChunks + 1));
+    assertChunkMapIsContiguous(splitRt);
+    ASSERT_EQ(splitRt->getVersion(ShardId("shard1")), version);
+
+    // Move all of the chunks of shard0 to a new shard, which leaves shard0 without chunks
+    std::vector<ChunkType> moves;
+    for (const auto& kv : splitRt->getChunkMap()) {
+        if (kv.second->getShardIdAt(boost::none) == ShardId("shard0")) {
+            version.incMajor();
+            moves.emplace_back(kNss, kv.second->getRange(), version, ShardId("shard2"));
+        }
+    }
+    auto movedRt = splitRt->makeUpdated(moves);
+
+    ASSERT_EQ(movedRt->getChunkMap().size(), size_t(numChunks + 1));
+    assertChunkMapIsContiguous(movedRt);
+    ASSERT_EQ(movedRt->getNShardsOwningChunks(), 2);
+    ASSERT_EQ(movedRt->getVersion(ShardId("shard0")).majorVersion(), 0U);
+    ASSERT_EQ(movedRt->getVersion(ShardId("shard2")), version);
+    ASSERT_EQ(splitRt->getNShardsOwningChunks(), 2);
+    ASSERT_EQ(splitRt->getVersion(ShardId("shard2")).majorVersion(), 0U);
+}
+
+TEST(RoutingTableHistoryLargeTest, IncrementalUpdateLeavingAGapIsRejected) {
+    const int numChunks = 2 * ChunkInfoMap::kMaxBucketSize;
+    auto rt = makeLargeRoutingTable(numChunks);
+
+    // Replaces [100, 110) by [100, 105) only
+    auto version = rt->getVersion();
+    version.incMajor();
+    ASSERT_THROWS_CODE(
+        rt->makeUpdated({{kNss, ChunkRange{BSON("a" << 100), BSON("a" << 105)}, version, {"0"}}}),
+        DBException,
+        ErrorCodes::ConflictingOperationInProgress);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -31,6 +31,7 @@
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/commands/server_status.h"
+#include "mongo/s/async_requests_sender.h"
 #include "mongo/s/balancer_configuration.h"
 #include "mongo/s/catalog_cache.h"
 #include "mongo/s/client/hedging_metrics.h"
@@ -88,6 +89,11 @@ public:
 
         numHostsTargetedMetrics.appendSection(&result);
         catalogCache->report(&result);
+
+        BSONObjBuilder asyncRequestsSenderBuilder(result.subobjStart("asyncRequestsSender"));
+        AsyncRequestsSender::reportStats(&asyncRequestsSenderBuilder);
+        asyncRequestsSenderBuilder.doneFast();
+
         return result.obj();
     }
 
@@ -174,8 +174,8 @@ bool isCommitResultUnknown(const Status& commitStatus, const Status& commitWCSta
     return false;
 }
 
-BSONObj sendCommitDirectlyToShards(OperationContext* opCtx, const std::vector<ShardId>& shardIds) {
-    // Assemble requests.
+std::vector<AsyncRequestsSender::Request> makeCommitRequests(
+    OperationContext* opCtx, const std::vector<ShardId>& shardIds) {
     std::vector<AsyncRequestsSender::Request> requests;
     for (const auto& shardId : shardIds) {
         CommitTransaction commitCmd;
@@ -184,13 +184,16 @@ BSONObj sendCommitDirectlyToShards(OperationContext* opCtx, const std::vector<Sh
             BSON(WriteConcernOptions::kWriteConcernField << opCtx->getWriteConcern().toBSON()));
         requests.emplace_back(shardId, commitCmdObj);
     }
+    return requests;
+}
 
+BSONObj sendCommitDirectlyToShards(OperationContext* opCtx, const std::vector<ShardId>& shardIds) {
     // Send the requests.
     MultiStatementTransactionRequestsSender ars(
         opCtx,
         Grid::get(opCtx)->getExecutorPool()->getFixedExecutor(),
         NamespaceString::kAdminDb,
-        requests,
+        makeCommitRequests(opCtx, shardIds),
         ReadPreferenceSetting{ReadPreference::PrimaryOnly},
         Shard::RetryPolicy::kIdempotent);
 
@@ -221,6 +224,37 @@ BSONObj sendCommitDirectlyToShards(OperationContext* opCtx, const std::vector<Sh
     return lastResult;
 }
 
+/**
+ * Sends commit to the read-only shards together with the single write shard and returns the
+ * response of the write shard. Only for write concerns which do not wait for majority: their
+ * commit on a read-only shard does not confirm anything about the data that was read, so its
+ * outcome cannot change the outcome of the transaction.
+ */
+BSONObj sendCommitToWriteShardAlongsideReadOnlyShards(OperationContext* opCtx,
+                                                      const ShardId& writeShard,
+                                                      std::vector<ShardId> readOnlyShards) {
+    readOnlyShards.push_back(writeShard);
+    MultiStatementTransactionRequestsSender ars(
+        opCtx,
+        Grid::get(opCtx)->getExecutorPool()->getFixedExecutor(),
+        NamespaceString::kAdminDb,
+        makeCommitRequests(opCtx, readOnlyShards),
+        ReadPreferenceSetting{ReadPreference::PrimaryOnly},
+        Shard::RetryPolicy::kIdempotent);
+
+    boost::optional<BSONObj> writeShardResult;
+    while (!ars.done()) {
+        auto response = ars.next();
+        if (response.shardId == writeShard) {
+            uassertStatusOK(response.swResponse);
+            writeShardResult = response.swResponse.getValue().data;
+        }
+    }
+
+    invariant(writeShardResult);
+    return *writeShardResult;
+}
+
 // Helper to convert the CommitType enum into a human readable string for diagnostics.
 std::string commitTypeToString(TransactionRouter::CommitType state) {
     switch (state) {
@@ -1125,6 +1159,13 @@ BSONObj TransactionRouter::Router::_commitTransaction(
             _onStartCommit(lk, opCtx);
         }
 
+        // Without a majority write concern, there is nothing for the read-only shards to confirm
+        // before the write shard can commit, so all of them are sent commit at once.
+        if (opCtx->getWriteConcern().wMode != WriteConcernOptions::kMajority) {
+            return sendCommitToWriteShardAlongsideReadOnlyShards(
+                opCtx, writeShards.front(), std::move(readOnlyShards));
+        }
+
         const auto readOnlyShardsResponse = sendCommitDirectlyToShards(opCtx, readOnlyShards);
 
         if (!getStatusFromCommandResult(readOnlyShardsResponse).isOK() ||
@@ -1058,6 +1058,86 @@ TEST_F(TransactionRouterTestWithDefaultSession,
     future.default_timed_get();
 }
 
+TEST_F(TransactionRouterTestWithDefaultSession,
+       SingleWriteShardCommitIgnoresReadOnlyShardErrorsWithoutMajorityWriteConcern) {
+    TxnNumber txnNum{3};
+
+    auto txnRouter = TransactionRouter::get(operationContext());
+    txnRouter.beginOrContinueTxn(
+        operationContext(), txnNum, TransactionRouter::TransactionActions::kStart);
+    txnRouter.setDefaultAtClusterTime(operationContext());
+
+    txnRouter.attachTxnFieldsIfNeeded(operationContext(), shard1, {});
+    txnRouter.attachTxnFieldsIfNeeded(operationContext(), shard2, {});
+    txnRouter.processParticipantResponse(operationContext(), shard1, kOkReadOnlyTrueResponse);
+    txnRouter.processParticipantResponse(operationContext(), shard2, kOkReadOnlyFalseResponse);
+
+    txnRouter.beginOrContinueTxn(
+        operationContext(), txnNum, TransactionRouter::TransactionActions::kCommit);
+
+    TxnRecoveryToken recoveryToken;
+    recoveryToken.setRecoveryShardId(shard1);
+
+    auto future = launchAsync([&] {
+        auto commitResult = txnRouter.commitTransaction(operationContext(), recoveryToken);
+        ASSERT_OK(getStatusFromCommandResult(commitResult));
+    });
+
+    // Both shards are sent commit before either of them responds.
+    onCommands({[&](const RemoteCommandRequest& request) {
+                    ASSERT_EQ(hostAndPort1, request.target);
+                    ASSERT_EQ(request.cmdObj.firstElement().fieldNameStringData(),
+                              "commitTransaction");
+                    return kNoSuchTransactionResponse;
+                },
+                [&](const RemoteCommandRequest& request) {
+                    ASSERT_EQ(hostAndPort2, request.target);
+                    ASSERT_EQ(request.cmdObj.firstElement().fieldNameStringData(),
+                              "commitTransaction");
+                    return BSON("ok" << 1);
+                }});
+
+    future.default_timed_get();
+}
+
+TEST_F(TransactionRouterTestWithDefaultSession,
+       SingleWriteShardCommitStopsOnReadOnlyShardErrorWithMajorityWriteConcern) {
+    TxnNumber txnNum{3};
+
+    auto opCtx = operationContext();
+    WriteConcernOptions writeConcern(
+        WriteConcernOptions::kMajority, WriteConcernOptions::SyncMode::UNSET, 0);
+    opCtx->setWriteConcern(writeConcern);
+
+    auto txnRouter = TransactionRouter::get(opCtx);
+    txnRouter.beginOrContinueTxn(opCtx, txnNum, TransactionRouter::TransactionActions::kStart);
+    txnRouter.setDefaultAtClusterTime(opCtx);
+
+    txnRouter.attachTxnFieldsIfNeeded(opCtx, shard1, {});
+    txnRouter.attachTxnFieldsIfNeeded(opCtx, shard2, {});
+    txnRouter.processParticipantResponse(opCtx, shard1, kOkReadOnlyTrueResponse);
+    txnRouter.processParticipantResponse(opCtx, shard2, kOkReadOnlyFalseResponse);
+
+    txnRouter.beginOrContinueTxn(opCtx, txnNum, TransactionRouter::TransactionActions::kCommit);
+
+    TxnRecoveryToken recoveryToken;
+    recoveryToken.setRecoveryShardId(shard1);
+
+    auto future = launchAsync([&] {
+        auto commitResult = txnRouter.commitTransaction(operationContext(), recoveryToken);
+        ASSERT_EQ(ErrorCodes::NoSuchTransaction, getStatusFromCommandResult(commitResult));
+    });
+
+    // The write shard is not sent commit once a read-only shard fails to commit.
+    onCommand([&](const RemoteCommandRequest& request) {
+        ASSERT_EQ(hostAndPort1, request.target);
+        ASSERT_EQ(request.cmdObj.firstElement().fieldNameStringData(), "commitTransaction");
+        return kNoSuchTransactionResponse;
+    });
+
+    future.default_timed_get();
+}
+
 TEST_F(TransactionRouterTestWithDefaultSession,
        SendCoordinateCommitForMultipleParticipantsMoreThanOneDidAWrite) {
     TxnNumber txnNum{3};
@@ -68,6 +68,11 @@ struct WriteErrorDetailComp {
 const int kEstUpdateOverheadBytes = (BSONObjMaxInternalSize - BSONObjMaxUserSize) / 100;
 const int kEstDeleteOverheadBytes = (BSONObjMaxInternalSize - BSONObjMaxUserSize) / 100;
 
+// Inserts are targeted in bulk this many documents at a time. Ordered batches and batches which
+// grow too large stop targeting early, so this also bounds how many documents may be targeted
+// again by the next call to targetBatch.
+const size_t kInsertTargetingWindow = 1000;
+
 /**
  * Returns a new write concern that has the copy of every field from the original
  * document but with a w set to 1. This is intended for upgrading { w: 0 } write
@@ -266,7 +271,9 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
     //
     // Targeting of unordered batches is fairly simple - each remaining write op is targeted,
     // and each of those targeted writes are grouped into a batch for a particular shard
-    // endpoint.
+    // endpoint. A write which would make its shard's batch too big is left for the next round,
+    // but targeting carries on with the writes for the other shards, so that one shard receiving
+    // most of the writes does not hold the others to a share of each round.
     //
     // Targeting of ordered batches is a bit more complex - to respect the ordering of the
     // batch, we can only send:
@@ -305,6 +312,12 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
 
+    // Bulk targeting results for the ready inserts among the ops [windowBegin, windowEnd)
+    const bool isInsert = _clientRequest.getBatchType() == BatchedCommandRequest::BatchType_Insert;
+    size_t windowBegin = 0;
+    size_t windowEnd = 0;
+    std::vector<boost::optional<StatusWith<ShardEndpoint>>> windowEndpoints;
+
     for (size_t i = 0; i < numWriteOps; ++i) {
         WriteOp& writeOp = _writeOps[i];
 
@@ -312,6 +325,31 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
         if (writeOp.getWriteState() != WriteOpState_Ready)
             continue;
 
+        boost::optional<StatusWith<ShardEndpoint>> insertEndpoint;
+        if (isInsert) {
+            if (i >= windowEnd) {
+                windowBegin = i;
+                windowEnd = std::min(numWriteOps, i + kInsertTargetingWindow);
+
+                std::vector<BSONObj> docs;
+                std::vector<size_t> offsets;
+                for (size_t j = windowBegin; j < windowEnd; ++j) {
+                    if (_writeOps[j].getWriteState() == WriteOpState_Ready) {
+                        docs.push_back(_writeOps[j].getWriteItem().getDocument());
+                        offsets.push_back(j - windowBegin);
+                    }
+                }
+
+                auto targeted = targeter.targetInserts(_opCtx, docs);
+                windowEndpoints.assign(windowEnd - windowBegin, boost::none);
+                for (size_t k = 0; k < offsets.size(); ++k) {
+                    windowEndpoints[offsets[k]] = std::move(targeted[k]);
+                }
+            }
+
+            insertEndpoint = std::move(windowEndpoints[i - windowBegin]);
+        }
+
         //
         // Get TargetedWrites from the targeter for the write operation
         //
@@ -320,7 +358,8 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
         OwnedPointerVector<TargetedWrite> writesOwned;
         vector<TargetedWrite*>& writes = writesOwned.mutableVector();
 
-        Status targetStatus = writeOp.targetWrites(_opCtx, targeter, &writes);
+        Status targetStatus =
+            writeOp.targetWrites(_opCtx, targeter, &writes, std::move(insertEndpoint));
 
         if (!targetStatus.isOK()) {
             WriteErrorDetail targetError;
@@ -381,7 +420,10 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
         if (wouldMakeBatchesTooBig(writes, writeSizeBytes, batchMap)) {
             invariant(!batchMap.empty());
             writeOp.cancelWrites(nullptr);
-            break;
+            if (ordered) {
+                break;
+            }
+            continue;
         }
 
         if (!ordered && !batchMap.empty() &&
@@ -1542,6 +1542,65 @@ TEST_F(BatchWriteOpLimitTests, OneBigOneSmall) {
     ASSERT(batchOp.isFinished());
 }
 
+// Unordered inserts, where the first shard's writes do not fit in one batch - the second shard's
+// writes should all go in the first round regardless
+TEST_F(BatchWriteOpLimitTests, UnorderedFullBatchDoesNotHoldBackOtherShards) {
+    NamespaceString nss("foo.bar");
+    ShardEndpoint endpointA(ShardId("shardA"), ChunkVersion::IGNORED());
+    ShardEndpoint endpointB(ShardId("shardB"), ChunkVersion::IGNORED());
+
+    auto targeter = initTargeterSplitRange(nss, endpointA, endpointB);
+
+    // Two of these do not fit in one batch
+    const std::string bigString(BSONObjMaxUserSize / 2 + 1, 'x');
+
+    BatchedCommandRequest request([&] {
+        write_ops::Insert insertOp(nss);
+        insertOp.setWriteCommandBase([] {
+            write_ops::WriteCommandBase wcb;
+            wcb.setOrdered(false);
+            return wcb;
+        }());
+        insertOp.setDocuments({BSON("x" << -1 << "data" << bigString),
+                               BSON("x" << -2 << "data" << bigString),
+                               BSON("x" << 1),
+                               BSON("x" << 2)});
+        return insertOp;
+    }());
+
+    BatchWriteOp batchOp(operationContext(), request);
+
+    OwnedPointerMap<ShardId, TargetedWriteBatch> targetedOwned;
+    std::map<ShardId, TargetedWriteBatch*>& targeted = targetedOwned.mutableMap();
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+    ASSERT_EQUALS(targeted.size(), 2u);
+    ASSERT_EQUALS(targeted[endpointA.shardName]->getWrites().size(), 1u);
+    ASSERT_EQUALS(targeted[endpointB.shardName]->getWrites().size(), 2u);
+
+    BatchedCommandResponse response;
+    buildResponse(1, &response);
+    batchOp.noteBatchResponse(*targeted[endpointA.shardName], response, nullptr);
+
+    buildResponse(2, &response);
+    batchOp.noteBatchResponse(*targeted[endpointB.shardName], response, nullptr);
+    ASSERT(!batchOp.isFinished());
+
+    targetedOwned.clear();
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+    ASSERT_EQUALS(targeted.size(), 1u);
+    ASSERT_EQUALS(targeted.begin()->first, endpointA.shardName);
+    ASSERT_EQUALS(targeted.begin()->second->getWrites().size(), 1u);
+
+    buildResponse(1, &response);
+    batchOp.noteBatchResponse(*targeted.begin()->second, response, nullptr);
+    ASSERT(batchOp.isFinished());
+
+    BatchedCommandResponse clientResponse;
+    batchOp.buildClientResponse(&clientResponse);
+    ASSERT(clientResponse.getOk());
+    ASSERT_EQUALS(clientResponse.getN(), 4);
+}
+
 class BatchWriteOpTransactionTest : public ShardingTestFixture {
 public:
     const TxnNumber kTxnNumber = 5;
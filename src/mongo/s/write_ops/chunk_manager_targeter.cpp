@@ -416,6 +416,65 @@ StatusWith<ShardEndpoint> ChunkManagerTargeter::targetInsert(OperationContext* o
     return Status::OK();
 }
 
+std::vector<boost::optional<StatusWith<ShardEndpoint>>> ChunkManagerTargeter::targetInserts(
+    OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+    std::vector<boost::optional<StatusWith<ShardEndpoint>>> endpoints(docs.size());
+
+    // Inserts into unsharded collections all go to the primary, there is nothing to share
+    if (!_routingInfo->cm())
+        return endpoints;
+
+    const auto& cm = *_routingInfo->cm();
+
+    std::vector<BSONObj> shardKeys;
+    std::vector<size_t> docIndexes;
+    shardKeys.reserve(docs.size());
+    docIndexes.reserve(docs.size());
+    for (size_t i = 0; i < docs.size(); ++i) {
+        auto shardKey = cm.getShardKeyPattern().extractShardKeyFromDoc(docs[i]);
+        if (shardKey.isEmpty())
+            continue;
+
+        shardKeys.push_back(std::move(shardKey));
+        docIndexes.push_back(i);
+    }
+
+    const auto shardIds = cm.getShardIdsForShardKeys(shardKeys);
+
+    std::map<ShardId, StatusWith<ChunkVersion>> shardVersions;
+    for (size_t i = 0; i < shardIds.size(); ++i) {
+        auto& endpoint = endpoints[docIndexes[i]];
+
+        if (!shardIds[i].isOK()) {
+            endpoint.emplace(shardIds[i].getStatus());
+            continue;
+        }
+
+        const auto& shardId = shardIds[i].getValue();
+        auto versionIt = shardVersions.find(shardId);
+        if (versionIt == shardVersions.end()) {
+            versionIt = shardVersions
+                            .emplace(shardId,
+                                     [&]() -> StatusWith<ChunkVersion> {
+                                         try {
+                                             return cm.getVersion(shardId);
+                                         } catch (const DBException& ex) {
+                                             return ex.toStatus();
+                                         }
+                                     }())
+                            .first;
+        }
+
+        if (!versionIt->second.isOK()) {
+            endpoint.emplace(versionIt->second.getStatus());
+        } else {
+            endpoint.emplace(ShardEndpoint(shardId, versionIt->second.getValue()));
+        }
+    }
+
+    return endpoints;
+}
+
 StatusWith<std::vector<ShardEndpoint>> ChunkManagerTargeter::targetUpdate(
     OperationContext* opCtx, const write_ops::UpdateOpEntry& updateDoc) const {
     // If the update is replacement-style:
@@ -82,6 +82,11 @@ public:
     StatusWith<ShardEndpoint> targetInsert(OperationContext* opCtx,
                                            const BSONObj& doc) const override;
 
+    // Looks up the chunks of all the documents' shard keys in one sorted pass, and each targeted
+    // shard's version once. Documents without a valid shard key are left to targetInsert.
+    std::vector<boost::optional<StatusWith<ShardEndpoint>>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const override;
+
     // Returns ShardKeyNotFound if the update can't be targeted without a shard key.
     StatusWith<std::vector<ShardEndpoint>> targetUpdate(
         OperationContext* opCtx, const write_ops::UpdateOpEntry& updateDoc) const override;
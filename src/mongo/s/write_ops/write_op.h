@@ -116,12 +116,16 @@ public:
      * The ShardTargeter determines the ShardEndpoints to send child writes to, but is not
      * modified by this operation.
      *
+     * For inserts, 'insertEndpoint' may carry the result of already targeting the document with
+     * NSTargeter::targetInserts(), in which case it is used instead of calling targetInsert().
+     *
      * Returns !OK if the targeting process itself fails
      *             (no TargetedWrites will be added, state unchanged)
      */
     Status targetWrites(OperationContext* opCtx,
                         const NSTargeter& targeter,
-                        std::vector<TargetedWrite*>* targetedWrites);
+                        std::vector<TargetedWrite*>* targetedWrites,
+                        boost::optional<StatusWith<ShardEndpoint>> insertEndpoint = boost::none);
 
     /**
      * Returns the number of child writes that were last targeted.
@@ -542,6 +542,36 @@ TEST_F(ChunkManagerTargeterTest, TargetInsertWithRangePrefixHashedShardKey) {
                        ErrorCodes::ShardKeyNotFound);
 }
 
+TEST_F(ChunkManagerTargeterTest, TargetInsertsInBulkAgreesWithTargetInsert) {
+    std::vector<BSONObj> splitPoints = {
+        BSON("a" << BSONNULL), BSON("a" << -100), BSON("a" << 0), BSON("a" << 100)};
+    auto cmTargeter = prepare(BSON("a" << 1), splitPoints);
+
+    // Unsorted keys, several of which fall into the same chunk, plus a document (with an array
+    // shard key) which must be left to targetInsert
+    std::vector<BSONObj> docs;
+    for (int i : {500, -150, 3, -3, 99, -101, 100, 7, -1000, 0}) {
+        docs.push_back(BSON("a" << i));
+    }
+    docs.push_back(BSONObj());
+    docs.push_back(fromjson("{a: [1, 2]}"));
+
+    const auto endpoints = cmTargeter.targetInserts(operationContext(), docs);
+    ASSERT_EQ(endpoints.size(), docs.size());
+
+    for (size_t i = 0; i < docs.size() - 1; ++i) {
+        ASSERT(endpoints[i]);
+        ASSERT_OK(endpoints[i]->getStatus());
+
+        const auto expected = cmTargeter.targetInsert(operationContext(), docs[i]);
+        ASSERT_OK(expected.getStatus());
+        ASSERT_EQ(endpoints[i]->getValue().shardName, expected.getValue().shardName);
+        ASSERT_EQ(endpoints[i]->getValue().shardVersion, expected.getValue().shardVersion);
+    }
+
+    ASSERT_FALSE(endpoints.back());
+}
+
 TEST_F(ChunkManagerTargeterTest, TargetInsertsWithVaryingHashedPrefixAndConstantRangedSuffix) {
     // Create 4 chunks and 4 shards such that shardId '0' has chunk [MinKey, -2^62), '1' has chunk
     // [-2^62, 0), '2' has chunk ['0', 2^62) and '3' has chunk [2^62, MaxKey).
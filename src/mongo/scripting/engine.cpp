@@ -291,13 +291,15 @@ ScriptingFunction Scope::createFunction(const char* code) {
         }
     }
 
-    FunctionCacheMap::iterator i = _cachedFunctions.find(code);
+    // Callers such as $function and $where look their function up once per document, so look it up
+    // by StringData rather than building a std::string key from 'code' each time.
+    FunctionCacheMap::iterator i = _cachedFunctions.find(StringData(code));
     if (i != _cachedFunctions.end())
         return i->second;
 
     // Get a function number, so the cache can be utilized to lookup the source on an exception
     ScriptingFunction functionNumber = _createFunction(code);
-    _cachedFunctions[code] = functionNumber;
+    _cachedFunctions.emplace(code, functionNumber);
     return functionNumber;
 }
 
@@ -33,11 +33,12 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 typedef unsigned long long ScriptingFunction;
 typedef BSONObj (*NativeFunction)(const BSONObj& args, void* data);
-typedef std::map<std::string, ScriptingFunction> FunctionCacheMap;
+typedef StringMap<ScriptingFunction> FunctionCacheMap;
 
 class DBClientBase;
 class OperationContext;
@@ -29,11 +29,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <map>
 #include <memory>
 #include <vector>
 
-#include <poll.h>
+#include <sys/epoll.h>
 #include <sys/eventfd.h>
 
 #include "mongo/base/checked_cast.h"
@@ -53,14 +55,24 @@ namespace transport {
 /**
  * TransportLayerASIO Baton implementation for linux.
  *
- * We implement our networking reactor on top of poll + eventfd for wakeups
+ * We implement our networking reactor on top of epoll + eventfd for wakeups. The epoll set belongs
+ * to the client and persists across waits, so waiting on many sessions (as in wide scatter-gather
+ * from mongos) costs one epoll_ctl per armed session rather than rebuilding and scanning a full
+ * pollset on every call to run.
  */
 class TransportLayerASIO::BatonASIO : public NetworkingBaton {
     static const inline auto kDetached = Status(ErrorCodes::ShutdownInProgress, "Baton detached");
 
+    // The epoll data of the client's eventfd. Sessions are registered with their id, which is
+    // never this large.
+    static constexpr uint64_t kEventFDKey = std::numeric_limits<uint64_t>::max();
+
+    // The smallest event buffer we hand to ::epoll_wait.
+    static constexpr size_t kMinEventsPerWait = 16;
+
     /**
      * We use this internal reactor timer to exit run_until calls (by forcing an early timeout for
-     * ::poll).
+     * ::epoll_wait).
      *
      * Its methods are all unreachable because we never actually use its timer-ness (we just need
      * its address for baton book keeping).
@@ -79,22 +91,37 @@ class TransportLayerASIO::BatonASIO : public NetworkingBaton {
     /**
      * RAII type that wraps up an eventfd and reading/writing to it.  We don't actually need the
      * counter portion, just the notify/wakeup
+     *
+     * It also owns the epoll set the baton waits on.  The eventfd is registered in it once, level
+     * triggered, and is identified by kEventFDKey.
      */
     struct EventFDHolder {
-        EventFDHolder() : fd(::eventfd(0, EFD_CLOEXEC)) {
+        EventFDHolder() : fd(::eventfd(0, EFD_CLOEXEC)), epfd(::epoll_create1(EPOLL_CLOEXEC)) {
             if (fd < 0) {
-                auto e = errno;
-                std::string reason = str::stream()
-                    << "error in creating eventfd: " << errnoWithDescription(e);
+                _failCreate("eventfd");
+            }
 
-                auto code = (e == EMFILE || e == ENFILE) ? ErrorCodes::TooManyFilesOpen
-                                                         : ErrorCodes::UnknownError;
+            if (epfd < 0) {
+                auto e = errno;
+                ::close(fd);
+                errno = e;
+                _failCreate("epoll set");
+            }
 
-                uasserted(code, reason);
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.u64 = kEventFDKey;
+            if (::epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &event) != 0) {
+                auto e = errno;
+                ::close(epfd);
+                ::close(fd);
+                errno = e;
+                _failCreate("eventfd registration");
             }
         }
 
         ~EventFDHolder() {
+            ::close(epfd);
             ::close(fd);
         }
 
@@ -125,8 +152,21 @@ class TransportLayerASIO::BatonASIO : public NetworkingBaton {
         }
 
         const int fd;
+        const int epfd;
 
         static const Client::Decoration<EventFDHolder> getForClient;
+
+    private:
+        [[noreturn]] static void _failCreate(StringData what) {
+            auto e = errno;
+            std::string reason = str::stream()
+                << "error in creating " << what << ": " << errnoWithDescription(e);
+
+            auto code = (e == EMFILE || e == ENFILE) ? ErrorCodes::TooManyFilesOpen
+                                                     : ErrorCodes::UnknownError;
+
+            uasserted(code, reason);
+        }
     };
 
 public:
@@ -141,18 +181,19 @@ public:
 
     void markKillOnClientDisconnect() noexcept override {
         if (_opCtx->getClient() && _opCtx->getClient()->session()) {
-            addSessionImpl(*(_opCtx->getClient()->session()), POLLRDHUP).getAsync([this](Status s) {
-                if (!s.isOK()) {
-                    return;
-                }
-
-                _opCtx->markKilled(ErrorCodes::ClientDisconnect);
-            });
+            addSessionImpl(*(_opCtx->getClient()->session()), EPOLLRDHUP)
+                .getAsync([this](Status s) {
+                    if (!s.isOK()) {
+                        return;
+                    }
+
+                    _opCtx->markKilled(ErrorCodes::ClientDisconnect);
+                });
         }
     }
 
     Future<void> addSession(Session& session, Type type) noexcept override {
-        return addSessionImpl(session, type == Type::In ? POLLIN : POLLOUT);
+        return addSessionImpl(session, type == Type::In ? EPOLLIN : EPOLLOUT);
     }
 
     Future<void> waitUntil(const ReactorTimer& timer, Date_t expiration) noexcept override {
@@ -181,11 +222,15 @@ public:
 
         stdx::unique_lock<Latch> lk(_mutex);
 
-        if (_sessions.find(id) == _sessions.end()) {
+        auto iter = _sessions.find(id);
+        if (iter == _sessions.end()) {
             return false;
         }
 
-        _safeExecute(std::move(lk), [id, this] { _sessions.erase(id); });
+        // The epoll set is never iterated, so there is no need to defer this to the reactor.
+        // Disarming (rather than removing) the fd keeps its registration for the next wait.
+        _disarm(iter->second.fd);
+        _sessions.erase(iter);
 
         return true;
     }
@@ -291,17 +336,9 @@ public:
             deadline = _timers.begin()->first;
         }
 
-        _pollSessions.clear();
-        _pollSet.clear();
-        _pollSessions.reserve(_sessions.size());
-        _pollSet.reserve(_sessions.size() + 1);
-
-        _pollSet.push_back(pollfd{efd().fd, POLLIN, 0});
-
-        for (auto iter = _sessions.begin(); iter != _sessions.end(); ++iter) {
-            _pollSet.push_back(pollfd{iter->second.fd, iter->second.type, 0});
-            _pollSessions.push_back(iter);
-        }
+        // Sessions are armed in the epoll set as they are added, so all we have to do here is size
+        // the event buffer.  Anything that doesn't fit stays queued for the next wait.
+        _events.resize(std::max<size_t>(_sessions.size() + 1, kMinEventsPerWait));
 
         auto now = clkSource->now();
 
@@ -317,19 +354,20 @@ public:
 
             _inPoll = true;
             lk.unlock();
-            rval = ::poll(_pollSet.data(),
-                          _pollSet.size(),
-                          deadline ? Milliseconds(*deadline - now).count() : -1);
+            rval = ::epoll_wait(efd().epfd,
+                                _events.data(),
+                                _events.size(),
+                                deadline ? Milliseconds(*deadline - now).count() : -1);
 
             const auto pollGuard = makeGuard([&] {
                 lk.lock();
                 _inPoll = false;
             });
 
-            // If poll failed, it better be in EINTR
+            // If epoll_wait failed, it better be in EINTR
             if (rval < 0 && errno != EINTR) {
                 LOGV2_FATAL(23921,
-                            "error in poll: {errnoWithDescription_errno}",
+                            "error in epoll_wait: {errnoWithDescription_errno}",
                             "errnoWithDescription_errno"_attr = errnoWithDescription(errno));
                 fassertFailed(50834);
             }
@@ -344,39 +382,30 @@ public:
             iter = _timers.erase(iter);
         }
 
-        // If poll found some activity
-        if (rval > 0) {
-            size_t remaining = rval;
+        // Only the ready fds are reported, so this is proportional to the activity rather than to
+        // the number of sessions being waited on.
+        for (int i = 0; i < rval; ++i) {
+            const auto key = _events[i].data.u64;
 
-            auto pollIter = _pollSet.begin();
-
-            if (pollIter->revents) {
+            if (key == kEventFDKey) {
                 efd().wait();
-
-                remaining--;
+                continue;
             }
 
-            ++pollIter;
-
-            for (auto sessionIter = _pollSessions.begin();
-                 sessionIter != _pollSessions.end() && remaining;
-                 ++sessionIter, ++pollIter) {
-                if (pollIter->revents) {
-                    toFulfill.push_back(std::move((*sessionIter)->second.promise));
-                    _sessions.erase(*sessionIter);
-
-                    remaining--;
-                }
+            // Sessions are armed one shot, so a session that was cancelled (or that belonged to an
+            // earlier operation on this client) can report at most one stale event, which we drop.
+            auto iter = _sessions.find(key);
+            if (iter != _sessions.end()) {
+                toFulfill.push_back(std::move(iter->second.promise));
+                _sessions.erase(iter);
             }
-
-            invariant(remaining == 0);
         }
 
         return;
     }
 
 private:
-    Future<void> addSessionImpl(Session& session, short type) noexcept {
+    Future<void> addSessionImpl(Session& session, uint32_t type) noexcept {
         auto fd = checked_cast<ASIOSession&>(session).getSocket().native_handle();
         auto id = session.id();
         auto pf = makePromiseFuture<void>();
@@ -387,14 +416,49 @@ private:
             return kDetached;
         }
 
-        _safeExecute(std::move(lk),
-                     [id, fd, type, promise = std::move(pf.promise), this]() mutable {
-                         _sessions[id] = TransportSession{fd, type, std::move(promise)};
-                     });
+        // epoll_ctl is safe to call while another thread is in epoll_wait, so unlike timers new
+        // sessions don't have to wake the reactor.
+        if (!_arm(fd, id, type)) {
+            // The fd can't be waited on (most likely it has been closed). Report it ready, as poll
+            // would with POLLNVAL, and let the subsequent I/O surface the error.
+            return Future<void>::makeReady();
+        }
+
+        _sessions[id] = TransportSession{fd, type, std::move(pf.promise)};
 
         return std::move(pf.future);
     }
 
+    /**
+     * Arms fd in the epoll set for a single, edge triggered event of the given type. Re-arming an
+     * fd that is already registered re-checks its current readiness, so no readiness is lost
+     * between waits. Returns false if the fd can't be added to the set.
+     */
+    bool _arm(int fd, SessionId id, uint32_t type) {
+        epoll_event event{};
+        event.events = type | EPOLLET | EPOLLONESHOT;
+        event.data.u64 = id;
+
+        if (::epoll_ctl(efd().epfd, EPOLL_CTL_MOD, fd, &event) == 0) {
+            return true;
+        }
+
+        if (errno == ENOENT && ::epoll_ctl(efd().epfd, EPOLL_CTL_ADD, fd, &event) == 0) {
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * Stops fd from reporting events without removing it from the epoll set, so that the next wait
+     * on it only needs a single epoll_ctl.
+     */
+    void _disarm(int fd) {
+        epoll_event event{};
+        ::epoll_ctl(efd().epfd, EPOLL_CTL_MOD, fd, &event);
+    }
+
     void detachImpl() noexcept override {
         decltype(_sessions) sessions;
         decltype(_scheduled) scheduled;
@@ -404,6 +468,11 @@ private:
             stdx::lock_guard<Latch> lk(_mutex);
 
             invariant(_opCtx->getBaton().get() == this);
+
+            for (auto& session : _sessions) {
+                _disarm(session.second.fd);
+            }
+
             _opCtx->setBaton(nullptr);
 
             _opCtx = nullptr;
@@ -436,7 +505,7 @@ private:
 
     struct TransportSession {
         int fd;
-        short type;
+        uint32_t type;
         Promise<void> promise;
     };
 
@@ -468,8 +537,7 @@ private:
 
     bool _inPoll = false;
 
-    // This map stores the sessions we need to poll on. We unwind it into a pollset for every
-    // blocking call to run
+    // This map stores the sessions armed in the epoll set, keyed by the id we register them with
     stdx::unordered_map<SessionId, TransportSession> _sessions;
 
     // The set is used to find the next timer which will fire.  The unordered_map looks up the
@@ -480,14 +548,9 @@ private:
     // For tasks that come in via schedule.  Or that were deferred because we were in poll
     std::vector<Task> _scheduled;
 
-    // We hold the two following values at the object level to save on allocations when a baton is
-    // waited on many times over the course of its lifetime.
-
-    // Holds the pollset for ::poll
-    std::vector<pollfd> _pollSet;
-
-    // Mirrors the above pollset with mappings back to _sessions
-    std::vector<decltype(_sessions)::iterator> _pollSessions;
+    // Receives the ready events from ::epoll_wait. We hold it at the object level to save on
+    // allocations when a baton is waited on many times over the course of its lifetime.
+    std::vector<epoll_event> _events;
 };
 
 const Client::Decoration<TransportLayerASIO::BatonASIO::EventFDHolder>
@@ -117,6 +117,45 @@ public:
         return _decompressBytesOut.loadRelaxed();
     }
 
+    /*
+     * This returns the total time spent in compressData, as recorded by counterHitCompressTime
+     */
+    int64_t getCompressorTimeMicros() const {
+        return _compressTimeMicros.loadRelaxed();
+    }
+
+    /*
+     * This returns the total time spent in decompressData, as recorded by
+     * counterHitDecompressTime
+     */
+    int64_t getDecompressorTimeMicros() const {
+        return _decompressTimeMicros.loadRelaxed();
+    }
+
+    /*
+     * This returns the number of messages that were sent uncompressed instead of being compressed
+     * with this compressor, because they were too small or did not compress.
+     */
+    int64_t getCompressorSkipped() const {
+        return _compressSkipped.loadRelaxed();
+    }
+
+    /*
+     * Called by the MessageCompressorManager to account for time spent compressing and
+     * decompressing, and for messages it chose not to compress.
+     */
+    void counterHitCompressTime(int64_t micros) {
+        _compressTimeMicros.addAndFetch(micros);
+    }
+
+    void counterHitDecompressTime(int64_t micros) {
+        _decompressTimeMicros.addAndFetch(micros);
+    }
+
+    void counterHitCompressSkipped() {
+        _compressSkipped.addAndFetch(1);
+    }
+
 
 protected:
     /*
@@ -151,5 +190,9 @@ private:
 
     AtomicWord<long long> _decompressBytesIn;
     AtomicWord<long long> _decompressBytesOut;
+
+    AtomicWord<long long> _compressTimeMicros;
+    AtomicWord<long long> _decompressTimeMicros;
+    AtomicWord<long long> _compressSkipped;
 };
 }  // namespace mongo
@@ -39,8 +39,10 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/message.h"
+#include "mongo/transport/message_compressor_parameters_gen.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/session.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
@@ -101,6 +103,14 @@ StatusWith<Message> MessageCompressorManager::compressMessage(
                 "compressor_getName"_attr = compressor->getName());
 
     auto inputHeader = msg.header();
+
+    // Sending a message uncompressed is always allowed, so don't bother compressing messages that
+    // are too small to benefit.
+    if (msg.dataSize() < static_cast<size_t>(gNetworkMessageCompressionMinBytes.load())) {
+        compressor->counterHitCompressSkipped();
+        return {msg};
+    }
+
     size_t bufferSize = compressor->getMaxCompressedSize(msg.dataSize()) +
         CompressionHeader::size() + MsgData::MsgDataHeaderSize;
 
@@ -128,12 +138,24 @@ StatusWith<Message> MessageCompressorManager::compressMessage(
     compressionHeader.serialize(&output);
     ConstDataRange input(inputHeader.data(), inputHeader.data() + inputHeader.dataLen());
 
+    Timer timer;
     auto sws = compressor->compressData(input, output);
+    compressor->counterHitCompressTime(timer.micros());
 
     if (!sws.isOK())
         return sws.getStatus();
 
     auto realCompressedSize = sws.getValue();
+    if (realCompressedSize > msg.dataSize()) {
+        // The message did not compress, so save the receiver the work of decompressing it.
+        LOGV2_DEBUG(5212013,
+                    3,
+                    "Message did not compress with {compressor}, sending it uncompressed",
+                    "compressor"_attr = compressor->getName());
+        compressor->counterHitCompressSkipped();
+        return {msg};
+    }
+
     outMessage.setLen(realCompressedSize + CompressionHeader::size() + MsgData::MsgDataHeaderSize);
 
     return {Message(outputMessageBuffer)};
@@ -185,7 +207,9 @@ StatusWith<Message> MessageCompressorManager::decompressMessage(const Message& m
 
     DataRangeCursor output(outMessage.data(), outMessage.data() + outMessage.dataLen());
 
+    Timer timer;
     auto sws = compressor->decompressData(input, output);
+    compressor->counterHitDecompressTime(timer.micros());
 
     if (!sws.isOK())
         return sws.getStatus();
@@ -168,7 +168,11 @@ void checkOverflow(std::unique_ptr<MessageCompressorBase> compressor) {
 }
 
 Message buildMessage() {
-    const auto data = std::string{"Hello, world!"};
+    // Large and repetitive enough to be worth compressing.
+    std::string data;
+    for (int i = 0; i < 100; ++i) {
+        data += "Hello, world!";
+    }
     const auto bufferSize = MsgData::MsgDataHeaderSize + data.size();
     auto buf = SharedBuffer::allocate(bufferSize);
     MsgData::View testView(buf.get());
@@ -252,6 +256,69 @@ TEST(ZstdMessageCompressor, Overflow) {
     checkOverflow(std::make_unique<ZstdMessageCompressor>());
 }
 
+MessageCompressorManager makeNegotiatedManager(MessageCompressorRegistry* registry,
+                                               std::unique_ptr<MessageCompressorBase> compressor) {
+    const auto compressorName = compressor->getName();
+    registry->setSupportedCompressors({compressorName});
+    registry->registerImplementation(std::move(compressor));
+    ASSERT_OK(registry->finalizeSupportedCompressors());
+
+    MessageCompressorManager mgr(registry);
+    BSONObjBuilder negotiatorOut;
+    mgr.serverNegotiate(BSON("isMaster" << 1 << "compression" << BSON_ARRAY(compressorName)),
+                        &negotiatorOut);
+    checkNegotiationResult(negotiatorOut.done(), {compressorName});
+    return mgr;
+}
+
+TEST(MessageCompressorManager, SmallMessagesAreNotCompressed) {
+    MessageCompressorRegistry registry;
+    auto mgr = makeNegotiatedManager(&registry, std::make_unique<SnappyMessageCompressor>());
+
+    const auto data = std::string{"Hello, world!"};
+    const auto bufferSize = MsgData::MsgDataHeaderSize + data.size();
+    auto buf = SharedBuffer::allocate(bufferSize);
+    MsgData::View testView(buf.get());
+    testView.setId(123456);
+    testView.setResponseToMsgId(654321);
+    testView.setOperation(dbQuery);
+    testView.setLen(bufferSize);
+    memcpy(testView.data(), data.data(), data.size());
+    Message msg{buf};
+
+    auto compressor = registry.getCompressor("snappy");
+    const auto skippedBefore = compressor->getCompressorSkipped();
+    auto compressed = assertOk(mgr.compressMessage(msg));
+    ASSERT_EQ(compressed.operation(), dbQuery);
+    ASSERT_EQ(compressed.buf(), msg.buf());
+    ASSERT_EQ(compressor->getCompressorSkipped(), skippedBefore + 1);
+}
+
+TEST(MessageCompressorManager, IncompressibleMessagesAreNotCompressed) {
+    MessageCompressorRegistry registry;
+    auto mgr = makeNegotiatedManager(&registry, std::make_unique<SnappyMessageCompressor>());
+
+    // Bytes from a linear congruential generator don't compress.
+    const size_t dataSize = 4096;
+    const auto bufferSize = MsgData::MsgDataHeaderSize + dataSize;
+    auto buf = SharedBuffer::allocate(bufferSize);
+    MsgData::View testView(buf.get());
+    testView.setId(123456);
+    testView.setResponseToMsgId(654321);
+    testView.setOperation(dbQuery);
+    testView.setLen(bufferSize);
+    uint32_t state = 12345;
+    for (size_t i = 0; i < dataSize; ++i) {
+        state = state * 1103515245 + 12345;
+        testView.data()[i] = static_cast<char>(state >> 24);
+    }
+    Message msg{buf};
+
+    auto compressed = assertOk(mgr.compressMessage(msg));
+    ASSERT_EQ(compressed.operation(), dbQuery);
+    ASSERT_EQ(compressed.buf(), msg.buf());
+}
+
 TEST(MessageCompressorManager, SERVER_28008) {
 
     // Create a client and server that will negotiate the same compressors,
@@ -32,15 +32,86 @@
 #include "mongo/platform/basic.h"
 
 #include <memory>
+#include <vector>
 
 #include <zstd.h>
 
 #include "mongo/base/init.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_zstd.h"
 
 namespace mongo {
 
+namespace {
+
+/**
+ * The one-shot ZSTD_compress() and ZSTD_decompress() allocate and initialize a fresh context for
+ * every message, which dominates the cost of compressing the many small messages on a connection.
+ * A context can only be used by one thread at a time, so idle contexts are kept in a small cache
+ * that bounds the memory they hold regardless of the number of connection threads.
+ */
+template <typename Context>
+class ZstdContextCache {
+public:
+    using CreateFn = Context* (*)();
+    using FreeFn = size_t (*)(Context*);
+
+    struct Releaser {
+        void operator()(Context* context) const {
+            cache->_release(context);
+        }
+        ZstdContextCache* cache;
+    };
+    using Handle = std::unique_ptr<Context, Releaser>;
+
+    ZstdContextCache(CreateFn create, FreeFn free) : _create(create), _free(free) {}
+
+    ~ZstdContextCache() {
+        for (auto context : _idle) {
+            _free(context);
+        }
+    }
+
+    // Returns a null handle if a new context could not be allocated.
+    Handle acquire() {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (!_idle.empty()) {
+                Handle context(_idle.back(), Releaser{this});
+                _idle.pop_back();
+                return context;
+            }
+        }
+        return Handle(_create(), Releaser{this});
+    }
+
+private:
+    static constexpr size_t kMaxIdleContexts = 16;
+
+    void _release(Context* context) {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (_idle.size() < kMaxIdleContexts) {
+                _idle.push_back(context);
+                return;
+            }
+        }
+        _free(context);
+    }
+
+    const CreateFn _create;
+    const FreeFn _free;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("ZstdContextCache::_mutex");
+    std::vector<Context*> _idle;
+};
+
+ZstdContextCache<ZSTD_CCtx> compressionContexts(ZSTD_createCCtx, ZSTD_freeCCtx);
+ZstdContextCache<ZSTD_DCtx> decompressionContexts(ZSTD_createDCtx, ZSTD_freeDCtx);
+
+}  // namespace
+
 ZstdMessageCompressor::ZstdMessageCompressor() : MessageCompressorBase(MessageCompressor::kZstd) {}
 
 std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
@@ -49,11 +120,17 @@ std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
 
 StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
                                                             DataRange output) {
-    size_t ret = ZSTD_compress(const_cast<char*>(output.data()),
-                               output.length(),
-                               input.data(),
-                               input.length(),
-                               ZSTD_CLEVEL_DEFAULT);
+    auto cctx = compressionContexts.acquire();
+    if (!cctx) {
+        return Status{ErrorCodes::ExceededMemoryLimit, "Could not allocate zstd context"};
+    }
+
+    size_t ret = ZSTD_compressCCtx(cctx.get(),
+                                   const_cast<char*>(output.data()),
+                                   output.length(),
+                                   input.data(),
+                                   input.length(),
+                                   ZSTD_CLEVEL_DEFAULT);
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -65,8 +142,16 @@ StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input
 
 StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
                                                               DataRange output) {
-    size_t ret = ZSTD_decompress(
-        const_cast<char*>(output.data()), output.length(), input.data(), input.length());
+    auto dctx = decompressionContexts.acquire();
+    if (!dctx) {
+        return Status{ErrorCodes::ExceededMemoryLimit, "Could not allocate zstd context"};
+    }
+
+    size_t ret = ZSTD_decompressDCtx(dctx.get(),
+                                     const_cast<char*>(output.data()),
+                                     output.length(),
+                                     input.data(),
+                                     input.length());
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -60,6 +60,8 @@ constexpr auto kTotalTimeQueuedUs = "totalTimeQueuedMicros"_sd;
 constexpr auto kThreadsInUse = "threadsInUse"_sd;
 constexpr auto kThreadsRunning = "threadsRunning"_sd;
 constexpr auto kThreadsPending = "threadsPending"_sd;
+constexpr auto kTasksQueued = "tasksQueued"_sd;
+constexpr auto kDeferredTasksQueued = "deferredTasksQueued"_sd;
 constexpr auto kExecutorLabel = "executor"_sd;
 constexpr auto kExecutorName = "adaptive"_sd;
 constexpr auto kStuckDetection = "stuckThreadsDetected"_sd;
@@ -121,6 +123,10 @@ struct ServerParameterOptions : public ServiceExecutorAdaptive::Options {
     int recursionLimit() const final {
         return adaptiveServiceExecutorRecursionLimit.load();
     }
+
+    int maxStarvationThreadsPerCheck() const final {
+        return adaptiveServiceExecutorMaxStarvationThreadsPerCheck.load();
+    }
 };
 
 }  // namespace
@@ -248,20 +254,24 @@ Status ServiceExecutorAdaptive::schedule(ServiceExecutorAdaptive::Task task,
 }
 
 bool ServiceExecutorAdaptive::_isStarved() const {
-    // If threads are still starting, then assume we won't be starved pretty soon, return false
+    return _starvationDeficit() > 0;
+}
+
+int ServiceExecutorAdaptive::_starvationDeficit() const {
+    // If threads are still starting, then assume we won't be starved pretty soon, return 0
     if (_threadsPending.load() > 0)
-        return false;
+        return 0;
 
     auto tasksQueued = _tasksQueued.load();
     // If there are no pending tasks, then we definitely aren't starved
     if (tasksQueued == 0)
-        return false;
+        return 0;
 
     // The available threads is the number that are running - the number that are currently
     // executing
     auto available = _threadsRunning.load() - _threadsInUse.load();
 
-    return (tasksQueued > available);
+    return std::max(tasksQueued - available, 0);
 }
 
 /*
@@ -429,11 +439,19 @@ void ServiceExecutorAdaptive::_controllerThreadRoutine() {
                  (sinceLastStuckThreadCheck.sinceStart() < stuckThreadTimeout));
 
         // If the number of pending tasks is greater than the number of running threads minus the
-        // number of tasks executing (the number of free threads), then start a new worker to
-        // avoid starvation.
-        if (_isStarved()) {
-            LOGV2(22956, "Starting worker thread to avoid starvation.");
-            _startWorkerThread(ThreadCreationReason::kStarvation);
+        // number of tasks executing (the number of free threads), then start new workers to
+        // avoid starvation. Starting more than one at a time lets the pool catch up with a burst
+        // of work, such as a storm of reconnecting clients, without waiting out maxQueueLatency()
+        // once per thread.
+        auto deficit = _starvationDeficit();
+        if (deficit > 0) {
+            auto toStart = std::min(deficit, std::max(_config->maxStarvationThreadsPerCheck(), 1));
+            LOGV2(22956,
+                  "Starting {threads} worker thread(s) to avoid starvation.",
+                  "threads"_attr = toStart);
+            for (int i = 0; i < toStart; ++i) {
+                _startWorkerThread(ThreadCreationReason::kStarvation);
+            }
         }
     }
 }
@@ -658,7 +676,9 @@ void ServiceExecutorAdaptive::appendStats(BSONObjBuilder* bob) const {
          << ticksToMicros(_getThreadTimerTotal(ThreadTimer::kExecuting, lk), _tickSource)  //
          << kTotalTimeQueuedUs << ticksToMicros(_totalSpentQueued.load(), _tickSource)     //
          << kThreadsRunning << _threadsRunning.load()                                      //
-         << kThreadsPending << _threadsPending.load();
+         << kThreadsPending << _threadsPending.load()                                      //
+         << kTasksQueued << _tasksQueued.load()                                            //
+         << kDeferredTasksQueued << _deferredTasksQueued.load();
 
     BSONObjBuilder threadStartReasons(bob->subobjStart(kThreadReasons));
     for (size_t i = 0; i < _threadStartCounters.size(); i++) {
@@ -80,6 +80,10 @@ public:
         // The maximum allowable depth of recursion for tasks scheduled with the MayRecurse flag
         // before stack unwinding is forced.
         virtual int recursionLimit() const = 0;
+
+        // The maximum number of threads the controller will start at once when it detects that
+        // the executor is starved.
+        virtual int maxStarvationThreadsPerCheck() const = 0;
     };
 
     explicit ServiceExecutorAdaptive(ServiceContext* ctx, ReactorHandle reactor);
@@ -198,6 +202,7 @@ private:
     void _workerThreadRoutine(int threadId, ThreadList::iterator it);
     void _controllerThreadRoutine();
     bool _isStarved() const;
+    int _starvationDeficit() const;
     Milliseconds _getThreadJitter() const;
 
     void _accumulateTaskMetrics(MetricsArray* outArray, const MetricsArray& inputArray) const;
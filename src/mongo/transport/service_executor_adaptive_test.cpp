@@ -73,6 +73,10 @@ struct TestOptions : public ServiceExecutorAdaptive::Options {
     int recursionLimit() const final {
         return 0;
     }
+
+    int maxStarvationThreadsPerCheck() const final {
+        return 1;
+    }
 };
 
 struct RecursionOptions : public ServiceExecutorAdaptive::Options {
@@ -103,6 +107,10 @@ struct RecursionOptions : public ServiceExecutorAdaptive::Options {
     int recursionLimit() const final {
         return 10;
     }
+
+    int maxStarvationThreadsPerCheck() const final {
+        return 1;
+    }
 };
 
 class ServiceExecutorAdaptiveFixture : public unittest::Test {
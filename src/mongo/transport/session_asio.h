@@ -37,6 +37,7 @@
 #include "mongo/transport/asio_utils.h"
 #include "mongo/transport/baton.h"
 #include "mongo/transport/transport_layer_asio.h"
+#include "mongo/transport/transport_options_gen.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/net/socket_utils.h"
 #ifdef MONGO_CONFIG_SSL
@@ -154,6 +155,17 @@ public:
 
     StatusWith<Message> sourceMessage() override {
         ensureSync();
+
+        // Replies are only held back while the next request is already buffered. Send them before
+        // blocking for more input.
+        if (!_pendingReplies.empty() && !hasBufferedMessage()) {
+            auto status = flushPendingReplies();
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+        _replyHeldSinceSource = false;
+
         return sourceMessageImpl().getNoThrow();
     }
 
@@ -165,6 +177,23 @@ public:
     Status sinkMessage(Message message) override {
         ensureSync();
 
+        // Only hold one reply per request sourced, so that streams of replies sent without reading
+        // in between (exhaust cursors) are not delayed.
+        if (_isIngressSession && gCoalescePipelinedReplies.load() && !_replyHeldSinceSource &&
+            hasBufferedMessage() &&
+            _pendingReplyBytes + message.size() <= kMaxCoalescedReplyBytes) {
+            _replyHeldSinceSource = true;
+            _pendingReplyBytes += message.size();
+            _pendingReplies.push_back(std::move(message));
+            return Status::OK();
+        }
+
+        if (!_pendingReplies.empty()) {
+            _pendingReplyBytes += message.size();
+            _pendingReplies.push_back(std::move(message));
+            return flushPendingReplies();
+        }
+
         return write(asio::buffer(message.buf(), message.size()))
             .then([this, &message] {
                 if (_isIngressSession) {
@@ -370,8 +399,164 @@ private:
         return _socket;
     }
 
+    static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+
+    // Size of the buffer handed to the speculative read in trySpeculativeSourceMessage(). Most
+    // requests and replies fit in it, so they can be received with a single recv() rather than
+    // one for the header followed by one for the body.
+    static constexpr size_t kSpeculativeReadSize = 4 * 1024;
+
+    // Upper bound on the replies sinkMessage() holds back when coalescePipelinedReplies is set.
+    static constexpr size_t kMaxCoalescedReplyBytes = 64 * 1024;
+
+    Status validateMessageLength(size_t msgLen) {
+        if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
+            StringBuilder sb;
+            sb << "recv(): message msgLen " << msgLen << " is invalid. "
+               << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
+            LOGV2(4615638,
+                  "recv(): message msgLen {msgLen} is invalid. Min: {min} Max: {max}",
+                  "msgLen"_attr = msgLen,
+                  "min"_attr = kHeaderSize,
+                  "max"_attr = MaxMessageSizeBytes);
+
+            return Status(ErrorCodes::ProtocolError, sb.str());
+        }
+        return Status::OK();
+    }
+
+    /**
+     * Receives the next message using whatever is left over in '_readAhead' or, failing that, a
+     * single non-looping read into a kSpeculativeReadSize buffer. Bytes past the end of the
+     * message (pipelined or exhaust messages) are kept in '_readAhead' for the next call.
+     *
+     * On a TLS session the read goes through the SSL stream, so a message that arrived in a single
+     * record is decrypted and returned by one pass through the engine, rather than one for the
+     * header and another for the body.
+     *
+     * Returns boost::none if the fast path does not apply, either because an ingress session may
+     * yet negotiate TLS, or because no data is available yet on an async session. The caller then
+     * falls back to reading the header and the body separately.
+     */
+    boost::optional<Future<Message>> trySpeculativeSourceMessage(const BatonHandle& baton) {
+#ifdef MONGO_CONFIG_SSL
+        if (!_ranHandshake) {
+            return boost::none;
+        }
+#endif
+        if (MONGO_unlikely(transportLayerASIOshortOpportunisticReadWrite.shouldFail())) {
+            return boost::none;
+        }
+
+        if (_readAhead) {
+            auto received = _readAheadSize;
+            _readAheadSize = 0;
+            return sourceMessageFromBuffer(std::move(_readAhead), received, baton);
+        }
+
+        auto buffer = SharedBuffer::allocatePooled(kSpeculativeReadSize);
+        std::error_code ec;
+        auto received = readSome(asio::buffer(buffer.get(), kSpeculativeReadSize), ec);
+        if ((ec == asio::error::would_block) || (ec == asio::error::try_again)) {
+            if (_blockingMode == Async) {
+                return boost::none;
+            }
+        }
+        if (ec) {
+            return Future<Message>::makeReady(errorCodeToStatus(ec));
+        }
+
+        return sourceMessageFromBuffer(std::move(buffer), received, baton);
+    }
+
+    // A single, non-looping read from whichever stream carries this session's messages.
+    size_t readSome(const asio::mutable_buffer& buffer, std::error_code& ec) {
+#ifdef MONGO_CONFIG_SSL
+        if (_sslSocket) {
+            return _sslSocket->read_some(buffer, ec);
+        }
+#endif
+        return _socket.read_some(buffer, ec);
+    }
+
+    // Returns whether '_readAhead' holds at least one complete message.
+    bool hasBufferedMessage() const {
+        if (!_readAhead || _readAheadSize < kHeaderSize) {
+            return false;
+        }
+        const auto msgLen = size_t(MSGHEADER::ConstView(_readAhead.get()).getMessageLength());
+        return msgLen <= _readAheadSize;
+    }
+
+    // Copies the replies held back by sinkMessage() into one buffer and sends it.
+    Status flushPendingReplies() {
+        const auto bytes = std::exchange(_pendingReplyBytes, 0);
+        auto buffer = SharedBuffer::allocatePooled(bytes);
+        size_t offset = 0;
+        for (const auto& reply : _pendingReplies) {
+            memcpy(buffer.get() + offset, reply.buf(), reply.size());
+            offset += reply.size();
+        }
+        _pendingReplies.clear();
+
+        return write(asio::buffer(buffer.get(), bytes))
+            .then([bytes] { networkCounter.hitPhysicalOut(bytes); })
+            .getNoThrow();
+    }
+
+    // Completes a message of which the first 'received' bytes are already in 'buffer'.
+    Future<Message> sourceMessageFromBuffer(SharedBuffer buffer,
+                                            size_t received,
+                                            const BatonHandle& baton) {
+        if (received < kHeaderSize) {
+            if (buffer.capacity() < kHeaderSize) {
+                buffer.realloc(kHeaderSize);
+            }
+            auto ptr = buffer.get() + received;
+            return read(asio::buffer(ptr, kHeaderSize - received), baton)
+                .then([this, buffer = std::move(buffer), baton]() mutable {
+                    return sourceMessageFromBuffer(std::move(buffer), kHeaderSize, baton);
+                });
+        }
+
+        if (checkForHTTPRequest(asio::buffer(buffer.get(), kHeaderSize))) {
+            return sendHTTPResponse(baton);
+        }
+
+        const auto msgLen = size_t(MSGHEADER::View(buffer.get()).getMessageLength());
+        auto status = validateMessageLength(msgLen);
+        if (!status.isOK()) {
+            return Future<Message>::makeReady(std::move(status));
+        }
+
+        if (received > msgLen) {
+            _readAheadSize = received - msgLen;
+            _readAhead = SharedBuffer::allocate(_readAheadSize);
+            memcpy(_readAhead.get(), buffer.get() + msgLen, _readAheadSize);
+        }
+
+        if (received >= msgLen) {
+            if (_isIngressSession) {
+                networkCounter.hitPhysicalIn(msgLen);
+            }
+            return Future<Message>::makeReady(Message(std::move(buffer)));
+        }
+
+        buffer.realloc(msgLen);
+        auto ptr = buffer.get() + received;
+        return read(asio::buffer(ptr, msgLen - received), baton)
+            .then([this, buffer = std::move(buffer), msgLen]() mutable {
+                if (_isIngressSession) {
+                    networkCounter.hitPhysicalIn(msgLen);
+                }
+                return Message(std::move(buffer));
+            });
+    }
+
     Future<Message> sourceMessageImpl(const BatonHandle& baton = nullptr) {
-        static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+        if (auto speculative = trySpeculativeSourceMessage(baton)) {
+            return std::move(*speculative);
+        }
 
         auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
         auto ptr = headerBuffer.get();
@@ -382,18 +567,9 @@ private:
                 }
 
                 const auto msgLen = size_t(MSGHEADER::View(headerBuffer.get()).getMessageLength());
-                if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
-                    StringBuilder sb;
-                    sb << "recv(): message msgLen " << msgLen << " is invalid. "
-                       << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
-                    const auto str = sb.str();
-                    LOGV2(4615638,
-                          "recv(): message msgLen {msgLen} is invalid. Min: {min} Max: {max}",
-                          "msgLen"_attr = msgLen,
-                          "min"_attr = kHeaderSize,
-                          "max"_attr = MaxMessageSizeBytes);
-
-                    return Future<Message>::makeReady(Status(ErrorCodes::ProtocolError, str));
+                auto status = validateMessageLength(msgLen);
+                if (!status.isOK()) {
+                    return Future<Message>::makeReady(std::move(status));
                 }
 
                 if (msgLen == kHeaderSize) {
@@ -404,7 +580,7 @@ private:
                     return Future<Message>::makeReady(Message(std::move(headerBuffer)));
                 }
 
-                auto buffer = SharedBuffer::allocate(msgLen);
+                auto buffer = SharedBuffer::allocatePooled(msgLen);
                 memcpy(buffer.get(), headerBuffer.get(), kHeaderSize);
 
                 MsgData::View msgView(buffer.get());
@@ -739,6 +915,16 @@ private:
     bool _ranHandshake = false;
 #endif
 
+    // Bytes received past the end of the last message returned by trySpeculativeSourceMessage().
+    SharedBuffer _readAhead;
+    size_t _readAheadSize = 0;
+
+    // Replies held back by sinkMessage() until the next one that is sent. Replies still held when
+    // the session ends are dropped along with the connection.
+    std::vector<Message> _pendingReplies;
+    size_t _pendingReplyBytes = 0;
+    bool _replyHeldSinceSource = false;
+
     TransportLayerASIO* const _tl;
     bool _isIngressSession;
 };
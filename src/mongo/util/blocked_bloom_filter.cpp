@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/blocked_bloom_filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <third_party/murmurhash3/MurmurHash3.h>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+BlockedBloomFilter::BlockedBloomFilter(uint64_t expectedKeys, uint32_t bitsPerKey)
+    : _capacity(std::max<uint64_t>(expectedKeys, 1)),
+      _numBlocks((_capacity * bitsPerKey + kBlockBits - 1) / kBlockBits),
+      // k = bitsPerKey * ln(2) minimizes the false positive rate of a classic Bloom filter. Fewer
+      // hashes work better when they all land in one block.
+      _numHashes(std::clamp<uint32_t>(std::lround(bitsPerKey * 0.6), 1, 16)),
+      _words(new std::atomic<uint64_t>[_numBlocks * kBlockWords]) {
+    invariant(bitsPerKey > 0);
+    for (uint64_t i = 0; i < _numBlocks * kBlockWords; ++i) {
+        _words[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+BlockedBloomFilter::Probe BlockedBloomFilter::_probe(StringData key) const {
+    uint64_t hash[2];
+    MurmurHash3_x64_128(key.rawData(), key.size(), 0, hash);
+
+    Probe probe{hash[0] % _numBlocks, {}};
+    // Derive the bit positions within the block from the second half of the hash by double hashing.
+    const uint32_t h1 = static_cast<uint32_t>(hash[1]);
+    const uint32_t h2 = static_cast<uint32_t>(hash[1] >> 32) | 1;
+    for (uint32_t i = 0; i < _numHashes; ++i) {
+        const uint32_t bit = (h1 + i * h2) % kBlockBits;
+        probe.masks[bit / 64] |= uint64_t{1} << (bit % 64);
+    }
+    return probe;
+}
+
+void BlockedBloomFilter::insert(StringData key) {
+    const auto probe = _probe(key);
+    auto* block = &_words[probe.block * kBlockWords];
+    for (uint64_t i = 0; i < kBlockWords; ++i) {
+        if (probe.masks[i] && (block[i].load() & probe.masks[i]) != probe.masks[i]) {
+            block[i].fetch_or(probe.masks[i]);
+        }
+    }
+}
+
+bool BlockedBloomFilter::mayContain(StringData key) const {
+    const auto probe = _probe(key);
+    const auto* block = &_words[probe.block * kBlockWords];
+    for (uint64_t i = 0; i < kBlockWords; ++i) {
+        if ((block[i].load() & probe.masks[i]) != probe.masks[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace mongo
@@ -0,0 +1,89 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "mongo/base/string_data.h"
+
+namespace mongo {
+
+/**
+ * A Bloom filter whose bits for each key all fall in a single 64-byte block, so that an insert or
+ * a lookup touches one cache line. The filter never reports a false negative: mayContain() always
+ * returns true for a key that was inserted. It may report a false positive, at a rate that depends
+ * on the number of bits per key the filter was sized for and on how many keys were inserted.
+ *
+ * insert() and mayContain() may be called concurrently from any number of threads. A key whose
+ * insert() happened before a call to mayContain() is always found by it.
+ */
+class BlockedBloomFilter {
+public:
+    /**
+     * Creates an empty filter sized for 'expectedKeys' keys at 'bitsPerKey' bits each.
+     */
+    BlockedBloomFilter(uint64_t expectedKeys, uint32_t bitsPerKey);
+
+    void insert(StringData key);
+
+    bool mayContain(StringData key) const;
+
+    /**
+     * Returns the number of keys the filter was sized for. Past this number the false positive rate
+     * grows quickly.
+     */
+    uint64_t getCapacity() const {
+        return _capacity;
+    }
+
+    uint64_t getSizeBytes() const {
+        return _numBlocks * kBlockWords * sizeof(uint64_t);
+    }
+
+private:
+    static constexpr uint64_t kBlockWords = 8;
+    static constexpr uint64_t kBlockBits = kBlockWords * 64;
+
+    struct Probe {
+        uint64_t block;
+        uint64_t masks[kBlockWords];
+    };
+
+    Probe _probe(StringData key) const;
+
+    const uint64_t _capacity;
+    const uint64_t _numBlocks;
+    const uint32_t _numHashes;
+    std::unique_ptr<std::atomic<uint64_t>[]> _words;
+};
+
+}  // namespace mongo
@@ -0,0 +1,80 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/blocked_bloom_filter.h"
+
+#include <string>
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(BlockedBloomFilterTest, NoFalseNegatives) {
+    BlockedBloomFilter filter(10000, 10);
+    for (int i = 0; i < 10000; ++i) {
+        filter.insert(std::to_string(i));
+    }
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_TRUE(filter.mayContain(std::to_string(i)));
+    }
+}
+
+TEST(BlockedBloomFilterTest, EmptyFilterContainsNothing) {
+    BlockedBloomFilter filter(100, 10);
+    ASSERT_FALSE(filter.mayContain(""));
+    ASSERT_FALSE(filter.mayContain("a"));
+    filter.insert("a");
+    ASSERT_TRUE(filter.mayContain("a"));
+}
+
+TEST(BlockedBloomFilterTest, FalsePositiveRateIsLowAtCapacity) {
+    BlockedBloomFilter filter(100000, 10);
+    for (int i = 0; i < 100000; ++i) {
+        filter.insert("key" + std::to_string(i));
+    }
+    int falsePositives = 0;
+    for (int i = 0; i < 100000; ++i) {
+        falsePositives += filter.mayContain("other" + std::to_string(i));
+    }
+    // About 1% at 10 bits per key.
+    ASSERT_LT(falsePositives, 2000);
+}
+
+TEST(BlockedBloomFilterTest, SizeFollowsCapacity) {
+    BlockedBloomFilter filter(1000, 16);
+    ASSERT_EQ(filter.getCapacity(), 1000U);
+    // 16000 bits rounded up to whole 64-byte blocks.
+    ASSERT_EQ(filter.getSizeBytes(), 2048U);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -239,6 +239,11 @@ void ThreadPool::schedule(Task task) {
     if (_numIdleThreads <= _pendingTasks.size()) {
         _lastFullUtilizationDate = Date_t::now();
     }
+
+    // Wake a worker only after releasing the mutex, so that it does not immediately block on the
+    // mutex this thread is still holding. With many threads scheduling at once this halves the
+    // number of times each schedule() call contends for _mutex.
+    lk.unlock();
     _workAvailable.notify_one();
 }
 
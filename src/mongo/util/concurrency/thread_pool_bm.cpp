@@ -0,0 +1,79 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/processinfo.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Benchmark scheduling no-op tasks on a ThreadPool with a fixed number of workers, given by the
+ * argument, from an increasing number of scheduling threads.
+ *
+ * All benchmark threads schedule onto the same pool, so that the contention between schedule()
+ * callers and the pool's workers shows up in the scaling of the benchmark.
+ */
+void BM_ThreadPoolSchedule(benchmark::State& state) {
+    static std::unique_ptr<ThreadPool> pool;
+    if (state.thread_index == 0) {
+        ThreadPool::Options options;
+        options.poolName = "BM_ThreadPoolSchedule";
+        options.minThreads = state.range(0);
+        options.maxThreads = state.range(0);
+        pool = std::make_unique<ThreadPool>(std::move(options));
+        pool->startup();
+    }
+
+    for (auto keepRunning : state) {
+        pool->schedule([](Status status) { benchmark::DoNotOptimize(status); });
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index == 0) {
+        pool->waitForIdle();
+        pool->shutdown();
+        pool->join();
+        pool.reset();
+    }
+}
+
+BENCHMARK(BM_ThreadPoolSchedule)
+    ->ThreadRange(1, ProcessInfo::getNumAvailableCores())
+    ->ArgName("workers")
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16);
+
+}  // namespace
+}  // namespace mongo
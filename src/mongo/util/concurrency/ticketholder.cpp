@@ -33,12 +33,153 @@
 
 #include "mongo/util/concurrency/ticketholder.h"
 
-#include <iostream>
+#include <algorithm>
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/logv2/log.h"
+#include "mongo/util/concurrency/ticketholder_gen.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
+namespace {
+
+// Queued waiters retry the pool at this interval, in case a ticket was returned to it while they
+// were being queued.
+const Milliseconds kQueueRetryInterval(500);
+
+StringData priorityName(TicketHolder::Priority priority) {
+    switch (priority) {
+        case TicketHolder::Priority::kLow:
+            return "low"_sd;
+        case TicketHolder::Priority::kNormal:
+            return "normal"_sd;
+    }
+    MONGO_UNREACHABLE;
+}
+
+}  // namespace
+
+void TicketHolder::waitForTicket(OperationContext* opCtx, Priority priority) {
+    invariant(waitForTicketUntil(opCtx, Date_t::max(), priority));
+}
+
+bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until, Priority priority) {
+    if (_tryAcquireFromPool())
+        return true;
+    if (until <= Date_t::now())
+        return false;
+    return _waitInQueue(opCtx, until, priority);
+}
+
+bool TicketHolder::_waitInQueue(OperationContext* opCtx, Date_t until, Priority priority) {
+    stdx::unique_lock<Latch> lk(_queueMutex);
+    Waiter waiter(priority, Date_t::now());
+    auto& queue = _queues[static_cast<int>(priority)];
+    auto& stats = _queueStats[static_cast<int>(priority)];
+    queue.push_back(&waiter);
+    _numWaiters.fetchAndAdd(1);
+    stats.addedToQueue++;
+
+    // A release() that saw no waiters returned its ticket to the pool, so look there once more now
+    // that this waiter is visible.
+    _grantToWaiters(lk);
+
+    auto onExit = makeGuard([&] {
+        if (!waiter.granted) {
+            _dequeue(lk, &waiter);
+            stats.canceled++;
+        }
+        stats.totalTimeQueued += Date_t::now() - waiter.queuedAt;
+    });
+
+    try {
+        while (!waiter.granted) {
+            auto deadline = std::min(until, Date_t::now() + kQueueRetryInterval);
+            if (opCtx) {
+                opCtx->waitForConditionOrInterruptUntil(
+                    waiter.cv, lk, deadline, [&] { return waiter.granted; });
+            } else {
+                waiter.cv.wait_until(
+                    lk, deadline.toSystemTimePoint(), [&] { return waiter.granted; });
+            }
+            if (!waiter.granted) {
+                if (deadline == until)
+                    return false;
+                _grantToWaiters(lk);
+            }
+        }
+    } catch (...) {
+        // An interrupted waiter that was granted a ticket in the meantime hands it on.
+        if (waiter.granted) {
+            _releaseToPool();
+            _grantToWaiters(lk);
+        }
+        throw;
+    }
+    return true;
+}
+
+void TicketHolder::release() {
+    _releaseToPool();
+    if (_numWaiters.load() == 0)
+        return;
+
+    stdx::lock_guard<Latch> lk(_queueMutex);
+    _grantToWaiters(lk);
+}
+
+void TicketHolder::_grantToWaiters(WithLock lk) {
+    const Milliseconds lowPriorityDelay(gAdmissionControlLowPriorityDelayMillis.load());
+    while (_numWaiters.load() > 0) {
+        // Low priority waiters are ordered as if they had arrived 'lowPriorityDelay' later than
+        // they did, so they only pass normal priority waiters that arrived well after them.
+        Waiter* next = nullptr;
+        Date_t nextArrival = Date_t::max();
+        for (int i = 0; i < kNumPriorities; ++i) {
+            if (_queues[i].empty())
+                continue;
+            auto waiter = _queues[i].front();
+            auto arrival = waiter->queuedAt +
+                lowPriorityDelay * (static_cast<int>(Priority::kNormal) - i);
+            if (!next || arrival < nextArrival) {
+                next = waiter;
+                nextArrival = arrival;
+            }
+        }
+        invariant(next);
+
+        if (!_tryAcquireFromPool())
+            return;
+
+        _dequeue(lk, next);
+        _queueStats[static_cast<int>(next->priority)].removedFromQueue++;
+        next->granted = true;
+        next->cv.notify_one();
+    }
+}
+
+void TicketHolder::_dequeue(WithLock, Waiter* waiter) {
+    auto& queue = _queues[static_cast<int>(waiter->priority)];
+    auto it = std::find(queue.begin(), queue.end(), waiter);
+    invariant(it != queue.end());
+    queue.erase(it);
+    _numWaiters.subtractAndFetch(1);
+}
+
+void TicketHolder::appendStats(BSONObjBuilder* b) const {
+    stdx::lock_guard<Latch> lk(_queueMutex);
+    BSONObjBuilder queues(b->subobjStart("queues"));
+    for (int i = kNumPriorities - 1; i >= 0; --i) {
+        const auto& stats = _queueStats[i];
+        BSONObjBuilder bb(queues.subobjStart(priorityName(static_cast<Priority>(i))));
+        bb.append("queueLength", static_cast<long long>(_queues[i].size()));
+        bb.append("addedToQueue", stats.addedToQueue);
+        bb.append("removedFromQueue", stats.removedFromQueue);
+        bb.append("canceled", stats.canceled);
+        bb.append("totalTimeQueuedMicros", durationCount<Microseconds>(stats.totalTimeQueued));
+    }
+}
 
 #if defined(__linux__)
 namespace {
@@ -62,14 +203,6 @@ void check(int ret) {
         return;
     failWithErrno(errno);
 }
-
-/**
- * Takes a Date_t deadline and sets the appropriate values in a timespec structure.
- */
-void tsFromDate(const Date_t& deadline, struct timespec& ts) {
-    ts.tv_sec = deadline.toTimeT();
-    ts.tv_nsec = (deadline.toMillisSinceEpoch() % 1000) * 1'000'000;
-}
 }  // namespace
 
 TicketHolder::TicketHolder(int num) : _outof(num) {
@@ -81,6 +214,10 @@ TicketHolder::~TicketHolder() {
 }
 
 bool TicketHolder::tryAcquire() {
+    return _tryAcquireFromPool();
+}
+
+bool TicketHolder::_tryAcquireFromPool() {
     while (0 != sem_trywait(&_sem)) {
         if (errno == EAGAIN)
             return false;
@@ -90,42 +227,7 @@ bool TicketHolder::tryAcquire() {
     return true;
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    waitForTicketUntil(opCtx, Date_t::max());
-}
-
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    const Milliseconds intervalMs(500);
-    struct timespec ts;
-
-    // To support interrupting ticket acquisition while still benefiting from semaphores, we do a
-    // timed wait on an interval to periodically check for interrupts.
-    // The wait period interval is the smaller of the default interval and the provided
-    // deadline.
-    Date_t deadline = std::min(until, Date_t::now() + intervalMs);
-    tsFromDate(deadline, ts);
-
-    while (0 != sem_timedwait(&_sem, &ts)) {
-        if (errno == ETIMEDOUT) {
-            // If we reached the deadline without being interrupted, we have completely timed out.
-            if (deadline == until)
-                return false;
-
-            deadline = std::min(until, Date_t::now() + intervalMs);
-            tsFromDate(deadline, ts);
-        } else if (errno != EINTR) {
-            failWithErrno(errno);
-        }
-
-        // To correctly handle errors from sem_timedwait, we should check for interrupts last.
-        // It is possible to unset 'errno' after a call to checkForInterrupt().
-        if (opCtx)
-            opCtx->checkForInterrupt();
-    }
-    return true;
-}
-
-void TicketHolder::release() {
+void TicketHolder::_releaseToPool() {
     check(sem_post(&_sem));
 }
 
@@ -176,44 +278,26 @@ TicketHolder::TicketHolder(int num) : _outof(num), _num(num) {}
 TicketHolder::~TicketHolder() = default;
 
 bool TicketHolder::tryAcquire() {
-    stdx::lock_guard<Latch> lk(_mutex);
-    return _tryAcquire();
+    return _tryAcquireFromPool();
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
-    } else {
-        _newTicket.wait(lk, [this] { return _tryAcquire(); });
-    }
-}
-
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        return opCtx->waitForConditionOrInterruptUntil(
-            _newTicket, lk, until, [this] { return _tryAcquire(); });
-    } else {
-        return _newTicket.wait_until(
-            lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); });
+bool TicketHolder::_tryAcquireFromPool() {
+    auto num = _num.load();
+    while (num > 0) {
+        if (_num.compareAndSwap(&num, num - 1))
+            return true;
     }
+    return false;
 }
 
-void TicketHolder::release() {
-    {
-        stdx::lock_guard<Latch> lk(_mutex);
-        _num++;
-    }
-    _newTicket.notify_one();
+void TicketHolder::_releaseToPool() {
+    _num.fetchAndAdd(1);
 }
 
 Status TicketHolder::resize(int newSize) {
-    stdx::lock_guard<Latch> lk(_mutex);
+    stdx::lock_guard<Latch> lk(_resizeMutex);
 
-    int used = _outof.load() - _num;
+    int used = _outof.load() - _num.load();
     if (used > newSize) {
         std::stringstream ss;
         ss << "can't resize since we're using (" << used << ") "
@@ -224,35 +308,27 @@ Status TicketHolder::resize(int newSize) {
         return Status(ErrorCodes::BadValue, errmsg);
     }
 
+    auto delta = newSize - _outof.load();
     _outof.store(newSize);
-    _num = _outof.load() - used;
+    _num.fetchAndAdd(delta);
 
-    // Potentially wasteful, but easier to see is correct
-    _newTicket.notify_all();
+    if (delta > 0 && _numWaiters.load() > 0) {
+        stdx::lock_guard<Latch> queueLock(_queueMutex);
+        _grantToWaiters(queueLock);
+    }
     return Status::OK();
 }
 
 int TicketHolder::available() const {
-    return _num;
+    return _num.load();
 }
 
 int TicketHolder::used() const {
-    return outof() - _num;
+    return outof() - available();
 }
 
 int TicketHolder::outof() const {
     return _outof.load();
 }
-
-bool TicketHolder::_tryAcquire() {
-    if (_num <= 0) {
-        if (_num < 0) {
-            std::cerr << "DISASTER! in TicketHolder" << std::endl;
-        }
-        return false;
-    }
-    _num--;
-    return true;
-}
 #endif
 }  // namespace mongo
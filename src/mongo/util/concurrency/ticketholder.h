@@ -32,20 +32,34 @@
 #include <semaphore.h>
 #endif
 
+#include <array>
+#include <list>
+
 #include "mongo/db/operation_context.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/hierarchical_acquisition.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
+
+/**
+ * Hands out a fixed number of tickets. When none are available, waiters queue by priority: a
+ * released ticket goes to the longest waiting normal priority waiter, unless a low priority waiter
+ * has been queued for more than admissionControlLowPriorityDelayMillis longer than it.
+ */
 class TicketHolder {
     TicketHolder(const TicketHolder&) = delete;
     TicketHolder& operator=(const TicketHolder&) = delete;
 
 public:
+    enum class Priority { kLow, kNormal };
+    static constexpr int kNumPriorities = 2;
+
     explicit TicketHolder(int num);
     ~TicketHolder();
 
@@ -56,7 +70,7 @@ public:
      * 'opCtx' is killed, throwing an AssertionException.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    void waitForTicket(OperationContext* opCtx);
+    void waitForTicket(OperationContext* opCtx, Priority priority = Priority::kNormal);
     void waitForTicket() {
         waitForTicket(nullptr);
     }
@@ -68,7 +82,9 @@ public:
      * proceed.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    bool waitForTicketUntil(OperationContext* opCtx, Date_t until);
+    bool waitForTicketUntil(OperationContext* opCtx,
+                            Date_t until,
+                            Priority priority = Priority::kNormal);
     bool waitForTicketUntil(Date_t until) {
         return waitForTicketUntil(nullptr, until);
     }
@@ -82,21 +98,64 @@ public:
 
     int outof() const;
 
+    /**
+     * Appends the queue statistics of each priority class, for serverStatus.
+     */
+    void appendStats(BSONObjBuilder* b) const;
+
 private:
+    struct Waiter {
+        Waiter(Priority priority, Date_t queuedAt) : priority(priority), queuedAt(queuedAt) {}
+
+        const Priority priority;
+        const Date_t queuedAt;
+        bool granted = false;
+        stdx::condition_variable cv;
+    };
+
+    struct QueueStats {
+        long long addedToQueue = 0;
+        long long removedFromQueue = 0;
+        long long canceled = 0;
+        Microseconds totalTimeQueued{0};
+    };
+
+    /**
+     * Takes a ticket from, or returns one to, the pool of available tickets, without looking at
+     * the queued waiters.
+     */
+    bool _tryAcquireFromPool();
+    void _releaseToPool();
+
+    bool _waitInQueue(OperationContext* opCtx, Date_t until, Priority priority);
+
+    /**
+     * Moves available tickets to queued waiters, in priority order.
+     */
+    void _grantToWaiters(WithLock);
+    void _dequeue(WithLock, Waiter* waiter);
+
+    // Number of waiters across all queues. Readable without _queueMutex so that release() only
+    // takes the mutex when it may have to hand its ticket to a waiter.
+    AtomicWord<int> _numWaiters{0};
+
+    mutable Mutex _queueMutex =
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_queueMutex");
+    std::array<std::list<Waiter*>, kNumPriorities> _queues;
+    std::array<QueueStats, kNumPriorities> _queueStats;
+
 #if defined(__linux__)
     mutable sem_t _sem;
 
     // You can read _outof without a lock, but have to hold _resizeMutex to change.
     AtomicWord<int> _outof;
     Mutex _resizeMutex =
-        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_resizeMutex");
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(1), "TicketHolder::_resizeMutex");
 #else
-    bool _tryAcquire();
-
     AtomicWord<int> _outof;
-    int _num;
-    Mutex _mutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_mutex");
-    stdx::condition_variable _newTicket;
+    AtomicWord<int> _num;
+    Mutex _resizeMutex =
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(1), "TicketHolder::_resizeMutex");
 #endif
 };
 
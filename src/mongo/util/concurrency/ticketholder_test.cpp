@@ -32,8 +32,14 @@
 
 #include "mongo/platform/basic.h"
 
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/concurrency/ticketholder_gen.h"
+#include "mongo/util/scopeguard.h"
 
 namespace {
 using namespace mongo;
@@ -72,4 +78,86 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+
+BSONObj queueStats(const TicketHolder& holder, StringData priority) {
+    BSONObjBuilder b;
+    holder.appendStats(&b);
+    return b.obj()["queues"][priority].Obj().getOwned();
+}
+
+void waitForQueueLength(const TicketHolder& holder, StringData priority, int length) {
+    while (queueStats(holder, priority)["queueLength"].numberInt() != length) {
+        sleepmillis(1);
+    }
+}
+
+/**
+ * Queues a low priority waiter and then a normal priority one on an exhausted holder, and returns
+ * the order in which they were granted tickets.
+ */
+std::vector<TicketHolder::Priority> grantOrder(Milliseconds lowPriorityDelay) {
+    const auto oldDelay = gAdmissionControlLowPriorityDelayMillis.load();
+    gAdmissionControlLowPriorityDelayMillis.store(durationCount<Milliseconds>(lowPriorityDelay));
+    ON_BLOCK_EXIT([&] { gAdmissionControlLowPriorityDelayMillis.store(oldDelay); });
+
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    Mutex mutex = MONGO_MAKE_LATCH();
+    std::vector<TicketHolder::Priority> order;
+    auto waitAndRecord = [&](TicketHolder::Priority priority) {
+        holder.waitForTicket(nullptr, priority);
+        {
+            stdx::lock_guard<Latch> lk(mutex);
+            order.push_back(priority);
+        }
+        holder.release();
+    };
+
+    stdx::thread low(waitAndRecord, TicketHolder::Priority::kLow);
+    waitForQueueLength(holder, "low", 1);
+    sleepmillis(5);
+    stdx::thread normal(waitAndRecord, TicketHolder::Priority::kNormal);
+    waitForQueueLength(holder, "normal", 1);
+
+    holder.release();
+    low.join();
+    normal.join();
+
+    ASSERT_EQ(holder.used(), 0);
+    ASSERT_EQ(queueStats(holder, "low")["removedFromQueue"].numberLong(), 1);
+    ASSERT_EQ(queueStats(holder, "normal")["removedFromQueue"].numberLong(), 1);
+    return order;
+}
+
+TEST(TicketholderTest, NormalPriorityWaitersGoFirst) {
+    auto order = grantOrder(Hours(1));
+    ASSERT_EQ(order.size(), 2U);
+    ASSERT(order[0] == TicketHolder::Priority::kNormal);
+    ASSERT(order[1] == TicketHolder::Priority::kLow);
+}
+
+TEST(TicketholderTest, LowPriorityWaitersAge) {
+    // Without a delay, waiters are served in arrival order whatever their priority.
+    auto order = grantOrder(Milliseconds(0));
+    ASSERT_EQ(order.size(), 2U);
+    ASSERT(order[0] == TicketHolder::Priority::kLow);
+    ASSERT(order[1] == TicketHolder::Priority::kNormal);
+}
+
+TEST(TicketholderTest, QueueStatsCountTimeouts) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+    ASSERT_FALSE(holder.waitForTicketUntil(
+        nullptr, Date_t::now() + Milliseconds(10), TicketHolder::Priority::kLow));
+
+    auto low = queueStats(holder, "low");
+    ASSERT_EQ(low["queueLength"].numberLong(), 0);
+    ASSERT_EQ(low["addedToQueue"].numberLong(), 1);
+    ASSERT_EQ(low["removedFromQueue"].numberLong(), 0);
+    ASSERT_EQ(low["canceled"].numberLong(), 1);
+    ASSERT_GTE(low["totalTimeQueuedMicros"].numberLong(), 10 * 1000);
+    ASSERT_EQ(queueStats(holder, "normal")["addedToQueue"].numberLong(), 0);
+    holder.release();
+}
 }  // namespace
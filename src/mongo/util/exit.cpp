@@ -38,6 +38,8 @@
 #include <stack>
 
 #include "mongo/logv2/log.h"
+#include "mongo/logv2/log_domain_global.h"
+#include "mongo/logv2/log_manager.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/thread.h"
@@ -69,6 +71,7 @@ void runTasks(decltype(shutdownTasks) tasks, const ShutdownTaskArgs& shutdownArg
 MONGO_COMPILER_NORETURN void logAndQuickExit_inlock() {
     ExitCode code = shutdownExitCode.get();
     LOGV2(23138, "shutting down with code:{code}", "code"_attr = code);
+    logv2::LogManager::global().getGlobalDomainInternal().flush();
     quickExit(code);
 }
 
@@ -30,7 +30,9 @@
 #pragma once
 
 #include <functional>
+#include <new>
 #include <type_traits>
+#include <utility>
 
 #include "mongo/stdx/type_traits.h"
 #include "mongo/util/assert_util.h"
@@ -45,6 +47,10 @@ class unique_function;
  * it is incapable of being copied.  Often this happens with C++14 or later lambdas which capture a
  * `std::unique_ptr` by move.  The interface of `unique_function` is nearly identical to
  * `std::function`, except that it is not copyable.
+ *
+ * Functors that are small enough and nothrow move constructible are stored inline rather than on
+ * the heap, so wrapping a lambda with only a few captures does not allocate. A consequence is that
+ * moving a `unique_function` may move the functor it holds.
  */
 template <typename RetType, typename... Args>
 class unique_function<RetType(Args...)> {
@@ -65,18 +71,29 @@ private:
 public:
     using result_type = RetType;
 
-    ~unique_function() noexcept = default;
+    ~unique_function() noexcept {
+        reset();
+    }
     unique_function() = default;
 
     unique_function(const unique_function&) = delete;
     unique_function& operator=(const unique_function&) = delete;
 
-    unique_function(unique_function&&) noexcept = default;
-    unique_function& operator=(unique_function&&) noexcept = default;
+    unique_function(unique_function&& that) noexcept {
+        takeFrom(that);
+    }
+    unique_function& operator=(unique_function&& that) noexcept {
+        if (this != &that) {
+            reset();
+            takeFrom(that);
+        }
+        return *this;
+    }
 
     void swap(unique_function& that) noexcept {
-        using std::swap;
-        swap(this->impl, that.impl);
+        unique_function tmp(std::move(that));
+        that = std::move(*this);
+        *this = std::move(tmp);
     }
 
     friend void swap(unique_function& a, unique_function& b) noexcept {
@@ -100,7 +117,7 @@ public:
         std::enable_if_t<std::is_move_constructible<Functor>::value, TagType> = makeTag(),
         std::enable_if_t<!std::is_same<std::decay_t<Functor>, unique_function>::value, TagType> =
             makeTag())
-        : impl(makeImpl(std::forward<Functor>(functor))) {}
+        : impl(makeImpl(std::forward<Functor>(functor), inlineStorage)) {}
 
     unique_function(std::nullptr_t) noexcept {}
 
@@ -135,8 +152,42 @@ private:
     struct Impl {
         virtual ~Impl() noexcept = default;
         virtual RetType call(Args&&... args) = 0;
+
+        // Move constructs a copy of this into 'storage' and returns it. Only called for Impls that
+        // live in the inline storage of a `unique_function`.
+        virtual Impl* moveInto(void* storage) noexcept = 0;
     };
 
+    // Large enough for the vtable pointer of an Impl and a functor of three pointers, which covers
+    // most lambdas.
+    static constexpr size_t kInlineStorageSize = 4 * sizeof(void*);
+    using InlineStorage = std::aligned_storage_t<kInlineStorageSize, alignof(void*)>;
+
+    bool isInline() const noexcept {
+        const auto implAddr = reinterpret_cast<const char*>(impl);
+        const auto storageAddr = reinterpret_cast<const char*>(&inlineStorage);
+        return implAddr >= storageAddr && implAddr < storageAddr + sizeof(inlineStorage);
+    }
+
+    void reset() noexcept {
+        if (isInline()) {
+            impl->~Impl();
+        } else {
+            delete impl;
+        }
+        impl = nullptr;
+    }
+
+    // Must only be called when this holds no functor.
+    void takeFrom(unique_function& that) noexcept {
+        if (that.isInline()) {
+            impl = that.impl->moveInto(&inlineStorage);
+            that.reset();
+        } else {
+            impl = std::exchange(that.impl, nullptr);
+        }
+    }
+
     // These overload helpers are needed to squelch problems in the `T ()` -> `void ()` case.
     template <typename Functor>
     static void callRegularVoid(const std::true_type isVoid, Functor& f, Args&&... args) {
@@ -151,7 +202,7 @@ private:
     }
 
     template <typename Functor>
-    static auto makeImpl(Functor&& functor) {
+    static Impl* makeImpl(Functor&& functor, InlineStorage& storage) {
         struct SpecificImpl : Impl {
             explicit SpecificImpl(Functor&& func) : f(std::forward<Functor>(func)) {}
 
@@ -159,13 +210,28 @@ private:
                 return callRegularVoid(std::is_void<RetType>(), f, std::forward<Args>(args)...);
             }
 
+            Impl* moveInto(void* storage) noexcept override {
+                if constexpr (std::is_nothrow_move_constructible_v<std::decay_t<Functor>>) {
+                    return new (storage) SpecificImpl(std::move(*this));
+                } else {
+                    MONGO_UNREACHABLE;
+                }
+            }
+
             std::decay_t<Functor> f;
         };
 
-        return std::make_unique<SpecificImpl>(std::forward<Functor>(functor));
+        if constexpr (sizeof(SpecificImpl) <= sizeof(InlineStorage) &&
+                      alignof(SpecificImpl) <= alignof(InlineStorage) &&
+                      std::is_nothrow_move_constructible_v<std::decay_t<Functor>>) {
+            return new (&storage) SpecificImpl(std::forward<Functor>(functor));
+        } else {
+            return new SpecificImpl(std::forward<Functor>(functor));
+        }
     }
 
-    std::unique_ptr<Impl> impl;
+    InlineStorage inlineStorage;
+    Impl* impl = nullptr;
 };
 
 /**
@@ -29,6 +29,9 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/db/record_id.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/flat_hash_map.h"
 #include "mongo/util/string_map.h"
 
 #include <absl/container/flat_hash_map.h>
@@ -58,6 +61,10 @@ using AbslFlatHashMapString = absl::flat_hash_map<std::string, bool>;
 using AbslNodeHashMapInt = absl::node_hash_map<uint32_t, bool>;
 using AbslNodeHashMapString = absl::node_hash_map<std::string, bool>;
 
+// The containers plan stages use to deduplicate RecordIds, with the hasher they use.
+using StdxUnorderedMapRecordId = stdx::unordered_map<RecordId, bool, RecordId::Hasher>;
+using FlatHashMapRecordId = FlatHashMap<RecordId, bool, RecordId::Hasher>;
+
 template <typename>
 struct IsAbslHashMap : std::false_type {};
 
@@ -119,6 +126,11 @@ absl::string_view BaseGenerator::generate<absl::string_view>() {
     return absl::string_view(sd.rawData(), sd.size());
 }
 
+template <>
+RecordId BaseGenerator::generate<RecordId>() {
+    return RecordId(generate<uint32_t>());
+}
+
 template <>
 std::string BaseGenerator::generate<std::string>() {
     return generate<StringData>().toString();
@@ -263,6 +275,16 @@ BENCHMARK_TEMPLATE(BM_Insert, StdUnorderedInt)->Apply(Range<1>);
 BENCHMARK_TEMPLATE(BM_Insert, AbslFlatHashMapInt)->Apply(Range<1>);
 BENCHMARK_TEMPLATE(BM_Insert, AbslNodeHashMapInt)->Apply(Range<1>);
 
+// RecordId key tests
+BENCHMARK_TEMPLATE(BM_SuccessfulLookup, StdxUnorderedMapRecordId)->Apply(Range);
+BENCHMARK_TEMPLATE(BM_SuccessfulLookup, FlatHashMapRecordId)->Apply(Range);
+
+BENCHMARK_TEMPLATE(BM_UnsuccessfulLookup, StdxUnorderedMapRecordId)->Apply(Range);
+BENCHMARK_TEMPLATE(BM_UnsuccessfulLookup, FlatHashMapRecordId)->Apply(Range);
+
+BENCHMARK_TEMPLATE(BM_Insert, StdxUnorderedMapRecordId)->Apply(Range<1>);
+BENCHMARK_TEMPLATE(BM_Insert, FlatHashMapRecordId)->Apply(Range<1>);
+
 // String key tests
 BENCHMARK_TEMPLATE(BM_SuccessfulLookup, StdUnorderedString)->Apply(Range);
 BENCHMARK_TEMPLATE(BM_SuccessfulLookup, AbslFlatHashMapString)->Apply(Range);
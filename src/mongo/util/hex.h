@@ -70,7 +70,8 @@ inline StatusWith<char> fromHex(StringData c) {
  * Decodes 'hexString' into raw bytes, appended to the out parameter 'buf'. Callers must first
  * ensure that 'hexString' is a valid hex encoding.
  */
-inline void fromHexString(StringData hexString, BufBuilder* buf) {
+template <typename Builder>
+void fromHexString(StringData hexString, Builder* buf) {
     invariant(hexString.size() % 2 == 0);
     // Combine every pair of two characters into one byte.
     for (std::size_t i = 0; i < hexString.size(); i += 2) {
@@ -90,17 +91,15 @@ inline bool isValidHex(StringData hexString) {
 inline std::string toHex(const void* inRaw, int len) {
     static const char hexchars[] = "0123456789ABCDEF";
 
-    StringBuilder out;
+    std::string out(2 * static_cast<size_t>(len), '\0');
     const char* in = reinterpret_cast<const char*>(inRaw);
     for (int i = 0; i < len; ++i) {
         char c = in[i];
-        char hi = hexchars[(c & 0xF0) >> 4];
-        char lo = hexchars[(c & 0x0F)];
-
-        out << hi << lo;
+        out[2 * i] = hexchars[(c & 0xF0) >> 4];
+        out[2 * i + 1] = hexchars[(c & 0x0F)];
     }
 
-    return out.str();
+    return out;
 }
 
 template <typename T>
@@ -109,17 +108,15 @@ std::string integerToHex(T val);
 inline std::string toHexLower(const void* inRaw, int len) {
     static const char hexchars[] = "0123456789abcdef";
 
-    StringBuilder out;
+    std::string out(2 * static_cast<size_t>(len), '\0');
     const char* in = reinterpret_cast<const char*>(inRaw);
     for (int i = 0; i < len; ++i) {
         char c = in[i];
-        char hi = hexchars[(c & 0xF0) >> 4];
-        char lo = hexchars[(c & 0x0F)];
-
-        out << hi << lo;
+        out[2 * i] = hexchars[(c & 0xF0) >> 4];
+        out[2 * i + 1] = hexchars[(c & 0x0F)];
     }
 
-    return out.str();
+    return out;
 }
 
 /**
@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/monotonic_arena.h"
+
+#include <cstdlib>
+
+#include "mongo/util/allocator.h"
+
+namespace mongo {
+namespace {
+
+// Blocks may be released by destructors of other thread_local objects after this thread's cache
+// has been torn down. This flag is trivially destructible, so it can still be consulted then.
+thread_local bool threadCacheDestroyed = false;
+
+struct ThreadCache {
+    ~ThreadCache() {
+        threadCacheDestroyed = true;
+        while (head) {
+            auto next = head->next;
+            std::free(head);
+            head = next;
+        }
+    }
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    FreeBlock* head = nullptr;
+    size_t numBlocks = 0;
+};
+
+thread_local ThreadCache threadCache;
+
+void* acquireBlock() {
+    if (!threadCacheDestroyed && threadCache.head) {
+        auto block = threadCache.head;
+        threadCache.head = block->next;
+        --threadCache.numBlocks;
+        return block;
+    }
+    return mongoMalloc(MonotonicArena::kBlockSize);
+}
+
+void releaseBlock(void* block) {
+    if (threadCacheDestroyed ||
+        threadCache.numBlocks == MonotonicArena::kMaxCachedBlocksPerThread) {
+        std::free(block);
+        return;
+    }
+    auto freeBlock = static_cast<ThreadCache::FreeBlock*>(block);
+    freeBlock->next = threadCache.head;
+    threadCache.head = freeBlock;
+    ++threadCache.numBlocks;
+}
+
+}  // namespace
+
+void MonotonicArena::reset() {
+    for (auto cleanup = _cleanups; cleanup; cleanup = cleanup->next) {
+        cleanup->destroy(cleanup->obj);
+    }
+    _cleanups = nullptr;
+
+    while (_head) {
+        auto block = _head;
+        _head = block->prev;
+        if (block->oversizedBytes) {
+            std::free(block);
+        } else {
+            releaseBlock(block);
+        }
+    }
+    _used = 0;
+    _bytesReserved = 0;
+}
+
+void* MonotonicArena::_allocateSlow(size_t bytes) {
+    if (bytes <= kMaxInlineAllocation || !_head) {
+        auto block = static_cast<Block*>(acquireBlock());
+        block->prev = _head;
+        block->oversizedBytes = 0;
+        _head = block;
+        _used = 0;
+        _bytesReserved += kBlockSize;
+        if (bytes <= kMaxInlineAllocation) {
+            _used = bytes;
+            return block->data();
+        }
+    }
+
+    // Link the oversized block in behind '_head' so that the rest of '_head' stays in use.
+    auto block = static_cast<Block*>(mongoMalloc(sizeof(Block) + bytes));
+    block->oversizedBytes = bytes;
+    block->prev = _head->prev;
+    _head->prev = block;
+    _bytesReserved += sizeof(Block) + bytes;
+    return block->data();
+}
+
+}  // namespace mongo
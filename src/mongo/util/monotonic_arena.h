@@ -0,0 +1,177 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace mongo {
+
+/**
+ * An arena for many small allocations that share a lifetime, such as those made while parsing and
+ * planning one operation. Memory is carved sequentially out of blocks of kBlockSize bytes, and
+ * allocations larger than kMaxInlineAllocation get a block of their own. It is never released
+ * individually: destroying or resetting the arena runs the destructors of the objects created with
+ * make(), latest first, and releases all blocks at once. Released blocks are kept on a per-thread
+ * free list of up to kMaxCachedBlocksPerThread blocks, so an arena rarely reaches the system
+ * allocator once its thread has run a few operations.
+ *
+ * Not thread-safe.
+ */
+class MonotonicArena {
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+public:
+    static constexpr size_t kBlockSize = 4096;
+    static constexpr size_t kMaxInlineAllocation = kBlockSize / 4;
+    static constexpr size_t kMaxCachedBlocksPerThread = 16;
+
+    MonotonicArena() = default;
+
+    ~MonotonicArena() {
+        reset();
+    }
+
+    /**
+     * Returns 'bytes' of uninitialized memory aligned to 'alignment', which must be a power of two
+     * no larger than alignof(std::max_align_t). The memory stays valid until reset() or the
+     * arena's destruction.
+     */
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        const auto offset = (_used + alignment - 1) & ~(alignment - 1);
+        if (_head && offset + bytes <= kUsableBlockSize) {
+            _used = offset + bytes;
+            return _head->data() + offset;
+        }
+        return _allocateSlow(bytes);
+    }
+
+    /**
+     * Constructs a T in the arena. Its destructor, if it has a non-trivial one, runs when the arena
+     * is reset or destroyed, so the returned object must not be deleted.
+     */
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        } else {
+            auto cleanup = static_cast<Cleanup*>(allocate(sizeof(Cleanup), alignof(Cleanup)));
+            T* obj = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            cleanup->destroy = [](void* p) { static_cast<T*>(p)->~T(); };
+            cleanup->obj = obj;
+            cleanup->next = _cleanups;
+            _cleanups = cleanup;
+            return obj;
+        }
+    }
+
+    /**
+     * Destroys every object made in the arena and releases its memory.
+     */
+    void reset();
+
+    /**
+     * Returns the number of bytes of block memory the arena holds.
+     */
+    size_t bytesReserved() const {
+        return _bytesReserved;
+    }
+
+private:
+    struct Block {
+        char* data() {
+            return reinterpret_cast<char*>(this + 1);
+        }
+
+        Block* prev;
+        // Zero for regular blocks, which hold kUsableBlockSize bytes.
+        size_t oversizedBytes;
+    };
+    static_assert(sizeof(Block) % alignof(std::max_align_t) == 0);
+
+    static constexpr size_t kUsableBlockSize = kBlockSize - sizeof(Block);
+
+    struct Cleanup {
+        void (*destroy)(void*);
+        void* obj;
+        Cleanup* next;
+    };
+
+    void* _allocateSlow(size_t bytes);
+
+    // The block allocations are carved from. Oversized blocks are linked in behind it.
+    Block* _head = nullptr;
+    size_t _used = 0;
+    size_t _bytesReserved = 0;
+    Cleanup* _cleanups = nullptr;
+};
+
+/**
+ * A standard allocator over a MonotonicArena, for containers whose elements share the arena's
+ * lifetime. deallocate() is a no-op; the memory is reclaimed with the arena.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(MonotonicArena* arena) : _arena(arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : _arena(other.arena()) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) {}
+
+    MonotonicArena* arena() const {
+        return _arena;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const {
+        return _arena == other.arena();
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const {
+        return _arena != other.arena();
+    }
+
+private:
+    MonotonicArena* _arena;
+};
+
+}  // namespace mongo
@@ -0,0 +1,134 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/monotonic_arena.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+bool isAligned(void* p, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+}
+
+TEST(MonotonicArena, AllocationsAreAlignedAndDistinct) {
+    MonotonicArena arena;
+    auto a = static_cast<char*>(arena.allocate(3, 1));
+    auto b = static_cast<char*>(arena.allocate(8, 8));
+    auto c = static_cast<char*>(arena.allocate(1));
+    ASSERT(isAligned(b, 8));
+    ASSERT(isAligned(c, alignof(std::max_align_t)));
+    ASSERT_GTE(b, a + 3);
+    ASSERT_GTE(c, b + 8);
+    ASSERT_EQ(MonotonicArena::kBlockSize, arena.bytesReserved());
+}
+
+TEST(MonotonicArena, GrowsBlockByBlock) {
+    MonotonicArena arena;
+    for (size_t i = 0; i < MonotonicArena::kBlockSize; ++i) {
+        *static_cast<char*>(arena.allocate(16)) = 'x';
+    }
+    ASSERT_GT(arena.bytesReserved(), 16 * MonotonicArena::kBlockSize);
+    ASSERT_EQ(0U, arena.bytesReserved() % MonotonicArena::kBlockSize);
+
+    arena.reset();
+    ASSERT_EQ(0U, arena.bytesReserved());
+}
+
+TEST(MonotonicArena, OversizedAllocationKeepsCurrentBlock) {
+    MonotonicArena arena;
+    auto small = static_cast<char*>(arena.allocate(16));
+    const auto bigSize = MonotonicArena::kMaxInlineAllocation + 1;
+    auto big = static_cast<char*>(arena.allocate(bigSize));
+    std::fill(big, big + bigSize, 'x');
+    auto next = static_cast<char*>(arena.allocate(16));
+
+    ASSERT_EQ(small + 16, next);
+    ASSERT_GT(arena.bytesReserved(), MonotonicArena::kBlockSize + bigSize);
+}
+
+TEST(MonotonicArena, MakeRunsDestructorsOnReset) {
+    int destroyed = 0;
+    struct Counted {
+        explicit Counted(int* counter) : counter(counter) {}
+        ~Counted() {
+            ++*counter;
+        }
+        int* counter;
+    };
+
+    MonotonicArena arena;
+    for (int i = 0; i < 10; ++i) {
+        arena.make<Counted>(&destroyed);
+    }
+    auto str = arena.make<std::string>(100, 'x');
+    ASSERT_EQ(100U, str->size());
+    ASSERT_EQ(0, destroyed);
+
+    arena.reset();
+    ASSERT_EQ(10, destroyed);
+
+    arena.make<Counted>(&destroyed);
+    {
+        MonotonicArena other;
+        other.make<Counted>(&destroyed);
+    }
+    ASSERT_EQ(11, destroyed);
+}
+
+TEST(MonotonicArena, ReleasedBlocksAreReusedByTheThread) {
+    void* first;
+    {
+        MonotonicArena arena;
+        first = arena.allocate(16);
+    }
+    MonotonicArena arena;
+    ASSERT_EQ(first, arena.allocate(16));
+}
+
+TEST(MonotonicArena, ArenaAllocatorBacksContainers) {
+    MonotonicArena arena;
+    std::vector<int, ArenaAllocator<int>> vec{ArenaAllocator<int>(&arena)};
+    for (int i = 0; i < 1000; ++i) {
+        vec.push_back(i);
+    }
+    ASSERT_EQ(999, vec.back());
+    ASSERT_GT(arena.bytesReserved(), 1000 * sizeof(int));
+    ASSERT(vec.get_allocator() == ArenaAllocator<long>(&arena));
+}
+
+}  // namespace
+}  // namespace mongo
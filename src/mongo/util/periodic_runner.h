@@ -40,6 +40,7 @@
 
 namespace mongo {
 
+class BSONObjBuilder;
 class Client;
 class PeriodicJobAnchor;
 
@@ -131,6 +132,11 @@ public:
      * is interested in observing and controlling the job execution state.
      */
     virtual JobAnchor makeJob(PeriodicJob job) = 0;
+
+    /**
+     * Appends how often and for how long each job has run, if the runner keeps track of it.
+     */
+    virtual void appendStats(BSONObjBuilder* builder) const {}
 };
 
 /**
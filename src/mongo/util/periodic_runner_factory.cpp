@@ -31,13 +31,39 @@
 
 #include "mongo/util/periodic_runner_factory.h"
 
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/service_context.h"
 #include "mongo/util/periodic_runner_impl.h"
+#include "mongo/util/periodic_runner_parameters_gen.h"
 
 namespace mongo {
 
 std::unique_ptr<PeriodicRunner> makePeriodicRunner(ServiceContext* svc) {
-    return std::make_unique<PeriodicRunnerImpl>(svc, svc->getPreciseClockSource());
+    return std::make_unique<PeriodicRunnerImpl>(
+        svc, svc->getPreciseClockSource(), gPeriodicRunnerSharedThreadCount);
 }
 
+namespace {
+
+class PeriodicJobsServerStatusSection final : public ServerStatusSection {
+public:
+    PeriodicJobsServerStatusSection() : ServerStatusSection("periodicJobs") {}
+
+    bool includeByDefault() const override {
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        if (auto runner = opCtx->getServiceContext()->getPeriodicRunner()) {
+            runner->appendStats(&builder);
+        }
+        return builder.obj();
+    }
+} periodicJobsServerStatusSection;
+
+}  // namespace
+
 }  // namespace mongo
@@ -33,28 +33,90 @@
 
 #include "mongo/util/periodic_runner_impl.h"
 
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/client.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/clock_source.h"
+#include "mongo/util/concurrency/thread_name.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
-PeriodicRunnerImpl::PeriodicRunnerImpl(ServiceContext* svc, ClockSource* clockSource)
-    : _svc(svc), _clockSource(clockSource) {}
+PeriodicRunnerImpl::PeriodicRunnerImpl(ServiceContext* svc,
+                                       ClockSource* clockSource,
+                                       size_t sharedThreadCount)
+    : _svc(svc), _clockSource(clockSource) {
+    if (sharedThreadCount > 0) {
+        _pool = std::make_shared<JobPool>(clockSource, sharedThreadCount);
+    }
+}
+
+PeriodicRunnerImpl::~PeriodicRunnerImpl() {
+    if (_pool) {
+        _pool->shutdown();
+    }
+}
 
 auto PeriodicRunnerImpl::makeJob(PeriodicJob job) -> JobAnchor {
-    auto impl = std::make_shared<PeriodicJobImpl>(std::move(job), this->_clockSource, this->_svc);
+    auto stats = _makeJobStats(job.name);
+    if (_pool) {
+        return JobAnchor(
+            std::make_shared<PooledJobImpl>(std::move(job), _svc, _pool, std::move(stats)));
+    }
+
+    auto impl = std::make_shared<PeriodicJobImpl>(
+        std::move(job), this->_clockSource, this->_svc, std::move(stats));
 
     JobAnchor anchor(std::move(impl));
     return anchor;
 }
 
+std::shared_ptr<PeriodicRunnerImpl::JobStats> PeriodicRunnerImpl::_makeJobStats(
+    const std::string& jobName) {
+    auto stats = std::make_shared<JobStats>(jobName);
+
+    stdx::lock_guard lk(_statsMutex);
+    _jobStats.erase(std::remove_if(_jobStats.begin(),
+                                   _jobStats.end(),
+                                   [](const auto& jobStats) { return jobStats.expired(); }),
+                    _jobStats.end());
+    _jobStats.push_back(stats);
+    return stats;
+}
+
+void PeriodicRunnerImpl::appendStats(BSONObjBuilder* builder) const {
+    builder->append("sharedThreads", _pool ? static_cast<long long>(_pool->threadCount()) : 0LL);
+
+    BSONArrayBuilder jobsBuilder(builder->subarrayStart("jobs"));
+    stdx::lock_guard lk(_statsMutex);
+    for (auto&& weakStats : _jobStats) {
+        auto stats = weakStats.lock();
+        if (!stats) {
+            continue;
+        }
+
+        BSONObjBuilder jobBuilder(jobsBuilder.subobjStart());
+        jobBuilder.append("name", stats->name);
+        jobBuilder.append("runs", stats->runs.load());
+        jobBuilder.append("totalMillis", stats->totalMillis.load());
+        jobBuilder.append("lastMillis", stats->lastMillis.load());
+    }
+}
+
+void PeriodicRunnerImpl::JobStats::recordRun(Milliseconds elapsed) {
+    runs.fetchAndAdd(1);
+    totalMillis.fetchAndAdd(durationCount<Milliseconds>(elapsed));
+    lastMillis.store(durationCount<Milliseconds>(elapsed));
+}
+
 PeriodicRunnerImpl::PeriodicJobImpl::PeriodicJobImpl(PeriodicJob job,
                                                      ClockSource* source,
-                                                     ServiceContext* svc)
-    : _job(std::move(job)), _clockSource(source), _serviceContext(svc) {}
+                                                     ServiceContext* svc,
+                                                     std::shared_ptr<JobStats> stats)
+    : _job(std::move(job)), _clockSource(source), _serviceContext(svc), _stats(std::move(stats)) {}
 
 void PeriodicRunnerImpl::PeriodicJobImpl::_run() {
     auto [startPromise, startFuture] = makePromiseFuture<void>();
@@ -73,7 +135,7 @@ void PeriodicRunnerImpl::PeriodicJobImpl::_run() {
         // Let start() know we're running
         {
             stdx::lock_guard lk(_mutex);
-            _execStatus = PeriodicJobImpl::ExecutionStatus::RUNNING;
+            _execStatus = ExecutionStatus::RUNNING;
         }
         startPromise.emplaceValue();
 
@@ -90,6 +152,7 @@ void PeriodicRunnerImpl::PeriodicJobImpl::_run() {
             // Unlock while job is running so we can pause/cancel concurrently
             lk.unlock();
             _job.job(Client::getCurrent());
+            _stats->recordRun(_clockSource->now() - start);
             lk.lock();
 
             auto getDeadlineFromInterval = [&] { return start + _job.interval; };
@@ -121,15 +184,15 @@ void PeriodicRunnerImpl::PeriodicJobImpl::start() {
 
 void PeriodicRunnerImpl::PeriodicJobImpl::pause() {
     stdx::lock_guard<Latch> lk(_mutex);
-    invariant(_execStatus == PeriodicJobImpl::ExecutionStatus::RUNNING);
-    _execStatus = PeriodicJobImpl::ExecutionStatus::PAUSED;
+    invariant(_execStatus == ExecutionStatus::RUNNING);
+    _execStatus = ExecutionStatus::PAUSED;
 }
 
 void PeriodicRunnerImpl::PeriodicJobImpl::resume() {
     {
         stdx::lock_guard<Latch> lk(_mutex);
-        invariant(_execStatus == PeriodicJobImpl::ExecutionStatus::PAUSED);
-        _execStatus = PeriodicJobImpl::ExecutionStatus::RUNNING;
+        invariant(_execStatus == ExecutionStatus::PAUSED);
+        _execStatus = ExecutionStatus::RUNNING;
     }
     _condvar.notify_one();
 }
@@ -166,9 +229,179 @@ void PeriodicRunnerImpl::PeriodicJobImpl::setPeriod(Milliseconds ms) {
     stdx::lock_guard<Latch> lk(_mutex);
     _job.interval = ms;
 
-    if (_execStatus == PeriodicJobImpl::ExecutionStatus::RUNNING) {
+    if (_execStatus == ExecutionStatus::RUNNING) {
         _condvar.notify_one();
     }
 }
 
+void PeriodicRunnerImpl::JobPool::add(std::shared_ptr<PooledJobImpl> job) {
+    {
+        stdx::lock_guard lk(_mutex);
+        if (_inShutdown) {
+            // The runner is gone, so the job is left stopped like any other job in shutdown.
+            return;
+        }
+        _jobs.push_back(std::move(job));
+
+        // Threads only start with the first job so that a runner nobody uses costs nothing.
+        while (_threads.size() < _threadCount) {
+            _threads.emplace_back([this, threadNum = _threads.size()] {
+                const auto threadName = "PeriodicJobPool-" + std::to_string(threadNum);
+                setThreadName(threadName);
+                _runJobs(threadName);
+            });
+        }
+    }
+    _condvar.notify_all();
+}
+
+void PeriodicRunnerImpl::JobPool::remove(PooledJobImpl* job) {
+    stdx::unique_lock lk(_mutex);
+    _condvar.wait(lk, [&] { return !job->_executing; });
+
+    auto it = std::find_if(
+        _jobs.begin(), _jobs.end(), [&](const auto& pooledJob) { return pooledJob.get() == job; });
+    if (it != _jobs.end()) {
+        _jobs.erase(it);
+    }
+}
+
+void PeriodicRunnerImpl::JobPool::notify() {
+    _condvar.notify_all();
+}
+
+void PeriodicRunnerImpl::JobPool::shutdown() {
+    {
+        stdx::lock_guard lk(_mutex);
+        _inShutdown = true;
+    }
+    _condvar.notify_all();
+
+    for (auto&& thread : _threads) {
+        thread.join();
+    }
+}
+
+void PeriodicRunnerImpl::JobPool::_runJobs(const std::string& threadName) {
+    stdx::unique_lock lk(_mutex);
+    while (!_inShutdown) {
+        // There are only ever a few dozen jobs, so finding the one which is due first by scanning
+        // all of them is cheaper than keeping them ordered across pauses and period changes.
+        std::shared_ptr<PooledJobImpl> next;
+        for (auto&& job : _jobs) {
+            if (job->_execStatus != ExecutionStatus::RUNNING || job->_executing) {
+                continue;
+            }
+            if (!next || job->_nextRunDate() < next->_nextRunDate()) {
+                next = job;
+            }
+        }
+
+        if (!next) {
+            _condvar.wait(lk);
+            continue;
+        }
+
+        auto deadline = next->_nextRunDate();
+        if (deadline > _clockSource->now()) {
+            // Any change to the jobs notifies the condvar, after which the choice is made again.
+            _clockSource->waitForConditionUntil(_condvar, lk, deadline);
+            continue;
+        }
+
+        next->_executing = true;
+        auto start = _clockSource->now();
+        next->_lastStart = start;
+
+        // The job's Client is only touched by the thread which set '_executing'.
+        lk.unlock();
+        {
+            auto restoreThreadName = makeGuard([&] { setThreadName(threadName); });
+            setThreadName(next->_job.name);
+            Client::setCurrent(std::move(next->_client));
+            auto releaseClient = makeGuard([&] { next->_client = Client::releaseCurrent(); });
+
+            next->_job.job(Client::getCurrent());
+        }
+        next->_stats->recordRun(_clockSource->now() - start);
+        lk.lock();
+
+        next->_executing = false;
+        _condvar.notify_all();
+    }
+}
+
+PeriodicRunnerImpl::PooledJobImpl::PooledJobImpl(PeriodicJob job,
+                                                 ServiceContext* svc,
+                                                 std::shared_ptr<JobPool> pool,
+                                                 std::shared_ptr<JobStats> stats)
+    : _job(std::move(job)),
+      _serviceContext(svc),
+      _pool(std::move(pool)),
+      _stats(std::move(stats)) {}
+
+void PeriodicRunnerImpl::PooledJobImpl::start() {
+    LOGV2_DEBUG(5212053,
+                2,
+                "Starting periodic job {job_name} on a shared thread",
+                "job_name"_attr = _job.name);
+
+    {
+        stdx::lock_guard lk(_pool->_mutex);
+        invariant(_execStatus == ExecutionStatus::NOT_SCHEDULED);
+        _client = _serviceContext->makeClient(_job.name);
+        _execStatus = ExecutionStatus::RUNNING;
+    }
+    _pool->add(shared_from_this());
+}
+
+void PeriodicRunnerImpl::PooledJobImpl::pause() {
+    stdx::lock_guard lk(_pool->_mutex);
+    invariant(_execStatus == ExecutionStatus::RUNNING);
+    _execStatus = ExecutionStatus::PAUSED;
+}
+
+void PeriodicRunnerImpl::PooledJobImpl::resume() {
+    {
+        stdx::lock_guard lk(_pool->_mutex);
+        invariant(_execStatus == ExecutionStatus::PAUSED);
+        _execStatus = ExecutionStatus::RUNNING;
+    }
+    _pool->notify();
+}
+
+void PeriodicRunnerImpl::PooledJobImpl::stop() {
+    auto lastExecStatus = [&] {
+        stdx::lock_guard lk(_pool->_mutex);
+        return std::exchange(_execStatus, ExecutionStatus::CANCELED);
+    }();
+
+    // If we never started, then nobody should wait
+    if (lastExecStatus == ExecutionStatus::NOT_SCHEDULED ||
+        lastExecStatus == ExecutionStatus::CANCELED) {
+        return;
+    }
+
+    LOGV2_DEBUG(5212054,
+                2,
+                "Stopping periodic job {job_name} on a shared thread",
+                "job_name"_attr = _job.name);
+
+    _pool->remove(this);
+    _client.reset();
+}
+
+Milliseconds PeriodicRunnerImpl::PooledJobImpl::getPeriod() {
+    stdx::lock_guard lk(_pool->_mutex);
+    return _job.interval;
+}
+
+void PeriodicRunnerImpl::PooledJobImpl::setPeriod(Milliseconds ms) {
+    {
+        stdx::lock_guard lk(_pool->_mutex);
+        _job.interval = ms;
+    }
+    _pool->notify();
+}
+
 }  // namespace mongo
@@ -29,9 +29,13 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/thread.h"
@@ -45,23 +49,48 @@ class Client;
 class ServiceContext;
 
 /**
- * An implementation of the PeriodicRunner which uses a thread per job and condvar waits on those
- * threads to independently sleep.
+ * An implementation of the PeriodicRunner which by default uses a thread per job and condvar waits
+ * on those threads to independently sleep. When it is given a number of shared threads, jobs
+ * instead take turns on that many threads, each of which runs whichever job is due first.
  */
 class PeriodicRunnerImpl : public PeriodicRunner {
 public:
-    PeriodicRunnerImpl(ServiceContext* svc, ClockSource* clockSource);
+    PeriodicRunnerImpl(ServiceContext* svc, ClockSource* clockSource, size_t sharedThreadCount = 0);
+
+    ~PeriodicRunnerImpl();
 
     JobAnchor makeJob(PeriodicJob job) override;
 
+    void appendStats(BSONObjBuilder* builder) const override;
+
 private:
+    /**
+     * How often and for how long a job has run, shared between the job and the runner so that the
+     * runner can report on jobs its caller owns.
+     */
+    struct JobStats {
+        explicit JobStats(std::string jobName) : name(std::move(jobName)) {}
+
+        void recordRun(Milliseconds elapsed);
+
+        const std::string name;
+        AtomicWord<long long> runs{0};
+        AtomicWord<long long> totalMillis{0};
+        AtomicWord<long long> lastMillis{0};
+    };
+
+    enum class ExecutionStatus { NOT_SCHEDULED, RUNNING, PAUSED, CANCELED };
+
     class PeriodicJobImpl : public ControllableJob {
         PeriodicJobImpl(const PeriodicJobImpl&) = delete;
         PeriodicJobImpl& operator=(const PeriodicJobImpl&) = delete;
 
     public:
         friend class PeriodicRunnerImpl;
-        PeriodicJobImpl(PeriodicJob job, ClockSource* source, ServiceContext* svc);
+        PeriodicJobImpl(PeriodicJob job,
+                        ClockSource* source,
+                        ServiceContext* svc,
+                        std::shared_ptr<JobStats> stats);
 
         void start() override;
         void pause() override;
@@ -70,14 +99,13 @@ private:
         Milliseconds getPeriod() override;
         void setPeriod(Milliseconds ms) override;
 
-        enum class ExecutionStatus { NOT_SCHEDULED, RUNNING, PAUSED, CANCELED };
-
     private:
         void _run();
 
         PeriodicJob _job;
         ClockSource* _clockSource;
         ServiceContext* _serviceContext;
+        std::shared_ptr<JobStats> _stats;
 
         stdx::thread _thread;
         SharedPromise<void> _stopPromise;
@@ -90,10 +118,112 @@ private:
         ExecutionStatus _execStatus{ExecutionStatus::NOT_SCHEDULED};
     };
 
-    std::shared_ptr<PeriodicRunnerImpl::PeriodicJobImpl> createAndAddJob(PeriodicJob job);
+    class PooledJobImpl;
+
+    /**
+     * The threads which run pooled jobs and the jobs they choose from. Jobs hold on to it so that
+     * stopping a job stays safe even if the runner has gone away first.
+     */
+    class JobPool {
+        JobPool(const JobPool&) = delete;
+        JobPool& operator=(const JobPool&) = delete;
+
+    public:
+        JobPool(ClockSource* clockSource, size_t threadCount)
+            : _clockSource(clockSource), _threadCount(threadCount) {}
+
+        /**
+         * Makes 'job' eligible to run, starting the pool's threads with the first job.
+         */
+        void add(std::shared_ptr<PooledJobImpl> job);
+
+        /**
+         * Waits for 'job' to finish any run in progress and makes it ineligible to run again.
+         */
+        void remove(PooledJobImpl* job);
+
+        /**
+         * Wakes up the pool's threads after a job was resumed or had its period changed.
+         */
+        void notify();
+
+        void shutdown();
+
+        size_t threadCount() const {
+            return _threadCount;
+        }
+
+    private:
+        friend class PooledJobImpl;
+
+        void _runJobs(const std::string& threadName);
+
+        ClockSource* const _clockSource;
+        const size_t _threadCount;
+
+        Mutex _mutex = MONGO_MAKE_LATCH("PeriodicRunnerImpl::JobPool::_mutex");
+        stdx::condition_variable _condvar;
+        std::vector<stdx::thread> _threads;
+
+        // Started jobs which have not been stopped yet. Along with the jobs' execution state, this
+        // is guarded by '_mutex'.
+        std::vector<std::shared_ptr<PooledJobImpl>> _jobs;
+
+        bool _inShutdown = false;
+    };
+
+    class PooledJobImpl : public ControllableJob,
+                          public std::enable_shared_from_this<PooledJobImpl> {
+        PooledJobImpl(const PooledJobImpl&) = delete;
+        PooledJobImpl& operator=(const PooledJobImpl&) = delete;
+
+    public:
+        PooledJobImpl(PeriodicJob job,
+                      ServiceContext* svc,
+                      std::shared_ptr<JobPool> pool,
+                      std::shared_ptr<JobStats> stats);
+
+        void start() override;
+        void pause() override;
+        void resume() override;
+        void stop() override;
+        Milliseconds getPeriod() override;
+        void setPeriod(Milliseconds ms) override;
+
+    private:
+        friend class JobPool;
+
+        /**
+         * Returns when the job should next run. A job which has never run is due immediately.
+         */
+        Date_t _nextRunDate() const {
+            return _lastStart ? *_lastStart + _job.interval : Date_t::min();
+        }
+
+        PeriodicJob _job;
+        ServiceContext* _serviceContext;
+        std::shared_ptr<JobPool> _pool;
+        std::shared_ptr<JobStats> _stats;
+
+        // The Client the job runs with, which is installed on whichever pool thread runs it.
+        ServiceContext::UniqueClient _client;
+
+        // The remaining state is guarded by the pool's mutex.
+        ExecutionStatus _execStatus{ExecutionStatus::NOT_SCHEDULED};
+        bool _executing = false;
+        boost::optional<Date_t> _lastStart;
+    };
+
+    std::shared_ptr<JobStats> _makeJobStats(const std::string& jobName);
 
     ServiceContext* _svc;
     ClockSource* _clockSource;
+
+    // Only set when jobs run on shared threads.
+    std::shared_ptr<JobPool> _pool;
+
+    mutable Mutex _statsMutex = MONGO_MAKE_LATCH("PeriodicRunnerImpl::_statsMutex");
+    mutable std::vector<std::weak_ptr<JobStats>> _jobStats;
 };
 
 }  // namespace mongo
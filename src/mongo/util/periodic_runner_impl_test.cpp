@@ -33,9 +33,15 @@
 
 #include "mongo/util/periodic_runner_impl.h"
 
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/stdx/unordered_set.h"
 #include "mongo/util/clock_source_mock.h"
 
 namespace mongo {
@@ -437,5 +443,156 @@ TEST_F(PeriodicRunnerImplTest, ChangingIntervalWorks) {
     tearDown();
 }
 
+class PeriodicRunnerImplSharedThreadsTest : public ServiceContextTest {
+public:
+    void setUp() override {
+        _clockSource = std::make_unique<ClockSourceMock>();
+        _runner = std::make_unique<PeriodicRunnerImpl>(
+            getServiceContext(), _clockSource.get(), 1 /* sharedThreadCount */);
+    }
+
+    ClockSourceMock& clockSource() {
+        return *_clockSource;
+    }
+
+    PeriodicRunner& runner() {
+        return *_runner;
+    }
+
+private:
+    std::unique_ptr<ClockSourceMock> _clockSource;
+    std::unique_ptr<PeriodicRunner> _runner;
+};
+
+TEST_F(PeriodicRunnerImplSharedThreadsTest, JobsTakeTurnsOnASharedThread) {
+    const size_t kNumJobs = 3;
+    std::vector<int> counts(kNumJobs, 0);
+    std::vector<std::string> clientNames(kNumJobs);
+    stdx::unordered_set<stdx::thread::id> threadIds;
+    Milliseconds interval{5};
+
+    auto mutex = MONGO_MAKE_LATCH();
+    stdx::condition_variable cv;
+
+    std::vector<PeriodicRunner::JobAnchor> anchors;
+    for (size_t i = 0; i < kNumJobs; ++i) {
+        PeriodicRunner::PeriodicJob job("job" + std::to_string(i),
+                                        [&, i](Client* client) {
+                                            {
+                                                stdx::unique_lock<Latch> lk(mutex);
+                                                counts[i]++;
+                                                clientNames[i] = client->desc();
+                                                threadIds.insert(stdx::this_thread::get_id());
+                                            }
+                                            cv.notify_all();
+                                        },
+                                        interval);
+        anchors.push_back(runner().makeJob(std::move(job)));
+        anchors.back().start();
+    }
+
+    // Every job runs once per interval even though there is a single thread to run them.
+    for (int i = 0; i < 10; i++) {
+        {
+            stdx::unique_lock<Latch> lk(mutex);
+            cv.wait(lk, [&] {
+                return std::all_of(
+                    counts.begin(), counts.end(), [&](int count) { return count > i; });
+            });
+        }
+        clockSource().advance(interval);
+    }
+
+    stdx::lock_guard<Latch> lk(mutex);
+    ASSERT_EQ(1ul, threadIds.size());
+    for (size_t i = 0; i < kNumJobs; ++i) {
+        ASSERT_EQ("job" + std::to_string(i), clientNames[i]);
+    }
+}
+
+TEST_F(PeriodicRunnerImplSharedThreadsTest, PausedAndStoppedJobsDoNotRun) {
+    int count = 0;
+    bool isPaused = false;
+    Milliseconds interval{5};
+
+    auto mutex = MONGO_MAKE_LATCH();
+    stdx::condition_variable cv;
+
+    PeriodicRunner::PeriodicJob job("job",
+                                    [&](Client*) {
+                                        {
+                                            stdx::unique_lock<Latch> lk(mutex);
+                                            // This will fail if pause does not work correctly.
+                                            ASSERT_FALSE(isPaused);
+                                            count++;
+                                        }
+                                        cv.notify_all();
+                                    },
+                                    interval);
+
+    auto jobAnchor = runner().makeJob(std::move(job));
+    jobAnchor.start();
+    {
+        stdx::unique_lock<Latch> lk(mutex);
+        cv.wait(lk, [&] { return count == 1; });
+        isPaused = true;
+        jobAnchor.pause();
+    }
+
+    for (int i = 0; i < 10; i++) {
+        clockSource().advance(interval);
+    }
+
+    {
+        stdx::unique_lock<Latch> lk(mutex);
+        isPaused = false;
+        jobAnchor.resume();
+        cv.wait(lk, [&] { return count == 2; });
+    }
+
+    jobAnchor.stop();
+    for (int i = 0; i < 10; i++) {
+        clockSource().advance(interval);
+    }
+
+    stdx::lock_guard<Latch> lk(mutex);
+    ASSERT_EQ(2, count);
+}
+
+TEST_F(PeriodicRunnerImplSharedThreadsTest, StatsReportEachJob) {
+    int count = 0;
+
+    auto mutex = MONGO_MAKE_LATCH();
+    stdx::condition_variable cv;
+
+    PeriodicRunner::PeriodicJob job("statsJob",
+                                    [&](Client*) {
+                                        {
+                                            stdx::unique_lock<Latch> lk(mutex);
+                                            count++;
+                                        }
+                                        cv.notify_all();
+                                    },
+                                    Milliseconds(5));
+
+    auto jobAnchor = runner().makeJob(std::move(job));
+    jobAnchor.start();
+    {
+        stdx::unique_lock<Latch> lk(mutex);
+        cv.wait(lk, [&] { return count == 1; });
+    }
+    jobAnchor.stop();
+
+    BSONObjBuilder builder;
+    runner().appendStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(1, stats["sharedThreads"].numberLong());
+
+    auto jobs = stats["jobs"].Array();
+    ASSERT_EQ(1ul, jobs.size());
+    ASSERT_EQ("statsJob", jobs[0]["name"].str());
+    ASSERT_EQ(1, jobs[0]["runs"].numberLong());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -35,9 +35,11 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/unordered_set.h"
 #include "mongo/util/concurrency/thread_pool_interface.h"
 #include "mongo/util/functional.h"
 #include "mongo/util/invalidating_lru_cache.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -71,17 +73,18 @@ protected:
      * std::lock_guard, and perform reads or writes of the cache.
      *
      * Alternatively, one may instantiate the guard, examine the cache, and then enter into an
-     * update mode by first wait()ing until otherUpdateInFetchPhase() is false, and then
+     * update mode by first wait()ing until no other thread is fetching the same key, and then
      * calling beginFetchPhase().  At this point, other threads may acquire the guard in the simple
-     * manner and do reads, but other threads may not enter into a fetch phase.  During the fetch
-     * phase, the thread should perform required network or disk activity to determine what update
-     * it will make to the cache.  Then, it should call endFetchPhase(), to reacquire the cache
-     * mutex.  At that point, the thread can make its modifications to the cache and let the guard
-     * go out of scope.
+     * manner and do reads, or enter into a fetch phase of their own for different keys.  Keeping
+     * track of which keys are being fetched is up to the caller.  During the fetch phase, the
+     * thread should perform required network or disk activity to determine what update it will
+     * make to the cache.  Then, it should call endFetchPhase(), to reacquire the cache mutex.  At
+     * that point, the thread can make its modifications to the cache and let the guard go out of
+     * scope.
      *
-     * All updates by guards using a fetch-phase are totally ordered with respect to one another,
-     * and all guards using no fetch phase are totally ordered with respect to one another, but
-     * there is not a total ordering among all guard objects.
+     * All guards using no fetch phase are totally ordered with respect to one another, but fetch
+     * phases for different keys may overlap, so there is not a total ordering among all guard
+     * objects.
      *
      * The cached data has an associated counter, called the cache generation.  If the cache
      * generation changes while a guard is in fetch phase, the fetched data should not be stored
@@ -108,26 +111,18 @@ protected:
             }
 
             if (_isThisGuardInFetchPhase) {
-                invariant(otherUpdateInFetchPhase());
-                _distCache->_isFetchPhaseBusy = false;
                 _distCache->_fetchPhaseIsReady.notify_all();
             }
         }
 
         /**
-         * Returns true if the distCache reports that it is in fetch phase.
-         */
-        bool otherUpdateInFetchPhase() const {
-            return _distCache->_isFetchPhaseBusy;
-        }
-
-        /**
-         * Waits on the _distCache->_fetchPhaseIsReady condition.
+         * Waits on the _distCache->_fetchPhaseIsReady condition, which is signalled every time a
+         * guard which was in fetch phase goes out of scope. Callers must re-check the state they
+         * are waiting on after this returns.
          */
         void wait() {
             invariant(!_isThisGuardInFetchPhase);
-            _distCache->_fetchPhaseIsReady.wait(_cacheLock,
-                                                [&] { return !otherUpdateInFetchPhase(); });
+            _distCache->_fetchPhaseIsReady.wait(_cacheLock);
         }
 
         /**
@@ -135,25 +130,27 @@ protected:
          * cache generation.
          */
         void beginFetchPhase() {
-            invariant(!otherUpdateInFetchPhase());
+            invariant(!_isThisGuardInFetchPhase);
             _isThisGuardInFetchPhase = true;
-            _distCache->_isFetchPhaseBusy = true;
             _distCacheFetchGenerationAtFetchBegin = _distCache->_fetchGeneration;
             _cacheLock.unlock();
         }
 
         /**
-         * Exits the fetch phase, reacquiring the _distCache->_cacheMutex.
+         * Exits the fetch phase, reacquiring the _distCache->_cacheMutex if it is not already
+         * held.
          */
         void endFetchPhase() {
-            _cacheLock.lock();
-            // We do not clear _distCache->_isFetchPhaseBusy or notify waiters until
-            // ~CacheGuard(), for two reasons.  First, there's no value to notifying the waiters
-            // before you're ready to release the mutex, because they'll just go to sleep on the
-            // mutex.  Second, in order to meaningfully check the preconditions of
-            // isSameCacheGeneration(), we need a state that means "fetch phase was entered and now
-            // has been exited."  That state is _isThisGuardInFetchPhase == true and
-            // _lock.owns_lock() == true.
+            invariant(_isThisGuardInFetchPhase);
+            if (!_cacheLock.owns_lock()) {
+                _cacheLock.lock();
+            }
+            // We do not notify waiters until ~CacheGuard(), for two reasons.  First, there's no
+            // value to notifying the waiters before you're ready to release the mutex, because
+            // they'll just go to sleep on the mutex.  Second, in order to meaningfully check the
+            // preconditions of isSameCacheGeneration(), we need a state that means "fetch phase
+            // was entered and now has been exited."  That state is _isThisGuardInFetchPhase ==
+            // true and _lock.owns_lock() == true.
         }
 
         /**
@@ -203,7 +200,8 @@ protected:
     ThreadPoolInterface& _threadPool;
 
     /**
-     * Protects _fetchGeneration and _isFetchPhaseBusy.  Manipulated via CacheGuard.
+     * Protects _fetchGeneration and the set of keys being fetched by the templated sub-class.
+     * Manipulated via CacheGuard.
      */
     Mutex& _cacheWriteMutex;
 
@@ -214,16 +212,8 @@ protected:
     OID _fetchGeneration{OID::gen()};
 
     /**
-     * True if there is an update to the _cache in progress, and that update is currently in
-     * the "fetch phase", during which it does not hold the _cacheMutex.
-     *
-     * Manipulated via CacheGuard.
-     */
-    bool _isFetchPhaseBusy{false};
-
-    /**
-     * Condition used to signal that it is OK for another CacheGuard to enter a fetch phase.
-     * Manipulated via CacheGuard.
+     * Condition used to signal that a CacheGuard has left its fetch phase, so that threads waiting
+     * for the same key can check the cache again. Manipulated via CacheGuard.
      */
     stdx::condition_variable _fetchPhaseIsReady;
 };
@@ -314,6 +304,9 @@ public:
      * the backing store, returns a ValueHandle which defaults to not-set (it's bool operator is
      * false).
      *
+     * Only one thread at a time fetches any given key; concurrent callers for the same key wait
+     * for its result, while callers for other keys are never blocked behind it.
+     *
      * NOTES:
      *  This is a potentially blocking method.
      *  The returned value may be invalid by the time the caller gets access to it.
@@ -325,10 +318,10 @@ public:
                 return ValueHandle(std::move(cachedValue));
 
             // Otherwise make sure we have the locks we need and check whether and wait on another
-            // thread is fetching into the cache
+            // thread is fetching the same key into the cache
             CacheGuard guard(this);
 
-            while (!(cachedValue = _cache.get(key)) && guard.otherUpdateInFetchPhase()) {
+            while (!(cachedValue = _cache.get(key)) && _keysInFetchPhase.count(key)) {
                 guard.wait();
             }
 
@@ -337,7 +330,12 @@ public:
 
             // If there's still no value in the cache, then we need to go and get it. Take the slow
             // path.
+            _keysInFetchPhase.insert(key);
             guard.beginFetchPhase();
+            ON_BLOCK_EXIT([&] {
+                guard.endFetchPhase();
+                _keysInFetchPhase.erase(key);
+            });
 
             auto value = lookup(opCtx, key);
             if (!value)
@@ -419,6 +417,10 @@ private:
     virtual boost::optional<Value> lookup(OperationContext* opCtx, const Key& key) = 0;
 
     Cache _cache;
+
+    // Keys for which some thread is currently in the fetch phase of 'acquire'. Protected by
+    // CacheGuard.
+    stdx::unordered_set<Key> _keysInFetchPhase;
 };
 
 }  // namespace mongo
@@ -31,8 +31,11 @@
 
 #include <string>
 
+#include "mongo/db/client.h"
 #include "mongo/db/service_context_test_fixture.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/notification.h"
 #include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/read_through_cache.h"
 
@@ -117,5 +120,43 @@ TEST_F(ReadThroughCacheTest, CacheSizeZero) {
     }
 }
 
+TEST_F(ReadThroughCacheTest, SlowLookupDoesNotBlockLookupsOfOtherKeys) {
+    Notification<void> slowLookupStarted;
+    Notification<void> unblockSlowLookup;
+    AtomicWord<int> countLookups{0};
+    Cache cache(getServiceContext(), 10, [&](OperationContext*, const std::string& key) {
+        countLookups.addAndFetch(1);
+        if (key == "SlowKey") {
+            slowLookupStarted.set();
+            unblockSlowLookup.get();
+        }
+        return CachedValue{static_cast<int>(key.size())};
+    });
+
+    auto fetchSlowKey = [&] {
+        ThreadClient tc(getServiceContext());
+        auto opCtx = tc->makeOperationContext();
+        auto value = cache.acquire(opCtx.get(), "SlowKey");
+        ASSERT(value);
+        ASSERT_EQ(7, value->counter);
+    };
+    stdx::thread slowThread(fetchSlowKey);
+    slowLookupStarted.get();
+
+    // A second user of the slow key must wait for the first one to finish rather than issue its
+    // own lookup, but it must not block users of other keys.
+    stdx::thread waitingThread(fetchSlowKey);
+
+    auto value = cache.acquire(_opCtx, "FastKey");
+    ASSERT(value);
+    ASSERT_EQ(7, value->counter);
+    ASSERT_EQ(2, countLookups.load());
+
+    unblockSlowLookup.set();
+    slowThread.join();
+    waitingThread.join();
+    ASSERT_EQ(2, countLookups.load());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,98 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/with_alignment.h"
+
+namespace mongo {
+
+/**
+ * Returns the shard, below 'numShards', that the calling thread should update. Threads running on
+ * the same CPU share a shard, so that shards updated concurrently are normally updated from
+ * different CPUs. Falls back to a shard per thread where the current CPU is not known.
+ */
+inline size_t currentCpuShard(size_t numShards) {
+#ifdef __linux__
+    auto cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return static_cast<size_t>(cpu) % numShards;
+    }
+#endif
+    thread_local const size_t threadHash =
+        std::hash<stdx::thread::id>()(stdx::this_thread::get_id());
+    return threadHash % numShards;
+}
+
+/**
+ * A counter for statistics that are updated far more often than they are read. Each CPU adds to
+ * its own cache line, so concurrent increments do not contend for one; reading sums the shards.
+ * Reads are not a consistent snapshot of concurrent increments.
+ */
+class ShardedCounter {
+public:
+    static constexpr size_t kNumShards = 32;
+
+    /**
+     * Adds 'n' and returns the previous value of the shard it was added to, which callers can use
+     * to detect a shard approaching overflow without summing every shard.
+     */
+    long long add(long long n) {
+        return _shards[currentCpuShard(kNumShards)].fetchAndAddRelaxed(n);
+    }
+
+    long long get() const {
+        long long total = 0;
+        for (const auto& shard : _shards) {
+            total += shard.loadRelaxed();
+        }
+        return total;
+    }
+
+    void reset() {
+        for (auto& shard : _shards) {
+            shard.store(0);
+        }
+    }
+
+private:
+    std::array<CacheAligned<AtomicWord<long long>>, kNumShards> _shards;
+};
+
+}  // namespace mongo
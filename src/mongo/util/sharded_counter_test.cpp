@@ -0,0 +1,78 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/sharded_counter.h"
+
+#include <vector>
+
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(ShardedCounterTest, SumsConcurrentIncrements) {
+    ShardedCounter counter;
+    ASSERT_EQ(counter.get(), 0);
+
+    const int kThreads = 8;
+    const int kIncrements = 10000;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kIncrements; ++j) {
+                counter.add(2);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(counter.get(), 2LL * kThreads * kIncrements);
+
+    counter.reset();
+    ASSERT_EQ(counter.get(), 0);
+}
+
+TEST(ShardedCounterTest, AddReturnsPreviousShardValue) {
+    ShardedCounter counter;
+    ASSERT_EQ(counter.add(5), 0);
+    ASSERT_EQ(counter.get(), 5);
+}
+
+TEST(ShardedCounterTest, CurrentCpuShardIsInRange) {
+    for (size_t numShards : {1, 3, 32}) {
+        ASSERT_LT(currentCpuShard(numShards), numShards);
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -38,6 +38,7 @@
 
 #include "mongo/util/allocator.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/shared_buffer_pool.h"
 
 namespace mongo {
 
@@ -56,6 +57,23 @@ public:
         return takeOwnership(mongoMalloc(sizeof(Holder) + bytes), bytes);
     }
 
+    /**
+     * Like allocate(), but rounds 'bytes' up to a SharedBufferPool size class so the memory is
+     * recycled by the releasing thread instead of going back to the allocator. Requests larger
+     * than the largest size class are served by allocate().
+     */
+    static SharedBuffer allocatePooled(size_t bytes) {
+        const auto capacity = SharedBufferPool::roundUp(bytes);
+        if (!capacity) {
+            return allocate(bytes);
+        }
+
+        auto buf = takeOwnership(SharedBufferPool::acquire(capacity, sizeof(Holder) + capacity),
+                                 capacity);
+        buf._holder->_pooled = true;
+        return buf;
+    }
+
     /**
      * Resizes the buffer, copying the current contents.
      *
@@ -67,6 +85,19 @@ public:
     void realloc(size_t size) {
         invariant(!_holder || !_holder->isShared());
 
+        if (_holder && _holder->_pooled && size <= SharedBufferPool::kLargestSizeClass) {
+            // Pooled blocks must go back through the pool, so move to a new pooled buffer rather
+            // than resizing in place. Growing past the largest size class resizes in place below
+            // and the result is no longer pooled, which keeps large replies from paying for an
+            // extra allocation and copy on every doubling.
+            auto tmp = SharedBuffer::allocatePooled(size);
+            memcpy(tmp._holder->data(),
+                   _holder->data(),
+                   std::min(size, static_cast<size_t>(_holder->_capacity)));
+            swap(tmp);
+            return;
+        }
+
         const size_t realSize = size + sizeof(Holder);
         void* newPtr = mongoRealloc(_holder.get(), realSize);
 
@@ -122,7 +153,7 @@ private:
     class Holder {
     public:
         explicit Holder(unsigned initial, size_t capacity)
-            : _refCount(initial), _capacity(capacity) {
+            : _refCount(initial), _capacity(capacity), _pooled(false) {
             invariant(capacity == _capacity);
         }
 
@@ -135,8 +166,14 @@ private:
             if (h->_refCount.subtractAndFetch(1) == 0) {
                 // We placement new'ed a Holder in takeOwnership above,
                 // so we must destroy the object here.
+                const bool pooled = h->_pooled;
+                const size_t capacity = h->_capacity;
                 h->~Holder();
-                free(h);
+                if (pooled) {
+                    SharedBufferPool::release(h, capacity, sizeof(Holder) + capacity);
+                } else {
+                    free(h);
+                }
             }
         }
 
@@ -153,7 +190,9 @@ private:
         }
 
         AtomicWord<unsigned> _refCount;
-        uint32_t _capacity;
+        uint32_t _capacity : 31;
+        // Set by allocatePooled() when the block came from SharedBufferPool.
+        uint32_t _pooled : 1;
     };
 
     explicit SharedBuffer(Holder* holder) : _holder(holder, /*add_ref=*/false) {
@@ -0,0 +1,141 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/shared_buffer_pool.h"
+
+#include <array>
+#include <cstdlib>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/allocator.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+AtomicWord<long long> poolHits;
+AtomicWord<long long> poolMisses;
+AtomicWord<long long> poolCached;
+AtomicWord<long long> poolFreed;
+
+// Buffers may be released by destructors of other thread_local objects after this thread's cache
+// has been torn down. This flag is trivially destructible, so it can still be consulted then.
+thread_local bool threadCacheDestroyed = false;
+
+struct ThreadCache {
+    ~ThreadCache() {
+        threadCacheDestroyed = true;
+        for (auto& head : freeLists) {
+            while (head) {
+                auto next = head->next;
+                std::free(head);
+                head = next;
+            }
+        }
+    }
+
+    std::array<FreeBlock*, SharedBufferPool::kNumSizeClasses> freeLists{};
+    size_t cachedBytes = 0;
+};
+
+thread_local ThreadCache threadCache;
+
+size_t sizeClassIndex(size_t capacity) {
+    size_t index = 0;
+    for (auto classSize = SharedBufferPool::kSmallestSizeClass; classSize < capacity;
+         classSize <<= 1) {
+        ++index;
+    }
+    dassert(index < SharedBufferPool::kNumSizeClasses);
+    dassert((SharedBufferPool::kSmallestSizeClass << index) == capacity);
+    return index;
+}
+
+}  // namespace
+
+size_t SharedBufferPool::roundUp(size_t bytes) {
+    if (bytes > kLargestSizeClass) {
+        return 0;
+    }
+
+    auto capacity = kSmallestSizeClass;
+    while (capacity < bytes) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+void* SharedBufferPool::acquire(size_t capacity, size_t blockSize) {
+    if (!threadCacheDestroyed) {
+        auto& head = threadCache.freeLists[sizeClassIndex(capacity)];
+        if (head) {
+            auto block = head;
+            head = block->next;
+            threadCache.cachedBytes -= blockSize;
+            poolHits.fetchAndAddRelaxed(1);
+            return block;
+        }
+    }
+
+    poolMisses.fetchAndAddRelaxed(1);
+    return mongoMalloc(blockSize);
+}
+
+void SharedBufferPool::release(void* block, size_t capacity, size_t blockSize) {
+    if (threadCacheDestroyed ||
+        threadCache.cachedBytes + blockSize > kMaxCachedBytesPerThread) {
+        poolFreed.fetchAndAddRelaxed(1);
+        std::free(block);
+        return;
+    }
+
+    auto& head = threadCache.freeLists[sizeClassIndex(capacity)];
+    auto freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = head;
+    head = freeBlock;
+    threadCache.cachedBytes += blockSize;
+    poolCached.fetchAndAddRelaxed(1);
+}
+
+SharedBufferPool::Stats SharedBufferPool::getStats() {
+    Stats stats;
+    stats.hits = poolHits.loadRelaxed();
+    stats.misses = poolMisses.loadRelaxed();
+    stats.cached = poolCached.loadRelaxed();
+    stats.freed = poolFreed.loadRelaxed();
+    return stats;
+}
+
+}  // namespace mongo
@@ -0,0 +1,80 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace mongo {
+
+/**
+ * Per-thread cache of the memory blocks behind SharedBuffer::allocatePooled().
+ *
+ * Buffers are rounded up to one of kNumSizeClasses power-of-two capacities starting at
+ * kSmallestSizeClass. When the last reference to a pooled buffer goes away its block is kept on a
+ * free list of the releasing thread, up to kMaxCachedBytesPerThread, and handed out again by the
+ * next pooled allocation of the same size class on that thread. This suits the wire protocol
+ * where a connection's thread repeatedly allocates and releases similarly sized messages.
+ */
+class SharedBufferPool {
+public:
+    static constexpr size_t kNumSizeClasses = 5;
+    static constexpr size_t kSmallestSizeClass = 1024;
+    static constexpr size_t kLargestSizeClass = kSmallestSizeClass << (kNumSizeClasses - 1);
+    static constexpr size_t kMaxCachedBytesPerThread = 64 * 1024;
+
+    struct Stats {
+        long long hits = 0;
+        long long misses = 0;
+        long long cached = 0;
+        long long freed = 0;
+    };
+
+    /**
+     * Returns the capacity of the smallest size class that can hold 'bytes', or 0 if 'bytes' is
+     * larger than kLargestSizeClass.
+     */
+    static size_t roundUp(size_t bytes);
+
+    /**
+     * Returns a block of 'blockSize' bytes for a buffer of size class 'capacity', reusing one
+     * cached by this thread if possible.
+     */
+    static void* acquire(size_t capacity, size_t blockSize);
+
+    /**
+     * Returns a block obtained from acquire() to this thread's cache, or frees it if the cache is
+     * full or the thread is exiting.
+     */
+    static void release(void* block, size_t capacity, size_t blockSize);
+
+    static Stats getStats();
+};
+
+}  // namespace mongo
@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/shared_buffer_pool.h"
+
+#include <cstring>
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/shared_buffer.h"
+
+namespace mongo {
+namespace {
+
+TEST(SharedBufferPool, RoundUpToSizeClass) {
+    ASSERT_EQ(SharedBufferPool::kSmallestSizeClass, SharedBufferPool::roundUp(1));
+    ASSERT_EQ(SharedBufferPool::kSmallestSizeClass,
+              SharedBufferPool::roundUp(SharedBufferPool::kSmallestSizeClass));
+    ASSERT_EQ(2 * SharedBufferPool::kSmallestSizeClass,
+              SharedBufferPool::roundUp(SharedBufferPool::kSmallestSizeClass + 1));
+    ASSERT_EQ(SharedBufferPool::kLargestSizeClass,
+              SharedBufferPool::roundUp(SharedBufferPool::kLargestSizeClass));
+    ASSERT_EQ(0U, SharedBufferPool::roundUp(SharedBufferPool::kLargestSizeClass + 1));
+}
+
+TEST(SharedBufferPool, ReleasedBufferIsReused) {
+    char* first;
+    {
+        auto buf = SharedBuffer::allocatePooled(100);
+        ASSERT_EQ(SharedBufferPool::kSmallestSizeClass, buf.capacity());
+        first = buf.get();
+    }
+
+    const auto before = SharedBufferPool::getStats();
+    auto buf = SharedBuffer::allocatePooled(200);
+    const auto after = SharedBufferPool::getStats();
+
+    ASSERT_EQ(first, buf.get());
+    ASSERT_EQ(before.hits + 1, after.hits);
+    ASSERT_EQ(before.misses, after.misses);
+}
+
+TEST(SharedBufferPool, OversizedRequestsAreNotPooled) {
+    const auto before = SharedBufferPool::getStats();
+    {
+        auto buf = SharedBuffer::allocatePooled(SharedBufferPool::kLargestSizeClass + 1);
+        ASSERT_EQ(SharedBufferPool::kLargestSizeClass + 1, buf.capacity());
+    }
+    const auto after = SharedBufferPool::getStats();
+
+    ASSERT_EQ(before.hits, after.hits);
+    ASSERT_EQ(before.misses, after.misses);
+    ASSERT_EQ(before.cached, after.cached);
+}
+
+TEST(SharedBufferPool, ReallocKeepsContents) {
+    auto buf = SharedBuffer::allocatePooled(10);
+    std::memcpy(buf.get(), "pooled", 7);
+
+    buf.realloc(3 * SharedBufferPool::kSmallestSizeClass);
+    ASSERT_EQ(4 * SharedBufferPool::kSmallestSizeClass, buf.capacity());
+    ASSERT_EQ(0, std::strcmp(buf.get(), "pooled"));
+
+    buf.realloc(SharedBufferPool::kLargestSizeClass * 2);
+    ASSERT_EQ(SharedBufferPool::kLargestSizeClass * 2, buf.capacity());
+    ASSERT_EQ(0, std::strcmp(buf.get(), "pooled"));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -47,6 +47,8 @@
 #include "mongo/logger/log_domain.h"
 #include "mongo/logger/logger.h"
 #include "mongo/logv2/log.h"
+#include "mongo/logv2/log_domain_global.h"
+#include "mongo/logv2/log_manager.h"
 #include "mongo/platform/compiler.h"
 #include "mongo/stdx/exception.h"
 #include "mongo/stdx/thread.h"
@@ -77,12 +79,16 @@ const char* strsignal(int signalNum) {
 }
 
 void endProcessWithSignal(int signalNum) {
+    logv2::LogManager::global().getGlobalDomainInternal().flush();
     RaiseException(EXIT_ABRUPT, EXCEPTION_NONCONTINUABLE, 0, nullptr);
 }
 
 #else
 
 void endProcessWithSignal(int signalNum) {
+    // Write out what is still buffered for the log file before the process goes away.
+    logv2::LogManager::global().getGlobalDomainInternal().flush();
+
     // This works by restoring the system-default handler for the given signal and re-raising it, in
     // order to get the system default termination behavior (i.e., dumping core, or just exiting).
     struct sigaction defaultedSignals;
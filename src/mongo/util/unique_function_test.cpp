@@ -29,6 +29,8 @@
 
 #include "mongo/util/functional.h"
 
+#include <array>
+
 #include "mongo/unittest/unittest.h"
 
 /**
@@ -171,6 +173,48 @@ TEST(UniqueFunctionTest, dtor_releases_functor_object_and_does_not_call_function
     ASSERT_FALSE(runDetection1.itRan);
 }
 
+TEST(UniqueFunctionTest, moves_release_small_and_large_functors_exactly_once) {
+    struct Counted {
+        explicit Counted(int* live) : live(live) {
+            ++*live;
+        }
+        Counted(const Counted& other) : live(other.live) {
+            ++*live;
+        }
+        Counted(Counted&& other) noexcept : live(other.live) {
+            ++*live;
+        }
+        ~Counted() {
+            --*live;
+        }
+        int* live;
+    };
+
+    int live = 0;
+    {
+        // Small enough to be stored inline.
+        mongo::unique_function<int()> small = [c = Counted(&live)] { return 1; };
+        // Too large to be stored inline.
+        mongo::unique_function<int()> large = [c = Counted(&live),
+                                               padding = std::array<char, 256>{}] { return 2; };
+        ASSERT_EQ(live, 2);
+
+        mongo::unique_function<int()> moved = std::move(small);
+        ASSERT_FALSE(small);
+        ASSERT_EQ(live, 2);
+
+        moved.swap(large);
+        ASSERT_EQ(moved(), 2);
+        ASSERT_EQ(large(), 1);
+        ASSERT_EQ(live, 2);
+
+        moved = std::move(large);
+        ASSERT_EQ(moved(), 1);
+        ASSERT_EQ(live, 1);
+    }
+    ASSERT_EQ(live, 0);
+}
+
 TEST(UniqueFunctionTest, comparison_checks) {
     mongo::unique_function<void()> uf;
 